@@ -0,0 +1,336 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+/* Built with +crc, the CRC32C hashes only run where HWCAP_CRC32 is set */
+#include <arm_acle.h>
+#include <arm_neon.h>
+#include <stdint.h>
+#include <sys/auxv.h>
+
+#include "hashbench.h"
+
+#ifndef HWCAP_CRC32
+#define HWCAP_CRC32 (1 << 7)
+#endif
+
+#define P32_1 0x9e3779b1u
+#define P32_2 0x85ebca77u
+#define P32_3 0xc2b2ae3du
+#define P32_4 0x27d4eb2fu
+#define P32_5 0x165667b1u
+
+int
+arm_has_crc32(void)
+{
+	return (getauxval(AT_HWCAP) & HWCAP_CRC32) != 0;
+}
+
+int
+arm_has_neon(void)
+{
+	/* Advanced SIMD is mandatory on AArch64 */
+	return 1;
+}
+
+uint64_t
+crc32c_armv8(const void *key, size_t len, uint64_t seed)
+{
+	const uint8_t *p = key;
+	uint32_t crc = ~(uint32_t)seed;
+
+	for (; len >= 8; len -= 8, p += 8)
+		crc = __crc32cd(crc, read64(p));
+	for (; len > 0; len--, p++)
+		crc = __crc32cb(crc, *p);
+	return ~crc;
+}
+
+/*
+ * Three interleaved CRC32C streams over 3 blocks, joined by shifting the first ones past the later blocks
+ *
+ * @crc [in]: register before the blocks
+ * @p [in]: first block, the others follow it
+ * @block [in]: block size
+ * @table [in]: shift tables for block bytes
+ * @return: register after the 3 blocks
+ */
+static inline uint32_t
+crc32c_armv8_blocks(uint32_t crc, const uint8_t *p, size_t block, uint32_t table[4][256])
+{
+	uint32_t crc1 = 0, crc2 = 0;
+	const uint8_t *end = p + block;
+
+	/* CRC32CX has a multi-cycle latency but pipelines, 3 streams keep the unit busy */
+	for (; p < end; p += 8) {
+		crc = __crc32cd(crc, read64(p));
+		crc1 = __crc32cd(crc1, read64(p + block));
+		crc2 = __crc32cd(crc2, read64(p + 2 * block));
+	}
+	crc = crc32c_shift(table, crc) ^ crc1;
+	return crc32c_shift(table, crc) ^ crc2;
+}
+
+uint64_t
+crc32c_armv8_3way(const void *key, size_t len, uint64_t seed)
+{
+	const uint8_t *p = key;
+	uint32_t crc = ~(uint32_t)seed;
+
+	for (; len >= 3 * CRC32C_LONG; len -= 3 * CRC32C_LONG, p += 3 * CRC32C_LONG)
+		crc = crc32c_armv8_blocks(crc, p, CRC32C_LONG, crc32c_long);
+	for (; len >= 3 * CRC32C_SHORT; len -= 3 * CRC32C_SHORT, p += 3 * CRC32C_SHORT)
+		crc = crc32c_armv8_blocks(crc, p, CRC32C_SHORT, crc32c_short);
+	for (; len >= 8; len -= 8, p += 8)
+		crc = __crc32cd(crc, read64(p));
+	for (; len > 0; len--, p++)
+		crc = __crc32cb(crc, *p);
+	return ~crc;
+}
+
+/*
+ * NEON XXH3 stripe kernel, four 128-bit lanes of 2 accumulators
+ */
+static void
+xxh3_accumulate_neon(uint64_t *acc, const uint8_t *in, const uint8_t *secret, size_t nb_stripes)
+{
+	uint64x2_t data, data_key, xacc;
+	size_t n;
+	int i;
+
+	for (n = 0; n < nb_stripes; n++, in += XXH3_STRIPE_LEN, secret += XXH3_SECRET_CONSUME) {
+		for (i = 0; i < 4; i++) {
+			xacc = vld1q_u64(acc + 2 * i);
+			data = vreinterpretq_u64_u8(vld1q_u8(in + 16 * i));
+			data_key = veorq_u64(data, vreinterpretq_u64_u8(vld1q_u8(secret + 16 * i)));
+			xacc = vaddq_u64(xacc, vextq_u64(data, data, 1));
+			/* Low 32 bits times high 32 bits of every 64-bit lane, accumulated */
+			xacc = vmlal_u32(xacc, vmovn_u64(data_key), vshrn_n_u64(data_key, 32));
+			vst1q_u64(acc + 2 * i, xacc);
+		}
+	}
+}
+
+/*
+ * NEON XXH3 scramble kernel
+ */
+static void
+xxh3_scramble_neon(uint64_t *acc, const uint8_t *secret)
+{
+	const uint32x2_t prime = vdup_n_u32(P32_1);
+	uint64x2_t data_key, hi;
+	int i;
+
+	for (i = 0; i < 4; i++) {
+		data_key = vld1q_u64(acc + 2 * i);
+		data_key = veorq_u64(data_key, vshrq_n_u64(data_key, 47));
+		data_key = veorq_u64(data_key, vreinterpretq_u64_u8(vld1q_u8(secret + 16 * i)));
+		/* 64-bit multiply by a 32-bit prime from two 32x32 products */
+		hi = vshlq_n_u64(vmull_u32(vshrn_n_u64(data_key, 32), prime), 32);
+		vst1q_u64(acc + 2 * i, vmlal_u32(hi, vmovn_u64(data_key), prime));
+	}
+}
+
+uint64_t
+xxh3_64_neon(const void *key, size_t len, uint64_t seed)
+{
+	return xxh3_64_with(key, len, seed, xxh3_accumulate_neon, xxh3_scramble_neon);
+}
+
+/* Rotate the 32-bit lanes of a NEON register left by a constant */
+#define ROTL32X4(v, r) vorrq_u32(vshlq_n_u32((v), (r)), vshrq_n_u32((v), 32 - (r)))
+
+/*
+ * Load one 32-bit word from each of 4 keys
+ *
+ * @keys [in]: keys
+ * @off [in]: offset of the word
+ * @return: one word per lane
+ */
+static inline uint32x4_t
+load_lanes_neon(const uint8_t *const *keys, size_t off)
+{
+	uint32_t w[4] = {read32(keys[0] + off), read32(keys[1] + off), read32(keys[2] + off), read32(keys[3] + off)};
+
+	return vld1q_u32(w);
+}
+
+/*
+ * Widen 4 32-bit hashes into the output
+ *
+ * @h [in]: hashes
+ * @out [out]: 4 results
+ */
+static inline void
+store_lanes_neon(uint32x4_t h, uint64_t *out)
+{
+	vst1q_u64(out, vmovl_u32(vget_low_u32(h)));
+	vst1q_u64(out + 2, vmovl_u32(vget_high_u32(h)));
+}
+
+/*
+ * Murmur3-32 of 8 keys, two NEON registers of 4 lanes so the two multiply chains overlap
+ */
+static void
+murmur3_32_lanes_neon(const uint8_t *const *keys, size_t len, uint64_t seed, uint64_t *out)
+{
+	const uint32x4_t c1 = vdupq_n_u32(0xcc9e2d51), c2 = vdupq_n_u32(0x1b873593);
+	const uint32x4_t add = vdupq_n_u32(0xe6546b64);
+	uint32x4_t h[2], k;
+	uint32_t t[4];
+	size_t off;
+	int r, l;
+
+	h[0] = vdupq_n_u32(seed);
+	h[1] = h[0];
+	for (off = 0; off + 4 <= len; off += 4) {
+		for (r = 0; r < 2; r++) {
+			k = vmulq_u32(load_lanes_neon(keys + 4 * r, off), c1);
+			k = vmulq_u32(ROTL32X4(k, 15), c2);
+			h[r] = ROTL32X4(veorq_u32(h[r], k), 13);
+			h[r] = vmlaq_n_u32(add, h[r], 5);
+		}
+	}
+	for (r = 0; r < 2; r++) {
+		if (len & 3) {
+			for (l = 0; l < 4; l++)
+				t[l] = read_tail32(keys[4 * r + l] + off, len & 3);
+			k = vmulq_u32(ROTL32X4(vmulq_u32(vld1q_u32(t), c1), 15), c2);
+			h[r] = veorq_u32(h[r], k);
+		}
+		h[r] = veorq_u32(h[r], vdupq_n_u32(len));
+		h[r] = veorq_u32(h[r], vshrq_n_u32(h[r], 16));
+		h[r] = vmulq_n_u32(h[r], 0x85ebca6b);
+		h[r] = veorq_u32(h[r], vshrq_n_u32(h[r], 13));
+		h[r] = vmulq_n_u32(h[r], 0xc2b2ae35);
+		h[r] = veorq_u32(h[r], vshrq_n_u32(h[r], 16));
+		store_lanes_neon(h[r], out + 4 * r);
+	}
+}
+
+void
+murmur3_32_batch_neon(const uint8_t *const *keys, size_t len, uint64_t seed, uint64_t *out, size_t n)
+{
+	hash_batch_run(murmur3_32_lanes_neon, murmur3_32, keys, len, seed, out, n);
+}
+
+/*
+ * XXH32 round on 4 lanes
+ *
+ * @acc [in]: lanes
+ * @in [in]: input words
+ * @return: new lanes
+ */
+static inline uint32x4_t
+xxh32_round_neon(uint32x4_t acc, uint32x4_t in)
+{
+	acc = vmlaq_n_u32(acc, in, P32_2);
+	return vmulq_n_u32(ROTL32X4(acc, 13), P32_1);
+}
+
+/*
+ * XXH32 of 4 keys, one per NEON lane
+ *
+ * @keys [in]: 4 keys
+ * @len [in]: length of every key
+ * @seed [in]: seed
+ * @out [out]: 4 hashes
+ */
+static inline void
+xxh32_quad_neon(const uint8_t *const *keys, size_t len, uint32_t seed, uint64_t *out)
+{
+	uint32x4_t v1, v2, v3, v4, h;
+	uint32_t b[4];
+	size_t off = 0;
+	int l;
+
+	if (len >= 16) {
+		v1 = vdupq_n_u32(seed + P32_1 + P32_2);
+		v2 = vdupq_n_u32(seed + P32_2);
+		v3 = vdupq_n_u32(seed);
+		v4 = vdupq_n_u32(seed - P32_1);
+		for (; off + 16 <= len; off += 16) {
+			v1 = xxh32_round_neon(v1, load_lanes_neon(keys, off));
+			v2 = xxh32_round_neon(v2, load_lanes_neon(keys, off + 4));
+			v3 = xxh32_round_neon(v3, load_lanes_neon(keys, off + 8));
+			v4 = xxh32_round_neon(v4, load_lanes_neon(keys, off + 12));
+		}
+		h = vaddq_u32(vaddq_u32(ROTL32X4(v1, 1), ROTL32X4(v2, 7)),
+			      vaddq_u32(ROTL32X4(v3, 12), ROTL32X4(v4, 18)));
+	} else {
+		h = vdupq_n_u32(seed + P32_5);
+	}
+	h = vaddq_u32(h, vdupq_n_u32(len));
+	for (; off + 4 <= len; off += 4) {
+		h = vmlaq_n_u32(h, load_lanes_neon(keys, off), P32_3);
+		h = vmulq_n_u32(ROTL32X4(h, 17), P32_4);
+	}
+	for (; off < len; off++) {
+		for (l = 0; l < 4; l++)
+			b[l] = keys[l][off];
+		h = vmlaq_n_u32(h, vld1q_u32(b), P32_5);
+		h = vmulq_n_u32(ROTL32X4(h, 11), P32_1);
+	}
+	h = veorq_u32(h, vshrq_n_u32(h, 15));
+	h = vmulq_n_u32(h, P32_2);
+	h = veorq_u32(h, vshrq_n_u32(h, 13));
+	h = vmulq_n_u32(h, P32_3);
+	h = veorq_u32(h, vshrq_n_u32(h, 16));
+	store_lanes_neon(h, out);
+}
+
+/*
+ * XXH32 of 8 keys as two groups of 4 NEON lanes
+ */
+static void
+xxh32_lanes_neon(const uint8_t *const *keys, size_t len, uint64_t seed, uint64_t *out)
+{
+	xxh32_quad_neon(keys, len, seed, out);
+	xxh32_quad_neon(keys + 4, len, seed, out + 4);
+}
+
+void
+xxh32_batch_neon(const uint8_t *const *keys, size_t len, uint64_t seed, uint64_t *out, size_t n)
+{
+	hash_batch_run(xxh32_lanes_neon, xxh32, keys, len, seed, out, n);
+}
+
+/*
+ * CRC32C of 8 keys as 8 interleaved hardware CRC streams
+ */
+static void
+crc32c_lanes_armv8(const uint8_t *const *keys, size_t len, uint64_t seed, uint64_t *out)
+{
+	uint32_t crc[HASH_BATCH_LANES];
+	size_t off;
+	int l;
+
+	for (l = 0; l < HASH_BATCH_LANES; l++)
+		crc[l] = ~(uint32_t)seed;
+	/* 31 general registers hold all the streams once the lane loops are unrolled */
+	for (off = 0; off + 8 <= len; off += 8) {
+#pragma GCC unroll 8
+		for (l = 0; l < HASH_BATCH_LANES; l++)
+			crc[l] = __crc32cd(crc[l], read64(keys[l] + off));
+	}
+	for (; off < len; off++) {
+#pragma GCC unroll 8
+		for (l = 0; l < HASH_BATCH_LANES; l++)
+			crc[l] = __crc32cb(crc[l], keys[l][off]);
+	}
+	for (l = 0; l < HASH_BATCH_LANES; l++)
+		out[l] = ~crc[l];
+}
+
+void
+crc32c_armv8_batch(const uint8_t *const *keys, size_t len, uint64_t seed, uint64_t *out, size_t n)
+{
+	hash_batch_run(crc32c_lanes_armv8, crc32c_armv8, keys, len, seed, out, n);
+}
@@ -0,0 +1,222 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+#include <stdint.h>
+
+#include "hashbench.h"
+
+/* CityHash v1.1 constants */
+#define K0 0xc3a5c85c97cb3127ULL
+#define K1 0xb492b66fbe98f273ULL
+#define K2 0x9ae16a3b2f90404fULL
+#define KMUL 0x9ddfea08eb382d69ULL
+
+/* Pair of 64-bit values, the result of the 32-byte mixer */
+struct u64_pair {
+	uint64_t first;
+	uint64_t second;
+};
+
+/*
+ * Rotate right, 0 allowed
+ *
+ * @v [in]: value
+ * @s [in]: bits
+ * @return: rotated value
+ */
+static inline uint64_t
+rotr(uint64_t v, int s)
+{
+	return s == 0 ? v : (v >> s) | (v << (64 - s));
+}
+
+/*
+ * Fold the high bits into the low bits
+ *
+ * @v [in]: value
+ * @return: mixed value
+ */
+static inline uint64_t
+shift_mix(uint64_t v)
+{
+	return v ^ (v >> 47);
+}
+
+/*
+ * Hash two 64-bit values
+ *
+ * @u [in]: first value
+ * @v [in]: second value
+ * @mul [in]: multiplier
+ * @return: hash
+ */
+static inline uint64_t
+hash_len16(uint64_t u, uint64_t v, uint64_t mul)
+{
+	uint64_t a, b;
+
+	a = (u ^ v) * mul;
+	a ^= a >> 47;
+	b = (v ^ a) * mul;
+	b ^= b >> 47;
+	return b * mul;
+}
+
+/*
+ * CityHash64 of up to 16 bytes
+ *
+ * @s [in]: input
+ * @len [in]: length
+ * @return: hash
+ */
+static uint64_t
+hash_len0to16(const uint8_t *s, size_t len)
+{
+	uint64_t mul = K2 + len * 2, a, b, c, d;
+	uint32_t y, z;
+
+	if (len >= 8) {
+		a = read64(s) + K2;
+		b = read64(s + len - 8);
+		c = rotr(b, 37) * mul + a;
+		d = (rotr(a, 25) + b) * mul;
+		return hash_len16(c, d, mul);
+	}
+	if (len >= 4)
+		return hash_len16(len + ((uint64_t)read32(s) << 3), read32(s + len - 4), mul);
+	if (len > 0) {
+		y = s[0] + ((uint32_t)s[len >> 1] << 8);
+		z = len + ((uint32_t)s[len - 1] << 2);
+		return shift_mix(y * K2 ^ z * K0) * K2;
+	}
+	return K2;
+}
+
+/*
+ * CityHash64 of 17 to 32 bytes
+ *
+ * @s [in]: input
+ * @len [in]: length
+ * @return: hash
+ */
+static uint64_t
+hash_len17to32(const uint8_t *s, size_t len)
+{
+	uint64_t mul = K2 + len * 2;
+	uint64_t a = read64(s) * K1, b = read64(s + 8);
+	uint64_t c = read64(s + len - 8) * mul, d = read64(s + len - 16) * K2;
+
+	return hash_len16(rotr(a + b, 43) + rotr(c, 30) + d, a + rotr(b + K2, 18) + c, mul);
+}
+
+/*
+ * CityHash64 of 33 to 64 bytes
+ *
+ * @s [in]: input
+ * @len [in]: length
+ * @return: hash
+ */
+static uint64_t
+hash_len33to64(const uint8_t *s, size_t len)
+{
+	uint64_t mul = K2 + len * 2;
+	uint64_t a = read64(s) * K2, b = read64(s + 8), c = read64(s + len - 24), d = read64(s + len - 32);
+	uint64_t e = read64(s + 16) * K2, f = read64(s + 24) * 9, g = read64(s + len - 8);
+	uint64_t h = read64(s + len - 16) * mul;
+	uint64_t u = rotr(a + g, 43) + (rotr(b, 30) + c) * 9;
+	uint64_t v = ((a + g) ^ d) + f + 1;
+	uint64_t w = __builtin_bswap64((u + v) * mul) + h;
+	uint64_t x = rotr(e + f, 42) + c;
+	uint64_t y = (__builtin_bswap64((v + w) * mul) + g) * mul;
+	uint64_t z = e + f + c;
+
+	a = __builtin_bswap64((x + z) * mul + y) + b;
+	b = shift_mix((z + a) * mul + d + h) * mul;
+	return b + x;
+}
+
+/*
+ * Mix 32 input bytes into two seeds
+ *
+ * @s [in]: 32 input bytes
+ * @a [in]: first seed
+ * @b [in]: second seed
+ * @return: mixed pair
+ */
+static inline struct u64_pair
+weak_hash32(const uint8_t *s, uint64_t a, uint64_t b)
+{
+	uint64_t w = read64(s), x = read64(s + 8), y = read64(s + 16), z = read64(s + 24), c;
+	struct u64_pair r;
+
+	a += w;
+	b = rotr(b + a + z, 21);
+	c = a;
+	a += x;
+	a += y;
+	b += rotr(a, 44);
+	r.first = a + z;
+	r.second = b + c;
+	return r;
+}
+
+/*
+ * CityHash64 v1.1
+ *
+ * @s [in]: input
+ * @len [in]: length
+ * @return: hash
+ */
+static uint64_t
+city_hash64(const uint8_t *s, size_t len)
+{
+	uint64_t x, y, z, t;
+	struct u64_pair v, w;
+
+	if (len <= 16)
+		return hash_len0to16(s, len);
+	if (len <= 32)
+		return hash_len17to32(s, len);
+	if (len <= 64)
+		return hash_len33to64(s, len);
+
+	x = read64(s + len - 40);
+	y = read64(s + len - 16) + read64(s + len - 56);
+	z = hash_len16(read64(s + len - 48) + len, read64(s + len - 24), KMUL);
+	v = weak_hash32(s + len - 64, len, z);
+	w = weak_hash32(s + len - 32, y + K1, x);
+	x = x * K1 + read64(s);
+
+	len = (len - 1) & ~(size_t)63;
+	do {
+		x = rotr(x + y + v.first + read64(s + 8), 37) * K1;
+		y = rotr(y + v.second + read64(s + 48), 42) * K1;
+		x ^= w.second;
+		y += v.first + read64(s + 40);
+		z = rotr(z + w.first, 33) * K1;
+		v = weak_hash32(s, v.second * K1, x + w.first);
+		w = weak_hash32(s + 32, z + w.second, y + read64(s + 16));
+		t = z;
+		z = x;
+		x = t;
+		s += 64;
+		len -= 64;
+	} while (len != 0);
+	return hash_len16(hash_len16(v.first, w.first, KMUL) + shift_mix(y) * K1 + z,
+			  hash_len16(v.second, w.second, KMUL) + x, KMUL);
+}
+
+uint64_t
+city64(const void *key, size_t len, uint64_t seed)
+{
+	/* CityHash64WithSeed */
+	return hash_len16(city_hash64(key, len) - K2, seed, KMUL);
+}
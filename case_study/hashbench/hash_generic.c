@@ -0,0 +1,398 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+#include <stdint.h>
+#include <string.h>
+
+#include "hashbench.h"
+
+#define FNV32_OFFSET 0x811c9dc5u
+#define FNV32_PRIME 0x01000193u
+#define FNV64_OFFSET 0xcbf29ce484222325ULL
+#define FNV64_PRIME 0x100000001b3ULL
+
+#define CRC32C_POLY 0x82f63b78u		/* Castagnoli, reflected */
+
+uint32_t crc32c_long[4][256];
+uint32_t crc32c_short[4][256];
+static uint32_t crc32c_table[8][256];	/* Slice-by-8 tables of the software CRC32C */
+
+uint64_t
+fnv1a_32(const void *key, size_t len, uint64_t seed)
+{
+	const uint8_t *p = key;
+	uint32_t h = FNV32_OFFSET ^ (uint32_t)seed;
+	size_t i;
+
+	for (i = 0; i < len; i++) {
+		h ^= p[i];
+		h *= FNV32_PRIME;
+	}
+	return h;
+}
+
+uint64_t
+fnv1a_64(const void *key, size_t len, uint64_t seed)
+{
+	const uint8_t *p = key;
+	uint64_t h = FNV64_OFFSET ^ seed;
+	size_t i;
+
+	for (i = 0; i < len; i++) {
+		h ^= p[i];
+		h *= FNV64_PRIME;
+	}
+	return h;
+}
+
+/*
+ * MurmurHash3 32-bit finalizer
+ *
+ * @h [in]: state
+ * @return: mixed state
+ */
+static inline uint32_t
+fmix32(uint32_t h)
+{
+	h ^= h >> 16;
+	h *= 0x85ebca6b;
+	h ^= h >> 13;
+	h *= 0xc2b2ae35;
+	h ^= h >> 16;
+	return h;
+}
+
+/*
+ * MurmurHash3 64-bit finalizer
+ *
+ * @k [in]: state
+ * @return: mixed state
+ */
+static inline uint64_t
+fmix64(uint64_t k)
+{
+	k ^= k >> 33;
+	k *= 0xff51afd7ed558ccdULL;
+	k ^= k >> 33;
+	k *= 0xc4ceb9fe1a85ec53ULL;
+	k ^= k >> 33;
+	return k;
+}
+
+uint64_t
+murmur3_32(const void *key, size_t len, uint64_t seed)
+{
+	const uint32_t c1 = 0xcc9e2d51, c2 = 0x1b873593;
+	const uint8_t *p = key, *tail = p + (len & ~(size_t)3);
+	uint32_t h1 = seed, k1;
+
+	for (; p < tail; p += 4) {
+		k1 = read32(p) * c1;
+		k1 = rotl32(k1, 15) * c2;
+		h1 ^= k1;
+		h1 = rotl32(h1, 13) * 5 + 0xe6546b64;
+	}
+	k1 = 0;
+	switch (len & 3) {
+	case 3:
+		k1 ^= tail[2] << 16;
+		/* fallthrough */
+	case 2:
+		k1 ^= tail[1] << 8;
+		/* fallthrough */
+	case 1:
+		k1 ^= tail[0];
+		k1 = rotl32(k1 * c1, 15) * c2;
+		h1 ^= k1;
+	}
+	return fmix32(h1 ^ (uint32_t)len);
+}
+
+uint64_t
+murmur3_128(const void *key, size_t len, uint64_t seed)
+{
+	const uint64_t c1 = 0x87c37b91114253d5ULL, c2 = 0x4cf5ad432745937fULL;
+	const uint8_t *p = key, *tail = p + (len & ~(size_t)15);
+	uint64_t h1 = (uint32_t)seed, h2 = (uint32_t)seed, k1, k2;
+
+	for (; p < tail; p += 16) {
+		k1 = rotl64(read64(p) * c1, 31) * c2;
+		h1 ^= k1;
+		h1 = (rotl64(h1, 27) + h2) * 5 + 0x52dce729;
+		k2 = rotl64(read64(p + 8) * c2, 33) * c1;
+		h2 ^= k2;
+		h2 = (rotl64(h2, 31) + h1) * 5 + 0x38495ab5;
+	}
+	k1 = 0;
+	k2 = 0;
+	switch (len & 15) {
+	case 15:
+		k2 ^= (uint64_t)tail[14] << 48;
+		/* fallthrough */
+	case 14:
+		k2 ^= (uint64_t)tail[13] << 40;
+		/* fallthrough */
+	case 13:
+		k2 ^= (uint64_t)tail[12] << 32;
+		/* fallthrough */
+	case 12:
+		k2 ^= (uint64_t)tail[11] << 24;
+		/* fallthrough */
+	case 11:
+		k2 ^= (uint64_t)tail[10] << 16;
+		/* fallthrough */
+	case 10:
+		k2 ^= (uint64_t)tail[9] << 8;
+		/* fallthrough */
+	case 9:
+		k2 ^= (uint64_t)tail[8];
+		h2 ^= rotl64(k2 * c2, 33) * c1;
+		/* fallthrough */
+	case 8:
+		k1 ^= (uint64_t)tail[7] << 56;
+		/* fallthrough */
+	case 7:
+		k1 ^= (uint64_t)tail[6] << 48;
+		/* fallthrough */
+	case 6:
+		k1 ^= (uint64_t)tail[5] << 40;
+		/* fallthrough */
+	case 5:
+		k1 ^= (uint64_t)tail[4] << 32;
+		/* fallthrough */
+	case 4:
+		k1 ^= (uint64_t)tail[3] << 24;
+		/* fallthrough */
+	case 3:
+		k1 ^= (uint64_t)tail[2] << 16;
+		/* fallthrough */
+	case 2:
+		k1 ^= (uint64_t)tail[1] << 8;
+		/* fallthrough */
+	case 1:
+		k1 ^= (uint64_t)tail[0];
+		h1 ^= rotl64(k1 * c1, 31) * c2;
+	}
+	h1 ^= len;
+	h2 ^= len;
+	h1 += h2;
+	h2 += h1;
+	h1 = fmix64(h1);
+	h2 = fmix64(h2);
+	/* Low 64 bits of the 128-bit result, the high half adds h1 once more */
+	return h1 + h2;
+}
+
+/*
+ * Murmur3-32 of HASH_BATCH_LANES keys, every step applied to all keys before the next so their chains overlap
+ */
+static void
+murmur3_32_lanes(const uint8_t *const *keys, size_t len, uint64_t seed, uint64_t *out)
+{
+	const uint32_t c1 = 0xcc9e2d51, c2 = 0x1b873593;
+	uint32_t h[HASH_BATCH_LANES], k;
+	size_t off;
+	int l;
+
+	for (l = 0; l < HASH_BATCH_LANES; l++)
+		h[l] = seed;
+	for (off = 0; off + 4 <= len; off += 4) {
+#pragma GCC unroll 8
+		for (l = 0; l < HASH_BATCH_LANES; l++) {
+			k = rotl32(read32(keys[l] + off) * c1, 15) * c2;
+			h[l] = rotl32(h[l] ^ k, 13) * 5 + 0xe6546b64;
+		}
+	}
+	for (l = 0; l < HASH_BATCH_LANES; l++) {
+		if (len & 3)
+			h[l] ^= rotl32(read_tail32(keys[l] + off, len & 3) * c1, 15) * c2;
+		out[l] = fmix32(h[l] ^ (uint32_t)len);
+	}
+}
+
+void
+murmur3_32_batch(const uint8_t *const *keys, size_t len, uint64_t seed, uint64_t *out, size_t n)
+{
+	hash_batch_run(murmur3_32_lanes, murmur3_32, keys, len, seed, out, n);
+}
+
+/*
+ * One SipHash round
+ */
+#define SIPROUND(v0, v1, v2, v3)						\
+	do {									\
+		v0 += v1;							\
+		v1 = rotl64(v1, 13);						\
+		v1 ^= v0;							\
+		v0 = rotl64(v0, 32);						\
+		v2 += v3;							\
+		v3 = rotl64(v3, 16);						\
+		v3 ^= v2;							\
+		v0 += v3;							\
+		v3 = rotl64(v3, 21);						\
+		v3 ^= v0;							\
+		v2 += v1;							\
+		v1 = rotl64(v1, 17);						\
+		v1 ^= v2;							\
+		v2 = rotl64(v2, 32);						\
+	} while (0)
+
+uint64_t
+siphash24_key(const void *key, size_t len, uint64_t k0, uint64_t k1)
+{
+	uint64_t v0 = k0 ^ 0x736f6d6570736575ULL, v1 = k1 ^ 0x646f72616e646f6dULL;
+	uint64_t v2 = k0 ^ 0x6c7967656e657261ULL, v3 = k1 ^ 0x7465646279746573ULL;
+	const uint8_t *p = key, *end = p + (len & ~(size_t)7);
+	uint64_t m, b = (uint64_t)len << 56;
+	int i;
+
+	for (; p < end; p += 8) {
+		m = read64(p);
+		v3 ^= m;
+		SIPROUND(v0, v1, v2, v3);
+		SIPROUND(v0, v1, v2, v3);
+		v0 ^= m;
+	}
+	for (i = len & 7; i > 0; i--)
+		b |= (uint64_t)p[i - 1] << (8 * (i - 1));
+	v3 ^= b;
+	SIPROUND(v0, v1, v2, v3);
+	SIPROUND(v0, v1, v2, v3);
+	v0 ^= b;
+	v2 ^= 0xff;
+	SIPROUND(v0, v1, v2, v3);
+	SIPROUND(v0, v1, v2, v3);
+	SIPROUND(v0, v1, v2, v3);
+	SIPROUND(v0, v1, v2, v3);
+	return v0 ^ v1 ^ v2 ^ v3;
+}
+
+uint64_t
+siphash24(const void *key, size_t len, uint64_t seed)
+{
+	return siphash24_key(key, len, seed, ~seed);
+}
+
+/*
+ * Multiply a vector by a GF(2) 32x32 matrix
+ *
+ * @mat [in]: matrix, one column per bit of vec
+ * @vec [in]: vector
+ * @return: product
+ */
+static uint32_t
+gf2_times(const uint32_t *mat, uint32_t vec)
+{
+	uint32_t sum = 0;
+
+	for (; vec != 0; vec >>= 1, mat++) {
+		if (vec & 1)
+			sum ^= *mat;
+	}
+	return sum;
+}
+
+/*
+ * Square a GF(2) 32x32 matrix
+ *
+ * @square [out]: mat * mat
+ * @mat [in]: matrix
+ */
+static void
+gf2_square(uint32_t *square, const uint32_t *mat)
+{
+	int n;
+
+	for (n = 0; n < 32; n++)
+		square[n] = gf2_times(mat, mat[n]);
+}
+
+/*
+ * Build the tables that shift a CRC32C register past len zero bytes
+ *
+ * @table [out]: one table per byte of the register
+ * @len [in]: zero bytes, a power of two
+ */
+static void
+crc32c_zeros(uint32_t table[4][256], size_t len)
+{
+	uint32_t even[32], odd[32], *op = odd, row = 1;
+	int n;
+
+	/* Operator for one zero bit, then squared up to len bytes */
+	odd[0] = CRC32C_POLY;
+	for (n = 1; n < 32; n++) {
+		odd[n] = row;
+		row <<= 1;
+	}
+	gf2_square(even, odd);
+	gf2_square(odd, even);
+	for (;;) {
+		gf2_square(even, odd);
+		op = even;
+		len >>= 1;
+		if (len == 0)
+			break;
+		gf2_square(odd, even);
+		op = odd;
+		len >>= 1;
+		if (len == 0)
+			break;
+	}
+	for (n = 0; n < 256; n++) {
+		table[0][n] = gf2_times(op, n);
+		table[1][n] = gf2_times(op, n << 8);
+		table[2][n] = gf2_times(op, n << 16);
+		table[3][n] = gf2_times(op, (uint32_t)n << 24);
+	}
+}
+
+void
+crc32c_init(void)
+{
+	uint32_t crc;
+	int n, k;
+
+	for (n = 0; n < 256; n++) {
+		crc = n;
+		for (k = 0; k < 8; k++)
+			crc = crc & 1 ? (crc >> 1) ^ CRC32C_POLY : crc >> 1;
+		crc32c_table[0][n] = crc;
+	}
+	for (n = 0; n < 256; n++) {
+		crc = crc32c_table[0][n];
+		for (k = 1; k < 8; k++) {
+			crc = crc32c_table[0][crc & 0xff] ^ (crc >> 8);
+			crc32c_table[k][n] = crc;
+		}
+	}
+	crc32c_zeros(crc32c_long, CRC32C_LONG);
+	crc32c_zeros(crc32c_short, CRC32C_SHORT);
+}
+
+uint64_t
+crc32c_sw(const void *key, size_t len, uint64_t seed)
+{
+	const uint8_t *p = key;
+	uint32_t crc = ~(uint32_t)seed;
+	uint64_t w;
+
+	for (; len >= 8; len -= 8, p += 8) {
+		w = read64(p) ^ crc;
+		crc = crc32c_table[7][w & 0xff] ^ crc32c_table[6][(w >> 8) & 0xff] ^
+		      crc32c_table[5][(w >> 16) & 0xff] ^ crc32c_table[4][(w >> 24) & 0xff] ^
+		      crc32c_table[3][(w >> 32) & 0xff] ^ crc32c_table[2][(w >> 40) & 0xff] ^
+		      crc32c_table[1][(w >> 48) & 0xff] ^ crc32c_table[0][w >> 56];
+	}
+	for (; len > 0; len--, p++)
+		crc = crc32c_table[0][(crc ^ *p) & 0xff] ^ (crc >> 8);
+	return ~crc;
+}
@@ -0,0 +1,318 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+#include <stdint.h>
+#include <x86intrin.h>
+
+#include "hashbench.h"
+
+#define P32_1 0x9e3779b1u
+#define P32_2 0x85ebca77u
+#define P32_3 0xc2b2ae3du
+#define P32_4 0x27d4eb2fu
+#define P32_5 0x165667b1u
+#define CRC32C_STREAMS 4	/* Interleaved CRC streams of the batch, divides HASH_BATCH_LANES */
+
+int
+x86_has_sse42(void)
+{
+	return __builtin_cpu_supports("sse4.2");
+}
+
+int
+x86_has_avx2(void)
+{
+	return __builtin_cpu_supports("avx2");
+}
+
+uint64_t __attribute__((target("sse4.2")))
+crc32c_sse42(const void *key, size_t len, uint64_t seed)
+{
+	const uint8_t *p = key;
+	uint64_t crc = ~(uint32_t)seed;
+
+	for (; len >= 8; len -= 8, p += 8)
+		crc = _mm_crc32_u64(crc, read64(p));
+	for (; len > 0; len--, p++)
+		crc = _mm_crc32_u8(crc, *p);
+	return ~(uint32_t)crc;
+}
+
+/*
+ * Three interleaved CRC32C streams over 3 blocks, joined by shifting the first ones past the later blocks
+ *
+ * @crc [in]: register before the blocks
+ * @p [in]: first block, the others follow it
+ * @block [in]: block size
+ * @table [in]: shift tables for block bytes
+ * @return: register after the 3 blocks
+ */
+static inline uint64_t __attribute__((target("sse4.2")))
+crc32c_sse42_blocks(uint64_t crc, const uint8_t *p, size_t block, uint32_t table[4][256])
+{
+	uint64_t crc1 = 0, crc2 = 0;
+	const uint8_t *end = p + block;
+
+	/* crc32 has a 3-cycle latency and a 1-cycle throughput, 3 streams keep the unit busy */
+	for (; p < end; p += 8) {
+		crc = _mm_crc32_u64(crc, read64(p));
+		crc1 = _mm_crc32_u64(crc1, read64(p + block));
+		crc2 = _mm_crc32_u64(crc2, read64(p + 2 * block));
+	}
+	crc = crc32c_shift(table, crc) ^ crc1;
+	return crc32c_shift(table, crc) ^ crc2;
+}
+
+uint64_t __attribute__((target("sse4.2")))
+crc32c_sse42_3way(const void *key, size_t len, uint64_t seed)
+{
+	const uint8_t *p = key;
+	uint64_t crc = ~(uint32_t)seed;
+
+	for (; len >= 3 * CRC32C_LONG; len -= 3 * CRC32C_LONG, p += 3 * CRC32C_LONG)
+		crc = crc32c_sse42_blocks(crc, p, CRC32C_LONG, crc32c_long);
+	for (; len >= 3 * CRC32C_SHORT; len -= 3 * CRC32C_SHORT, p += 3 * CRC32C_SHORT)
+		crc = crc32c_sse42_blocks(crc, p, CRC32C_SHORT, crc32c_short);
+	for (; len >= 8; len -= 8, p += 8)
+		crc = _mm_crc32_u64(crc, read64(p));
+	for (; len > 0; len--, p++)
+		crc = _mm_crc32_u8(crc, *p);
+	return ~(uint32_t)crc;
+}
+
+/*
+ * AVX2 XXH3 stripe kernel, two 256-bit lanes of 4 accumulators
+ */
+static void __attribute__((target("avx2")))
+xxh3_accumulate_avx2(uint64_t *acc, const uint8_t *in, const uint8_t *secret, size_t nb_stripes)
+{
+	__m256i *xacc = (__m256i *)acc, data, key, data_key, product, swapped;
+	size_t n;
+	int i;
+
+	for (n = 0; n < nb_stripes; n++, in += XXH3_STRIPE_LEN, secret += XXH3_SECRET_CONSUME) {
+		for (i = 0; i < 2; i++) {
+			data = _mm256_loadu_si256((const __m256i *)in + i);
+			key = _mm256_loadu_si256((const __m256i *)secret + i);
+			data_key = _mm256_xor_si256(data, key);
+			/* Low 32 bits times high 32 bits of every 64-bit lane */
+			product = _mm256_mul_epu32(data_key, _mm256_srli_epi64(data_key, 32));
+			swapped = _mm256_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+			xacc[i] = _mm256_add_epi64(product, _mm256_add_epi64(xacc[i], swapped));
+		}
+	}
+}
+
+/*
+ * AVX2 XXH3 scramble kernel
+ */
+static void __attribute__((target("avx2")))
+xxh3_scramble_avx2(uint64_t *acc, const uint8_t *secret)
+{
+	const __m256i prime = _mm256_set1_epi32(P32_1);
+	__m256i *xacc = (__m256i *)acc, data_key, lo, hi;
+	int i;
+
+	for (i = 0; i < 2; i++) {
+		data_key = _mm256_xor_si256(xacc[i], _mm256_srli_epi64(xacc[i], 47));
+		data_key = _mm256_xor_si256(data_key, _mm256_loadu_si256((const __m256i *)secret + i));
+		/* 64-bit multiply by a 32-bit prime from two 32x32 products */
+		lo = _mm256_mul_epu32(data_key, prime);
+		hi = _mm256_mul_epu32(_mm256_shuffle_epi32(data_key, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+		xacc[i] = _mm256_add_epi64(lo, _mm256_slli_epi64(hi, 32));
+	}
+}
+
+uint64_t
+xxh3_64_avx2(const void *key, size_t len, uint64_t seed)
+{
+	return xxh3_64_with(key, len, seed, xxh3_accumulate_avx2, xxh3_scramble_avx2);
+}
+
+/*
+ * Rotate 8 32-bit lanes left
+ *
+ * @v [in]: lanes
+ * @r [in]: bits, 1 to 31
+ * @return: rotated lanes
+ */
+static inline __m256i __attribute__((target("avx2")))
+rotl32_avx2(__m256i v, int r)
+{
+	return _mm256_or_si256(_mm256_slli_epi32(v, r), _mm256_srli_epi32(v, 32 - r));
+}
+
+/*
+ * Load one 32-bit word from each of 8 keys
+ *
+ * @keys [in]: keys
+ * @off [in]: offset of the word
+ * @return: one word per lane
+ */
+static inline __m256i __attribute__((target("avx2")))
+load_lanes_avx2(const uint8_t *const *keys, size_t off)
+{
+	return _mm256_setr_epi32(read32(keys[0] + off), read32(keys[1] + off), read32(keys[2] + off),
+				 read32(keys[3] + off), read32(keys[4] + off), read32(keys[5] + off),
+				 read32(keys[6] + off), read32(keys[7] + off));
+}
+
+/*
+ * Widen 8 32-bit hashes into the output
+ *
+ * @h [in]: hashes
+ * @out [out]: 8 results
+ */
+static inline void __attribute__((target("avx2")))
+store_lanes_avx2(__m256i h, uint64_t *out)
+{
+	_mm256_storeu_si256((__m256i *)out, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(h)));
+	_mm256_storeu_si256((__m256i *)out + 1, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(h, 1)));
+}
+
+/*
+ * Murmur3-32 of 8 keys, one per AVX2 lane
+ */
+static void __attribute__((target("avx2")))
+murmur3_32_lanes_avx2(const uint8_t *const *keys, size_t len, uint64_t seed, uint64_t *out)
+{
+	const __m256i c1 = _mm256_set1_epi32(0xcc9e2d51), c2 = _mm256_set1_epi32(0x1b873593);
+	__m256i h = _mm256_set1_epi32(seed), k;
+	size_t off;
+
+	for (off = 0; off + 4 <= len; off += 4) {
+		k = _mm256_mullo_epi32(rotl32_avx2(_mm256_mullo_epi32(load_lanes_avx2(keys, off), c1), 15), c2);
+		h = rotl32_avx2(_mm256_xor_si256(h, k), 13);
+		h = _mm256_add_epi32(_mm256_add_epi32(_mm256_slli_epi32(h, 2), h), _mm256_set1_epi32(0xe6546b64));
+	}
+	if (len & 3) {
+		k = _mm256_setr_epi32(read_tail32(keys[0] + off, len & 3), read_tail32(keys[1] + off, len & 3),
+				      read_tail32(keys[2] + off, len & 3), read_tail32(keys[3] + off, len & 3),
+				      read_tail32(keys[4] + off, len & 3), read_tail32(keys[5] + off, len & 3),
+				      read_tail32(keys[6] + off, len & 3), read_tail32(keys[7] + off, len & 3));
+		k = _mm256_mullo_epi32(rotl32_avx2(_mm256_mullo_epi32(k, c1), 15), c2);
+		h = _mm256_xor_si256(h, k);
+	}
+	h = _mm256_xor_si256(h, _mm256_set1_epi32(len));
+	h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 16));
+	h = _mm256_mullo_epi32(h, _mm256_set1_epi32(0x85ebca6b));
+	h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 13));
+	h = _mm256_mullo_epi32(h, _mm256_set1_epi32(0xc2b2ae35));
+	h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 16));
+	store_lanes_avx2(h, out);
+}
+
+void
+murmur3_32_batch_avx2(const uint8_t *const *keys, size_t len, uint64_t seed, uint64_t *out, size_t n)
+{
+	hash_batch_run(murmur3_32_lanes_avx2, murmur3_32, keys, len, seed, out, n);
+}
+
+/*
+ * XXH32 round on 8 lanes
+ *
+ * @acc [in]: lanes
+ * @in [in]: input words
+ * @return: new lanes
+ */
+static inline __m256i __attribute__((target("avx2")))
+xxh32_round_avx2(__m256i acc, __m256i in)
+{
+	acc = _mm256_add_epi32(acc, _mm256_mullo_epi32(in, _mm256_set1_epi32(P32_2)));
+	return _mm256_mullo_epi32(rotl32_avx2(acc, 13), _mm256_set1_epi32(P32_1));
+}
+
+/*
+ * XXH32 of 8 keys, one per AVX2 lane
+ */
+static void __attribute__((target("avx2")))
+xxh32_lanes_avx2(const uint8_t *const *keys, size_t len, uint64_t seed, uint64_t *out)
+{
+	uint32_t s = seed;
+	__m256i v1, v2, v3, v4, h;
+	size_t off = 0;
+
+	if (len >= 16) {
+		v1 = _mm256_set1_epi32(s + P32_1 + P32_2);
+		v2 = _mm256_set1_epi32(s + P32_2);
+		v3 = _mm256_set1_epi32(s);
+		v4 = _mm256_set1_epi32(s - P32_1);
+		for (; off + 16 <= len; off += 16) {
+			v1 = xxh32_round_avx2(v1, load_lanes_avx2(keys, off));
+			v2 = xxh32_round_avx2(v2, load_lanes_avx2(keys, off + 4));
+			v3 = xxh32_round_avx2(v3, load_lanes_avx2(keys, off + 8));
+			v4 = xxh32_round_avx2(v4, load_lanes_avx2(keys, off + 12));
+		}
+		h = _mm256_add_epi32(_mm256_add_epi32(rotl32_avx2(v1, 1), rotl32_avx2(v2, 7)),
+				     _mm256_add_epi32(rotl32_avx2(v3, 12), rotl32_avx2(v4, 18)));
+	} else {
+		h = _mm256_set1_epi32(s + P32_5);
+	}
+	h = _mm256_add_epi32(h, _mm256_set1_epi32(len));
+	for (; off + 4 <= len; off += 4) {
+		h = _mm256_add_epi32(h, _mm256_mullo_epi32(load_lanes_avx2(keys, off), _mm256_set1_epi32(P32_3)));
+		h = _mm256_mullo_epi32(rotl32_avx2(h, 17), _mm256_set1_epi32(P32_4));
+	}
+	for (; off < len; off++) {
+		h = _mm256_add_epi32(h, _mm256_mullo_epi32(_mm256_setr_epi32(keys[0][off], keys[1][off], keys[2][off],
+									       keys[3][off], keys[4][off], keys[5][off],
+									       keys[6][off], keys[7][off]),
+							   _mm256_set1_epi32(P32_5)));
+		h = _mm256_mullo_epi32(rotl32_avx2(h, 11), _mm256_set1_epi32(P32_1));
+	}
+	h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 15));
+	h = _mm256_mullo_epi32(h, _mm256_set1_epi32(P32_2));
+	h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 13));
+	h = _mm256_mullo_epi32(h, _mm256_set1_epi32(P32_3));
+	h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 16));
+	store_lanes_avx2(h, out);
+}
+
+void
+xxh32_batch_avx2(const uint8_t *const *keys, size_t len, uint64_t seed, uint64_t *out, size_t n)
+{
+	hash_batch_run(xxh32_lanes_avx2, xxh32, keys, len, seed, out, n);
+}
+
+/*
+ * CRC32C of 8 keys as two rounds of CRC32C_STREAMS interleaved hardware CRC streams
+ */
+static void __attribute__((target("sse4.2")))
+crc32c_lanes_sse42(const uint8_t *const *keys, size_t len, uint64_t seed, uint64_t *out)
+{
+	uint64_t crc[CRC32C_STREAMS];
+	size_t off;
+	int g, l;
+
+	/* Three crc32 in flight cover its latency, eight streams would spill; unrolled to keep crc[] in registers */
+	for (g = 0; g < HASH_BATCH_LANES; g += CRC32C_STREAMS) {
+		for (l = 0; l < CRC32C_STREAMS; l++)
+			crc[l] = ~(uint32_t)seed;
+		for (off = 0; off + 8 <= len; off += 8) {
+#pragma GCC unroll 8
+			for (l = 0; l < CRC32C_STREAMS; l++)
+				crc[l] = _mm_crc32_u64(crc[l], read64(keys[g + l] + off));
+		}
+		for (; off < len; off++) {
+#pragma GCC unroll 8
+			for (l = 0; l < CRC32C_STREAMS; l++)
+				crc[l] = _mm_crc32_u8(crc[l], keys[g + l][off]);
+		}
+		for (l = 0; l < CRC32C_STREAMS; l++)
+			out[g + l] = ~(uint32_t)crc[l];
+	}
+}
+
+void
+crc32c_sse42_batch(const uint8_t *const *keys, size_t len, uint64_t seed, uint64_t *out, size_t n)
+{
+	hash_batch_run(crc32c_lanes_sse42, crc32c_sse42, keys, len, seed, out, n);
+}
@@ -0,0 +1,499 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+#include <stdint.h>
+#include <string.h>
+
+#include "hashbench.h"
+
+#define P32_1 0x9e3779b1u
+#define P32_2 0x85ebca77u
+#define P32_3 0xc2b2ae3du
+#define P32_4 0x27d4eb2fu
+#define P32_5 0x165667b1u
+#define P64_1 0x9e3779b185ebca87ULL
+#define P64_2 0xc2b2ae3d27d4eb4fULL
+#define P64_3 0x165667b19e3779f9ULL
+#define P64_4 0x85ebca77c2b2ae63ULL
+#define P64_5 0x27d4eb2f165667c5ULL
+#define PRIME_MX1 0x165667919e3779f9ULL
+#define PRIME_MX2 0x9fb21c651e98df25ULL
+
+#define XXH3_MIDSIZE_MAX 240		/* Longest input of the mid-size path */
+#define XXH3_MIDSIZE_START 3		/* Secret offset of the mid-size rounds past the 8th */
+#define XXH3_MIDSIZE_LAST 17		/* Secret offset from the end of the minimum secret for the last 16 bytes */
+#define XXH3_SECRET_SIZE_MIN 136	/* Minimum secret size */
+#define XXH3_LASTACC_START 7		/* Secret offset from the end for the last stripe */
+#define XXH3_MERGEACCS_START 11		/* Secret offset of the accumulator merge */
+
+static const uint8_t xxh3_secret[XXH3_SECRET_SIZE] __attribute__((aligned(64))) = {
+	0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+	0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+	0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+	0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+	0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+	0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+	0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+	0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+	0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+	0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+	0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+	0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+/*
+ * XXH32 accumulator round
+ *
+ * @acc [in]: lane
+ * @in [in]: input word
+ * @return: new lane
+ */
+static inline uint32_t
+xxh32_round(uint32_t acc, uint32_t in)
+{
+	return rotl32(acc + in * P32_2, 13) * P32_1;
+}
+
+uint64_t
+xxh32(const void *key, size_t len, uint64_t seed)
+{
+	const uint8_t *p = key, *end = p + len;
+	uint32_t s = seed, v1, v2, v3, v4, h;
+
+	if (len >= 16) {
+		v1 = s + P32_1 + P32_2;
+		v2 = s + P32_2;
+		v3 = s;
+		v4 = s - P32_1;
+		for (; p + 16 <= end; p += 16) {
+			v1 = xxh32_round(v1, read32(p));
+			v2 = xxh32_round(v2, read32(p + 4));
+			v3 = xxh32_round(v3, read32(p + 8));
+			v4 = xxh32_round(v4, read32(p + 12));
+		}
+		h = rotl32(v1, 1) + rotl32(v2, 7) + rotl32(v3, 12) + rotl32(v4, 18);
+	} else {
+		h = s + P32_5;
+	}
+	h += len;
+	for (; p + 4 <= end; p += 4)
+		h = rotl32(h + read32(p) * P32_3, 17) * P32_4;
+	for (; p < end; p++)
+		h = rotl32(h + *p * P32_5, 11) * P32_1;
+	h ^= h >> 15;
+	h *= P32_2;
+	h ^= h >> 13;
+	h *= P32_3;
+	h ^= h >> 16;
+	return h;
+}
+
+/*
+ * XXH32 stripes of two keys, their eight lanes fill the registers without spilling
+ *
+ * @p [in]: first key
+ * @q [in]: second key
+ * @stripes [in]: bytes of 16-byte stripes
+ * @seed [in]: seed
+ * @h [out]: the two hashes after merging the lanes
+ */
+static inline void
+xxh32_stripes_pair(const uint8_t *p, const uint8_t *q, size_t stripes, uint32_t seed, uint32_t *h)
+{
+	uint32_t p1 = seed + P32_1 + P32_2, p2 = seed + P32_2, p3 = seed, p4 = seed - P32_1;
+	uint32_t q1 = p1, q2 = p2, q3 = p3, q4 = p4;
+	size_t off;
+
+	for (off = 0; off < stripes; off += 16) {
+		p1 = xxh32_round(p1, read32(p + off));
+		q1 = xxh32_round(q1, read32(q + off));
+		p2 = xxh32_round(p2, read32(p + off + 4));
+		q2 = xxh32_round(q2, read32(q + off + 4));
+		p3 = xxh32_round(p3, read32(p + off + 8));
+		q3 = xxh32_round(q3, read32(q + off + 8));
+		p4 = xxh32_round(p4, read32(p + off + 12));
+		q4 = xxh32_round(q4, read32(q + off + 12));
+	}
+	h[0] = rotl32(p1, 1) + rotl32(p2, 7) + rotl32(p3, 12) + rotl32(p4, 18);
+	h[1] = rotl32(q1, 1) + rotl32(q2, 7) + rotl32(q3, 12) + rotl32(q4, 18);
+}
+
+/*
+ * XXH32 of HASH_BATCH_LANES keys, the stripes two keys at a time and the tail steps across all keys
+ */
+static void
+xxh32_lanes(const uint8_t *const *keys, size_t len, uint64_t seed, uint64_t *out)
+{
+	uint32_t h[HASH_BATCH_LANES];
+	size_t off, stripes = len & ~(size_t)15;
+	int l;
+
+	for (l = 0; l < HASH_BATCH_LANES; l += 2) {
+		if (len >= 16)
+			xxh32_stripes_pair(keys[l], keys[l + 1], stripes, seed, &h[l]);
+		else
+			h[l] = h[l + 1] = (uint32_t)seed + P32_5;
+	}
+	for (l = 0; l < HASH_BATCH_LANES; l++)
+		h[l] += len;
+	for (off = stripes; off + 4 <= len; off += 4) {
+#pragma GCC unroll 8
+		for (l = 0; l < HASH_BATCH_LANES; l++)
+			h[l] = rotl32(h[l] + read32(keys[l] + off) * P32_3, 17) * P32_4;
+	}
+	for (; off < len; off++) {
+#pragma GCC unroll 8
+		for (l = 0; l < HASH_BATCH_LANES; l++)
+			h[l] = rotl32(h[l] + keys[l][off] * P32_5, 11) * P32_1;
+	}
+	for (l = 0; l < HASH_BATCH_LANES; l++) {
+		h[l] ^= h[l] >> 15;
+		h[l] *= P32_2;
+		h[l] ^= h[l] >> 13;
+		h[l] *= P32_3;
+		h[l] ^= h[l] >> 16;
+		out[l] = h[l];
+	}
+}
+
+void
+xxh32_batch(const uint8_t *const *keys, size_t len, uint64_t seed, uint64_t *out, size_t n)
+{
+	hash_batch_run(xxh32_lanes, xxh32, keys, len, seed, out, n);
+}
+
+/*
+ * XXH64 accumulator round
+ *
+ * @acc [in]: lane
+ * @in [in]: input word
+ * @return: new lane
+ */
+static inline uint64_t
+xxh64_round(uint64_t acc, uint64_t in)
+{
+	return rotl64(acc + in * P64_2, 31) * P64_1;
+}
+
+/*
+ * Fold an XXH64 lane into the hash
+ *
+ * @h [in]: hash
+ * @v [in]: lane
+ * @return: new hash
+ */
+static inline uint64_t
+xxh64_merge(uint64_t h, uint64_t v)
+{
+	return (h ^ xxh64_round(0, v)) * P64_1 + P64_4;
+}
+
+/*
+ * XXH64 final mix, also used by XXH3
+ *
+ * @h [in]: hash
+ * @return: mixed hash
+ */
+static inline uint64_t
+xxh64_avalanche(uint64_t h)
+{
+	h ^= h >> 33;
+	h *= P64_2;
+	h ^= h >> 29;
+	h *= P64_3;
+	h ^= h >> 32;
+	return h;
+}
+
+uint64_t
+xxh64(const void *key, size_t len, uint64_t seed)
+{
+	const uint8_t *p = key, *end = p + len;
+	uint64_t v1, v2, v3, v4, h;
+
+	if (len >= 32) {
+		v1 = seed + P64_1 + P64_2;
+		v2 = seed + P64_2;
+		v3 = seed;
+		v4 = seed - P64_1;
+		for (; p + 32 <= end; p += 32) {
+			v1 = xxh64_round(v1, read64(p));
+			v2 = xxh64_round(v2, read64(p + 8));
+			v3 = xxh64_round(v3, read64(p + 16));
+			v4 = xxh64_round(v4, read64(p + 24));
+		}
+		h = rotl64(v1, 1) + rotl64(v2, 7) + rotl64(v3, 12) + rotl64(v4, 18);
+		h = xxh64_merge(h, v1);
+		h = xxh64_merge(h, v2);
+		h = xxh64_merge(h, v3);
+		h = xxh64_merge(h, v4);
+	} else {
+		h = seed + P64_5;
+	}
+	h += len;
+	for (; p + 8 <= end; p += 8)
+		h = rotl64(h ^ xxh64_round(0, read64(p)), 27) * P64_1 + P64_4;
+	if (p + 4 <= end) {
+		h = rotl64(h ^ read32(p) * P64_1, 23) * P64_2 + P64_3;
+		p += 4;
+	}
+	for (; p < end; p++)
+		h = rotl64(h ^ *p * P64_5, 11) * P64_1;
+	return xxh64_avalanche(h);
+}
+
+/*
+ * 64x64 to 128-bit multiply folded to 64 bits
+ *
+ * @a [in]: first factor
+ * @b [in]: second factor
+ * @return: low half xor high half of the product
+ */
+static inline uint64_t
+mul128_fold64(uint64_t a, uint64_t b)
+{
+	__uint128_t product = (__uint128_t)a * b;
+
+	return (uint64_t)product ^ (uint64_t)(product >> 64);
+}
+
+/*
+ * XXH3 final mix
+ *
+ * @h [in]: hash
+ * @return: mixed hash
+ */
+static inline uint64_t
+xxh3_avalanche(uint64_t h)
+{
+	h ^= h >> 37;
+	h *= PRIME_MX1;
+	h ^= h >> 32;
+	return h;
+}
+
+/*
+ * XXH3 16-byte mixer
+ *
+ * @in [in]: 16 input bytes
+ * @secret [in]: 16 secret bytes
+ * @seed [in]: seed
+ * @return: mixed value
+ */
+static inline uint64_t
+xxh3_mix16(const uint8_t *in, const uint8_t *secret, uint64_t seed)
+{
+	return mul128_fold64(read64(in) ^ (read64(secret) + seed), read64(in + 8) ^ (read64(secret + 8) - seed));
+}
+
+/*
+ * XXH3-64 of up to 16 bytes
+ *
+ * @in [in]: input
+ * @len [in]: length
+ * @seed [in]: seed
+ * @return: hash
+ */
+static inline uint64_t
+xxh3_0to16(const uint8_t *in, size_t len, uint64_t seed)
+{
+	const uint8_t *secret = xxh3_secret;
+	uint64_t flip1, flip2, lo, hi, acc;
+	uint32_t combined;
+
+	if (len > 8) {
+		flip1 = (read64(secret + 24) ^ read64(secret + 32)) + seed;
+		flip2 = (read64(secret + 40) ^ read64(secret + 48)) - seed;
+		lo = read64(in) ^ flip1;
+		hi = read64(in + len - 8) ^ flip2;
+		acc = len + __builtin_bswap64(lo) + hi + mul128_fold64(lo, hi);
+		return xxh3_avalanche(acc);
+	}
+	if (len >= 4) {
+		seed ^= (uint64_t)__builtin_bswap32((uint32_t)seed) << 32;
+		flip1 = (read64(secret + 8) ^ read64(secret + 16)) - seed;
+		acc = (read32(in + len - 4) + ((uint64_t)read32(in) << 32)) ^ flip1;
+		/* rrmxmx */
+		acc ^= rotl64(acc, 49) ^ rotl64(acc, 24);
+		acc *= PRIME_MX2;
+		acc ^= (acc >> 35) + len;
+		acc *= PRIME_MX2;
+		return acc ^ (acc >> 28);
+	}
+	if (len > 0) {
+		combined = ((uint32_t)in[0] << 16) | ((uint32_t)in[len >> 1] << 24) | in[len - 1] |
+			   ((uint32_t)len << 8);
+		flip1 = (read32(secret) ^ read32(secret + 4)) + seed;
+		return xxh64_avalanche(combined ^ flip1);
+	}
+	return xxh64_avalanche(seed ^ read64(secret + 56) ^ read64(secret + 64));
+}
+
+/*
+ * XXH3-64 of 17 to 240 bytes
+ *
+ * @in [in]: input
+ * @len [in]: length
+ * @seed [in]: seed
+ * @return: hash
+ */
+static inline uint64_t
+xxh3_17to240(const uint8_t *in, size_t len, uint64_t seed)
+{
+	const uint8_t *secret = xxh3_secret;
+	uint64_t acc = len * P64_1;
+	size_t i;
+
+	if (len <= 128) {
+		if (len > 32) {
+			if (len > 64) {
+				if (len > 96) {
+					acc += xxh3_mix16(in + 48, secret + 96, seed);
+					acc += xxh3_mix16(in + len - 64, secret + 112, seed);
+				}
+				acc += xxh3_mix16(in + 32, secret + 64, seed);
+				acc += xxh3_mix16(in + len - 48, secret + 80, seed);
+			}
+			acc += xxh3_mix16(in + 16, secret + 32, seed);
+			acc += xxh3_mix16(in + len - 32, secret + 48, seed);
+		}
+		acc += xxh3_mix16(in, secret, seed);
+		acc += xxh3_mix16(in + len - 16, secret + 16, seed);
+		return xxh3_avalanche(acc);
+	}
+
+	for (i = 0; i < 8; i++)
+		acc += xxh3_mix16(in + 16 * i, secret + 16 * i, seed);
+	acc = xxh3_avalanche(acc);
+	for (i = 8; i < len / 16; i++)
+		acc += xxh3_mix16(in + 16 * i, secret + 16 * (i - 8) + XXH3_MIDSIZE_START, seed);
+	acc += xxh3_mix16(in + len - 16, secret + XXH3_SECRET_SIZE_MIN - XXH3_MIDSIZE_LAST, seed);
+	return xxh3_avalanche(acc);
+}
+
+/*
+ * Portable XXH3 stripe kernel
+ */
+static void
+xxh3_accumulate_scalar(uint64_t *acc, const uint8_t *in, const uint8_t *secret, size_t nb_stripes)
+{
+	uint64_t data, key;
+	size_t n;
+	int i;
+
+	for (n = 0; n < nb_stripes; n++, in += XXH3_STRIPE_LEN, secret += XXH3_SECRET_CONSUME) {
+		for (i = 0; i < 8; i++) {
+			data = read64(in + 8 * i);
+			key = data ^ read64(secret + 8 * i);
+			acc[i ^ 1] += data;
+			acc[i] += (key & 0xffffffff) * (key >> 32);
+		}
+	}
+}
+
+/*
+ * Portable XXH3 scramble kernel
+ */
+static void
+xxh3_scramble_scalar(uint64_t *acc, const uint8_t *secret)
+{
+	int i;
+
+	for (i = 0; i < 8; i++)
+		acc[i] = (acc[i] ^ (acc[i] >> 47) ^ read64(secret + 8 * i)) * P32_1;
+}
+
+/*
+ * XXH3-64 of more than 240 bytes
+ *
+ * @in [in]: input
+ * @len [in]: length
+ * @secret [in]: secret, XXH3_SECRET_SIZE bytes
+ * @accumulate [in]: stripe kernel
+ * @scramble [in]: scramble kernel
+ * @return: hash
+ */
+static uint64_t
+xxh3_long(const uint8_t *in, size_t len, const uint8_t *secret, xxh3_accumulate_fn accumulate,
+	  xxh3_scramble_fn scramble)
+{
+	uint64_t acc[8] __attribute__((aligned(64))) = {P32_3, P64_1, P64_2, P64_3, P64_4, P32_2, P64_5, P32_1};
+	const size_t stripes_per_block = (XXH3_SECRET_SIZE - XXH3_STRIPE_LEN) / XXH3_SECRET_CONSUME;
+	const size_t block_len = XXH3_STRIPE_LEN * stripes_per_block;
+	size_t nb_blocks = (len - 1) / block_len, n;
+	uint64_t result = len * P64_1;
+	int i;
+
+	for (n = 0; n < nb_blocks; n++) {
+		accumulate(acc, in + n * block_len, secret, stripes_per_block);
+		scramble(acc, secret + XXH3_SECRET_SIZE - XXH3_STRIPE_LEN);
+	}
+	accumulate(acc, in + nb_blocks * block_len, secret, ((len - 1) - block_len * nb_blocks) / XXH3_STRIPE_LEN);
+	accumulate(acc, in + len - XXH3_STRIPE_LEN, secret + XXH3_SECRET_SIZE - XXH3_STRIPE_LEN - XXH3_LASTACC_START,
+		   1);
+
+	for (i = 0; i < 4; i++)
+		result += mul128_fold64(acc[2 * i] ^ read64(secret + XXH3_MERGEACCS_START + 16 * i),
+					acc[2 * i + 1] ^ read64(secret + XXH3_MERGEACCS_START + 16 * i + 8));
+	return xxh3_avalanche(result);
+}
+
+uint64_t
+xxh3_64_with(const void *key, size_t len, uint64_t seed, xxh3_accumulate_fn accumulate, xxh3_scramble_fn scramble)
+{
+	uint8_t custom[XXH3_SECRET_SIZE] __attribute__((aligned(64)));
+	const uint8_t *in = key;
+	uint64_t lo, hi;
+	int i;
+
+	if (len <= 16)
+		return xxh3_0to16(in, len, seed);
+	if (len <= XXH3_MIDSIZE_MAX)
+		return xxh3_17to240(in, len, seed);
+	if (seed == 0)
+		return xxh3_long(in, len, xxh3_secret, accumulate, scramble);
+
+	/* Long seeded inputs run on a secret derived from the seed */
+	for (i = 0; i < XXH3_SECRET_SIZE / 16; i++) {
+		lo = read64(xxh3_secret + 16 * i) + seed;
+		hi = read64(xxh3_secret + 16 * i + 8) - seed;
+		memcpy(custom + 16 * i, &lo, sizeof(lo));
+		memcpy(custom + 16 * i + 8, &hi, sizeof(hi));
+	}
+	return xxh3_long(in, len, custom, accumulate, scramble);
+}
+
+uint64_t
+xxh3_64(const void *key, size_t len, uint64_t seed)
+{
+	return xxh3_64_with(key, len, seed, xxh3_accumulate_scalar, xxh3_scramble_scalar);
+}
+
+void
+xxh3_64_batch(const uint8_t *const *keys, size_t len, uint64_t seed, uint64_t *out, size_t n)
+{
+	size_t i;
+
+	/*
+	 * XXH3 needs 64x64-bit multiplies, which neither AVX2 nor NEON has, so the batch picks the length path once
+	 * and lets the core overlap the inlined per-key code
+	 */
+	if (len <= 16) {
+		for (i = 0; i < n; i++)
+			out[i] = xxh3_0to16(keys[i], len, seed);
+	} else if (len <= XXH3_MIDSIZE_MAX) {
+		for (i = 0; i < n; i++)
+			out[i] = xxh3_17to240(keys[i], len, seed);
+	} else {
+		for (i = 0; i < n; i++)
+			out[i] = xxh3_64(keys[i], len, seed);
+	}
+}
@@ -0,0 +1,801 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+#define _GNU_SOURCE
+#include <getopt.h>
+#include <linux/perf_event.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+#include "hashbench.h"
+
+#define DEFAULT_BULK_KB 256		/* Bulk input, the smhasher speed test size */
+#define DEFAULT_REPS 10			/* Runs of every point, the best one is reported */
+#define BULK_BYTES_PER_REP (64UL << 20)	/* Bytes hashed per bulk run */
+#define LAT_HASHES_PER_REP 100000	/* Dependent hashes per latency run */
+#define CALIBRATE_MS 100		/* Timer calibration window */
+#define MAX_KEY_SIZES 16		/* Most key sizes of -k */
+#define MAX_KEY_LEN 256			/* Longest key of -k */
+#define VERIFY_LONG (64UL << 10)	/* Long input of the self-check, past the 3-way CRC32C blocks */
+#define POOL_KEYS 4096			/* Keys of the batch test, as if taken from many request buffers */
+#define BATCH_KEYS_PER_REP (1UL << 20)	/* Keys hashed per batch run */
+#define MAX_BATCH 64			/* Largest batch of -n */
+#define LIST_SEP ","			/* Separator of the -H, -B, -m, -k and -n lists */
+
+/*
+ * Always-true support check of the portable hashes
+ *
+ * @return: 1
+ */
+static int
+portable(void)
+{
+	return 1;
+}
+
+#if defined(__aarch64__)
+/*
+ * Support check of the ARMv8 CRC32C hashes, the NEON ones are always supported
+ *
+ * @return: non-zero if the CPU has the CRC32 instructions
+ */
+static int
+has_crc32(void)
+{
+	return arm_has_crc32();
+}
+#endif
+
+/* Suite, in output order, with the self-check code of every hash */
+static const struct {
+	struct hash_impl impl;		/* Hash */
+	uint32_t check;			/* Expected self-check code */
+} hashes[] = {
+	{{"fnv1a_32", 32, fnv1a_32, portable}, 0x2f2b8fb4},
+	{{"fnv1a_64", 64, fnv1a_64, portable}, 0x038b79d9},
+	{{"murmur3_32", 32, murmur3_32, portable}, 0x4abd4db5},
+	{{"murmur3_128", 128, murmur3_128, portable}, 0x59816623},
+	{{"xxh32", 32, xxh32, portable}, 0xc01eed75},
+	{{"xxh64", 64, xxh64, portable}, 0x1f07ec33},
+	{{"xxh3", 64, xxh3_64, portable}, 0x9c1da0ea},
+#if defined(__x86_64__)
+	{{"xxh3_avx2", 64, xxh3_64_avx2, x86_has_avx2}, 0x9c1da0ea},
+#endif
+#if defined(__aarch64__)
+	{{"xxh3_neon", 64, xxh3_64_neon, arm_has_neon}, 0x9c1da0ea},
+#endif
+	{{"city64", 64, city64, portable}, 0x46cfc0f7},
+	{{"siphash24", 64, siphash24, portable}, 0xe145b9dc},
+	{{"crc32c_sw", 32, crc32c_sw, portable}, 0xe27ea64b},
+#if defined(__x86_64__)
+	{{"crc32c_sse42", 32, crc32c_sse42, x86_has_sse42}, 0xe27ea64b},
+	{{"crc32c_sse42_3way", 32, crc32c_sse42_3way, x86_has_sse42}, 0xe27ea64b},
+#endif
+#if defined(__aarch64__)
+	{{"crc32c_armv8", 32, crc32c_armv8, has_crc32}, 0xe27ea64b},
+	{{"crc32c_armv8_3way", 32, crc32c_armv8_3way, has_crc32}, 0xe27ea64b},
+#endif
+};
+#define NB_HASHES (sizeof(hashes) / sizeof(hashes[0]))
+
+/* Batched hashes, each checked against and timed next to a loop over its per-key hash */
+static const struct hash_batch_impl batches[] = {
+	{"murmur3_32_batch", murmur3_32, murmur3_32_batch, portable},
+#if defined(__x86_64__)
+	{"murmur3_32_batch_avx2", murmur3_32, murmur3_32_batch_avx2, x86_has_avx2},
+#endif
+#if defined(__aarch64__)
+	{"murmur3_32_batch_neon", murmur3_32, murmur3_32_batch_neon, arm_has_neon},
+#endif
+	{"xxh32_batch", xxh32, xxh32_batch, portable},
+#if defined(__x86_64__)
+	{"xxh32_batch_avx2", xxh32, xxh32_batch_avx2, x86_has_avx2},
+#endif
+#if defined(__aarch64__)
+	{"xxh32_batch_neon", xxh32, xxh32_batch_neon, arm_has_neon},
+#endif
+	{"xxh3_batch", xxh3_64, xxh3_64_batch, portable},
+#if defined(__x86_64__)
+	{"crc32c_sse42_batch", crc32c_sse42, crc32c_sse42_batch, x86_has_sse42},
+#endif
+#if defined(__aarch64__)
+	{"crc32c_armv8_batch", crc32c_armv8, crc32c_armv8_batch, has_crc32},
+#endif
+};
+#define NB_BATCHES (sizeof(batches) / sizeof(batches[0]))
+
+/* Benchmark configuration, from the command line */
+struct hashbench_config {
+	bool selected[NB_HASHES];	/* Hashes to run */
+	bool selected_batch[NB_BATCHES];/* Batched hashes to run */
+	bool bulk;			/* Run the bulk bandwidth test */
+	bool latency;			/* Run the small-key latency test */
+	bool batch;			/* Run the batched against per-key test */
+	size_t bulk_bytes;		/* Bulk input size */
+	size_t key_sizes[MAX_KEY_SIZES];/* Small-key sizes */
+	int nb_key_sizes;		/* Number of small-key sizes */
+	int batch_sizes[MAX_KEY_SIZES];	/* Keys per batch */
+	int nb_batch_sizes;		/* Number of batch sizes */
+	int reps;			/* Runs of every point */
+	int core;			/* Core to pin to */
+	bool verify_only;		/* Only print the self-check codes */
+};
+
+static double ticks_per_ns;		/* Timer frequency, from calibrate_timer() */
+static int cycles_fd = -1;		/* perf core-cycle counter, -1 if unavailable */
+static volatile uint64_t sink;		/* Keeps the hashes alive */
+
+/*
+ * Read the fixed-frequency cycle timer: TSC on x86, the generic timer on Arm
+ *
+ * @return: ticks
+ */
+static inline uint64_t
+read_ticks(void)
+{
+#if defined(__x86_64__)
+	unsigned int aux;
+
+	return __rdtscp(&aux);
+#elif defined(__aarch64__)
+	uint64_t v;
+
+	__asm__ volatile("isb; mrs %0, cntvct_el0" : "=r"(v) : : "memory");
+	return v;
+#else
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+#endif
+}
+
+/*
+ * Current CLOCK_MONOTONIC time
+ *
+ * @return: time in nanoseconds
+ */
+static double
+now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/*
+ * Measure the timer frequency against CLOCK_MONOTONIC, so results are in ns without a hand-entered clock period
+ */
+static void
+calibrate_timer(void)
+{
+	struct timespec wait = {0, CALIBRATE_MS * 1000000L};
+	uint64_t t0, t1;
+	double n0, n1;
+
+	n0 = now_ns();
+	t0 = read_ticks();
+	nanosleep(&wait, NULL);
+	n1 = now_ns();
+	t1 = read_ticks();
+	ticks_per_ns = (t1 - t0) / (n1 - n0);
+}
+
+/*
+ * Open a user-space core-cycle counter on this thread, for cycles per hash
+ */
+static void
+open_cycles(void)
+{
+	struct perf_event_attr attr;
+
+	memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = PERF_TYPE_HARDWARE;
+	attr.config = PERF_COUNT_HW_CPU_CYCLES;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	cycles_fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+/*
+ * Read the core-cycle counter
+ *
+ * @return: cycles, 0 if the counter is unavailable
+ */
+static uint64_t
+read_cycles(void)
+{
+	uint64_t v = 0;
+
+	if (cycles_fd < 0 || read(cycles_fd, &v, sizeof(v)) != sizeof(v))
+		return 0;
+	return v;
+}
+
+/*
+ * Fill a buffer with reproducible pseudo-random bytes
+ *
+ * @buf [out]: buffer
+ * @len [in]: length
+ */
+static void
+fill_random(uint8_t *buf, size_t len)
+{
+	uint64_t state = 0x9e3779b97f4a7c15ULL;
+	size_t i;
+
+	for (i = 0; i < len; i++) {
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		buf[i] = state;
+	}
+}
+
+/*
+ * Self-check code of a hash: smhasher-style keys of 0 to 255 bytes hashed into one more hash, mixed with the
+ * hash of a long input
+ *
+ * @fn [in]: hash
+ * @long_buf [in]: VERIFY_LONG + 13 bytes of fill_random() data
+ * @return: code
+ */
+static uint32_t
+check_code(hash_fn fn, const uint8_t *long_buf)
+{
+	uint8_t key[256];
+	uint64_t out[256];
+	int i;
+
+	for (i = 0; i < 256; i++) {
+		key[i] = i;
+		out[i] = fn(key, i, 256 - i);
+	}
+	return fn(out, sizeof(out), 0) ^ fn(long_buf, VERIFY_LONG + 13, 1);
+}
+
+/*
+ * Bulk bandwidth of a hash
+ *
+ * @cfg [in]: configuration
+ * @impl [in]: hash
+ * @buf [in]: input of bulk_bytes
+ * @return: best GB/s over the runs
+ */
+static double
+run_bulk(const struct hashbench_config *cfg, const struct hash_impl *impl, const uint8_t *buf)
+{
+	size_t iters = BULK_BYTES_PER_REP / cfg->bulk_bytes, i;
+	double best = 0, gbps;
+	uint64_t t0, t1, h = 0;
+	int r;
+
+	if (iters == 0)
+		iters = 1;
+	for (r = 0; r < cfg->reps; r++) {
+		t0 = read_ticks();
+		for (i = 0; i < iters; i++)
+			h += impl->fn(buf, cfg->bulk_bytes, i);
+		t1 = read_ticks();
+		gbps = cfg->bulk_bytes * iters / ((t1 - t0) / ticks_per_ns);
+		if (gbps > best)
+			best = gbps;
+	}
+	sink ^= h;
+	return best;
+}
+
+/*
+ * Small-key latency of a hash: every key takes the previous hash, so each hash waits for the one before
+ *
+ * @cfg [in]: configuration
+ * @impl [in]: hash
+ * @len [in]: key length
+ * @cycles [out]: core cycles per hash of the best run, 0 without a cycle counter
+ * @return: best ns per hash over the runs
+ */
+static double
+run_latency(const struct hashbench_config *cfg, const struct hash_impl *impl, size_t len, double *cycles)
+{
+	uint8_t key[MAX_KEY_LEN] __attribute__((aligned(64)));
+	uint64_t t0, t1, c0, c1, h = 0;
+	double best = 0, ns;
+	size_t n = len < sizeof(h) ? len : sizeof(h);
+	int r, i;
+
+	fill_random(key, sizeof(key));
+	*cycles = 0;
+	for (r = 0; r < cfg->reps; r++) {
+		c0 = read_cycles();
+		t0 = read_ticks();
+		for (i = 0; i < LAT_HASHES_PER_REP; i++) {
+			/* One store-to-load forward per hash is part of the chain */
+			memcpy(key, &h, n);
+			h = impl->fn(key, len, 0);
+		}
+		t1 = read_ticks();
+		c1 = read_cycles();
+		ns = (t1 - t0) / ticks_per_ns / LAT_HASHES_PER_REP;
+		if (best == 0 || ns < best) {
+			best = ns;
+			*cycles = (double)(c1 - c0) / LAT_HASHES_PER_REP;
+		}
+	}
+	sink ^= h;
+	return best;
+}
+
+/*
+ * Check a batched hash against its per-key hash for every key length up to 64 and every batch size up to 33
+ *
+ * @impl [in]: batched hash
+ * @keys [in]: at least 33 keys of 64 bytes
+ * @return: 0 if every result matches and -1 otherwise
+ */
+static int
+check_batch(const struct hash_batch_impl *impl, const uint8_t *const *keys)
+{
+	uint64_t out[33];
+	size_t len, n, i;
+
+	for (len = 0; len <= 64; len++) {
+		for (n = 1; n <= 33; n++) {
+			impl->batch(keys, len, len * 7, out, n);
+			for (i = 0; i < n; i++) {
+				if (out[i] != impl->single(keys[i], len, len * 7))
+					return -1;
+			}
+		}
+	}
+	return 0;
+}
+
+/*
+ * Per-key throughput of a batched hash and of a loop calling its per-key hash on the same batches
+ *
+ * @cfg [in]: configuration
+ * @impl [in]: batched hash
+ * @keys [in]: POOL_KEYS keys
+ * @len [in]: key length
+ * @batch [in]: keys per batch
+ * @loop_ns [out]: best ns per key of the per-key loop
+ * @return: best ns per key of the batched hash
+ */
+static double
+run_batch(const struct hashbench_config *cfg, const struct hash_batch_impl *impl, const uint8_t *const *keys,
+	  size_t len, int batch, double *loop_ns)
+{
+	size_t rounds = BATCH_KEYS_PER_REP / POOL_KEYS, k, i;
+	uint64_t out[MAX_BATCH], t0, t1, h = 0;
+	double best = 0, ns;
+	int r, j;
+
+	*loop_ns = 0;
+	for (r = 0; r < cfg->reps; r++) {
+		t0 = read_ticks();
+		for (k = 0; k < rounds; k++) {
+			for (i = 0; i + batch <= POOL_KEYS; i += batch) {
+				for (j = 0; j < batch; j++)
+					out[j] = impl->single(keys[i + j], len, 0);
+				h += out[0] ^ out[batch - 1];
+			}
+		}
+		t1 = read_ticks();
+		ns = (t1 - t0) / ticks_per_ns / (rounds * (POOL_KEYS / batch * batch));
+		if (*loop_ns == 0 || ns < *loop_ns)
+			*loop_ns = ns;
+
+		t0 = read_ticks();
+		for (k = 0; k < rounds; k++) {
+			for (i = 0; i + batch <= POOL_KEYS; i += batch) {
+				impl->batch(keys + i, len, 0, out, batch);
+				h += out[0] ^ out[batch - 1];
+			}
+		}
+		t1 = read_ticks();
+		ns = (t1 - t0) / ticks_per_ns / (rounds * (POOL_KEYS / batch * batch));
+		if (best == 0 || ns < best)
+			best = ns;
+	}
+	sink ^= h;
+	return best;
+}
+
+/*
+ * Parse a comma separated list of names
+ *
+ * @list [in]: list, modified
+ * @names [in]: known names
+ * @nb_names [in]: number of known names
+ * @selected [out]: one flag per known name
+ * @return: 0 on success and -1 otherwise
+ */
+static int
+parse_names(char *list, const char *const *names, size_t nb_names, bool *selected)
+{
+	char *tok, *saveptr;
+	size_t n;
+
+	memset(selected, 0, sizeof(bool) * nb_names);
+	for (tok = strtok_r(list, LIST_SEP, &saveptr); tok != NULL; tok = strtok_r(NULL, LIST_SEP, &saveptr)) {
+		for (n = 0; n < nb_names; n++) {
+			if (strcmp(tok, names[n]) == 0)
+				break;
+		}
+		if (n == nb_names) {
+			fprintf(stderr, "Unknown %s, not built for this architecture?\n", tok);
+			return -1;
+		}
+		selected[n] = true;
+	}
+	return 0;
+}
+
+/*
+ * Parse a comma separated list of batch sizes
+ *
+ * @list [in]: list, modified
+ * @cfg [out]: configuration receiving the sizes
+ * @return: 0 on success and -1 otherwise
+ */
+static int
+parse_batch_sizes(char *list, struct hashbench_config *cfg)
+{
+	char *tok, *saveptr;
+	int n;
+
+	cfg->nb_batch_sizes = 0;
+	for (tok = strtok_r(list, LIST_SEP, &saveptr); tok != NULL; tok = strtok_r(NULL, LIST_SEP, &saveptr)) {
+		n = atoi(tok);
+		if (n < 1 || n > MAX_BATCH || cfg->nb_batch_sizes == MAX_KEY_SIZES) {
+			fprintf(stderr, "Batch size %s must be in [1, %d]\n", tok, MAX_BATCH);
+			return -1;
+		}
+		cfg->batch_sizes[cfg->nb_batch_sizes++] = n;
+	}
+	return 0;
+}
+
+/*
+ * Parse a comma separated list of key sizes
+ *
+ * @list [in]: list, modified
+ * @cfg [out]: configuration receiving the sizes
+ * @return: 0 on success and -1 otherwise
+ */
+static int
+parse_key_sizes(char *list, struct hashbench_config *cfg)
+{
+	char *tok, *saveptr;
+	long len;
+
+	cfg->nb_key_sizes = 0;
+	for (tok = strtok_r(list, LIST_SEP, &saveptr); tok != NULL; tok = strtok_r(NULL, LIST_SEP, &saveptr)) {
+		len = atol(tok);
+		if (len < 1 || len > MAX_KEY_LEN || cfg->nb_key_sizes == MAX_KEY_SIZES) {
+			fprintf(stderr, "Key size %s must be in [1, %d]\n", tok, MAX_KEY_LEN);
+			return -1;
+		}
+		cfg->key_sizes[cfg->nb_key_sizes++] = len;
+	}
+	return 0;
+}
+
+/*
+ * Print the usage
+ *
+ * @prog [in]: program name
+ */
+static void
+usage(const char *prog)
+{
+	size_t h;
+
+	printf("Usage: %s [-H hashes] [-B batched] [-m bulk,latency,batch] [-b KB] [-k sizes] [-n sizes] [-r reps]"
+	       " [-c core] [-V]\n", prog);
+	printf("Hash bulk bandwidth, small-key latency and batched small-key throughput, timed with the TSC or\n");
+	printf("the Arm generic timer. Every result is also printed as one of\n");
+	printf("  HASHBW <hash> <bytes> <GB/s>\n");
+	printf("  HASHLAT <hash> <key bytes> <ns> <cycles>\n");
+	printf("  HASHBATCH <batched> <key bytes> <batch> <per-key loop ns> <batched ns> <speedup>\n");
+	printf("  -H, --hashes <list>      built here:");
+	for (h = 0; h < NB_HASHES; h++)
+		printf("%s%s", h ? "," : " ", hashes[h].impl.name);
+	printf("\n                           (default: all the CPU supports)\n");
+	printf("  -B, --batched <list>     built here:");
+	for (h = 0; h < NB_BATCHES; h++)
+		printf("%s%s", h ? "," : " ", batches[h].name);
+	printf("\n                           (default: all the CPU supports)\n");
+	printf("  -m, --mode <list>        bulk, latency, batch (default: all)\n");
+	printf("  -b, --bulk <KB>          bulk input size (default: %d)\n", DEFAULT_BULK_KB);
+	printf("  -k, --keys <list>        small-key sizes in bytes (default: 8,16,24,32,48,64)\n");
+	printf("  -n, --batch <list>       keys per batch, at most %d (default: 8,16,32)\n", MAX_BATCH);
+	printf("  -r, --reps <n>           runs of every point, the best one is reported (default: %d)\n",
+	       DEFAULT_REPS);
+	printf("  -c, --core <n>           core to pin to (default: 0)\n");
+	printf("  -V, --verify             only print the self-check code of every hash\n");
+}
+
+/*
+ * Hash benchmark main function
+ *
+ * @argc [in]: command line arguments size
+ * @argv [in]: array of command line arguments
+ * @return: EXIT_SUCCESS on success and EXIT_FAILURE otherwise
+ */
+int
+main(int argc, char **argv)
+{
+	static const struct option long_opts[] = {
+		{"hashes", required_argument, NULL, 'H'},
+		{"batched", required_argument, NULL, 'B'},
+		{"mode", required_argument, NULL, 'm'},
+		{"bulk", required_argument, NULL, 'b'},
+		{"keys", required_argument, NULL, 'k'},
+		{"batch", required_argument, NULL, 'n'},
+		{"reps", required_argument, NULL, 'r'},
+		{"core", required_argument, NULL, 'c'},
+		{"verify", no_argument, NULL, 'V'},
+		{"help", no_argument, NULL, 'h'},
+		{NULL, 0, NULL, 0},
+	};
+	static const size_t default_keys[] = {8, 16, 24, 32, 48, 64};
+	static const int default_batches[] = {8, 16, 32};
+	const char *hash_names[NB_HASHES], *batch_names[NB_BATCHES];
+	const uint8_t *keys[POOL_KEYS];
+	struct hashbench_config cfg = {0};
+	int c, i, exit_status = EXIT_SUCCESS;
+	bool explicit_hashes = false, explicit_batches = false;
+	char *tok, *saveptr;
+	uint8_t *buf, *long_buf, *pool;
+	double lat_ns[MAX_KEY_SIZES], lat_cycles[MAX_KEY_SIZES], gbps, loop_ns, batch_ns;
+	uint32_t code;
+	cpu_set_t set;
+	size_t h, len;
+	int j;
+
+	for (h = 0; h < NB_HASHES; h++) {
+		hash_names[h] = hashes[h].impl.name;
+		cfg.selected[h] = true;
+	}
+	for (h = 0; h < NB_BATCHES; h++) {
+		batch_names[h] = batches[h].name;
+		cfg.selected_batch[h] = true;
+	}
+	cfg.bulk = true;
+	cfg.latency = true;
+	cfg.batch = true;
+	cfg.bulk_bytes = (size_t)DEFAULT_BULK_KB << 10;
+	for (i = 0; i < (int)(sizeof(default_keys) / sizeof(default_keys[0])); i++)
+		cfg.key_sizes[cfg.nb_key_sizes++] = default_keys[i];
+	for (i = 0; i < (int)(sizeof(default_batches) / sizeof(default_batches[0])); i++)
+		cfg.batch_sizes[cfg.nb_batch_sizes++] = default_batches[i];
+	cfg.reps = DEFAULT_REPS;
+
+	while ((c = getopt_long(argc, argv, "H:B:m:b:k:n:r:c:Vh", long_opts, NULL)) != -1) {
+		switch (c) {
+		case 'H':
+			if (parse_names(optarg, hash_names, NB_HASHES, cfg.selected) != 0)
+				return EXIT_FAILURE;
+			explicit_hashes = true;
+			break;
+		case 'B':
+			if (parse_names(optarg, batch_names, NB_BATCHES, cfg.selected_batch) != 0)
+				return EXIT_FAILURE;
+			explicit_batches = true;
+			break;
+		case 'm':
+			cfg.bulk = false;
+			cfg.latency = false;
+			cfg.batch = false;
+			for (tok = strtok_r(optarg, LIST_SEP, &saveptr); tok != NULL;
+			     tok = strtok_r(NULL, LIST_SEP, &saveptr)) {
+				if (strcmp(tok, "bulk") == 0) {
+					cfg.bulk = true;
+				} else if (strcmp(tok, "latency") == 0) {
+					cfg.latency = true;
+				} else if (strcmp(tok, "batch") == 0) {
+					cfg.batch = true;
+				} else {
+					fprintf(stderr, "Unknown mode %s\n", tok);
+					return EXIT_FAILURE;
+				}
+			}
+			break;
+		case 'b':
+			cfg.bulk_bytes = strtoull(optarg, NULL, 0) << 10;
+			break;
+		case 'k':
+			if (parse_key_sizes(optarg, &cfg) != 0)
+				return EXIT_FAILURE;
+			break;
+		case 'n':
+			if (parse_batch_sizes(optarg, &cfg) != 0)
+				return EXIT_FAILURE;
+			break;
+		case 'r':
+			cfg.reps = atoi(optarg);
+			break;
+		case 'c':
+			cfg.core = atoi(optarg);
+			break;
+		case 'V':
+			cfg.verify_only = true;
+			break;
+		case 'h':
+			usage(argv[0]);
+			return EXIT_SUCCESS;
+		default:
+			usage(argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+	if (cfg.reps < 1 || cfg.bulk_bytes == 0) {
+		fprintf(stderr, "At least 1 run and a 1 KB bulk input are needed\n");
+		return EXIT_FAILURE;
+	}
+
+	CPU_ZERO(&set);
+	CPU_SET(cfg.core, &set);
+	if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+		fprintf(stderr, "Failed to pin to core %d\n", cfg.core);
+		return EXIT_FAILURE;
+	}
+	crc32c_init();
+	buf = aligned_alloc(64, (cfg.bulk_bytes + VERIFY_LONG + 13 + 63) & ~(size_t)63);
+	if (buf == NULL) {
+		fprintf(stderr, "Failed to allocate the input\n");
+		return EXIT_FAILURE;
+	}
+	long_buf = buf + cfg.bulk_bytes;
+	fill_random(long_buf, VERIFY_LONG + 13);
+	/* Keys of a batch only share their length, each starts on its own cache line of the pool */
+	pool = aligned_alloc(64, (size_t)POOL_KEYS * MAX_KEY_LEN);
+	if (pool == NULL) {
+		fprintf(stderr, "Failed to allocate the key pool\n");
+		free(buf);
+		return EXIT_FAILURE;
+	}
+	fill_random(pool, (size_t)POOL_KEYS * MAX_KEY_LEN);
+	for (i = 0; i < POOL_KEYS; i++)
+		keys[i] = pool + (size_t)i * 64;
+
+	/* A hash is only timed once it returns the same values as the reference on this CPU */
+	for (h = 0; h < NB_HASHES; h++) {
+		if (!cfg.selected[h])
+			continue;
+		if (!hashes[h].impl.supported()) {
+			if (explicit_hashes)
+				fprintf(stderr, "This CPU does not support %s, skipped\n", hashes[h].impl.name);
+			cfg.selected[h] = false;
+			continue;
+		}
+		code = check_code(hashes[h].impl.fn, long_buf);
+		if (cfg.verify_only) {
+			printf("%-20s 0x%08x %s\n", hashes[h].impl.name, code, code == hashes[h].check ? "ok" : "FAIL");
+		} else if (code != hashes[h].check) {
+			fprintf(stderr, "%s self-check failed (0x%08x, expected 0x%08x), skipped\n",
+				hashes[h].impl.name, code, hashes[h].check);
+			cfg.selected[h] = false;
+			exit_status = EXIT_FAILURE;
+		}
+	}
+	/* A batched hash is only timed once it returns the same values as its per-key hash */
+	for (h = 0; h < NB_BATCHES; h++) {
+		if (!cfg.selected_batch[h])
+			continue;
+		if (!batches[h].supported()) {
+			if (explicit_batches)
+				fprintf(stderr, "This CPU does not support %s, skipped\n", batches[h].name);
+			cfg.selected_batch[h] = false;
+			continue;
+		}
+		if (check_batch(&batches[h], keys) == 0) {
+			if (cfg.verify_only)
+				printf("%-22s ok\n", batches[h].name);
+			continue;
+		}
+		fprintf(stderr, "%s differs from its per-key hash, skipped\n", batches[h].name);
+		cfg.selected_batch[h] = false;
+		exit_status = EXIT_FAILURE;
+	}
+	if (cfg.verify_only) {
+		free(pool);
+		free(buf);
+		return exit_status;
+	}
+
+	calibrate_timer();
+	open_cycles();
+	printf("Timer %.3f GHz, core cycles %s\n\n", ticks_per_ns, cycles_fd >= 0 ? "from perf" : "unavailable");
+
+	if (cfg.bulk) {
+		fill_random(buf, cfg.bulk_bytes);
+		printf("Bulk bandwidth, %zu KB input\n", cfg.bulk_bytes >> 10);
+		printf("Hash\t\t\t GB/s\n");
+		for (h = 0; h < NB_HASHES; h++) {
+			if (!cfg.selected[h])
+				continue;
+			gbps = run_bulk(&cfg, &hashes[h].impl, buf);
+			printf("%-20s\t %.2f\n", hashes[h].impl.name, gbps);
+			printf("HASHBW %s %zu %.3f\n", hashes[h].impl.name, cfg.bulk_bytes, gbps);
+			fflush(stdout);
+		}
+		printf("\n");
+	}
+
+	if (cfg.latency) {
+		printf("Small-key latency, ns per hash (core cycles)\n");
+		printf("Hash\t\t");
+		for (i = 0; i < cfg.nb_key_sizes; i++)
+			printf("\t %zuB", cfg.key_sizes[i]);
+		printf("\n");
+		for (h = 0; h < NB_HASHES; h++) {
+			if (!cfg.selected[h])
+				continue;
+			for (i = 0; i < cfg.nb_key_sizes; i++)
+				lat_ns[i] = run_latency(&cfg, &hashes[h].impl, cfg.key_sizes[i], &lat_cycles[i]);
+			printf("%-20s", hashes[h].impl.name);
+			for (i = 0; i < cfg.nb_key_sizes; i++) {
+				if (lat_cycles[i] > 0)
+					printf("\t %.2f (%.0f)", lat_ns[i], lat_cycles[i]);
+				else
+					printf("\t %.2f", lat_ns[i]);
+			}
+			printf("\n");
+			for (i = 0; i < cfg.nb_key_sizes; i++)
+				printf("HASHLAT %s %zu %.3f %.1f\n", hashes[h].impl.name, cfg.key_sizes[i], lat_ns[i],
+				       lat_cycles[i]);
+			fflush(stdout);
+		}
+		printf("\n");
+	}
+
+	if (cfg.batch) {
+		printf("Batched small keys, ns per key of a per-key loop and of the batched hash, %d keys\n",
+		       POOL_KEYS);
+		printf("Batched\t\t\tKey\tBatch\t Loop\t Batched Speedup\n");
+		for (h = 0; h < NB_BATCHES; h++) {
+			if (!cfg.selected_batch[h])
+				continue;
+			for (i = 0; i < cfg.nb_key_sizes; i++) {
+				len = cfg.key_sizes[i];
+				for (j = 0; j < POOL_KEYS; j++)
+					keys[j] = pool + (size_t)j * ((len + 63) & ~(size_t)63);
+				for (j = 0; j < cfg.nb_batch_sizes; j++) {
+					batch_ns = run_batch(&cfg, &batches[h], keys, len, cfg.batch_sizes[j],
+							     &loop_ns);
+					printf("%-22s\t%zu\t%d\t %.2f\t %.2f\t %.2fx\n", batches[h].name, len,
+					       cfg.batch_sizes[j], loop_ns, batch_ns, loop_ns / batch_ns);
+					printf("HASHBATCH %s %zu %d %.3f %.3f %.3f\n", batches[h].name, len,
+					       cfg.batch_sizes[j], loop_ns, batch_ns, loop_ns / batch_ns);
+					fflush(stdout);
+				}
+			}
+		}
+	}
+	free(pool);
+	free(buf);
+	return exit_status;
+}
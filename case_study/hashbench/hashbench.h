@@ -0,0 +1,259 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+#ifndef HASHBENCH_H_
+#define HASHBENCH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/* Every hash takes a key, its length and a seed and returns its low 64 bits */
+typedef uint64_t (*hash_fn)(const void *key, size_t len, uint64_t seed);
+
+/* One hash implementation of the suite */
+struct hash_impl {
+	const char *name;		/* Name given to -H */
+	int bits;			/* Width of the full hash */
+	hash_fn fn;			/* Hash */
+	int (*supported)(void);		/* Non-zero if this CPU can run it */
+};
+
+/*
+ * Batched hash: keys[i] hashed into out[i] for n keys of one length, the result of the per-key hash
+ */
+typedef void (*hash_batch_fn)(const uint8_t *const *keys, size_t len, uint64_t seed, uint64_t *out, size_t n);
+
+/*
+ * Hash exactly HASH_BATCH_LANES keys at once
+ */
+typedef void (*hash_lanes_fn)(const uint8_t *const *keys, size_t len, uint64_t seed, uint64_t *out);
+
+/* One batched hash of the suite */
+struct hash_batch_impl {
+	const char *name;		/* Name given to -B */
+	hash_fn single;			/* Per-key hash it must match */
+	hash_batch_fn batch;		/* Batched hash */
+	int (*supported)(void);		/* Non-zero if this CPU can run it */
+};
+
+#define HASH_BATCH_LANES 8		/* Keys in flight at once: one AVX2 register, two NEON registers */
+
+/*
+ * XXH3 long-input kernel: accumulate nb_stripes 64-byte stripes into the 8 accumulators
+ */
+typedef void (*xxh3_accumulate_fn)(uint64_t *acc, const uint8_t *in, const uint8_t *secret, size_t nb_stripes);
+
+/*
+ * XXH3 long-input kernel: scramble the accumulators at the end of a block
+ */
+typedef void (*xxh3_scramble_fn)(uint64_t *acc, const uint8_t *secret);
+
+#define XXH3_SECRET_SIZE 192		/* Size of the default secret */
+#define XXH3_STRIPE_LEN 64		/* Input consumed by one accumulate step */
+#define XXH3_SECRET_CONSUME 8		/* Secret advance per stripe */
+
+#define CRC32C_LONG 8192		/* Block of the 3-way hardware CRC32C for long inputs */
+#define CRC32C_SHORT 256		/* Block of the 3-way hardware CRC32C for the tail */
+
+/* Tables that shift a CRC32C past CRC32C_LONG or CRC32C_SHORT zero bytes, built by crc32c_init() */
+extern uint32_t crc32c_long[4][256];
+extern uint32_t crc32c_short[4][256];
+
+/*
+ * Unaligned little-endian 32-bit load
+ *
+ * @p [in]: address
+ * @return: value
+ */
+static inline uint32_t
+read32(const uint8_t *p)
+{
+	uint32_t v;
+
+	memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+/*
+ * Unaligned little-endian 64-bit load
+ *
+ * @p [in]: address
+ * @return: value
+ */
+static inline uint64_t
+read64(const uint8_t *p)
+{
+	uint64_t v;
+
+	memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+/*
+ * 32-bit rotate left
+ *
+ * @v [in]: value
+ * @r [in]: bits, 1 to 31
+ * @return: rotated value
+ */
+static inline uint32_t
+rotl32(uint32_t v, int r)
+{
+	return (v << r) | (v >> (32 - r));
+}
+
+/*
+ * 64-bit rotate left
+ *
+ * @v [in]: value
+ * @r [in]: bits, 1 to 63
+ * @return: rotated value
+ */
+static inline uint64_t
+rotl64(uint64_t v, int r)
+{
+	return (v << r) | (v >> (64 - r));
+}
+
+/*
+ * Little-endian load of the last 1 to 3 bytes of a key, as Murmur3 reads its tail
+ *
+ * @p [in]: tail
+ * @n [in]: bytes, 0 to 3
+ * @return: value
+ */
+static inline uint32_t
+read_tail32(const uint8_t *p, size_t n)
+{
+	uint32_t v = 0;
+
+	switch (n) {
+	case 3:
+		v ^= (uint32_t)p[2] << 16;
+		/* fallthrough */
+	case 2:
+		v ^= (uint32_t)p[1] << 8;
+		/* fallthrough */
+	case 1:
+		v ^= p[0];
+	}
+	return v;
+}
+
+/*
+ * Run a batch as groups of HASH_BATCH_LANES keys, the remainder one key at a time
+ *
+ * @lanes [in]: group kernel
+ * @single [in]: per-key hash
+ * @keys [in]: keys
+ * @len [in]: length of every key
+ * @seed [in]: seed
+ * @out [out]: one hash per key
+ * @n [in]: number of keys
+ */
+static inline void
+hash_batch_run(hash_lanes_fn lanes, hash_fn single, const uint8_t *const *keys, size_t len, uint64_t seed,
+	       uint64_t *out, size_t n)
+{
+	size_t i;
+
+	for (i = 0; i + HASH_BATCH_LANES <= n; i += HASH_BATCH_LANES)
+		lanes(keys + i, len, seed, out + i);
+	for (; i < n; i++)
+		out[i] = single(keys[i], len, seed);
+}
+
+/*
+ * Build the CRC32C tables, must run before any CRC32C hash
+ */
+void crc32c_init(void);
+
+/*
+ * Shift a CRC32C register past a block of zero bytes
+ *
+ * @table [in]: crc32c_long or crc32c_short
+ * @crc [in]: register
+ * @return: shifted register
+ */
+static inline uint32_t
+crc32c_shift(uint32_t table[4][256], uint32_t crc)
+{
+	return table[0][crc & 0xff] ^ table[1][(crc >> 8) & 0xff] ^ table[2][(crc >> 16) & 0xff] ^
+	       table[3][crc >> 24];
+}
+
+/*
+ * Run XXH3-64 with a given long-input kernel
+ *
+ * @key [in]: key
+ * @len [in]: key length
+ * @seed [in]: seed
+ * @accumulate [in]: stripe kernel for inputs over 240 bytes
+ * @scramble [in]: scramble kernel for inputs over 240 bytes
+ * @return: 64-bit hash
+ */
+uint64_t xxh3_64_with(const void *key, size_t len, uint64_t seed, xxh3_accumulate_fn accumulate,
+		      xxh3_scramble_fn scramble);
+
+/*
+ * SipHash-2-4 with a full 128-bit key
+ *
+ * @key [in]: message
+ * @len [in]: message length
+ * @k0 [in]: low half of the key
+ * @k1 [in]: high half of the key
+ * @return: 64-bit hash
+ */
+uint64_t siphash24_key(const void *key, size_t len, uint64_t k0, uint64_t k1);
+
+/* Portable hashes, hash_generic.c, hash_xxhash.c and hash_city.c */
+uint64_t fnv1a_32(const void *key, size_t len, uint64_t seed);
+uint64_t fnv1a_64(const void *key, size_t len, uint64_t seed);
+uint64_t murmur3_32(const void *key, size_t len, uint64_t seed);
+uint64_t murmur3_128(const void *key, size_t len, uint64_t seed);
+uint64_t siphash24(const void *key, size_t len, uint64_t seed);
+uint64_t crc32c_sw(const void *key, size_t len, uint64_t seed);
+uint64_t xxh32(const void *key, size_t len, uint64_t seed);
+uint64_t xxh64(const void *key, size_t len, uint64_t seed);
+uint64_t xxh3_64(const void *key, size_t len, uint64_t seed);
+uint64_t city64(const void *key, size_t len, uint64_t seed);
+
+/* Interleaved scalar batches, next to their per-key hashes */
+void murmur3_32_batch(const uint8_t *const *keys, size_t len, uint64_t seed, uint64_t *out, size_t n);
+void xxh32_batch(const uint8_t *const *keys, size_t len, uint64_t seed, uint64_t *out, size_t n);
+void xxh3_64_batch(const uint8_t *const *keys, size_t len, uint64_t seed, uint64_t *out, size_t n);
+
+#if defined(__x86_64__)
+/* SSE4.2 CRC32C, AVX2 XXH3 and AVX2 batches, hash_x86.c */
+int x86_has_sse42(void);
+int x86_has_avx2(void);
+uint64_t crc32c_sse42(const void *key, size_t len, uint64_t seed);
+uint64_t crc32c_sse42_3way(const void *key, size_t len, uint64_t seed);
+uint64_t xxh3_64_avx2(const void *key, size_t len, uint64_t seed);
+void murmur3_32_batch_avx2(const uint8_t *const *keys, size_t len, uint64_t seed, uint64_t *out, size_t n);
+void xxh32_batch_avx2(const uint8_t *const *keys, size_t len, uint64_t seed, uint64_t *out, size_t n);
+void crc32c_sse42_batch(const uint8_t *const *keys, size_t len, uint64_t seed, uint64_t *out, size_t n);
+#endif
+
+#if defined(__aarch64__)
+/* ARMv8 CRC32C, NEON XXH3 and NEON batches, hash_arm.c */
+int arm_has_crc32(void);
+int arm_has_neon(void);
+uint64_t crc32c_armv8(const void *key, size_t len, uint64_t seed);
+uint64_t crc32c_armv8_3way(const void *key, size_t len, uint64_t seed);
+uint64_t xxh3_64_neon(const void *key, size_t len, uint64_t seed);
+void murmur3_32_batch_neon(const uint8_t *const *keys, size_t len, uint64_t seed, uint64_t *out, size_t n);
+void xxh32_batch_neon(const uint8_t *const *keys, size_t len, uint64_t seed, uint64_t *out, size_t n);
+void crc32c_armv8_batch(const uint8_t *const *keys, size_t len, uint64_t seed, uint64_t *out, size_t n);
+#endif
+
+#endif /* HASHBENCH_H_ */
@@ -0,0 +1,345 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <doca_buf.h>
+#include <doca_buf_inventory.h>
+#include <doca_dev.h>
+#include <doca_error.h>
+#include <doca_log.h>
+#include <doca_mmap.h>
+
+#include "dma_common.h"
+
+DOCA_LOG_REGISTER(BUF_INVENTORY_SCALE_DPU);
+
+#define SLOT_SIZE 64			/* Memory behind every doca_buf */
+#define DATA_LEN 32			/* Data length set by doca_buf_set_data */
+#define SET_DATA_PASSES 4		/* set_data/reset_data_len passes over the live buffers */
+#define MAX_THREADS 8			/* Largest number of threads */
+#define MAX_BUFS (1U << 20)		/* Largest inventory */
+#define STRIDE 7919			/* Odd stride, visits live buffers out of allocation order */
+
+/* Inventory sizes of the sweeps */
+static const uint32_t sizes[] = {1024, 16384, 131072, MAX_BUFS};
+#define NB_SIZES (sizeof(sizes) / sizeof(sizes[0]))
+
+/* Inventory operations, in the order they run */
+enum inv_op {
+	OP_GET,			/* doca_buf_inventory_buf_get_by_addr */
+	OP_SET_DATA,		/* doca_buf_set_data */
+	OP_RESET,		/* doca_buf_reset_data_len */
+	OP_DEC_REFCOUNT,	/* doca_buf_dec_refcount, returns the buffer to the inventory */
+	NB_OPS,
+};
+
+static const char *const op_names[NB_OPS] = {"get_by_addr", "set_data", "reset_data_len", "dec_refcount"};
+
+/* One thread with its own mmap and inventory */
+struct inv_worker {
+	struct doca_dev *dev;		/* DOCA device */
+	uint32_t capacity;		/* Inventory capacity */
+	uint32_t live;			/* Buffers held at the same time */
+	char *mem;			/* live * SLOT_SIZE bytes */
+	struct doca_mmap *mmap;		/* Local mmap over mem */
+	struct doca_buf_inventory *inv;	/* Inventory of this thread */
+	struct doca_buf **bufs;		/* Live buffers */
+	volatile int *go;		/* Set to 1 once all threads exist, -1 to abort */
+	double ns[NB_OPS];		/* Time spent in every operation */
+	uint64_t ops[NB_OPS];		/* Number of operations */
+	doca_error_t result;		/* First error of the thread */
+};
+
+/*
+ * Elapsed time between two timestamps
+ *
+ * @start [in]: start timestamp
+ * @end [in]: end timestamp
+ * @return: elapsed time in nanoseconds
+ */
+static double
+elapsed_ns(const struct timespec *start, const struct timespec *end)
+{
+	return (end->tv_sec - start->tv_sec) * 1e9 + (end->tv_nsec - start->tv_nsec);
+}
+
+/*
+ * Create the mmap and inventory of a worker, not part of the measurement
+ *
+ * @w [in]: worker
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+setup_worker(struct inv_worker *w)
+{
+	doca_error_t result;
+
+	w->mem = calloc(w->live, SLOT_SIZE);
+	w->bufs = calloc(w->live, sizeof(*w->bufs));
+	if (w->mem == NULL || w->bufs == NULL) {
+		DOCA_LOG_ERR("Failed to allocate %u buffers", w->live);
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	result = doca_mmap_create(&w->mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Unable to create mmap: %s", doca_error_get_descr(result));
+		return result;
+	}
+	result = doca_mmap_add_dev(w->mmap, w->dev);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_set_memrange(w->mmap, w->mem, (size_t)w->live * SLOT_SIZE);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_start(w->mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Unable to start mmap: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_buf_inventory_create(w->capacity, &w->inv);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Unable to create buffer inventory: %s", doca_error_get_descr(result));
+		return result;
+	}
+	result = doca_buf_inventory_start(w->inv);
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Unable to start buffer inventory: %s", doca_error_get_descr(result));
+	return result;
+}
+
+/*
+ * Destroy the mmap and inventory of a worker
+ *
+ * @w [in]: worker
+ */
+static void
+teardown_worker(struct inv_worker *w)
+{
+	if (w->inv != NULL) {
+		doca_buf_inventory_stop(w->inv);
+		doca_buf_inventory_destroy(w->inv);
+	}
+	if (w->mmap != NULL)
+		doca_mmap_destroy(w->mmap);
+	free(w->bufs);
+	free(w->mem);
+}
+
+/*
+ * Worker thread: fill the inventory, touch every live buffer, return them all
+ *
+ * @arg [in]: worker
+ * @return: NULL
+ */
+static void *
+run_worker(void *arg)
+{
+	struct inv_worker *w = arg;
+	struct timespec start, end;
+	doca_error_t result = DOCA_SUCCESS;
+	uint32_t i, idx;
+	int pass;
+
+	/* Start all threads together */
+	while (*w->go == 0)
+		;
+	if (*w->go < 0)
+		return NULL;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < w->live && result == DOCA_SUCCESS; i++)
+		result = doca_buf_inventory_buf_get_by_addr(w->inv, w->mmap, w->mem + (size_t)i * SLOT_SIZE,
+							    SLOT_SIZE, &w->bufs[i]);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to get buffer %u: %s", i - 1, doca_error_get_descr(result));
+		w->result = result;
+		w->live = i - 1;
+		goto put_bufs;
+	}
+	w->ns[OP_GET] += elapsed_ns(&start, &end);
+	w->ops[OP_GET] += w->live;
+
+	for (pass = 0; pass < SET_DATA_PASSES && result == DOCA_SUCCESS; pass++) {
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		for (i = 0, idx = 0; i < w->live && result == DOCA_SUCCESS; i++, idx = (idx + STRIDE) % w->live)
+			result = doca_buf_set_data(w->bufs[idx], w->mem + (size_t)idx * SLOT_SIZE, DATA_LEN);
+		clock_gettime(CLOCK_MONOTONIC, &end);
+		w->ns[OP_SET_DATA] += elapsed_ns(&start, &end);
+		w->ops[OP_SET_DATA] += w->live;
+
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		for (i = 0, idx = 0; i < w->live && result == DOCA_SUCCESS; i++, idx = (idx + STRIDE) % w->live)
+			result = doca_buf_reset_data_len(w->bufs[idx]);
+		clock_gettime(CLOCK_MONOTONIC, &end);
+		w->ns[OP_RESET] += elapsed_ns(&start, &end);
+		w->ops[OP_RESET] += w->live;
+	}
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to update buffer data: %s", doca_error_get_descr(result));
+		w->result = result;
+	}
+
+put_bufs:
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < w->live; i++) {
+		result = doca_buf_dec_refcount(w->bufs[i], NULL);
+		if (result != DOCA_SUCCESS && w->result == DOCA_SUCCESS)
+			w->result = result;
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	w->ns[OP_DEC_REFCOUNT] += elapsed_ns(&start, &end);
+	w->ops[OP_DEC_REFCOUNT] += w->live;
+
+	return NULL;
+}
+
+/*
+ * Measure one (capacity, live buffers, threads) point
+ *
+ * @dev [in]: DOCA device
+ * @capacity [in]: inventory capacity of every thread
+ * @live [in]: buffers every thread holds at the same time
+ * @nb_threads [in]: number of threads, each one with its own inventory
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+measure_point(struct doca_dev *dev, uint32_t capacity, uint32_t live, int nb_threads)
+{
+	struct inv_worker workers[MAX_THREADS];
+	pthread_t threads[MAX_THREADS];
+	volatile int go = 0;
+	doca_error_t result = DOCA_SUCCESS;
+	double lat_ns, max_ns;
+	uint64_t total_ops;
+	int t, nb_started = 0, op;
+
+	memset(workers, 0, sizeof(workers));
+	for (t = 0; t < nb_threads; t++) {
+		workers[t].dev = dev;
+		workers[t].capacity = capacity;
+		workers[t].live = live;
+		workers[t].go = &go;
+		result = setup_worker(&workers[t]);
+		if (result != DOCA_SUCCESS)
+			goto teardown;
+	}
+
+	for (nb_started = 0; nb_started < nb_threads; nb_started++) {
+		if (pthread_create(&threads[nb_started], NULL, run_worker, &workers[nb_started]) != 0) {
+			DOCA_LOG_ERR("Failed to create worker thread");
+			result = DOCA_ERROR_OPERATING_SYSTEM;
+			break;
+		}
+	}
+	go = result == DOCA_SUCCESS ? 1 : -1;
+	for (t = 0; t < nb_started; t++)
+		pthread_join(threads[t], NULL);
+
+	for (t = 0; t < nb_threads; t++)
+		DOCA_ERROR_PROPAGATE(result, workers[t].result);
+	if (result != DOCA_SUCCESS)
+		goto teardown;
+
+	printf("%9u\t %9u\t %7d", capacity, live, nb_threads);
+	for (op = 0; op < NB_OPS; op++) {
+		lat_ns = 0;
+		max_ns = 0;
+		total_ops = 0;
+		for (t = 0; t < nb_threads; t++) {
+			lat_ns += workers[t].ns[op] / workers[t].ops[op];
+			if (workers[t].ns[op] > max_ns)
+				max_ns = workers[t].ns[op];
+			total_ops += workers[t].ops[op];
+		}
+		/* Average per-operation latency of the threads, aggregate throughput over the slowest thread */
+		printf("\t %8.1f\t %8.2f", lat_ns / nb_threads, total_ops / max_ns * 1000);
+	}
+	printf("\n");
+	fflush(stdout);
+
+teardown:
+	for (t = 0; t < nb_threads; t++)
+		teardown_worker(&workers[t]);
+	return result;
+}
+
+/*
+ * Print the column header
+ */
+static void
+print_header(void)
+{
+	int op;
+
+	printf("%9s\t %9s\t %7s", "Capacity", "Live bufs", "Threads");
+	for (op = 0; op < NB_OPS; op++)
+		printf("\t %8s\t %8s", "ns/op", "Mops");
+	printf("\n%9s\t %9s\t %7s", "", "", "");
+	for (op = 0; op < NB_OPS; op++)
+		printf("\t %-19s", op_names[op]);
+	printf("\n");
+}
+
+/*
+ * Run doca_buf_inventory scaling benchmark on the DPU
+ *
+ * @pcie_addr [in]: Device PCI address
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t
+buf_inventory_scale_dpu(const char *pcie_addr)
+{
+	struct doca_dev *dev;
+	doca_error_t result, tmp_result;
+	size_t i;
+	int t;
+
+	result = open_doca_device_with_pci(pcie_addr, &dma_task_is_supported, &dev);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to open DOCA device: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	/* Inventories that are always full, as sized by create_core_objects() */
+	printf("Full inventories, capacity = live buffers\n");
+	print_header();
+	for (i = 0; i < NB_SIZES && result == DOCA_SUCCESS; i++)
+		result = measure_point(dev, sizes[i], sizes[i], 1);
+
+	/* One large inventory with a growing number of live buffers */
+	printf("\nLive buffers in a %u-entry inventory\n", MAX_BUFS);
+	print_header();
+	for (i = 0; i < NB_SIZES && result == DOCA_SUCCESS; i++)
+		result = measure_point(dev, MAX_BUFS, sizes[i], 1);
+
+	/* Separate inventories per thread */
+	printf("\nThreads with separate inventories\n");
+	print_header();
+	for (i = 0; i < NB_SIZES && result == DOCA_SUCCESS; i++) {
+		for (t = 1; t <= MAX_THREADS && result == DOCA_SUCCESS; t *= 2)
+			result = measure_point(dev, sizes[i], sizes[i], t);
+	}
+
+	tmp_result = doca_dev_close(dev);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+		DOCA_LOG_ERR("Failed to close DOCA device: %s", doca_error_get_descr(tmp_result));
+	}
+
+	return result;
+}
@@ -0,0 +1,17 @@
+# /*
+# * Copyright (c) 2025, University of California, Merced. All rights reserved.
+# *
+# * This file is part of the benchmarking software package developed by
+# * the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+# *
+# * For detailed copyright and licensing information, please refer to the license
+# * file LICENSE in the top level directory.
+# *
+# */
+
+# Runs on the DPU only, no host side is needed.
+make clean
+make
+echo ""
+
+./doca_buf_inventory_scale -p 03:00.0
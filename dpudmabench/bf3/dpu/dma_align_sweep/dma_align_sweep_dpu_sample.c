@@ -0,0 +1,519 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <doca_buf.h>
+#include <doca_buf_inventory.h>
+#include <doca_dma.h>
+#include <doca_error.h>
+#include <doca_log.h>
+#include <doca_mmap.h>
+#include <doca_pe.h>
+
+#include "dma_common.h"
+#include "utils.h"
+
+DOCA_LOG_REGISTER(DMA_ALIGN_SWEEP_DPU);
+
+#define RECV_BUF_SIZE 256		/* Buffer which contains config information */
+#define MAX_DESC_SIZE 1024		/* Maximum size of the export descriptor */
+#define LAT_ITERATIONS 1000		/* Latency iterations per (offset, offset) cell */
+#define THR_REPS 10			/* Batches of NUM_DMA_TASKS tasks per throughput cell */
+#define OFFSET_ROOM 4096		/* Buffer space reserved for the offsets */
+
+/* Data-flow direction of a DPU-initiated transfer */
+enum sweep_direction {
+	SWEEP_PULL,	/* DPU reads host memory (dma_read_d_to_h) */
+	SWEEP_PUSH,	/* DPU writes host memory (dma_write_d_to_h) */
+};
+
+/* Byte offsets from a page-aligned base: aligned, sub-cacheline, cacheline edges, mid-page and page crossing */
+static const size_t offsets[] = {0, 1, 8, 32, 63, 64, 65, 127, 2048, 4032, 4095};
+#define NB_OFFSETS (sizeof(offsets) / sizeof(offsets[0]))
+
+/* Header-, packet- and value-sized payloads, most of them not a multiple of 64 */
+static const size_t sizes[] = {60, 64, 100, 1000, 1500, 4096, 4097, 65535};
+#define NB_SIZES (sizeof(sizes) / sizeof(sizes[0]))
+
+/*
+ * Saves export descriptor and buffer information content into memory buffers
+ *
+ * @export_desc_file_path [in]: Export descriptor file path
+ * @buffer_info_file_path [in]: Buffer information file path
+ * @export_desc [in]: Export descriptor buffer
+ * @export_desc_len [in]: Export descriptor buffer length
+ * @remote_addr [in]: Remote buffer address
+ * @remote_addr_len [in]: Remote buffer total length
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+save_config_info_to_buffers(const char *export_desc_file_path, const char *buffer_info_file_path, char *export_desc,
+			    size_t *export_desc_len, char **remote_addr, size_t *remote_addr_len)
+{
+	FILE *fp;
+	long file_size;
+	char buffer[RECV_BUF_SIZE];
+
+	fp = fopen(export_desc_file_path, "r");
+	if (fp == NULL) {
+		DOCA_LOG_ERR("Failed to open %s", export_desc_file_path);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	if (fseek(fp, 0, SEEK_END) != 0) {
+		DOCA_LOG_ERR("Failed to calculate file size");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	file_size = ftell(fp);
+	if (file_size == -1) {
+		DOCA_LOG_ERR("Failed to calculate file size");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	if (file_size > MAX_DESC_SIZE)
+		file_size = MAX_DESC_SIZE;
+
+	*export_desc_len = file_size;
+
+	if (fseek(fp, 0L, SEEK_SET) != 0) {
+		DOCA_LOG_ERR("Failed to calculate file size");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	if (fread(export_desc, 1, file_size, fp) != (size_t)file_size) {
+		DOCA_LOG_ERR("Failed to read the export descriptor");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	fclose(fp);
+
+	/* Read source buffer information from file */
+	fp = fopen(buffer_info_file_path, "r");
+	if (fp == NULL) {
+		DOCA_LOG_ERR("Failed to open %s", buffer_info_file_path);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	/* Get source buffer address */
+	if (fgets(buffer, RECV_BUF_SIZE, fp) == NULL) {
+		DOCA_LOG_ERR("Failed to read the source (host) buffer address");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+	*remote_addr = (char *)strtoull(buffer, NULL, 0);
+
+	memset(buffer, 0, RECV_BUF_SIZE);
+
+	/* Get source buffer length */
+	if (fgets(buffer, RECV_BUF_SIZE, fp) == NULL) {
+		DOCA_LOG_ERR("Failed to read the source (host) buffer length");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+	*remote_addr_len = strtoull(buffer, NULL, 0);
+
+	fclose(fp);
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Elapsed time between two timestamps
+ *
+ * @start [in]: start timestamp
+ * @end [in]: end timestamp
+ * @return: elapsed time in nanoseconds
+ */
+static double
+elapsed_ns(const struct timespec *start, const struct timespec *end)
+{
+	return (end->tv_sec - start->tv_sec) * 1e9 + (end->tv_nsec - start->tv_nsec);
+}
+
+/*
+ * Point every task at the source and destination offsets for one direction and size
+ *
+ * @resources [in]: DMA resources
+ * @direction [in]: data-flow direction
+ * @size [in]: payload size
+ * @src_off [in]: offset of the source data from its page-aligned base
+ * @dst_off [in]: offset of the destination data from its page-aligned base
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+prepare_tasks(struct dma_resources *resources, enum sweep_direction direction, size_t size, size_t src_off,
+	      size_t dst_off)
+{
+	struct doca_buf *src, *dst;
+	char *src_addr, *dst_addr;
+	doca_error_t result;
+	int i;
+
+	for (i = 0; i < NUM_DMA_TASKS; i++) {
+		if (direction == SWEEP_PULL) {
+			src = resources->dst_doca_buf_array[i];
+			dst = resources->src_doca_buf_array[i];
+			src_addr = resources->remote_addr + src_off;
+			dst_addr = resources->dpu_buffer + dst_off;
+		} else {
+			src = resources->src_doca_buf_array[i];
+			dst = resources->dst_doca_buf_array[i];
+			src_addr = resources->dpu_buffer + src_off;
+			dst_addr = resources->remote_addr + dst_off;
+		}
+
+		result = doca_buf_set_data(src, src_addr, size);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to set data for DOCA source buffer: %s", doca_error_get_descr(result));
+			return result;
+		}
+		/* Empty data section at the offset, the completion callback only resets its length */
+		result = doca_buf_set_data(dst, dst_addr, 0);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to set data for DOCA destination buffer: %s", doca_error_get_descr(result));
+			return result;
+		}
+
+		doca_dma_task_memcpy_set_src(resources->tasks[i], src);
+		doca_dma_task_memcpy_set_dst(resources->tasks[i], dst);
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Submit the first num tasks
+ *
+ * @resources [in]: DMA resources
+ * @num [in]: number of tasks to submit
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+submit_tasks(struct dma_resources *resources, int num)
+{
+	doca_error_t result;
+	int i;
+
+	resources->num_remaining_tasks = num;
+	for (i = 0; i < num; i++) {
+		result = doca_task_submit(doca_dma_task_memcpy_as_task(resources->tasks[i]));
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to submit DMA task: %s", doca_error_get_descr(result));
+			return result;
+		}
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Measure polling latency and throughput of one (source offset, destination offset) cell
+ *
+ * @resources [in]: DMA resources
+ * @direction [in]: data-flow direction
+ * @size [in]: payload size
+ * @src_off [in]: source offset
+ * @dst_off [in]: destination offset
+ * @lat_us [out]: average latency in microseconds
+ * @mops [out]: throughput in Mops
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+measure_cell(struct dma_resources *resources, enum sweep_direction direction, size_t size, size_t src_off,
+	     size_t dst_off, double *lat_us, double *mops)
+{
+	struct timespec start, end;
+	doca_error_t result;
+	int i;
+
+	result = prepare_tasks(resources, direction, size, src_off, dst_off);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < LAT_ITERATIONS; i++) {
+		result = submit_tasks(resources, 1);
+		if (result != DOCA_SUCCESS)
+			return result;
+		result = dma_wait_tasks(resources, false);
+		if (result != DOCA_SUCCESS)
+			return result;
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	*lat_us = elapsed_ns(&start, &end) / LAT_ITERATIONS / 1000;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < THR_REPS; i++) {
+		result = submit_tasks(resources, NUM_DMA_TASKS);
+		if (result != DOCA_SUCCESS)
+			return result;
+		result = dma_wait_tasks(resources, false);
+		if (result != DOCA_SUCCESS)
+			return result;
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	*mops = (double)THR_REPS * NUM_DMA_TASKS / elapsed_ns(&start, &end) * 1000;
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Print a penalty map, one row per source offset and one column per destination offset
+ *
+ * @title [in]: map title
+ * @values [in]: measured values
+ * @higher_is_better [in]: true for throughput, false for latency
+ */
+static void
+print_penalty_map(const char *title, double values[NB_OFFSETS][NB_OFFSETS], bool higher_is_better)
+{
+	double base = values[0][0], penalty;
+	size_t s, d;
+
+	printf("%s, penalty (%%) vs. src_off=0 dst_off=0\n", title);
+	printf("src\\dst");
+	for (d = 0; d < NB_OFFSETS; d++)
+		printf("\t %6zu", offsets[d]);
+	printf("\n");
+	for (s = 0; s < NB_OFFSETS; s++) {
+		printf("%7zu", offsets[s]);
+		for (d = 0; d < NB_OFFSETS; d++) {
+			if (higher_is_better)
+				penalty = (base - values[s][d]) / base * 100;
+			else
+				penalty = (values[s][d] - base) / base * 100;
+			printf("\t %6.1f", penalty);
+		}
+		printf("\n");
+	}
+}
+
+/*
+ * Sweep all offset pairs for one direction and size
+ *
+ * @resources [in]: DMA resources
+ * @direction [in]: data-flow direction
+ * @size [in]: payload size
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+sweep_offsets(struct dma_resources *resources, enum sweep_direction direction, size_t size)
+{
+	static double lat[NB_OFFSETS][NB_OFFSETS], mops[NB_OFFSETS][NB_OFFSETS];
+	const char *dir_name = direction == SWEEP_PULL ? "pull" : "push";
+	doca_error_t result;
+	size_t s, d;
+
+	for (s = 0; s < NB_OFFSETS; s++) {
+		for (d = 0; d < NB_OFFSETS; d++) {
+			result = measure_cell(resources, direction, size, offsets[s], offsets[d], &lat[s][d],
+					      &mops[s][d]);
+			if (result != DOCA_SUCCESS)
+				return result;
+			/* ALIGN <direction> <size> <src_off> <dst_off> <lat_us> <mops> <gbps> */
+			printf("ALIGN %s %zu %zu %zu %.3f %.4f %.3f\n", dir_name, size, offsets[s], offsets[d],
+			       lat[s][d], mops[s][d], mops[s][d] * size / 1000);
+		}
+	}
+
+	printf("\nDMA (%s) (polling), dst_buffer_size: %zu\n", direction == SWEEP_PULL ? "read D-to-H" : "write D-to-H",
+	       size);
+	print_penalty_map("Avg Lat(us)", lat, false);
+	print_penalty_map("Throughput (Mops)", mops, true);
+	printf("\n");
+	fflush(stdout);
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Run DOCA DMA alignment sweep on the DPU
+ *
+ * @export_desc_file_path [in]: Export descriptor file path
+ * @buffer_info_file_path [in]: Buffer info file path
+ * @pcie_addr [in]: Device PCI address
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t
+dma_align_sweep_dpu(const char *export_desc_file_path, const char *buffer_info_file_path, const char *pcie_addr)
+{
+	struct dma_resources resources;
+	struct program_core_objects *state = &resources.state;
+	union doca_data task_user_data = {0};
+	char export_desc[MAX_DESC_SIZE] = {0};
+	size_t export_desc_len = 0;
+	uint64_t max_buffer_size;
+	doca_error_t result, tmp_result, task_result = DOCA_SUCCESS;
+	size_t max_size, skew;
+	int i, nb_bufs = 0, nb_tasks = 0;
+	size_t k;
+
+	/* Allocate resources, every point polls so no event handle is needed */
+	result = allocate_dma_resources(pcie_addr, &resources);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to allocate DMA resources: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	/* Connect context to progress engine */
+	result = doca_pe_connect_ctx(state->pe, state->ctx);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to connect progress engine to context: %s", doca_error_get_descr(result));
+		goto destroy_resources;
+	}
+
+	result = doca_ctx_start(state->ctx);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start context: %s", doca_error_get_descr(result));
+		goto destroy_resources;
+	}
+
+	/* Get maximum buffer size allowed */
+	result = doca_dma_cap_task_memcpy_get_max_buf_size(doca_dev_as_devinfo(state->dev), &max_buffer_size);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to get max buffer size: %s", doca_error_get_descr(result));
+		goto stop_dma;
+	}
+
+	/* Copy all relevant information into local buffers */
+	result = save_config_info_to_buffers(export_desc_file_path, buffer_info_file_path, export_desc,
+					     &export_desc_len, &resources.remote_addr, &resources.remote_addr_len);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to read memory configuration from file: %s", doca_error_get_descr(result));
+		goto stop_dma;
+	}
+
+	/* Offsets are taken from the first page boundary of the exported host buffer */
+	skew = (OFFSET_ROOM - ((uintptr_t)resources.remote_addr % OFFSET_ROOM)) % OFFSET_ROOM;
+	if (resources.remote_addr_len <= skew + OFFSET_ROOM) {
+		DOCA_LOG_ERR("Host buffer of %zu bytes is too small for the offset sweep", resources.remote_addr_len);
+		result = DOCA_ERROR_INVALID_VALUE;
+		goto stop_dma;
+	}
+	resources.remote_addr += skew;
+	resources.remote_addr_len -= skew;
+
+	max_size = MIN(resources.remote_addr_len, max_buffer_size);
+	resources.dst_buffer_size = max_size;
+	if (posix_memalign((void **)&resources.dpu_buffer, OFFSET_ROOM, max_size) != 0) {
+		DOCA_LOG_ERR("Failed to allocate memory for DPU buffer");
+		resources.dpu_buffer = NULL;
+		result = DOCA_ERROR_NO_MEMORY;
+		goto free_dpu_buffer;
+	}
+	memset(resources.dpu_buffer, '0', max_size);
+	printf("Offsets from page-aligned bases, payloads up to %zu bytes\n", max_size - OFFSET_ROOM);
+
+	result = doca_mmap_set_memrange(state->dst_mmap, resources.dpu_buffer, max_size);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set memory range for destination mmap: %s", doca_error_get_descr(result));
+		goto free_dpu_buffer;
+	}
+
+	result = doca_mmap_start(state->dst_mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start destination mmap: %s", doca_error_get_descr(result));
+		goto free_dpu_buffer;
+	}
+
+	/* Create a local DOCA mmap from exported data */
+	result = doca_mmap_create_from_export(NULL, (const void *)export_desc, export_desc_len, state->dev,
+					      &resources.remote_mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create mmap from export: %s", doca_error_get_descr(result));
+		goto free_dpu_buffer;
+	}
+
+	/* src_doca_buf_array holds the DPU side and dst_doca_buf_array the host side of every task */
+	for (nb_bufs = 0; nb_bufs < NUM_DMA_TASKS; nb_bufs++) {
+		result = doca_buf_inventory_buf_get_by_addr(state->buf_inv, state->dst_mmap, resources.dpu_buffer,
+							    max_size, &resources.src_doca_buf_array[nb_bufs]);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Unable to acquire DOCA buffer representing local buffer: %s",
+				     doca_error_get_descr(result));
+			goto destroy_bufs;
+		}
+		result = doca_buf_inventory_buf_get_by_addr(state->buf_inv, resources.remote_mmap, resources.remote_addr,
+							    max_size, &resources.dst_doca_buf_array[nb_bufs]);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Unable to acquire DOCA buffer representing remote buffer: %s",
+				     doca_error_get_descr(result));
+			doca_buf_dec_refcount(resources.src_doca_buf_array[nb_bufs], NULL);
+			goto destroy_bufs;
+		}
+	}
+
+	task_user_data.ptr = &task_result;
+	for (nb_tasks = 0; nb_tasks < NUM_DMA_TASKS; nb_tasks++) {
+		result = doca_dma_task_memcpy_alloc_init(resources.dma_ctx, resources.src_doca_buf_array[nb_tasks],
+							 resources.dst_doca_buf_array[nb_tasks], task_user_data,
+							 &resources.tasks[nb_tasks]);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to allocate DMA memcpy task: %s", doca_error_get_descr(result));
+			goto free_tasks;
+		}
+	}
+
+	for (k = 0; k < NB_SIZES && sizes[k] + OFFSET_ROOM <= max_size; k++) {
+		result = sweep_offsets(&resources, SWEEP_PULL, sizes[k]);
+		if (result == DOCA_SUCCESS)
+			result = sweep_offsets(&resources, SWEEP_PUSH, sizes[k]);
+		if (result != DOCA_SUCCESS || task_result != DOCA_SUCCESS) {
+			DOCA_ERROR_PROPAGATE(result, task_result);
+			DOCA_LOG_ERR("DMA alignment sweep failed at %zu bytes: %s", sizes[k], doca_error_get_descr(result));
+			break;
+		}
+	}
+
+free_tasks:
+	for (i = 0; i < nb_tasks; i++)
+		doca_task_free(doca_dma_task_memcpy_as_task(resources.tasks[i]));
+destroy_bufs:
+	for (i = 0; i < nb_bufs; i++) {
+		tmp_result = doca_buf_dec_refcount(resources.src_doca_buf_array[i], NULL);
+		DOCA_ERROR_PROPAGATE(tmp_result, doca_buf_dec_refcount(resources.dst_doca_buf_array[i], NULL));
+		if (tmp_result != DOCA_SUCCESS) {
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+			DOCA_LOG_ERR("Failed to decrease DOCA buffer reference count: %s", doca_error_get_descr(tmp_result));
+		}
+	}
+	tmp_result = doca_mmap_destroy(resources.remote_mmap);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+		DOCA_LOG_ERR("Failed to destroy remote mmap: %s", doca_error_get_descr(tmp_result));
+	}
+free_dpu_buffer:
+	free(resources.dpu_buffer);
+stop_dma:
+	tmp_result = request_stop_ctx(state->pe, state->ctx);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+		DOCA_LOG_ERR("Unable to stop context: %s", doca_error_get_descr(tmp_result));
+	}
+	state->ctx = NULL;
+destroy_resources:
+	tmp_result = destroy_dma_resources(&resources);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+		DOCA_LOG_ERR("Failed to destroy DMA resources: %s", doca_error_get_descr(tmp_result));
+	}
+
+	return result;
+}
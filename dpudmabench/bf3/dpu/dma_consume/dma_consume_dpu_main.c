@@ -0,0 +1,92 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <doca_argp.h>
+#include <doca_log.h>
+
+#include "dma_common.h"
+
+DOCA_LOG_REGISTER(DMA_CONSUME_DPU::MAIN);
+
+/* Sample's Logic */
+doca_error_t dma_consume_dpu(const char *export_desc_file_path, const char *buffer_info_file_path,
+			     const char *pcie_addr);
+
+/*
+ * Sample main function
+ *
+ * @argc [in]: command line arguments size
+ * @argv [in]: array of command line arguments
+ * @return: EXIT_SUCCESS on success and EXIT_FAILURE otherwise
+ */
+int
+main(int argc, char **argv)
+{
+	struct dma_config dma_conf;
+	doca_error_t result;
+	struct doca_log_backend *sdk_log;
+	int exit_status = EXIT_FAILURE;
+
+	/* Set the default configuration values (Example values) */
+	strcpy(dma_conf.pci_address, "03:00.0");
+	strcpy(dma_conf.export_desc_path, "/tmp/export_desc.txt");
+	strcpy(dma_conf.buf_info_path, "/tmp/buffer_info.txt");
+	dma_conf.cpy_txt[0] = '\0';
+
+	/* Register a logger backend */
+	result = doca_log_backend_create_standard();
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+
+	/* Register a logger backend for internal SDK errors and warnings */
+	result = doca_log_backend_create_with_file_sdk(stderr, &sdk_log);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+	result = doca_log_backend_set_sdk_level(sdk_log, DOCA_LOG_LEVEL_WARNING);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+
+	result = doca_argp_init("doca_dma_consume_dpu", &dma_conf);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to init ARGP resources: %s", doca_error_get_descr(result));
+		goto sample_exit;
+	}
+	result = register_dma_params(true);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register DMA sample parameters: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+	result = doca_argp_start(argc, argv);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to parse sample input: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	result = dma_consume_dpu(dma_conf.export_desc_path, dma_conf.buf_info_path, dma_conf.pci_address);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("dma_consume_dpu() encountered an error: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	exit_status = EXIT_SUCCESS;
+
+argp_cleanup:
+	doca_argp_destroy();
+sample_exit:
+	if (exit_status == EXIT_SUCCESS)
+		DOCA_LOG_INFO("Sample finished successfully");
+	else
+		DOCA_LOG_INFO("Sample finished with errors");
+	return exit_status;
+}
@@ -0,0 +1,374 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <doca_buf.h>
+#include <doca_buf_inventory.h>
+#include <doca_dma.h>
+#include <doca_error.h>
+#include <doca_log.h>
+#include <doca_mmap.h>
+#include <doca_pe.h>
+
+#include "dma_common.h"
+#include "dma_consume.h"
+
+DOCA_LOG_REGISTER(DMA_CONSUME_DPU);
+
+#define RECV_BUF_SIZE 256		/* Buffer which contains config information */
+#define MAX_DESC_SIZE 1024		/* Maximum size of the export descriptor */
+
+/* Tasks used for every round, each one has its own local and remote buffer */
+enum consume_task {
+	TASK_READ_SEQ,		/* DMA read of the host sequence */
+	TASK_PAYLOAD,		/* DMA write of the payload */
+	TASK_WRITE_SEQ,		/* DMA write of the DPU sequence */
+	NB_CONSUME_TASKS,
+};
+
+/*
+ * Saves export descriptor and buffer information content into memory buffers
+ *
+ * @export_desc_file_path [in]: Export descriptor file path
+ * @buffer_info_file_path [in]: Buffer information file path
+ * @export_desc [in]: Export descriptor buffer
+ * @export_desc_len [in]: Export descriptor buffer length
+ * @remote_addr [in]: Remote buffer address
+ * @remote_addr_len [in]: Remote buffer total length
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+save_config_info_to_buffers(const char *export_desc_file_path, const char *buffer_info_file_path, char *export_desc,
+			    size_t *export_desc_len, char **remote_addr, size_t *remote_addr_len)
+{
+	FILE *fp;
+	long file_size;
+	char buffer[RECV_BUF_SIZE];
+
+	fp = fopen(export_desc_file_path, "r");
+	if (fp == NULL) {
+		DOCA_LOG_ERR("Failed to open %s", export_desc_file_path);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	if (fseek(fp, 0, SEEK_END) != 0) {
+		DOCA_LOG_ERR("Failed to calculate file size");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	file_size = ftell(fp);
+	if (file_size == -1) {
+		DOCA_LOG_ERR("Failed to calculate file size");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	if (file_size > MAX_DESC_SIZE)
+		file_size = MAX_DESC_SIZE;
+
+	*export_desc_len = file_size;
+
+	if (fseek(fp, 0L, SEEK_SET) != 0) {
+		DOCA_LOG_ERR("Failed to calculate file size");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	if (fread(export_desc, 1, file_size, fp) != (size_t)file_size) {
+		DOCA_LOG_ERR("Failed to read the export descriptor");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	fclose(fp);
+
+	/* Read source buffer information from file */
+	fp = fopen(buffer_info_file_path, "r");
+	if (fp == NULL) {
+		DOCA_LOG_ERR("Failed to open %s", buffer_info_file_path);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	/* Get source buffer address */
+	if (fgets(buffer, RECV_BUF_SIZE, fp) == NULL) {
+		DOCA_LOG_ERR("Failed to read the source (host) buffer address");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+	*remote_addr = (char *)strtoull(buffer, NULL, 0);
+
+	memset(buffer, 0, RECV_BUF_SIZE);
+
+	/* Get source buffer length */
+	if (fgets(buffer, RECV_BUF_SIZE, fp) == NULL) {
+		DOCA_LOG_ERR("Failed to read the source (host) buffer length");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+	*remote_addr_len = strtoull(buffer, NULL, 0);
+
+	fclose(fp);
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Run one task to completion
+ *
+ * @resources [in]: DMA resources
+ * @task [in]: task to run
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+run_task(struct dma_resources *resources, enum consume_task task)
+{
+	doca_error_t result;
+
+	resources->num_remaining_tasks = 1;
+	result = doca_task_submit(doca_dma_task_memcpy_as_task(resources->tasks[task]));
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to submit DMA task: %s", doca_error_get_descr(result));
+		return result;
+	}
+	return dma_wait_tasks(resources, false);
+}
+
+/*
+ * Produce payloads for the host consumer until it ends the run
+ *
+ * @resources [in]: DMA resources
+ * @payload_size [in]: payload size
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+produce(struct dma_resources *resources, size_t payload_size)
+{
+	volatile uint64_t *host_seq = (volatile uint64_t *)(resources->dpu_buffer + CONSUME_HOST_SEQ);
+	uint64_t *dpu_seq = (uint64_t *)(resources->dpu_buffer + CONSUME_DPU_SEQ);
+	uint64_t *payload = (uint64_t *)(resources->dpu_buffer + CONSUME_PAYLOAD);
+	uint64_t seq = 0;
+	doca_error_t result;
+
+	for (;;) {
+		/* Poll the host sequence over PCIe until the host releases the next round */
+		do {
+			result = run_task(resources, TASK_READ_SEQ);
+			if (result != DOCA_SUCCESS)
+				return result;
+		} while (*host_seq == seq);
+
+		if (*host_seq == CONSUME_DONE)
+			break;
+		seq = *host_seq;
+
+		/* Every round lands new data, the host checksums it */
+		payload[0] = seq;
+		result = run_task(resources, TASK_PAYLOAD);
+		if (result != DOCA_SUCCESS)
+			return result;
+
+		/* The payload write has completed, only now announce it */
+		*dpu_seq = seq;
+		result = run_task(resources, TASK_WRITE_SEQ);
+		if (result != DOCA_SUCCESS)
+			return result;
+	}
+
+	printf("Produced %" PRIu64 " payloads, dst_buffer_size: %zu\n", seq, payload_size);
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Run DOCA DMA producer for the host consumer measurement on the DPU
+ *
+ * @export_desc_file_path [in]: Export descriptor file path
+ * @buffer_info_file_path [in]: Buffer info file path
+ * @pcie_addr [in]: Device PCI address
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t
+dma_consume_dpu(const char *export_desc_file_path, const char *buffer_info_file_path, const char *pcie_addr)
+{
+	/* Local and remote (offset, length) of every task, the payload length is filled in below */
+	struct {
+		size_t offset;
+		size_t len;
+	} ranges[NB_CONSUME_TASKS] = {
+		[TASK_READ_SEQ] = {CONSUME_HOST_SEQ, sizeof(uint64_t)},
+		[TASK_PAYLOAD] = {CONSUME_PAYLOAD, 0},
+		[TASK_WRITE_SEQ] = {CONSUME_DPU_SEQ, sizeof(uint64_t)},
+	};
+	struct dma_resources resources;
+	struct program_core_objects *state = &resources.state;
+	union doca_data task_user_data = {0};
+	char export_desc[MAX_DESC_SIZE] = {0};
+	size_t export_desc_len = 0;
+	uint64_t max_buffer_size;
+	struct doca_buf *local, *remote;
+	doca_error_t result, tmp_result, task_result = DOCA_SUCCESS;
+	int i, nb_bufs = 0, nb_tasks = 0;
+
+	result = allocate_dma_resources(pcie_addr, &resources);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to allocate DMA resources: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	/* Connect context to progress engine */
+	result = doca_pe_connect_ctx(state->pe, state->ctx);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to connect progress engine to context: %s", doca_error_get_descr(result));
+		goto destroy_resources;
+	}
+
+	result = doca_ctx_start(state->ctx);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start context: %s", doca_error_get_descr(result));
+		goto destroy_resources;
+	}
+
+	/* Get maximum buffer size allowed */
+	result = doca_dma_cap_task_memcpy_get_max_buf_size(doca_dev_as_devinfo(state->dev), &max_buffer_size);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to get max buffer size: %s", doca_error_get_descr(result));
+		goto stop_dma;
+	}
+
+	/* Copy all relevant information into local buffers */
+	result = save_config_info_to_buffers(export_desc_file_path, buffer_info_file_path, export_desc,
+					     &export_desc_len, &resources.remote_addr, &resources.remote_addr_len);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to read memory configuration from file: %s", doca_error_get_descr(result));
+		goto stop_dma;
+	}
+
+	if (resources.remote_addr_len <= CONSUME_PAYLOAD ||
+	    resources.remote_addr_len - CONSUME_PAYLOAD > max_buffer_size) {
+		DOCA_LOG_ERR("Host buffer of %zu bytes does not fit the consume layout", resources.remote_addr_len);
+		result = DOCA_ERROR_INVALID_VALUE;
+		goto stop_dma;
+	}
+	ranges[TASK_PAYLOAD].len = resources.remote_addr_len - CONSUME_PAYLOAD;
+
+	/* The local buffer mirrors the host layout */
+	resources.dst_buffer_size = resources.remote_addr_len;
+	resources.dpu_buffer = (char *)calloc(1, resources.dst_buffer_size);
+	if (resources.dpu_buffer == NULL) {
+		DOCA_LOG_ERR("Failed to allocate memory for DPU buffer");
+		result = DOCA_ERROR_NO_MEMORY;
+		goto stop_dma;
+	}
+	memset(resources.dpu_buffer + CONSUME_PAYLOAD, '1', ranges[TASK_PAYLOAD].len);
+
+	result = doca_mmap_set_memrange(state->dst_mmap, resources.dpu_buffer, resources.dst_buffer_size);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set memory range for destination mmap: %s", doca_error_get_descr(result));
+		goto free_dpu_buffer;
+	}
+
+	result = doca_mmap_start(state->dst_mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start destination mmap: %s", doca_error_get_descr(result));
+		goto free_dpu_buffer;
+	}
+
+	/* Create a local DOCA mmap from exported data */
+	result = doca_mmap_create_from_export(NULL, (const void *)export_desc, export_desc_len, state->dev,
+					      &resources.remote_mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create mmap from export: %s", doca_error_get_descr(result));
+		goto free_dpu_buffer;
+	}
+
+	for (nb_bufs = 0; nb_bufs < NB_CONSUME_TASKS; nb_bufs++) {
+		result = doca_buf_inventory_buf_get_by_addr(state->buf_inv, state->dst_mmap,
+							    resources.dpu_buffer + ranges[nb_bufs].offset,
+							    ranges[nb_bufs].len, &resources.src_doca_buf_array[nb_bufs]);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Unable to acquire DOCA buffer representing local buffer: %s",
+				     doca_error_get_descr(result));
+			goto destroy_bufs;
+		}
+		result = doca_buf_inventory_buf_get_by_addr(state->buf_inv, resources.remote_mmap,
+							    resources.remote_addr + ranges[nb_bufs].offset,
+							    ranges[nb_bufs].len, &resources.dst_doca_buf_array[nb_bufs]);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Unable to acquire DOCA buffer representing remote buffer: %s",
+				     doca_error_get_descr(result));
+			doca_buf_dec_refcount(resources.src_doca_buf_array[nb_bufs], NULL);
+			goto destroy_bufs;
+		}
+	}
+
+	task_user_data.ptr = &task_result;
+	for (nb_tasks = 0; nb_tasks < NB_CONSUME_TASKS; nb_tasks++) {
+		local = resources.src_doca_buf_array[nb_tasks];
+		remote = resources.dst_doca_buf_array[nb_tasks];
+		/* Destinations start empty, the completion callback empties them again */
+		result = doca_buf_reset_data_len(nb_tasks == TASK_READ_SEQ ? local : remote);
+		if (result == DOCA_SUCCESS)
+			result = doca_dma_task_memcpy_alloc_init(resources.dma_ctx,
+								 nb_tasks == TASK_READ_SEQ ? remote : local,
+								 nb_tasks == TASK_READ_SEQ ? local : remote, task_user_data,
+								 &resources.tasks[nb_tasks]);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to allocate DMA memcpy task: %s", doca_error_get_descr(result));
+			goto free_tasks;
+		}
+	}
+
+	result = produce(&resources, ranges[TASK_PAYLOAD].len);
+	if (result == DOCA_SUCCESS)
+		result = task_result;
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("DMA producer failed: %s", doca_error_get_descr(result));
+
+free_tasks:
+	for (i = 0; i < nb_tasks; i++)
+		doca_task_free(doca_dma_task_memcpy_as_task(resources.tasks[i]));
+destroy_bufs:
+	for (i = 0; i < nb_bufs; i++) {
+		tmp_result = doca_buf_dec_refcount(resources.src_doca_buf_array[i], NULL);
+		DOCA_ERROR_PROPAGATE(tmp_result, doca_buf_dec_refcount(resources.dst_doca_buf_array[i], NULL));
+		if (tmp_result != DOCA_SUCCESS) {
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+			DOCA_LOG_ERR("Failed to decrease DOCA buffer reference count: %s", doca_error_get_descr(tmp_result));
+		}
+	}
+	tmp_result = doca_mmap_destroy(resources.remote_mmap);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+		DOCA_LOG_ERR("Failed to destroy remote mmap: %s", doca_error_get_descr(tmp_result));
+	}
+free_dpu_buffer:
+	free(resources.dpu_buffer);
+stop_dma:
+	tmp_result = request_stop_ctx(state->pe, state->ctx);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+		DOCA_LOG_ERR("Unable to stop context: %s", doca_error_get_descr(tmp_result));
+	}
+	state->ctx = NULL;
+destroy_resources:
+	tmp_result = destroy_dma_resources(&resources);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+		DOCA_LOG_ERR("Failed to destroy DMA resources: %s", doca_error_get_descr(tmp_result));
+	}
+
+	return result;
+}
@@ -0,0 +1,21 @@
+# /*
+# * Copyright (c) 2025, University of California, Merced. All rights reserved.
+# *
+# * This file is part of the benchmarking software package developed by
+# * the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+# *
+# * For detailed copyright and licensing information, please refer to the license
+# * file LICENSE in the top level directory.
+# *
+# */
+
+# Start host/dma_consume/run.sh <payload size> <consumer core> on the host first.
+scp <user>@<host>:/tmp/buffer_info.txt .
+scp <user>@<host>:/tmp/export_desc.txt .
+echo ""
+
+make clean
+make
+echo ""
+
+./doca_dma_consume_dpu -p 03:00.0 -d export_desc.txt -b buffer_info.txt
@@ -0,0 +1,518 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+#ifndef DMA_CORO_HPP_
+#define DMA_CORO_HPP_
+
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+extern "C" {
+#include <doca_buf.h>
+#include <doca_buf_inventory.h>
+#include <doca_dma.h>
+#include <doca_error.h>
+#include <doca_mmap.h>
+#include <doca_pe.h>
+}
+
+/*
+ * C++20 coroutine layer over DOCA DMA
+ *
+ * `co_await dma.copy(src, dst, len)` takes two buffers from the inventory and one task, submits it and suspends the
+ * calling coroutine. The completion callback gives the buffers and the task back and queues the coroutine on its
+ * scheduler, which resumes it after doca_pe_progress() returns, so coroutines never run inside DOCA callbacks. When
+ * the context has no free task the copy waits in the scheduler and is submitted as soon as one completes, so the
+ * number of logical transfers is not limited by the task pool of the context. One scheduler per thread and progress
+ * engine; nothing here is thread safe.
+ */
+
+namespace dma_coro {
+
+class scheduler;
+class dma;
+
+/* Address inside a started mmap, local or imported */
+struct dma_ptr {
+	struct doca_mmap *mmap;	/* Memory map holding addr */
+	char *addr;		/* Address */
+
+	/*
+	 * Address off bytes further
+	 *
+	 * @off [in]: offset
+	 * @return: pointer in the same mmap
+	 */
+	dma_ptr operator+(size_t off) const
+	{
+		return {mmap, addr + off};
+	}
+};
+
+template <typename T = void>
+class task;
+
+namespace detail {
+
+/* Promise part shared by task<T> and task<void> */
+struct promise_base {
+	std::coroutine_handle<> continuation;	/* Awaiting coroutine, none for a spawned task */
+	size_t *live = nullptr;			/* Live counter of the scheduler, spawned tasks only */
+
+	/* Resumes the awaiting coroutine, or accounts for the end of a spawned task */
+	struct final_awaiter {
+		bool await_ready() noexcept
+		{
+			return false;
+		}
+
+		template <typename P>
+		std::coroutine_handle<> await_suspend(std::coroutine_handle<P> h) noexcept
+		{
+			promise_base &p = h.promise();
+
+			if (p.continuation)
+				return p.continuation;
+			if (p.live != nullptr)
+				--*p.live;
+			return std::noop_coroutine();
+		}
+
+		void await_resume() noexcept
+		{
+		}
+	};
+
+	/* Tasks are lazy: they run when awaited or spawned */
+	std::suspend_always initial_suspend() noexcept
+	{
+		return {};
+	}
+
+	final_awaiter final_suspend() noexcept
+	{
+		return {};
+	}
+
+	/* The benchmarks are built without exception handling in mind */
+	void unhandled_exception() noexcept
+	{
+		std::terminate();
+	}
+};
+
+template <typename T>
+struct promise : promise_base {
+	T value;	/* co_return value */
+
+	task<T> get_return_object() noexcept;
+
+	void return_value(T v) noexcept
+	{
+		value = std::move(v);
+	}
+};
+
+template <>
+struct promise<void> : promise_base {
+	task<void> get_return_object() noexcept;
+
+	void return_void() noexcept
+	{
+	}
+};
+
+} /* namespace detail */
+
+/* Lazy coroutine returning T, awaiting it runs it to completion and resumes the awaiter by symmetric transfer */
+template <typename T>
+class task {
+public:
+	using promise_type = detail::promise<T>;
+	using handle = std::coroutine_handle<promise_type>;
+
+	explicit task(handle h) noexcept : h_(h)
+	{
+	}
+
+	task(task &&other) noexcept : h_(std::exchange(other.h_, nullptr))
+	{
+	}
+
+	task(const task &) = delete;
+	task &operator=(const task &) = delete;
+
+	~task()
+	{
+		if (h_)
+			h_.destroy();
+	}
+
+	bool await_ready() noexcept
+	{
+		return false;
+	}
+
+	std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) noexcept
+	{
+		h_.promise().continuation = caller;
+		return h_;
+	}
+
+	T await_resume() noexcept
+	{
+		if constexpr (!std::is_void_v<T>)
+			return std::move(h_.promise().value);
+	}
+
+	/*
+	 * Give up ownership of the coroutine frame, used by scheduler::spawn()
+	 *
+	 * @return: coroutine handle
+	 */
+	handle release() noexcept
+	{
+		return std::exchange(h_, nullptr);
+	}
+
+private:
+	handle h_;	/* Coroutine frame */
+};
+
+namespace detail {
+
+template <typename T>
+task<T>
+promise<T>::get_return_object() noexcept
+{
+	return task<T>(std::coroutine_handle<promise<T>>::from_promise(*this));
+}
+
+inline task<void>
+promise<void>::get_return_object() noexcept
+{
+	return task<void>(std::coroutine_handle<promise<void>>::from_promise(*this));
+}
+
+} /* namespace detail */
+
+/* One DMA copy, the object lives in the frame of the awaiting coroutine until it is resumed */
+class copy_awaitable {
+public:
+	copy_awaitable(dma &d, dma_ptr src, dma_ptr dst, size_t len) noexcept : dma_(d), src_(src), dst_(dst), len_(len)
+	{
+	}
+
+	bool await_ready() noexcept
+	{
+		return false;
+	}
+
+	inline bool await_suspend(std::coroutine_handle<> h) noexcept;
+
+	/*
+	 * Result of the copy
+	 *
+	 * @return: DOCA_SUCCESS, the error of the task, or the error of a failed submission
+	 */
+	doca_error_t await_resume() noexcept
+	{
+		return status_;
+	}
+
+private:
+	friend class dma;
+	friend class scheduler;
+
+	inline doca_error_t try_submit() noexcept;
+	inline void finished(struct doca_dma_task_memcpy *task, doca_error_t status) noexcept;
+
+	dma &dma_;				/* Context of the copy */
+	dma_ptr src_;				/* Source */
+	dma_ptr dst_;				/* Destination */
+	size_t len_;				/* Bytes to copy */
+	doca_error_t status_ = DOCA_SUCCESS;	/* Result */
+	std::coroutine_handle<> h_;		/* Suspended coroutine */
+	copy_awaitable *next_ = nullptr;	/* Next copy waiting for a free task */
+};
+
+/* Drives one progress engine and the coroutines that use it */
+class scheduler {
+public:
+	explicit scheduler(struct doca_pe *pe) : pe_(pe)
+	{
+	}
+
+	scheduler(const scheduler &) = delete;
+	scheduler &operator=(const scheduler &) = delete;
+
+	~scheduler()
+	{
+		for (std::coroutine_handle<> h : roots_)
+			h.destroy();
+	}
+
+	/*
+	 * Start a task on the next run() round, the scheduler owns it from now on
+	 *
+	 * @t [in]: task
+	 */
+	void spawn(task<void> t)
+	{
+		task<void>::handle h = t.release();
+
+		h.promise().live = &live_;
+		live_++;
+		roots_.push_back(h);
+		ready_.push_back(h);
+	}
+
+	/*
+	 * Poll and resume until every spawned task has finished, then free their frames
+	 */
+	void run()
+	{
+		while (live_ > 0) {
+			while (doca_pe_progress(pe_) != 0)
+				;
+			submit_waiting();
+			running_.swap(ready_);
+			for (std::coroutine_handle<> h : running_)
+				h.resume();
+			running_.clear();
+		}
+		for (std::coroutine_handle<> h : roots_)
+			h.destroy();
+		roots_.clear();
+	}
+
+	/* Awaitable that requeues the coroutine behind the ones already ready */
+	struct yield_awaitable {
+		scheduler &s;	/* Scheduler */
+
+		bool await_ready() noexcept
+		{
+			return false;
+		}
+
+		void await_suspend(std::coroutine_handle<> h)
+		{
+			s.ready_.push_back(h);
+		}
+
+		void await_resume() noexcept
+		{
+		}
+	};
+
+	/*
+	 * Let the other ready coroutines run
+	 *
+	 * @return: awaitable
+	 */
+	yield_awaitable yield() noexcept
+	{
+		return {*this};
+	}
+
+private:
+	friend class copy_awaitable;
+
+	/*
+	 * Submit the copies that waited for a free task, in arrival order, until the context is full again
+	 */
+	void submit_waiting() noexcept
+	{
+		copy_awaitable *c;
+		doca_error_t result;
+
+		while ((c = wait_head_) != nullptr) {
+			result = c->try_submit();
+			if (result == DOCA_ERROR_NO_MEMORY)
+				return;
+			wait_head_ = c->next_;
+			if (wait_head_ == nullptr)
+				wait_tail_ = nullptr;
+			if (result != DOCA_SUCCESS) {
+				c->status_ = result;
+				ready_.push_back(c->h_);
+			}
+		}
+	}
+
+	/*
+	 * Queue a copy until a task is free
+	 *
+	 * @c [in]: copy
+	 */
+	void wait_for_task(copy_awaitable *c) noexcept
+	{
+		c->next_ = nullptr;
+		if (wait_tail_ != nullptr)
+			wait_tail_->next_ = c;
+		else
+			wait_head_ = c;
+		wait_tail_ = c;
+	}
+
+	struct doca_pe *pe_;				/* Progress engine */
+	std::vector<std::coroutine_handle<>> ready_;	/* Coroutines to resume */
+	std::vector<std::coroutine_handle<>> running_;	/* Coroutines resumed in this round */
+	std::vector<std::coroutine_handle<>> roots_;	/* Frames of spawned tasks */
+	size_t live_ = 0;				/* Spawned tasks not finished */
+	copy_awaitable *wait_head_ = nullptr;		/* Copies waiting for a free task */
+	copy_awaitable *wait_tail_ = nullptr;		/* Last waiting copy */
+};
+
+/* DMA context bound to a scheduler, its task callbacks must be completed_callback() and error_callback() */
+class dma {
+public:
+	dma(scheduler &sched, struct doca_dma *ctx, struct doca_buf_inventory *inv) noexcept
+		: sched_(sched), ctx_(ctx), inv_(inv)
+	{
+	}
+
+	/*
+	 * Copy len bytes, co_await the result to get the doca_error_t of the copy
+	 *
+	 * @src [in]: source
+	 * @dst [in]: destination
+	 * @len [in]: bytes to copy
+	 * @return: awaitable
+	 */
+	copy_awaitable copy(dma_ptr src, dma_ptr dst, size_t len) noexcept
+	{
+		return copy_awaitable(*this, src, dst, len);
+	}
+
+	/*
+	 * Task completed callback for doca_dma_task_memcpy_set_conf()
+	 *
+	 * @task [in]: completed task
+	 * @task_user_data [in]: the copy
+	 * @ctx_user_data [in]: unused
+	 */
+	static void completed_callback(struct doca_dma_task_memcpy *task, union doca_data task_user_data,
+				       union doca_data ctx_user_data) noexcept
+	{
+		(void)ctx_user_data;
+		static_cast<copy_awaitable *>(task_user_data.ptr)->finished(task, DOCA_SUCCESS);
+	}
+
+	/*
+	 * Task error callback for doca_dma_task_memcpy_set_conf()
+	 *
+	 * @task [in]: failed task
+	 * @task_user_data [in]: the copy
+	 * @ctx_user_data [in]: unused
+	 */
+	static void error_callback(struct doca_dma_task_memcpy *task, union doca_data task_user_data,
+				   union doca_data ctx_user_data) noexcept
+	{
+		(void)ctx_user_data;
+		static_cast<copy_awaitable *>(task_user_data.ptr)
+			->finished(task, doca_task_get_status(doca_dma_task_memcpy_as_task(task)));
+	}
+
+private:
+	friend class copy_awaitable;
+
+	scheduler &sched_;			/* Scheduler resuming the coroutines */
+	struct doca_dma *ctx_;			/* DMA context */
+	struct doca_buf_inventory *inv_;	/* Inventory, two buffers per task */
+};
+
+/*
+ * Take buffers and a task and submit the copy
+ *
+ * @return: DOCA_SUCCESS, DOCA_ERROR_NO_MEMORY if the context or the inventory is exhausted, or another error
+ */
+inline doca_error_t
+copy_awaitable::try_submit() noexcept
+{
+	struct doca_buf *src = nullptr, *dst = nullptr;
+	struct doca_dma_task_memcpy *task;
+	union doca_data data;
+	doca_error_t result;
+
+	data.ptr = this;
+	result = doca_buf_inventory_buf_get_by_addr(dma_.inv_, src_.mmap, src_.addr, len_, &src);
+	if (result == DOCA_SUCCESS)
+		result = doca_buf_set_data(src, src_.addr, len_);
+	if (result == DOCA_SUCCESS)
+		result = doca_buf_inventory_buf_get_by_addr(dma_.inv_, dst_.mmap, dst_.addr, len_, &dst);
+	if (result == DOCA_SUCCESS)
+		result = doca_dma_task_memcpy_alloc_init(dma_.ctx_, src, dst, data, &task);
+	if (result == DOCA_SUCCESS) {
+		result = doca_task_submit(doca_dma_task_memcpy_as_task(task));
+		if (result != DOCA_SUCCESS)
+			doca_task_free(doca_dma_task_memcpy_as_task(task));
+	}
+	if (result != DOCA_SUCCESS) {
+		if (src != nullptr)
+			doca_buf_dec_refcount(src, nullptr);
+		if (dst != nullptr)
+			doca_buf_dec_refcount(dst, nullptr);
+	}
+	return result;
+}
+
+/*
+ * Submit the copy, or queue it behind the other copies waiting for a task
+ *
+ * @h [in]: awaiting coroutine
+ * @return: false to resume at once after a failed submission, true otherwise
+ */
+inline bool
+copy_awaitable::await_suspend(std::coroutine_handle<> h) noexcept
+{
+	scheduler &s = dma_.sched_;
+
+	h_ = h;
+	/* Keep arrival order: nobody overtakes copies that are already waiting */
+	if (s.wait_head_ != nullptr) {
+		s.wait_for_task(this);
+		return true;
+	}
+	status_ = try_submit();
+	if (status_ == DOCA_ERROR_NO_MEMORY) {
+		status_ = DOCA_SUCCESS;
+		s.wait_for_task(this);
+		return true;
+	}
+	return status_ == DOCA_SUCCESS;
+}
+
+/*
+ * Give back the buffers and the task, and queue the coroutine for resumption
+ *
+ * @task [in]: finished task
+ * @status [in]: status of the task
+ */
+inline void
+copy_awaitable::finished(struct doca_dma_task_memcpy *task, doca_error_t status) noexcept
+{
+	doca_buf_dec_refcount(const_cast<struct doca_buf *>(doca_dma_task_memcpy_get_src(task)), nullptr);
+	doca_buf_dec_refcount(doca_dma_task_memcpy_get_dst(task), nullptr);
+	doca_task_free(doca_dma_task_memcpy_as_task(task));
+	status_ = status;
+	dma_.sched_.ready_.push_back(h_);
+}
+
+} /* namespace dma_coro */
+
+#endif
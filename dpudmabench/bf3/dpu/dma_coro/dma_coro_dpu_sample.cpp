@@ -0,0 +1,758 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+extern "C" {
+#include <doca_buf.h>
+#include <doca_buf_inventory.h>
+#include <doca_ctx.h>
+#include <doca_dev.h>
+#include <doca_dma.h>
+#include <doca_error.h>
+#include <doca_log.h>
+#include <doca_mmap.h>
+#include <doca_pe.h>
+
+#include "dma_common.h"
+}
+
+#include "dma_coro.hpp"
+
+DOCA_LOG_REGISTER(DMA_CORO_DPU);
+
+#define RECV_BUF_SIZE 256		/* Buffer which contains config information */
+#define MAX_DESC_SIZE 1024		/* Maximum size of the export descriptor */
+#define NUM_TASKS 32			/* Task pool of every DMA context */
+#define NB_OPS 500000			/* Copies per per-op measurement */
+#define NB_YIELDS 2000000		/* Suspend/resume round trips of the scheduler measurement */
+#define SLOT (8UL << 10)		/* Local and remote slot of a logical transfer or handler */
+#define MAX_HANDLERS 1024		/* Largest number of concurrent handlers */
+#define HDR_SIZE 64			/* Request header and response size of a handler */
+#define PAYLOAD_SIZE 4096		/* Request payload size of a handler */
+#define REQS_TOTAL 200000		/* Requests served per handler measurement */
+
+using dma_coro::dma_ptr;
+
+/* DOCA objects shared by every measurement, each measurement starts its own DMA context */
+struct bench_objects {
+	struct doca_dev *dev;			/* DOCA device */
+	struct doca_pe *pe;			/* Progress engine */
+	struct doca_mmap *local_mmap;		/* DPU buffer mmap */
+	struct doca_mmap *remote_mmap;		/* Host buffer mmap */
+	struct doca_buf_inventory *buf_inv;	/* Inventory, two buffers per task */
+	struct doca_dma *dma;			/* DMA context of the running measurement */
+	char *local;				/* DPU buffer */
+	char *remote;				/* Host buffer */
+	size_t remote_len;			/* Host buffer length */
+};
+
+/* Callback-driven copy loop, the way the C samples are written */
+struct raw_state {
+	struct bench_objects *objs;	/* DOCA objects */
+	size_t len;			/* Bytes per copy */
+	uint64_t posted;		/* Copies submitted */
+	uint64_t completed;		/* Copies completed */
+	uint64_t failed;		/* Copies failed */
+	bool realloc;			/* Take new buffers and a new task for every copy */
+};
+
+/* Dependent-copy handler written as a callback state machine */
+struct sm_handler {
+	struct sm_state *sm;	/* Shared state */
+	uint32_t id;		/* Handler index, selects its slots */
+	uint32_t stage;		/* 0: read header, 1: read payload, 2: write response */
+};
+
+/* Shared state of the callback state machine handlers */
+struct sm_state {
+	struct bench_objects *objs;			/* DOCA objects */
+	struct sm_handler handlers[MAX_HANDLERS];	/* Handlers */
+	uint64_t started;				/* Requests started */
+	uint64_t completed;				/* Requests completed */
+	uint64_t failed;				/* Copies failed */
+};
+
+/*
+ * Saves export descriptor and buffer information content into memory buffers
+ *
+ * @export_desc_file_path [in]: Export descriptor file path
+ * @buffer_info_file_path [in]: Buffer information file path
+ * @export_desc [in]: Export descriptor buffer
+ * @export_desc_len [in]: Export descriptor buffer length
+ * @remote_addr [in]: Remote buffer address
+ * @remote_addr_len [in]: Remote buffer total length
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+save_config_info_to_buffers(const char *export_desc_file_path, const char *buffer_info_file_path, char *export_desc,
+			    size_t *export_desc_len, char **remote_addr, size_t *remote_addr_len)
+{
+	FILE *fp;
+	long file_size;
+	char buffer[RECV_BUF_SIZE];
+
+	fp = fopen(export_desc_file_path, "r");
+	if (fp == NULL) {
+		DOCA_LOG_ERR("Failed to open %s", export_desc_file_path);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	if (fseek(fp, 0, SEEK_END) != 0) {
+		DOCA_LOG_ERR("Failed to calculate file size");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	file_size = ftell(fp);
+	if (file_size == -1) {
+		DOCA_LOG_ERR("Failed to calculate file size");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	if (file_size > MAX_DESC_SIZE)
+		file_size = MAX_DESC_SIZE;
+
+	*export_desc_len = file_size;
+
+	if (fseek(fp, 0L, SEEK_SET) != 0) {
+		DOCA_LOG_ERR("Failed to calculate file size");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	if (fread(export_desc, 1, file_size, fp) != (size_t)file_size) {
+		DOCA_LOG_ERR("Failed to read the export descriptor");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	fclose(fp);
+
+	/* Read source buffer information from file */
+	fp = fopen(buffer_info_file_path, "r");
+	if (fp == NULL) {
+		DOCA_LOG_ERR("Failed to open %s", buffer_info_file_path);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	/* Get source buffer address */
+	if (fgets(buffer, RECV_BUF_SIZE, fp) == NULL) {
+		DOCA_LOG_ERR("Failed to read the source (host) buffer address");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+	*remote_addr = (char *)strtoull(buffer, NULL, 0);
+
+	memset(buffer, 0, RECV_BUF_SIZE);
+
+	/* Get source buffer length */
+	if (fgets(buffer, RECV_BUF_SIZE, fp) == NULL) {
+		DOCA_LOG_ERR("Failed to read the source (host) buffer length");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+	*remote_addr_len = strtoull(buffer, NULL, 0);
+
+	fclose(fp);
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Current time
+ *
+ * @return: CLOCK_MONOTONIC in nanoseconds
+ */
+static uint64_t
+now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000UL + ts.tv_nsec;
+}
+
+/*
+ * Start a DMA context with the given task callbacks
+ *
+ * @objs [in]: DOCA objects, objs->dma is set
+ * @completed [in]: task completed callback
+ * @error [in]: task error callback
+ * @ctx_user [in]: context user data
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+start_dma(struct bench_objects *objs, doca_dma_task_memcpy_completion_cb_t completed,
+	  doca_dma_task_memcpy_completion_cb_t error, void *ctx_user)
+{
+	union doca_data data;
+	doca_error_t result;
+
+	data.ptr = ctx_user;
+	result = doca_dma_create(objs->dev, &objs->dma);
+	if (result == DOCA_SUCCESS)
+		result = doca_dma_task_memcpy_set_conf(objs->dma, completed, error, NUM_TASKS);
+	if (result == DOCA_SUCCESS)
+		result = doca_ctx_set_user_data(doca_dma_as_ctx(objs->dma), data);
+	if (result == DOCA_SUCCESS)
+		result = doca_pe_connect_ctx(objs->pe, doca_dma_as_ctx(objs->dma));
+	if (result == DOCA_SUCCESS)
+		result = doca_ctx_start(doca_dma_as_ctx(objs->dma));
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start DMA context: %s", doca_error_get_descr(result));
+		if (objs->dma != NULL)
+			doca_dma_destroy(objs->dma);
+		objs->dma = NULL;
+	}
+	return result;
+}
+
+/*
+ * Stop and destroy the DMA context of the measurement
+ *
+ * @objs [in]: DOCA objects
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+stop_dma(struct bench_objects *objs)
+{
+	doca_error_t result, tmp_result;
+
+	result = request_stop_ctx(objs->pe, doca_dma_as_ctx(objs->dma));
+	tmp_result = doca_dma_destroy(objs->dma);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	objs->dma = NULL;
+	return result;
+}
+
+/*
+ * Take buffers and a task for one copy and submit it
+ *
+ * @objs [in]: DOCA objects
+ * @src [in]: source
+ * @dst [in]: destination
+ * @len [in]: bytes to copy
+ * @user [in]: task user data
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+submit_copy(struct bench_objects *objs, dma_ptr src, dma_ptr dst, size_t len, void *user)
+{
+	struct doca_buf *src_buf = NULL, *dst_buf = NULL;
+	struct doca_dma_task_memcpy *task;
+	union doca_data data;
+	doca_error_t result;
+
+	data.ptr = user;
+	result = doca_buf_inventory_buf_get_by_addr(objs->buf_inv, src.mmap, src.addr, len, &src_buf);
+	if (result == DOCA_SUCCESS)
+		result = doca_buf_set_data(src_buf, src.addr, len);
+	if (result == DOCA_SUCCESS)
+		result = doca_buf_inventory_buf_get_by_addr(objs->buf_inv, dst.mmap, dst.addr, len, &dst_buf);
+	if (result == DOCA_SUCCESS)
+		result = doca_dma_task_memcpy_alloc_init(objs->dma, src_buf, dst_buf, data, &task);
+	if (result == DOCA_SUCCESS) {
+		result = doca_task_submit(doca_dma_task_memcpy_as_task(task));
+		if (result != DOCA_SUCCESS)
+			doca_task_free(doca_dma_task_memcpy_as_task(task));
+	}
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to submit a copy: %s", doca_error_get_descr(result));
+		if (src_buf != NULL)
+			doca_buf_dec_refcount(src_buf, NULL);
+		if (dst_buf != NULL)
+			doca_buf_dec_refcount(dst_buf, NULL);
+	}
+	return result;
+}
+
+/*
+ * Give back the buffers and the task of a finished copy
+ *
+ * @task [in]: finished task
+ */
+static void
+free_copy(struct doca_dma_task_memcpy *task)
+{
+	doca_buf_dec_refcount(const_cast<struct doca_buf *>(doca_dma_task_memcpy_get_src(task)), NULL);
+	doca_buf_dec_refcount(doca_dma_task_memcpy_get_dst(task), NULL);
+	doca_task_free(doca_dma_task_memcpy_as_task(task));
+}
+
+/*
+ * Raw copy finished: resubmit the same task, or replace it by a new one
+ *
+ * @task [in]: finished task
+ * @task_user_data [in]: slot of the copy
+ * @ctx_user_data [in]: raw_state
+ */
+static void
+raw_callback(struct doca_dma_task_memcpy *task, union doca_data task_user_data, union doca_data ctx_user_data)
+{
+	struct raw_state *st = static_cast<struct raw_state *>(ctx_user_data.ptr);
+	uint64_t slot = task_user_data.u64;
+
+	if (doca_task_get_status(doca_dma_task_memcpy_as_task(task)) != DOCA_SUCCESS)
+		st->failed++;
+	st->completed++;
+	if (st->realloc) {
+		free_copy(task);
+		if (st->posted < NB_OPS &&
+		    submit_copy(st->objs, {st->objs->remote_mmap, st->objs->remote + slot * SLOT},
+				{st->objs->local_mmap, st->objs->local + slot * SLOT}, st->len,
+				task_user_data.ptr) == DOCA_SUCCESS)
+			st->posted++;
+		return;
+	}
+	/* The finished copy filled dst, empty it so the resubmitted copy has room */
+	if (st->posted < NB_OPS && doca_buf_reset_data_len(doca_dma_task_memcpy_get_dst(task)) == DOCA_SUCCESS &&
+	    doca_task_submit(doca_dma_task_memcpy_as_task(task)) == DOCA_SUCCESS)
+		st->posted++;
+	else
+		free_copy(task);
+}
+
+/*
+ * NB_OPS copies through C callbacks, depth copies outstanding
+ *
+ * @objs [in]: DOCA objects
+ * @len [in]: bytes per copy
+ * @depth [in]: copies outstanding
+ * @realloc [in]: new buffers and task per copy instead of resubmitting
+ * @ns_per_op [out]: nanoseconds per copy
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+run_raw(struct bench_objects *objs, size_t len, uint32_t depth, bool realloc, double *ns_per_op)
+{
+	struct raw_state st = {objs, len, 0, 0, 0, realloc};
+	doca_error_t result, tmp_result;
+	union doca_data slot;
+	uint64_t start;
+	uint32_t d;
+
+	*ns_per_op = 0;
+	result = start_dma(objs, raw_callback, raw_callback, &st);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	start = now_ns();
+	for (d = 0; d < depth && result == DOCA_SUCCESS; d++) {
+		slot.u64 = d;
+		result = submit_copy(objs, {objs->remote_mmap, objs->remote + d * SLOT},
+				     {objs->local_mmap, objs->local + d * SLOT}, len, slot.ptr);
+		if (result == DOCA_SUCCESS)
+			st.posted++;
+	}
+	/* A failed resubmission stops its chain, so wait for the copies actually posted */
+	while (st.completed < st.posted)
+		(void)doca_pe_progress(objs->pe);
+	*ns_per_op = (double)(now_ns() - start) / st.completed;
+
+	if (result == DOCA_SUCCESS && (st.failed > 0 || st.completed != NB_OPS))
+		result = DOCA_ERROR_IO_FAILED;
+	tmp_result = stop_dma(objs);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	return result;
+}
+
+/*
+ * Copy loop of one coroutine
+ *
+ * @d [in]: DMA context
+ * @src [in]: source slot
+ * @dst [in]: destination slot
+ * @len [in]: bytes per copy
+ * @nb [in]: number of copies
+ * @failed [in/out]: failed copies
+ * @return: task
+ */
+static dma_coro::task<void>
+copy_loop(dma_coro::dma &d, dma_ptr src, dma_ptr dst, size_t len, uint64_t nb, uint64_t *failed)
+{
+	for (uint64_t i = 0; i < nb; i++)
+		if (co_await d.copy(src, dst, len) != DOCA_SUCCESS)
+			(*failed)++;
+}
+
+/*
+ * NB_OPS copies from depth coroutines
+ *
+ * @objs [in]: DOCA objects
+ * @len [in]: bytes per copy
+ * @depth [in]: coroutines, more than NUM_TASKS makes copies wait for a free task
+ * @ns_per_op [out]: nanoseconds per copy
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+run_coro(struct bench_objects *objs, size_t len, uint32_t depth, double *ns_per_op)
+{
+	dma_coro::scheduler sched(objs->pe);
+	uint64_t failed = 0, start;
+	doca_error_t result, tmp_result;
+	uint32_t c;
+
+	*ns_per_op = 0;
+	result = start_dma(objs, dma_coro::dma::completed_callback, dma_coro::dma::error_callback, NULL);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	dma_coro::dma d(sched, objs->dma, objs->buf_inv);
+	for (c = 0; c < depth; c++)
+		sched.spawn(copy_loop(d, {objs->remote_mmap, objs->remote + c * SLOT},
+				      {objs->local_mmap, objs->local + c * SLOT}, len,
+				      NB_OPS / depth + (c < NB_OPS % depth), &failed));
+	start = now_ns();
+	sched.run();
+	*ns_per_op = (double)(now_ns() - start) / NB_OPS;
+
+	result = failed > 0 ? DOCA_ERROR_IO_FAILED : DOCA_SUCCESS;
+	tmp_result = stop_dma(objs);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	return result;
+}
+
+/*
+ * Yield loop of one coroutine
+ *
+ * @sched [in]: scheduler
+ * @nb [in]: number of yields
+ * @return: task
+ */
+static dma_coro::task<void>
+yield_loop(dma_coro::scheduler &sched, uint64_t nb)
+{
+	for (uint64_t i = 0; i < nb; i++)
+		co_await sched.yield();
+}
+
+/*
+ * Cost of one suspend/resume through the scheduler, without DMA
+ *
+ * @objs [in]: DOCA objects
+ * @nb_coros [in]: coroutines sharing NB_YIELDS yields
+ * @return: nanoseconds per yield
+ */
+static double
+run_yield(struct bench_objects *objs, uint32_t nb_coros)
+{
+	dma_coro::scheduler sched(objs->pe);
+	uint64_t start;
+	uint32_t c;
+
+	for (c = 0; c < nb_coros; c++)
+		sched.spawn(yield_loop(sched, NB_YIELDS / nb_coros));
+	start = now_ns();
+	sched.run();
+	return (double)(now_ns() - start) / (NB_YIELDS / nb_coros * nb_coros);
+}
+
+/*
+ * Submit the copy of the current stage of a state machine handler
+ *
+ * @h [in]: handler
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+sm_submit(struct sm_handler *h)
+{
+	struct bench_objects *objs = h->sm->objs;
+	dma_ptr local = {objs->local_mmap, objs->local + h->id * SLOT};
+	dma_ptr remote = {objs->remote_mmap, objs->remote + h->id * SLOT};
+
+	switch (h->stage) {
+	case 0:
+		return submit_copy(objs, remote, local, HDR_SIZE, h);
+	case 1:
+		return submit_copy(objs, remote + HDR_SIZE, local + HDR_SIZE, PAYLOAD_SIZE, h);
+	default:
+		return submit_copy(objs, local, remote + SLOT / 2, HDR_SIZE, h);
+	}
+}
+
+/*
+ * State machine handler copy finished: move to the next stage or the next request
+ *
+ * @task [in]: finished task
+ * @task_user_data [in]: handler
+ * @ctx_user_data [in]: unused
+ */
+static void
+sm_callback(struct doca_dma_task_memcpy *task, union doca_data task_user_data, union doca_data ctx_user_data)
+{
+	struct sm_handler *h = static_cast<struct sm_handler *>(task_user_data.ptr);
+	struct sm_state *sm = h->sm;
+
+	(void)ctx_user_data;
+	if (doca_task_get_status(doca_dma_task_memcpy_as_task(task)) != DOCA_SUCCESS)
+		sm->failed++;
+	free_copy(task);
+
+	if (++h->stage == 3) {
+		sm->completed++;
+		h->stage = 0;
+		if (sm->started == REQS_TOTAL)
+			return;
+		sm->started++;
+	}
+	if (sm_submit(h) != DOCA_SUCCESS)
+		sm->failed++;
+}
+
+/*
+ * REQS_TOTAL requests of three dependent copies, handlers written as callback state machines
+ *
+ * Every handler has one copy outstanding, so nb_handlers must not exceed NUM_TASKS: going further needs a queue of
+ * handlers waiting for a task, which is what the coroutine layer provides.
+ *
+ * @objs [in]: DOCA objects
+ * @nb_handlers [in]: concurrent handlers
+ * @ns_per_req [out]: nanoseconds per request
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+run_handlers_sm(struct bench_objects *objs, uint32_t nb_handlers, double *ns_per_req)
+{
+	static struct sm_state sm;
+	doca_error_t result, tmp_result;
+	uint64_t start;
+	uint32_t i;
+
+	*ns_per_req = 0;
+	memset(&sm, 0, sizeof(sm));
+	sm.objs = objs;
+	result = start_dma(objs, sm_callback, sm_callback, NULL);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	start = now_ns();
+	for (i = 0; i < nb_handlers && result == DOCA_SUCCESS; i++) {
+		sm.handlers[i] = {&sm, i, 0};
+		sm.started++;
+		result = sm_submit(&sm.handlers[i]);
+	}
+	while (sm.completed + sm.failed < sm.started)
+		(void)doca_pe_progress(objs->pe);
+	*ns_per_req = (double)(now_ns() - start) / sm.completed;
+
+	if (result == DOCA_SUCCESS && sm.failed > 0)
+		result = DOCA_ERROR_IO_FAILED;
+	tmp_result = stop_dma(objs);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	return result;
+}
+
+/*
+ * Request handler: read the header, read the payload, write the response, nb times
+ *
+ * @d [in]: DMA context
+ * @local [in]: DPU slot of the handler
+ * @remote [in]: host slot of the handler
+ * @nb [in]: requests to serve
+ * @failed [in/out]: failed copies
+ * @return: task
+ */
+static dma_coro::task<void>
+handler(dma_coro::dma &d, dma_ptr local, dma_ptr remote, uint64_t nb, uint64_t *failed)
+{
+	for (uint64_t i = 0; i < nb; i++) {
+		if (co_await d.copy(remote, local, HDR_SIZE) != DOCA_SUCCESS)
+			(*failed)++;
+		if (co_await d.copy(remote + HDR_SIZE, local + HDR_SIZE, PAYLOAD_SIZE) != DOCA_SUCCESS)
+			(*failed)++;
+		if (co_await d.copy(local, remote + SLOT / 2, HDR_SIZE) != DOCA_SUCCESS)
+			(*failed)++;
+	}
+}
+
+/*
+ * REQS_TOTAL requests of three dependent copies, handlers written as coroutines
+ *
+ * @objs [in]: DOCA objects
+ * @nb_handlers [in]: concurrent handlers
+ * @ns_per_req [out]: nanoseconds per request
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+run_handlers_coro(struct bench_objects *objs, uint32_t nb_handlers, double *ns_per_req)
+{
+	dma_coro::scheduler sched(objs->pe);
+	uint64_t failed = 0, start;
+	doca_error_t result, tmp_result;
+	uint32_t i;
+
+	*ns_per_req = 0;
+	result = start_dma(objs, dma_coro::dma::completed_callback, dma_coro::dma::error_callback, NULL);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	dma_coro::dma d(sched, objs->dma, objs->buf_inv);
+	for (i = 0; i < nb_handlers; i++)
+		sched.spawn(handler(d, {objs->local_mmap, objs->local + i * SLOT},
+				    {objs->remote_mmap, objs->remote + i * SLOT},
+				    REQS_TOTAL / nb_handlers + (i < REQS_TOTAL % nb_handlers), &failed));
+	start = now_ns();
+	sched.run();
+	*ns_per_req = (double)(now_ns() - start) / REQS_TOTAL;
+
+	result = failed > 0 ? DOCA_ERROR_IO_FAILED : DOCA_SUCCESS;
+	tmp_result = stop_dma(objs);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	return result;
+}
+
+/*
+ * Run every measurement
+ *
+ * @objs [in]: DOCA objects
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+run_all(struct bench_objects *objs)
+{
+	static const size_t sizes[] = {64, 4096};
+	static const uint32_t depths[] = {1, NUM_TASKS};
+	static const uint32_t handler_counts[] = {1, NUM_TASKS, MAX_HANDLERS};
+	double resubmit, alloc, coro, sm, co;
+	doca_error_t result;
+
+	printf("Scheduler round trip without DMA (includes an empty doca_pe_progress)\n");
+	printf("Coroutines\t ns/yield\n");
+	printf("%-10d\t %8.1f\n", 1, run_yield(objs, 1));
+	printf("%-10d\t %8.1f\n\n", MAX_HANDLERS, run_yield(objs, MAX_HANDLERS));
+
+	printf("Per-copy cost, %d host-to-DPU reads, %d tasks per context\n", NB_OPS, NUM_TASKS);
+	printf("Size\t Depth\t Resubmit(ns)\t Callback(ns)\t Coroutine(ns)\t Overhead(ns)\n");
+	for (size_t len : sizes) {
+		for (uint32_t depth : depths) {
+			result = run_raw(objs, len, depth, false, &resubmit);
+			if (result == DOCA_SUCCESS)
+				result = run_raw(objs, len, depth, true, &alloc);
+			if (result == DOCA_SUCCESS)
+				result = run_coro(objs, len, depth, &coro);
+			if (result != DOCA_SUCCESS)
+				return result;
+			printf("%-6zu\t %-5u\t %12.1f\t %12.1f\t %13.1f\t %12.1f\n", len, depth, resubmit, alloc, coro,
+			       coro - alloc);
+			fflush(stdout);
+		}
+	}
+
+	printf("\nHandlers of %d requests: read %d B header, read %d B payload, write %d B response\n", REQS_TOTAL,
+	       HDR_SIZE, PAYLOAD_SIZE, HDR_SIZE);
+	printf("Handlers\t State machine(ns/req)\t Coroutine(ns/req)\n");
+	for (uint32_t nb : handler_counts) {
+		result = run_handlers_coro(objs, nb, &co);
+		if (result != DOCA_SUCCESS)
+			return result;
+		if (nb <= NUM_TASKS) {
+			result = run_handlers_sm(objs, nb, &sm);
+			if (result != DOCA_SUCCESS)
+				return result;
+			printf("%-8u\t %21.1f\t %17.1f\n", nb, sm, co);
+		} else {
+			printf("%-8u\t %21s\t %17.1f\n", nb, "-", co);
+		}
+		fflush(stdout);
+	}
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Run DOCA DMA coroutine overhead benchmark on the DPU
+ *
+ * @export_desc_file_path [in]: Export descriptor file path
+ * @buffer_info_file_path [in]: Buffer info file path
+ * @pcie_addr [in]: Device PCI address
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+extern "C" doca_error_t
+dma_coro_dpu(const char *export_desc_file_path, const char *buffer_info_file_path, const char *pcie_addr)
+{
+	static struct bench_objects objs;
+	char export_desc[MAX_DESC_SIZE];
+	size_t export_desc_len;
+	doca_error_t result, tmp_result;
+
+	result = save_config_info_to_buffers(export_desc_file_path, buffer_info_file_path, export_desc,
+					     &export_desc_len, &objs.remote, &objs.remote_len);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to read memory configuration from file: %s", doca_error_get_descr(result));
+		return result;
+	}
+	if (objs.remote_len < MAX_HANDLERS * SLOT) {
+		DOCA_LOG_ERR("Host buffer must hold at least %lu bytes", MAX_HANDLERS * SLOT);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	result = open_doca_device_with_pci(pcie_addr, &dma_task_is_supported, &objs.dev);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to open DOCA device: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	objs.local = static_cast<char *>(calloc(MAX_HANDLERS, SLOT));
+	if (objs.local == NULL) {
+		DOCA_LOG_ERR("Failed to allocate the DPU buffer");
+		result = DOCA_ERROR_NO_MEMORY;
+	}
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_create(&objs.local_mmap);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_add_dev(objs.local_mmap, objs.dev);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_set_memrange(objs.local_mmap, objs.local, MAX_HANDLERS * SLOT);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_start(objs.local_mmap);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_create_from_export(NULL, export_desc, export_desc_len, objs.dev, &objs.remote_mmap);
+	if (result == DOCA_SUCCESS)
+		result = doca_buf_inventory_create(2 * NUM_TASKS, &objs.buf_inv);
+	if (result == DOCA_SUCCESS)
+		result = doca_buf_inventory_start(objs.buf_inv);
+	if (result == DOCA_SUCCESS)
+		result = doca_pe_create(&objs.pe);
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Failed to create DOCA objects: %s", doca_error_get_descr(result));
+	else
+		result = run_all(&objs);
+
+	if (objs.pe != NULL) {
+		tmp_result = doca_pe_destroy(objs.pe);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+	if (objs.buf_inv != NULL) {
+		tmp_result = doca_buf_inventory_stop(objs.buf_inv);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+		tmp_result = doca_buf_inventory_destroy(objs.buf_inv);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+	if (objs.remote_mmap != NULL) {
+		tmp_result = doca_mmap_destroy(objs.remote_mmap);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+	if (objs.local_mmap != NULL) {
+		tmp_result = doca_mmap_destroy(objs.local_mmap);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+	free(objs.local);
+	tmp_result = doca_dev_close(objs.dev);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	return result;
+}
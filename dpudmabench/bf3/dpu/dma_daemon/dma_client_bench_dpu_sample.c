@@ -0,0 +1,342 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <doca_error.h>
+#include <doca_log.h>
+
+#include "dma_client.h"
+#include "dma_engine.h"
+
+DOCA_LOG_REGISTER(DMA_CLIENT_BENCH_DPU);
+
+#define BENCH_DEPTH 32			/* Requests outstanding in the throughput test */
+#define LAT_ITERS 10000			/* Requests of the latency test */
+#define THR_OPS 100000			/* Largest number of requests of the throughput test */
+#define THR_BYTES (1UL << 30)		/* Largest number of bytes of the throughput test */
+#define NB_JOBS 20			/* Short jobs */
+#define JOB_OPS 1000			/* Requests of a short job */
+#define JOB_SIZE 4096			/* Request size of a short job */
+
+static const uint32_t sizes[] = {64, 4096, 65536, 1 << 20};
+#define NB_SIZES (sizeof(sizes) / sizeof(sizes[0]))
+
+/* The same workload either through the daemon or on DOCA objects of this process */
+struct bench_ctx {
+	bool inproc;			/* Own DOCA objects instead of the daemon */
+	const char *pcie_addr;		/* Device PCI address, in-process only */
+	const char *export_desc;	/* Export descriptor file, in-process only */
+	const char *buf_info;		/* Buffer info file, in-process only */
+	struct dma_client *client;	/* Daemon connection */
+	struct dma_engine eng;		/* In-process DOCA objects */
+	char *data;			/* Local buffer */
+	size_t data_len;		/* Local buffer length */
+	enum dmad_op op;		/* READ with a host buffer, COPY without */
+	uint64_t completed;		/* Completions collected */
+	uint64_t failed;		/* Completions with an error */
+};
+
+/*
+ * Current time
+ *
+ * @return: CLOCK_MONOTONIC in nanoseconds
+ */
+static uint64_t
+now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000UL + ts.tv_nsec;
+}
+
+/*
+ * In-process completion callback
+ *
+ * @user [in]: benchmark context
+ * @cookie [in]: unused
+ * @status [in]: status of the copy
+ */
+static void
+inproc_done(void *user, uint64_t cookie, doca_error_t status)
+{
+	struct bench_ctx *ctx = user;
+
+	(void)cookie;
+	ctx->completed++;
+	if (status != DOCA_SUCCESS)
+		ctx->failed++;
+}
+
+/*
+ * Attach to the daemon, or open the device and start a DMA context in this process
+ *
+ * @ctx [in]: benchmark context
+ * @return: 0 on success and -1 otherwise
+ */
+static int
+bench_open(struct bench_ctx *ctx)
+{
+	bool remote;
+
+	if (!ctx->inproc) {
+		ctx->client = dma_client_attach();
+		if (ctx->client == NULL)
+			return -1;
+		ctx->data = dma_client_data(ctx->client, &ctx->data_len);
+		remote = dma_client_remote_len(ctx->client) >= sizes[NB_SIZES - 1];
+	} else {
+		ctx->data_len = DMAD_CLIENT_DATA;
+		ctx->data = aligned_alloc(4096, ctx->data_len);
+		if (ctx->data == NULL)
+			return -1;
+		if (dma_engine_create(&ctx->eng, ctx->pcie_addr, ctx->export_desc, ctx->buf_info, ctx->data,
+				      ctx->data_len, BENCH_DEPTH, inproc_done, ctx) != DOCA_SUCCESS) {
+			free(ctx->data);
+			return -1;
+		}
+		remote = ctx->eng.remote_len >= sizes[NB_SIZES - 1];
+	}
+	ctx->op = remote ? DMAD_OP_READ : DMAD_OP_COPY;
+	return 0;
+}
+
+/*
+ * Detach from the daemon, or tear the DOCA objects down
+ *
+ * @ctx [in]: benchmark context
+ */
+static void
+bench_close(struct bench_ctx *ctx)
+{
+	if (!ctx->inproc) {
+		dma_client_detach(ctx->client);
+		return;
+	}
+	dma_engine_destroy(&ctx->eng);
+	free(ctx->data);
+}
+
+/*
+ * Submit one copy of len bytes
+ *
+ * @ctx [in]: benchmark context
+ * @len [in]: bytes to copy
+ * @return: 0 on success and -1 otherwise
+ */
+static int
+bench_submit(struct bench_ctx *ctx, uint32_t len)
+{
+	struct dmad_req req = {.id = 0, .src_off = 0, .dst_off = 0, .len = len, .op = ctx->op};
+
+	/* A local copy goes from the first half of the data area to the second */
+	if (ctx->op == DMAD_OP_COPY)
+		req.dst_off = ctx->data_len / 2;
+	if (!ctx->inproc)
+		return dma_client_submit(ctx->client, &req);
+	return dma_engine_submit(&ctx->eng, req.op, req.src_off, req.dst_off, len, 0) == DOCA_SUCCESS ? 0 : -1;
+}
+
+/*
+ * Collect completions
+ *
+ * @ctx [in]: benchmark context
+ */
+static void
+bench_poll(struct bench_ctx *ctx)
+{
+	struct dmad_cpl cpl[BENCH_DEPTH];
+	int i, n;
+
+	if (ctx->inproc) {
+		(void)dma_engine_progress(&ctx->eng);
+		return;
+	}
+	n = dma_client_poll(ctx->client, cpl, BENCH_DEPTH);
+	for (i = 0; i < n; i++)
+		if (cpl[i].status != 0)
+			ctx->failed++;
+	ctx->completed += n;
+}
+
+/*
+ * Run nb_ops copies of len bytes with depth of them outstanding
+ *
+ * @ctx [in]: benchmark context
+ * @len [in]: bytes per copy
+ * @nb_ops [in]: number of copies
+ * @depth [in]: copies outstanding at most
+ * @lat_ns [out]: per-copy latency when depth is 1, may be NULL
+ * @return: 0 on success and -1 otherwise
+ */
+static int
+run_ops(struct bench_ctx *ctx, uint32_t len, uint64_t nb_ops, uint32_t depth, double *lat_ns)
+{
+	uint64_t posted = 0, start = 0, base = ctx->completed;
+
+	while (ctx->completed - base < nb_ops) {
+		if (posted < nb_ops && posted - (ctx->completed - base) < depth) {
+			if (lat_ns != NULL)
+				start = now_ns();
+			if (bench_submit(ctx, len) != 0) {
+				fprintf(stderr, "Failed to submit request %" PRIu64 "\n", posted);
+				return -1;
+			}
+			posted++;
+			continue;
+		}
+		bench_poll(ctx);
+		if (lat_ns != NULL && ctx->completed - base == posted)
+			lat_ns[posted - 1] = now_ns() - start;
+	}
+	if (ctx->failed > 0) {
+		fprintf(stderr, "%" PRIu64 " requests failed\n", ctx->failed);
+		return -1;
+	}
+	return 0;
+}
+
+/*
+ * Compare two doubles for qsort
+ *
+ * @a [in]: first value
+ * @b [in]: second value
+ * @return: <0, 0 or >0
+ */
+static int
+cmp_double(const void *a, const void *b)
+{
+	double x = *(const double *)a, y = *(const double *)b;
+
+	return (x > y) - (x < y);
+}
+
+/*
+ * Per-request latency and throughput for every size
+ *
+ * @ctx [in]: open benchmark context
+ * @return: 0 on success and -1 otherwise
+ */
+static int
+run_sizes(struct bench_ctx *ctx)
+{
+	static double lat_ns[LAT_ITERS];
+	uint64_t start, nb_ops;
+	double sum, ns;
+	size_t s;
+	int i;
+
+	printf("Size\t\t Avg Lat(us)\t p50(us)\t p99(us)\t Mops\t\t GB/s\n");
+	for (s = 0; s < NB_SIZES; s++) {
+		if (run_ops(ctx, sizes[s], LAT_ITERS, 1, lat_ns) != 0)
+			return -1;
+		sum = 0;
+		for (i = 0; i < LAT_ITERS; i++)
+			sum += lat_ns[i];
+		qsort(lat_ns, LAT_ITERS, sizeof(double), cmp_double);
+
+		nb_ops = THR_BYTES / sizes[s] < THR_OPS ? THR_BYTES / sizes[s] : THR_OPS;
+		start = now_ns();
+		if (run_ops(ctx, sizes[s], nb_ops, BENCH_DEPTH, NULL) != 0)
+			return -1;
+		ns = now_ns() - start;
+
+		printf("%-10u\t %8.2f\t %8.2f\t %8.2f\t %8.4f\t %8.3f\n", sizes[s], sum / LAT_ITERS / 1000,
+		       lat_ns[LAT_ITERS / 2] / 1000, lat_ns[LAT_ITERS * 99 / 100] / 1000, nb_ops / ns * 1000,
+		       nb_ops * sizes[s] / ns);
+		fflush(stdout);
+	}
+	return 0;
+}
+
+/*
+ * Short jobs: set up, copy JOB_OPS x JOB_SIZE bytes, tear down
+ *
+ * @ctx [in]: closed benchmark context
+ * @return: 0 on success and -1 otherwise
+ */
+static int
+run_jobs(struct bench_ctx *ctx)
+{
+	uint64_t t0, t1, t2, t3;
+	double setup = 0, work = 0, teardown = 0;
+	int j;
+
+	for (j = 0; j < NB_JOBS; j++) {
+		t0 = now_ns();
+		if (bench_open(ctx) != 0)
+			return -1;
+		t1 = now_ns();
+		if (run_ops(ctx, JOB_SIZE, JOB_OPS, BENCH_DEPTH, NULL) != 0) {
+			bench_close(ctx);
+			return -1;
+		}
+		t2 = now_ns();
+		bench_close(ctx);
+		t3 = now_ns();
+		setup += t1 - t0;
+		work += t2 - t1;
+		teardown += t3 - t2;
+	}
+	printf("Short jobs: %d x (%d x %d bytes)\n", NB_JOBS, JOB_OPS, JOB_SIZE);
+	printf("Setup(us)\t Work(us)\t Teardown(us)\t Job(us)\n");
+	printf("%9.1f\t %8.1f\t %12.1f\t %7.1f\n", setup / NB_JOBS / 1000, work / NB_JOBS / 1000,
+	       teardown / NB_JOBS / 1000, (setup + work + teardown) / NB_JOBS / 1000);
+	return 0;
+}
+
+/*
+ * Run the client benchmark against the DMA daemon or with in-process DOCA objects
+ *
+ * @inproc [in]: use DOCA objects of this process instead of the daemon
+ * @export_desc_file_path [in]: Export descriptor file path, in-process only
+ * @buffer_info_file_path [in]: Buffer info file path, in-process only
+ * @pcie_addr [in]: Device PCI address, in-process only
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t
+dma_client_bench_dpu(bool inproc, const char *export_desc_file_path, const char *buffer_info_file_path,
+		     const char *pcie_addr)
+{
+	static struct bench_ctx ctx;
+	uint64_t start, setup;
+	int ret;
+
+	ctx.inproc = inproc;
+	ctx.pcie_addr = pcie_addr;
+	ctx.export_desc = export_desc_file_path;
+	ctx.buf_info = buffer_info_file_path;
+
+	start = now_ns();
+	if (bench_open(&ctx) != 0)
+		return DOCA_ERROR_INITIALIZATION;
+	setup = now_ns() - start;
+
+	printf("Mode %s, %s, setup %.1f us\n", inproc ? "in-process" : "daemon",
+	       ctx.op == DMAD_OP_READ ? "host to local reads" : "local copies", setup / 1000.0);
+	ret = run_sizes(&ctx);
+
+	start = now_ns();
+	bench_close(&ctx);
+	printf("Teardown %.1f us\n\n", (now_ns() - start) / 1000.0);
+	if (ret == 0)
+		ret = run_jobs(&ctx);
+	fflush(stdout);
+	return ret == 0 ? DOCA_SUCCESS : DOCA_ERROR_IO_FAILED;
+}
@@ -0,0 +1,171 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+#ifndef DMA_DAEMON_H_
+#define DMA_DAEMON_H_
+
+#include <stdint.h>
+
+/*
+ * Shared-memory protocol of the DMA offload daemon
+ *
+ * The daemon owns the DOCA device, the DMA context and, on the DPU, the imported host buffer, and creates one POSIX
+ * shared memory segment. The segment holds a header, a slot per client and one data area per client; the daemon
+ * registers all data areas with the device once. A client claims a free slot, writes requests into its submission
+ * ring and reads completions from its completion ring. Both rings are single-producer single-consumer: the client
+ * produces requests and the daemon consumes them, and the other way around for completions. A client never has more
+ * than DMAD_RING_SIZE requests outstanding, so the daemon never finds a completion ring full.
+ */
+
+#define DMAD_SHM_NAME "/dpudmabench_dma_daemon"	/* POSIX shared memory object */
+#define DMAD_MAGIC 0x444d4144			/* "DMAD", set once the daemon is ready */
+#define DMAD_MAX_CLIENTS 8			/* Client slots */
+#define DMAD_RING_SIZE 256			/* Entries per ring, a power of two */
+#define DMAD_CLIENT_DATA (16UL << 20)		/* Data area of every client */
+#define DMAD_CACHE_LINE 64			/* Ring indices live on their own cache lines */
+
+/* Copy directions, offsets of the local side are relative to the data area of the client */
+enum dmad_op {
+	DMAD_OP_READ,	/* Remote (host buffer) to local */
+	DMAD_OP_WRITE,	/* Local to remote */
+	DMAD_OP_COPY,	/* Local to local, the only direction of a daemon without a remote buffer */
+};
+
+/* Client slot states */
+enum dmad_slot_state {
+	DMAD_SLOT_FREE,		/* Can be claimed */
+	DMAD_SLOT_ATTACHED,	/* Owned by a client */
+	DMAD_SLOT_DETACHING,	/* Released by its client, freed by the daemon once idle */
+};
+
+/* Copy request */
+struct dmad_req {
+	uint64_t id;		/* Returned in the completion */
+	uint64_t src_off;	/* Source offset */
+	uint64_t dst_off;	/* Destination offset */
+	uint32_t len;		/* Bytes to copy */
+	uint32_t op;		/* enum dmad_op */
+};
+
+/* Completion of a request */
+struct dmad_cpl {
+	uint64_t id;		/* Id of the request */
+	int32_t status;		/* doca_error_t of the copy, 0 on success */
+	uint32_t reserved;	/* Padding */
+};
+
+/* Ring indices, head is written by the consumer and tail by the producer */
+struct dmad_ring_idx {
+	uint64_t head __attribute__((aligned(DMAD_CACHE_LINE)));	/* Next entry to consume */
+	uint64_t tail __attribute__((aligned(DMAD_CACHE_LINE)));	/* Next entry to produce */
+};
+
+/* Submission ring, client to daemon */
+struct dmad_sq {
+	struct dmad_ring_idx idx;		/* Indices */
+	struct dmad_req e[DMAD_RING_SIZE];	/* Entries */
+};
+
+/* Completion ring, daemon to client */
+struct dmad_cq {
+	struct dmad_ring_idx idx;		/* Indices */
+	struct dmad_cpl e[DMAD_RING_SIZE];	/* Entries */
+};
+
+/* Client slot */
+struct dmad_slot {
+	uint32_t state __attribute__((aligned(DMAD_CACHE_LINE)));	/* enum dmad_slot_state */
+	int32_t pid;							/* Owning process */
+	struct dmad_sq sq;						/* Requests */
+	struct dmad_cq cq;						/* Completions */
+};
+
+/* Header of the segment, followed by the client data areas at data_off */
+struct dmad_shm {
+	uint32_t magic;				/* DMAD_MAGIC once the daemon serves requests */
+	uint32_t nb_slots;			/* DMAD_MAX_CLIENTS */
+	uint64_t remote_len;			/* Length of the host buffer, 0 without one */
+	uint64_t data_off;			/* Offset of the first data area in the segment */
+	uint64_t data_len;			/* Length of every data area */
+	struct dmad_slot slots[DMAD_MAX_CLIENTS];	/* Client slots */
+};
+
+/*
+ * Produce one entry of a ring
+ *
+ * @idx [in]: ring indices
+ * @slot [out]: index of the entry to fill
+ * @return: 0 if there is room and -1 if the ring is full
+ */
+static inline int
+dmad_ring_reserve(struct dmad_ring_idx *idx, uint32_t *slot)
+{
+	uint64_t tail = idx->tail;
+
+	if (tail - __atomic_load_n(&idx->head, __ATOMIC_ACQUIRE) == DMAD_RING_SIZE)
+		return -1;
+	*slot = tail & (DMAD_RING_SIZE - 1);
+	return 0;
+}
+
+/*
+ * Publish the entry returned by dmad_ring_reserve()
+ *
+ * @idx [in]: ring indices
+ */
+static inline void
+dmad_ring_publish(struct dmad_ring_idx *idx)
+{
+	__atomic_store_n(&idx->tail, idx->tail + 1, __ATOMIC_RELEASE);
+}
+
+/*
+ * Look at the oldest entry of a ring
+ *
+ * @idx [in]: ring indices
+ * @slot [out]: index of the entry to read
+ * @return: 0 if there is an entry and -1 if the ring is empty
+ */
+static inline int
+dmad_ring_peek(struct dmad_ring_idx *idx, uint32_t *slot)
+{
+	uint64_t head = idx->head;
+
+	if (__atomic_load_n(&idx->tail, __ATOMIC_ACQUIRE) == head)
+		return -1;
+	*slot = head & (DMAD_RING_SIZE - 1);
+	return 0;
+}
+
+/*
+ * Release the entry returned by dmad_ring_peek()
+ *
+ * @idx [in]: ring indices
+ */
+static inline void
+dmad_ring_consume(struct dmad_ring_idx *idx)
+{
+	__atomic_store_n(&idx->head, idx->head + 1, __ATOMIC_RELEASE);
+}
+
+/*
+ * Size of the shared memory segment
+ *
+ * @return: header, rounded up to a page, plus every client data area
+ */
+static inline uint64_t
+dmad_shm_size(void)
+{
+	return ((sizeof(struct dmad_shm) + 4095) & ~4095UL) + DMAD_MAX_CLIENTS * DMAD_CLIENT_DATA;
+}
+
+#endif
@@ -0,0 +1,289 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <doca_error.h>
+#include <doca_log.h>
+
+#include "dma_engine.h"
+
+DOCA_LOG_REGISTER(DMA_DAEMON_DPU);
+
+#define DAEMON_TASKS 64			/* Tasks in the engine at most, shared by every client */
+#define DAEMON_BURST 16			/* Requests taken from one client before moving to the next */
+#define LIVENESS_PERIOD (1U << 20)	/* Polling rounds between checks for crashed clients */
+
+/* Request handed to the engine */
+struct pending {
+	uint64_t id;	/* Id chosen by the client */
+	uint32_t slot;	/* Client slot */
+	uint32_t next;	/* Next free entry */
+};
+
+/* Daemon state */
+struct daemon_state {
+	struct dmad_shm *shm;				/* Shared segment */
+	struct dma_engine eng;				/* DOCA objects */
+	struct pending pending[DAEMON_TASKS];		/* Requests in the engine */
+	uint32_t free_pending;				/* First free entry of pending, DAEMON_TASKS if none */
+	uint32_t inflight[DMAD_MAX_CLIENTS];		/* Requests of every slot in the engine */
+	uint64_t served[DMAD_MAX_CLIENTS];		/* Requests completed for the current client of a slot */
+	uint64_t bytes[DMAD_MAX_CLIENTS];		/* Bytes copied for the current client of a slot */
+	uint64_t clients;				/* Clients served so far */
+};
+
+static volatile sig_atomic_t stop_daemon;	/* Set by SIGINT and SIGTERM */
+
+/*
+ * Signal handler, lets the polling loop exit
+ *
+ * @signum [in]: signal number
+ */
+static void
+signal_handler(int signum)
+{
+	(void)signum;
+	stop_daemon = 1;
+}
+
+/*
+ * Write one completion to the completion ring of a slot
+ *
+ * @st [in]: daemon state
+ * @slot [in]: client slot
+ * @id [in]: id of the request
+ * @status [in]: status of the copy
+ */
+static void
+complete_request(struct daemon_state *st, uint32_t slot, uint64_t id, doca_error_t status)
+{
+	struct dmad_cq *cq = &st->shm->slots[slot].cq;
+	uint32_t idx;
+
+	/* Clients keep at most DMAD_RING_SIZE requests outstanding, there is always room */
+	if (dmad_ring_reserve(&cq->idx, &idx) != 0) {
+		DOCA_LOG_ERR("Completion ring of slot %u overflowed", slot);
+		return;
+	}
+	cq->e[idx].id = id;
+	cq->e[idx].status = status;
+	cq->e[idx].reserved = 0;
+	dmad_ring_publish(&cq->idx);
+}
+
+/*
+ * Engine completion callback, returns the completion to its client
+ *
+ * @user [in]: daemon state
+ * @cookie [in]: index in the pending table
+ * @status [in]: status of the copy
+ */
+static void
+daemon_copy_done(void *user, uint64_t cookie, doca_error_t status)
+{
+	struct daemon_state *st = user;
+	struct pending *p = &st->pending[cookie];
+
+	complete_request(st, p->slot, p->id, status);
+	st->inflight[p->slot]--;
+	st->served[p->slot]++;
+	p->next = st->free_pending;
+	st->free_pending = cookie;
+}
+
+/*
+ * Translate a request of a slot to engine offsets and submit it
+ *
+ * @st [in]: daemon state
+ * @slot [in]: client slot
+ * @req [in]: request read from the submission ring
+ */
+static void
+serve_request(struct daemon_state *st, uint32_t slot, const struct dmad_req *req)
+{
+	uint64_t base = slot * DMAD_CLIENT_DATA, src_off = req->src_off, dst_off = req->dst_off;
+	uint32_t cookie = st->free_pending;
+	doca_error_t result;
+
+	/* The local side must stay inside the data area of the slot */
+	if ((req->op != DMAD_OP_READ && (src_off > DMAD_CLIENT_DATA || req->len > DMAD_CLIENT_DATA - src_off)) ||
+	    (req->op != DMAD_OP_WRITE && (dst_off > DMAD_CLIENT_DATA || req->len > DMAD_CLIENT_DATA - dst_off))) {
+		complete_request(st, slot, req->id, DOCA_ERROR_INVALID_VALUE);
+		return;
+	}
+	if (req->op != DMAD_OP_READ)
+		src_off += base;
+	if (req->op != DMAD_OP_WRITE)
+		dst_off += base;
+
+	st->pending[cookie].id = req->id;
+	st->pending[cookie].slot = slot;
+	result = dma_engine_submit(&st->eng, req->op, src_off, dst_off, req->len, cookie);
+	if (result != DOCA_SUCCESS) {
+		complete_request(st, slot, req->id, result);
+		return;
+	}
+	st->free_pending = st->pending[cookie].next;
+	st->inflight[slot]++;
+	st->bytes[slot] += req->len;
+}
+
+/*
+ * Serve one slot: take its requests, or free it once its client is gone
+ *
+ * @st [in]: daemon state
+ * @slot [in]: client slot
+ * @check_alive [in]: also check that the owning process still exists
+ */
+static void
+poll_slot(struct daemon_state *st, uint32_t slot, bool check_alive)
+{
+	struct dmad_slot *s = &st->shm->slots[slot];
+	uint32_t state = __atomic_load_n(&s->state, __ATOMIC_ACQUIRE);
+	uint32_t idx, n;
+
+	if (state == DMAD_SLOT_ATTACHED) {
+		if (check_alive && s->pid != 0 && kill(s->pid, 0) != 0 && errno == ESRCH) {
+			DOCA_LOG_WARN("Client %d of slot %u exited without detaching", s->pid, slot);
+			__atomic_store_n(&s->state, DMAD_SLOT_DETACHING, __ATOMIC_RELEASE);
+			return;
+		}
+		for (n = 0; n < DAEMON_BURST && st->free_pending != DAEMON_TASKS; n++) {
+			if (dmad_ring_peek(&s->sq.idx, &idx) != 0)
+				break;
+			serve_request(st, slot, &s->sq.e[idx]);
+			dmad_ring_consume(&s->sq.idx);
+		}
+	} else if (state == DMAD_SLOT_DETACHING && st->inflight[slot] == 0) {
+		printf("Slot %u: client %d detached after %" PRIu64 " requests, %" PRIu64 " bytes\n", slot, s->pid,
+		       st->served[slot], st->bytes[slot]);
+		fflush(stdout);
+		st->served[slot] = 0;
+		st->bytes[slot] = 0;
+		st->clients++;
+		s->pid = 0;
+		memset(&s->sq.idx, 0, sizeof(s->sq.idx));
+		memset(&s->cq.idx, 0, sizeof(s->cq.idx));
+		__atomic_store_n(&s->state, DMAD_SLOT_FREE, __ATOMIC_RELEASE);
+	}
+}
+
+/*
+ * Create the shared segment, replacing one left behind by a daemon that did not exit cleanly
+ *
+ * @return: mapped segment on success and NULL otherwise
+ */
+static struct dmad_shm *
+create_segment(void)
+{
+	struct dmad_shm *shm;
+	int fd;
+
+	fd = shm_open(DMAD_SHM_NAME, O_RDWR | O_CREAT | O_EXCL, 0666);
+	if (fd < 0 && errno == EEXIST) {
+		DOCA_LOG_WARN("Removing stale %s", DMAD_SHM_NAME);
+		shm_unlink(DMAD_SHM_NAME);
+		fd = shm_open(DMAD_SHM_NAME, O_RDWR | O_CREAT | O_EXCL, 0666);
+	}
+	if (fd < 0) {
+		DOCA_LOG_ERR("Failed to create %s: %s", DMAD_SHM_NAME, strerror(errno));
+		return NULL;
+	}
+	/* Clients of other users attach too, so the mode is not left to the umask */
+	if (fchmod(fd, 0666) != 0 || ftruncate(fd, dmad_shm_size()) != 0) {
+		DOCA_LOG_ERR("Failed to size %s: %s", DMAD_SHM_NAME, strerror(errno));
+		close(fd);
+		shm_unlink(DMAD_SHM_NAME);
+		return NULL;
+	}
+	shm = mmap(NULL, dmad_shm_size(), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+	close(fd);
+	if (shm == MAP_FAILED) {
+		DOCA_LOG_ERR("Failed to map %s: %s", DMAD_SHM_NAME, strerror(errno));
+		shm_unlink(DMAD_SHM_NAME);
+		return NULL;
+	}
+	shm->nb_slots = DMAD_MAX_CLIENTS;
+	shm->data_off = dmad_shm_size() - DMAD_MAX_CLIENTS * DMAD_CLIENT_DATA;
+	shm->data_len = DMAD_CLIENT_DATA;
+	return shm;
+}
+
+/*
+ * Run the DMA offload daemon on the DPU until SIGINT or SIGTERM
+ *
+ * @export_desc_file_path [in]: Export descriptor file path
+ * @buffer_info_file_path [in]: Buffer info file path
+ * @pcie_addr [in]: Device PCI address
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t
+dma_daemon_dpu(const char *export_desc_file_path, const char *buffer_info_file_path, const char *pcie_addr)
+{
+	static struct daemon_state st;
+	struct sigaction sa;
+	uint64_t rounds = 0;
+	doca_error_t result;
+	uint32_t i;
+
+	st.shm = create_segment();
+	if (st.shm == NULL)
+		return DOCA_ERROR_OPERATING_SYSTEM;
+
+	for (i = 0; i < DAEMON_TASKS; i++)
+		st.pending[i].next = i + 1;
+	st.free_pending = 0;
+
+	result = dma_engine_create(&st.eng, pcie_addr, export_desc_file_path, buffer_info_file_path,
+				   (char *)st.shm + st.shm->data_off, DMAD_MAX_CLIENTS * DMAD_CLIENT_DATA, DAEMON_TASKS,
+				   daemon_copy_done, &st);
+	if (result != DOCA_SUCCESS)
+		goto unmap;
+	st.shm->remote_len = st.eng.remote_len;
+
+	memset(&sa, 0, sizeof(sa));
+	sa.sa_handler = signal_handler;
+	sigaction(SIGINT, &sa, NULL);
+	sigaction(SIGTERM, &sa, NULL);
+
+	__atomic_store_n(&st.shm->magic, DMAD_MAGIC, __ATOMIC_RELEASE);
+	printf("DMA daemon ready on %s: %u slots, %lu MB data area each, host buffer %" PRIu64 " bytes\n",
+	       DMAD_SHM_NAME, DMAD_MAX_CLIENTS, DMAD_CLIENT_DATA >> 20, st.shm->remote_len);
+	fflush(stdout);
+
+	/* Busy polls one core, as the polling benchmarks do */
+	while (!stop_daemon) {
+		rounds++;
+		for (i = 0; i < DMAD_MAX_CLIENTS; i++)
+			poll_slot(&st, i, rounds % LIVENESS_PERIOD == 0);
+		(void)dma_engine_progress(&st.eng);
+	}
+
+	__atomic_store_n(&st.shm->magic, 0, __ATOMIC_RELEASE);
+	printf("DMA daemon stopping after %" PRIu64 " clients\n", st.clients);
+	result = dma_engine_destroy(&st.eng);
+unmap:
+	munmap(st.shm, dmad_shm_size());
+	shm_unlink(DMAD_SHM_NAME);
+	return result;
+}
@@ -0,0 +1,356 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <doca_buf.h>
+#include <doca_ctx.h>
+#include <doca_error.h>
+#include <doca_log.h>
+
+#include "dma_common.h"
+#include "dma_engine.h"
+
+DOCA_LOG_REGISTER(DMA_ENGINE);
+
+#define RECV_BUF_SIZE 256		/* Buffer which contains config information */
+#define MAX_DESC_SIZE 1024		/* Maximum size of the export descriptor */
+
+/*
+ * Saves export descriptor and buffer information content into memory buffers
+ *
+ * @export_desc_file_path [in]: Export descriptor file path
+ * @buffer_info_file_path [in]: Buffer information file path
+ * @export_desc [in]: Export descriptor buffer
+ * @export_desc_len [in]: Export descriptor buffer length
+ * @remote_addr [in]: Remote buffer address
+ * @remote_addr_len [in]: Remote buffer total length
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+save_config_info_to_buffers(const char *export_desc_file_path, const char *buffer_info_file_path, char *export_desc,
+			    size_t *export_desc_len, char **remote_addr, size_t *remote_addr_len)
+{
+	FILE *fp;
+	long file_size;
+	char buffer[RECV_BUF_SIZE];
+
+	fp = fopen(export_desc_file_path, "r");
+	if (fp == NULL) {
+		DOCA_LOG_ERR("Failed to open %s", export_desc_file_path);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	if (fseek(fp, 0, SEEK_END) != 0) {
+		DOCA_LOG_ERR("Failed to calculate file size");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	file_size = ftell(fp);
+	if (file_size == -1) {
+		DOCA_LOG_ERR("Failed to calculate file size");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	if (file_size > MAX_DESC_SIZE)
+		file_size = MAX_DESC_SIZE;
+
+	*export_desc_len = file_size;
+
+	if (fseek(fp, 0L, SEEK_SET) != 0) {
+		DOCA_LOG_ERR("Failed to calculate file size");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	if (fread(export_desc, 1, file_size, fp) != (size_t)file_size) {
+		DOCA_LOG_ERR("Failed to read the export descriptor");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	fclose(fp);
+
+	/* Read source buffer information from file */
+	fp = fopen(buffer_info_file_path, "r");
+	if (fp == NULL) {
+		DOCA_LOG_ERR("Failed to open %s", buffer_info_file_path);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	/* Get source buffer address */
+	if (fgets(buffer, RECV_BUF_SIZE, fp) == NULL) {
+		DOCA_LOG_ERR("Failed to read the source (host) buffer address");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+	*remote_addr = (char *)strtoull(buffer, NULL, 0);
+
+	memset(buffer, 0, RECV_BUF_SIZE);
+
+	/* Get source buffer length */
+	if (fgets(buffer, RECV_BUF_SIZE, fp) == NULL) {
+		DOCA_LOG_ERR("Failed to read the source (host) buffer length");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+	*remote_addr_len = strtoull(buffer, NULL, 0);
+
+	fclose(fp);
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Give back the buffers and the task of a finished copy and report it
+ *
+ * @dma_task [in]: finished task
+ * @cookie [in]: cookie of the copy
+ * @eng [in]: engine
+ * @status [in]: status of the task
+ */
+static void
+copy_finished(struct doca_dma_task_memcpy *dma_task, uint64_t cookie, struct dma_engine *eng, doca_error_t status)
+{
+	doca_buf_dec_refcount((struct doca_buf *)doca_dma_task_memcpy_get_src(dma_task), NULL);
+	doca_buf_dec_refcount(doca_dma_task_memcpy_get_dst(dma_task), NULL);
+	doca_task_free(doca_dma_task_memcpy_as_task(dma_task));
+	eng->inflight--;
+	eng->done(eng->user, cookie, status);
+}
+
+/*
+ * Copy completed callback
+ *
+ * @dma_task [in]: Completed task
+ * @task_user_data [in]: doca_data from the task, the cookie
+ * @ctx_user_data [in]: doca_data from the context, the engine
+ */
+static void
+engine_completed_callback(struct doca_dma_task_memcpy *dma_task, union doca_data task_user_data,
+			  union doca_data ctx_user_data)
+{
+	copy_finished(dma_task, task_user_data.u64, ctx_user_data.ptr, DOCA_SUCCESS);
+}
+
+/*
+ * Copy error callback
+ *
+ * @dma_task [in]: failed task
+ * @task_user_data [in]: doca_data from the task, the cookie
+ * @ctx_user_data [in]: doca_data from the context, the engine
+ */
+static void
+engine_error_callback(struct doca_dma_task_memcpy *dma_task, union doca_data task_user_data,
+		      union doca_data ctx_user_data)
+{
+	copy_finished(dma_task, task_user_data.u64, ctx_user_data.ptr,
+		      doca_task_get_status(doca_dma_task_memcpy_as_task(dma_task)));
+}
+
+doca_error_t
+dma_engine_create(struct dma_engine *eng, const char *pcie_addr, const char *export_desc_path,
+		  const char *buffer_info_path, void *local, size_t local_len, uint32_t max_tasks,
+		  dma_engine_done_cb done, void *user)
+{
+	char export_desc[MAX_DESC_SIZE];
+	size_t export_desc_len;
+	union doca_data data;
+	doca_error_t result;
+
+	memset(eng, 0, sizeof(*eng));
+	eng->local = local;
+	eng->local_len = local_len;
+	eng->max_tasks = max_tasks;
+	eng->done = done;
+	eng->user = user;
+	data.ptr = eng;
+
+	if (export_desc_path != NULL) {
+		result = save_config_info_to_buffers(export_desc_path, buffer_info_path, export_desc,
+						     &export_desc_len, &eng->remote, &eng->remote_len);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to read memory configuration from file: %s", doca_error_get_descr(result));
+			return result;
+		}
+	}
+
+	result = open_doca_device_with_pci(pcie_addr, &dma_task_is_supported, &eng->dev);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to open DOCA device: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_mmap_create(&eng->local_mmap);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_add_dev(eng->local_mmap, eng->dev);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_set_memrange(eng->local_mmap, local, local_len);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_start(eng->local_mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start local mmap: %s", doca_error_get_descr(result));
+		goto destroy_engine;
+	}
+
+	if (export_desc_path != NULL) {
+		result = doca_mmap_create_from_export(NULL, export_desc, export_desc_len, eng->dev,
+						      &eng->remote_mmap);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to create mmap from export: %s", doca_error_get_descr(result));
+			goto destroy_engine;
+		}
+	}
+
+	result = doca_buf_inventory_create(2 * max_tasks, &eng->buf_inv);
+	if (result == DOCA_SUCCESS)
+		result = doca_buf_inventory_start(eng->buf_inv);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start buffer inventory: %s", doca_error_get_descr(result));
+		goto destroy_engine;
+	}
+
+	result = doca_pe_create(&eng->pe);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create progress engine: %s", doca_error_get_descr(result));
+		goto destroy_engine;
+	}
+
+	result = doca_dma_create(eng->dev, &eng->dma);
+	if (result == DOCA_SUCCESS)
+		result = doca_dma_task_memcpy_set_conf(eng->dma, engine_completed_callback, engine_error_callback,
+						       max_tasks);
+	if (result == DOCA_SUCCESS)
+		result = doca_ctx_set_user_data(doca_dma_as_ctx(eng->dma), data);
+	if (result == DOCA_SUCCESS)
+		result = doca_pe_connect_ctx(eng->pe, doca_dma_as_ctx(eng->dma));
+	if (result == DOCA_SUCCESS)
+		result = doca_ctx_start(doca_dma_as_ctx(eng->dma));
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start DMA context: %s", doca_error_get_descr(result));
+		if (eng->dma != NULL) {
+			doca_dma_destroy(eng->dma);
+			eng->dma = NULL;
+		}
+		goto destroy_engine;
+	}
+	return DOCA_SUCCESS;
+
+destroy_engine:
+	dma_engine_destroy(eng);
+	return result;
+}
+
+doca_error_t
+dma_engine_submit(struct dma_engine *eng, enum dmad_op op, uint64_t src_off, uint64_t dst_off, uint32_t len,
+		  uint64_t cookie)
+{
+	struct doca_mmap *src_mmap = eng->local_mmap, *dst_mmap = eng->local_mmap;
+	char *src_base = eng->local, *dst_base = eng->local;
+	size_t src_len = eng->local_len, dst_len = eng->local_len;
+	struct doca_buf *src = NULL, *dst = NULL;
+	struct doca_dma_task_memcpy *task;
+	union doca_data data = {.u64 = cookie};
+	doca_error_t result;
+
+	if (op == DMAD_OP_READ) {
+		src_mmap = eng->remote_mmap;
+		src_base = eng->remote;
+		src_len = eng->remote_len;
+	} else if (op == DMAD_OP_WRITE) {
+		dst_mmap = eng->remote_mmap;
+		dst_base = eng->remote;
+		dst_len = eng->remote_len;
+	} else if (op != DMAD_OP_COPY) {
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	if (src_mmap == NULL || dst_mmap == NULL || len == 0 || src_off > src_len || len > src_len - src_off ||
+	    dst_off > dst_len || len > dst_len - dst_off)
+		return DOCA_ERROR_INVALID_VALUE;
+
+	result = doca_buf_inventory_buf_get_by_addr(eng->buf_inv, src_mmap, src_base + src_off, len, &src);
+	if (result == DOCA_SUCCESS)
+		result = doca_buf_set_data(src, src_base + src_off, len);
+	if (result == DOCA_SUCCESS)
+		result = doca_buf_inventory_buf_get_by_addr(eng->buf_inv, dst_mmap, dst_base + dst_off, len, &dst);
+	if (result == DOCA_SUCCESS)
+		result = doca_dma_task_memcpy_alloc_init(eng->dma, src, dst, data, &task);
+	if (result == DOCA_SUCCESS) {
+		result = doca_task_submit(doca_dma_task_memcpy_as_task(task));
+		if (result != DOCA_SUCCESS)
+			doca_task_free(doca_dma_task_memcpy_as_task(task));
+	}
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to submit a copy: %s", doca_error_get_descr(result));
+		if (src != NULL)
+			doca_buf_dec_refcount(src, NULL);
+		if (dst != NULL)
+			doca_buf_dec_refcount(dst, NULL);
+		return result;
+	}
+	eng->inflight++;
+	return DOCA_SUCCESS;
+}
+
+doca_error_t
+dma_engine_destroy(struct dma_engine *eng)
+{
+	enum doca_ctx_states ctx_state;
+	doca_error_t result = DOCA_SUCCESS, tmp_result;
+
+	if (eng->dma != NULL) {
+		while (eng->inflight > 0)
+			(void)doca_pe_progress(eng->pe);
+		/* Stopped quietly: the in-process jobs of the client benchmark time the teardown */
+		tmp_result = doca_ctx_stop(doca_dma_as_ctx(eng->dma));
+		if (tmp_result == DOCA_ERROR_IN_PROGRESS) {
+			do {
+				(void)doca_pe_progress(eng->pe);
+				tmp_result = doca_ctx_get_state(doca_dma_as_ctx(eng->dma), &ctx_state);
+			} while (tmp_result == DOCA_SUCCESS && ctx_state != DOCA_CTX_STATE_IDLE);
+		}
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+		tmp_result = doca_dma_destroy(eng->dma);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+	if (eng->pe != NULL) {
+		tmp_result = doca_pe_destroy(eng->pe);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+	if (eng->buf_inv != NULL) {
+		tmp_result = doca_buf_inventory_stop(eng->buf_inv);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+		tmp_result = doca_buf_inventory_destroy(eng->buf_inv);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+	if (eng->remote_mmap != NULL) {
+		tmp_result = doca_mmap_destroy(eng->remote_mmap);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+	if (eng->local_mmap != NULL) {
+		tmp_result = doca_mmap_destroy(eng->local_mmap);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+	if (eng->dev != NULL) {
+		tmp_result = doca_dev_close(eng->dev);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Failed to destroy DMA engine: %s", doca_error_get_descr(result));
+	memset(eng, 0, sizeof(*eng));
+	return result;
+}
@@ -0,0 +1,109 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+#ifndef DMA_ENGINE_H_
+#define DMA_ENGINE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <doca_buf_inventory.h>
+#include <doca_dev.h>
+#include <doca_dma.h>
+#include <doca_mmap.h>
+#include <doca_pe.h>
+
+#include "dma_daemon.h"
+
+/*
+ * DOCA objects behind the daemon, and behind the in-process mode of the client benchmark
+ *
+ * Opens the device, registers a local buffer, imports the host buffer when an export descriptor is given, and
+ * starts one DMA context on one progress engine. Every submitted copy takes two buffers from the inventory and one
+ * task, and gives them back on completion before the done callback runs.
+ */
+
+/* Completion callback, status is DOCA_SUCCESS or the error of the task */
+typedef void (*dma_engine_done_cb)(void *user, uint64_t cookie, doca_error_t status);
+
+/* Engine state */
+struct dma_engine {
+	struct doca_dev *dev;			/* DOCA device */
+	struct doca_pe *pe;			/* Progress engine */
+	struct doca_dma *dma;			/* DMA context */
+	struct doca_mmap *local_mmap;		/* Local buffer mmap */
+	struct doca_mmap *remote_mmap;		/* Host buffer mmap, NULL without one */
+	struct doca_buf_inventory *buf_inv;	/* Inventory */
+	char *local;				/* Local buffer */
+	size_t local_len;			/* Local buffer length */
+	char *remote;				/* Host buffer */
+	size_t remote_len;			/* Host buffer length, 0 without one */
+	uint32_t max_tasks;			/* Tasks in flight at most */
+	uint32_t inflight;			/* Tasks in flight */
+	dma_engine_done_cb done;		/* Completion callback */
+	void *user;				/* First argument of the callback */
+};
+
+/*
+ * Open the device and start the DMA context
+ *
+ * @eng [out]: engine
+ * @pcie_addr [in]: device PCI address
+ * @export_desc_path [in]: export descriptor of the host buffer, NULL for local copies only
+ * @buffer_info_path [in]: buffer information of the host buffer, NULL for local copies only
+ * @local [in]: local buffer
+ * @local_len [in]: local buffer length
+ * @max_tasks [in]: tasks in flight at most
+ * @done [in]: completion callback
+ * @user [in]: first argument of the callback
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t dma_engine_create(struct dma_engine *eng, const char *pcie_addr, const char *export_desc_path,
+			       const char *buffer_info_path, void *local, size_t local_len, uint32_t max_tasks,
+			       dma_engine_done_cb done, void *user);
+
+/*
+ * Submit one copy, the caller keeps inflight below max_tasks
+ *
+ * @eng [in]: engine
+ * @op [in]: copy direction
+ * @src_off [in]: source offset in the local or host buffer
+ * @dst_off [in]: destination offset in the local or host buffer
+ * @len [in]: bytes to copy
+ * @cookie [in]: passed to the done callback
+ * @return: DOCA_SUCCESS on success, DOCA_ERROR_INVALID_VALUE for a copy outside the buffers and DOCA_ERROR otherwise
+ */
+doca_error_t dma_engine_submit(struct dma_engine *eng, enum dmad_op op, uint64_t src_off, uint64_t dst_off,
+			       uint32_t len, uint64_t cookie);
+
+/*
+ * Poll for completions, done callbacks run from here
+ *
+ * @eng [in]: engine
+ * @return: true if a completion was handled
+ */
+static inline bool
+dma_engine_progress(struct dma_engine *eng)
+{
+	return doca_pe_progress(eng->pe) != 0;
+}
+
+/*
+ * Wait for the tasks in flight, then stop and destroy everything
+ *
+ * @eng [in]: engine
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t dma_engine_destroy(struct dma_engine *eng);
+
+#endif
@@ -0,0 +1,38 @@
+# /*
+# * Copyright (c) 2025, University of California, Merced. All rights reserved.
+# *
+# * This file is part of the benchmarking software package developed by
+# * the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+# *
+# * For detailed copyright and licensing information, please refer to the license
+# * file LICENSE in the top level directory.
+# *
+# */
+
+
+# Usage: run.sh [number of concurrent clients]
+# Start host/dma_write_d_to_h_lat_poll/run.sh 33554432 on the host first.
+# The in-process run goes first, then the clients share the daemon.
+clients=${1:-1}
+scp <user>@<host>:/tmp/buffer_info.txt .
+scp <user>@<host>:/tmp/export_desc.txt .
+echo ""
+
+make clean
+make
+echo ""
+
+./doca_dma_client_bench -m inproc -p 03:00.0 -d export_desc.txt -b buffer_info.txt | tee dma_client_inproc.txt
+echo ""
+
+./doca_dma_daemon -p 03:00.0 -d export_desc.txt -b buffer_info.txt > dma_daemon.txt &
+daemon=$!
+sleep 2
+for i in $(seq 1 ${clients}); do
+	./doca_dma_client_bench -m daemon > dma_client_daemon.txt.$i &
+	pids="${pids} $!"
+done
+wait ${pids}
+kill -TERM ${daemon}
+wait ${daemon}
+cat dma_client_daemon.txt.* dma_daemon.txt
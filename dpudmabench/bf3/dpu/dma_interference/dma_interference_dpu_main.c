@@ -0,0 +1,333 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <doca_argp.h>
+#include <doca_log.h>
+
+#include "dma_common.h"
+
+DOCA_LOG_REGISTER(DMA_INTERFERENCE_DPU::MAIN);
+
+/* Configuration struct, dma_conf comes first so the dma_common ARGP callbacks can use it */
+struct interference_config {
+	struct dma_config dma_conf;		/* Device and host buffer */
+	char generator[MAX_ARG_SIZE];		/* Path of the interfere binary */
+	char kinds[MAX_ARG_SIZE];		/* Comma separated loads */
+	char cores[MAX_ARG_SIZE];		/* Core list of the loads */
+	int dma_core;				/* Core of the DMA workload */
+	char tcp_target[MAX_ARG_SIZE];		/* Remote tcp_sink, empty for loopback */
+	size_t size;				/* Transfer size of the throughput phase */
+	uint32_t duration_s;			/* Length of every phase */
+};
+
+/* Sample's Logic */
+doca_error_t dma_interference_dpu(const char *generator, char *kinds, const char *cores, int dma_core,
+				  const char *tcp_target, size_t size, uint32_t duration_s,
+				  const char *export_desc_file_path, const char *buffer_info_file_path,
+				  const char *pcie_addr);
+
+/*
+ * ARGP Callback - Handle generator parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+generator_callback(void *param, void *config)
+{
+	struct interference_config *conf = (struct interference_config *)config;
+	const char *value = (char *)param;
+
+	if (strnlen(value, MAX_ARG_SIZE) == MAX_ARG_SIZE) {
+		DOCA_LOG_ERR("Generator path is too long - MAX=%d", MAX_USER_ARG_SIZE);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	strcpy(conf->generator, value);
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle interferers parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+interferers_callback(void *param, void *config)
+{
+	struct interference_config *conf = (struct interference_config *)config;
+	const char *value = (char *)param;
+
+	if (strnlen(value, MAX_ARG_SIZE) == MAX_ARG_SIZE) {
+		DOCA_LOG_ERR("Load list is too long - MAX=%d", MAX_USER_ARG_SIZE);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	strcpy(conf->kinds, value);
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle cores parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+cores_callback(void *param, void *config)
+{
+	struct interference_config *conf = (struct interference_config *)config;
+	const char *value = (char *)param;
+
+	if (strnlen(value, MAX_ARG_SIZE) == MAX_ARG_SIZE) {
+		DOCA_LOG_ERR("Core list is too long - MAX=%d", MAX_USER_ARG_SIZE);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	strcpy(conf->cores, value);
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle dma-core parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+dma_core_callback(void *param, void *config)
+{
+	struct interference_config *conf = (struct interference_config *)config;
+	int value = *(int *)param;
+
+	if (value < 0) {
+		DOCA_LOG_ERR("DMA core must not be negative");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	conf->dma_core = value;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle tcp-target parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+tcp_target_callback(void *param, void *config)
+{
+	struct interference_config *conf = (struct interference_config *)config;
+	const char *value = (char *)param;
+
+	if (strnlen(value, MAX_ARG_SIZE) == MAX_ARG_SIZE) {
+		DOCA_LOG_ERR("TCP target is too long - MAX=%d", MAX_USER_ARG_SIZE);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	strcpy(conf->tcp_target, value);
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle size parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+size_callback(void *param, void *config)
+{
+	struct interference_config *conf = (struct interference_config *)config;
+	int value = *(int *)param;
+
+	if (value < 1) {
+		DOCA_LOG_ERR("Transfer size must be at least 1 byte");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	conf->size = value;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle duration parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+duration_callback(void *param, void *config)
+{
+	struct interference_config *conf = (struct interference_config *)config;
+	int value = *(int *)param;
+
+	if (value < 1) {
+		DOCA_LOG_ERR("Duration must be at least 1 s");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	conf->duration_s = value;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Register one program parameter
+ *
+ * @short_name [in]: short option
+ * @long_name [in]: long option
+ * @description [in]: help text
+ * @callback [in]: parser callback
+ * @type [in]: argument type
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+register_param(const char *short_name, const char *long_name, const char *description, doca_argp_param_cb_t callback,
+	       enum doca_argp_type type)
+{
+	struct doca_argp_param *param;
+	doca_error_t result;
+
+	result = doca_argp_param_create(&param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(param, short_name);
+	doca_argp_param_set_long_name(param, long_name);
+	doca_argp_param_set_description(param, description);
+	doca_argp_param_set_callback(param, callback);
+	doca_argp_param_set_type(param, type);
+	result = doca_argp_register_param(param);
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+	return result;
+}
+
+/*
+ * Register the generator, load, core, target, size and duration parameters
+ *
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+register_interference_params(void)
+{
+	doca_error_t result;
+
+	result = register_param("g", "generator", "interfere binary (default: ../../../interference/interfere)",
+				generator_callback, DOCA_ARGP_TYPE_STRING);
+	if (result != DOCA_SUCCESS)
+		return result;
+	result = register_param("k", "interferers", "Comma separated loads of interfere -k (default: stream,tcp,hash)",
+				interferers_callback, DOCA_ARGP_TYPE_STRING);
+	if (result != DOCA_SUCCESS)
+		return result;
+	result = register_param("c", "cores", "Cores of the loads, e.g. 1-7 (default: 1-7)", cores_callback,
+				DOCA_ARGP_TYPE_STRING);
+	if (result != DOCA_SUCCESS)
+		return result;
+	result = register_param("a", "dma-core", "Core of the DMA workload (default: 0)", dma_core_callback,
+				DOCA_ARGP_TYPE_INT);
+	if (result != DOCA_SUCCESS)
+		return result;
+	result = register_param("r", "tcp-target", "host:port of an interfere tcp_sink (default: loopback)",
+				tcp_target_callback, DOCA_ARGP_TYPE_STRING);
+	if (result != DOCA_SUCCESS)
+		return result;
+	result = register_param("z", "size", "Transfer size of the throughput phase in bytes (default: 65536)",
+				size_callback, DOCA_ARGP_TYPE_INT);
+	if (result != DOCA_SUCCESS)
+		return result;
+	return register_param("s", "duration", "Length of the throughput and the latency phase in s (default: 2)",
+			      duration_callback, DOCA_ARGP_TYPE_INT);
+}
+
+/*
+ * Sample main function
+ *
+ * @argc [in]: command line arguments size
+ * @argv [in]: array of command line arguments
+ * @return: EXIT_SUCCESS on success and EXIT_FAILURE otherwise
+ */
+int
+main(int argc, char **argv)
+{
+	struct interference_config conf = {0};
+	doca_error_t result;
+	struct doca_log_backend *sdk_log;
+	int exit_status = EXIT_FAILURE;
+
+	/* Set the default configuration values (Example values) */
+	strcpy(conf.dma_conf.pci_address, "03:00.0");
+	strcpy(conf.dma_conf.export_desc_path, "/tmp/export_desc.txt");
+	strcpy(conf.dma_conf.buf_info_path, "/tmp/buffer_info.txt");
+	strcpy(conf.generator, "../../../interference/interfere");
+	strcpy(conf.kinds, "stream,tcp,hash");
+	strcpy(conf.cores, "1-7");
+	conf.size = 65536;
+	conf.duration_s = 2;
+
+	/* Register a logger backend */
+	result = doca_log_backend_create_standard();
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+
+	/* Register a logger backend for internal SDK errors and warnings */
+	result = doca_log_backend_create_with_file_sdk(stderr, &sdk_log);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+	result = doca_log_backend_set_sdk_level(sdk_log, DOCA_LOG_LEVEL_WARNING);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+
+	result = doca_argp_init("doca_dma_interference", &conf);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to init ARGP resources: %s", doca_error_get_descr(result));
+		goto sample_exit;
+	}
+	result = register_dma_params(true);
+	if (result == DOCA_SUCCESS)
+		result = register_interference_params();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register DMA sample parameters: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+	result = doca_argp_start(argc, argv);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to parse sample input: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	result = dma_interference_dpu(conf.generator, conf.kinds, conf.cores, conf.dma_core, conf.tcp_target, conf.size,
+				      conf.duration_s, conf.dma_conf.export_desc_path, conf.dma_conf.buf_info_path,
+				      conf.dma_conf.pci_address);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("dma_interference_dpu() encountered an error: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	exit_status = EXIT_SUCCESS;
+
+argp_cleanup:
+	doca_argp_destroy();
+sample_exit:
+	if (exit_status == EXIT_SUCCESS)
+		DOCA_LOG_INFO("Sample finished successfully");
+	else
+		DOCA_LOG_INFO("Sample finished with errors");
+	return exit_status;
+}
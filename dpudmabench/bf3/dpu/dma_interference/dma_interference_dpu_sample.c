@@ -0,0 +1,680 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <doca_buf.h>
+#include <doca_buf_inventory.h>
+#include <doca_ctx.h>
+#include <doca_dev.h>
+#include <doca_dma.h>
+#include <doca_error.h>
+#include <doca_log.h>
+#include <doca_mmap.h>
+#include <doca_pe.h>
+
+#include "dma_common.h"
+
+DOCA_LOG_REGISTER(DMA_INTERFERENCE_DPU);
+
+#define RECV_BUF_SIZE 256		/* Buffer which contains config information */
+#define MAX_DESC_SIZE 1024		/* Maximum size of the export descriptor */
+#define QUEUE_DEPTH 32			/* Outstanding DMAs of the throughput phase */
+#define LAT_SIZE 64			/* Transfer size of the latency phase */
+#define LAT_TASK QUEUE_DEPTH		/* Index of the latency task */
+#define MAX_LAT_SAMPLES (1 << 20)	/* Latency samples kept per phase */
+#define LINE_SIZE 256			/* Maximum size of a generator output line */
+#define KIND_SEP ","			/* Separator of the interferer list */
+
+/* DMA workload, one context progressed on the DMA core */
+struct dma_run {
+	struct doca_dev *dev;				/* DOCA device */
+	struct doca_mmap *local_mmap;			/* DPU buffer mmap */
+	struct doca_mmap *remote_mmap;			/* Host buffer mmap */
+	struct doca_buf_inventory *buf_inv;		/* Inventory */
+	struct doca_pe *pe;				/* Progress engine */
+	struct doca_dma *dma;				/* DMA context */
+	struct doca_ctx *ctx;				/* DMA context as a generic context, NULL until started */
+	char *local;					/* DPU buffer */
+	char export_desc[MAX_DESC_SIZE];		/* Host export descriptor */
+	size_t export_desc_len;				/* Host export descriptor length */
+	char *remote_addr;				/* Host buffer address */
+	size_t remote_len;				/* Host buffer length */
+	struct doca_dma_task_memcpy *tasks[QUEUE_DEPTH + 1];	/* Throughput tasks, then the latency task */
+	struct doca_buf *src[QUEUE_DEPTH + 1];		/* Sources of the tasks */
+	struct doca_buf *dst[QUEUE_DEPTH + 1];		/* Destinations of the tasks */
+	uint64_t end_ns;				/* End of the throughput window, 0 in the latency phase */
+	uint64_t completed;				/* Completions inside the throughput window */
+	uint64_t lat_done_ns;				/* Completion time of the latency task, 0 while in flight */
+	uint32_t inflight;				/* Tasks submitted and not completed */
+	doca_error_t task_result;			/* First task error */
+};
+
+/* DMA results of one phase pair */
+struct dma_result {
+	double gbps;		/* Throughput at QUEUE_DEPTH outstanding */
+	double p50_us;		/* Median LAT_SIZE latency at one outstanding */
+	double p99_us;		/* 99th percentile LAT_SIZE latency */
+};
+
+/* A running generator process */
+struct interferer {
+	pid_t pid;		/* Generator process */
+	FILE *out;		/* Its standard output */
+};
+
+/*
+ * Saves export descriptor and buffer information content into memory buffers
+ *
+ * @export_desc_file_path [in]: Export descriptor file path
+ * @buffer_info_file_path [in]: Buffer information file path
+ * @export_desc [in]: Export descriptor buffer
+ * @export_desc_len [in]: Export descriptor buffer length
+ * @remote_addr [in]: Remote buffer address
+ * @remote_addr_len [in]: Remote buffer total length
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+save_config_info_to_buffers(const char *export_desc_file_path, const char *buffer_info_file_path, char *export_desc,
+			    size_t *export_desc_len, char **remote_addr, size_t *remote_addr_len)
+{
+	FILE *fp;
+	long file_size;
+	char buffer[RECV_BUF_SIZE];
+
+	fp = fopen(export_desc_file_path, "r");
+	if (fp == NULL) {
+		DOCA_LOG_ERR("Failed to open %s", export_desc_file_path);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	if (fseek(fp, 0, SEEK_END) != 0) {
+		DOCA_LOG_ERR("Failed to calculate file size");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	file_size = ftell(fp);
+	if (file_size == -1) {
+		DOCA_LOG_ERR("Failed to calculate file size");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	if (file_size > MAX_DESC_SIZE)
+		file_size = MAX_DESC_SIZE;
+
+	*export_desc_len = file_size;
+
+	if (fseek(fp, 0L, SEEK_SET) != 0) {
+		DOCA_LOG_ERR("Failed to calculate file size");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	if (fread(export_desc, 1, file_size, fp) != (size_t)file_size) {
+		DOCA_LOG_ERR("Failed to read the export descriptor");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	fclose(fp);
+
+	/* Read source buffer information from file */
+	fp = fopen(buffer_info_file_path, "r");
+	if (fp == NULL) {
+		DOCA_LOG_ERR("Failed to open %s", buffer_info_file_path);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	/* Get source buffer address */
+	if (fgets(buffer, RECV_BUF_SIZE, fp) == NULL) {
+		DOCA_LOG_ERR("Failed to read the source (host) buffer address");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+	*remote_addr = (char *)strtoull(buffer, NULL, 0);
+
+	memset(buffer, 0, RECV_BUF_SIZE);
+
+	/* Get source buffer length */
+	if (fgets(buffer, RECV_BUF_SIZE, fp) == NULL) {
+		DOCA_LOG_ERR("Failed to read the source (host) buffer length");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+	*remote_addr_len = strtoull(buffer, NULL, 0);
+
+	fclose(fp);
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Current CLOCK_MONOTONIC time
+ *
+ * @return: time in nanoseconds
+ */
+static uint64_t
+now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/*
+ * Sleep for a number of nanoseconds
+ *
+ * @ns [in]: sleep length
+ */
+static void
+sleep_ns(uint64_t ns)
+{
+	struct timespec ts = {ns / 1000000000ULL, ns % 1000000000ULL};
+
+	while (nanosleep(&ts, &ts) != 0 && errno == EINTR)
+		;
+}
+
+/*
+ * DMA completed callback, resubmits throughput tasks until the window closes and timestamps the latency task
+ *
+ * @dma_task [in]: Completed task
+ * @task_user_data [in]: doca_data from the task, index of the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void
+dma_completed_callback(struct doca_dma_task_memcpy *dma_task, union doca_data task_user_data,
+		       union doca_data ctx_user_data)
+{
+	struct dma_run *r = (struct dma_run *)ctx_user_data.ptr;
+	uint64_t now = now_ns();
+	doca_error_t result;
+
+	r->inflight--;
+	if (task_user_data.u64 == LAT_TASK) {
+		r->lat_done_ns = now;
+		return;
+	}
+	if (now >= r->end_ns || r->task_result != DOCA_SUCCESS)
+		return;
+	r->completed++;
+
+	result = doca_buf_reset_data_len(doca_dma_task_memcpy_get_dst(dma_task));
+	if (result == DOCA_SUCCESS)
+		result = doca_task_submit(doca_dma_task_memcpy_as_task(dma_task));
+	if (result != DOCA_SUCCESS) {
+		r->task_result = result;
+		return;
+	}
+	r->inflight++;
+}
+
+/*
+ * DMA error callback
+ *
+ * @dma_task [in]: failed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void
+dma_error_callback(struct doca_dma_task_memcpy *dma_task, union doca_data task_user_data,
+		   union doca_data ctx_user_data)
+{
+	struct dma_run *r = (struct dma_run *)ctx_user_data.ptr;
+
+	r->inflight--;
+	if (task_user_data.u64 == LAT_TASK)
+		r->lat_done_ns = now_ns();
+	if (r->task_result == DOCA_SUCCESS)
+		r->task_result = doca_task_get_status(doca_dma_task_memcpy_as_task(dma_task));
+}
+
+/*
+ * Open the device, import the host buffer, start the DMA context and allocate the read tasks
+ *
+ * @r [in]: DMA workload, memory configuration set
+ * @pcie_addr [in]: Device PCI address
+ * @size [in]: transfer size of the throughput phase
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+dma_setup(struct dma_run *r, const char *pcie_addr, size_t size)
+{
+	size_t local_len = QUEUE_DEPTH * size + LAT_SIZE;
+	union doca_data data = {0};
+	doca_error_t result;
+	size_t len;
+	uint32_t i;
+
+	result = open_doca_device_with_pci(pcie_addr, &dma_task_is_supported, &r->dev);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to open DOCA device: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	if (posix_memalign((void **)&r->local, 4096, local_len) != 0) {
+		DOCA_LOG_ERR("Failed to allocate the DPU buffer");
+		r->local = NULL;
+		return DOCA_ERROR_NO_MEMORY;
+	}
+	memset(r->local, 0, local_len);
+
+	result = doca_mmap_create(&r->local_mmap);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_add_dev(r->local_mmap, r->dev);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_set_memrange(r->local_mmap, r->local, local_len);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_start(r->local_mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start local mmap: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_buf_inventory_create(2 * (QUEUE_DEPTH + 1), &r->buf_inv);
+	if (result == DOCA_SUCCESS)
+		result = doca_buf_inventory_start(r->buf_inv);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start buffer inventory: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_pe_create(&r->pe);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create progress engine: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_dma_create(r->dev, &r->dma);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create DMA context: %s", doca_error_get_descr(result));
+		return result;
+	}
+	result = doca_dma_task_memcpy_set_conf(r->dma, dma_completed_callback, dma_error_callback, QUEUE_DEPTH + 1);
+	if (result == DOCA_SUCCESS) {
+		data.ptr = r;
+		result = doca_ctx_set_user_data(doca_dma_as_ctx(r->dma), data);
+	}
+	if (result == DOCA_SUCCESS)
+		result = doca_pe_connect_ctx(r->pe, doca_dma_as_ctx(r->dma));
+	if (result == DOCA_SUCCESS)
+		result = doca_ctx_start(doca_dma_as_ctx(r->dma));
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start DMA context: %s", doca_error_get_descr(result));
+		return result;
+	}
+	r->ctx = doca_dma_as_ctx(r->dma);
+
+	result = doca_mmap_create_from_export(NULL, r->export_desc, r->export_desc_len, r->dev, &r->remote_mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to import the host buffer: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	/* Host-to-DPU reads, every task owns its slot on both sides, the latency task comes last */
+	for (i = 0; i <= QUEUE_DEPTH && result == DOCA_SUCCESS; i++) {
+		len = i == LAT_TASK ? LAT_SIZE : size;
+		result = doca_buf_inventory_buf_get_by_addr(r->buf_inv, r->remote_mmap, r->remote_addr + i * size, len,
+							    &r->src[i]);
+		if (result == DOCA_SUCCESS)
+			result = doca_buf_set_data(r->src[i], r->remote_addr + i * size, len);
+		if (result == DOCA_SUCCESS)
+			result = doca_buf_inventory_buf_get_by_addr(r->buf_inv, r->local_mmap, r->local + i * size, len,
+								    &r->dst[i]);
+		if (result == DOCA_SUCCESS) {
+			data.u64 = i;
+			result = doca_dma_task_memcpy_alloc_init(r->dma, r->src[i], r->dst[i], data, &r->tasks[i]);
+		}
+	}
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Failed to allocate the tasks: %s", doca_error_get_descr(result));
+	return result;
+}
+
+/*
+ * Free the tasks, stop the context and destroy all DMA objects
+ *
+ * @r [in]: DMA workload
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+dma_destroy(struct dma_run *r)
+{
+	doca_error_t result = DOCA_SUCCESS;
+	uint32_t i;
+
+	for (i = 0; i <= QUEUE_DEPTH; i++) {
+		if (r->tasks[i] != NULL)
+			doca_task_free(doca_dma_task_memcpy_as_task(r->tasks[i]));
+		if (r->src[i] != NULL)
+			doca_buf_dec_refcount(r->src[i], NULL);
+		if (r->dst[i] != NULL)
+			doca_buf_dec_refcount(r->dst[i], NULL);
+	}
+	if (r->ctx != NULL)
+		DOCA_ERROR_PROPAGATE(result, request_stop_ctx(r->pe, r->ctx));
+	if (r->remote_mmap != NULL)
+		DOCA_ERROR_PROPAGATE(result, doca_mmap_destroy(r->remote_mmap));
+	if (r->dma != NULL)
+		DOCA_ERROR_PROPAGATE(result, doca_dma_destroy(r->dma));
+	if (r->pe != NULL)
+		DOCA_ERROR_PROPAGATE(result, doca_pe_destroy(r->pe));
+	if (r->buf_inv != NULL) {
+		DOCA_ERROR_PROPAGATE(result, doca_buf_inventory_stop(r->buf_inv));
+		DOCA_ERROR_PROPAGATE(result, doca_buf_inventory_destroy(r->buf_inv));
+	}
+	if (r->local_mmap != NULL)
+		DOCA_ERROR_PROPAGATE(result, doca_mmap_destroy(r->local_mmap));
+	free(r->local);
+	if (r->dev != NULL)
+		DOCA_ERROR_PROPAGATE(result, doca_dev_close(r->dev));
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Failed to destroy DMA objects: %s", doca_error_get_descr(result));
+	return result;
+}
+
+/*
+ * qsort comparator of latency samples
+ *
+ * @a [in]: first sample
+ * @b [in]: second sample
+ * @return: <0, 0 or >0
+ */
+static int
+cmp_u64(const void *a, const void *b)
+{
+	uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+/*
+ * Run the throughput phase and then the latency phase, duration_s each
+ *
+ * @r [in]: DMA workload
+ * @size [in]: transfer size of the throughput phase
+ * @duration_s [in]: length of each phase
+ * @samples [in]: room for MAX_LAT_SAMPLES latency samples
+ * @res [out]: results
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+measure_dma(struct dma_run *r, size_t size, uint32_t duration_s, uint64_t *samples, struct dma_result *res)
+{
+	uint64_t start, end, submit_ns;
+	doca_error_t result = DOCA_SUCCESS;
+	uint32_t i;
+	size_t n = 0;
+
+	r->completed = 0;
+	r->task_result = DOCA_SUCCESS;
+	start = now_ns();
+	r->end_ns = start + (uint64_t)duration_s * 1000000000ULL;
+	/* The last completion of each task in the previous phase left its dst full */
+	for (i = 0; i < QUEUE_DEPTH && result == DOCA_SUCCESS; i++) {
+		result = doca_buf_reset_data_len(r->dst[i]);
+		if (result == DOCA_SUCCESS)
+			result = doca_task_submit(doca_dma_task_memcpy_as_task(r->tasks[i]));
+		if (result == DOCA_SUCCESS)
+			r->inflight++;
+	}
+	if (result != DOCA_SUCCESS)
+		r->task_result = result;
+	while (r->inflight > 0)
+		(void)doca_pe_progress(r->pe);
+	if (r->task_result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Throughput phase failed: %s", doca_error_get_descr(r->task_result));
+		return r->task_result;
+	}
+	res->gbps = r->completed * size / (duration_s * 1e9);
+
+	/* One LAT_SIZE read at a time, submission to completion callback */
+	end = now_ns() + (uint64_t)duration_s * 1000000000ULL;
+	while (n < MAX_LAT_SAMPLES && now_ns() < end) {
+		result = doca_buf_reset_data_len(r->dst[LAT_TASK]);
+		if (result != DOCA_SUCCESS)
+			return result;
+		r->lat_done_ns = 0;
+		submit_ns = now_ns();
+		result = doca_task_submit(doca_dma_task_memcpy_as_task(r->tasks[LAT_TASK]));
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to submit latency task: %s", doca_error_get_descr(result));
+			return result;
+		}
+		r->inflight++;
+		while (r->lat_done_ns == 0)
+			(void)doca_pe_progress(r->pe);
+		if (r->task_result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Latency phase failed: %s", doca_error_get_descr(r->task_result));
+			return r->task_result;
+		}
+		samples[n++] = r->lat_done_ns - submit_ns;
+	}
+	qsort(samples, n, sizeof(*samples), cmp_u64);
+	res->p50_us = samples[n / 2] / 1e3;
+	res->p99_us = samples[n * 99 / 100] / 1e3;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Start a generator on the interference cores and wait until it is ready
+ *
+ * @generator [in]: path of the interfere binary
+ * @kind [in]: load name
+ * @cores [in]: core list of the load
+ * @tcp_target [in]: remote tcp_sink, empty for loopback
+ * @ifr [out]: running generator
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+start_interferer(const char *generator, const char *kind, const char *cores, const char *tcp_target,
+		 struct interferer *ifr)
+{
+	char *argv[] = {(char *)generator, "-k", (char *)kind, "-c", (char *)cores, NULL, NULL, NULL};
+	char line[LINE_SIZE];
+	int fds[2];
+
+	if (tcp_target[0] != '\0' && strcmp(kind, "tcp") == 0) {
+		argv[5] = "-a";
+		argv[6] = (char *)tcp_target;
+	}
+	if (pipe(fds) != 0) {
+		DOCA_LOG_ERR("Failed to create the generator pipe");
+		return DOCA_ERROR_OPERATING_SYSTEM;
+	}
+
+	fflush(NULL);
+	ifr->pid = fork();
+	if (ifr->pid == 0) {
+		dup2(fds[1], STDOUT_FILENO);
+		close(fds[0]);
+		close(fds[1]);
+		execv(generator, argv);
+		perror(generator);
+		_exit(EXIT_FAILURE);
+	}
+	close(fds[1]);
+	if (ifr->pid < 0) {
+		close(fds[0]);
+		DOCA_LOG_ERR("Failed to fork the generator");
+		return DOCA_ERROR_OPERATING_SYSTEM;
+	}
+	ifr->out = fdopen(fds[0], "r");
+	if (ifr->out == NULL) {
+		close(fds[0]);
+		kill(ifr->pid, SIGKILL);
+		waitpid(ifr->pid, NULL, 0);
+		return DOCA_ERROR_OPERATING_SYSTEM;
+	}
+
+	/* The generator pins and sets up all its threads before it prints READY */
+	while (fgets(line, sizeof(line), ifr->out) != NULL) {
+		if (strncmp(line, "READY", 5) == 0)
+			return DOCA_SUCCESS;
+	}
+	DOCA_LOG_ERR("Generator %s %s exited before it was ready", generator, kind);
+	fclose(ifr->out);
+	waitpid(ifr->pid, NULL, 0);
+	return DOCA_ERROR_OPERATING_SYSTEM;
+}
+
+/*
+ * Stop a generator and read its rate
+ *
+ * @ifr [in]: running generator
+ * @gbps [out]: generator throughput over its whole run
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+stop_interferer(struct interferer *ifr, double *gbps)
+{
+	char line[LINE_SIZE], name[LINE_SIZE];
+	double secs, mops;
+	int threads, status, found = 0;
+
+	kill(ifr->pid, SIGTERM);
+	while (fgets(line, sizeof(line), ifr->out) != NULL) {
+		if (sscanf(line, "INTERFERER %255s %d %lf %lf %lf", name, &threads, &secs, gbps, &mops) == 5)
+			found = 1;
+	}
+	fclose(ifr->out);
+	waitpid(ifr->pid, &status, 0);
+	if (!found || !WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS) {
+		DOCA_LOG_ERR("Generator failed");
+		return DOCA_ERROR_OPERATING_SYSTEM;
+	}
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Run DOCA DMA interference sample on the DPU
+ *
+ * @generator [in]: path of the interfere binary
+ * @kinds [in]: comma separated loads, modified in place
+ * @cores [in]: core list of the loads
+ * @dma_core [in]: core that submits and progresses the DMAs
+ * @tcp_target [in]: remote tcp_sink of the tcp load, empty for loopback
+ * @size [in]: transfer size of the throughput phase
+ * @duration_s [in]: length of every phase
+ * @export_desc_file_path [in]: Export descriptor file path
+ * @buffer_info_file_path [in]: Buffer info file path
+ * @pcie_addr [in]: Device PCI address
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t
+dma_interference_dpu(const char *generator, char *kinds, const char *cores, int dma_core, const char *tcp_target,
+		     size_t size, uint32_t duration_s, const char *export_desc_file_path,
+		     const char *buffer_info_file_path, const char *pcie_addr)
+{
+	struct dma_result base, loaded;
+	struct interferer ifr;
+	struct dma_run *r;
+	uint64_t *samples;
+	double alone_gbps, with_dma_gbps;
+	doca_error_t result, tmp_result;
+	char *kind, *saveptr;
+	cpu_set_t set;
+
+	r = calloc(1, sizeof(*r));
+	samples = malloc(MAX_LAT_SAMPLES * sizeof(*samples));
+	if (r == NULL || samples == NULL) {
+		free(r);
+		free(samples);
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	result = save_config_info_to_buffers(export_desc_file_path, buffer_info_file_path, r->export_desc,
+					     &r->export_desc_len, &r->remote_addr, &r->remote_len);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to read memory configuration from file: %s", doca_error_get_descr(result));
+		goto free_run;
+	}
+	if (r->remote_len < QUEUE_DEPTH * size + LAT_SIZE) {
+		DOCA_LOG_ERR("Host buffer must hold at least %zu bytes", QUEUE_DEPTH * size + LAT_SIZE);
+		result = DOCA_ERROR_INVALID_VALUE;
+		goto free_run;
+	}
+
+	CPU_ZERO(&set);
+	CPU_SET(dma_core, &set);
+	if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+		DOCA_LOG_ERR("Failed to pin the DMA workload to core %d", dma_core);
+		result = DOCA_ERROR_OPERATING_SYSTEM;
+		goto free_run;
+	}
+
+	result = dma_setup(r, pcie_addr, size);
+	if (result != DOCA_SUCCESS)
+		goto destroy_run;
+
+	printf("DMA read (host to DPU) on core %d: %zu bytes x %d in flight for %u s, then %d bytes x 1 for %u s\n",
+	       dma_core, size, QUEUE_DEPTH, duration_s, LAT_SIZE, duration_s);
+	printf("Loads on cores %s, each also run alone for %u s\n", cores, 2 * duration_s);
+	result = measure_dma(r, size, duration_s, samples, &base);
+	if (result != DOCA_SUCCESS)
+		goto destroy_run;
+	printf("Load\t DMA(GB/s)\t vs alone\t p50(us)\t p99(us)\t p99 vs alone\t Load alone(GB/s)\t "
+	       "Load with DMA(GB/s)\t vs alone\n");
+	printf("none\t %9.3f\t %7.3f\t %7.2f\t %7.2f\t %12.3f\t %16s\t %19s\t %8s\n", base.gbps, 1.0, base.p50_us,
+	       base.p99_us, 1.0, "-", "-", "-");
+	printf("INTERFERENCE none %.3f 1.000 %.2f %.2f 1.000 - - -\n", base.gbps, base.p50_us, base.p99_us);
+
+	for (kind = strtok_r(kinds, KIND_SEP, &saveptr); kind != NULL; kind = strtok_r(NULL, KIND_SEP, &saveptr)) {
+		/* The load alone, as long as both DMA phases */
+		result = start_interferer(generator, kind, cores, tcp_target, &ifr);
+		if (result != DOCA_SUCCESS)
+			break;
+		sleep_ns(2ULL * duration_s * 1000000000ULL);
+		result = stop_interferer(&ifr, &alone_gbps);
+		if (result != DOCA_SUCCESS)
+			break;
+
+		/* The load again, with the DMA workload on its own core */
+		result = start_interferer(generator, kind, cores, tcp_target, &ifr);
+		if (result != DOCA_SUCCESS)
+			break;
+		result = measure_dma(r, size, duration_s, samples, &loaded);
+		tmp_result = stop_interferer(&ifr, &with_dma_gbps);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+		if (result != DOCA_SUCCESS)
+			break;
+
+		printf("%s\t %9.3f\t %7.3f\t %7.2f\t %7.2f\t %12.3f\t %16.3f\t %19.3f\t %8.3f\n", kind, loaded.gbps,
+		       loaded.gbps / base.gbps, loaded.p50_us, loaded.p99_us, loaded.p99_us / base.p99_us, alone_gbps,
+		       with_dma_gbps, with_dma_gbps / alone_gbps);
+		printf("INTERFERENCE %s %.3f %.3f %.2f %.2f %.3f %.3f %.3f %.3f\n", kind, loaded.gbps,
+		       loaded.gbps / base.gbps, loaded.p50_us, loaded.p99_us, loaded.p99_us / base.p99_us, alone_gbps,
+		       with_dma_gbps, with_dma_gbps / alone_gbps);
+		fflush(stdout);
+	}
+
+destroy_run:
+	tmp_result = dma_destroy(r);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+free_run:
+	free(samples);
+	free(r);
+	return result;
+}
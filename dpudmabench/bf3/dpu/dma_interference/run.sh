@@ -0,0 +1,29 @@
+# /*
+# * Copyright (c) 2025, University of California, Merced. All rights reserved.
+# *
+# * This file is part of the benchmarking software package developed by
+# * the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+# *
+# * For detailed copyright and licensing information, please refer to the license
+# * file LICENSE in the top level directory.
+# *
+# */
+
+
+# Usage: run.sh [loads] [load cores] [DMA core]
+# Start host/dma_write_d_to_h_lat_poll/run.sh 33554432 on the host first.
+# For a tcp load that leaves the DPU, start interfere -k tcp_sink on the peer and add -r <peer>:7007.
+loads=${1:-stream,tcp,hash}
+cores=${2:-1-7}
+dma_core=${3:-0}
+scp <user>@<host>:/tmp/buffer_info.txt .
+scp <user>@<host>:/tmp/export_desc.txt .
+echo ""
+
+make -C ../../../interference clean
+make -C ../../../interference
+make clean
+make
+echo ""
+
+./doca_dma_interference -p 03:00.0 -d export_desc.txt -b buffer_info.txt -k ${loads} -c ${cores} -a ${dma_core} | tee dma_interference.txt
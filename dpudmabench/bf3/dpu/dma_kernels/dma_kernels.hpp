@@ -0,0 +1,436 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+
+#ifndef DMA_KERNELS_HPP_
+#define DMA_KERNELS_HPP_
+
+#include <cerrno>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+
+#include <sys/epoll.h>
+
+extern "C" {
+#include <doca_buf.h>
+#include <doca_dma.h>
+#include <doca_error.h>
+#include <doca_pe.h>
+
+#include "dma_common.h"
+#include "dma_timeline.h"
+#include "dma_trace.h"
+}
+
+/*
+ * DMA measurement loops written once and specialized at compile time
+ *
+ * A kernel is run_kernel<Dir, Completion, Timing>: Dir picks which side of every task is the source, Completion how the
+ * calling thread waits for the PE and Timing what is measured. All three are template parameters, so each instantiation
+ * has a straight-line hot loop with no test of the direction or of the completion mode, which is what the small payload
+ * points are sensitive to. Completion policies take an optional hook that is called after every doca_pe_progress() that
+ * retired tasks; the default hook is empty and compiles away. Submissions, progress calls, re-arms and epoll wakeups go
+ * through the trace points of dma_trace.h, which cost one branch while tracing is off. The tasks are the NUM_DMA_TASKS
+ * tasks of struct dma_resources: src_doca_buf_array holds the local side and dst_doca_buf_array the remote side of
+ * every task.
+ */
+
+namespace dma_kernels {
+
+#define LAT_ITERATIONS 5000		/* Latency iterations (same as the latency benchmarks) */
+#define THR_BYTES (1UL << 30)		/* Bytes moved per throughput point */
+#define THR_MIN_REPS 10			/* Minimum number of batches per throughput point */
+#define THR_MAX_REPS 1000		/* Maximum number of batches per throughput point */
+
+/* Data-flow direction, seen from the initiator */
+enum class dma_dir {
+	read,	/* Remote buffer to local buffer */
+	write,	/* Local buffer to remote buffer */
+};
+
+/* Result of one kernel at one size, fields a timing policy does not measure stay negative */
+struct kernel_result {
+	double min_us = -1;	/* Fastest operation */
+	double avg_us = -1;	/* Mean operation latency */
+	double max_us = -1;	/* Slowest operation */
+	double std_us = -1;	/* Standard deviation of the latency */
+	double mops = -1;	/* Throughput */
+	struct timeline *timeline = nullptr;	/* Samples of a streaming kernel, freed with timeline_destroy() */
+};
+
+/* Parameters of the streaming kernels, set by the sample before running them */
+struct stream_params {
+	uint32_t interval_ms = 10;	/* Sampling interval of the timeline */
+	uint32_t duration_s = 2;	/* Length of one streaming run */
+};
+
+inline stream_params stream;
+
+/*
+ * Elapsed time between two timestamps
+ *
+ * @start [in]: start timestamp
+ * @end [in]: end timestamp
+ * @return: elapsed time in nanoseconds
+ */
+static inline double
+elapsed_ns(const struct timespec &start, const struct timespec &end)
+{
+	return (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+}
+
+/* Progress hook that does nothing */
+struct no_hook {
+	inline void operator()(const struct dma_resources *) const
+	{
+	}
+};
+
+/* Busy-poll the PE until every submitted task has completed */
+struct poll_completion {
+	static constexpr const char *name = "poll";
+
+	/*
+	 * Wait for the outstanding tasks
+	 *
+	 * @resources [in]: DMA resources, num_remaining_tasks is decremented by the task callbacks
+	 * @hook [in]: called after every progress call that retired tasks
+	 * @return: DOCA_SUCCESS
+	 */
+	template <class Hook = no_hook>
+	static inline doca_error_t wait(struct dma_resources *resources, Hook hook = Hook())
+	{
+		uint64_t start;
+
+		while (resources->num_remaining_tasks > 0) {
+			start = trace_now();
+			if (doca_pe_progress(resources->state.pe) > 0) {
+				trace_span(TRACE_PROGRESS, start, resources->num_remaining_tasks);
+				hook(resources);
+			} else {
+				trace_span(TRACE_PROGRESS_IDLE, start, 0);
+			}
+		}
+		return DOCA_SUCCESS;
+	}
+};
+
+/* Sleep on the PE notification handle (needs allocate_dma_resources_with_event) */
+struct event_completion {
+	static constexpr const char *name = "event";
+
+	/*
+	 * Wait for the outstanding tasks
+	 *
+	 * @resources [in]: DMA resources, num_remaining_tasks is decremented by the task callbacks
+	 * @hook [in]: called after every progress call that retired tasks
+	 * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+	 */
+	template <class Hook = no_hook>
+	static inline doca_error_t wait(struct dma_resources *resources, Hook hook = Hook())
+	{
+		struct program_core_objects *state = &resources->state;
+		struct epoll_event events[5];
+		doca_error_t result;
+		uint64_t start;
+		int nfds;
+
+		for (;;) {
+			/* Drain completions that are already there before arming the notification */
+			while (resources->num_remaining_tasks > 0) {
+				start = trace_now();
+				if (doca_pe_progress(state->pe) == 0) {
+					trace_span(TRACE_PROGRESS_IDLE, start, 0);
+					break;
+				}
+				trace_span(TRACE_PROGRESS, start, resources->num_remaining_tasks);
+				hook(resources);
+			}
+			if (resources->num_remaining_tasks == 0)
+				return DOCA_SUCCESS;
+
+			start = trace_now();
+			result = doca_pe_request_notification(state->pe);
+			if (result != DOCA_SUCCESS)
+				return result;
+			trace_span(TRACE_REARM, start, 0);
+			start = trace_now();
+			nfds = epoll_wait(state->epoll_fd, events, 5, -1);
+			if (nfds < 0 && errno != EINTR)
+				return DOCA_ERROR_IO_FAILED;
+			trace_span(TRACE_EPOLL, start, nfds < 0 ? 0 : nfds);
+			result = doca_pe_clear_notification(state->pe, 0);
+			if (result != DOCA_SUCCESS)
+				return result;
+		}
+	}
+};
+
+/*
+ * Submit the first num tasks
+ *
+ * @resources [in]: DMA resources
+ * @num [in]: number of tasks to submit
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static inline doca_error_t
+submit_tasks(struct dma_resources *resources, int num)
+{
+	doca_error_t result;
+
+	resources->num_remaining_tasks = num;
+	for (int i = 0; i < num; i++) {
+		trace_event(TRACE_SUBMIT, i);
+		result = doca_task_submit(doca_dma_task_memcpy_as_task(resources->tasks[i]));
+		if (result != DOCA_SUCCESS)
+			return result;
+	}
+	return DOCA_SUCCESS;
+}
+
+/* One task in flight, every operation timed on its own */
+struct latency_timing {
+	static constexpr const char *name = "lat";
+
+	/*
+	 * Measure per-operation latency
+	 *
+	 * @resources [in]: DMA resources with prepared tasks
+	 * @size [in]: payload size
+	 * @res [out]: min, avg, max and std of the latency
+	 * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+	 */
+	template <class Completion>
+	static doca_error_t run(struct dma_resources *resources, size_t size, kernel_result *res)
+	{
+		static double times[LAT_ITERATIONS];
+		struct timespec start, end;
+		double min_t, max_t, mean_t = 0, std_dev = 0;
+		doca_error_t result;
+
+		(void)size;
+		for (int i = 0; i < LAT_ITERATIONS; i++) {
+			clock_gettime(CLOCK_MONOTONIC, &start);
+			result = submit_tasks(resources, 1);
+			if (result != DOCA_SUCCESS)
+				return result;
+			result = Completion::wait(resources);
+			if (result != DOCA_SUCCESS)
+				return result;
+			clock_gettime(CLOCK_MONOTONIC, &end);
+			times[i] = elapsed_ns(start, end);
+		}
+
+		min_t = max_t = times[0];
+		for (int i = 0; i < LAT_ITERATIONS; i++) {
+			mean_t += times[i];
+			if (times[i] < min_t)
+				min_t = times[i];
+			if (times[i] > max_t)
+				max_t = times[i];
+		}
+		mean_t /= LAT_ITERATIONS;
+		for (int i = 0; i < LAT_ITERATIONS; i++)
+			std_dev += (times[i] - mean_t) * (times[i] - mean_t);
+
+		res->min_us = min_t / 1000;
+		res->avg_us = mean_t / 1000;
+		res->max_us = max_t / 1000;
+		res->std_us = std::sqrt(std_dev / LAT_ITERATIONS) / 1000;
+		return DOCA_SUCCESS;
+	}
+};
+
+/* Batches of NUM_DMA_TASKS tasks, the whole run timed at once */
+struct throughput_timing {
+	static constexpr const char *name = "thr";
+
+	/*
+	 * Measure throughput
+	 *
+	 * @resources [in]: DMA resources with prepared tasks
+	 * @size [in]: payload size, sets the number of batches
+	 * @res [out]: Mops
+	 * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+	 */
+	template <class Completion>
+	static doca_error_t run(struct dma_resources *resources, size_t size, kernel_result *res)
+	{
+		size_t reps = THR_BYTES / (size * NUM_DMA_TASKS);
+		struct timespec start, end;
+		doca_error_t result;
+
+		if (reps < THR_MIN_REPS)
+			reps = THR_MIN_REPS;
+		if (reps > THR_MAX_REPS)
+			reps = THR_MAX_REPS;
+
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		for (size_t i = 0; i < reps; i++) {
+			result = submit_tasks(resources, NUM_DMA_TASKS);
+			if (result != DOCA_SUCCESS)
+				return result;
+			result = Completion::wait(resources);
+			if (result != DOCA_SUCCESS)
+				return result;
+		}
+		clock_gettime(CLOCK_MONOTONIC, &end);
+
+		res->mops = (double)reps * NUM_DMA_TASKS / elapsed_ns(start, end) * 1000;
+		return DOCA_SUCCESS;
+	}
+};
+
+/* Publishes the progress of the running batch to a timeline */
+struct timeline_hook {
+	struct timeline *tl;	/* Timeline of the run */
+	uint64_t base;		/* Operations completed before the batch */
+
+	inline void operator()(const struct dma_resources *resources) const
+	{
+		timeline_update(tl, base + NUM_DMA_TASKS - resources->num_remaining_tasks,
+				resources->num_remaining_tasks);
+	}
+};
+
+/* Back-to-back batches of NUM_DMA_TASKS tasks for stream.duration_s, sampled every stream.interval_ms */
+struct stream_timing {
+	static constexpr const char *name = "stream";
+
+	/*
+	 * Measure throughput over time
+	 *
+	 * @resources [in]: DMA resources with prepared tasks
+	 * @size [in]: payload size
+	 * @res [out]: Mops over the whole run and the timeline
+	 * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+	 */
+	template <class Completion>
+	static doca_error_t run(struct dma_resources *resources, size_t size, kernel_result *res)
+	{
+		uint64_t duration_ns = (uint64_t)stream.duration_s * 1000000000UL, ops = 0;
+		struct timespec start, now;
+		struct timeline *tl;
+		doca_error_t result = DOCA_SUCCESS;
+
+		(void)size;
+		tl = timeline_create(stream.interval_ms,
+				     (uint32_t)(duration_ns / (stream.interval_ms * 1000000UL)) + 4);
+		if (tl == nullptr)
+			return DOCA_ERROR_NO_MEMORY;
+
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		do {
+			result = submit_tasks(resources, NUM_DMA_TASKS);
+			if (result != DOCA_SUCCESS)
+				break;
+			timeline_update(tl, ops, NUM_DMA_TASKS);
+			result = Completion::wait(resources, timeline_hook{tl, ops});
+			if (result != DOCA_SUCCESS)
+				break;
+			ops += NUM_DMA_TASKS;
+			clock_gettime(CLOCK_MONOTONIC, &now);
+		} while (elapsed_ns(start, now) < duration_ns);
+		timeline_stop(tl);
+
+		if (result != DOCA_SUCCESS) {
+			timeline_destroy(tl);
+			return result;
+		}
+		res->mops = (double)ops / elapsed_ns(start, now) * 1000;
+		res->timeline = tl;
+		return DOCA_SUCCESS;
+	}
+};
+
+/*
+ * Point every task at the local and remote buffers for one direction and size
+ *
+ * @resources [in]: DMA resources
+ * @size [in]: payload size
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+template <dma_dir Dir>
+doca_error_t
+prepare_tasks(struct dma_resources *resources, size_t size)
+{
+	struct doca_buf *src, *dst;
+	doca_error_t result;
+
+	for (int i = 0; i < NUM_DMA_TASKS; i++) {
+		if constexpr (Dir == dma_dir::read) {
+			src = resources->dst_doca_buf_array[i];
+			dst = resources->src_doca_buf_array[i];
+			result = doca_buf_set_data(src, resources->remote_addr, size);
+		} else {
+			src = resources->src_doca_buf_array[i];
+			dst = resources->dst_doca_buf_array[i];
+			result = doca_buf_set_data(src, resources->dpu_buffer, size);
+		}
+		if (result != DOCA_SUCCESS)
+			return result;
+		result = doca_buf_reset_data_len(dst);
+		if (result != DOCA_SUCCESS)
+			return result;
+
+		doca_dma_task_memcpy_set_src(resources->tasks[i], src);
+		doca_dma_task_memcpy_set_dst(resources->tasks[i], dst);
+	}
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Run one kernel at one size
+ *
+ * @resources [in]: DMA resources with allocated tasks
+ * @size [in]: payload size
+ * @res [out]: measured values
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+template <dma_dir Dir, class Completion, class Timing>
+doca_error_t
+run_kernel(struct dma_resources *resources, size_t size, kernel_result *res)
+{
+	doca_error_t result = prepare_tasks<Dir>(resources, size);
+
+	if (result != DOCA_SUCCESS)
+		return result;
+	return Timing::template run<Completion>(resources, size, res);
+}
+
+/* Entry of the kernel table */
+struct kernel_desc {
+	const char *name;								/* dir_timing_completion */
+	doca_error_t (*run)(struct dma_resources *, size_t, kernel_result *);	/* Instantiation */
+};
+
+/* Every combination, one instantiation each */
+static const kernel_desc kernels[] = {
+	{"read_lat_poll", run_kernel<dma_dir::read, poll_completion, latency_timing>},
+	{"read_lat_event", run_kernel<dma_dir::read, event_completion, latency_timing>},
+	{"read_thr_poll", run_kernel<dma_dir::read, poll_completion, throughput_timing>},
+	{"read_thr_event", run_kernel<dma_dir::read, event_completion, throughput_timing>},
+	{"write_lat_poll", run_kernel<dma_dir::write, poll_completion, latency_timing>},
+	{"write_lat_event", run_kernel<dma_dir::write, event_completion, latency_timing>},
+	{"write_thr_poll", run_kernel<dma_dir::write, poll_completion, throughput_timing>},
+	{"write_thr_event", run_kernel<dma_dir::write, event_completion, throughput_timing>},
+	{"read_stream_poll", run_kernel<dma_dir::read, poll_completion, stream_timing>},
+	{"read_stream_event", run_kernel<dma_dir::read, event_completion, stream_timing>},
+	{"write_stream_poll", run_kernel<dma_dir::write, poll_completion, stream_timing>},
+	{"write_stream_event", run_kernel<dma_dir::write, event_completion, stream_timing>},
+};
+
+} /* namespace dma_kernels */
+
+#endif
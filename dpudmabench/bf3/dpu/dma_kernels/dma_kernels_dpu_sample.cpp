@@ -0,0 +1,367 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+extern "C" {
+#include <doca_buf.h>
+#include <doca_buf_inventory.h>
+#include <doca_dma.h>
+#include <doca_error.h>
+#include <doca_log.h>
+#include <doca_mmap.h>
+#include <doca_pe.h>
+
+#include "dma_common.h"
+#include "utils.h"
+}
+
+#include "dma_kernels.hpp"
+
+DOCA_LOG_REGISTER(DMA_KERNELS_DPU);
+
+#define RECV_BUF_SIZE 256		/* Buffer which contains config information */
+#define MAX_DESC_SIZE 1024		/* Maximum size of the export descriptor */
+#define MIN_KERNEL_SIZE 64		/* First payload size, the sweep goes up in powers of four */
+
+/*
+ * Saves export descriptor and buffer information content into memory buffers
+ *
+ * @export_desc_file_path [in]: Export descriptor file path
+ * @buffer_info_file_path [in]: Buffer information file path
+ * @export_desc [in]: Export descriptor buffer
+ * @export_desc_len [in]: Export descriptor buffer length
+ * @remote_addr [in]: Remote buffer address
+ * @remote_addr_len [in]: Remote buffer total length
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+save_config_info_to_buffers(const char *export_desc_file_path, const char *buffer_info_file_path, char *export_desc,
+			    size_t *export_desc_len, char **remote_addr, size_t *remote_addr_len)
+{
+	FILE *fp;
+	long file_size;
+	char buffer[RECV_BUF_SIZE];
+
+	fp = fopen(export_desc_file_path, "r");
+	if (fp == NULL) {
+		DOCA_LOG_ERR("Failed to open %s", export_desc_file_path);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	if (fseek(fp, 0, SEEK_END) != 0) {
+		DOCA_LOG_ERR("Failed to calculate file size");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	file_size = ftell(fp);
+	if (file_size == -1) {
+		DOCA_LOG_ERR("Failed to calculate file size");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	if (file_size > MAX_DESC_SIZE)
+		file_size = MAX_DESC_SIZE;
+
+	*export_desc_len = file_size;
+
+	if (fseek(fp, 0L, SEEK_SET) != 0) {
+		DOCA_LOG_ERR("Failed to calculate file size");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	if (fread(export_desc, 1, file_size, fp) != (size_t)file_size) {
+		DOCA_LOG_ERR("Failed to read the export descriptor");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	fclose(fp);
+
+	/* Read source buffer information from file */
+	fp = fopen(buffer_info_file_path, "r");
+	if (fp == NULL) {
+		DOCA_LOG_ERR("Failed to open %s", buffer_info_file_path);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	/* Get source buffer address */
+	if (fgets(buffer, RECV_BUF_SIZE, fp) == NULL) {
+		DOCA_LOG_ERR("Failed to read the source (host) buffer address");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+	*remote_addr = (char *)strtoull(buffer, NULL, 0);
+
+	memset(buffer, 0, RECV_BUF_SIZE);
+
+	/* Get source buffer length */
+	if (fgets(buffer, RECV_BUF_SIZE, fp) == NULL) {
+		DOCA_LOG_ERR("Failed to read the source (host) buffer length");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+	*remote_addr_len = strtoull(buffer, NULL, 0);
+
+	fclose(fp);
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Run a kernel point again with tracing on and print the cost of the trace points per operation
+ *
+ * @k [in]: kernel
+ * @resources [in]: DMA resources
+ * @size [in]: payload size
+ * @plain [in]: result of the untraced run
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+trace_kernel(const dma_kernels::kernel_desc &k, struct dma_resources *resources, size_t size,
+	     const dma_kernels::kernel_result &plain)
+{
+	dma_kernels::kernel_result res;
+	doca_error_t result;
+	double off_us, on_us;
+	uint64_t start;
+
+	trace_enable(1);
+	start = trace_now();
+	result = k.run(resources, size, &res);
+	trace_span(TRACE_SPAN, start, (uintptr_t)k.name);
+	trace_enable(0);
+	timeline_destroy(res.timeline);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	/* Latency kernels compare the mean latency, the others the time per operation at full throughput */
+	off_us = plain.mops < 0 ? plain.avg_us : 1 / plain.mops;
+	on_us = res.mops < 0 ? res.avg_us : 1 / res.mops;
+	printf("TRACE_OVERHEAD %s %zu %.4f %.4f %+.2f%%\n", k.name, size, off_us, on_us, (on_us / off_us - 1) * 100);
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Run the selected template kernels over the size sweep, the DPU initiates and the host exports (d_to_h)
+ *
+ * @kernel [in]: kernel name, or "all"
+ * @interval_ms [in]: timeline sampling interval of the streaming kernels
+ * @duration_s [in]: length of every streaming run
+ * @trace_path [in]: Chrome trace output, empty to run without tracing
+ * @export_desc_file_path [in]: Export descriptor file path
+ * @buffer_info_file_path [in]: Buffer info file path
+ * @pcie_addr [in]: Device PCI address
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+extern "C" doca_error_t
+dma_kernels_dpu(const char *kernel, uint32_t interval_ms, uint32_t duration_s, const char *trace_path,
+		const char *export_desc_file_path, const char *buffer_info_file_path, const char *pcie_addr)
+{
+	struct dma_resources resources;
+	struct program_core_objects *state = &resources.state;
+	union doca_data task_user_data = {0};
+	char export_desc[MAX_DESC_SIZE] = {0};
+	size_t export_desc_len = 0;
+	uint64_t max_buffer_size;
+	doca_error_t result, tmp_result, task_result = DOCA_SUCCESS;
+	dma_kernels::kernel_result res;
+	size_t size, max_size;
+	bool selected = false, tracing = trace_path[0] != '\0';
+	long nb_events;
+	int i, nb_bufs = 0, nb_tasks = 0;
+
+	for (const auto &k : dma_kernels::kernels)
+		selected |= strcmp(kernel, "all") == 0 || strcmp(kernel, k.name) == 0;
+	if (!selected) {
+		DOCA_LOG_ERR("Unknown kernel %s", kernel);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	dma_kernels::stream.interval_ms = interval_ms;
+	dma_kernels::stream.duration_s = duration_s;
+
+	/* Allocate resources, the event handle is only used by the *_event kernels */
+	result = allocate_dma_resources_with_event(pcie_addr, &resources);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to allocate DMA resources: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	/* Connect context to progress engine */
+	result = doca_pe_connect_ctx(state->pe, state->ctx);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to connect progress engine to context: %s", doca_error_get_descr(result));
+		goto destroy_resources;
+	}
+
+	result = doca_ctx_start(state->ctx);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start context: %s", doca_error_get_descr(result));
+		goto destroy_resources;
+	}
+
+	/* Get maximum buffer size allowed */
+	result = doca_dma_cap_task_memcpy_get_max_buf_size(doca_dev_as_devinfo(state->dev), &max_buffer_size);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to get max buffer size: %s", doca_error_get_descr(result));
+		goto stop_dma;
+	}
+
+	/* Copy all relevant information into local buffers */
+	result = save_config_info_to_buffers(export_desc_file_path, buffer_info_file_path, export_desc,
+					     &export_desc_len, &resources.remote_addr, &resources.remote_addr_len);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to read memory configuration from file: %s", doca_error_get_descr(result));
+		goto stop_dma;
+	}
+
+	/* The sweep goes up to the exported host buffer, capped by the engine limit */
+	max_size = MIN(resources.remote_addr_len, max_buffer_size);
+	resources.dst_buffer_size = max_size;
+	resources.dpu_buffer = (char *)malloc(max_size);
+	if (resources.dpu_buffer == NULL) {
+		DOCA_LOG_ERR("Failed to allocate memory for DPU buffer");
+		result = DOCA_ERROR_NO_MEMORY;
+		goto stop_dma;
+	}
+	memset(resources.dpu_buffer, '0', max_size);
+
+	result = doca_mmap_set_memrange(state->dst_mmap, resources.dpu_buffer, max_size);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set memory range for destination mmap: %s", doca_error_get_descr(result));
+		goto free_dpu_buffer;
+	}
+
+	result = doca_mmap_start(state->dst_mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start destination mmap: %s", doca_error_get_descr(result));
+		goto free_dpu_buffer;
+	}
+
+	/* Create a local DOCA mmap from exported data */
+	result = doca_mmap_create_from_export(NULL, (const void *)export_desc, export_desc_len, state->dev,
+					      &resources.remote_mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create mmap from export: %s", doca_error_get_descr(result));
+		goto free_dpu_buffer;
+	}
+
+	/* src_doca_buf_array holds the DPU side and dst_doca_buf_array the host side of every task */
+	for (nb_bufs = 0; nb_bufs < NUM_DMA_TASKS; nb_bufs++) {
+		result = doca_buf_inventory_buf_get_by_addr(state->buf_inv, state->dst_mmap, resources.dpu_buffer,
+							    max_size, &resources.src_doca_buf_array[nb_bufs]);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Unable to acquire DOCA buffer representing local buffer: %s",
+				     doca_error_get_descr(result));
+			goto destroy_bufs;
+		}
+		result = doca_buf_inventory_buf_get_by_addr(state->buf_inv, resources.remote_mmap, resources.remote_addr,
+							    max_size, &resources.dst_doca_buf_array[nb_bufs]);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Unable to acquire DOCA buffer representing remote buffer: %s",
+				     doca_error_get_descr(result));
+			doca_buf_dec_refcount(resources.src_doca_buf_array[nb_bufs], NULL);
+			goto destroy_bufs;
+		}
+	}
+
+	task_user_data.ptr = &task_result;
+	for (nb_tasks = 0; nb_tasks < NUM_DMA_TASKS; nb_tasks++) {
+		result = doca_dma_task_memcpy_alloc_init(resources.dma_ctx, resources.src_doca_buf_array[nb_tasks],
+							 resources.dst_doca_buf_array[nb_tasks], task_user_data,
+							 &resources.tasks[nb_tasks]);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to allocate DMA memcpy task: %s", doca_error_get_descr(result));
+			goto free_tasks;
+		}
+	}
+
+	printf("%-20s %10s %10s %10s %10s %10s %10s %10s\n", "kernel", "size", "min(us)", "avg(us)", "max(us)",
+	       "std(us)", "Mops", "GB/s");
+	for (const auto &k : dma_kernels::kernels) {
+		if (strcmp(kernel, "all") != 0 && strcmp(kernel, k.name) != 0)
+			continue;
+		for (size = MIN_KERNEL_SIZE; size <= max_size; size *= 4) {
+			res = dma_kernels::kernel_result();
+			result = k.run(&resources, size, &res);
+			if (result == DOCA_SUCCESS && task_result == DOCA_SUCCESS && tracing)
+				result = trace_kernel(k, &resources, size, res);
+			if (result != DOCA_SUCCESS || task_result != DOCA_SUCCESS) {
+				DOCA_ERROR_PROPAGATE(result, task_result);
+				DOCA_LOG_ERR("Kernel %s failed at %zu bytes: %s", k.name, size, doca_error_get_descr(result));
+				goto free_tasks;
+			}
+			if (res.mops < 0)
+				printf("%-20s %10zu %10.2f %10.2f %10.2f %10.2f %10s %10s\n", k.name, size, res.min_us,
+				       res.avg_us, res.max_us, res.std_us, "-", "-");
+			else
+				printf("%-20s %10zu %10s %10s %10s %10s %10.3f %10.3f\n", k.name, size, "-", "-", "-", "-",
+				       res.mops, res.mops * size / 1000);
+			if (res.timeline != nullptr) {
+				timeline_report(res.timeline, k.name, size);
+				timeline_destroy(res.timeline);
+			}
+			fflush(stdout);
+		}
+	}
+
+	if (tracing) {
+		nb_events = trace_export(trace_path);
+		if (nb_events < 0) {
+			DOCA_LOG_ERR("Failed to write trace to %s", trace_path);
+			result = DOCA_ERROR_IO_FAILED;
+		} else {
+			printf("Trace: %ld events written to %s\n", nb_events, trace_path);
+		}
+	}
+
+free_tasks:
+	for (i = 0; i < nb_tasks; i++)
+		doca_task_free(doca_dma_task_memcpy_as_task(resources.tasks[i]));
+destroy_bufs:
+	for (i = 0; i < nb_bufs; i++) {
+		tmp_result = doca_buf_dec_refcount(resources.src_doca_buf_array[i], NULL);
+		DOCA_ERROR_PROPAGATE(tmp_result, doca_buf_dec_refcount(resources.dst_doca_buf_array[i], NULL));
+		if (tmp_result != DOCA_SUCCESS) {
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+			DOCA_LOG_ERR("Failed to decrease DOCA buffer reference count: %s", doca_error_get_descr(tmp_result));
+		}
+	}
+	tmp_result = doca_mmap_destroy(resources.remote_mmap);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+		DOCA_LOG_ERR("Failed to destroy remote mmap: %s", doca_error_get_descr(tmp_result));
+	}
+free_dpu_buffer:
+	free(resources.dpu_buffer);
+stop_dma:
+	tmp_result = request_stop_ctx(state->pe, state->ctx);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+		DOCA_LOG_ERR("Unable to stop context: %s", doca_error_get_descr(tmp_result));
+	}
+	state->ctx = NULL;
+destroy_resources:
+	tmp_result = destroy_dma_resources(&resources);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+		DOCA_LOG_ERR("Failed to destroy DMA resources: %s", doca_error_get_descr(tmp_result));
+	}
+
+	return result;
+}
@@ -0,0 +1,102 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+
+#ifndef DMA_TIMELINE_H_
+#define DMA_TIMELINE_H_
+
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Per-interval throughput timeline
+ *
+ * The measured thread publishes its completed operation count and in-flight depth with timeline_update(), two
+ * relaxed stores to a cacheline of their own. A side thread wakes up every interval on an absolute CLOCK_MONOTONIC
+ * deadline, copies both counters into a preallocated sample array and goes back to sleep, so the measured thread
+ * never takes a lock or a system call. Rates are computed from the real timestamps of consecutive samples, a late
+ * wakeup makes one interval longer but does not distort its rate. The layer does not know about DOCA.
+ */
+
+#define TIMELINE_CACHE_LINE 64	/* Keeps the published counters away from the sampler fields */
+
+/* One sample */
+struct timeline_sample {
+	uint64_t t_ns;		/* Time since timeline_create() */
+	uint64_t ops;		/* Completed operations */
+	uint64_t in_flight;	/* Submitted and not yet completed operations */
+};
+
+/* Timeline of one run */
+struct timeline {
+	/* Written by the measured thread */
+	uint64_t ops __attribute__((aligned(TIMELINE_CACHE_LINE)));	/* Completed operations */
+	uint64_t in_flight;						/* Outstanding operations */
+	/* Sampler */
+	struct timeline_sample *samples __attribute__((aligned(TIMELINE_CACHE_LINE)));	/* Sample array */
+	uint32_t max_samples;		/* Capacity of samples */
+	uint32_t nb_samples;		/* Valid samples */
+	uint64_t interval_ns;		/* Sampling interval */
+	uint64_t start_ns;		/* CLOCK_MONOTONIC time of the first sample */
+	int stop;			/* Set by timeline_stop() */
+	int running;			/* The sampler thread has to be joined */
+	pthread_t thread;		/* Sampler thread */
+};
+
+/*
+ * Create a timeline and start its sampler thread, the first sample is taken right away with both counters at 0
+ *
+ * @interval_ms [in]: sampling interval in milliseconds, at least 1
+ * @max_samples [in]: capacity, the sampler stops when it is full
+ * @return: timeline on success and NULL otherwise
+ */
+struct timeline *timeline_create(uint32_t interval_ms, uint32_t max_samples);
+
+/*
+ * Publish the counters of the measured thread
+ *
+ * @tl [in]: timeline
+ * @ops [in]: completed operations since timeline_create()
+ * @in_flight [in]: outstanding operations
+ */
+static inline void
+timeline_update(struct timeline *tl, uint64_t ops, uint64_t in_flight)
+{
+	__atomic_store_n(&tl->ops, ops, __ATOMIC_RELAXED);
+	__atomic_store_n(&tl->in_flight, in_flight, __ATOMIC_RELAXED);
+}
+
+/*
+ * Stop the sampler and take a last sample, so the final partial interval is not lost
+ *
+ * @tl [in]: timeline
+ */
+void timeline_stop(struct timeline *tl);
+
+/*
+ * Print one TIMELINE line per interval and a STABILITY summary of the interval bandwidths
+ *
+ * @tl [in]: stopped timeline
+ * @name [in]: label of the run
+ * @size [in]: bytes per operation
+ */
+void timeline_report(const struct timeline *tl, const char *name, size_t size);
+
+/*
+ * Stop the sampler if it still runs and free the timeline
+ *
+ * @tl [in]: timeline, may be NULL
+ */
+void timeline_destroy(struct timeline *tl);
+
+#endif
@@ -0,0 +1,172 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "dma_trace.h"
+
+#define TRACE_RING_MASK (TRACE_RING_SIZE - 1)
+
+/* Ring of one thread */
+struct trace_ring {
+	struct trace_rec *recs;		/* TRACE_RING_SIZE records */
+	uint64_t head;			/* Records written so far */
+	uint32_t tid;			/* Kernel thread id */
+	struct trace_ring *next;	/* Global list */
+};
+
+int trace_enabled;
+static struct trace_ring *rings;		/* Every ring ever created */
+static __thread struct trace_ring *self;	/* Ring of the calling thread */
+
+/*
+ * Ring of the calling thread, created on first use
+ *
+ * @return: ring, NULL if it cannot be allocated
+ */
+static struct trace_ring *
+ring_get(void)
+{
+	struct trace_ring *r;
+
+	if (self != NULL)
+		return self;
+	r = calloc(1, sizeof(*r));
+	if (r == NULL)
+		return NULL;
+	r->recs = calloc(TRACE_RING_SIZE, sizeof(*r->recs));
+	if (r->recs == NULL) {
+		free(r);
+		return NULL;
+	}
+	r->tid = syscall(SYS_gettid);
+	r->next = __atomic_load_n(&rings, __ATOMIC_RELAXED);
+	while (!__atomic_compare_exchange_n(&rings, &r->next, r, false, __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+		;
+	self = r;
+	return r;
+}
+
+void
+trace_record(uint32_t type, uint64_t start_ns, uint64_t arg)
+{
+	struct trace_ring *r = ring_get();
+	struct trace_rec *rec;
+	struct timespec ts;
+	uint64_t now;
+
+	if (r == NULL)
+		return;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	now = (uint64_t)ts.tv_sec * 1000000000UL + ts.tv_nsec;
+	if (start_ns == 0)
+		start_ns = now;
+
+	/* A run of empty progress calls becomes one record that grows, its arg counts the calls */
+	if (type == TRACE_PROGRESS_IDLE) {
+		if (r->head > 0) {
+			rec = &r->recs[(r->head - 1) & TRACE_RING_MASK];
+			if (rec->type == TRACE_PROGRESS_IDLE) {
+				rec->dur_ns = now - rec->ts_ns;
+				rec->arg++;
+				return;
+			}
+		}
+		arg = 1;
+	}
+
+	rec = &r->recs[r->head & TRACE_RING_MASK];
+	rec->ts_ns = start_ns;
+	rec->dur_ns = now - start_ns;
+	rec->type = type;
+	rec->arg = arg;
+	r->head++;
+}
+
+void
+trace_enable(int on)
+{
+	__atomic_store_n(&trace_enabled, on, __ATOMIC_RELEASE);
+}
+
+void
+trace_reset(void)
+{
+	struct trace_ring *r;
+
+	for (r = __atomic_load_n(&rings, __ATOMIC_ACQUIRE); r != NULL; r = r->next)
+		r->head = 0;
+}
+
+/*
+ * Index of the oldest record still in a ring
+ *
+ * @r [in]: ring
+ * @return: record number
+ */
+static uint64_t
+ring_first(const struct trace_ring *r)
+{
+	return r->head > TRACE_RING_SIZE ? r->head - TRACE_RING_SIZE : 0;
+}
+
+long
+trace_export(const char *path)
+{
+	static const char *const names[] = {"submit", "progress=0", "progress=1", "completion", "error", "rearm",
+					    "epoll_wait"};
+	static const char *const args[] = {"task", "calls", "remaining", "remaining", "remaining", "unused", "events"};
+	const struct trace_ring *r;
+	const struct trace_rec *rec;
+	uint64_t i, t0 = UINT64_MAX;
+	long n = 0;
+	int pid = getpid(), first = 1;
+	FILE *fp;
+
+	for (r = __atomic_load_n(&rings, __ATOMIC_ACQUIRE); r != NULL; r = r->next)
+		if (r->head > 0 && r->recs[ring_first(r) & TRACE_RING_MASK].ts_ns < t0)
+			t0 = r->recs[ring_first(r) & TRACE_RING_MASK].ts_ns;
+
+	fp = fopen(path, "w");
+	if (fp == NULL)
+		return -1;
+	fprintf(fp, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+	for (r = __atomic_load_n(&rings, __ATOMIC_ACQUIRE); r != NULL; r = r->next) {
+		fprintf(fp, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%u,"
+			"\"args\":{\"name\":\"dma %u\"}}",
+			first ? "" : ",\n", pid, r->tid, r->tid);
+		first = 0;
+		for (i = ring_first(r); i < r->head; i++) {
+			rec = &r->recs[i & TRACE_RING_MASK];
+			fprintf(fp, ",\n{\"name\":\"%s\",\"cat\":\"dma\",\"pid\":%d,\"tid\":%u,\"ts\":%.3f,",
+				rec->type == TRACE_SPAN ? (const char *)rec->arg : names[rec->type], pid, r->tid,
+				(rec->ts_ns - t0) / 1000.0);
+			if (rec->dur_ns > 0 || rec->type == TRACE_SPAN || rec->type == TRACE_PROGRESS_IDLE)
+				fprintf(fp, "\"ph\":\"X\",\"dur\":%.3f", rec->dur_ns / 1000.0);
+			else
+				fprintf(fp, "\"ph\":\"i\",\"s\":\"t\"");
+			if (rec->type == TRACE_SPAN || rec->type == TRACE_REARM)
+				fprintf(fp, "}");
+			else
+				fprintf(fp, ",\"args\":{\"%s\":%lu}}", args[rec->type], rec->arg);
+			n++;
+		}
+	}
+	fprintf(fp, "\n]}\n");
+	if (fclose(fp) != 0)
+		return -1;
+	return n;
+}
@@ -0,0 +1,128 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+
+#ifndef DMA_TRACE_H_
+#define DMA_TRACE_H_
+
+#include <stdint.h>
+#include <time.h>
+
+/*
+ * Per-thread DMA event trace
+ *
+ * Every thread that records an event gets its own ring of TRACE_RING_SIZE records on first use, linked into a global
+ * list with a compare-and-swap, so recording never takes a lock and never touches another thread's cacheline. A full
+ * ring overwrites its oldest records, the trace always holds the end of the run. Consecutive PE progress calls that
+ * retired nothing are merged into one record. Tracing is compiled in and off until trace_enable(); while it is off
+ * every trace point is one load and one predicted branch. trace_export() writes the Chrome trace event format, which
+ * chrome://tracing and ui.perfetto.dev open directly; call it once the traced threads are quiet.
+ */
+
+#define TRACE_RING_SIZE (1U << 20)	/* Records per thread, a power of two */
+
+/* Event types */
+enum trace_type {
+	TRACE_SUBMIT,		/* Task submitted, arg: task index */
+	TRACE_PROGRESS_IDLE,	/* Progress calls that returned 0, arg: number of calls */
+	TRACE_PROGRESS,		/* Progress call that returned 1, arg: remaining tasks */
+	TRACE_COMPLETION,	/* Task completion callback, arg: remaining tasks */
+	TRACE_ERROR,		/* Task error callback, arg: remaining tasks */
+	TRACE_REARM,		/* PE notification requested */
+	TRACE_EPOLL,		/* epoll_wait() on the PE notification handle, arg: number of events */
+	TRACE_SPAN,		/* Named span, arg: const char * name */
+};
+
+/* One record */
+struct trace_rec {
+	uint64_t ts_ns;		/* CLOCK_MONOTONIC start time */
+	uint64_t arg;		/* Type-specific argument */
+	uint64_t dur_ns;	/* Duration, 0 for an instant event, 64 bits as a stream span lasts seconds */
+	uint32_t type;		/* enum trace_type */
+};
+
+/* Set by trace_enable(), read by every trace point */
+extern int trace_enabled;
+
+/*
+ * Current CLOCK_MONOTONIC time if tracing is on
+ *
+ * @return: time in nanoseconds, 0 while tracing is off
+ */
+static inline uint64_t
+trace_now(void)
+{
+	struct timespec ts;
+
+	if (__builtin_expect(!trace_enabled, 1))
+		return 0;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000UL + ts.tv_nsec;
+}
+
+/*
+ * Append one record to the ring of the calling thread, only called with tracing on
+ *
+ * @type [in]: enum trace_type
+ * @start_ns [in]: start time from trace_now(), 0 for an instant event at the current time
+ * @arg [in]: type-specific argument
+ */
+void trace_record(uint32_t type, uint64_t start_ns, uint64_t arg);
+
+/*
+ * Record an instant event
+ *
+ * @type [in]: enum trace_type
+ * @arg [in]: type-specific argument
+ */
+static inline void
+trace_event(uint32_t type, uint64_t arg)
+{
+	if (__builtin_expect(trace_enabled, 0))
+		trace_record(type, 0, arg);
+}
+
+/*
+ * Record an event that started at start_ns and ends now
+ *
+ * @type [in]: enum trace_type
+ * @start_ns [in]: value of trace_now() at the start
+ * @arg [in]: type-specific argument
+ */
+static inline void
+trace_span(uint32_t type, uint64_t start_ns, uint64_t arg)
+{
+	if (__builtin_expect(trace_enabled, 0))
+		trace_record(type, start_ns, arg);
+}
+
+/*
+ * Turn tracing on or off for all threads
+ *
+ * @on [in]: 1 to record, 0 to stop recording
+ */
+void trace_enable(int on);
+
+/*
+ * Drop every recorded event, the rings stay allocated
+ */
+void trace_reset(void);
+
+/*
+ * Write all rings in the Chrome trace event format
+ *
+ * @path [in]: output file
+ * @return: number of exported events on success and -1 otherwise
+ */
+long trace_export(const char *path);
+
+#endif
@@ -0,0 +1,243 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "dma_multiproc.h"
+
+/* Shared launcher state, followed by the result slots */
+struct mp_shared {
+	size_t map_size;		/* Size of the whole mapping */
+	size_t slot_size;		/* Result slot size, rounded up to a cache line */
+	int nb_workers;			/* Number of workers of the launch */
+	int arrived;			/* Workers waiting at the barrier */
+	int generation;			/* Incremented every time the barrier releases */
+	int aborted;			/* Set once a worker failed */
+	uint64_t release_ns;		/* Time of the last barrier release */
+};
+
+/* Per-thread launch argument */
+struct mp_thread {
+	pthread_t tid;			/* Thread handle */
+	struct mp_shared *s;		/* Shared state */
+	int id;				/* Worker index */
+	mp_worker_fn fn;		/* Worker function */
+	void *arg;			/* Worker argument */
+	int ret;			/* Worker return value */
+};
+
+#define MP_CACHE_LINE 64
+#define MP_HEADER_SIZE ((sizeof(struct mp_shared) + MP_CACHE_LINE - 1) & ~(size_t)(MP_CACHE_LINE - 1))
+
+/*
+ * Current CLOCK_MONOTONIC time
+ *
+ * @return: time in nanoseconds
+ */
+static uint64_t
+now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+struct mp_shared *
+mp_shared_create(int nb_workers, size_t result_size)
+{
+	struct mp_shared *s;
+	size_t slot_size, map_size;
+
+	if (nb_workers < 1)
+		return NULL;
+	slot_size = (result_size + MP_CACHE_LINE - 1) & ~(size_t)(MP_CACHE_LINE - 1);
+	map_size = MP_HEADER_SIZE + slot_size * nb_workers;
+
+	/* Anonymous shared memory is zeroed and stays shared with every child forked afterwards */
+	s = mmap(NULL, map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (s == MAP_FAILED) {
+		perror("Failed to map launcher state");
+		return NULL;
+	}
+	s->map_size = map_size;
+	s->slot_size = slot_size;
+	s->nb_workers = nb_workers;
+	return s;
+}
+
+void *
+mp_result(struct mp_shared *s, int id)
+{
+	return (char *)s + MP_HEADER_SIZE + s->slot_size * id;
+}
+
+int
+mp_barrier_wait(struct mp_shared *s, uint64_t *release_ns)
+{
+	int generation = __atomic_load_n(&s->generation, __ATOMIC_ACQUIRE);
+
+	if (__atomic_load_n(&s->aborted, __ATOMIC_ACQUIRE))
+		return -1;
+
+	if (__atomic_add_fetch(&s->arrived, 1, __ATOMIC_ACQ_REL) == s->nb_workers) {
+		/* Last one in: publish the release time, reset the count, then open the barrier */
+		s->release_ns = now_ns();
+		__atomic_store_n(&s->arrived, 0, __ATOMIC_RELAXED);
+		__atomic_store_n(&s->generation, generation + 1, __ATOMIC_RELEASE);
+	} else {
+		/* Workers can outnumber the cores, so yield instead of spinning hard */
+		while (__atomic_load_n(&s->generation, __ATOMIC_ACQUIRE) == generation) {
+			if (__atomic_load_n(&s->aborted, __ATOMIC_ACQUIRE))
+				return -1;
+			sched_yield();
+		}
+	}
+
+	if (release_ns != NULL)
+		*release_ns = s->release_ns;
+	return 0;
+}
+
+void
+mp_abort(struct mp_shared *s)
+{
+	__atomic_store_n(&s->aborted, 1, __ATOMIC_RELEASE);
+}
+
+/*
+ * Thread entry point of a worker
+ *
+ * @arg [in]: launch argument
+ * @return: NULL
+ */
+static void *
+thread_main(void *arg)
+{
+	struct mp_thread *t = arg;
+
+	t->ret = t->fn(t->s, t->id, t->arg);
+	if (t->ret != 0)
+		mp_abort(t->s);
+	return NULL;
+}
+
+/*
+ * Run the workers as threads of this process
+ *
+ * @s [in]: shared state
+ * @fn [in]: worker function
+ * @arg [in]: worker argument
+ * @return: 0 if every worker returned 0 and -1 otherwise
+ */
+static int
+run_threads(struct mp_shared *s, mp_worker_fn fn, void *arg)
+{
+	struct mp_thread *threads;
+	int i, started, ret = 0;
+
+	threads = calloc(s->nb_workers, sizeof(*threads));
+	if (threads == NULL)
+		return -1;
+
+	for (started = 0; started < s->nb_workers; started++) {
+		threads[started] = (struct mp_thread){.s = s, .id = started, .fn = fn, .arg = arg};
+		if (pthread_create(&threads[started].tid, NULL, thread_main, &threads[started]) != 0) {
+			fprintf(stderr, "Failed to start worker thread %d\n", started);
+			mp_abort(s);
+			ret = -1;
+			break;
+		}
+	}
+	for (i = 0; i < started; i++) {
+		pthread_join(threads[i].tid, NULL);
+		if (threads[i].ret != 0)
+			ret = -1;
+	}
+
+	free(threads);
+	return ret;
+}
+
+/*
+ * Run the workers as forked processes
+ *
+ * @s [in]: shared state
+ * @fn [in]: worker function
+ * @arg [in]: worker argument
+ * @return: 0 if every worker returned 0 and -1 otherwise
+ */
+static int
+run_processes(struct mp_shared *s, mp_worker_fn fn, void *arg)
+{
+	int started, status, ret = 0;
+	pid_t pid;
+
+	/* Children inherit unflushed stdio buffers, which would then be printed twice */
+	fflush(NULL);
+
+	for (started = 0; started < s->nb_workers; started++) {
+		pid = fork();
+		if (pid == 0) {
+			status = fn(s, started, arg);
+			if (status != 0)
+				mp_abort(s);
+			fflush(NULL);
+			_exit(status == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+		}
+		if (pid < 0) {
+			perror("Failed to fork worker process");
+			mp_abort(s);
+			ret = -1;
+			break;
+		}
+	}
+
+	/* A worker killed by a signal cannot abort by itself, so the launcher does it for the others */
+	for (; started > 0; started--) {
+		pid = waitpid(-1, &status, 0);
+		if (pid < 0) {
+			perror("Failed to wait for worker process");
+			mp_abort(s);
+			return -1;
+		}
+		if (!WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS) {
+			if (WIFSIGNALED(status))
+				fprintf(stderr, "Worker process %d killed by signal %d\n", (int)pid, WTERMSIG(status));
+			mp_abort(s);
+			ret = -1;
+		}
+	}
+	return ret;
+}
+
+int
+mp_run(struct mp_shared *s, enum mp_mode mode, mp_worker_fn fn, void *arg)
+{
+	if (mode == MP_THREADS)
+		return run_threads(s, fn, arg);
+	return run_processes(s, fn, arg);
+}
+
+void
+mp_shared_destroy(struct mp_shared *s)
+{
+	if (s != NULL)
+		munmap(s, s->map_size);
+}
@@ -0,0 +1,97 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+#ifndef DMA_MULTIPROC_H_
+#define DMA_MULTIPROC_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Launcher for workers that run either as threads of one process or as forked processes
+ *
+ * The launcher state, a start barrier and one result slot per worker live in an anonymous shared mapping created
+ * before the workers start, so forked workers and threads use the same code. The barrier releases all workers at
+ * once and hands them a common start time. A worker that fails, or a process that dies, aborts the barrier so the
+ * other workers do not wait forever. The launcher does not know about DOCA; workers open their own devices.
+ */
+
+/* How workers are started */
+enum mp_mode {
+	MP_THREADS,	/* pthreads sharing one address space */
+	MP_PROCESSES,	/* fork()ed processes, each with its own address space */
+};
+
+struct mp_shared;
+
+/*
+ * Worker function
+ *
+ * @s [in]: shared state, for mp_barrier_wait() and mp_result()
+ * @id [in]: worker index, 0 .. nb_workers - 1
+ * @arg [in]: argument given to mp_run()
+ * @return: 0 on success and -1 otherwise
+ */
+typedef int (*mp_worker_fn)(struct mp_shared *s, int id, void *arg);
+
+/*
+ * Create the shared state for one launch
+ *
+ * @nb_workers [in]: number of workers
+ * @result_size [in]: size of the result slot of every worker
+ * @return: shared state, NULL on failure
+ */
+struct mp_shared *mp_shared_create(int nb_workers, size_t result_size);
+
+/*
+ * Result slot of a worker, zeroed at creation and visible to the launcher after mp_run()
+ *
+ * @s [in]: shared state
+ * @id [in]: worker index
+ * @return: result slot
+ */
+void *mp_result(struct mp_shared *s, int id);
+
+/*
+ * Wait until every worker reached the barrier
+ *
+ * @s [in]: shared state
+ * @release_ns [out]: CLOCK_MONOTONIC time at which the last worker arrived, the same for every worker
+ * @return: 0 on success and -1 if the launch was aborted
+ */
+int mp_barrier_wait(struct mp_shared *s, uint64_t *release_ns);
+
+/*
+ * Abort the launch, current and future barrier waits return -1
+ *
+ * @s [in]: shared state
+ */
+void mp_abort(struct mp_shared *s);
+
+/*
+ * Run the workers and wait for all of them
+ *
+ * @s [in]: shared state
+ * @mode [in]: threads or processes
+ * @fn [in]: worker function
+ * @arg [in]: worker argument, copied into every process by fork()
+ * @return: 0 if every worker returned 0 and -1 otherwise
+ */
+int mp_run(struct mp_shared *s, enum mp_mode mode, mp_worker_fn fn, void *arg);
+
+/*
+ * Destroy the shared state
+ *
+ * @s [in]: shared state
+ */
+void mp_shared_destroy(struct mp_shared *s);
+
+#endif
@@ -0,0 +1,280 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <doca_argp.h>
+#include <doca_log.h>
+
+#include "dma_common.h"
+
+DOCA_LOG_REGISTER(DMA_MULTIPROC_DPU::MAIN);
+
+/* Configuration struct, dma_conf comes first so the dma_common ARGP callbacks can use it */
+struct multiproc_config {
+	struct dma_config dma_conf;	/* Device and host buffer */
+	int nb_workers;			/* Largest number of workers of the sweep */
+	size_t size;			/* Transfer size */
+	uint32_t duration_s;		/* Measured window of every point */
+	char mode[MAX_ARG_SIZE];	/* threads, procs or both */
+	char op[MAX_ARG_SIZE];		/* read or write */
+};
+
+/* Sample's Logic */
+doca_error_t dma_multiproc_dpu(int max_workers, size_t size, uint32_t duration_s, const char *mode, const char *op,
+			       const char *export_desc_file_path, const char *buffer_info_file_path,
+			       const char *pcie_addr);
+
+/*
+ * ARGP Callback - Handle workers parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+workers_callback(void *param, void *config)
+{
+	struct multiproc_config *conf = (struct multiproc_config *)config;
+	int workers = *(int *)param;
+
+	if (workers < 1) {
+		DOCA_LOG_ERR("Number of workers must be at least 1");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	conf->nb_workers = workers;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle size parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+size_callback(void *param, void *config)
+{
+	struct multiproc_config *conf = (struct multiproc_config *)config;
+	int size = *(int *)param;
+
+	if (size < 1) {
+		DOCA_LOG_ERR("Transfer size must be at least 1 byte");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	conf->size = size;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle duration parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+duration_callback(void *param, void *config)
+{
+	struct multiproc_config *conf = (struct multiproc_config *)config;
+	int duration = *(int *)param;
+
+	if (duration < 1) {
+		DOCA_LOG_ERR("Duration must be at least 1 s");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	conf->duration_s = duration;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle mode parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+mode_callback(void *param, void *config)
+{
+	struct multiproc_config *conf = (struct multiproc_config *)config;
+	const char *mode = (char *)param;
+
+	if (strcmp(mode, "threads") != 0 && strcmp(mode, "procs") != 0 && strcmp(mode, "both") != 0) {
+		DOCA_LOG_ERR("Mode must be threads, procs or both");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	strcpy(conf->mode, mode);
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle op parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+op_callback(void *param, void *config)
+{
+	struct multiproc_config *conf = (struct multiproc_config *)config;
+	const char *op = (char *)param;
+
+	if (strcmp(op, "read") != 0 && strcmp(op, "write") != 0) {
+		DOCA_LOG_ERR("Operation must be read or write");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	strcpy(conf->op, op);
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Register one program parameter
+ *
+ * @short_name [in]: short option
+ * @long_name [in]: long option
+ * @description [in]: help text
+ * @callback [in]: parser callback
+ * @type [in]: argument type
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+register_param(const char *short_name, const char *long_name, const char *description, doca_argp_param_cb_t callback,
+	       enum doca_argp_type type)
+{
+	struct doca_argp_param *param;
+	doca_error_t result;
+
+	result = doca_argp_param_create(&param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(param, short_name);
+	doca_argp_param_set_long_name(param, long_name);
+	doca_argp_param_set_description(param, description);
+	doca_argp_param_set_callback(param, callback);
+	doca_argp_param_set_type(param, type);
+	result = doca_argp_register_param(param);
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+	return result;
+}
+
+/*
+ * Register the workers, size, duration, mode and op parameters
+ *
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+register_multiproc_params(void)
+{
+	doca_error_t result;
+
+	result = register_param("n", "workers", "Largest number of workers, the sweep runs 1 .. n (default: 4)",
+				workers_callback, DOCA_ARGP_TYPE_INT);
+	if (result != DOCA_SUCCESS)
+		return result;
+	result = register_param("z", "size", "Transfer size in bytes (default: 65536)", size_callback,
+				DOCA_ARGP_TYPE_INT);
+	if (result != DOCA_SUCCESS)
+		return result;
+	result = register_param("s", "duration", "Measured window of every point in seconds (default: 2)",
+				duration_callback, DOCA_ARGP_TYPE_INT);
+	if (result != DOCA_SUCCESS)
+		return result;
+	result = register_param("m", "mode", "threads, procs or both (default: both)", mode_callback,
+				DOCA_ARGP_TYPE_STRING);
+	if (result != DOCA_SUCCESS)
+		return result;
+	return register_param("o", "op", "read (host to DPU) or write (DPU to host) (default: read)", op_callback,
+			      DOCA_ARGP_TYPE_STRING);
+}
+
+/*
+ * Sample main function
+ *
+ * @argc [in]: command line arguments size
+ * @argv [in]: array of command line arguments
+ * @return: EXIT_SUCCESS on success and EXIT_FAILURE otherwise
+ */
+int
+main(int argc, char **argv)
+{
+	struct multiproc_config conf = {0};
+	doca_error_t result;
+	struct doca_log_backend *sdk_log;
+	int exit_status = EXIT_FAILURE;
+
+	/* Set the default configuration values (Example values) */
+	strcpy(conf.dma_conf.pci_address, "03:00.0");
+	strcpy(conf.dma_conf.export_desc_path, "/tmp/export_desc.txt");
+	strcpy(conf.dma_conf.buf_info_path, "/tmp/buffer_info.txt");
+	conf.nb_workers = 4;
+	conf.size = 65536;
+	conf.duration_s = 2;
+	strcpy(conf.mode, "both");
+	strcpy(conf.op, "read");
+
+	/* Register a logger backend */
+	result = doca_log_backend_create_standard();
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+
+	/* Register a logger backend for internal SDK errors and warnings */
+	result = doca_log_backend_create_with_file_sdk(stderr, &sdk_log);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+	result = doca_log_backend_set_sdk_level(sdk_log, DOCA_LOG_LEVEL_WARNING);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+
+	result = doca_argp_init("doca_dma_multiproc", &conf);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to init ARGP resources: %s", doca_error_get_descr(result));
+		goto sample_exit;
+	}
+	result = register_dma_params(true);
+	if (result == DOCA_SUCCESS)
+		result = register_multiproc_params();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register DMA sample parameters: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+	result = doca_argp_start(argc, argv);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to parse sample input: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	result = dma_multiproc_dpu(conf.nb_workers, conf.size, conf.duration_s, conf.mode, conf.op,
+				   conf.dma_conf.export_desc_path, conf.dma_conf.buf_info_path,
+				   conf.dma_conf.pci_address);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("dma_multiproc_dpu() encountered an error: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	exit_status = EXIT_SUCCESS;
+
+argp_cleanup:
+	doca_argp_destroy();
+sample_exit:
+	if (exit_status == EXIT_SUCCESS)
+		DOCA_LOG_INFO("Sample finished successfully");
+	else
+		DOCA_LOG_INFO("Sample finished with errors");
+	return exit_status;
+}
@@ -0,0 +1,616 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <doca_buf.h>
+#include <doca_buf_inventory.h>
+#include <doca_ctx.h>
+#include <doca_dev.h>
+#include <doca_dma.h>
+#include <doca_error.h>
+#include <doca_log.h>
+#include <doca_mmap.h>
+#include <doca_pe.h>
+
+#include "dma_common.h"
+#include "dma_multiproc.h"
+
+DOCA_LOG_REGISTER(DMA_MULTIPROC_DPU);
+
+#define RECV_BUF_SIZE 256		/* Buffer which contains config information */
+#define MAX_DESC_SIZE 1024		/* Maximum size of the export descriptor */
+#define QUEUE_DEPTH 32			/* Outstanding DMAs per worker */
+#define MAX_WORKERS 16			/* Largest number of workers */
+
+/* Data-flow direction of a DPU-initiated transfer */
+enum mp_direction {
+	MP_PULL,	/* DPU reads host memory */
+	MP_PUSH,	/* DPU writes host memory */
+};
+
+/* Run parameters, read by the launcher and inherited by every worker */
+struct mp_params {
+	const char *pcie_addr;				/* DPU device every worker opens */
+	char export_desc[MAX_DESC_SIZE];		/* Host export descriptor */
+	size_t export_desc_len;				/* Host export descriptor length */
+	char *remote_addr;				/* Host buffer address */
+	size_t remote_len;				/* Host buffer length */
+	size_t size;					/* Transfer size */
+	uint32_t duration_s;				/* Length of the measured window */
+	enum mp_direction dir;				/* Direction */
+};
+
+/* Result of one worker, written into its shared slot */
+struct mp_worker_result {
+	double gbps;					/* Throughput over the common window */
+	double mops;					/* Operations per second over the common window */
+	double lat_us;					/* Average completion latency */
+	double setup_ms;				/* Device open to barrier arrival */
+};
+
+/* One worker with its own device, context and host slice */
+struct worker {
+	int id;						/* Worker index */
+	struct doca_dev *dev;				/* DOCA device, opened by this worker */
+	struct doca_mmap *local_mmap;			/* DPU buffer mmap */
+	struct doca_mmap *remote_mmap;			/* Host buffer mmap, imported by this worker */
+	struct doca_buf_inventory *buf_inv;		/* Inventory */
+	struct doca_pe *pe;				/* Progress engine */
+	struct doca_dma *dma;				/* DMA context */
+	struct doca_ctx *ctx;				/* DMA context as a generic context, NULL until started */
+	char *local;					/* DPU buffer */
+	struct doca_dma_task_memcpy *tasks[QUEUE_DEPTH];	/* Tasks, resubmitted until the window closes */
+	struct doca_buf *src[QUEUE_DEPTH];		/* Sources of the tasks */
+	struct doca_buf *dst[QUEUE_DEPTH];		/* Destinations of the tasks */
+	uint64_t submit_ns[QUEUE_DEPTH];		/* Last submission of every task */
+	uint64_t end_ns;				/* End of the measured window */
+	uint64_t completed;				/* Completions inside the window */
+	uint64_t lat_sum_ns;				/* Latency of the completions inside the window */
+	uint32_t inflight;				/* Tasks submitted and not completed */
+	doca_error_t task_result;			/* First task error */
+};
+
+/*
+ * Saves export descriptor and buffer information content into memory buffers
+ *
+ * @export_desc_file_path [in]: Export descriptor file path
+ * @buffer_info_file_path [in]: Buffer information file path
+ * @export_desc [in]: Export descriptor buffer
+ * @export_desc_len [in]: Export descriptor buffer length
+ * @remote_addr [in]: Remote buffer address
+ * @remote_addr_len [in]: Remote buffer total length
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+save_config_info_to_buffers(const char *export_desc_file_path, const char *buffer_info_file_path, char *export_desc,
+			    size_t *export_desc_len, char **remote_addr, size_t *remote_addr_len)
+{
+	FILE *fp;
+	long file_size;
+	char buffer[RECV_BUF_SIZE];
+
+	fp = fopen(export_desc_file_path, "r");
+	if (fp == NULL) {
+		DOCA_LOG_ERR("Failed to open %s", export_desc_file_path);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	if (fseek(fp, 0, SEEK_END) != 0) {
+		DOCA_LOG_ERR("Failed to calculate file size");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	file_size = ftell(fp);
+	if (file_size == -1) {
+		DOCA_LOG_ERR("Failed to calculate file size");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	if (file_size > MAX_DESC_SIZE)
+		file_size = MAX_DESC_SIZE;
+
+	*export_desc_len = file_size;
+
+	if (fseek(fp, 0L, SEEK_SET) != 0) {
+		DOCA_LOG_ERR("Failed to calculate file size");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	if (fread(export_desc, 1, file_size, fp) != (size_t)file_size) {
+		DOCA_LOG_ERR("Failed to read the export descriptor");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	fclose(fp);
+
+	/* Read source buffer information from file */
+	fp = fopen(buffer_info_file_path, "r");
+	if (fp == NULL) {
+		DOCA_LOG_ERR("Failed to open %s", buffer_info_file_path);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	/* Get source buffer address */
+	if (fgets(buffer, RECV_BUF_SIZE, fp) == NULL) {
+		DOCA_LOG_ERR("Failed to read the source (host) buffer address");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+	*remote_addr = (char *)strtoull(buffer, NULL, 0);
+
+	memset(buffer, 0, RECV_BUF_SIZE);
+
+	/* Get source buffer length */
+	if (fgets(buffer, RECV_BUF_SIZE, fp) == NULL) {
+		DOCA_LOG_ERR("Failed to read the source (host) buffer length");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+	*remote_addr_len = strtoull(buffer, NULL, 0);
+
+	fclose(fp);
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Current CLOCK_MONOTONIC time
+ *
+ * @return: time in nanoseconds
+ */
+static uint64_t
+now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/*
+ * DMA completed callback, counts completions inside the window and resubmits until it closes
+ *
+ * @dma_task [in]: Completed task
+ * @task_user_data [in]: doca_data from the task, index of the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void
+worker_completed_callback(struct doca_dma_task_memcpy *dma_task, union doca_data task_user_data,
+			  union doca_data ctx_user_data)
+{
+	struct worker *w = (struct worker *)ctx_user_data.ptr;
+	uint64_t i = task_user_data.u64, now = now_ns();
+	doca_error_t result;
+
+	w->inflight--;
+	if (now >= w->end_ns || w->task_result != DOCA_SUCCESS)
+		return;
+	w->completed++;
+	w->lat_sum_ns += now - w->submit_ns[i];
+
+	result = doca_buf_reset_data_len(doca_dma_task_memcpy_get_dst(dma_task));
+	if (result == DOCA_SUCCESS)
+		result = doca_task_submit(doca_dma_task_memcpy_as_task(dma_task));
+	if (result != DOCA_SUCCESS) {
+		w->task_result = result;
+		return;
+	}
+	w->submit_ns[i] = now;
+	w->inflight++;
+}
+
+/*
+ * DMA error callback
+ *
+ * @dma_task [in]: failed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void
+worker_error_callback(struct doca_dma_task_memcpy *dma_task, union doca_data task_user_data,
+		      union doca_data ctx_user_data)
+{
+	struct worker *w = (struct worker *)ctx_user_data.ptr;
+
+	(void)task_user_data;
+	w->inflight--;
+	if (w->task_result == DOCA_SUCCESS)
+		w->task_result = doca_task_get_status(doca_dma_task_memcpy_as_task(dma_task));
+}
+
+/*
+ * Open the device, import the host buffer, start a DMA context and allocate the tasks of one worker
+ *
+ * @w [in]: worker, id set
+ * @p [in]: run parameters
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+worker_setup(struct worker *w, const struct mp_params *p)
+{
+	size_t local_len = QUEUE_DEPTH * p->size;
+	char *remote = p->remote_addr + w->id * local_len;
+	struct doca_mmap *src_mmap, *dst_mmap;
+	char *src_addr, *dst_addr;
+	union doca_data data = {0};
+	doca_error_t result;
+	uint32_t i;
+
+	result = open_doca_device_with_pci(p->pcie_addr, &dma_task_is_supported, &w->dev);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Worker %d failed to open DOCA device: %s", w->id, doca_error_get_descr(result));
+		return result;
+	}
+
+	if (posix_memalign((void **)&w->local, 4096, local_len) != 0) {
+		DOCA_LOG_ERR("Worker %d failed to allocate its DPU buffer", w->id);
+		w->local = NULL;
+		return DOCA_ERROR_NO_MEMORY;
+	}
+	memset(w->local, 0, local_len);
+
+	result = doca_mmap_create(&w->local_mmap);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_add_dev(w->local_mmap, w->dev);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_set_memrange(w->local_mmap, w->local, local_len);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_start(w->local_mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Worker %d failed to start local mmap: %s", w->id, doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_buf_inventory_create(2 * QUEUE_DEPTH, &w->buf_inv);
+	if (result == DOCA_SUCCESS)
+		result = doca_buf_inventory_start(w->buf_inv);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Worker %d failed to start buffer inventory: %s", w->id, doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_pe_create(&w->pe);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Worker %d failed to create progress engine: %s", w->id, doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_dma_create(w->dev, &w->dma);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Worker %d failed to create DMA context: %s", w->id, doca_error_get_descr(result));
+		return result;
+	}
+	result = doca_dma_task_memcpy_set_conf(w->dma, worker_completed_callback, worker_error_callback, QUEUE_DEPTH);
+	if (result == DOCA_SUCCESS) {
+		data.ptr = w;
+		result = doca_ctx_set_user_data(doca_dma_as_ctx(w->dma), data);
+	}
+	if (result == DOCA_SUCCESS)
+		result = doca_pe_connect_ctx(w->pe, doca_dma_as_ctx(w->dma));
+	if (result == DOCA_SUCCESS)
+		result = doca_ctx_start(doca_dma_as_ctx(w->dma));
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Worker %d failed to start DMA context: %s", w->id, doca_error_get_descr(result));
+		return result;
+	}
+	w->ctx = doca_dma_as_ctx(w->dma);
+
+	result = doca_mmap_create_from_export(NULL, p->export_desc, p->export_desc_len, w->dev, &w->remote_mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Worker %d failed to import the host buffer: %s", w->id, doca_error_get_descr(result));
+		return result;
+	}
+
+	/* Every task owns size bytes on both sides, every worker its own slice of the host buffer */
+	src_mmap = p->dir == MP_PULL ? w->remote_mmap : w->local_mmap;
+	dst_mmap = p->dir == MP_PULL ? w->local_mmap : w->remote_mmap;
+	for (i = 0; i < QUEUE_DEPTH && result == DOCA_SUCCESS; i++) {
+		src_addr = (p->dir == MP_PULL ? remote : w->local) + i * p->size;
+		dst_addr = (p->dir == MP_PULL ? w->local : remote) + i * p->size;
+		result = doca_buf_inventory_buf_get_by_addr(w->buf_inv, src_mmap, src_addr, p->size, &w->src[i]);
+		if (result == DOCA_SUCCESS)
+			result = doca_buf_set_data(w->src[i], src_addr, p->size);
+		if (result == DOCA_SUCCESS)
+			result = doca_buf_inventory_buf_get_by_addr(w->buf_inv, dst_mmap, dst_addr, p->size,
+								    &w->dst[i]);
+		if (result == DOCA_SUCCESS) {
+			data.u64 = i;
+			result = doca_dma_task_memcpy_alloc_init(w->dma, w->src[i], w->dst[i], data, &w->tasks[i]);
+		}
+	}
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Worker %d failed to allocate its tasks: %s", w->id, doca_error_get_descr(result));
+	return result;
+}
+
+/*
+ * Free the tasks of a worker, stop its context and destroy all its objects
+ *
+ * @w [in]: worker
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+worker_destroy(struct worker *w)
+{
+	doca_error_t result = DOCA_SUCCESS;
+	uint32_t i;
+
+	for (i = 0; i < QUEUE_DEPTH; i++) {
+		if (w->tasks[i] != NULL)
+			doca_task_free(doca_dma_task_memcpy_as_task(w->tasks[i]));
+		if (w->src[i] != NULL)
+			doca_buf_dec_refcount(w->src[i], NULL);
+		if (w->dst[i] != NULL)
+			doca_buf_dec_refcount(w->dst[i], NULL);
+	}
+	if (w->ctx != NULL)
+		DOCA_ERROR_PROPAGATE(result, request_stop_ctx(w->pe, w->ctx));
+	if (w->remote_mmap != NULL)
+		DOCA_ERROR_PROPAGATE(result, doca_mmap_destroy(w->remote_mmap));
+	if (w->dma != NULL)
+		DOCA_ERROR_PROPAGATE(result, doca_dma_destroy(w->dma));
+	if (w->pe != NULL)
+		DOCA_ERROR_PROPAGATE(result, doca_pe_destroy(w->pe));
+	if (w->buf_inv != NULL) {
+		DOCA_ERROR_PROPAGATE(result, doca_buf_inventory_stop(w->buf_inv));
+		DOCA_ERROR_PROPAGATE(result, doca_buf_inventory_destroy(w->buf_inv));
+	}
+	if (w->local_mmap != NULL)
+		DOCA_ERROR_PROPAGATE(result, doca_mmap_destroy(w->local_mmap));
+	free(w->local);
+	if (w->dev != NULL)
+		DOCA_ERROR_PROPAGATE(result, doca_dev_close(w->dev));
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Worker %d failed to destroy its objects: %s", w->id, doca_error_get_descr(result));
+	return result;
+}
+
+/*
+ * Worker body, identical for threads and processes: set up, wait for the others, stream for the common window
+ *
+ * @s [in]: launcher state
+ * @id [in]: worker index
+ * @arg [in]: run parameters
+ * @return: 0 on success and -1 otherwise
+ */
+static int
+run_worker(struct mp_shared *s, int id, void *arg)
+{
+	const struct mp_params *p = (const struct mp_params *)arg;
+	struct mp_worker_result *res = mp_result(s, id);
+	struct worker *w;
+	uint64_t setup_start = now_ns(), release_ns;
+	doca_error_t result;
+	uint32_t i;
+	int ret = -1;
+
+	w = calloc(1, sizeof(*w));
+	if (w == NULL)
+		return -1;
+	w->id = id;
+	w->task_result = DOCA_SUCCESS;
+
+	result = worker_setup(w, p);
+	if (result != DOCA_SUCCESS)
+		goto destroy_worker;
+	res->setup_ms = (now_ns() - setup_start) / 1e6;
+
+	/* Device opens and context starts are excluded, the window starts when the last worker is ready */
+	if (mp_barrier_wait(s, &release_ns) != 0)
+		goto destroy_worker;
+	w->end_ns = release_ns + (uint64_t)p->duration_s * 1000000000ULL;
+
+	for (i = 0; i < QUEUE_DEPTH; i++) {
+		w->submit_ns[i] = now_ns();
+		result = doca_task_submit(doca_dma_task_memcpy_as_task(w->tasks[i]));
+		if (result != DOCA_SUCCESS) {
+			w->task_result = result;
+			break;
+		}
+		w->inflight++;
+	}
+	while (w->inflight > 0)
+		(void)doca_pe_progress(w->pe);
+
+	if (w->task_result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("DMA of worker %d failed: %s", id, doca_error_get_descr(w->task_result));
+		goto destroy_worker;
+	}
+	res->mops = w->completed / (p->duration_s * 1e6);
+	res->gbps = w->completed * p->size / (p->duration_s * 1e9);
+	res->lat_us = w->completed ? w->lat_sum_ns / 1e3 / w->completed : 0;
+	ret = 0;
+
+destroy_worker:
+	if (worker_destroy(w) != DOCA_SUCCESS)
+		ret = -1;
+	free(w);
+	return ret;
+}
+
+/*
+ * Jain's fairness index of the per-worker throughputs, 1 when every worker gets the same share
+ *
+ * @gbps [in]: per-worker throughputs
+ * @n [in]: number of workers
+ * @return: fairness index in [1/n, 1]
+ */
+static double
+jain_index(const double *gbps, int n)
+{
+	double sum = 0, sum_sq = 0;
+	int i;
+
+	for (i = 0; i < n; i++) {
+		sum += gbps[i];
+		sum_sq += gbps[i] * gbps[i];
+	}
+	return sum_sq > 0 ? sum * sum / (n * sum_sq) : 1;
+}
+
+/*
+ * Launch nb_workers workers, wait for them and print one row
+ *
+ * @p [in]: run parameters
+ * @mode [in]: threads or processes
+ * @nb_workers [in]: number of workers
+ * @single_gbps [in/out]: throughput of one worker of this mode, set by the first point
+ * @agg_gbps [out]: aggregate throughput
+ * @jain [out]: fairness index
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+run_point(struct mp_params *p, enum mp_mode mode, int nb_workers, double *single_gbps, double *agg_gbps,
+	  double *jain)
+{
+	double gbps[MAX_WORKERS], min_gbps, max_gbps, lat_us = 0, setup_ms = 0;
+	struct mp_worker_result *res;
+	struct mp_shared *s;
+	const char *mode_name = mode == MP_THREADS ? "threads" : "procs";
+	int i;
+
+	s = mp_shared_create(nb_workers, sizeof(struct mp_worker_result));
+	if (s == NULL)
+		return DOCA_ERROR_NO_MEMORY;
+	if (mp_run(s, mode, run_worker, p) != 0) {
+		DOCA_LOG_ERR("%d worker %s failed", nb_workers, mode_name);
+		mp_shared_destroy(s);
+		return DOCA_ERROR_OPERATING_SYSTEM;
+	}
+
+	*agg_gbps = 0;
+	for (i = 0; i < nb_workers; i++) {
+		res = mp_result(s, i);
+		gbps[i] = res->gbps;
+		*agg_gbps += res->gbps;
+		lat_us += res->lat_us / nb_workers;
+		if (res->setup_ms > setup_ms)
+			setup_ms = res->setup_ms;
+	}
+	min_gbps = max_gbps = gbps[0];
+	for (i = 1; i < nb_workers; i++) {
+		if (gbps[i] < min_gbps)
+			min_gbps = gbps[i];
+		if (gbps[i] > max_gbps)
+			max_gbps = gbps[i];
+	}
+	*jain = jain_index(gbps, nb_workers);
+	if (nb_workers == 1)
+		*single_gbps = *agg_gbps;
+
+	printf("%s\t %d\t %12.3f\t %8.3f\t %8.3f\t %.4f\t %.2fx\t %8.2f\t %8.1f\n", mode_name, nb_workers, *agg_gbps,
+	       min_gbps, max_gbps, *jain, *agg_gbps / *single_gbps, lat_us, setup_ms);
+	for (i = 0; i < nb_workers; i++) {
+		res = mp_result(s, i);
+		printf("WORKER %s %d %d %.3f %.4f %.2f %.1f\n", mode_name, nb_workers, i, res->gbps, res->mops,
+		       res->lat_us, res->setup_ms);
+	}
+	printf("MULTIPROC %s %d %zu %.3f %.3f %.3f %.4f %.3f %.2f\n", mode_name, nb_workers, p->size, *agg_gbps,
+	       min_gbps, max_gbps, *jain, *agg_gbps / *single_gbps, lat_us);
+	fflush(stdout);
+
+	mp_shared_destroy(s);
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Run DOCA multi-process DMA contention sample on the DPU
+ *
+ * @max_workers [in]: largest number of workers, the sweep runs 1 .. max_workers
+ * @size [in]: transfer size
+ * @duration_s [in]: length of the measured window of every point
+ * @mode [in]: "threads", "procs" or "both"
+ * @op [in]: "read" (host to DPU) or "write" (DPU to host)
+ * @export_desc_file_path [in]: Export descriptor file path
+ * @buffer_info_file_path [in]: Buffer info file path
+ * @pcie_addr [in]: Device PCI address
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t
+dma_multiproc_dpu(int max_workers, size_t size, uint32_t duration_s, const char *mode, const char *op,
+		  const char *export_desc_file_path, const char *buffer_info_file_path, const char *pcie_addr)
+{
+	static const char *const dir_names[] = {"read (host to DPU)", "write (DPU to host)"};
+	double single_gbps[2] = {0}, agg_gbps[2][MAX_WORKERS + 1], jain[2][MAX_WORKERS + 1];
+	bool run_mode[2];
+	struct mp_params *p;
+	doca_error_t result;
+	int m, n;
+
+	if (max_workers < 1 || max_workers > MAX_WORKERS) {
+		DOCA_LOG_ERR("Number of workers must be in [1, %d]", MAX_WORKERS);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	run_mode[MP_THREADS] = strcmp(mode, "procs") != 0;
+	run_mode[MP_PROCESSES] = strcmp(mode, "threads") != 0;
+
+	p = calloc(1, sizeof(*p));
+	if (p == NULL)
+		return DOCA_ERROR_NO_MEMORY;
+	p->pcie_addr = pcie_addr;
+	p->size = size;
+	p->duration_s = duration_s;
+	p->dir = strcmp(op, "write") == 0 ? MP_PUSH : MP_PULL;
+
+	/* The launcher never opens the device, so forked workers do not inherit any DOCA state */
+	result = save_config_info_to_buffers(export_desc_file_path, buffer_info_file_path, p->export_desc,
+					     &p->export_desc_len, &p->remote_addr, &p->remote_len);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to read memory configuration from file: %s", doca_error_get_descr(result));
+		goto free_params;
+	}
+	if (p->remote_len < (size_t)max_workers * QUEUE_DEPTH * size) {
+		DOCA_LOG_ERR("Host buffer must hold at least %zu bytes, %d workers x %d x %zu",
+			     (size_t)max_workers * QUEUE_DEPTH * size, max_workers, QUEUE_DEPTH, size);
+		result = DOCA_ERROR_INVALID_VALUE;
+		goto free_params;
+	}
+
+	printf("DMA %s, %zu bytes, queue depth %d per worker, %u s per point\n", dir_names[p->dir], size, QUEUE_DEPTH,
+	       duration_s);
+	printf("Mode\t Workers Aggregate(GB/s)\t Min(GB/s)\t Max(GB/s)\t Jain\t Scaling\t Lat(us)\t Setup(ms)\n");
+	for (n = 1; n <= max_workers; n++) {
+		for (m = MP_THREADS; m <= MP_PROCESSES; m++) {
+			if (!run_mode[m])
+				continue;
+			result = run_point(p, m, n, &single_gbps[m], &agg_gbps[m][n], &jain[m][n]);
+			if (result != DOCA_SUCCESS)
+				goto free_params;
+		}
+	}
+
+	if (run_mode[MP_THREADS] && run_mode[MP_PROCESSES]) {
+		printf("\nProcesses vs threads\n");
+		printf("Workers\t Threads(GB/s)\t Procs(GB/s)\t Procs/Threads\t Jain threads\t Jain procs\n");
+		for (n = 1; n <= max_workers; n++) {
+			printf("%d\t %12.3f\t %10.3f\t %12.3f\t %11.4f\t %9.4f\n", n, agg_gbps[MP_THREADS][n],
+			       agg_gbps[MP_PROCESSES][n], agg_gbps[MP_PROCESSES][n] / agg_gbps[MP_THREADS][n],
+			       jain[MP_THREADS][n], jain[MP_PROCESSES][n]);
+			printf("EFFICIENCY %d %.3f %.3f %.3f %.4f %.4f\n", n, agg_gbps[MP_THREADS][n],
+			       agg_gbps[MP_PROCESSES][n], agg_gbps[MP_PROCESSES][n] / agg_gbps[MP_THREADS][n],
+			       jain[MP_THREADS][n], jain[MP_PROCESSES][n]);
+		}
+	}
+
+free_params:
+	free(p);
+	return result;
+}
@@ -0,0 +1,204 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+#include <stdlib.h>
+
+#include "dma_qos.h"
+
+/* One tenant */
+struct qos_tenant {
+	struct qos_tenant_cfg cfg;	/* Tenant configuration */
+	double bytes_tokens;		/* Byte bucket */
+	double ops_tokens;		/* Op bucket */
+	double last_finish;		/* Finish tag of the last enqueued request */
+	struct qos_req *head;		/* Oldest queued request */
+	struct qos_req *tail;		/* Newest queued request */
+	struct qos_tenant_stats stats;	/* Counters */
+};
+
+struct qos {
+	enum qos_policy policy;				/* Dequeue policy */
+	struct qos_tenant tenants[QOS_MAX_TENANTS];	/* Tenants */
+	int nb_tenants;					/* Number of tenants */
+	double vtime;					/* Start tag of the last dequeued request */
+	uint64_t seq;					/* Next arrival number */
+	uint64_t queued;				/* Requests queued */
+	uint64_t last_ns;				/* Time of the last refill */
+};
+
+/*
+ * Add the tokens earned since the last refill, up to the bucket depths
+ *
+ * @q [in]: QoS layer
+ * @now_ns [in]: current time
+ */
+static void
+refill(struct qos *q, uint64_t now_ns)
+{
+	struct qos_tenant *t;
+	double dt;
+	int i;
+
+	if (now_ns <= q->last_ns)
+		return;
+	dt = (now_ns - q->last_ns) / 1e9;
+	q->last_ns = now_ns;
+	for (i = 0; i < q->nb_tenants; i++) {
+		t = &q->tenants[i];
+		if (t->cfg.bytes_rate > 0) {
+			t->bytes_tokens += t->cfg.bytes_rate * dt;
+			if (t->bytes_tokens > t->cfg.bytes_burst)
+				t->bytes_tokens = t->cfg.bytes_burst;
+		}
+		if (t->cfg.ops_rate > 0) {
+			t->ops_tokens += t->cfg.ops_rate * dt;
+			if (t->ops_tokens > t->cfg.ops_burst)
+				t->ops_tokens = t->cfg.ops_burst;
+		}
+	}
+}
+
+/*
+ * Check that both buckets of a tenant cover its head request
+ *
+ * @t [in]: tenant with a queued request
+ * @return: 1 if the head request may go and 0 otherwise
+ */
+static int
+eligible(const struct qos_tenant *t)
+{
+	if (t->cfg.bytes_rate > 0 && t->bytes_tokens < (double)t->head->len)
+		return 0;
+	if (t->cfg.ops_rate > 0 && t->ops_tokens < 1)
+		return 0;
+	return 1;
+}
+
+struct qos *
+qos_create(enum qos_policy policy, const struct qos_tenant_cfg *cfg, int nb_tenants, uint64_t now_ns)
+{
+	struct qos *q;
+	int i;
+
+	if (nb_tenants < 1 || nb_tenants > QOS_MAX_TENANTS)
+		return NULL;
+	for (i = 0; i < nb_tenants && policy == QOS_POLICY_WFQ; i++) {
+		if (cfg[i].weight == 0 || (cfg[i].bytes_rate > 0 && cfg[i].bytes_burst <= 0) ||
+		    (cfg[i].ops_rate > 0 && cfg[i].ops_burst < 1))
+			return NULL;
+	}
+
+	q = calloc(1, sizeof(*q));
+	if (q == NULL)
+		return NULL;
+	q->policy = policy;
+	q->nb_tenants = nb_tenants;
+	q->last_ns = now_ns;
+	for (i = 0; i < nb_tenants; i++) {
+		if (policy == QOS_POLICY_WFQ)
+			q->tenants[i].cfg = cfg[i];
+		else
+			q->tenants[i].cfg.weight = 1;
+		q->tenants[i].bytes_tokens = q->tenants[i].cfg.bytes_burst;
+		q->tenants[i].ops_tokens = q->tenants[i].cfg.ops_burst;
+	}
+	return q;
+}
+
+int
+qos_enqueue(struct qos *q, struct qos_req *req)
+{
+	struct qos_tenant *t;
+	double start;
+
+	if (req->tenant < 0 || req->tenant >= q->nb_tenants)
+		return -1;
+
+	t = &q->tenants[req->tenant];
+	start = t->last_finish > q->vtime ? t->last_finish : q->vtime;
+	req->finish = start + (double)req->len / t->cfg.weight;
+	t->last_finish = req->finish;
+	req->seq = q->seq++;
+	req->next = NULL;
+	if (t->tail != NULL)
+		t->tail->next = req;
+	else
+		t->head = req;
+	t->tail = req;
+	q->queued++;
+	return 0;
+}
+
+struct qos_req *
+qos_dequeue(struct qos *q, uint64_t now_ns)
+{
+	struct qos_tenant *t, *best = NULL;
+	struct qos_req *req;
+	int i;
+
+	if (q->queued == 0)
+		return NULL;
+
+	refill(q, now_ns);
+	for (i = 0; i < q->nb_tenants; i++) {
+		t = &q->tenants[i];
+		if (t->head == NULL)
+			continue;
+		if (q->policy == QOS_POLICY_FIFO) {
+			if (best == NULL || t->head->seq < best->head->seq)
+				best = t;
+			continue;
+		}
+		if (!eligible(t)) {
+			t->stats.throttled++;
+			continue;
+		}
+		if (best == NULL || t->head->finish < best->head->finish)
+			best = t;
+	}
+	if (best == NULL)
+		return NULL;
+
+	req = best->head;
+	best->head = req->next;
+	if (best->head == NULL)
+		best->tail = NULL;
+	q->queued--;
+	if (best->cfg.bytes_rate > 0)
+		best->bytes_tokens -= req->len;
+	if (best->cfg.ops_rate > 0)
+		best->ops_tokens -= 1;
+	/* The system virtual time follows the start tag of the request in service */
+	if (q->policy == QOS_POLICY_WFQ && req->finish - (double)req->len / best->cfg.weight > q->vtime)
+		q->vtime = req->finish - (double)req->len / best->cfg.weight;
+	best->stats.ops++;
+	best->stats.bytes += req->len;
+	return req;
+}
+
+uint64_t
+qos_queued(const struct qos *q)
+{
+	return q->queued;
+}
+
+void
+qos_get_stats(const struct qos *q, int tenant, struct qos_tenant_stats *stats)
+{
+	*stats = q->tenants[tenant].stats;
+}
+
+void
+qos_destroy(struct qos *q)
+{
+	free(q);
+}
@@ -0,0 +1,121 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+#ifndef DMA_QOS_H_
+#define DMA_QOS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Per-tenant DMA QoS
+ *
+ * Sits in front of task submission: tenants enqueue requests, and the submitter asks qos_dequeue() for the next
+ * request whenever the engine can take one. Every tenant has a token bucket on bytes/s and on ops/s, and a request
+ * is only eligible once both buckets hold enough tokens. Among the eligible tenants the one whose head request has
+ * the smallest weighted finish tag goes first (start-time fair queueing: a request starts at the larger of the
+ * system virtual time and the previous finish tag of its tenant, and finishes len / weight later). The FIFO policy
+ * ignores weights and buckets and serves requests in arrival order, as plain submission does. The layer does not
+ * know about DOCA.
+ */
+
+#define QOS_MAX_TENANTS 16	/* Largest number of tenants */
+
+/* Dequeue policy */
+enum qos_policy {
+	QOS_POLICY_FIFO,	/* Arrival order, no shaping */
+	QOS_POLICY_WFQ,		/* Token buckets and weighted fair queueing */
+};
+
+/* Configuration of one tenant */
+struct qos_tenant_cfg {
+	uint32_t weight;	/* Share of the engine relative to the other tenants, at least 1 */
+	double bytes_rate;	/* Bytes per second, 0 is unlimited */
+	double bytes_burst;	/* Bucket depth in bytes, at least the largest request of the tenant */
+	double ops_rate;	/* Requests per second, 0 is unlimited */
+	double ops_burst;	/* Bucket depth in requests, at least 1 */
+};
+
+/* One request, owned by the caller */
+struct qos_req {
+	size_t len;		/* Bytes the request moves */
+	int tenant;		/* Tenant index */
+	void *user;		/* Free for the caller */
+	/* QoS state */
+	uint64_t seq;		/* Arrival number */
+	double finish;		/* Weighted finish tag */
+	struct qos_req *next;	/* Tenant queue */
+};
+
+/* Per-tenant counters */
+struct qos_tenant_stats {
+	uint64_t ops;		/* Requests dequeued */
+	uint64_t bytes;		/* Bytes dequeued */
+	uint64_t throttled;	/* Dequeue attempts that found the head request without tokens */
+};
+
+struct qos;
+
+/*
+ * Create a QoS layer
+ *
+ * @policy [in]: dequeue policy
+ * @cfg [in]: configuration of every tenant, ignored by QOS_POLICY_FIFO
+ * @nb_tenants [in]: number of tenants
+ * @now_ns [in]: current time, the buckets start full
+ * @return: QoS layer, NULL on invalid arguments or allocation failure
+ */
+struct qos *qos_create(enum qos_policy policy, const struct qos_tenant_cfg *cfg, int nb_tenants, uint64_t now_ns);
+
+/*
+ * Queue a request behind the other requests of its tenant
+ *
+ * @q [in]: QoS layer
+ * @req [in]: request, len and tenant set
+ * @return: 0 on success and -1 for an unknown tenant
+ */
+int qos_enqueue(struct qos *q, struct qos_req *req);
+
+/*
+ * Take the next request to submit
+ *
+ * @q [in]: QoS layer
+ * @now_ns [in]: current time, refills the buckets
+ * @return: request, NULL if nothing is queued or no queued request is eligible yet
+ */
+struct qos_req *qos_dequeue(struct qos *q, uint64_t now_ns);
+
+/*
+ * Number of queued requests
+ *
+ * @q [in]: QoS layer
+ * @return: requests enqueued and not dequeued
+ */
+uint64_t qos_queued(const struct qos *q);
+
+/*
+ * Counters of a tenant
+ *
+ * @q [in]: QoS layer
+ * @tenant [in]: tenant index
+ * @stats [out]: counters
+ */
+void qos_get_stats(const struct qos *q, int tenant, struct qos_tenant_stats *stats);
+
+/*
+ * Destroy a QoS layer, queued requests stay owned by the caller
+ *
+ * @q [in]: QoS layer
+ */
+void qos_destroy(struct qos *q);
+
+#endif
@@ -0,0 +1,574 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <doca_buf.h>
+#include <doca_buf_inventory.h>
+#include <doca_ctx.h>
+#include <doca_dev.h>
+#include <doca_dma.h>
+#include <doca_error.h>
+#include <doca_log.h>
+#include <doca_mmap.h>
+#include <doca_pe.h>
+
+#include "dma_common.h"
+#include "dma_qos.h"
+
+DOCA_LOG_REGISTER(DMA_QOS_DPU);
+
+#define RECV_BUF_SIZE 256		/* Buffer which contains config information */
+#define MAX_DESC_SIZE 1024		/* Maximum size of the export descriptor */
+#define MAX_TENANTS 4			/* Tenants of a scenario */
+#define MAX_DEPTH 8			/* Largest number of requests a tenant keeps outstanding */
+#define TENANT_SLOT (1UL << 20)		/* Largest request, every tenant copies its own slot */
+#define ENGINE_DEPTH 4			/* Tasks handed to the DMA engine at the same time */
+#define RUN_NS 2000000000UL		/* Length of a scenario */
+#define LAT_SAMPLES 65536		/* Latency samples kept per tenant */
+
+/* Synthetic tenant: a closed loop of depth requests of one size */
+struct tenant_spec {
+	size_t size;			/* Request size */
+	int depth;			/* Requests kept queued or in flight */
+	struct qos_tenant_cfg cfg;	/* Weight and token buckets */
+};
+
+/* One scenario */
+struct scenario {
+	const char *name;			/* Scenario name */
+	enum qos_policy policy;			/* FIFO is plain submission */
+	int nb_tenants;				/* Number of tenants */
+	struct tenant_spec t[MAX_TENANTS];	/* Tenants */
+};
+
+#define BULK_64K(w) {65536, MAX_DEPTH, {w, 0, 0, 0, 0}}
+#define BULK_1M {TENANT_SLOT, MAX_DEPTH, {1, 0, 0, 0, 0}}
+#define PROBE {64, 1, {1, 0, 0, 0, 0}}
+
+static const struct scenario scenarios[] = {
+	/* Share of four backlogged tenants with weights 1:1:2:4 */
+	{"fifo-weights", QOS_POLICY_FIFO, 4, {BULK_64K(1), BULK_64K(1), BULK_64K(2), BULK_64K(4)}},
+	{"wfq-weights", QOS_POLICY_WFQ, 4, {BULK_64K(1), BULK_64K(1), BULK_64K(2), BULK_64K(4)}},
+	/* The heaviest tenant capped at 1 GB/s and 10 Kops/s */
+	{"wfq-ratelimit", QOS_POLICY_WFQ, 4,
+	 {{65536, MAX_DEPTH, {4, 1e9, TENANT_SLOT, 10000, MAX_DEPTH}}, BULK_64K(1), BULK_64K(1), BULK_64K(1)}},
+	/* Latency of a 64-byte tenant next to three 1 MB tenants */
+	{"fifo-isolation", QOS_POLICY_FIFO, 4, {PROBE, BULK_1M, BULK_1M, BULK_1M}},
+	{"wfq-isolation", QOS_POLICY_WFQ, 4, {PROBE, BULK_1M, BULK_1M, BULK_1M}},
+};
+#define NB_SCENARIOS (sizeof(scenarios) / sizeof(scenarios[0]))
+
+struct tenant_run;
+
+/* A request of a tenant */
+struct tenant_req {
+	struct qos_req q;		/* QoS request, q.user points back here */
+	struct tenant_run *tenant;	/* Owning tenant */
+	uint64_t enq_ns;		/* Time the request was queued */
+};
+
+/* Runtime state of one tenant */
+struct tenant_run {
+	const struct tenant_spec *spec;		/* Tenant specification */
+	char *src;				/* Host slot */
+	char *dst;				/* DPU slot */
+	struct tenant_req reqs[MAX_DEPTH];	/* Requests of the closed loop */
+	uint64_t ops;				/* Completed requests */
+	uint64_t bytes;				/* Completed bytes */
+	double lat_ns[LAT_SAMPLES];		/* First LAT_SAMPLES queue + DMA latencies */
+	uint64_t nb_lat;			/* Latency samples stored */
+};
+
+/* State of one scenario */
+struct qos_run {
+	struct qos *q;					/* QoS layer */
+	struct doca_dma *dma;				/* DMA context */
+	struct doca_buf_inventory *buf_inv;		/* Inventory */
+	struct doca_mmap *local_mmap;			/* DPU buffer mmap */
+	struct doca_mmap *remote_mmap;			/* Host buffer mmap */
+	struct tenant_run tenants[MAX_TENANTS];		/* Tenants */
+	uint32_t inflight;				/* Tasks in the engine */
+	int running;					/* Completed requests are queued again while set */
+	doca_error_t result;				/* First task error */
+};
+
+/*
+ * Saves export descriptor and buffer information content into memory buffers
+ *
+ * @export_desc_file_path [in]: Export descriptor file path
+ * @buffer_info_file_path [in]: Buffer information file path
+ * @export_desc [in]: Export descriptor buffer
+ * @export_desc_len [in]: Export descriptor buffer length
+ * @remote_addr [in]: Remote buffer address
+ * @remote_addr_len [in]: Remote buffer total length
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+save_config_info_to_buffers(const char *export_desc_file_path, const char *buffer_info_file_path, char *export_desc,
+			    size_t *export_desc_len, char **remote_addr, size_t *remote_addr_len)
+{
+	FILE *fp;
+	long file_size;
+	char buffer[RECV_BUF_SIZE];
+
+	fp = fopen(export_desc_file_path, "r");
+	if (fp == NULL) {
+		DOCA_LOG_ERR("Failed to open %s", export_desc_file_path);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	if (fseek(fp, 0, SEEK_END) != 0) {
+		DOCA_LOG_ERR("Failed to calculate file size");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	file_size = ftell(fp);
+	if (file_size == -1) {
+		DOCA_LOG_ERR("Failed to calculate file size");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	if (file_size > MAX_DESC_SIZE)
+		file_size = MAX_DESC_SIZE;
+
+	*export_desc_len = file_size;
+
+	if (fseek(fp, 0L, SEEK_SET) != 0) {
+		DOCA_LOG_ERR("Failed to calculate file size");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	if (fread(export_desc, 1, file_size, fp) != (size_t)file_size) {
+		DOCA_LOG_ERR("Failed to read the export descriptor");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	fclose(fp);
+
+	/* Read source buffer information from file */
+	fp = fopen(buffer_info_file_path, "r");
+	if (fp == NULL) {
+		DOCA_LOG_ERR("Failed to open %s", buffer_info_file_path);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	/* Get source buffer address */
+	if (fgets(buffer, RECV_BUF_SIZE, fp) == NULL) {
+		DOCA_LOG_ERR("Failed to read the source (host) buffer address");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+	*remote_addr = (char *)strtoull(buffer, NULL, 0);
+
+	memset(buffer, 0, RECV_BUF_SIZE);
+
+	/* Get source buffer length */
+	if (fgets(buffer, RECV_BUF_SIZE, fp) == NULL) {
+		DOCA_LOG_ERR("Failed to read the source (host) buffer length");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+	*remote_addr_len = strtoull(buffer, NULL, 0);
+
+	fclose(fp);
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Current time
+ *
+ * @return: CLOCK_MONOTONIC in nanoseconds
+ */
+static uint64_t
+now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000UL + ts.tv_nsec;
+}
+
+/*
+ * Account for a finished request and queue it again while the scenario runs
+ *
+ * @dma_task [in]: finished task, freed here
+ * @req [in]: request of the task
+ * @run [in]: scenario state
+ * @status [in]: status of the task
+ */
+static void
+request_finished(struct doca_dma_task_memcpy *dma_task, struct tenant_req *req, struct qos_run *run,
+		 doca_error_t status)
+{
+	struct tenant_run *t = req->tenant;
+	uint64_t now = now_ns();
+
+	doca_buf_dec_refcount((struct doca_buf *)doca_dma_task_memcpy_get_src(dma_task), NULL);
+	doca_buf_dec_refcount(doca_dma_task_memcpy_get_dst(dma_task), NULL);
+	doca_task_free(doca_dma_task_memcpy_as_task(dma_task));
+	run->inflight--;
+
+	if (status != DOCA_SUCCESS) {
+		if (run->result == DOCA_SUCCESS)
+			run->result = status;
+		return;
+	}
+	t->ops++;
+	t->bytes += req->q.len;
+	if (t->nb_lat < LAT_SAMPLES)
+		t->lat_ns[t->nb_lat++] = now - req->enq_ns;
+
+	if (run->running) {
+		req->enq_ns = now;
+		(void)qos_enqueue(run->q, &req->q);
+	}
+}
+
+/*
+ * Tenant request completed callback
+ *
+ * @dma_task [in]: Completed task
+ * @task_user_data [in]: doca_data from the task, the request
+ * @ctx_user_data [in]: doca_data from the context, the scenario
+ */
+static void
+qos_completed_callback(struct doca_dma_task_memcpy *dma_task, union doca_data task_user_data,
+		       union doca_data ctx_user_data)
+{
+	request_finished(dma_task, task_user_data.ptr, ctx_user_data.ptr, DOCA_SUCCESS);
+}
+
+/*
+ * Tenant request error callback
+ *
+ * @dma_task [in]: failed task
+ * @task_user_data [in]: doca_data from the task, the request
+ * @ctx_user_data [in]: doca_data from the context, the scenario
+ */
+static void
+qos_error_callback(struct doca_dma_task_memcpy *dma_task, union doca_data task_user_data,
+		   union doca_data ctx_user_data)
+{
+	request_finished(dma_task, task_user_data.ptr, ctx_user_data.ptr,
+			 doca_task_get_status(doca_dma_task_memcpy_as_task(dma_task)));
+}
+
+/*
+ * Hand one dequeued request to the DMA engine
+ *
+ * @run [in]: scenario state
+ * @req [in]: request
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+submit_request(struct qos_run *run, struct tenant_req *req)
+{
+	struct tenant_run *t = req->tenant;
+	struct doca_buf *src = NULL, *dst = NULL;
+	struct doca_dma_task_memcpy *task;
+	union doca_data data = {.ptr = req};
+	doca_error_t result;
+
+	result = doca_buf_inventory_buf_get_by_addr(run->buf_inv, run->remote_mmap, t->src, req->q.len, &src);
+	if (result == DOCA_SUCCESS)
+		result = doca_buf_set_data(src, t->src, req->q.len);
+	if (result == DOCA_SUCCESS)
+		result = doca_buf_inventory_buf_get_by_addr(run->buf_inv, run->local_mmap, t->dst, req->q.len, &dst);
+	if (result == DOCA_SUCCESS)
+		result = doca_dma_task_memcpy_alloc_init(run->dma, src, dst, data, &task);
+	if (result == DOCA_SUCCESS) {
+		result = doca_task_submit(doca_dma_task_memcpy_as_task(task));
+		if (result != DOCA_SUCCESS)
+			doca_task_free(doca_dma_task_memcpy_as_task(task));
+	}
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to submit a request: %s", doca_error_get_descr(result));
+		if (src != NULL)
+			doca_buf_dec_refcount(src, NULL);
+		if (dst != NULL)
+			doca_buf_dec_refcount(dst, NULL);
+		return result;
+	}
+	run->inflight++;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Compare two doubles for qsort
+ *
+ * @a [in]: first value
+ * @b [in]: second value
+ * @return: <0, 0 or >0
+ */
+static int
+cmp_double(const void *a, const void *b)
+{
+	double x = *(const double *)a, y = *(const double *)b;
+
+	return (x > y) - (x < y);
+}
+
+/*
+ * Print the achieved share, throughput and latency of every tenant
+ *
+ * @sc [in]: scenario
+ * @run [in]: finished scenario
+ * @elapsed [in]: scenario length in nanoseconds
+ */
+static void
+report(const struct scenario *sc, struct qos_run *run, double elapsed)
+{
+	const struct tenant_spec *spec;
+	struct tenant_run *t;
+	uint64_t total_bytes = 0, total_weight = 0;
+	char limit[32];
+	int i;
+
+	for (i = 0; i < sc->nb_tenants; i++) {
+		total_bytes += run->tenants[i].bytes;
+		total_weight += sc->t[i].cfg.weight;
+	}
+
+	printf("Scenario %s (%s), %d tenants, engine depth %d\n", sc->name,
+	       sc->policy == QOS_POLICY_WFQ ? "token buckets + WFQ" : "FIFO", sc->nb_tenants, ENGINE_DEPTH);
+	printf("Tenant\t Size\t\t Weight\t Limit\t\t Share(%%)\t Weighted(%%)\t GB/s\t\t Kops/s\t\t p50(us)\t p99(us)\n");
+	for (i = 0; i < sc->nb_tenants; i++) {
+		spec = &sc->t[i];
+		t = &run->tenants[i];
+		qsort(t->lat_ns, t->nb_lat, sizeof(double), cmp_double);
+		if (spec->cfg.bytes_rate > 0 || spec->cfg.ops_rate > 0)
+			snprintf(limit, sizeof(limit), "%.2fGB/s,%.0fKops", spec->cfg.bytes_rate / 1e9,
+				 spec->cfg.ops_rate / 1e3);
+		else
+			snprintf(limit, sizeof(limit), "-");
+		printf("%d\t %-10zu\t %u\t %-14s\t %8.2f\t %11.2f\t %8.3f\t %8.2f\t %8.2f\t %8.2f\n", i, spec->size,
+		       spec->cfg.weight, limit, total_bytes ? 100.0 * t->bytes / total_bytes : 0,
+		       100.0 * spec->cfg.weight / total_weight, t->bytes / elapsed, t->ops / elapsed * 1e6,
+		       t->nb_lat ? t->lat_ns[t->nb_lat / 2] / 1000 : 0,
+		       t->nb_lat ? t->lat_ns[t->nb_lat * 99 / 100] / 1000 : 0);
+	}
+	printf("\n");
+	fflush(stdout);
+}
+
+/*
+ * Run one scenario on a fresh DMA context
+ *
+ * @sc [in]: scenario
+ * @dev [in]: DOCA device
+ * @pe [in]: progress engine
+ * @run [in]: scenario state, buf_inv and mmaps set
+ * @local [in]: DPU buffer
+ * @remote [in]: host buffer
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+run_scenario(const struct scenario *sc, struct doca_dev *dev, struct doca_pe *pe, struct qos_run *run, char *local,
+	     char *remote)
+{
+	struct qos_tenant_cfg cfg[MAX_TENANTS];
+	struct tenant_req *req;
+	struct qos_req *next;
+	union doca_data data = {.ptr = run};
+	doca_error_t result, tmp_result;
+	uint64_t start, now;
+	int i, d;
+
+	memset(run->tenants, 0, sizeof(run->tenants));
+	run->inflight = 0;
+	run->result = DOCA_SUCCESS;
+	run->dma = NULL;
+
+	for (i = 0; i < sc->nb_tenants; i++)
+		cfg[i] = sc->t[i].cfg;
+	run->q = qos_create(sc->policy, cfg, sc->nb_tenants, now_ns());
+	if (run->q == NULL) {
+		DOCA_LOG_ERR("Invalid QoS configuration in scenario %s", sc->name);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	result = doca_dma_create(dev, &run->dma);
+	if (result == DOCA_SUCCESS)
+		result = doca_dma_task_memcpy_set_conf(run->dma, qos_completed_callback, qos_error_callback,
+						       ENGINE_DEPTH);
+	if (result == DOCA_SUCCESS)
+		result = doca_ctx_set_user_data(doca_dma_as_ctx(run->dma), data);
+	if (result == DOCA_SUCCESS)
+		result = doca_pe_connect_ctx(pe, doca_dma_as_ctx(run->dma));
+	if (result == DOCA_SUCCESS)
+		result = doca_ctx_start(doca_dma_as_ctx(run->dma));
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start DMA context: %s", doca_error_get_descr(result));
+		if (run->dma != NULL)
+			doca_dma_destroy(run->dma);
+		qos_destroy(run->q);
+		return result;
+	}
+
+	/* Every tenant starts with its whole closed loop queued */
+	start = now_ns();
+	for (i = 0; i < sc->nb_tenants; i++) {
+		run->tenants[i].spec = &sc->t[i];
+		run->tenants[i].src = remote + i * TENANT_SLOT;
+		run->tenants[i].dst = local + i * TENANT_SLOT;
+		for (d = 0; d < sc->t[i].depth; d++) {
+			req = &run->tenants[i].reqs[d];
+			req->q.len = sc->t[i].size;
+			req->q.tenant = i;
+			req->q.user = req;
+			req->tenant = &run->tenants[i];
+			req->enq_ns = start;
+			(void)qos_enqueue(run->q, &req->q);
+		}
+	}
+
+	run->running = 1;
+	do {
+		now = now_ns();
+		while (run->inflight < ENGINE_DEPTH && (next = qos_dequeue(run->q, now)) != NULL) {
+			result = submit_request(run, next->user);
+			if (result != DOCA_SUCCESS)
+				break;
+		}
+		(void)doca_pe_progress(pe);
+	} while (result == DOCA_SUCCESS && run->result == DOCA_SUCCESS && now - start < RUN_NS);
+	run->running = 0;
+	DOCA_ERROR_PROPAGATE(result, run->result);
+
+	while (run->inflight > 0)
+		(void)doca_pe_progress(pe);
+	if (result == DOCA_SUCCESS)
+		report(sc, run, now - start);
+
+	tmp_result = request_stop_ctx(pe, doca_dma_as_ctx(run->dma));
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	tmp_result = doca_dma_destroy(run->dma);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	qos_destroy(run->q);
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Scenario %s failed: %s", sc->name, doca_error_get_descr(result));
+	return result;
+}
+
+/*
+ * Run DOCA DMA per-tenant QoS benchmark on the DPU
+ *
+ * @export_desc_file_path [in]: Export descriptor file path
+ * @buffer_info_file_path [in]: Buffer info file path
+ * @pcie_addr [in]: Device PCI address
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t
+dma_qos_dpu(const char *export_desc_file_path, const char *buffer_info_file_path, const char *pcie_addr)
+{
+	static struct qos_run run;
+	struct doca_dev *dev;
+	struct doca_pe *pe = NULL;
+	char export_desc[MAX_DESC_SIZE];
+	size_t export_desc_len, remote_len;
+	char *local = NULL, *remote;
+	doca_error_t result, tmp_result;
+	size_t s;
+
+	result = save_config_info_to_buffers(export_desc_file_path, buffer_info_file_path, export_desc,
+					     &export_desc_len, &remote, &remote_len);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to read memory configuration from file: %s", doca_error_get_descr(result));
+		return result;
+	}
+	if (remote_len < MAX_TENANTS * TENANT_SLOT) {
+		DOCA_LOG_ERR("Host buffer must hold at least %lu bytes", MAX_TENANTS * TENANT_SLOT);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	result = open_doca_device_with_pci(pcie_addr, &dma_task_is_supported, &dev);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to open DOCA device: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	local = calloc(MAX_TENANTS, TENANT_SLOT);
+	if (local == NULL) {
+		DOCA_LOG_ERR("Failed to allocate the DPU buffer");
+		result = DOCA_ERROR_NO_MEMORY;
+		goto destroy_objects;
+	}
+
+	result = doca_mmap_create(&run.local_mmap);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_add_dev(run.local_mmap, dev);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_set_memrange(run.local_mmap, local, MAX_TENANTS * TENANT_SLOT);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_start(run.local_mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start local mmap: %s", doca_error_get_descr(result));
+		goto destroy_objects;
+	}
+
+	result = doca_mmap_create_from_export(NULL, export_desc, export_desc_len, dev, &run.remote_mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create mmap from export: %s", doca_error_get_descr(result));
+		goto destroy_objects;
+	}
+
+	result = doca_buf_inventory_create(2 * ENGINE_DEPTH, &run.buf_inv);
+	if (result == DOCA_SUCCESS)
+		result = doca_buf_inventory_start(run.buf_inv);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start buffer inventory: %s", doca_error_get_descr(result));
+		goto destroy_objects;
+	}
+
+	result = doca_pe_create(&pe);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create progress engine: %s", doca_error_get_descr(result));
+		goto destroy_objects;
+	}
+
+	for (s = 0; s < NB_SCENARIOS && result == DOCA_SUCCESS; s++)
+		result = run_scenario(&scenarios[s], dev, pe, &run, local, remote);
+
+destroy_objects:
+	if (pe != NULL) {
+		tmp_result = doca_pe_destroy(pe);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+	if (run.buf_inv != NULL) {
+		tmp_result = doca_buf_inventory_stop(run.buf_inv);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+		tmp_result = doca_buf_inventory_destroy(run.buf_inv);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+	if (run.remote_mmap != NULL) {
+		tmp_result = doca_mmap_destroy(run.remote_mmap);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+	if (run.local_mmap != NULL) {
+		tmp_result = doca_mmap_destroy(run.local_mmap);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+	free(local);
+	tmp_result = doca_dev_close(dev);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	return result;
+}
@@ -0,0 +1,369 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "dma_replay.h"
+
+#define MAX_LINE 512		/* Longest trace line */
+#define LATE_NS 10000		/* A DMA issued this much after its intended time counts as late */
+
+struct replay {
+	struct replay_trace *trace;	/* Replayed trace */
+	enum replay_mode mode;		/* Issue timing */
+	double speed;			/* Trace time divisor in timed mode */
+	size_t cursor;			/* Next DMA whose intended time has not been reached */
+	int64_t ready_head;		/* Oldest eligible DMA */
+	int64_t ready_tail;		/* Newest eligible DMA */
+	size_t completed;		/* Completed DMAs */
+};
+
+int
+replay_trace_load(const char *path, struct replay_trace *trace)
+{
+	char line[MAX_LINE], dir[16], dep[32], *hash, *end;
+	struct replay_op *op, *ops;
+	size_t capacity = 0, lineno = 0;
+	uint64_t last_ns = 0;
+	double t_us;
+	FILE *fp;
+	int n;
+
+	memset(trace, 0, sizeof(*trace));
+	fp = fopen(path, "r");
+	if (fp == NULL) {
+		fprintf(stderr, "Failed to open trace %s\n", path);
+		return -1;
+	}
+
+	while (fgets(line, sizeof(line), fp) != NULL) {
+		lineno++;
+		hash = strchr(line, '#');
+		if (hash != NULL)
+			*hash = '\0';
+		strcpy(dep, "-");
+		if (trace->nb_ops == capacity) {
+			capacity = capacity ? 2 * capacity : 1024;
+			ops = realloc(trace->ops, capacity * sizeof(*ops));
+			if (ops == NULL) {
+				fprintf(stderr, "Failed to allocate %zu trace entries\n", capacity);
+				goto error;
+			}
+			trace->ops = ops;
+		}
+		op = &trace->ops[trace->nb_ops];
+		memset(op, 0, sizeof(*op));
+
+		n = sscanf(line, "%lf %15s %zu %zu %31s", &t_us, dir, &op->size, &op->offset, dep);
+		if (n <= 0)
+			continue;
+		if (n < 4) {
+			fprintf(stderr, "%s:%zu: expected <time_us> <r|w> <size> <offset> [<dep>]\n", path, lineno);
+			goto error;
+		}
+		if (t_us < 0 || (uint64_t)(t_us * 1000) < last_ns) {
+			fprintf(stderr, "%s:%zu: times must be positive and sorted\n", path, lineno);
+			goto error;
+		}
+		op->t_ns = last_ns = (uint64_t)(t_us * 1000);
+
+		if (strcmp(dir, "r") == 0 || strcmp(dir, "read") == 0)
+			op->dir = REPLAY_READ;
+		else if (strcmp(dir, "w") == 0 || strcmp(dir, "write") == 0)
+			op->dir = REPLAY_WRITE;
+		else {
+			fprintf(stderr, "%s:%zu: unknown direction %s\n", path, lineno, dir);
+			goto error;
+		}
+
+		if (op->size == 0 || op->offset + op->size < op->offset) {
+			fprintf(stderr, "%s:%zu: invalid size or offset\n", path, lineno);
+			goto error;
+		}
+
+		op->dep = -1;
+		if (strcmp(dep, "-") != 0) {
+			op->dep = strtoll(dep, &end, 0);
+			if (*end != '\0' || op->dep < 0 || (size_t)op->dep >= trace->nb_ops) {
+				fprintf(stderr, "%s:%zu: dependency %s is not an earlier DMA\n", path, lineno, dep);
+				goto error;
+			}
+		}
+
+		if (op->offset + op->size > trace->span)
+			trace->span = op->offset + op->size;
+		if (op->size > trace->max_size)
+			trace->max_size = op->size;
+		trace->bytes += op->size;
+		trace->nb_ops++;
+	}
+
+	fclose(fp);
+	if (trace->nb_ops == 0) {
+		fprintf(stderr, "Trace %s holds no DMAs\n", path);
+		replay_trace_free(trace);
+		return -1;
+	}
+	return 0;
+
+error:
+	fclose(fp);
+	replay_trace_free(trace);
+	return -1;
+}
+
+void
+replay_trace_free(struct replay_trace *trace)
+{
+	free(trace->ops);
+	memset(trace, 0, sizeof(*trace));
+}
+
+struct replay *
+replay_create(struct replay_trace *trace, enum replay_mode mode, double speed)
+{
+	struct replay *r;
+	size_t i;
+
+	if (speed <= 0)
+		return NULL;
+	r = calloc(1, sizeof(*r));
+	if (r == NULL)
+		return NULL;
+	r->trace = trace;
+	r->mode = mode;
+	r->speed = speed;
+	r->ready_head = r->ready_tail = -1;
+
+	for (i = 0; i < trace->nb_ops; i++) {
+		struct replay_op *op = &trace->ops[i];
+
+		op->intended_ns = mode == REPLAY_TIMED ? (uint64_t)(op->t_ns / speed) : 0;
+		op->issue_ns = op->done_ns = 0;
+		op->next = op->waiters = -1;
+		op->dep_stalled = op->done = 0;
+	}
+	return r;
+}
+
+/*
+ * Append a DMA to the ready queue
+ *
+ * @r [in]: replay
+ * @op [in]: index of the DMA
+ */
+static void
+ready_push(struct replay *r, int64_t op)
+{
+	r->trace->ops[op].next = -1;
+	if (r->ready_tail < 0)
+		r->ready_head = op;
+	else
+		r->trace->ops[r->ready_tail].next = op;
+	r->ready_tail = op;
+}
+
+int64_t
+replay_next(struct replay *r, uint64_t now_ns)
+{
+	struct replay_op *ops = r->trace->ops, *op, *dep;
+	int64_t next;
+
+	/* Release every DMA whose time has come, to the ready queue or to the wait list of its dependency */
+	while (r->cursor < r->trace->nb_ops && ops[r->cursor].intended_ns <= now_ns) {
+		op = &ops[r->cursor];
+		if (op->dep >= 0 && !ops[op->dep].done) {
+			dep = &ops[op->dep];
+			op->dep_stalled = 1;
+			op->next = dep->waiters;
+			dep->waiters = r->cursor;
+		} else {
+			ready_push(r, r->cursor);
+		}
+		r->cursor++;
+	}
+
+	next = r->ready_head;
+	if (next < 0)
+		return -1;
+	r->ready_head = ops[next].next;
+	if (r->ready_head < 0)
+		r->ready_tail = -1;
+	ops[next].issue_ns = now_ns;
+	return next;
+}
+
+void
+replay_complete(struct replay *r, int64_t op, uint64_t now_ns)
+{
+	struct replay_op *ops = r->trace->ops;
+	int64_t w, next, reversed = -1;
+
+	ops[op].done = 1;
+	ops[op].done_ns = now_ns;
+	r->completed++;
+
+	/* Waiters were pushed newest first, hand them to the ready queue in trace order */
+	for (w = ops[op].waiters; w >= 0; w = next) {
+		next = ops[w].next;
+		ops[w].next = reversed;
+		reversed = w;
+	}
+	for (w = reversed; w >= 0; w = next) {
+		next = ops[w].next;
+		ready_push(r, w);
+	}
+	ops[op].waiters = -1;
+}
+
+int
+replay_finished(const struct replay *r)
+{
+	return r->completed == r->trace->nb_ops;
+}
+
+/*
+ * Compare two doubles for qsort
+ *
+ * @a [in]: first value
+ * @b [in]: second value
+ * @return: <0, 0 or >0
+ */
+static int
+cmp_double(const void *a, const void *b)
+{
+	double x = *(const double *)a, y = *(const double *)b;
+
+	return (x > y) - (x < y);
+}
+
+/*
+ * Sort samples and print count, min, percentiles, max and mean in microseconds
+ *
+ * @name [in]: row name
+ * @v [in]: samples in nanoseconds, sorted in place
+ * @n [in]: number of samples
+ * @pct [out]: p50, p99 and p99.9 in microseconds, may be NULL
+ */
+static void
+print_row(const char *name, double *v, size_t n, double pct[3])
+{
+	double sum = 0;
+	size_t i;
+
+	if (n == 0) {
+		printf("%-12s %10d %10s %10s %10s %10s %10s %10s %10s\n", name, 0, "-", "-", "-", "-", "-", "-", "-");
+		if (pct != NULL)
+			pct[0] = pct[1] = pct[2] = 0;
+		return;
+	}
+	qsort(v, n, sizeof(double), cmp_double);
+	for (i = 0; i < n; i++)
+		sum += v[i];
+	printf("%-12s %10zu %10.2f %10.2f %10.2f %10.2f %10.2f %10.2f %10.2f\n", name, n, v[0] / 1000,
+	       v[n / 2] / 1000, v[n * 90 / 100] / 1000, v[n * 99 / 100] / 1000, v[n * 999 / 1000] / 1000,
+	       v[n - 1] / 1000, sum / n / 1000);
+	if (pct != NULL) {
+		pct[0] = v[n / 2] / 1000;
+		pct[1] = v[n * 99 / 100] / 1000;
+		pct[2] = v[n * 999 / 1000] / 1000;
+	}
+}
+
+void
+replay_report(const struct replay *r, uint64_t elapsed_ns)
+{
+	const struct replay_trace *trace = r->trace;
+	const struct replay_op *op;
+	double *all, *reads, *writes, *on_time, *stalled, lat[3], lag[3] = {0, 0, 0};
+	size_t nb_reads = 0, nb_writes = 0, nb_on_time = 0, nb_stalled = 0, late = 0, i;
+	double trace_ns = trace->ops[trace->nb_ops - 1].intended_ns;
+
+	all = calloc(5 * trace->nb_ops, sizeof(double));
+	if (all == NULL) {
+		fprintf(stderr, "Failed to allocate the report\n");
+		return;
+	}
+	reads = all + trace->nb_ops;
+	writes = reads + trace->nb_ops;
+	on_time = writes + trace->nb_ops;
+	stalled = on_time + trace->nb_ops;
+
+	for (i = 0; i < trace->nb_ops; i++) {
+		op = &trace->ops[i];
+		all[i] = op->done_ns - op->issue_ns;
+		if (op->dir == REPLAY_READ)
+			reads[nb_reads++] = all[i];
+		else
+			writes[nb_writes++] = all[i];
+		if (op->dep_stalled)
+			stalled[nb_stalled++] = op->issue_ns - op->intended_ns;
+		else
+			on_time[nb_on_time++] = op->issue_ns - op->intended_ns;
+		if (op->issue_ns - op->intended_ns > LATE_NS)
+			late++;
+	}
+
+	printf("Replayed %zu DMAs (%zu reads, %zu writes, %lu bytes) %s", trace->nb_ops, nb_reads, nb_writes,
+	       trace->bytes, r->mode == REPLAY_TIMED ? "with the trace timing" : "as fast as possible");
+	if (r->mode == REPLAY_TIMED && r->speed != 1)
+		printf(" at %.2fx speed", r->speed);
+	printf("\n");
+	printf("Elapsed %.3f ms, %.3f GB/s", elapsed_ns / 1e6, trace->bytes / (double)elapsed_ns);
+	if (r->mode == REPLAY_TIMED)
+		printf("; trace %.3f ms, offered %.3f GB/s", trace_ns / 1e6,
+		       trace_ns > 0 ? trace->bytes / trace_ns : 0.0);
+	printf("\n\n");
+
+	printf("%-12s %10s %10s %10s %10s %10s %10s %10s %10s\n", "latency(us)", "count", "min", "p50", "p90", "p99",
+	       "p99.9", "max", "mean");
+	print_row("all", all, trace->nb_ops, lat);
+	print_row("read", reads, nb_reads, NULL);
+	print_row("write", writes, nb_writes, NULL);
+
+	/* Lag only means something against the trace timing; waits for a dependency are shown on their own */
+	if (r->mode == REPLAY_TIMED) {
+		printf("\n%-12s %10s %10s %10s %10s %10s %10s %10s %10s\n", "lag(us)", "count", "min", "p50", "p90",
+		       "p99", "p99.9", "max", "mean");
+		print_row("no-dep-wait", on_time, nb_on_time, lag);
+		print_row("dep-wait", stalled, nb_stalled, NULL);
+		printf("%zu DMAs (%.2f%%) issued more than %d us late, elapsed/trace time %.3f\n", late,
+		       100.0 * late / trace->nb_ops, LATE_NS / 1000, trace_ns > 0 ? elapsed_ns / trace_ns : 0.0);
+	}
+
+	/* One line per replay for comparing firmware and DOCA versions */
+	printf("REPLAY %s %zu %.3f %.3f %.2f %.2f %.2f %.2f %.2f %.2f\n\n", r->mode == REPLAY_TIMED ? "timed" : "afap",
+	       trace->nb_ops, elapsed_ns / 1e6, trace->bytes / (double)elapsed_ns, lat[0], lat[1], lat[2], lag[0],
+	       lag[1], r->mode == REPLAY_TIMED ? 100.0 * late / trace->nb_ops : 0.0);
+	fflush(stdout);
+	free(all);
+}
+
+void
+replay_write_csv(const struct replay *r, FILE *out)
+{
+	const struct replay_op *op;
+	size_t i;
+
+	fprintf(out, "index,dir,size,offset,dep,intended_us,issue_us,done_us\n");
+	for (i = 0; i < r->trace->nb_ops; i++) {
+		op = &r->trace->ops[i];
+		fprintf(out, "%zu,%c,%zu,%zu,%ld,%.3f,%.3f,%.3f\n", i, op->dir == REPLAY_READ ? 'r' : 'w', op->size,
+			op->offset, (long)op->dep, op->intended_ns / 1e3, op->issue_ns / 1e3, op->done_ns / 1e3);
+	}
+}
+
+void
+replay_destroy(struct replay *r)
+{
+	free(r);
+}
@@ -0,0 +1,152 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+#ifndef DMA_REPLAY_H_
+#define DMA_REPLAY_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/*
+ * Trace-driven DMA replay
+ *
+ * A trace is a text file with one DMA per line:
+ *
+ *	<time_us> <r|w> <size> <offset> [<dep>]
+ *
+ * time_us is the issue time relative to the start of the trace, and lines must be sorted by it. r reads size bytes
+ * at offset of the remote buffer into the same offset of the local buffer and w writes them back. dep is the line
+ * number (0-based, counting only DMA lines) of an earlier DMA that must complete before this one is issued, or -.
+ * Blank lines and everything after # are ignored.
+ *
+ * The replay layer decides when each DMA is issued and collects the timing; it does not know about DOCA. In timed
+ * mode a DMA becomes eligible at its trace time (divided by the speed factor), in as-fast-as-possible mode right
+ * away, and in both modes not before its dependency completed. Eligible DMAs are issued in trace order, except that
+ * a DMA waiting for its dependency does not hold back later independent ones.
+ */
+
+/* Direction of a DMA, seen from the initiator */
+enum replay_dir {
+	REPLAY_READ,	/* Remote to local buffer */
+	REPLAY_WRITE,	/* Local to remote buffer */
+};
+
+/* Issue timing */
+enum replay_mode {
+	REPLAY_TIMED,	/* Original inter-arrival times */
+	REPLAY_AFAP,	/* As fast as possible */
+};
+
+/* One DMA of a trace */
+struct replay_op {
+	uint64_t t_ns;		/* Issue time in the trace */
+	size_t size;		/* Bytes */
+	size_t offset;		/* Offset into both buffers */
+	int64_t dep;		/* DMA that must complete first, -1 for none */
+	enum replay_dir dir;	/* Direction */
+	/* Replay state, times relative to the start of the replay */
+	uint64_t intended_ns;	/* Time the DMA should have been issued */
+	uint64_t issue_ns;	/* Time the DMA was issued */
+	uint64_t done_ns;	/* Time the DMA completed */
+	int64_t next;		/* Ready queue or dependency wait list */
+	int64_t waiters;	/* First DMA waiting for this one */
+	int dep_stalled;	/* The dependency was not complete at the intended time */
+	int done;		/* Completed */
+};
+
+/* A loaded trace */
+struct replay_trace {
+	struct replay_op *ops;	/* DMAs in trace order */
+	size_t nb_ops;		/* Number of DMAs */
+	size_t span;		/* Largest offset + size, the buffers must be at least this long */
+	size_t max_size;	/* Largest DMA */
+	uint64_t bytes;		/* Bytes of all DMAs */
+};
+
+struct replay;
+
+/*
+ * Load a trace file
+ *
+ * @path [in]: trace file
+ * @trace [out]: loaded trace, released with replay_trace_free()
+ * @return: 0 on success and -1 on a read or syntax error, reported on stderr with the line number
+ */
+int replay_trace_load(const char *path, struct replay_trace *trace);
+
+/*
+ * Release a loaded trace
+ *
+ * @trace [in]: trace
+ */
+void replay_trace_free(struct replay_trace *trace);
+
+/*
+ * Start a replay, resets the replay state of every DMA
+ *
+ * @trace [in]: trace, must outlive the replay
+ * @mode [in]: issue timing
+ * @speed [in]: trace time is divided by this factor in timed mode, 1 replays the original rate
+ * @return: replay, NULL on allocation failure
+ */
+struct replay *replay_create(struct replay_trace *trace, enum replay_mode mode, double speed);
+
+/*
+ * Take the next DMA to issue and mark it issued
+ *
+ * @r [in]: replay
+ * @now_ns [in]: time since the start of the replay
+ * @return: index of the DMA, -1 if no DMA is eligible yet
+ */
+int64_t replay_next(struct replay *r, uint64_t now_ns);
+
+/*
+ * Mark a DMA completed, DMAs that waited for it become eligible
+ *
+ * @r [in]: replay
+ * @op [in]: index of the DMA
+ * @now_ns [in]: time since the start of the replay
+ */
+void replay_complete(struct replay *r, int64_t op, uint64_t now_ns);
+
+/*
+ * Check whether every DMA completed
+ *
+ * @r [in]: replay
+ * @return: 1 if the replay is finished and 0 otherwise
+ */
+int replay_finished(const struct replay *r);
+
+/*
+ * Print latency percentiles and the achieved against the intended timing of a finished replay
+ *
+ * @r [in]: finished replay
+ * @elapsed_ns [in]: length of the replay
+ */
+void replay_report(const struct replay *r, uint64_t elapsed_ns);
+
+/*
+ * Write one CSV line per DMA: index, direction, size, intended, issue and completion time in microseconds
+ *
+ * @r [in]: finished replay
+ * @out [in]: output file
+ */
+void replay_write_csv(const struct replay *r, FILE *out);
+
+/*
+ * Destroy a replay, the trace keeps the timing of the last replay
+ *
+ * @r [in]: replay
+ */
+void replay_destroy(struct replay *r);
+
+#endif
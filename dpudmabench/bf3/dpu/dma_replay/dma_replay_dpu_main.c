@@ -0,0 +1,287 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <doca_argp.h>
+#include <doca_log.h>
+
+#include "dma_common.h"
+#include "dma_replay.h"
+
+DOCA_LOG_REGISTER(DMA_REPLAY_DPU::MAIN);
+
+#define MAX_REPLAY_DEPTH 1024	/* Largest engine depth */
+
+/* Configuration struct, dma_conf comes first so the dma_common ARGP callbacks can use it */
+struct replay_config {
+	struct dma_config dma_conf;	/* Device and host buffer */
+	char trace_path[MAX_ARG_SIZE];	/* Trace file */
+	enum replay_mode mode;		/* Issue timing */
+	double speed;			/* Trace time divisor in timed mode */
+	uint32_t depth;			/* Largest number of DMAs in the engine */
+	char csv_path[MAX_ARG_SIZE];	/* Per-DMA timing output, empty for none */
+};
+
+/* Sample's Logic */
+doca_error_t dma_replay_dpu(const char *trace_path, enum replay_mode mode, double speed, uint32_t depth,
+			    const char *csv_path, const char *export_desc_file_path, const char *buffer_info_file_path,
+			    const char *pcie_addr);
+
+/*
+ * ARGP Callback - Handle trace file parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+trace_file_callback(void *param, void *config)
+{
+	struct replay_config *conf = (struct replay_config *)config;
+	const char *path = (char *)param;
+
+	if (strnlen(path, MAX_ARG_SIZE) == MAX_ARG_SIZE) {
+		DOCA_LOG_ERR("Trace path is too long - MAX=%d", MAX_USER_ARG_SIZE);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	strcpy(conf->trace_path, path);
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle mode parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+mode_callback(void *param, void *config)
+{
+	struct replay_config *conf = (struct replay_config *)config;
+	const char *mode = (char *)param;
+
+	if (strcmp(mode, "timed") == 0)
+		conf->mode = REPLAY_TIMED;
+	else if (strcmp(mode, "afap") == 0)
+		conf->mode = REPLAY_AFAP;
+	else {
+		DOCA_LOG_ERR("Unknown mode %s, expected timed or afap", mode);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle speed parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+speed_callback(void *param, void *config)
+{
+	struct replay_config *conf = (struct replay_config *)config;
+	char *end;
+
+	conf->speed = strtod((char *)param, &end);
+	if (*end != '\0' || conf->speed <= 0) {
+		DOCA_LOG_ERR("Speed must be a positive number");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle depth parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+depth_callback(void *param, void *config)
+{
+	struct replay_config *conf = (struct replay_config *)config;
+	int depth = *(int *)param;
+
+	if (depth < 1 || depth > MAX_REPLAY_DEPTH) {
+		DOCA_LOG_ERR("Engine depth must be between 1 and %d", MAX_REPLAY_DEPTH);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	conf->depth = depth;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle output parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+output_callback(void *param, void *config)
+{
+	struct replay_config *conf = (struct replay_config *)config;
+	const char *path = (char *)param;
+
+	if (strnlen(path, MAX_ARG_SIZE) == MAX_ARG_SIZE) {
+		DOCA_LOG_ERR("Output path is too long - MAX=%d", MAX_USER_ARG_SIZE);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	strcpy(conf->csv_path, path);
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Register one program parameter
+ *
+ * @short_name [in]: short option
+ * @long_name [in]: long option
+ * @description [in]: help text
+ * @callback [in]: parser callback
+ * @type [in]: argument type
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+register_param(const char *short_name, const char *long_name, const char *description, doca_argp_param_cb_t callback,
+	       enum doca_argp_type type)
+{
+	struct doca_argp_param *param;
+	doca_error_t result;
+
+	result = doca_argp_param_create(&param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(param, short_name);
+	doca_argp_param_set_long_name(param, long_name);
+	doca_argp_param_set_description(param, description);
+	doca_argp_param_set_callback(param, callback);
+	doca_argp_param_set_type(param, type);
+	result = doca_argp_register_param(param);
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+	return result;
+}
+
+/*
+ * Register the trace file, mode, speed, depth and output parameters
+ *
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+register_replay_params(void)
+{
+	doca_error_t result;
+
+	result = register_param("f", "trace-file", "Trace to replay, lines of <time_us> <r|w> <size> <offset> [<dep>]",
+				trace_file_callback, DOCA_ARGP_TYPE_STRING);
+	if (result != DOCA_SUCCESS)
+		return result;
+	result = register_param("m", "mode", "timed (trace inter-arrival times) or afap (as fast as possible), "
+				"default: timed", mode_callback, DOCA_ARGP_TYPE_STRING);
+	if (result != DOCA_SUCCESS)
+		return result;
+	result = register_param("x", "speed", "Divide the trace times by this factor in timed mode (default: 1)",
+				speed_callback, DOCA_ARGP_TYPE_STRING);
+	if (result != DOCA_SUCCESS)
+		return result;
+	result = register_param("q", "depth", "Largest number of DMAs in the engine (default: 32)", depth_callback,
+				DOCA_ARGP_TYPE_INT);
+	if (result != DOCA_SUCCESS)
+		return result;
+	return register_param("o", "output", "Write the per-DMA timing as CSV to <path>", output_callback,
+			      DOCA_ARGP_TYPE_STRING);
+}
+
+/*
+ * Sample main function
+ *
+ * @argc [in]: command line arguments size
+ * @argv [in]: array of command line arguments
+ * @return: EXIT_SUCCESS on success and EXIT_FAILURE otherwise
+ */
+int
+main(int argc, char **argv)
+{
+	struct replay_config conf = {0};
+	doca_error_t result;
+	struct doca_log_backend *sdk_log;
+	int exit_status = EXIT_FAILURE;
+
+	/* Set the default configuration values (Example values) */
+	strcpy(conf.dma_conf.pci_address, "03:00.0");
+	strcpy(conf.dma_conf.export_desc_path, "/tmp/export_desc.txt");
+	strcpy(conf.dma_conf.buf_info_path, "/tmp/buffer_info.txt");
+	conf.mode = REPLAY_TIMED;
+	conf.speed = 1;
+	conf.depth = 32;
+
+	/* Register a logger backend */
+	result = doca_log_backend_create_standard();
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+
+	/* Register a logger backend for internal SDK errors and warnings */
+	result = doca_log_backend_create_with_file_sdk(stderr, &sdk_log);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+	result = doca_log_backend_set_sdk_level(sdk_log, DOCA_LOG_LEVEL_WARNING);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+
+	result = doca_argp_init("doca_dma_replay", &conf);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to init ARGP resources: %s", doca_error_get_descr(result));
+		goto sample_exit;
+	}
+	result = register_dma_params(true);
+	if (result == DOCA_SUCCESS)
+		result = register_replay_params();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register DMA sample parameters: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+	result = doca_argp_start(argc, argv);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to parse sample input: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+	if (conf.trace_path[0] == '\0') {
+		DOCA_LOG_ERR("No trace file given (-f)");
+		goto argp_cleanup;
+	}
+
+	result = dma_replay_dpu(conf.trace_path, conf.mode, conf.speed, conf.depth, conf.csv_path,
+				conf.dma_conf.export_desc_path, conf.dma_conf.buf_info_path, conf.dma_conf.pci_address);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("dma_replay_dpu() encountered an error: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	exit_status = EXIT_SUCCESS;
+
+argp_cleanup:
+	doca_argp_destroy();
+sample_exit:
+	if (exit_status == EXIT_SUCCESS)
+		DOCA_LOG_INFO("Sample finished successfully");
+	else
+		DOCA_LOG_INFO("Sample finished with errors");
+	return exit_status;
+}
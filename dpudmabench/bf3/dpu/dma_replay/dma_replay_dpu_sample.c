@@ -0,0 +1,468 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <doca_buf.h>
+#include <doca_buf_inventory.h>
+#include <doca_ctx.h>
+#include <doca_dev.h>
+#include <doca_dma.h>
+#include <doca_error.h>
+#include <doca_log.h>
+#include <doca_mmap.h>
+#include <doca_pe.h>
+
+#include "dma_common.h"
+#include "dma_replay.h"
+
+DOCA_LOG_REGISTER(DMA_REPLAY_DPU);
+
+#define RECV_BUF_SIZE 256		/* Buffer which contains config information */
+#define MAX_DESC_SIZE 1024		/* Maximum size of the export descriptor */
+
+/* State of a replay run */
+struct replay_run {
+	struct replay *r;			/* Replay layer */
+	struct replay_trace *trace;		/* Replayed trace */
+	struct doca_dma *dma;			/* DMA context */
+	struct doca_buf_inventory *buf_inv;	/* Inventory */
+	struct doca_mmap *local_mmap;		/* DPU buffer mmap */
+	struct doca_mmap *remote_mmap;		/* Host buffer mmap */
+	char *local;				/* DPU buffer */
+	char *remote;				/* Host buffer */
+	uint64_t start_ns;			/* Start of the replay */
+	uint32_t inflight;			/* Tasks in the engine */
+	doca_error_t result;			/* First task error */
+};
+
+/*
+ * Saves export descriptor and buffer information content into memory buffers
+ *
+ * @export_desc_file_path [in]: Export descriptor file path
+ * @buffer_info_file_path [in]: Buffer information file path
+ * @export_desc [in]: Export descriptor buffer
+ * @export_desc_len [in]: Export descriptor buffer length
+ * @remote_addr [in]: Remote buffer address
+ * @remote_addr_len [in]: Remote buffer total length
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+save_config_info_to_buffers(const char *export_desc_file_path, const char *buffer_info_file_path, char *export_desc,
+			    size_t *export_desc_len, char **remote_addr, size_t *remote_addr_len)
+{
+	FILE *fp;
+	long file_size;
+	char buffer[RECV_BUF_SIZE];
+
+	fp = fopen(export_desc_file_path, "r");
+	if (fp == NULL) {
+		DOCA_LOG_ERR("Failed to open %s", export_desc_file_path);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	if (fseek(fp, 0, SEEK_END) != 0) {
+		DOCA_LOG_ERR("Failed to calculate file size");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	file_size = ftell(fp);
+	if (file_size == -1) {
+		DOCA_LOG_ERR("Failed to calculate file size");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	if (file_size > MAX_DESC_SIZE)
+		file_size = MAX_DESC_SIZE;
+
+	*export_desc_len = file_size;
+
+	if (fseek(fp, 0L, SEEK_SET) != 0) {
+		DOCA_LOG_ERR("Failed to calculate file size");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	if (fread(export_desc, 1, file_size, fp) != (size_t)file_size) {
+		DOCA_LOG_ERR("Failed to read the export descriptor");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	fclose(fp);
+
+	/* Read source buffer information from file */
+	fp = fopen(buffer_info_file_path, "r");
+	if (fp == NULL) {
+		DOCA_LOG_ERR("Failed to open %s", buffer_info_file_path);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	/* Get source buffer address */
+	if (fgets(buffer, RECV_BUF_SIZE, fp) == NULL) {
+		DOCA_LOG_ERR("Failed to read the source (host) buffer address");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+	*remote_addr = (char *)strtoull(buffer, NULL, 0);
+
+	memset(buffer, 0, RECV_BUF_SIZE);
+
+	/* Get source buffer length */
+	if (fgets(buffer, RECV_BUF_SIZE, fp) == NULL) {
+		DOCA_LOG_ERR("Failed to read the source (host) buffer length");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+	*remote_addr_len = strtoull(buffer, NULL, 0);
+
+	fclose(fp);
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Current time
+ *
+ * @return: CLOCK_MONOTONIC in nanoseconds
+ */
+static uint64_t
+now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000UL + ts.tv_nsec;
+}
+
+/*
+ * Release the buffers and the task of a finished DMA and tell the replay layer
+ *
+ * @dma_task [in]: finished task, freed here
+ * @op [in]: index of the DMA in the trace
+ * @run [in]: replay state
+ * @status [in]: status of the task
+ */
+static void
+dma_finished(struct doca_dma_task_memcpy *dma_task, int64_t op, struct replay_run *run, doca_error_t status)
+{
+	uint64_t now = now_ns() - run->start_ns;
+
+	doca_buf_dec_refcount((struct doca_buf *)doca_dma_task_memcpy_get_src(dma_task), NULL);
+	doca_buf_dec_refcount(doca_dma_task_memcpy_get_dst(dma_task), NULL);
+	doca_task_free(doca_dma_task_memcpy_as_task(dma_task));
+	run->inflight--;
+
+	if (status != DOCA_SUCCESS && run->result == DOCA_SUCCESS)
+		run->result = status;
+	replay_complete(run->r, op, now);
+}
+
+/*
+ * Replayed DMA completed callback
+ *
+ * @dma_task [in]: Completed task
+ * @task_user_data [in]: doca_data from the task, the index of the DMA
+ * @ctx_user_data [in]: doca_data from the context, the replay state
+ */
+static void
+replay_completed_callback(struct doca_dma_task_memcpy *dma_task, union doca_data task_user_data,
+			  union doca_data ctx_user_data)
+{
+	dma_finished(dma_task, (int64_t)task_user_data.u64, ctx_user_data.ptr, DOCA_SUCCESS);
+}
+
+/*
+ * Replayed DMA error callback
+ *
+ * @dma_task [in]: failed task
+ * @task_user_data [in]: doca_data from the task, the index of the DMA
+ * @ctx_user_data [in]: doca_data from the context, the replay state
+ */
+static void
+replay_error_callback(struct doca_dma_task_memcpy *dma_task, union doca_data task_user_data,
+		      union doca_data ctx_user_data)
+{
+	dma_finished(dma_task, (int64_t)task_user_data.u64, ctx_user_data.ptr,
+		     doca_task_get_status(doca_dma_task_memcpy_as_task(dma_task)));
+}
+
+/*
+ * Hand one DMA of the trace to the engine
+ *
+ * @run [in]: replay state
+ * @op [in]: index of the DMA
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+submit_dma(struct replay_run *run, int64_t op)
+{
+	const struct replay_op *dma = &run->trace->ops[op];
+	struct doca_mmap *src_mmap = run->remote_mmap, *dst_mmap = run->local_mmap;
+	char *src_addr = run->remote + dma->offset, *dst_addr = run->local + dma->offset;
+	struct doca_buf *src = NULL, *dst = NULL;
+	struct doca_dma_task_memcpy *task;
+	union doca_data data = {.u64 = (uint64_t)op};
+	doca_error_t result;
+
+	if (dma->dir == REPLAY_WRITE) {
+		src_mmap = run->local_mmap;
+		src_addr = run->local + dma->offset;
+		dst_mmap = run->remote_mmap;
+		dst_addr = run->remote + dma->offset;
+	}
+
+	/* The source carries the data, the destination is filled by the engine */
+	result = doca_buf_inventory_buf_get_by_data(run->buf_inv, src_mmap, src_addr, dma->size, &src);
+	if (result == DOCA_SUCCESS)
+		result = doca_buf_inventory_buf_get_by_addr(run->buf_inv, dst_mmap, dst_addr, dma->size, &dst);
+	if (result == DOCA_SUCCESS)
+		result = doca_dma_task_memcpy_alloc_init(run->dma, src, dst, data, &task);
+	if (result == DOCA_SUCCESS) {
+		result = doca_task_submit(doca_dma_task_memcpy_as_task(task));
+		if (result != DOCA_SUCCESS)
+			doca_task_free(doca_dma_task_memcpy_as_task(task));
+	}
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to submit DMA %ld: %s", (long)op, doca_error_get_descr(result));
+		if (src != NULL)
+			doca_buf_dec_refcount(src, NULL);
+		if (dst != NULL)
+			doca_buf_dec_refcount(dst, NULL);
+		return result;
+	}
+	run->inflight++;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Replay the trace once on a fresh DMA context
+ *
+ * @run [in]: replay state, buffers, mmaps and inventory set
+ * @dev [in]: DOCA device
+ * @pe [in]: progress engine
+ * @mode [in]: issue timing
+ * @speed [in]: trace time divisor in timed mode
+ * @depth [in]: largest number of DMAs in the engine
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+run_replay(struct replay_run *run, struct doca_dev *dev, struct doca_pe *pe, enum replay_mode mode, double speed,
+	   uint32_t depth)
+{
+	union doca_data data = {.ptr = run};
+	doca_error_t result, tmp_result;
+	uint64_t now = 0;
+	int64_t op;
+
+	run->inflight = 0;
+	run->result = DOCA_SUCCESS;
+	run->r = replay_create(run->trace, mode, speed);
+	if (run->r == NULL) {
+		DOCA_LOG_ERR("Failed to create the replay");
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	result = doca_dma_create(dev, &run->dma);
+	if (result == DOCA_SUCCESS)
+		result = doca_dma_task_memcpy_set_conf(run->dma, replay_completed_callback, replay_error_callback,
+						       depth);
+	if (result == DOCA_SUCCESS)
+		result = doca_ctx_set_user_data(doca_dma_as_ctx(run->dma), data);
+	if (result == DOCA_SUCCESS)
+		result = doca_pe_connect_ctx(pe, doca_dma_as_ctx(run->dma));
+	if (result == DOCA_SUCCESS)
+		result = doca_ctx_start(doca_dma_as_ctx(run->dma));
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start DMA context: %s", doca_error_get_descr(result));
+		if (run->dma != NULL)
+			doca_dma_destroy(run->dma);
+		replay_destroy(run->r);
+		run->r = NULL;
+		return result;
+	}
+
+	/* Issue every eligible DMA the engine has room for, then poll; timed mode spins until the next trace time */
+	run->start_ns = now_ns();
+	while (!replay_finished(run->r) && result == DOCA_SUCCESS && run->result == DOCA_SUCCESS) {
+		now = now_ns() - run->start_ns;
+		while (run->inflight < depth && (op = replay_next(run->r, now)) >= 0) {
+			result = submit_dma(run, op);
+			if (result != DOCA_SUCCESS)
+				break;
+		}
+		(void)doca_pe_progress(pe);
+	}
+	now = now_ns() - run->start_ns;
+	DOCA_ERROR_PROPAGATE(result, run->result);
+
+	while (run->inflight > 0)
+		(void)doca_pe_progress(pe);
+	if (result == DOCA_SUCCESS)
+		replay_report(run->r, now);
+
+	tmp_result = request_stop_ctx(pe, doca_dma_as_ctx(run->dma));
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	tmp_result = doca_dma_destroy(run->dma);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	run->dma = NULL;
+	return result;
+}
+
+/*
+ * Run DOCA DMA trace replay on the DPU, the host exports its buffer (d_to_h)
+ *
+ * @trace_path [in]: trace file
+ * @mode [in]: issue timing
+ * @speed [in]: trace time divisor in timed mode
+ * @depth [in]: largest number of DMAs in the engine
+ * @csv_path [in]: per-DMA timing output, empty for none
+ * @export_desc_file_path [in]: Export descriptor file path
+ * @buffer_info_file_path [in]: Buffer info file path
+ * @pcie_addr [in]: Device PCI address
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t
+dma_replay_dpu(const char *trace_path, enum replay_mode mode, double speed, uint32_t depth, const char *csv_path,
+	       const char *export_desc_file_path, const char *buffer_info_file_path, const char *pcie_addr)
+{
+	static struct replay_run run;
+	struct replay_trace trace;
+	struct doca_dev *dev;
+	struct doca_pe *pe = NULL;
+	char export_desc[MAX_DESC_SIZE];
+	size_t export_desc_len, remote_len;
+	uint64_t max_buffer_size;
+	doca_error_t result, tmp_result;
+	FILE *csv;
+
+	if (replay_trace_load(trace_path, &trace) != 0)
+		return DOCA_ERROR_INVALID_VALUE;
+	run.trace = &trace;
+
+	result = save_config_info_to_buffers(export_desc_file_path, buffer_info_file_path, export_desc,
+					     &export_desc_len, &run.remote, &remote_len);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to read memory configuration from file: %s", doca_error_get_descr(result));
+		replay_trace_free(&trace);
+		return result;
+	}
+	if (remote_len < trace.span) {
+		DOCA_LOG_ERR("The trace touches %zu bytes, the host buffer only holds %zu", trace.span, remote_len);
+		replay_trace_free(&trace);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	result = open_doca_device_with_pci(pcie_addr, &dma_task_is_supported, &dev);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to open DOCA device: %s", doca_error_get_descr(result));
+		replay_trace_free(&trace);
+		return result;
+	}
+
+	result = doca_dma_cap_task_memcpy_get_max_buf_size(doca_dev_as_devinfo(dev), &max_buffer_size);
+	if (result == DOCA_SUCCESS && trace.max_size > max_buffer_size) {
+		DOCA_LOG_ERR("The trace holds a %zu-byte DMA, the engine takes at most %lu", trace.max_size,
+			     max_buffer_size);
+		result = DOCA_ERROR_INVALID_VALUE;
+	}
+	if (result != DOCA_SUCCESS)
+		goto destroy_objects;
+
+	run.local = calloc(1, trace.span);
+	if (run.local == NULL) {
+		DOCA_LOG_ERR("Failed to allocate the DPU buffer");
+		result = DOCA_ERROR_NO_MEMORY;
+		goto destroy_objects;
+	}
+
+	result = doca_mmap_create(&run.local_mmap);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_add_dev(run.local_mmap, dev);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_set_memrange(run.local_mmap, run.local, trace.span);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_start(run.local_mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start local mmap: %s", doca_error_get_descr(result));
+		goto destroy_objects;
+	}
+
+	result = doca_mmap_create_from_export(NULL, export_desc, export_desc_len, dev, &run.remote_mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create mmap from export: %s", doca_error_get_descr(result));
+		goto destroy_objects;
+	}
+
+	result = doca_buf_inventory_create(2 * depth, &run.buf_inv);
+	if (result == DOCA_SUCCESS)
+		result = doca_buf_inventory_start(run.buf_inv);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start buffer inventory: %s", doca_error_get_descr(result));
+		goto destroy_objects;
+	}
+
+	result = doca_pe_create(&pe);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create progress engine: %s", doca_error_get_descr(result));
+		goto destroy_objects;
+	}
+
+	printf("Trace %s: %zu DMAs, %lu bytes over %.3f ms, engine depth %u\n", trace_path, trace.nb_ops, trace.bytes,
+	       trace.ops[trace.nb_ops - 1].t_ns / 1e6, depth);
+	result = run_replay(&run, dev, pe, mode, speed, depth);
+
+	if (result == DOCA_SUCCESS && csv_path[0] != '\0') {
+		csv = fopen(csv_path, "w");
+		if (csv == NULL) {
+			DOCA_LOG_ERR("Failed to open %s", csv_path);
+			result = DOCA_ERROR_IO_FAILED;
+		} else {
+			replay_write_csv(run.r, csv);
+			fclose(csv);
+			printf("Per-DMA timing written to %s\n", csv_path);
+		}
+	}
+	if (run.r != NULL)
+		replay_destroy(run.r);
+
+destroy_objects:
+	if (pe != NULL) {
+		tmp_result = doca_pe_destroy(pe);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+	if (run.buf_inv != NULL) {
+		tmp_result = doca_buf_inventory_stop(run.buf_inv);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+		tmp_result = doca_buf_inventory_destroy(run.buf_inv);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+	if (run.remote_mmap != NULL) {
+		tmp_result = doca_mmap_destroy(run.remote_mmap);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+	if (run.local_mmap != NULL) {
+		tmp_result = doca_mmap_destroy(run.local_mmap);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+	free(run.local);
+	tmp_result = doca_dev_close(dev);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	replay_trace_free(&trace);
+	return result;
+}
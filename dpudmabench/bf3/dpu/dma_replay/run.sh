@@ -0,0 +1,26 @@
+# /*
+# * Copyright (c) 2025, University of California, Merced. All rights reserved.
+# *
+# * This file is part of the benchmarking software package developed by
+# * the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+# *
+# * For detailed copyright and licensing information, please refer to the license
+# * file LICENSE in the top level directory.
+# *
+# */
+
+
+# Start host/dma_write_d_to_h_lat_poll/run.sh 33554432 on the host first,
+# replayed writes need a READ_WRITE export.
+# Usage: run.sh [trace] [timed|afap]
+trace=${1:-example.trace}
+mode=${2:-timed}
+scp <user>@<host>:/tmp/buffer_info.txt .
+scp <user>@<host>:/tmp/export_desc.txt .
+echo ""
+
+make clean
+make
+echo ""
+
+./doca_dma_replay -p 03:00.0 -d export_desc.txt -b buffer_info.txt -f ${trace} -m ${mode} -o dma_replay.csv | tee dma_replay.txt
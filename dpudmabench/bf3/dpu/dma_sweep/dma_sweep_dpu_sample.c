@@ -0,0 +1,504 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <doca_buf.h>
+#include <doca_buf_inventory.h>
+#include <doca_dma.h>
+#include <doca_error.h>
+#include <doca_log.h>
+#include <doca_mmap.h>
+#include <doca_pe.h>
+
+#include "dma_common.h"
+#include "utils.h"
+
+DOCA_LOG_REGISTER(DMA_SWEEP_DPU);
+
+#define RECV_BUF_SIZE 256		/* Buffer which contains config information */
+#define MAX_DESC_SIZE 1024		/* Maximum size of the export descriptor */
+#define MIN_SWEEP_SIZE 2		/* First payload size of the sweep */
+#define LAT_ITERATIONS 5000		/* Latency iterations (same as the latency benchmarks) */
+#define THR_BYTES (1UL << 30)		/* Bytes moved per throughput point */
+#define THR_MIN_REPS 10			/* Minimum number of batches per throughput point */
+#define THR_MAX_REPS 1000		/* Maximum number of batches per throughput point */
+
+/* Data-flow direction of a DPU-initiated transfer */
+enum sweep_direction {
+	SWEEP_PULL,	/* DPU reads host memory (dma_read_d_to_h) */
+	SWEEP_PUSH,	/* DPU writes host memory (dma_write_d_to_h) */
+};
+
+/*
+ * Saves export descriptor and buffer information content into memory buffers
+ *
+ * @export_desc_file_path [in]: Export descriptor file path
+ * @buffer_info_file_path [in]: Buffer information file path
+ * @export_desc [in]: Export descriptor buffer
+ * @export_desc_len [in]: Export descriptor buffer length
+ * @remote_addr [in]: Remote buffer address
+ * @remote_addr_len [in]: Remote buffer total length
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+save_config_info_to_buffers(const char *export_desc_file_path, const char *buffer_info_file_path, char *export_desc,
+			    size_t *export_desc_len, char **remote_addr, size_t *remote_addr_len)
+{
+	FILE *fp;
+	long file_size;
+	char buffer[RECV_BUF_SIZE];
+
+	fp = fopen(export_desc_file_path, "r");
+	if (fp == NULL) {
+		DOCA_LOG_ERR("Failed to open %s", export_desc_file_path);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	if (fseek(fp, 0, SEEK_END) != 0) {
+		DOCA_LOG_ERR("Failed to calculate file size");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	file_size = ftell(fp);
+	if (file_size == -1) {
+		DOCA_LOG_ERR("Failed to calculate file size");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	if (file_size > MAX_DESC_SIZE)
+		file_size = MAX_DESC_SIZE;
+
+	*export_desc_len = file_size;
+
+	if (fseek(fp, 0L, SEEK_SET) != 0) {
+		DOCA_LOG_ERR("Failed to calculate file size");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	if (fread(export_desc, 1, file_size, fp) != (size_t)file_size) {
+		DOCA_LOG_ERR("Failed to read the export descriptor");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	fclose(fp);
+
+	/* Read source buffer information from file */
+	fp = fopen(buffer_info_file_path, "r");
+	if (fp == NULL) {
+		DOCA_LOG_ERR("Failed to open %s", buffer_info_file_path);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	/* Get source buffer address */
+	if (fgets(buffer, RECV_BUF_SIZE, fp) == NULL) {
+		DOCA_LOG_ERR("Failed to read the source (host) buffer address");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+	*remote_addr = (char *)strtoull(buffer, NULL, 0);
+
+	memset(buffer, 0, RECV_BUF_SIZE);
+
+	/* Get source buffer length */
+	if (fgets(buffer, RECV_BUF_SIZE, fp) == NULL) {
+		DOCA_LOG_ERR("Failed to read the source (host) buffer length");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+	*remote_addr_len = strtoull(buffer, NULL, 0);
+
+	fclose(fp);
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Elapsed time between two timestamps
+ *
+ * @start [in]: start timestamp
+ * @end [in]: end timestamp
+ * @return: elapsed time in nanoseconds
+ */
+static double
+elapsed_ns(const struct timespec *start, const struct timespec *end)
+{
+	return (end->tv_sec - start->tv_sec) * 1e9 + (end->tv_nsec - start->tv_nsec);
+}
+
+/*
+ * Print one sweep record, the input format of dpudmabench/crossover/transport_select
+ *
+ * @direction [in]: pull, push or local
+ * @transport [in]: transport name
+ * @size [in]: payload size
+ * @lat_us [in]: average latency in microseconds
+ * @mops [in]: throughput in Mops
+ */
+static void
+print_record(const char *direction, const char *transport, size_t size, double lat_us, double mops)
+{
+	printf("RECORD %s %s %zu %.3f %.4f %.3f\n", direction, transport, size, lat_us, mops,
+	       mops * size / 1000);
+	fflush(stdout);
+}
+
+/*
+ * Number of batches used for one throughput point
+ *
+ * @size [in]: payload size
+ * @return: number of batches of NUM_DMA_TASKS tasks
+ */
+static int
+thr_reps(size_t size)
+{
+	size_t reps = THR_BYTES / (size * NUM_DMA_TASKS);
+
+	if (reps < THR_MIN_REPS)
+		return THR_MIN_REPS;
+	if (reps > THR_MAX_REPS)
+		return THR_MAX_REPS;
+	return reps;
+}
+
+/*
+ * Point every task at the local and remote buffers for one direction and size
+ *
+ * @resources [in]: DMA resources
+ * @direction [in]: data-flow direction
+ * @size [in]: payload size
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+prepare_tasks(struct dma_resources *resources, enum sweep_direction direction, size_t size)
+{
+	struct doca_buf *src, *dst;
+	void *src_addr;
+	doca_error_t result;
+	int i;
+
+	for (i = 0; i < NUM_DMA_TASKS; i++) {
+		if (direction == SWEEP_PULL) {
+			src = resources->dst_doca_buf_array[i];
+			dst = resources->src_doca_buf_array[i];
+			src_addr = resources->remote_addr;
+		} else {
+			src = resources->src_doca_buf_array[i];
+			dst = resources->dst_doca_buf_array[i];
+			src_addr = resources->dpu_buffer;
+		}
+
+		result = doca_buf_set_data(src, src_addr, size);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to set data for DOCA source buffer: %s", doca_error_get_descr(result));
+			return result;
+		}
+		result = doca_buf_reset_data_len(dst);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to reset DOCA destination buffer: %s", doca_error_get_descr(result));
+			return result;
+		}
+
+		doca_dma_task_memcpy_set_src(resources->tasks[i], src);
+		doca_dma_task_memcpy_set_dst(resources->tasks[i], dst);
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Submit the first num tasks
+ *
+ * @resources [in]: DMA resources
+ * @num [in]: number of tasks to submit
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+submit_tasks(struct dma_resources *resources, int num)
+{
+	doca_error_t result;
+	int i;
+
+	resources->num_remaining_tasks = num;
+	for (i = 0; i < num; i++) {
+		result = doca_task_submit(doca_dma_task_memcpy_as_task(resources->tasks[i]));
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to submit DMA task: %s", doca_error_get_descr(result));
+			return result;
+		}
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Measure DMA latency and throughput for one direction, completion mode and size
+ *
+ * @resources [in]: DMA resources
+ * @direction [in]: data-flow direction
+ * @use_event [in]: wait for completions on the PE notification handle instead of polling
+ * @size [in]: payload size
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+measure_dma(struct dma_resources *resources, enum sweep_direction direction, bool use_event, size_t size)
+{
+	struct timespec start, end;
+	double lat_ns, thr_ns;
+	doca_error_t result;
+	int i, reps;
+
+	result = prepare_tasks(resources, direction, size);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	/* Latency: one task in flight */
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < LAT_ITERATIONS; i++) {
+		result = submit_tasks(resources, 1);
+		if (result != DOCA_SUCCESS)
+			return result;
+		result = dma_wait_tasks(resources, use_event);
+		if (result != DOCA_SUCCESS)
+			return result;
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	lat_ns = elapsed_ns(&start, &end) / LAT_ITERATIONS;
+
+	/* Throughput: batches of NUM_DMA_TASKS tasks */
+	reps = thr_reps(size);
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < reps; i++) {
+		result = submit_tasks(resources, NUM_DMA_TASKS);
+		if (result != DOCA_SUCCESS)
+			return result;
+		result = dma_wait_tasks(resources, use_event);
+		if (result != DOCA_SUCCESS)
+			return result;
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	thr_ns = elapsed_ns(&start, &end);
+
+	print_record(direction == SWEEP_PULL ? "pull" : "push", use_event ? "dma_event" : "dma_poll", size,
+		     lat_ns / 1000, (double)reps * NUM_DMA_TASKS / thr_ns * 1000);
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Measure a DPU-local CPU memcpy of the same size as a shared-memory baseline
+ *
+ * @dst [in]: destination buffer
+ * @src [in]: source buffer
+ * @size [in]: payload size
+ */
+static void
+measure_memcpy(char *dst, const char *src, size_t size)
+{
+	struct timespec start, end;
+	double lat_ns, thr_ns;
+	int i, reps;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < LAT_ITERATIONS; i++) {
+		memcpy(dst, src, size);
+		__asm__ __volatile__("" : : "r"(dst) : "memory");
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	lat_ns = elapsed_ns(&start, &end) / LAT_ITERATIONS;
+
+	reps = thr_reps(size) * NUM_DMA_TASKS;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < reps; i++) {
+		memcpy(dst, src, size);
+		__asm__ __volatile__("" : : "r"(dst) : "memory");
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	thr_ns = elapsed_ns(&start, &end);
+
+	print_record("local", "memcpy", size, lat_ns / 1000, (double)reps / thr_ns * 1000);
+}
+
+/*
+ * Run DOCA DMA size sweep on the DPU
+ *
+ * @export_desc_file_path [in]: Export descriptor file path
+ * @buffer_info_file_path [in]: Buffer info file path
+ * @pcie_addr [in]: Device PCI address
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t
+dma_sweep_dpu(const char *export_desc_file_path, const char *buffer_info_file_path, const char *pcie_addr)
+{
+	struct dma_resources resources;
+	struct program_core_objects *state = &resources.state;
+	union doca_data task_user_data = {0};
+	char export_desc[MAX_DESC_SIZE] = {0};
+	size_t export_desc_len = 0;
+	uint64_t max_buffer_size;
+	char *copy_buffer = NULL;
+	doca_error_t result, tmp_result, task_result = DOCA_SUCCESS;
+	size_t size, max_size;
+	int i, nb_bufs = 0, nb_tasks = 0;
+
+	/* Allocate resources, the event handle is only used by the dma_event points */
+	result = allocate_dma_resources_with_event(pcie_addr, &resources);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to allocate DMA resources: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	/* Connect context to progress engine */
+	result = doca_pe_connect_ctx(state->pe, state->ctx);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to connect progress engine to context: %s", doca_error_get_descr(result));
+		goto destroy_resources;
+	}
+
+	result = doca_ctx_start(state->ctx);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start context: %s", doca_error_get_descr(result));
+		goto destroy_resources;
+	}
+
+	/* Get maximum buffer size allowed */
+	result = doca_dma_cap_task_memcpy_get_max_buf_size(doca_dev_as_devinfo(state->dev), &max_buffer_size);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to get max buffer size: %s", doca_error_get_descr(result));
+		goto stop_dma;
+	}
+
+	/* Copy all relevant information into local buffers */
+	result = save_config_info_to_buffers(export_desc_file_path, buffer_info_file_path, export_desc,
+					     &export_desc_len, &resources.remote_addr, &resources.remote_addr_len);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to read memory configuration from file: %s", doca_error_get_descr(result));
+		goto stop_dma;
+	}
+
+	/* The sweep goes up to the exported host buffer, capped by the engine limit */
+	max_size = MIN(resources.remote_addr_len, max_buffer_size);
+	resources.dst_buffer_size = max_size;
+	resources.dpu_buffer = (char *)malloc(max_size);
+	copy_buffer = (char *)malloc(max_size);
+	if (resources.dpu_buffer == NULL || copy_buffer == NULL) {
+		DOCA_LOG_ERR("Failed to allocate memory for DPU buffers");
+		result = DOCA_ERROR_NO_MEMORY;
+		goto free_dpu_buffer;
+	}
+	memset(resources.dpu_buffer, '0', max_size);
+	memset(copy_buffer, '0', max_size);
+	printf("Sweep from %d to %zu bytes\n", MIN_SWEEP_SIZE, max_size);
+
+	result = doca_mmap_set_memrange(state->dst_mmap, resources.dpu_buffer, max_size);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set memory range for destination mmap: %s", doca_error_get_descr(result));
+		goto free_dpu_buffer;
+	}
+
+	result = doca_mmap_start(state->dst_mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start destination mmap: %s", doca_error_get_descr(result));
+		goto free_dpu_buffer;
+	}
+
+	/* Create a local DOCA mmap from exported data */
+	result = doca_mmap_create_from_export(NULL, (const void *)export_desc, export_desc_len, state->dev,
+					      &resources.remote_mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create mmap from export: %s", doca_error_get_descr(result));
+		goto free_dpu_buffer;
+	}
+
+	/* src_doca_buf_array holds the DPU side and dst_doca_buf_array the host side of every task */
+	for (nb_bufs = 0; nb_bufs < NUM_DMA_TASKS; nb_bufs++) {
+		result = doca_buf_inventory_buf_get_by_addr(state->buf_inv, state->dst_mmap, resources.dpu_buffer,
+							    max_size, &resources.src_doca_buf_array[nb_bufs]);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Unable to acquire DOCA buffer representing local buffer: %s",
+				     doca_error_get_descr(result));
+			goto destroy_bufs;
+		}
+		result = doca_buf_inventory_buf_get_by_addr(state->buf_inv, resources.remote_mmap, resources.remote_addr,
+							    max_size, &resources.dst_doca_buf_array[nb_bufs]);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Unable to acquire DOCA buffer representing remote buffer: %s",
+				     doca_error_get_descr(result));
+			doca_buf_dec_refcount(resources.src_doca_buf_array[nb_bufs], NULL);
+			goto destroy_bufs;
+		}
+	}
+
+	task_user_data.ptr = &task_result;
+	for (nb_tasks = 0; nb_tasks < NUM_DMA_TASKS; nb_tasks++) {
+		result = doca_dma_task_memcpy_alloc_init(resources.dma_ctx, resources.src_doca_buf_array[nb_tasks],
+							 resources.dst_doca_buf_array[nb_tasks], task_user_data,
+							 &resources.tasks[nb_tasks]);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to allocate DMA memcpy task: %s", doca_error_get_descr(result));
+			goto free_tasks;
+		}
+	}
+
+	for (size = MIN_SWEEP_SIZE; size <= max_size; size *= 2) {
+		for (i = 0; i < 4 && result == DOCA_SUCCESS; i++)
+			result = measure_dma(&resources, (i & 1) ? SWEEP_PUSH : SWEEP_PULL, i >= 2, size);
+		if (result != DOCA_SUCCESS || task_result != DOCA_SUCCESS) {
+			DOCA_ERROR_PROPAGATE(result, task_result);
+			DOCA_LOG_ERR("DMA sweep failed at %zu bytes: %s", size, doca_error_get_descr(result));
+			break;
+		}
+		measure_memcpy(copy_buffer, resources.dpu_buffer, size);
+	}
+
+free_tasks:
+	for (i = 0; i < nb_tasks; i++)
+		doca_task_free(doca_dma_task_memcpy_as_task(resources.tasks[i]));
+destroy_bufs:
+	for (i = 0; i < nb_bufs; i++) {
+		tmp_result = doca_buf_dec_refcount(resources.src_doca_buf_array[i], NULL);
+		DOCA_ERROR_PROPAGATE(tmp_result, doca_buf_dec_refcount(resources.dst_doca_buf_array[i], NULL));
+		if (tmp_result != DOCA_SUCCESS) {
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+			DOCA_LOG_ERR("Failed to decrease DOCA buffer reference count: %s", doca_error_get_descr(tmp_result));
+		}
+	}
+	tmp_result = doca_mmap_destroy(resources.remote_mmap);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+		DOCA_LOG_ERR("Failed to destroy remote mmap: %s", doca_error_get_descr(tmp_result));
+	}
+free_dpu_buffer:
+	free(copy_buffer);
+	free(resources.dpu_buffer);
+stop_dma:
+	tmp_result = request_stop_ctx(state->pe, state->ctx);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+		DOCA_LOG_ERR("Unable to stop context: %s", doca_error_get_descr(tmp_result));
+	}
+	state->ctx = NULL;
+destroy_resources:
+	tmp_result = destroy_dma_resources(&resources);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+		DOCA_LOG_ERR("Failed to destroy DMA resources: %s", doca_error_get_descr(tmp_result));
+	}
+
+	return result;
+}
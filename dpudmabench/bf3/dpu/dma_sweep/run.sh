@@ -0,0 +1,22 @@
+# /*
+# * Copyright (c) 2025, University of California, Merced. All rights reserved.
+# *
+# * This file is part of the benchmarking software package developed by
+# * the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+# *
+# * For detailed copyright and licensing information, please refer to the license
+# * file LICENSE in the top level directory.
+# *
+# */
+
+# Start host/dma_write_d_to_h_lat_poll/run.sh <largest size> on the host first,
+# the exported buffer is used for both the pull (read) and push (write) points.
+scp <user>@<host>:/tmp/buffer_info.txt .
+scp <user>@<host>:/tmp/export_desc.txt .
+echo ""
+
+make clean
+make
+echo ""
+
+./doca_dma_sweep -p 03:00.0 -d export_desc.txt -b buffer_info.txt | tee dma_sweep.txt
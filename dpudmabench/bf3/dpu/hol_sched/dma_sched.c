@@ -0,0 +1,344 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+#include <stdlib.h>
+
+#include <doca_buf.h>
+#include <doca_ctx.h>
+#include <doca_log.h>
+
+#include "common.h"
+#include "dma_sched.h"
+
+DOCA_LOG_REGISTER(DMA_SCHED);
+
+/* One DMA context, shared by the classes pointing at it */
+struct sched_ctx {
+	struct dma_sched *sched;	/* Owning scheduler */
+	struct doca_dma *dma;		/* DMA context */
+	struct doca_ctx *ctx;		/* DMA context as a generic context, NULL until started */
+	uint32_t inflight_tasks;	/* Tasks submitted and not completed */
+};
+
+/* One latency class */
+struct sched_class {
+	struct dma_sched_class_cfg cfg;	/* Class configuration */
+	struct sched_ctx *sctx;		/* Context the class submits to */
+	size_t inflight;		/* Bytes submitted and not completed */
+	struct dma_sched_req *head;	/* Oldest request with chunks left to submit */
+	struct dma_sched_req *tail;	/* Newest request */
+};
+
+struct dma_sched {
+	struct doca_pe *pe;					/* Progress engine of all contexts */
+	struct doca_buf_inventory *buf_inv;			/* Inventory of the chunk buffers */
+	struct sched_ctx ctxs[DMA_SCHED_MAX_CLASSES];		/* Contexts */
+	int nb_ctxs;						/* Number of contexts */
+	struct sched_class classes[DMA_SCHED_MAX_CLASSES];	/* Classes, pumped in index order */
+	int nb_classes;						/* Number of classes */
+	uint64_t pending;					/* Requests not completed */
+	struct dma_sched_stats stats;				/* Counters */
+};
+
+/*
+ * Account for one finished chunk and complete its request once nothing is left
+ *
+ * @dma_task [in]: finished task, freed here
+ * @req [in]: request of the chunk
+ * @sctx [in]: context of the chunk
+ * @status [in]: status of the chunk
+ */
+static void
+chunk_finished(struct doca_dma_task_memcpy *dma_task, struct dma_sched_req *req, struct sched_ctx *sctx,
+	       doca_error_t status)
+{
+	struct dma_sched *sched = sctx->sched;
+	struct sched_class *cls = &sched->classes[req->cls];
+	struct doca_buf *src = (struct doca_buf *)doca_dma_task_memcpy_get_src(dma_task);
+	struct doca_buf *dst = doca_dma_task_memcpy_get_dst(dma_task);
+	size_t len = 0;
+
+	(void)doca_buf_get_data_len(src, &len);
+	doca_task_free(doca_dma_task_memcpy_as_task(dma_task));
+	doca_buf_dec_refcount(src, NULL);
+	doca_buf_dec_refcount(dst, NULL);
+
+	cls->inflight -= len;
+	sctx->inflight_tasks--;
+	sched->stats.chunks[req->cls]++;
+	if (status == DOCA_SUCCESS)
+		sched->stats.bytes[req->cls] += len;
+	else if (req->result == DOCA_SUCCESS)
+		req->result = status;
+
+	/* Requests with chunks left are completed by pump_class(), which also drops the rest of a failed one */
+	if (--req->outstanding > 0 || req->next_off < req->len)
+		return;
+	sched->stats.reqs[req->cls]++;
+	sched->pending--;
+	req->done(req);
+}
+
+/*
+ * Chunk completed callback
+ *
+ * @dma_task [in]: Completed task
+ * @task_user_data [in]: doca_data from the task, the request
+ * @ctx_user_data [in]: doca_data from the context, the scheduler context
+ */
+static void
+chunk_completed_callback(struct doca_dma_task_memcpy *dma_task, union doca_data task_user_data,
+			 union doca_data ctx_user_data)
+{
+	chunk_finished(dma_task, task_user_data.ptr, ctx_user_data.ptr, DOCA_SUCCESS);
+}
+
+/*
+ * Chunk error callback
+ *
+ * @dma_task [in]: failed task
+ * @task_user_data [in]: doca_data from the task, the request
+ * @ctx_user_data [in]: doca_data from the context, the scheduler context
+ */
+static void
+chunk_error_callback(struct doca_dma_task_memcpy *dma_task, union doca_data task_user_data,
+		     union doca_data ctx_user_data)
+{
+	chunk_finished(dma_task, task_user_data.ptr, ctx_user_data.ptr,
+		       doca_task_get_status(doca_dma_task_memcpy_as_task(dma_task)));
+}
+
+/*
+ * Submit one chunk of a request
+ *
+ * @sched [in]: scheduler
+ * @sctx [in]: context to submit to
+ * @req [in]: request
+ * @len [in]: chunk length, starting at req->next_off
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+submit_chunk(struct dma_sched *sched, struct sched_ctx *sctx, struct dma_sched_req *req, size_t len)
+{
+	struct doca_buf *src = NULL, *dst = NULL;
+	struct doca_dma_task_memcpy *task;
+	union doca_data data = {.ptr = req};
+	doca_error_t result;
+
+	result = doca_buf_inventory_buf_get_by_addr(sched->buf_inv, req->src_mmap, req->src + req->next_off, len, &src);
+	if (result == DOCA_SUCCESS)
+		result = doca_buf_set_data(src, req->src + req->next_off, len);
+	if (result == DOCA_SUCCESS)
+		result = doca_buf_inventory_buf_get_by_addr(sched->buf_inv, req->dst_mmap, req->dst + req->next_off, len,
+							    &dst);
+	if (result == DOCA_SUCCESS)
+		result = doca_dma_task_memcpy_alloc_init(sctx->dma, src, dst, data, &task);
+	if (result != DOCA_SUCCESS)
+		goto release_bufs;
+
+	result = doca_task_submit(doca_dma_task_memcpy_as_task(task));
+	if (result != DOCA_SUCCESS) {
+		doca_task_free(doca_dma_task_memcpy_as_task(task));
+		goto release_bufs;
+	}
+	return DOCA_SUCCESS;
+
+release_bufs:
+	DOCA_LOG_ERR("Failed to submit a chunk of class %d: %s", req->cls, doca_error_get_descr(result));
+	if (src != NULL)
+		doca_buf_dec_refcount(src, NULL);
+	if (dst != NULL)
+		doca_buf_dec_refcount(dst, NULL);
+	return result;
+}
+
+/*
+ * Submit the queued chunks of a class until the queue is empty or a limit is hit
+ *
+ * @sched [in]: scheduler
+ * @c [in]: class index
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+pump_class(struct dma_sched *sched, int c)
+{
+	struct sched_class *cls = &sched->classes[c];
+	struct sched_ctx *sctx = cls->sctx;
+	struct dma_sched_req *req;
+	doca_error_t result;
+	size_t len;
+
+	while ((req = cls->head) != NULL) {
+		if (req->result != DOCA_SUCCESS) {
+			/* An earlier chunk failed, drop the rest of the request */
+			req->next_off = req->len;
+		} else {
+			len = req->len - req->next_off;
+			if (cls->cfg.split != 0 && len > cls->cfg.split)
+				len = cls->cfg.split;
+			/* An idle class always gets one chunk, even above its limit */
+			if ((cls->cfg.max_inflight != 0 && cls->inflight != 0 && cls->inflight + len > cls->cfg.max_inflight) ||
+			    sctx->inflight_tasks == DMA_SCHED_MAX_TASKS) {
+				sched->stats.throttled[c]++;
+				return DOCA_SUCCESS;
+			}
+			result = submit_chunk(sched, sctx, req, len);
+			if (result != DOCA_SUCCESS)
+				return result;
+			req->next_off += len;
+			req->outstanding++;
+			cls->inflight += len;
+			sctx->inflight_tasks++;
+		}
+
+		if (req->next_off < req->len)
+			continue;
+		cls->head = req->next;
+		if (cls->head == NULL)
+			cls->tail = NULL;
+		if (req->outstanding == 0) {
+			sched->stats.reqs[c]++;
+			sched->pending--;
+			req->done(req);
+		}
+	}
+	return DOCA_SUCCESS;
+}
+
+doca_error_t
+dma_sched_create(struct doca_dev *dev, struct doca_pe *pe, struct doca_buf_inventory *buf_inv,
+		 const struct dma_sched_class_cfg *cfg, int nb_classes, struct dma_sched **sched)
+{
+	struct dma_sched *s;
+	struct sched_ctx *sctx;
+	union doca_data data;
+	doca_error_t result;
+	int c;
+
+	if (nb_classes < 1 || nb_classes > DMA_SCHED_MAX_CLASSES || !cfg[0].own_ctx)
+		return DOCA_ERROR_INVALID_VALUE;
+
+	s = calloc(1, sizeof(*s));
+	if (s == NULL)
+		return DOCA_ERROR_NO_MEMORY;
+	s->pe = pe;
+	s->buf_inv = buf_inv;
+	s->nb_classes = nb_classes;
+
+	for (c = 0; c < nb_classes; c++) {
+		s->classes[c].cfg = cfg[c];
+		if (!cfg[c].own_ctx) {
+			s->classes[c].sctx = s->classes[0].sctx;
+			continue;
+		}
+
+		sctx = &s->ctxs[s->nb_ctxs++];
+		sctx->sched = s;
+		s->classes[c].sctx = sctx;
+		result = doca_dma_create(dev, &sctx->dma);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to create DMA context of class %d: %s", c, doca_error_get_descr(result));
+			goto destroy_sched;
+		}
+		result = doca_dma_task_memcpy_set_conf(sctx->dma, chunk_completed_callback, chunk_error_callback,
+						       DMA_SCHED_MAX_TASKS);
+		if (result == DOCA_SUCCESS) {
+			data.ptr = sctx;
+			result = doca_ctx_set_user_data(doca_dma_as_ctx(sctx->dma), data);
+		}
+		if (result == DOCA_SUCCESS)
+			result = doca_pe_connect_ctx(pe, doca_dma_as_ctx(sctx->dma));
+		if (result == DOCA_SUCCESS)
+			result = doca_ctx_start(doca_dma_as_ctx(sctx->dma));
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to start DMA context of class %d: %s", c, doca_error_get_descr(result));
+			goto destroy_sched;
+		}
+		sctx->ctx = doca_dma_as_ctx(sctx->dma);
+	}
+
+	*sched = s;
+	return DOCA_SUCCESS;
+
+destroy_sched:
+	dma_sched_destroy(s);
+	return result;
+}
+
+doca_error_t
+dma_sched_submit(struct dma_sched *sched, struct dma_sched_req *req)
+{
+	struct sched_class *cls;
+
+	if (req->cls < 0 || req->cls >= sched->nb_classes || req->len == 0)
+		return DOCA_ERROR_INVALID_VALUE;
+
+	cls = &sched->classes[req->cls];
+	req->next_off = 0;
+	req->outstanding = 0;
+	req->result = DOCA_SUCCESS;
+	req->next = NULL;
+	if (cls->tail != NULL)
+		cls->tail->next = req;
+	else
+		cls->head = req;
+	cls->tail = req;
+	sched->pending++;
+	return DOCA_SUCCESS;
+}
+
+doca_error_t
+dma_sched_progress(struct dma_sched *sched)
+{
+	doca_error_t result;
+	int c;
+
+	for (c = 0; c < sched->nb_classes; c++) {
+		result = pump_class(sched, c);
+		if (result != DOCA_SUCCESS)
+			return result;
+	}
+	(void)doca_pe_progress(sched->pe);
+	return DOCA_SUCCESS;
+}
+
+uint64_t
+dma_sched_pending(const struct dma_sched *sched)
+{
+	return sched->pending;
+}
+
+void
+dma_sched_get_stats(const struct dma_sched *sched, struct dma_sched_stats *stats)
+{
+	*stats = sched->stats;
+}
+
+doca_error_t
+dma_sched_destroy(struct dma_sched *sched)
+{
+	doca_error_t result = DOCA_SUCCESS, tmp_result;
+	int i;
+
+	for (i = 0; i < sched->nb_ctxs; i++) {
+		if (sched->ctxs[i].ctx != NULL) {
+			tmp_result = request_stop_ctx(sched->pe, sched->ctxs[i].ctx);
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+		}
+		if (sched->ctxs[i].dma != NULL) {
+			tmp_result = doca_dma_destroy(sched->ctxs[i].dma);
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+		}
+	}
+	free(sched);
+	return result;
+}
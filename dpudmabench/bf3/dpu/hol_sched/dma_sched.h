@@ -0,0 +1,137 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+#ifndef DMA_SCHED_H_
+#define DMA_SCHED_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <doca_buf_inventory.h>
+#include <doca_dev.h>
+#include <doca_dma.h>
+#include <doca_error.h>
+#include <doca_mmap.h>
+#include <doca_pe.h>
+
+/*
+ * Latency-class-aware DMA scheduler
+ *
+ * Requests are queued in software per latency class and pumped into DOCA DMA tasks by dma_sched_progress().
+ * Every class can either own a DMA context, so its tasks sit in their own hardware queue, or share the context of
+ * another class. Large requests of a class are split into chunks of at most split bytes and a class never has more
+ * than max_inflight bytes submitted, so a small request of a higher class waits behind at most max_inflight bytes
+ * instead of a whole bulk transfer. Classes are pumped in index order, class 0 first.
+ */
+
+#define DMA_SCHED_MAX_CLASSES 4		/* Largest number of latency classes */
+#define DMA_SCHED_MAX_TASKS 64		/* Tasks per DMA context */
+
+struct dma_sched_req;
+
+/*
+ * Request completion callback, called from dma_sched_progress() once every chunk has completed
+ *
+ * @req [in]: completed request, req->result holds the first chunk error
+ */
+typedef void (*dma_sched_done_cb)(struct dma_sched_req *req);
+
+/* One transfer, owned by the caller until its done callback */
+struct dma_sched_req {
+	struct doca_mmap *src_mmap;	/* mmap of the source */
+	struct doca_mmap *dst_mmap;	/* mmap of the destination */
+	char *src;			/* Source address */
+	char *dst;			/* Destination address */
+	size_t len;			/* Transfer length */
+	int cls;			/* Latency class */
+	dma_sched_done_cb done;		/* Completion callback */
+	void *user;			/* Free for the caller */
+	/* Scheduler state */
+	size_t next_off;		/* First byte not submitted yet */
+	uint32_t outstanding;		/* Chunks submitted and not completed */
+	doca_error_t result;		/* First chunk error */
+	struct dma_sched_req *next;	/* Class queue */
+};
+
+/* Configuration of one class */
+struct dma_sched_class_cfg {
+	int own_ctx;			/* 1: own DMA context, 0: share the context of class 0 */
+	size_t split;			/* Largest chunk, 0 does not split */
+	size_t max_inflight;		/* Largest number of submitted bytes, 0 is unlimited */
+};
+
+/* Scheduler counters */
+struct dma_sched_stats {
+	uint64_t reqs[DMA_SCHED_MAX_CLASSES];		/* Completed requests */
+	uint64_t chunks[DMA_SCHED_MAX_CLASSES];		/* Completed chunks */
+	uint64_t bytes[DMA_SCHED_MAX_CLASSES];		/* Completed bytes */
+	uint64_t throttled[DMA_SCHED_MAX_CLASSES];	/* Pumps stopped by max_inflight or the task limit */
+};
+
+struct dma_sched;
+
+/*
+ * Create a scheduler and start its DMA contexts on a PE
+ *
+ * @dev [in]: DMA capable device
+ * @pe [in]: progress engine, only progressed through dma_sched_progress()
+ * @buf_inv [in]: started inventory with two buffers per task of every context
+ * @cfg [in]: configuration of every class, cfg[0].own_ctx must be 1
+ * @nb_classes [in]: number of classes
+ * @sched [out]: scheduler
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t dma_sched_create(struct doca_dev *dev, struct doca_pe *pe, struct doca_buf_inventory *buf_inv,
+			      const struct dma_sched_class_cfg *cfg, int nb_classes, struct dma_sched **sched);
+
+/*
+ * Queue a request, nothing is submitted before the next dma_sched_progress()
+ *
+ * @sched [in]: scheduler
+ * @req [in]: request, everything up to user set
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR_INVALID_VALUE for an unknown class or an empty request
+ */
+doca_error_t dma_sched_submit(struct dma_sched *sched, struct dma_sched_req *req);
+
+/*
+ * Submit queued chunks class by class within their limits, then progress the PE once
+ *
+ * @sched [in]: scheduler
+ * @return: DOCA_SUCCESS on success and the DOCA error of a failed submission otherwise
+ */
+doca_error_t dma_sched_progress(struct dma_sched *sched);
+
+/*
+ * Number of requests queued or in flight
+ *
+ * @sched [in]: scheduler
+ * @return: number of requests not completed
+ */
+uint64_t dma_sched_pending(const struct dma_sched *sched);
+
+/*
+ * Scheduler counters
+ *
+ * @sched [in]: scheduler
+ * @stats [out]: counters
+ */
+void dma_sched_get_stats(const struct dma_sched *sched, struct dma_sched_stats *stats);
+
+/*
+ * Stop the contexts and destroy the scheduler, every request must have completed
+ *
+ * @sched [in]: scheduler
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t dma_sched_destroy(struct dma_sched *sched);
+
+#endif
@@ -0,0 +1,475 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <doca_buf_inventory.h>
+#include <doca_dev.h>
+#include <doca_dma.h>
+#include <doca_error.h>
+#include <doca_log.h>
+#include <doca_mmap.h>
+#include <doca_pe.h>
+
+#include "dma_common.h"
+#include "dma_sched.h"
+
+DOCA_LOG_REGISTER(HOL_SCHED_DPU);
+
+#define RECV_BUF_SIZE 256		/* Buffer which contains config information */
+#define MAX_DESC_SIZE 1024		/* Maximum size of the export descriptor */
+#define BULK_SIZE (8UL << 20)		/* Size of one bulk copy */
+#define BULK_DEPTH 4			/* Bulk copies kept queued */
+#define PROBE_SIZE 64			/* Size of a latency-critical probe */
+#define PROBES 5000			/* Probes per mode */
+#define PROBE_GAP_NS 20000		/* Idle time between a probe completion and the next probe */
+#define WARMUP_NS 100000000		/* Bulk-only time before the first probe */
+#define CHUNK_SIZE (256UL << 10)	/* Bulk chunk of the split modes */
+#define BULK_BUDGET (1UL << 20)		/* Bulk bytes in flight of the split modes */
+#define LOCAL_LEN (BULK_DEPTH * BULK_SIZE + PROBE_SIZE)	/* DPU buffer, probes land after the bulk slots */
+
+/* Classes of the workload */
+enum { CLS_PROBE, CLS_BULK };
+
+/* One scheduler configuration */
+struct hol_mode {
+	const char *name;			/* Mode name */
+	int with_bulk;				/* 0 measures probes alone */
+	int nb_classes;				/* 1: probes and bulk share the class (FIFO) */
+	struct dma_sched_class_cfg cfg[2];	/* Probe and bulk class */
+};
+
+static const struct hol_mode modes[] = {
+	/* Probes alone, the reference latency */
+	{"idle", 0, 1, {{1, 0, 0}}},
+	/* One context and one FIFO, whole bulk copies: what the benchmarks do today */
+	{"shared", 1, 1, {{1, 0, 0}}},
+	/* One context, probes first in software, bulk split and capped */
+	{"split", 1, 2, {{1, 0, 0}, {0, CHUNK_SIZE, BULK_BUDGET}}},
+	/* A context per class, whole bulk copies */
+	{"classes", 1, 2, {{1, 0, 0}, {1, 0, 0}}},
+	/* A context per class, bulk split and capped */
+	{"classes+split", 1, 2, {{1, 0, 0}, {1, CHUNK_SIZE, BULK_BUDGET}}},
+};
+#define NB_MODES (sizeof(modes) / sizeof(modes[0]))
+
+/* State of one run */
+struct hol_run {
+	struct dma_sched *sched;		/* Scheduler of the mode */
+	struct dma_sched_req bulk[BULK_DEPTH];	/* Bulk copies, resubmitted while running */
+	struct dma_sched_req probe;		/* Probe */
+	int running;				/* Bulk copies are resubmitted while set */
+	int probe_done;				/* Set by the probe completion */
+	uint64_t bulk_bytes;			/* Bulk bytes completed */
+	doca_error_t result;			/* First request error */
+};
+
+/* Per-mode summary */
+struct hol_stats {
+	double avg_us, p50_us, p99_us, p999_us, max_us;	/* Probe latency */
+	double bulk_gbps;				/* Bulk throughput while probing */
+};
+
+/*
+ * Saves export descriptor and buffer information content into memory buffers
+ *
+ * @export_desc_file_path [in]: Export descriptor file path
+ * @buffer_info_file_path [in]: Buffer information file path
+ * @export_desc [in]: Export descriptor buffer
+ * @export_desc_len [in]: Export descriptor buffer length
+ * @remote_addr [in]: Remote buffer address
+ * @remote_addr_len [in]: Remote buffer total length
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+save_config_info_to_buffers(const char *export_desc_file_path, const char *buffer_info_file_path, char *export_desc,
+			    size_t *export_desc_len, char **remote_addr, size_t *remote_addr_len)
+{
+	FILE *fp;
+	long file_size;
+	char buffer[RECV_BUF_SIZE];
+
+	fp = fopen(export_desc_file_path, "r");
+	if (fp == NULL) {
+		DOCA_LOG_ERR("Failed to open %s", export_desc_file_path);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	if (fseek(fp, 0, SEEK_END) != 0) {
+		DOCA_LOG_ERR("Failed to calculate file size");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	file_size = ftell(fp);
+	if (file_size == -1) {
+		DOCA_LOG_ERR("Failed to calculate file size");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	if (file_size > MAX_DESC_SIZE)
+		file_size = MAX_DESC_SIZE;
+
+	*export_desc_len = file_size;
+
+	if (fseek(fp, 0L, SEEK_SET) != 0) {
+		DOCA_LOG_ERR("Failed to calculate file size");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	if (fread(export_desc, 1, file_size, fp) != (size_t)file_size) {
+		DOCA_LOG_ERR("Failed to read the export descriptor");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	fclose(fp);
+
+	/* Read source buffer information from file */
+	fp = fopen(buffer_info_file_path, "r");
+	if (fp == NULL) {
+		DOCA_LOG_ERR("Failed to open %s", buffer_info_file_path);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	/* Get source buffer address */
+	if (fgets(buffer, RECV_BUF_SIZE, fp) == NULL) {
+		DOCA_LOG_ERR("Failed to read the source (host) buffer address");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+	*remote_addr = (char *)strtoull(buffer, NULL, 0);
+
+	memset(buffer, 0, RECV_BUF_SIZE);
+
+	/* Get source buffer length */
+	if (fgets(buffer, RECV_BUF_SIZE, fp) == NULL) {
+		DOCA_LOG_ERR("Failed to read the source (host) buffer length");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+	*remote_addr_len = strtoull(buffer, NULL, 0);
+
+	fclose(fp);
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Elapsed time between two timestamps
+ *
+ * @start [in]: start timestamp
+ * @end [in]: end timestamp
+ * @return: elapsed time in nanoseconds
+ */
+static double
+elapsed_ns(const struct timespec *start, const struct timespec *end)
+{
+	return (end->tv_sec - start->tv_sec) * 1e9 + (end->tv_nsec - start->tv_nsec);
+}
+
+/*
+ * Bulk copy completion, queues the same copy again while the run lasts
+ *
+ * @req [in]: completed bulk copy
+ */
+static void
+bulk_done(struct dma_sched_req *req)
+{
+	struct hol_run *run = (struct hol_run *)req->user;
+
+	if (req->result != DOCA_SUCCESS) {
+		if (run->result == DOCA_SUCCESS)
+			run->result = req->result;
+		return;
+	}
+	run->bulk_bytes += req->len;
+	if (run->running && run->result == DOCA_SUCCESS)
+		run->result = dma_sched_submit(run->sched, req);
+}
+
+/*
+ * Probe completion
+ *
+ * @req [in]: completed probe
+ */
+static void
+probe_done(struct dma_sched_req *req)
+{
+	struct hol_run *run = (struct hol_run *)req->user;
+
+	if (req->result != DOCA_SUCCESS && run->result == DOCA_SUCCESS)
+		run->result = req->result;
+	run->probe_done = 1;
+}
+
+/*
+ * Progress the scheduler for a while
+ *
+ * @run [in]: run state
+ * @ns [in]: time to progress
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+progress_for(struct hol_run *run, double ns)
+{
+	struct timespec start, now;
+	doca_error_t result;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	do {
+		result = dma_sched_progress(run->sched);
+		if (result != DOCA_SUCCESS)
+			return result;
+		clock_gettime(CLOCK_MONOTONIC, &now);
+	} while (elapsed_ns(&start, &now) < ns && run->result == DOCA_SUCCESS);
+	return run->result;
+}
+
+/*
+ * Compare two doubles for qsort
+ *
+ * @a [in]: first value
+ * @b [in]: second value
+ * @return: <0, 0 or >0
+ */
+static int
+cmp_double(const void *a, const void *b)
+{
+	double x = *(const double *)a, y = *(const double *)b;
+
+	return (x > y) - (x < y);
+}
+
+/*
+ * Run one mode: keep the bulk copies queued and time PROBES probes injected into the stream
+ *
+ * @mode [in]: scheduler configuration
+ * @dev [in]: DOCA device
+ * @pe [in]: progress engine
+ * @buf_inv [in]: inventory
+ * @local_mmap [in]: mmap of the DPU buffer
+ * @local [in]: DPU buffer
+ * @remote_mmap [in]: mmap of the host buffer
+ * @remote [in]: host buffer
+ * @lat_ns [in]: PROBES entries of scratch space
+ * @stats [out]: summary
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+run_mode(const struct hol_mode *mode, struct doca_dev *dev, struct doca_pe *pe, struct doca_buf_inventory *buf_inv,
+	 struct doca_mmap *local_mmap, char *local, struct doca_mmap *remote_mmap, char *remote, double *lat_ns,
+	 struct hol_stats *stats)
+{
+	static struct hol_run run;
+	struct timespec t0, t1, start, end;
+	uint64_t bytes_start;
+	doca_error_t result, tmp_result;
+	double sum = 0;
+	int i;
+
+	memset(&run, 0, sizeof(run));
+	result = dma_sched_create(dev, pe, buf_inv, mode->cfg, mode->nb_classes, &run.sched);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create the %s scheduler: %s", mode->name, doca_error_get_descr(result));
+		return result;
+	}
+
+	/* Host to DPU reads: bulk copy i uses slot i on both sides, the probe lands after the bulk slots */
+	run.running = 1;
+	for (i = 0; i < BULK_DEPTH && mode->with_bulk && result == DOCA_SUCCESS; i++) {
+		run.bulk[i] = (struct dma_sched_req){
+			.src_mmap = remote_mmap, .dst_mmap = local_mmap, .src = remote + i * BULK_SIZE,
+			.dst = local + i * BULK_SIZE, .len = BULK_SIZE, .cls = mode->nb_classes > 1 ? CLS_BULK : CLS_PROBE,
+			.done = bulk_done, .user = &run,
+		};
+		result = dma_sched_submit(run.sched, &run.bulk[i]);
+	}
+	if (result == DOCA_SUCCESS && mode->with_bulk)
+		result = progress_for(&run, WARMUP_NS);
+
+	run.probe = (struct dma_sched_req){
+		.src_mmap = remote_mmap, .dst_mmap = local_mmap, .src = remote, .dst = local + BULK_DEPTH * BULK_SIZE,
+		.len = PROBE_SIZE, .cls = CLS_PROBE, .done = probe_done, .user = &run,
+	};
+	bytes_start = run.bulk_bytes;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < PROBES && result == DOCA_SUCCESS; i++) {
+		result = progress_for(&run, PROBE_GAP_NS);
+		if (result != DOCA_SUCCESS)
+			break;
+		run.probe_done = 0;
+		clock_gettime(CLOCK_MONOTONIC, &t0);
+		result = dma_sched_submit(run.sched, &run.probe);
+		while (result == DOCA_SUCCESS && !run.probe_done)
+			result = dma_sched_progress(run.sched);
+		clock_gettime(CLOCK_MONOTONIC, &t1);
+		if (result == DOCA_SUCCESS)
+			result = run.result;
+		lat_ns[i] = elapsed_ns(&t0, &t1);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	stats->bulk_gbps = (run.bulk_bytes - bytes_start) / elapsed_ns(&start, &end);
+
+	/* Let the bulk copies drain before the contexts are stopped */
+	run.running = 0;
+	while (dma_sched_pending(run.sched) > 0) {
+		tmp_result = dma_sched_progress(run.sched);
+		if (tmp_result != DOCA_SUCCESS) {
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+			break;
+		}
+	}
+	tmp_result = dma_sched_destroy(run.sched);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Mode %s failed: %s", mode->name, doca_error_get_descr(result));
+		return result;
+	}
+
+	for (i = 0; i < PROBES; i++)
+		sum += lat_ns[i];
+	qsort(lat_ns, PROBES, sizeof(*lat_ns), cmp_double);
+	stats->avg_us = sum / PROBES / 1000;
+	stats->p50_us = lat_ns[PROBES / 2] / 1000;
+	stats->p99_us = lat_ns[PROBES * 99 / 100] / 1000;
+	stats->p999_us = lat_ns[PROBES * 999 / 1000] / 1000;
+	stats->max_us = lat_ns[PROBES - 1] / 1000;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Run DOCA DMA head-of-line blocking benchmark on the DPU
+ *
+ * @export_desc_file_path [in]: Export descriptor file path
+ * @buffer_info_file_path [in]: Buffer info file path
+ * @pcie_addr [in]: Device PCI address
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t
+hol_sched_dpu(const char *export_desc_file_path, const char *buffer_info_file_path, const char *pcie_addr)
+{
+	static double lat_ns[PROBES];
+	struct hol_stats stats, idle = {0};
+	struct doca_dev *dev;
+	struct doca_pe *pe = NULL;
+	struct doca_buf_inventory *buf_inv = NULL;
+	struct doca_mmap *local_mmap = NULL, *remote_mmap = NULL;
+	char export_desc[MAX_DESC_SIZE];
+	size_t export_desc_len, remote_len;
+	char *local = NULL, *remote;
+	doca_error_t result, tmp_result;
+	size_t m;
+
+	result = save_config_info_to_buffers(export_desc_file_path, buffer_info_file_path, export_desc,
+					     &export_desc_len, &remote, &remote_len);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to read memory configuration from file: %s", doca_error_get_descr(result));
+		return result;
+	}
+	if (remote_len < BULK_DEPTH * BULK_SIZE) {
+		DOCA_LOG_ERR("Host buffer must hold at least %lu bytes", BULK_DEPTH * BULK_SIZE);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	result = open_doca_device_with_pci(pcie_addr, &dma_task_is_supported, &dev);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to open DOCA device: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	local = malloc(LOCAL_LEN);
+	if (local == NULL) {
+		DOCA_LOG_ERR("Failed to allocate the DPU buffer");
+		result = DOCA_ERROR_NO_MEMORY;
+		goto destroy_objects;
+	}
+	memset(local, 0, LOCAL_LEN);
+
+	result = doca_mmap_create(&local_mmap);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_add_dev(local_mmap, dev);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_set_memrange(local_mmap, local, LOCAL_LEN);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_start(local_mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start local mmap: %s", doca_error_get_descr(result));
+		goto destroy_objects;
+	}
+
+	result = doca_mmap_create_from_export(NULL, export_desc, export_desc_len, dev, &remote_mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create mmap from export: %s", doca_error_get_descr(result));
+		goto destroy_objects;
+	}
+
+	/* Two buffers for every task of up to two contexts */
+	result = doca_buf_inventory_create(4 * DMA_SCHED_MAX_TASKS, &buf_inv);
+	if (result == DOCA_SUCCESS)
+		result = doca_buf_inventory_start(buf_inv);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start buffer inventory: %s", doca_error_get_descr(result));
+		goto destroy_objects;
+	}
+
+	result = doca_pe_create(&pe);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create progress engine: %s", doca_error_get_descr(result));
+		goto destroy_objects;
+	}
+
+	printf("%d-byte probes every %d us into %d queued %lu MB host-to-DPU reads, chunk %lu KB, bulk budget %lu KB\n",
+	       PROBE_SIZE, PROBE_GAP_NS / 1000, BULK_DEPTH, BULK_SIZE >> 20, CHUNK_SIZE >> 10, BULK_BUDGET >> 10);
+	printf("Mode\t\t Avg(us)\t p50(us)\t p99(us)\t p99.9(us)\t Max(us)\t p99 inflation\t Bulk(GB/s)\n");
+	for (m = 0; m < NB_MODES; m++) {
+		result = run_mode(&modes[m], dev, pe, buf_inv, local_mmap, local, remote_mmap, remote, lat_ns, &stats);
+		if (result != DOCA_SUCCESS)
+			break;
+		if (m == 0)
+			idle = stats;
+		printf("%-14s\t %7.2f\t %7.2f\t %7.2f\t %9.2f\t %7.2f\t %12.1fx\t %10.3f\n", modes[m].name,
+		       stats.avg_us, stats.p50_us, stats.p99_us, stats.p999_us, stats.max_us, stats.p99_us / idle.p99_us,
+		       stats.bulk_gbps);
+		fflush(stdout);
+	}
+
+destroy_objects:
+	if (pe != NULL) {
+		tmp_result = doca_pe_destroy(pe);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+	if (buf_inv != NULL) {
+		tmp_result = doca_buf_inventory_stop(buf_inv);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+		tmp_result = doca_buf_inventory_destroy(buf_inv);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+	if (remote_mmap != NULL) {
+		tmp_result = doca_mmap_destroy(remote_mmap);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+	if (local_mmap != NULL) {
+		tmp_result = doca_mmap_destroy(local_mmap);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+	free(local);
+	tmp_result = doca_dev_close(dev);
+	DOCA_ERROR_PROPAGATE(result, tmp_result);
+	return result;
+}
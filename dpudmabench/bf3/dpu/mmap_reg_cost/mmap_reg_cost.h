@@ -0,0 +1,36 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+#ifndef MMAP_REG_COST_H_
+#define MMAP_REG_COST_H_
+
+#include <stdint.h>
+
+/*
+ * Export descriptor file written by host/mmap_reg_cost and read by dpu/mmap_reg_cost
+ *
+ * uint64_t magic, uint64_t number of regions, then for every region:
+ * uint64_t region length, uint64_t descriptor length, descriptor bytes.
+ */
+#define REG_DESC_MAGIC 0x444d4d5052454731ULL	/* "DMMPREG1" */
+#define REG_MIN_SIZE 4096UL			/* Smallest region of the sweep */
+#define REG_SIZE_STEP 4				/* Region size multiplier of the sweep */
+
+/* Time spent in every control-path step of one region, in nanoseconds */
+struct reg_times {
+	double create;		/* doca_mmap_create + doca_mmap_add_dev (+ permissions) */
+	double memrange;	/* doca_mmap_set_memrange */
+	double start;		/* doca_mmap_start, pins and registers the pages */
+	double export_pci;	/* doca_mmap_export_pci on the host, doca_mmap_create_from_export on the DPU */
+	double destroy;		/* doca_mmap_destroy */
+};
+
+#endif
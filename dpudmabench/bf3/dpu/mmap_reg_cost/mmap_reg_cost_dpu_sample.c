@@ -0,0 +1,259 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+
+#include <doca_dev.h>
+#include <doca_error.h>
+#include <doca_log.h>
+#include <doca_mmap.h>
+
+#include "dma_common.h"
+#include "mmap_reg_cost.h"
+
+DOCA_LOG_REGISTER(MMAP_REG_COST_DPU);
+
+#define IMPORT_REPS 100		/* doca_mmap_create_from_export repetitions per region */
+#define MAX_REGIONS 64		/* Maximum number of regions in the descriptor file */
+
+/* One region exported by the host */
+struct remote_region {
+	uint64_t len;		/* Region length */
+	uint64_t desc_len;	/* Export descriptor length */
+	void *desc;		/* Export descriptor */
+};
+
+/*
+ * Elapsed time between two timestamps
+ *
+ * @start [in]: start timestamp
+ * @end [in]: end timestamp
+ * @return: elapsed time in nanoseconds
+ */
+static double
+elapsed_ns(const struct timespec *start, const struct timespec *end)
+{
+	return (end->tv_sec - start->tv_sec) * 1e9 + (end->tv_nsec - start->tv_nsec);
+}
+
+/*
+ * Read the export descriptors written by the host
+ *
+ * @path [in]: descriptor file, see mmap_reg_cost.h
+ * @regions [out]: regions, at least MAX_REGIONS entries
+ * @nb_regions [out]: number of regions
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+read_regions(const char *path, struct remote_region *regions, int *nb_regions)
+{
+	uint64_t header[2], record[2];
+	doca_error_t result = DOCA_SUCCESS;
+	FILE *fp;
+	int i;
+
+	*nb_regions = 0;
+	fp = fopen(path, "rb");
+	if (fp == NULL) {
+		DOCA_LOG_ERR("Failed to open %s", path);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	if (fread(header, sizeof(header), 1, fp) != 1 || header[0] != REG_DESC_MAGIC || header[1] > MAX_REGIONS) {
+		DOCA_LOG_ERR("%s is not a registration cost descriptor file", path);
+		fclose(fp);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	for (i = 0; i < (int)header[1]; i++) {
+		if (fread(record, sizeof(record), 1, fp) != 1) {
+			result = DOCA_ERROR_IO_FAILED;
+			break;
+		}
+		regions[i].len = record[0];
+		regions[i].desc_len = record[1];
+		regions[i].desc = malloc(record[1]);
+		if (regions[i].desc == NULL) {
+			result = DOCA_ERROR_NO_MEMORY;
+			break;
+		}
+		*nb_regions = i + 1;
+		if (fread(regions[i].desc, 1, record[1], fp) != record[1]) {
+			result = DOCA_ERROR_IO_FAILED;
+			break;
+		}
+	}
+
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Failed to read region %d from %s", i, path);
+	fclose(fp);
+	return result;
+}
+
+/*
+ * Measure importing every host region
+ *
+ * @dev [in]: DOCA device
+ * @regions [in]: regions exported by the host
+ * @nb_regions [in]: number of regions
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+measure_import(struct doca_dev *dev, const struct remote_region *regions, int nb_regions)
+{
+	struct timespec ts[3];
+	struct reg_times t;
+	struct doca_mmap *mmap;
+	doca_error_t result;
+	int i, rep;
+
+	printf("\nImport cost per region (us)\n");
+	printf("%12s\t %18s\t %11s\n", "Region size", "create_from_export", "destroy");
+	for (i = 0; i < nb_regions; i++) {
+		memset(&t, 0, sizeof(t));
+		for (rep = 0; rep < IMPORT_REPS; rep++) {
+			clock_gettime(CLOCK_MONOTONIC, &ts[0]);
+			result = doca_mmap_create_from_export(NULL, regions[i].desc, regions[i].desc_len, dev, &mmap);
+			clock_gettime(CLOCK_MONOTONIC, &ts[1]);
+			if (result != DOCA_SUCCESS) {
+				DOCA_LOG_ERR("Failed to create mmap from export: %s", doca_error_get_descr(result));
+				return result;
+			}
+			result = doca_mmap_destroy(mmap);
+			clock_gettime(CLOCK_MONOTONIC, &ts[2]);
+			if (result != DOCA_SUCCESS) {
+				DOCA_LOG_ERR("Failed to destroy mmap: %s", doca_error_get_descr(result));
+				return result;
+			}
+			t.export_pci += elapsed_ns(&ts[0], &ts[1]);
+			t.destroy += elapsed_ns(&ts[1], &ts[2]);
+		}
+		printf("%12lu\t %18.2f\t %11.2f\n", (unsigned long)regions[i].len, t.export_pci / IMPORT_REPS / 1000,
+		       t.destroy / IMPORT_REPS / 1000);
+		fflush(stdout);
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Measure registering DPU memory of the same sizes, as done for the local buffer of every benchmark
+ *
+ * @dev [in]: DOCA device
+ * @regions [in]: regions exported by the host, only their sizes are used
+ * @nb_regions [in]: number of regions
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+measure_local(struct doca_dev *dev, const struct remote_region *regions, int nb_regions)
+{
+	struct timespec ts[5];
+	struct reg_times t;
+	struct doca_mmap *local_mmap;
+	doca_error_t result;
+	int i, rep, reps;
+	void *mem;
+
+	printf("\nLocal registration cost per region (us), page size: 4 KB\n");
+	printf("%12s\t %10s\t %12s\t %9s\t %11s\t %9s\n", "Region size", "create", "set_memrange", "start", "destroy",
+	       "total");
+	for (i = 0; i < nb_regions; i++) {
+		mem = mmap(NULL, regions[i].len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1,
+			   0);
+		if (mem == MAP_FAILED) {
+			printf("%12lu\t skipped, failed to allocate\n", (unsigned long)regions[i].len);
+			continue;
+		}
+
+		memset(&t, 0, sizeof(t));
+		reps = regions[i].len <= (16UL << 20) ? 100 : 3;
+		for (rep = 0; rep < reps; rep++) {
+			clock_gettime(CLOCK_MONOTONIC, &ts[0]);
+			result = doca_mmap_create(&local_mmap);
+			if (result != DOCA_SUCCESS)
+				break;
+			result = doca_mmap_add_dev(local_mmap, dev);
+			clock_gettime(CLOCK_MONOTONIC, &ts[1]);
+			if (result == DOCA_SUCCESS)
+				result = doca_mmap_set_memrange(local_mmap, mem, regions[i].len);
+			clock_gettime(CLOCK_MONOTONIC, &ts[2]);
+			if (result == DOCA_SUCCESS)
+				result = doca_mmap_start(local_mmap);
+			clock_gettime(CLOCK_MONOTONIC, &ts[3]);
+			DOCA_ERROR_PROPAGATE(result, doca_mmap_destroy(local_mmap));
+			clock_gettime(CLOCK_MONOTONIC, &ts[4]);
+			if (result != DOCA_SUCCESS)
+				break;
+			t.create += elapsed_ns(&ts[0], &ts[1]);
+			t.memrange += elapsed_ns(&ts[1], &ts[2]);
+			t.start += elapsed_ns(&ts[2], &ts[3]);
+			t.destroy += elapsed_ns(&ts[3], &ts[4]);
+		}
+		munmap(mem, regions[i].len);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to register local region: %s", doca_error_get_descr(result));
+			return result;
+		}
+
+		printf("%12lu\t %10.2f\t %12.2f\t %9.2f\t %11.2f\t %9.2f\n", (unsigned long)regions[i].len,
+		       t.create / reps / 1000, t.memrange / reps / 1000, t.start / reps / 1000, t.destroy / reps / 1000,
+		       (t.create + t.memrange + t.start + t.destroy) / reps / 1000);
+		fflush(stdout);
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Run DOCA mmap import and registration cost benchmark on the DPU
+ *
+ * @export_desc_file_path [in]: Export descriptor file path
+ * @pcie_addr [in]: Device PCI address
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t
+mmap_reg_cost_dpu(const char *export_desc_file_path, const char *pcie_addr)
+{
+	struct remote_region regions[MAX_REGIONS];
+	struct doca_dev *dev;
+	doca_error_t result, tmp_result;
+	int i, nb_regions;
+
+	result = read_regions(export_desc_file_path, regions, &nb_regions);
+	if (result != DOCA_SUCCESS)
+		goto free_regions;
+
+	result = open_doca_device_with_pci(pcie_addr, &dma_task_is_supported, &dev);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to open DOCA device: %s", doca_error_get_descr(result));
+		goto free_regions;
+	}
+
+	result = measure_import(dev, regions, nb_regions);
+	if (result == DOCA_SUCCESS)
+		result = measure_local(dev, regions, nb_regions);
+
+	tmp_result = doca_dev_close(dev);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+		DOCA_LOG_ERR("Failed to close DOCA device: %s", doca_error_get_descr(tmp_result));
+	}
+
+free_regions:
+	for (i = 0; i < nb_regions; i++)
+		free(regions[i].desc);
+	return result;
+}
@@ -0,0 +1,32 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+#ifndef MULTI_DEV_H_
+#define MULTI_DEV_H_
+
+#include "dma_common.h"
+
+/*
+ * Every device of the list gets its own host buffer and export, written to
+ * <descriptor path>.<index> and <buffer path>.<index>. Index i of the host list
+ * is imported by index i of the DPU list, so both lists must be in the same order.
+ */
+#define MAX_DEVS 4		/* Largest number of devices */
+#define DEV_LIST_SEP ","	/* Separator of the device list */
+
+/* Configuration struct, dma_conf comes first so the dma_common ARGP callbacks can use it */
+struct multi_dev_config {
+	struct dma_config dma_conf;	/* Base of the per-device descriptor and buffer paths */
+	char devs[MAX_ARG_SIZE];	/* Device list, PCI addresses or IB device names */
+};
+
+#endif
@@ -0,0 +1,591 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <doca_buf.h>
+#include <doca_buf_inventory.h>
+#include <doca_ctx.h>
+#include <doca_dev.h>
+#include <doca_dma.h>
+#include <doca_error.h>
+#include <doca_log.h>
+#include <doca_mmap.h>
+#include <doca_pe.h>
+
+#include "multi_dev.h"
+
+DOCA_LOG_REGISTER(MULTI_DEV_DPU);
+
+#define RECV_BUF_SIZE 256		/* Buffer which contains config information */
+#define MAX_DESC_SIZE 1024		/* Maximum size of the export descriptor */
+#define QUEUE_DEPTH 32			/* Outstanding DMAs per device */
+#define MAX_SIZE (1UL << 20)		/* Largest transfer */
+#define LOCAL_LEN (QUEUE_DEPTH * MAX_SIZE)	/* DPU buffer per device, also the smallest host buffer */
+#define TOTAL_BYTES (1UL << 30)		/* Bytes moved per point, striped over the devices */
+
+/* Transfer sizes of the sweep */
+static const size_t sizes[] = {1024, 8192, 65536, MAX_SIZE};
+#define NB_SIZES (sizeof(sizes) / sizeof(sizes[0]))
+
+/* Data-flow direction of a DPU-initiated transfer */
+enum stripe_direction {
+	STRIPE_PULL,	/* DPU reads host memory */
+	STRIPE_PUSH,	/* DPU writes host memory */
+};
+
+/* One device with its own context, PE and host buffer */
+struct lane {
+	const char *name;				/* PCI address or IB device name */
+	struct doca_dev *dev;				/* DOCA device */
+	struct doca_mmap *local_mmap;			/* DPU buffer mmap */
+	struct doca_mmap *remote_mmap;			/* Host buffer mmap, imported through this device */
+	struct doca_buf_inventory *buf_inv;		/* Inventory */
+	struct doca_pe *pe;				/* Progress engine, progressed by the lane thread only */
+	struct doca_dma *dma;				/* DMA context */
+	struct doca_ctx *ctx;				/* DMA context as a generic context, NULL until started */
+	char *local;					/* DPU buffer */
+	char export_desc[MAX_DESC_SIZE];		/* Host export descriptor */
+	size_t export_desc_len;				/* Host export descriptor length */
+	char *remote_addr;				/* Host buffer address */
+	size_t remote_len;				/* Host buffer length */
+	struct doca_dma_task_memcpy *tasks[QUEUE_DEPTH];	/* Tasks of the current point */
+	struct doca_buf *src[QUEUE_DEPTH];		/* Sources of the tasks */
+	struct doca_buf *dst[QUEUE_DEPTH];		/* Destinations of the tasks */
+	uint32_t nb_tasks;				/* Tasks of the current point */
+	uint64_t to_submit;				/* Chunks not submitted yet */
+	uint64_t completed;				/* Chunks completed */
+	uint32_t inflight;				/* Chunks submitted and not completed */
+	doca_error_t task_result;			/* First task error of the point */
+	volatile int *go;				/* Set to 1 once all lane threads exist, -1 to abort */
+	struct timespec start;				/* First submission */
+	struct timespec end;				/* Last completion */
+};
+
+/*
+ * Saves export descriptor and buffer information content into memory buffers
+ *
+ * @export_desc_file_path [in]: Export descriptor file path
+ * @buffer_info_file_path [in]: Buffer information file path
+ * @export_desc [in]: Export descriptor buffer
+ * @export_desc_len [in]: Export descriptor buffer length
+ * @remote_addr [in]: Remote buffer address
+ * @remote_addr_len [in]: Remote buffer total length
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+save_config_info_to_buffers(const char *export_desc_file_path, const char *buffer_info_file_path, char *export_desc,
+			    size_t *export_desc_len, char **remote_addr, size_t *remote_addr_len)
+{
+	FILE *fp;
+	long file_size;
+	char buffer[RECV_BUF_SIZE];
+
+	fp = fopen(export_desc_file_path, "r");
+	if (fp == NULL) {
+		DOCA_LOG_ERR("Failed to open %s", export_desc_file_path);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	if (fseek(fp, 0, SEEK_END) != 0) {
+		DOCA_LOG_ERR("Failed to calculate file size");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	file_size = ftell(fp);
+	if (file_size == -1) {
+		DOCA_LOG_ERR("Failed to calculate file size");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	if (file_size > MAX_DESC_SIZE)
+		file_size = MAX_DESC_SIZE;
+
+	*export_desc_len = file_size;
+
+	if (fseek(fp, 0L, SEEK_SET) != 0) {
+		DOCA_LOG_ERR("Failed to calculate file size");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	if (fread(export_desc, 1, file_size, fp) != (size_t)file_size) {
+		DOCA_LOG_ERR("Failed to read the export descriptor");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	fclose(fp);
+
+	/* Read source buffer information from file */
+	fp = fopen(buffer_info_file_path, "r");
+	if (fp == NULL) {
+		DOCA_LOG_ERR("Failed to open %s", buffer_info_file_path);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	/* Get source buffer address */
+	if (fgets(buffer, RECV_BUF_SIZE, fp) == NULL) {
+		DOCA_LOG_ERR("Failed to read the source (host) buffer address");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+	*remote_addr = (char *)strtoull(buffer, NULL, 0);
+
+	memset(buffer, 0, RECV_BUF_SIZE);
+
+	/* Get source buffer length */
+	if (fgets(buffer, RECV_BUF_SIZE, fp) == NULL) {
+		DOCA_LOG_ERR("Failed to read the source (host) buffer length");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+	*remote_addr_len = strtoull(buffer, NULL, 0);
+
+	fclose(fp);
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Elapsed time between two timestamps
+ *
+ * @start [in]: start timestamp
+ * @end [in]: end timestamp
+ * @return: elapsed time in nanoseconds
+ */
+static double
+elapsed_ns(const struct timespec *start, const struct timespec *end)
+{
+	return (end->tv_sec - start->tv_sec) * 1e9 + (end->tv_nsec - start->tv_nsec);
+}
+
+/*
+ * Striped DMA completed callback, resubmits the task while the lane has chunks left
+ *
+ * @dma_task [in]: Completed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void
+stripe_completed_callback(struct doca_dma_task_memcpy *dma_task, union doca_data task_user_data,
+			  union doca_data ctx_user_data)
+{
+	struct lane *l = (struct lane *)ctx_user_data.ptr;
+	doca_error_t result;
+
+	(void)task_user_data;
+	l->inflight--;
+	l->completed++;
+	if (l->to_submit == 0 || l->task_result != DOCA_SUCCESS)
+		return;
+
+	result = doca_buf_reset_data_len(doca_dma_task_memcpy_get_dst(dma_task));
+	if (result == DOCA_SUCCESS)
+		result = doca_task_submit(doca_dma_task_memcpy_as_task(dma_task));
+	if (result != DOCA_SUCCESS) {
+		l->task_result = result;
+		return;
+	}
+	l->to_submit--;
+	l->inflight++;
+}
+
+/*
+ * Striped DMA error callback
+ *
+ * @dma_task [in]: failed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void
+stripe_error_callback(struct doca_dma_task_memcpy *dma_task, union doca_data task_user_data,
+		      union doca_data ctx_user_data)
+{
+	struct lane *l = (struct lane *)ctx_user_data.ptr;
+
+	(void)task_user_data;
+	l->inflight--;
+	if (l->task_result == DOCA_SUCCESS)
+		l->task_result = doca_task_get_status(doca_dma_task_memcpy_as_task(dma_task));
+}
+
+/*
+ * Open a device, import its host buffer and start its own DMA context
+ *
+ * @l [in]: lane, name set
+ * @index [in]: index of the device in the list
+ * @export_desc_file_path [in]: Base of the export descriptor file paths
+ * @buffer_info_file_path [in]: Base of the buffer info file paths
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+lane_setup(struct lane *l, int index, const char *export_desc_file_path, const char *buffer_info_file_path)
+{
+	char desc_path[MAX_ARG_SIZE + 8], info_path[MAX_ARG_SIZE + 8];
+	union doca_data data = {0};
+	doca_error_t result;
+
+	snprintf(desc_path, sizeof(desc_path), "%s.%d", export_desc_file_path, index);
+	snprintf(info_path, sizeof(info_path), "%s.%d", buffer_info_file_path, index);
+	result = save_config_info_to_buffers(desc_path, info_path, l->export_desc, &l->export_desc_len, &l->remote_addr,
+					     &l->remote_len);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to read memory configuration of %s: %s", l->name, doca_error_get_descr(result));
+		return result;
+	}
+	if (l->remote_len < LOCAL_LEN) {
+		DOCA_LOG_ERR("Host buffer of %s must hold at least %lu bytes", l->name, LOCAL_LEN);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	/* PFs are given by PCI address, SFs share their PF's address and are given by IB device name */
+	if (strchr(l->name, ':') != NULL)
+		result = open_doca_device_with_pci(l->name, &dma_task_is_supported, &l->dev);
+	else
+		result = open_doca_device_with_ibdev_name((const uint8_t *)l->name, strlen(l->name),
+							  &dma_task_is_supported, &l->dev);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to open DOCA device %s: %s", l->name, doca_error_get_descr(result));
+		return result;
+	}
+
+	if (posix_memalign((void **)&l->local, 4096, LOCAL_LEN) != 0) {
+		DOCA_LOG_ERR("Failed to allocate the DPU buffer of %s", l->name);
+		l->local = NULL;
+		return DOCA_ERROR_NO_MEMORY;
+	}
+	memset(l->local, 0, LOCAL_LEN);
+
+	result = doca_mmap_create(&l->local_mmap);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_add_dev(l->local_mmap, l->dev);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_set_memrange(l->local_mmap, l->local, LOCAL_LEN);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_start(l->local_mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start local mmap of %s: %s", l->name, doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_buf_inventory_create(2 * QUEUE_DEPTH, &l->buf_inv);
+	if (result == DOCA_SUCCESS)
+		result = doca_buf_inventory_start(l->buf_inv);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start buffer inventory of %s: %s", l->name, doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_pe_create(&l->pe);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create progress engine of %s: %s", l->name, doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_dma_create(l->dev, &l->dma);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create DMA context of %s: %s", l->name, doca_error_get_descr(result));
+		return result;
+	}
+	result = doca_dma_task_memcpy_set_conf(l->dma, stripe_completed_callback, stripe_error_callback, QUEUE_DEPTH);
+	if (result == DOCA_SUCCESS) {
+		data.ptr = l;
+		result = doca_ctx_set_user_data(doca_dma_as_ctx(l->dma), data);
+	}
+	if (result == DOCA_SUCCESS)
+		result = doca_pe_connect_ctx(l->pe, doca_dma_as_ctx(l->dma));
+	if (result == DOCA_SUCCESS)
+		result = doca_ctx_start(doca_dma_as_ctx(l->dma));
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start DMA context of %s: %s", l->name, doca_error_get_descr(result));
+		return result;
+	}
+	l->ctx = doca_dma_as_ctx(l->dma);
+
+	result = doca_mmap_create_from_export(NULL, l->export_desc, l->export_desc_len, l->dev, &l->remote_mmap);
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Failed to import the host buffer through %s: %s", l->name, doca_error_get_descr(result));
+	return result;
+}
+
+/*
+ * Stop the context of a lane and destroy all its objects
+ *
+ * @l [in]: lane
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+lane_destroy(struct lane *l)
+{
+	doca_error_t result = DOCA_SUCCESS;
+
+	if (l->ctx != NULL)
+		DOCA_ERROR_PROPAGATE(result, request_stop_ctx(l->pe, l->ctx));
+	if (l->remote_mmap != NULL)
+		DOCA_ERROR_PROPAGATE(result, doca_mmap_destroy(l->remote_mmap));
+	if (l->dma != NULL)
+		DOCA_ERROR_PROPAGATE(result, doca_dma_destroy(l->dma));
+	if (l->pe != NULL)
+		DOCA_ERROR_PROPAGATE(result, doca_pe_destroy(l->pe));
+	if (l->buf_inv != NULL) {
+		DOCA_ERROR_PROPAGATE(result, doca_buf_inventory_stop(l->buf_inv));
+		DOCA_ERROR_PROPAGATE(result, doca_buf_inventory_destroy(l->buf_inv));
+	}
+	if (l->local_mmap != NULL)
+		DOCA_ERROR_PROPAGATE(result, doca_mmap_destroy(l->local_mmap));
+	free(l->local);
+	if (l->dev != NULL)
+		DOCA_ERROR_PROPAGATE(result, doca_dev_close(l->dev));
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Failed to destroy the objects of %s: %s", l->name, doca_error_get_descr(result));
+	return result;
+}
+
+/*
+ * Release the tasks and buffers of the current point
+ *
+ * @l [in]: lane
+ */
+static void
+lane_release_tasks(struct lane *l)
+{
+	uint32_t i;
+
+	for (i = 0; i < QUEUE_DEPTH; i++) {
+		if (l->tasks[i] != NULL)
+			doca_task_free(doca_dma_task_memcpy_as_task(l->tasks[i]));
+		if (l->src[i] != NULL)
+			doca_buf_dec_refcount(l->src[i], NULL);
+		if (l->dst[i] != NULL)
+			doca_buf_dec_refcount(l->dst[i], NULL);
+		l->tasks[i] = NULL;
+		l->src[i] = NULL;
+		l->dst[i] = NULL;
+	}
+	l->nb_tasks = 0;
+}
+
+/*
+ * Allocate the tasks of one point, every slot owns its own size bytes on both sides
+ *
+ * @l [in]: lane
+ * @size [in]: transfer size
+ * @dir [in]: direction
+ * @chunks [in]: chunks striped to this lane
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+lane_prepare_tasks(struct lane *l, size_t size, enum stripe_direction dir, uint64_t chunks)
+{
+	union doca_data task_data = {0};
+	struct doca_mmap *src_mmap, *dst_mmap;
+	char *src_addr, *dst_addr;
+	doca_error_t result = DOCA_SUCCESS;
+	uint32_t i;
+
+	src_mmap = dir == STRIPE_PULL ? l->remote_mmap : l->local_mmap;
+	dst_mmap = dir == STRIPE_PULL ? l->local_mmap : l->remote_mmap;
+	l->nb_tasks = chunks < QUEUE_DEPTH ? chunks : QUEUE_DEPTH;
+	for (i = 0; i < l->nb_tasks && result == DOCA_SUCCESS; i++) {
+		src_addr = (dir == STRIPE_PULL ? l->remote_addr : l->local) + i * size;
+		dst_addr = (dir == STRIPE_PULL ? l->local : l->remote_addr) + i * size;
+		result = doca_buf_inventory_buf_get_by_addr(l->buf_inv, src_mmap, src_addr, size, &l->src[i]);
+		if (result == DOCA_SUCCESS)
+			result = doca_buf_set_data(l->src[i], src_addr, size);
+		if (result == DOCA_SUCCESS)
+			result = doca_buf_inventory_buf_get_by_addr(l->buf_inv, dst_mmap, dst_addr, size, &l->dst[i]);
+		if (result == DOCA_SUCCESS)
+			result = doca_dma_task_memcpy_alloc_init(l->dma, l->src[i], l->dst[i], task_data, &l->tasks[i]);
+	}
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to allocate the tasks of %s: %s", l->name, doca_error_get_descr(result));
+		lane_release_tasks(l);
+		return result;
+	}
+
+	l->to_submit = chunks;
+	l->completed = 0;
+	l->inflight = 0;
+	l->task_result = DOCA_SUCCESS;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Lane thread, keeps QUEUE_DEPTH chunks in flight on its own device until its share is done
+ *
+ * @arg [in]: lane
+ * @return: NULL
+ */
+static void *
+run_lane(void *arg)
+{
+	struct lane *l = (struct lane *)arg;
+	doca_error_t result;
+	uint32_t i;
+
+	while (*l->go == 0)
+		;
+	if (*l->go < 0)
+		return NULL;
+
+	clock_gettime(CLOCK_MONOTONIC, &l->start);
+	for (i = 0; i < l->nb_tasks; i++) {
+		result = doca_task_submit(doca_dma_task_memcpy_as_task(l->tasks[i]));
+		if (result != DOCA_SUCCESS) {
+			l->task_result = result;
+			break;
+		}
+		l->to_submit--;
+		l->inflight++;
+	}
+	while (l->inflight > 0)
+		(void)doca_pe_progress(l->pe);
+	clock_gettime(CLOCK_MONOTONIC, &l->end);
+	return NULL;
+}
+
+/*
+ * Stripe TOTAL_BYTES over the first nb_lanes devices, chunk c goes to device c % nb_lanes
+ *
+ * @lanes [in]: started lanes
+ * @nb_lanes [in]: devices used by this point
+ * @size [in]: transfer size
+ * @dir [in]: direction
+ * @gbps [out]: throughput of every device
+ * @agg_gbps [out]: aggregate throughput, all bytes over the union of the device windows
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+run_point(struct lane *lanes, int nb_lanes, size_t size, enum stripe_direction dir, double gbps[MAX_DEVS],
+	  double *agg_gbps)
+{
+	pthread_t threads[MAX_DEVS];
+	volatile int go = 0;
+	uint64_t chunks = TOTAL_BYTES / size, bytes = 0;
+	struct timespec first, last;
+	doca_error_t result = DOCA_SUCCESS;
+	int i, nb_prepared = 0, nb_started = 0;
+
+	for (i = 0; i < nb_lanes && result == DOCA_SUCCESS; i++) {
+		result = lane_prepare_tasks(&lanes[i], size, dir, chunks / nb_lanes + ((uint64_t)i < chunks % nb_lanes));
+		if (result == DOCA_SUCCESS)
+			nb_prepared++;
+	}
+	for (i = 0; i < nb_prepared && result == DOCA_SUCCESS; i++) {
+		lanes[i].go = &go;
+		if (pthread_create(&threads[i], NULL, run_lane, &lanes[i]) != 0) {
+			DOCA_LOG_ERR("Failed to create the thread of %s", lanes[i].name);
+			result = DOCA_ERROR_OPERATING_SYSTEM;
+			break;
+		}
+		nb_started++;
+	}
+	go = result == DOCA_SUCCESS ? 1 : -1;
+	for (i = 0; i < nb_started; i++)
+		pthread_join(threads[i], NULL);
+
+	if (result == DOCA_SUCCESS) {
+		first = lanes[0].start;
+		last = lanes[0].end;
+		for (i = 0; i < nb_lanes; i++) {
+			if (lanes[i].task_result != DOCA_SUCCESS) {
+				DOCA_LOG_ERR("DMA on %s failed: %s", lanes[i].name,
+					     doca_error_get_descr(lanes[i].task_result));
+				result = lanes[i].task_result;
+			}
+			gbps[i] = lanes[i].completed * size / elapsed_ns(&lanes[i].start, &lanes[i].end);
+			bytes += lanes[i].completed * size;
+			if (elapsed_ns(&lanes[i].start, &first) > 0)
+				first = lanes[i].start;
+			if (elapsed_ns(&last, &lanes[i].end) > 0)
+				last = lanes[i].end;
+		}
+		*agg_gbps = bytes / elapsed_ns(&first, &last);
+	}
+
+	for (i = 0; i < nb_prepared; i++)
+		lane_release_tasks(&lanes[i]);
+	return result;
+}
+
+/*
+ * Run DOCA multi-device DMA striping sample on the DPU
+ *
+ * @devs [in]: comma separated PCI addresses or IB device names, modified in place
+ * @export_desc_file_path [in]: Base of the export descriptor file paths
+ * @buffer_info_file_path [in]: Base of the buffer info file paths
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t
+multi_dev_dpu(char *devs, const char *export_desc_file_path, const char *buffer_info_file_path)
+{
+	static struct lane lanes[MAX_DEVS];
+	static const char *const dir_names[] = {"read (host to DPU)", "write (DPU to host)"};
+	double gbps[MAX_DEVS], agg_gbps, single_gbps = 0;
+	doca_error_t result = DOCA_SUCCESS, tmp_result;
+	char *tok, *saveptr;
+	int i, k, d, nb_devs = 0;
+	size_t s;
+
+	for (tok = strtok_r(devs, DEV_LIST_SEP, &saveptr); tok != NULL; tok = strtok_r(NULL, DEV_LIST_SEP, &saveptr)) {
+		if (nb_devs == MAX_DEVS) {
+			DOCA_LOG_ERR("At most %d devices are supported", MAX_DEVS);
+			return DOCA_ERROR_INVALID_VALUE;
+		}
+		lanes[nb_devs++].name = tok;
+	}
+	if (nb_devs == 0) {
+		DOCA_LOG_ERR("Empty device list");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	for (i = 0; i < nb_devs && result == DOCA_SUCCESS; i++)
+		result = lane_setup(&lanes[i], i, export_desc_file_path, buffer_info_file_path);
+	if (result != DOCA_SUCCESS)
+		goto destroy_lanes;
+
+	/* Every point first runs on the first device alone, then striped over 2 .. nb_devs devices */
+	for (d = STRIPE_PULL; d <= STRIPE_PUSH && result == DOCA_SUCCESS; d++) {
+		printf("DMA %s, %lu bytes per point, queue depth %d per device\n", dir_names[d], TOTAL_BYTES,
+		       QUEUE_DEPTH);
+		printf("Size\t Devices\t Aggregate(GB/s)\t Scaling\t Per device(GB/s)\n");
+		for (s = 0; s < NB_SIZES && result == DOCA_SUCCESS; s++) {
+			for (k = 1; k <= nb_devs && result == DOCA_SUCCESS; k++) {
+				result = run_point(lanes, k, sizes[s], d, gbps, &agg_gbps);
+				if (result != DOCA_SUCCESS)
+					break;
+				if (k == 1)
+					single_gbps = agg_gbps;
+				printf("%zu\t %d\t\t %12.3f\t\t %.2fx\t\t", sizes[s], k, agg_gbps, agg_gbps / single_gbps);
+				for (i = 0; i < k; i++)
+					printf(" %s=%.3f", lanes[i].name, gbps[i]);
+				printf("\n");
+			}
+		}
+		printf("\n");
+	}
+
+destroy_lanes:
+	for (i = 0; i < nb_devs; i++) {
+		tmp_result = lane_destroy(&lanes[i]);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+	return result;
+}
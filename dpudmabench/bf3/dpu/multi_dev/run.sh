@@ -0,0 +1,29 @@
+# /*
+# * Copyright (c) 2025, University of California, Merced. All rights reserved.
+# *
+# * This file is part of the benchmarking software package developed by
+# * the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+# *
+# * For detailed copyright and licensing information, please refer to the license
+# * file LICENSE in the top level directory.
+# *
+# */
+
+
+# Usage: run.sh [device list] [number of devices]
+# Start host/multi_dev/run.sh 33554432 on the host first with the matching PFs,
+# index i of the host list is imported through index i of the DPU list.
+# For SFs give their IB device names, e.g. run.sh mlx5_2,mlx5_3 2
+devs=${1:-03:00.0,03:00.1}
+nb=${2:-2}
+for i in $(seq 0 $((nb - 1))); do
+	scp <user>@<host>:/tmp/buffer_info.txt.$i .
+	scp <user>@<host>:/tmp/export_desc.txt.$i .
+done
+echo ""
+
+make clean
+make
+echo ""
+
+./doca_multi_dev -l ${devs} -d export_desc.txt -b buffer_info.txt | tee multi_dev.txt
@@ -0,0 +1,502 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+#include <float.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <doca_buf.h>
+#include <doca_buf_inventory.h>
+#include <doca_ctx.h>
+#include <doca_dev.h>
+#include <doca_dma.h>
+#include <doca_error.h>
+#include <doca_log.h>
+#include <doca_mmap.h>
+#include <doca_pe.h>
+
+#include "dma_common.h"
+
+DOCA_LOG_REGISTER(STARTUP_PROFILE_DPU);
+
+#define RECV_BUF_SIZE 256		/* Buffer which contains config information */
+#define MAX_DESC_SIZE 1024		/* Maximum size of the export descriptor */
+#define CYCLES 20			/* Startup/teardown cycles, the first one is cold */
+#define FIRST_DMA_SIZE 64		/* Size of the first DMA of every cycle */
+
+/* Control-path phases of one DMA session, in the order they run */
+enum phase {
+	PH_ENUM,		/* doca_devinfo_create_list + PCI address and DMA capability match */
+	PH_DEV_OPEN,		/* doca_dev_open */
+	PH_MMAP,		/* local doca_mmap create/add_dev/set_memrange/start */
+	PH_INVENTORY,		/* doca_buf_inventory create/start */
+	PH_PE,			/* doca_pe_create */
+	PH_CTX_CREATE,		/* doca_dma_create, task configuration, connect to the PE */
+	PH_CTX_START,		/* doca_ctx_start */
+	PH_IMPORT,		/* doca_mmap_create_from_export of the host buffer */
+	PH_FIRST_DMA,		/* buffers, task allocation, submit and completion of the first DMA */
+	PH_CTX_STOP,		/* task/buffer release and doca_ctx_stop */
+	PH_DESTROY,		/* mmaps, DMA context, PE, inventory and device close */
+	NB_PHASES,
+};
+
+static const char *const phase_names[NB_PHASES] = {
+	"device enumeration", "device open", "mmap create/start", "inventory start", "PE create",
+	"DMA ctx create", "ctx start", "import", "first DMA", "ctx stop", "destroy",
+};
+
+/* Objects of one session */
+struct session {
+	struct doca_devinfo **dev_list;		/* Device list, freed once the device is open */
+	struct doca_devinfo *devinfo;		/* Matching device */
+	struct doca_dev *dev;			/* Opened device */
+	struct doca_mmap *local_mmap;		/* Local buffer mmap */
+	struct doca_mmap *remote_mmap;		/* Host buffer mmap */
+	struct doca_buf_inventory *buf_inv;	/* Inventory */
+	struct doca_pe *pe;			/* Progress engine */
+	struct doca_dma *dma;			/* DMA context */
+	struct doca_ctx *ctx;			/* DMA context as a generic context */
+	struct doca_buf *src;			/* Host side of the first DMA */
+	struct doca_buf *dst;			/* Local side of the first DMA */
+	struct doca_dma_task_memcpy *task;	/* First DMA */
+	int completed;				/* Set by the completion callbacks */
+	doca_error_t task_result;		/* Result of the first DMA */
+};
+
+/* Inputs shared by all cycles */
+struct profile_config {
+	const char *pcie_addr;			/* Device PCI address */
+	char export_desc[MAX_DESC_SIZE];	/* Host export descriptor */
+	size_t export_desc_len;			/* Host export descriptor length */
+	char *remote_addr;			/* Host buffer address */
+	size_t remote_addr_len;			/* Host buffer length */
+	char local_buffer[FIRST_DMA_SIZE];	/* DPU buffer */
+};
+
+/*
+ * Saves export descriptor and buffer information content into memory buffers
+ *
+ * @export_desc_file_path [in]: Export descriptor file path
+ * @buffer_info_file_path [in]: Buffer information file path
+ * @export_desc [in]: Export descriptor buffer
+ * @export_desc_len [in]: Export descriptor buffer length
+ * @remote_addr [in]: Remote buffer address
+ * @remote_addr_len [in]: Remote buffer total length
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+save_config_info_to_buffers(const char *export_desc_file_path, const char *buffer_info_file_path, char *export_desc,
+			    size_t *export_desc_len, char **remote_addr, size_t *remote_addr_len)
+{
+	FILE *fp;
+	long file_size;
+	char buffer[RECV_BUF_SIZE];
+
+	fp = fopen(export_desc_file_path, "r");
+	if (fp == NULL) {
+		DOCA_LOG_ERR("Failed to open %s", export_desc_file_path);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	if (fseek(fp, 0, SEEK_END) != 0) {
+		DOCA_LOG_ERR("Failed to calculate file size");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	file_size = ftell(fp);
+	if (file_size == -1) {
+		DOCA_LOG_ERR("Failed to calculate file size");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	if (file_size > MAX_DESC_SIZE)
+		file_size = MAX_DESC_SIZE;
+
+	*export_desc_len = file_size;
+
+	if (fseek(fp, 0L, SEEK_SET) != 0) {
+		DOCA_LOG_ERR("Failed to calculate file size");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	if (fread(export_desc, 1, file_size, fp) != (size_t)file_size) {
+		DOCA_LOG_ERR("Failed to read the export descriptor");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	fclose(fp);
+
+	/* Read source buffer information from file */
+	fp = fopen(buffer_info_file_path, "r");
+	if (fp == NULL) {
+		DOCA_LOG_ERR("Failed to open %s", buffer_info_file_path);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	/* Get source buffer address */
+	if (fgets(buffer, RECV_BUF_SIZE, fp) == NULL) {
+		DOCA_LOG_ERR("Failed to read the source (host) buffer address");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+	*remote_addr = (char *)strtoull(buffer, NULL, 0);
+
+	memset(buffer, 0, RECV_BUF_SIZE);
+
+	/* Get source buffer length */
+	if (fgets(buffer, RECV_BUF_SIZE, fp) == NULL) {
+		DOCA_LOG_ERR("Failed to read the source (host) buffer length");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+	*remote_addr_len = strtoull(buffer, NULL, 0);
+
+	fclose(fp);
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Elapsed time between two timestamps
+ *
+ * @start [in]: start timestamp
+ * @end [in]: end timestamp
+ * @return: elapsed time in nanoseconds
+ */
+static double
+elapsed_ns(const struct timespec *start, const struct timespec *end)
+{
+	return (end->tv_sec - start->tv_sec) * 1e9 + (end->tv_nsec - start->tv_nsec);
+}
+
+/*
+ * First DMA completed callback
+ *
+ * @dma_task [in]: Completed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void
+first_dma_completed_callback(struct doca_dma_task_memcpy *dma_task, union doca_data task_user_data,
+			     union doca_data ctx_user_data)
+{
+	struct session *s = (struct session *)ctx_user_data.ptr;
+
+	(void)dma_task;
+	(void)task_user_data;
+	s->task_result = DOCA_SUCCESS;
+	s->completed = 1;
+}
+
+/*
+ * First DMA error callback
+ *
+ * @dma_task [in]: failed task
+ * @task_user_data [in]: doca_data from the task
+ * @ctx_user_data [in]: doca_data from the context
+ */
+static void
+first_dma_error_callback(struct doca_dma_task_memcpy *dma_task, union doca_data task_user_data,
+			 union doca_data ctx_user_data)
+{
+	struct session *s = (struct session *)ctx_user_data.ptr;
+
+	(void)task_user_data;
+	s->task_result = doca_task_get_status(doca_dma_task_memcpy_as_task(dma_task));
+	s->completed = 1;
+}
+
+/*
+ * Bring a session up to its first completed DMA, timestamping every phase
+ *
+ * Objects created so far are left in the session for teardown() on failure.
+ *
+ * @cfg [in]: profile inputs
+ * @s [in]: zeroed session
+ * @ns [out]: time of every startup phase
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+startup(struct profile_config *cfg, struct session *s, double ns[NB_PHASES])
+{
+	struct timespec ts[PH_FIRST_DMA + 2];
+	union doca_data data = {0};
+	uint8_t is_addr_equal;
+	uint32_t nb_devs, i;
+	doca_error_t result;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts[PH_ENUM]);
+	result = doca_devinfo_create_list(&s->dev_list, &nb_devs);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to load doca devices list: %s", doca_error_get_descr(result));
+		return result;
+	}
+	for (i = 0; i < nb_devs && s->devinfo == NULL; i++) {
+		is_addr_equal = 0;
+		if (doca_devinfo_is_equal_pci_addr(s->dev_list[i], cfg->pcie_addr, &is_addr_equal) == DOCA_SUCCESS &&
+		    is_addr_equal && dma_task_is_supported(s->dev_list[i]) == DOCA_SUCCESS)
+			s->devinfo = s->dev_list[i];
+	}
+	if (s->devinfo == NULL) {
+		DOCA_LOG_ERR("No DMA capable device at %s", cfg->pcie_addr);
+		return DOCA_ERROR_NOT_FOUND;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &ts[PH_DEV_OPEN]);
+	result = doca_dev_open(s->devinfo, &s->dev);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to open device: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_devinfo_destroy_list(s->dev_list);
+	s->dev_list = NULL;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts[PH_MMAP]);
+	result = doca_mmap_create(&s->local_mmap);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_add_dev(s->local_mmap, s->dev);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_set_memrange(s->local_mmap, cfg->local_buffer, sizeof(cfg->local_buffer));
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_start(s->local_mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start local mmap: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &ts[PH_INVENTORY]);
+	result = doca_buf_inventory_create(2, &s->buf_inv);
+	if (result == DOCA_SUCCESS)
+		result = doca_buf_inventory_start(s->buf_inv);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start buffer inventory: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &ts[PH_PE]);
+	result = doca_pe_create(&s->pe);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create progress engine: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &ts[PH_CTX_CREATE]);
+	result = doca_dma_create(s->dev, &s->dma);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create DMA context: %s", doca_error_get_descr(result));
+		return result;
+	}
+	s->ctx = doca_dma_as_ctx(s->dma);
+	result = doca_dma_task_memcpy_set_conf(s->dma, first_dma_completed_callback, first_dma_error_callback, 1);
+	if (result == DOCA_SUCCESS) {
+		data.ptr = s;
+		result = doca_ctx_set_user_data(s->ctx, data);
+	}
+	if (result == DOCA_SUCCESS)
+		result = doca_pe_connect_ctx(s->pe, s->ctx);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to configure DMA context: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &ts[PH_CTX_START]);
+	result = doca_ctx_start(s->ctx);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start context: %s", doca_error_get_descr(result));
+		s->ctx = NULL;
+		return result;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &ts[PH_IMPORT]);
+	result = doca_mmap_create_from_export(NULL, cfg->export_desc, cfg->export_desc_len, s->dev, &s->remote_mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create mmap from export: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &ts[PH_FIRST_DMA]);
+	result = doca_buf_inventory_buf_get_by_addr(s->buf_inv, s->remote_mmap, cfg->remote_addr, FIRST_DMA_SIZE,
+						    &s->src);
+	if (result == DOCA_SUCCESS)
+		result = doca_buf_set_data(s->src, cfg->remote_addr, FIRST_DMA_SIZE);
+	if (result == DOCA_SUCCESS)
+		result = doca_buf_inventory_buf_get_by_addr(s->buf_inv, s->local_mmap, cfg->local_buffer,
+							    FIRST_DMA_SIZE, &s->dst);
+	if (result == DOCA_SUCCESS)
+		result = doca_dma_task_memcpy_alloc_init(s->dma, s->src, s->dst, data, &s->task);
+	if (result == DOCA_SUCCESS)
+		result = doca_task_submit(doca_dma_task_memcpy_as_task(s->task));
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to submit the first DMA: %s", doca_error_get_descr(result));
+		return result;
+	}
+	while (!s->completed)
+		(void)doca_pe_progress(s->pe);
+	clock_gettime(CLOCK_MONOTONIC, &ts[PH_FIRST_DMA + 1]);
+	if (s->task_result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("First DMA failed: %s", doca_error_get_descr(s->task_result));
+		return s->task_result;
+	}
+
+	for (i = PH_ENUM; i <= PH_FIRST_DMA; i++)
+		ns[i] = elapsed_ns(&ts[i], &ts[i + 1]);
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Stop the context and destroy every object of a session, timestamping both phases
+ *
+ * @s [in]: session
+ * @ns [out]: time of the teardown phases
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+teardown(struct session *s, double ns[NB_PHASES])
+{
+	struct timespec ts[3];
+	enum doca_ctx_states ctx_state;
+	doca_error_t result = DOCA_SUCCESS, tmp_result;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts[0]);
+	if (s->task != NULL)
+		doca_task_free(doca_dma_task_memcpy_as_task(s->task));
+	if (s->src != NULL)
+		DOCA_ERROR_PROPAGATE(result, doca_buf_dec_refcount(s->src, NULL));
+	if (s->dst != NULL)
+		DOCA_ERROR_PROPAGATE(result, doca_buf_dec_refcount(s->dst, NULL));
+	if (s->ctx != NULL) {
+		tmp_result = doca_ctx_stop(s->ctx);
+		if (tmp_result == DOCA_ERROR_IN_PROGRESS) {
+			do {
+				(void)doca_pe_progress(s->pe);
+				tmp_result = doca_ctx_get_state(s->ctx, &ctx_state);
+			} while (tmp_result == DOCA_SUCCESS && ctx_state != DOCA_CTX_STATE_IDLE);
+		}
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &ts[1]);
+	if (s->remote_mmap != NULL)
+		DOCA_ERROR_PROPAGATE(result, doca_mmap_destroy(s->remote_mmap));
+	if (s->dma != NULL)
+		DOCA_ERROR_PROPAGATE(result, doca_dma_destroy(s->dma));
+	if (s->pe != NULL)
+		DOCA_ERROR_PROPAGATE(result, doca_pe_destroy(s->pe));
+	if (s->buf_inv != NULL) {
+		DOCA_ERROR_PROPAGATE(result, doca_buf_inventory_stop(s->buf_inv));
+		DOCA_ERROR_PROPAGATE(result, doca_buf_inventory_destroy(s->buf_inv));
+	}
+	if (s->local_mmap != NULL)
+		DOCA_ERROR_PROPAGATE(result, doca_mmap_destroy(s->local_mmap));
+	if (s->dev != NULL)
+		DOCA_ERROR_PROPAGATE(result, doca_dev_close(s->dev));
+	if (s->dev_list != NULL)
+		doca_devinfo_destroy_list(s->dev_list);
+	clock_gettime(CLOCK_MONOTONIC, &ts[2]);
+
+	ns[PH_CTX_STOP] = elapsed_ns(&ts[0], &ts[1]);
+	ns[PH_DESTROY] = elapsed_ns(&ts[1], &ts[2]);
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Failed to tear down the session: %s", doca_error_get_descr(result));
+	return result;
+}
+
+/*
+ * Print the per-phase breakdown of all cycles
+ *
+ * @ns [in]: phase times of every cycle, cycle 0 is cold
+ * @nb_cycles [in]: number of cycles
+ */
+static void
+report(double ns[][NB_PHASES], int nb_cycles)
+{
+	double sum, min_t, max_t, cold_ttfd = 0, warm_ttfd = 0, cold_down = 0, warm_down = 0;
+	int p, c;
+
+	printf("Phase\t\t\t Cold(us)\t Warm avg(us)\t Warm min(us)\t Warm max(us)\n");
+	for (p = 0; p < NB_PHASES; p++) {
+		sum = 0;
+		min_t = DBL_MAX;
+		max_t = 0;
+		for (c = 1; c < nb_cycles; c++) {
+			sum += ns[c][p];
+			if (ns[c][p] < min_t)
+				min_t = ns[c][p];
+			if (ns[c][p] > max_t)
+				max_t = ns[c][p];
+		}
+		printf("%-20s\t %9.2f\t %12.2f\t %12.2f\t %12.2f\n", phase_names[p], ns[0][p] / 1000,
+		       sum / (nb_cycles - 1) / 1000, min_t / 1000, max_t / 1000);
+		if (p <= PH_FIRST_DMA) {
+			cold_ttfd += ns[0][p];
+			warm_ttfd += sum / (nb_cycles - 1);
+		} else {
+			cold_down += ns[0][p];
+			warm_down += sum / (nb_cycles - 1);
+		}
+	}
+	printf("%-20s\t %9.2f\t %12.2f\n", "time-to-first-DMA", cold_ttfd / 1000, warm_ttfd / 1000);
+	printf("%-20s\t %9.2f\t %12.2f\n", "teardown", cold_down / 1000, warm_down / 1000);
+}
+
+/*
+ * Run DOCA DMA session startup and teardown profiler on the DPU
+ *
+ * @export_desc_file_path [in]: Export descriptor file path
+ * @buffer_info_file_path [in]: Buffer info file path
+ * @pcie_addr [in]: Device PCI address
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t
+startup_profile_dpu(const char *export_desc_file_path, const char *buffer_info_file_path, const char *pcie_addr)
+{
+	static struct profile_config cfg;
+	double ns[CYCLES][NB_PHASES];
+	struct session s;
+	doca_error_t result, tmp_result;
+	int c;
+
+	cfg.pcie_addr = pcie_addr;
+	result = save_config_info_to_buffers(export_desc_file_path, buffer_info_file_path, cfg.export_desc,
+					     &cfg.export_desc_len, &cfg.remote_addr, &cfg.remote_addr_len);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to read memory configuration from file: %s", doca_error_get_descr(result));
+		return result;
+	}
+	if (cfg.remote_addr_len < FIRST_DMA_SIZE) {
+		DOCA_LOG_ERR("Host buffer must hold at least %d bytes", FIRST_DMA_SIZE);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	/* Cycle 0 runs first in the process (cold), the others reuse whatever the libraries and driver cached */
+	for (c = 0; c < CYCLES; c++) {
+		memset(&s, 0, sizeof(s));
+		result = startup(&cfg, &s, ns[c]);
+		tmp_result = teardown(&s, ns[c]);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Startup/teardown cycle %d failed: %s", c, doca_error_get_descr(result));
+			return result;
+		}
+	}
+
+	printf("Startup/teardown breakdown over %d cycles, first DMA of %d bytes (H-to-D read)\n", CYCLES,
+	       FIRST_DMA_SIZE);
+	report(ns, CYCLES);
+	return DOCA_SUCCESS;
+}
@@ -0,0 +1,29 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+#ifndef DMA_CONSUME_H_
+#define DMA_CONSUME_H_
+
+#include <stdint.h>
+
+/*
+ * Layout of the exported host buffer shared by host/dma_consume and dpu/dma_consume.
+ *
+ * The host publishes round n in CONSUME_HOST_SEQ once the payload is in the requested cache state. The DPU reads it
+ * with a DMA read, writes the payload with one DMA write and, after that write has completed, writes n into
+ * CONSUME_DPU_SEQ. The host spins on CONSUME_DPU_SEQ and then consumes the payload.
+ */
+#define CONSUME_HOST_SEQ 0		/* Offset of the round published by the host */
+#define CONSUME_DPU_SEQ 64		/* Offset of the round completed by the DPU, own cacheline */
+#define CONSUME_PAYLOAD 4096		/* Offset of the payload, page aligned */
+#define CONSUME_DONE UINT64_MAX		/* Host sequence value that ends the run */
+
+#endif
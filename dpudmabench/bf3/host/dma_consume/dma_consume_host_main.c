@@ -0,0 +1,116 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <doca_argp.h>
+#include <doca_dev.h>
+#include <doca_log.h>
+
+#include <utils.h>
+
+#include "dma_common.h"
+#include "dma_consume.h"
+
+DOCA_LOG_REGISTER(DMA_CONSUME_HOST::MAIN);
+
+/* Sample's Logic */
+doca_error_t dma_consume_host(const char *pcie_addr, char *buffer, size_t payload_size, int consumer_core,
+			      char *export_desc_file_path, char *buffer_info_file_path);
+
+/*
+ * Sample main function
+ *
+ * @argc [in]: command line arguments size
+ * @argv [in]: array of command line arguments
+ * @return: EXIT_SUCCESS on success and EXIT_FAILURE otherwise
+ */
+int
+main(int argc, char **argv)
+{
+	struct dma_config dma_conf = {0};
+	char *buffer = NULL;
+	size_t length;
+	int consumer_core;
+	doca_error_t result;
+	struct doca_log_backend *sdk_log;
+	int exit_status = EXIT_FAILURE;
+
+	/* Set the default configuration values (Example values) */
+	strcpy(dma_conf.pci_address, "b1:00.0");
+	strcpy(dma_conf.export_desc_path, "/tmp/export_desc.txt");
+	strcpy(dma_conf.buf_info_path, "/tmp/buffer_info.txt");
+
+	/* Register a logger backend */
+	result = doca_log_backend_create_standard();
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+
+	/* Register a logger backend for internal SDK errors and warnings */
+	result = doca_log_backend_create_with_file_sdk(stderr, &sdk_log);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+	result = doca_log_backend_set_sdk_level(sdk_log, DOCA_LOG_LEVEL_WARNING);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+
+	result = doca_argp_init("doca_dma_consume_host", &dma_conf);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to init ARGP resources: %s", doca_error_get_descr(result));
+		goto sample_exit;
+	}
+	result = register_dma_params(true);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register DMA sample parameters: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+	result = doca_argp_start(argc, argv);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to parse sample input: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+#ifndef DOCA_ARCH_HOST
+	DOCA_LOG_ERR("Sample can run only on the Host");
+	goto argp_cleanup;
+#endif
+	/* Payload size and the core of the consumer thread, both set by run.sh */
+	length = 65536;
+	consumer_core = 2;
+
+	/* Control cachelines and the page-aligned payload share one exported buffer */
+	if (posix_memalign((void **)&buffer, CONSUME_PAYLOAD, CONSUME_PAYLOAD + length) != 0) {
+		DOCA_LOG_ERR("Buffer allocation failed");
+		goto argp_cleanup;
+	}
+	memset(buffer, 0, CONSUME_PAYLOAD + length);
+
+	result = dma_consume_host(dma_conf.pci_address, buffer, length, consumer_core, dma_conf.export_desc_path,
+				  dma_conf.buf_info_path);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("dma_consume_host() encountered an error: %s", doca_error_get_descr(result));
+		goto buf_cleanup;
+	}
+
+	exit_status = EXIT_SUCCESS;
+
+buf_cleanup:
+	free(buffer);
+argp_cleanup:
+	doca_argp_destroy();
+sample_exit:
+	if (exit_status == EXIT_SUCCESS)
+		DOCA_LOG_INFO("Sample finished successfully");
+	else
+		DOCA_LOG_INFO("Sample finished with errors");
+	return exit_status;
+}
@@ -0,0 +1,447 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+#define _GNU_SOURCE
+#include <inttypes.h>
+#include <linux/perf_event.h>
+#include <math.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#if defined(__x86_64__)
+#include <emmintrin.h>
+#endif
+
+#include <doca_dma.h>
+#include <doca_error.h>
+#include <doca_log.h>
+#include <doca_mmap.h>
+
+#include "dma_common.h"
+#include "dma_consume.h"
+
+DOCA_LOG_REGISTER(DMA_CONSUME_HOST);
+
+#define ITERATIONS 1000			/* Consumed payloads per cache state */
+#define CACHELINE 64			/* Flush granularity */
+#define EVICT_SIZE (256UL << 20)	/* Larger than the host LLC, streamed to evict the payload */
+
+/* State of the destination lines when the DPU writes them */
+enum consume_mode {
+	CONSUME_COLD,		/* evicted by streaming an unrelated buffer */
+	CONSUME_FLUSHED,	/* written back and invalidated line by line (clflush / dc civac) */
+	CONSUME_WARM,		/* read by the consumer core right before the DMA */
+	CONSUME_NB_MODES,
+};
+
+static const char *const mode_names[CONSUME_NB_MODES] = {"cold", "flushed", "warm"};
+
+static volatile bool stop_consumer;	/* Set on SIGINT/SIGTERM */
+
+/* Hardware counters of the consumer thread, -1 if not available */
+struct consume_counters {
+	int cycles_fd;		/* core cycles */
+	int misses_fd;		/* last level cache read misses */
+};
+
+/* Per-iteration cost of consuming one payload */
+struct consume_sample {
+	double ns;		/* elapsed time */
+	uint64_t cycles;	/* core cycles */
+	uint64_t misses;	/* LLC read misses */
+};
+
+/*
+ * Signal handler
+ *
+ * @signum [in]: Signal number to handle
+ */
+static void
+signal_handler(int signum)
+{
+	if (signum == SIGINT || signum == SIGTERM)
+		stop_consumer = true;
+}
+
+/*
+ * Saves export descriptor and buffer information into two separate files
+ *
+ * @export_desc [in]: Export descriptor to write into a file
+ * @export_desc_len [in]: Export descriptor length
+ * @src_buffer [in]: Source buffer
+ * @src_buffer_len [in]: Source buffer length
+ * @export_desc_file_path [in]: Export descriptor file path
+ * @buffer_info_file_path [in]: Buffer information file path
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+save_config_info_to_files(const void *export_desc, size_t export_desc_len, const char *src_buffer,
+			  size_t src_buffer_len, char *export_desc_file_path, char *buffer_info_file_path)
+{
+	FILE *fp;
+	uint64_t buffer_addr = (uintptr_t)src_buffer;
+	uint64_t buffer_len = (uint64_t)src_buffer_len;
+
+	fp = fopen(export_desc_file_path, "wb");
+	if (fp == NULL) {
+		DOCA_LOG_ERR("Failed to create the DMA copy file");
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	if (fwrite(export_desc, 1, export_desc_len, fp) != export_desc_len) {
+		DOCA_LOG_ERR("Failed to write all data into the file");
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	fclose(fp);
+
+	fp = fopen(buffer_info_file_path, "w");
+	if (fp == NULL) {
+		DOCA_LOG_ERR("Failed to create the DMA copy file");
+		return DOCA_ERROR_IO_FAILED;
+	}
+
+	fprintf(fp, "%" PRIu64 "\n", buffer_addr);
+	fprintf(fp, "%" PRIu64 "", buffer_len);
+
+	fclose(fp);
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Open one user-space hardware counter of the calling thread
+ *
+ * @type [in]: perf event type
+ * @config [in]: perf event config
+ * @return: counter file descriptor, -1 if the counter is not available
+ */
+static int
+open_counter(uint32_t type, uint64_t config)
+{
+	struct perf_event_attr attr;
+
+	memset(&attr, 0, sizeof(attr));
+	attr.size = sizeof(attr);
+	attr.type = type;
+	attr.config = config;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+
+	return syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+/*
+ * Read a counter
+ *
+ * @fd [in]: counter file descriptor
+ * @return: counter value, 0 if the counter is not available
+ */
+static uint64_t
+read_counter(int fd)
+{
+	uint64_t value = 0;
+
+	if (fd < 0 || read(fd, &value, sizeof(value)) != sizeof(value))
+		return 0;
+	return value;
+}
+
+/*
+ * Write back and invalidate every line of a buffer
+ *
+ * @buf [in]: buffer
+ * @len [in]: buffer length
+ */
+static void
+flush_buffer(const char *buf, size_t len)
+{
+	size_t off;
+
+	for (off = 0; off < len; off += CACHELINE) {
+#if defined(__x86_64__)
+		_mm_clflush(buf + off);
+#elif defined(__aarch64__)
+		__asm__ __volatile__("dc civac, %0" : : "r"(buf + off) : "memory");
+#endif
+	}
+#if defined(__x86_64__)
+	_mm_mfence();
+#elif defined(__aarch64__)
+	__asm__ __volatile__("dsb ish" : : : "memory");
+#endif
+}
+
+/*
+ * Consumer work: 64-bit additive checksum of the payload
+ *
+ * @buf [in]: payload
+ * @len [in]: payload length
+ * @return: checksum
+ */
+static uint64_t
+checksum(const char *buf, size_t len)
+{
+	const uint64_t *words = (const uint64_t *)buf;
+	uint64_t sum = 0;
+	size_t i;
+
+	for (i = 0; i < len / sizeof(uint64_t); i++)
+		sum += words[i];
+	return sum;
+}
+
+/*
+ * Put the payload into the cache state of a mode before the DPU writes it
+ *
+ * @mode [in]: cache state
+ * @payload [in]: payload
+ * @len [in]: payload length
+ * @evict [in]: eviction buffer of EVICT_SIZE bytes
+ * @return: checksum, only returned to keep the reads
+ */
+static uint64_t
+prepare_payload(enum consume_mode mode, const char *payload, size_t len, const char *evict)
+{
+	switch (mode) {
+	case CONSUME_COLD:
+		return checksum(evict, EVICT_SIZE);
+	case CONSUME_FLUSHED:
+		flush_buffer(payload, len);
+		return 0;
+	case CONSUME_WARM:
+	default:
+		return checksum(payload, len);
+	}
+}
+
+/*
+ * Print consumer statistics of one mode
+ *
+ * @mode [in]: cache state
+ * @len [in]: payload length
+ * @samples [in]: per-iteration cost
+ * @n [in]: number of samples
+ * @counters [in]: hardware counters
+ */
+static void
+report_mode(enum consume_mode mode, size_t len, const struct consume_sample *samples, int n,
+	    const struct consume_counters *counters)
+{
+	double min_t = samples[0].ns, max_t = samples[0].ns, mean_t = 0, std_dev = 0, cycles = 0, misses = 0;
+	int i;
+
+	for (i = 0; i < n; i++) {
+		mean_t += samples[i].ns;
+		cycles += samples[i].cycles;
+		misses += samples[i].misses;
+		if (samples[i].ns < min_t)
+			min_t = samples[i].ns;
+		if (samples[i].ns > max_t)
+			max_t = samples[i].ns;
+	}
+	mean_t /= n;
+	for (i = 0; i < n; i++)
+		std_dev += pow(samples[i].ns - mean_t, 2);
+	std_dev = sqrt(std_dev / n);
+
+	printf("Consumer (%s), dst_buffer_size: %zu\n", mode_names[mode], len);
+	printf("Min time(us)\t Avg Lat(us)\t Max time(us)\t Std dev(us)\n");
+	printf("%.2f\t %13.2f\t %13.2f\t %13.2f\n", min_t / 1000, mean_t / 1000, max_t / 1000, std_dev / 1000);
+	printf("ns/byte = %.4f", mean_t / len);
+	if (counters->cycles_fd >= 0)
+		printf(", cycles/byte = %.4f", cycles / n / len);
+	if (counters->misses_fd >= 0)
+		printf(", LLC misses/byte = %.5f (%.3f per line)", misses / n / len,
+		       misses / n / ((len + CACHELINE - 1) / CACHELINE));
+	printf("\n");
+	fflush(stdout);
+}
+
+/*
+ * Run the consumer side: prepare the cache state, release the DPU, wait for the payload and consume it
+ *
+ * @buffer [in]: exported buffer, see dma_consume.h
+ * @len [in]: payload length
+ * @consumer_core [in]: core the consumer is pinned to
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+run_consumer(char *buffer, size_t len, int consumer_core)
+{
+	volatile uint64_t *host_seq = (volatile uint64_t *)(buffer + CONSUME_HOST_SEQ);
+	volatile uint64_t *dpu_seq = (volatile uint64_t *)(buffer + CONSUME_DPU_SEQ);
+	char *payload = buffer + CONSUME_PAYLOAD;
+	struct consume_counters counters;
+	struct consume_sample *samples;
+	struct timespec start, end;
+	uint64_t seq = 0, cycles, misses;
+	volatile uint64_t sink = 0;
+	doca_error_t result = DOCA_SUCCESS;
+	enum consume_mode mode;
+	cpu_set_t cpuset;
+	char *evict;
+	int i;
+
+	CPU_ZERO(&cpuset);
+	CPU_SET(consumer_core, &cpuset);
+	if (sched_setaffinity(0, sizeof(cpuset), &cpuset) != 0) {
+		DOCA_LOG_ERR("Failed to pin the consumer to core %d", consumer_core);
+		return DOCA_ERROR_OPERATING_SYSTEM;
+	}
+
+	samples = calloc(ITERATIONS, sizeof(*samples));
+	evict = malloc(EVICT_SIZE);
+	if (samples == NULL || evict == NULL) {
+		DOCA_LOG_ERR("Failed to allocate consumer buffers");
+		free(samples);
+		free(evict);
+		return DOCA_ERROR_NO_MEMORY;
+	}
+	memset(evict, 1, EVICT_SIZE);
+
+	/* Counters are opened after pinning, so they count the consumer core only */
+	counters.cycles_fd = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+	counters.misses_fd = open_counter(PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_LL |
+					  (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+					  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+	if (counters.cycles_fd < 0 || counters.misses_fd < 0)
+		DOCA_LOG_WARN("Hardware counters not available (perf_event_paranoid?), reporting time only");
+
+	DOCA_LOG_INFO("Consumer pinned to core %d, waiting for the DPU", consumer_core);
+
+	for (mode = CONSUME_COLD; mode < CONSUME_NB_MODES && !stop_consumer; mode++) {
+		for (i = 0; i < ITERATIONS && !stop_consumer; i++) {
+			sink += prepare_payload(mode, payload, len, evict);
+
+			/* Release the DPU for this round */
+			__atomic_store_n(host_seq, ++seq, __ATOMIC_RELEASE);
+			while (*dpu_seq != seq && !stop_consumer)
+				;
+			__atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+			cycles = read_counter(counters.cycles_fd);
+			misses = read_counter(counters.misses_fd);
+			clock_gettime(CLOCK_MONOTONIC, &start);
+			sink += checksum(payload, len);
+			clock_gettime(CLOCK_MONOTONIC, &end);
+			samples[i].cycles = read_counter(counters.cycles_fd) - cycles;
+			samples[i].misses = read_counter(counters.misses_fd) - misses;
+			samples[i].ns = (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+		}
+		if (i == ITERATIONS)
+			report_mode(mode, len, samples, ITERATIONS, &counters);
+	}
+
+	if (stop_consumer) {
+		DOCA_LOG_ERR("Consumer interrupted");
+		result = DOCA_ERROR_IO_FAILED;
+	}
+
+	/* Tell the DPU to finish */
+	__atomic_store_n(host_seq, CONSUME_DONE, __ATOMIC_RELEASE);
+
+	if (counters.cycles_fd >= 0)
+		close(counters.cycles_fd);
+	if (counters.misses_fd >= 0)
+		close(counters.misses_fd);
+	free(evict);
+	free(samples);
+	return result;
+}
+
+/*
+ * Run DOCA DMA consumer-side cost measurement on the Host
+ *
+ * @pcie_addr [in]: Device PCI address
+ * @buffer [in]: Buffer to export, CONSUME_PAYLOAD + payload_size bytes
+ * @payload_size [in]: Payload size
+ * @consumer_core [in]: Core the consumer is pinned to
+ * @export_desc_file_path [in]: Export descriptor file path
+ * @buffer_info_file_path [in]: Buffer info file path
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t
+dma_consume_host(const char *pcie_addr, char *buffer, size_t payload_size, int consumer_core,
+		 char *export_desc_file_path, char *buffer_info_file_path)
+{
+	struct program_core_objects state = {0};
+	const void *export_desc;
+	size_t export_desc_len;
+	doca_error_t result, tmp_result;
+
+	signal(SIGINT, signal_handler);
+	signal(SIGTERM, signal_handler);
+
+	/* Allocate resources */
+	result = allocate_dma_host_resources(pcie_addr, &state);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to allocate DMA host resources: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	/* The DPU reads the host sequence and writes the payload and its own sequence */
+	result = doca_mmap_set_permissions(state.src_mmap, DOCA_ACCESS_FLAG_PCI_READ_WRITE);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set mmap permissions: %s", doca_error_get_descr(result));
+		goto destroy_resources;
+	}
+
+	result = doca_mmap_set_memrange(state.src_mmap, buffer, CONSUME_PAYLOAD + payload_size);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set memory range for source mmap: %s", doca_error_get_descr(result));
+		goto destroy_resources;
+	}
+
+	result = doca_mmap_start(state.src_mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start source mmap: %s", doca_error_get_descr(result));
+		goto destroy_resources;
+	}
+
+	/* Export DOCA mmap to enable DMA on Host*/
+	result = doca_mmap_export_pci(state.src_mmap, state.dev, &export_desc, &export_desc_len);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start export source mmap: %s", doca_error_get_descr(result));
+		goto destroy_resources;
+	}
+
+	/* Saves the export desc and buffer info to files, it is the user responsibility to transfer them to the dpu */
+	result = save_config_info_to_files(export_desc, export_desc_len, buffer, CONSUME_PAYLOAD + payload_size,
+					   export_desc_file_path, buffer_info_file_path);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to save configurations information: %s", doca_error_get_descr(result));
+		goto destroy_resources;
+	}
+
+	DOCA_LOG_INFO("Please copy %s and %s to the DPU and run the DMA consume DPU sample", export_desc_file_path,
+		      buffer_info_file_path);
+
+	result = run_consumer(buffer, payload_size, consumer_core);
+
+destroy_resources:
+	tmp_result = destroy_dma_host_resources(&state);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+		DOCA_LOG_ERR("Failed to destroy DMA host resources: %s", doca_error_get_descr(tmp_result));
+	}
+
+	return result;
+}
@@ -0,0 +1,23 @@
+# /*
+# * Copyright (c) 2025, University of California, Merced. All rights reserved.
+# *
+# * This file is part of the benchmarking software package developed by
+# * the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+# *
+# * For detailed copyright and licensing information, please refer to the license
+# * file LICENSE in the top level directory.
+# *
+# */
+
+# Usage: run.sh <payload size> <consumer core>
+# Pick a core on the NUMA node of the BlueField for the consumer.
+len=$1
+core=$2
+sed -i "/length =/c\	length = ${len};" dma_consume_host_main.c
+sed -i "/consumer_core =/c\	consumer_core = ${core};" dma_consume_host_main.c
+
+make clean
+make
+echo ""
+
+./doca_dma_consume_host -p 01:00.0
@@ -0,0 +1,143 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "dma_client.h"
+
+/* Attached client */
+struct dma_client {
+	struct dmad_shm *shm;		/* Mapped segment */
+	size_t shm_len;			/* Length of the mapping */
+	struct dmad_slot *slot;		/* Claimed slot */
+	char *data;			/* Data area of the slot */
+	uint32_t outstanding;		/* Submitted and not yet completed */
+};
+
+struct dma_client *
+dma_client_attach(void)
+{
+	struct dma_client *client;
+	struct stat st;
+	uint32_t i, state;
+	int fd;
+
+	client = calloc(1, sizeof(*client));
+	if (client == NULL)
+		return NULL;
+
+	fd = shm_open(DMAD_SHM_NAME, O_RDWR, 0);
+	if (fd < 0) {
+		fprintf(stderr, "No DMA daemon running (%s: %s)\n", DMAD_SHM_NAME, strerror(errno));
+		free(client);
+		return NULL;
+	}
+	if (fstat(fd, &st) != 0 || (uint64_t)st.st_size != dmad_shm_size()) {
+		fprintf(stderr, "Unexpected size of %s, daemon built with other limits?\n", DMAD_SHM_NAME);
+		close(fd);
+		free(client);
+		return NULL;
+	}
+	client->shm_len = st.st_size;
+	client->shm = mmap(NULL, client->shm_len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (client->shm == MAP_FAILED) {
+		perror("Failed to map the daemon segment");
+		free(client);
+		return NULL;
+	}
+	if (__atomic_load_n(&client->shm->magic, __ATOMIC_ACQUIRE) != DMAD_MAGIC) {
+		fprintf(stderr, "DMA daemon is not ready\n");
+		goto unmap;
+	}
+
+	for (i = 0; i < client->shm->nb_slots; i++) {
+		state = DMAD_SLOT_FREE;
+		if (__atomic_compare_exchange_n(&client->shm->slots[i].state, &state, DMAD_SLOT_ATTACHED, false,
+						__ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+			break;
+	}
+	if (i == client->shm->nb_slots) {
+		fprintf(stderr, "All %u daemon slots are taken\n", client->shm->nb_slots);
+		goto unmap;
+	}
+	client->slot = &client->shm->slots[i];
+	client->slot->pid = getpid();
+	client->data = (char *)client->shm + client->shm->data_off + i * client->shm->data_len;
+	return client;
+
+unmap:
+	munmap(client->shm, client->shm_len);
+	free(client);
+	return NULL;
+}
+
+void *
+dma_client_data(struct dma_client *client, size_t *len)
+{
+	*len = client->shm->data_len;
+	return client->data;
+}
+
+uint64_t
+dma_client_remote_len(const struct dma_client *client)
+{
+	return client->shm->remote_len;
+}
+
+int
+dma_client_submit(struct dma_client *client, const struct dmad_req *req)
+{
+	uint32_t idx;
+
+	/* Also bounds the completions, so the daemon never finds the completion ring full */
+	if (client->outstanding == DMAD_RING_SIZE || dmad_ring_reserve(&client->slot->sq.idx, &idx) != 0)
+		return -1;
+	client->slot->sq.e[idx] = *req;
+	dmad_ring_publish(&client->slot->sq.idx);
+	client->outstanding++;
+	return 0;
+}
+
+int
+dma_client_poll(struct dma_client *client, struct dmad_cpl *cpl, int max)
+{
+	uint32_t idx;
+	int n = 0;
+
+	while (n < max && dmad_ring_peek(&client->slot->cq.idx, &idx) == 0) {
+		cpl[n++] = client->slot->cq.e[idx];
+		dmad_ring_consume(&client->slot->cq.idx);
+	}
+	client->outstanding -= n;
+	return n;
+}
+
+void
+dma_client_detach(struct dma_client *client)
+{
+	struct dmad_cpl cpl[16];
+
+	while (client->outstanding > 0)
+		(void)dma_client_poll(client, cpl, 16);
+	__atomic_store_n(&client->slot->state, DMAD_SLOT_DETACHING, __ATOMIC_RELEASE);
+	munmap(client->shm, client->shm_len);
+	free(client);
+}
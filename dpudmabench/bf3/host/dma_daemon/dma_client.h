@@ -0,0 +1,81 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+#ifndef DMA_CLIENT_H_
+#define DMA_CLIENT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "dma_daemon.h"
+
+/*
+ * Client side of the DMA offload daemon, plain POSIX without DOCA
+ *
+ * A client maps the segment of a running daemon, claims a slot and then submits copies between its data area and
+ * the host buffer of the daemon. Completions come back in submission order of the daemon, which is the order of the
+ * DMA engine and not necessarily the order of the submission ring.
+ */
+
+struct dma_client;
+
+/*
+ * Attach to the running daemon
+ *
+ * @return: client on success and NULL otherwise
+ */
+struct dma_client *dma_client_attach(void);
+
+/*
+ * Data area of the client, the local side of every copy
+ *
+ * @client [in]: client
+ * @len [out]: length of the data area
+ * @return: start of the data area
+ */
+void *dma_client_data(struct dma_client *client, size_t *len);
+
+/*
+ * Length of the host buffer of the daemon
+ *
+ * @client [in]: client
+ * @return: length in bytes, 0 if the daemon only does local copies
+ */
+uint64_t dma_client_remote_len(const struct dma_client *client);
+
+/*
+ * Queue one copy
+ *
+ * @client [in]: client
+ * @req [in]: copy request
+ * @return: 0 on success and -1 if DMAD_RING_SIZE requests are outstanding
+ */
+int dma_client_submit(struct dma_client *client, const struct dmad_req *req);
+
+/*
+ * Collect completions
+ *
+ * @client [in]: client
+ * @cpl [out]: completions
+ * @max [in]: size of cpl
+ * @return: number of completions written to cpl
+ */
+int dma_client_poll(struct dma_client *client, struct dmad_cpl *cpl, int max);
+
+/*
+ * Release the slot once the outstanding requests completed, and unmap the segment
+ *
+ * @client [in]: client
+ */
+void dma_client_detach(struct dma_client *client);
+
+#endif
@@ -0,0 +1,153 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <doca_argp.h>
+#include <doca_log.h>
+
+#include "dma_common.h"
+
+DOCA_LOG_REGISTER(DMA_CLIENT_BENCH_HOST::MAIN);
+
+/* Configuration struct, dma_conf comes first so the dma_common ARGP callbacks can use it */
+struct client_bench_config {
+	struct dma_config dma_conf;	/* Device of the in-process mode */
+	bool inproc;			/* In-process DOCA objects instead of the daemon */
+};
+
+/* Sample's Logic */
+doca_error_t dma_client_bench_host(bool inproc, const char *pcie_addr);
+
+/*
+ * ARGP Callback - Handle mode parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+mode_callback(void *param, void *config)
+{
+	struct client_bench_config *conf = (struct client_bench_config *)config;
+	const char *mode = (char *)param;
+
+	if (strcmp(mode, "daemon") == 0)
+		conf->inproc = false;
+	else if (strcmp(mode, "inproc") == 0)
+		conf->inproc = true;
+	else {
+		DOCA_LOG_ERR("Unknown mode %s, expected daemon or inproc", mode);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Register the mode parameter
+ *
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+register_mode_param(void)
+{
+	struct doca_argp_param *mode_param;
+	doca_error_t result;
+
+	result = doca_argp_param_create(&mode_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(mode_param, "m");
+	doca_argp_param_set_long_name(mode_param, "mode");
+	doca_argp_param_set_description(mode_param, "daemon: submit through the DMA daemon, inproc: own DOCA objects");
+	doca_argp_param_set_callback(mode_param, mode_callback);
+	doca_argp_param_set_type(mode_param, DOCA_ARGP_TYPE_STRING);
+	result = doca_argp_register_param(mode_param);
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+	return result;
+}
+
+/*
+ * Sample main function
+ *
+ * @argc [in]: command line arguments size
+ * @argv [in]: array of command line arguments
+ * @return: EXIT_SUCCESS on success and EXIT_FAILURE otherwise
+ */
+int
+main(int argc, char **argv)
+{
+	struct client_bench_config conf = {0};
+	doca_error_t result;
+	struct doca_log_backend *sdk_log;
+	int exit_status = EXIT_FAILURE;
+
+	/* Set the default configuration values (Example values) */
+	strcpy(conf.dma_conf.pci_address, "b1:00.0");
+
+	/* Register a logger backend */
+	result = doca_log_backend_create_standard();
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+
+	/* Register a logger backend for internal SDK errors and warnings */
+	result = doca_log_backend_create_with_file_sdk(stderr, &sdk_log);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+	result = doca_log_backend_set_sdk_level(sdk_log, DOCA_LOG_LEVEL_WARNING);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+
+	result = doca_argp_init("doca_dma_client_bench_host", &conf);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to init ARGP resources: %s", doca_error_get_descr(result));
+		goto sample_exit;
+	}
+	result = register_dma_params(false);
+	if (result == DOCA_SUCCESS)
+		result = register_mode_param();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register DMA sample parameters: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+	result = doca_argp_start(argc, argv);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to parse sample input: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+#ifndef DOCA_ARCH_HOST
+	DOCA_LOG_ERR("Sample can run only on the Host");
+	goto argp_cleanup;
+#endif
+	result = dma_client_bench_host(conf.inproc, conf.dma_conf.pci_address);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("dma_client_bench_host() encountered an error: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	exit_status = EXIT_SUCCESS;
+
+argp_cleanup:
+	doca_argp_destroy();
+sample_exit:
+	if (exit_status == EXIT_SUCCESS)
+		DOCA_LOG_INFO("Sample finished successfully");
+	else
+		DOCA_LOG_INFO("Sample finished with errors");
+	return exit_status;
+}
@@ -0,0 +1,34 @@
+# /*
+# * Copyright (c) 2025, University of California, Merced. All rights reserved.
+# *
+# * This file is part of the benchmarking software package developed by
+# * the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+# *
+# * For detailed copyright and licensing information, please refer to the license
+# * file LICENSE in the top level directory.
+# *
+# */
+
+
+# Usage: run.sh [number of concurrent clients]
+# Runs on the host only. Without a DPU side the daemon has no remote buffer,
+# so the clients copy within their data areas.
+clients=${1:-1}
+make clean
+make
+echo ""
+
+./doca_dma_client_bench_host -m inproc -p 01:00.0 | tee dma_client_inproc.txt
+echo ""
+
+./doca_dma_daemon_host -p 01:00.0 > dma_daemon.txt &
+daemon=$!
+sleep 2
+for i in $(seq 1 ${clients}); do
+	./doca_dma_client_bench_host -m daemon > dma_client_daemon.txt.$i &
+	pids="${pids} $!"
+done
+wait ${pids}
+kill -TERM ${daemon}
+wait ${daemon}
+cat dma_client_daemon.txt.* dma_daemon.txt
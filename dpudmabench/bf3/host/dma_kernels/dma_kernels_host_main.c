@@ -0,0 +1,256 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <doca_argp.h>
+#include <doca_log.h>
+
+#include "dma_common.h"
+
+DOCA_LOG_REGISTER(DMA_KERNELS_HOST::MAIN);
+
+/* Configuration struct, dma_conf comes first so the dma_common ARGP callbacks can use it */
+struct kernels_config {
+	struct dma_config dma_conf;	/* Device and host buffer */
+	char kernel[MAX_ARG_SIZE];	/* Kernel to run, or "all" */
+	uint32_t interval_ms;		/* Timeline sampling interval of the streaming kernels */
+	uint32_t duration_s;		/* Length of every streaming run */
+	char trace_path[MAX_ARG_SIZE];	/* Chrome trace output, empty for no tracing */
+};
+
+/* Sample's Logic */
+doca_error_t dma_kernels_host(const char *kernel, uint32_t interval_ms, uint32_t duration_s, const char *trace_path,
+			      const char *export_desc_file_path, const char *buffer_info_file_path,
+			      const char *pcie_addr);
+
+/*
+ * ARGP Callback - Handle kernel parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+kernel_callback(void *param, void *config)
+{
+	struct kernels_config *conf = (struct kernels_config *)config;
+	const char *kernel = (char *)param;
+
+	if (strnlen(kernel, MAX_ARG_SIZE) == MAX_ARG_SIZE) {
+		DOCA_LOG_ERR("Kernel name is too long - MAX=%d", MAX_USER_ARG_SIZE);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	strcpy(conf->kernel, kernel);
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle trace parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+trace_callback(void *param, void *config)
+{
+	struct kernels_config *conf = (struct kernels_config *)config;
+	const char *path = (char *)param;
+
+	if (strnlen(path, MAX_ARG_SIZE) == MAX_ARG_SIZE) {
+		DOCA_LOG_ERR("Trace path is too long - MAX=%d", MAX_USER_ARG_SIZE);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	strcpy(conf->trace_path, path);
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle interval parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+interval_callback(void *param, void *config)
+{
+	struct kernels_config *conf = (struct kernels_config *)config;
+	int interval = *(int *)param;
+
+	if (interval < 1) {
+		DOCA_LOG_ERR("Sampling interval must be at least 1 ms");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	conf->interval_ms = interval;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * ARGP Callback - Handle duration parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+duration_callback(void *param, void *config)
+{
+	struct kernels_config *conf = (struct kernels_config *)config;
+	int duration = *(int *)param;
+
+	if (duration < 1) {
+		DOCA_LOG_ERR("Streaming duration must be at least 1 s");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	conf->duration_s = duration;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Register one program parameter
+ *
+ * @short_name [in]: short option
+ * @long_name [in]: long option
+ * @description [in]: help text
+ * @callback [in]: parser callback
+ * @type [in]: argument type
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+register_param(const char *short_name, const char *long_name, const char *description, doca_argp_param_cb_t callback,
+	       enum doca_argp_type type)
+{
+	struct doca_argp_param *param;
+	doca_error_t result;
+
+	result = doca_argp_param_create(&param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(param, short_name);
+	doca_argp_param_set_long_name(param, long_name);
+	doca_argp_param_set_description(param, description);
+	doca_argp_param_set_callback(param, callback);
+	doca_argp_param_set_type(param, type);
+	result = doca_argp_register_param(param);
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+	return result;
+}
+
+/*
+ * Register the kernel, interval, duration and trace parameters
+ *
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+register_kernels_params(void)
+{
+	doca_error_t result;
+
+	result = register_param("k", "kernel", "<read|write>_<lat|thr|stream>_<poll|event>, or all (default: all)",
+				kernel_callback, DOCA_ARGP_TYPE_STRING);
+	if (result != DOCA_SUCCESS)
+		return result;
+	result = register_param("i", "interval", "Timeline sampling interval of the stream kernels in ms (default: 10)",
+				interval_callback, DOCA_ARGP_TYPE_INT);
+	if (result != DOCA_SUCCESS)
+		return result;
+	result = register_param("s", "duration", "Length of every stream kernel run in seconds (default: 2)",
+				duration_callback, DOCA_ARGP_TYPE_INT);
+	if (result != DOCA_SUCCESS)
+		return result;
+	return register_param("T", "trace", "Rerun every kernel point with tracing, write a Chrome trace to <path>",
+			      trace_callback, DOCA_ARGP_TYPE_STRING);
+}
+
+/*
+ * Sample main function
+ *
+ * @argc [in]: command line arguments size
+ * @argv [in]: array of command line arguments
+ * @return: EXIT_SUCCESS on success and EXIT_FAILURE otherwise
+ */
+int
+main(int argc, char **argv)
+{
+	struct kernels_config conf = {0};
+	doca_error_t result;
+	struct doca_log_backend *sdk_log;
+	int exit_status = EXIT_FAILURE;
+
+	/* Set the default configuration values (Example values) */
+	strcpy(conf.dma_conf.pci_address, "b1:00.0");
+	strcpy(conf.dma_conf.export_desc_path, "/tmp/export_desc.txt");
+	strcpy(conf.dma_conf.buf_info_path, "/tmp/buffer_info.txt");
+	strcpy(conf.kernel, "all");
+	conf.interval_ms = 10;
+	conf.duration_s = 2;
+
+	/* Register a logger backend */
+	result = doca_log_backend_create_standard();
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+
+	/* Register a logger backend for internal SDK errors and warnings */
+	result = doca_log_backend_create_with_file_sdk(stderr, &sdk_log);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+	result = doca_log_backend_set_sdk_level(sdk_log, DOCA_LOG_LEVEL_WARNING);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+
+	result = doca_argp_init("doca_dma_kernels", &conf);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to init ARGP resources: %s", doca_error_get_descr(result));
+		goto sample_exit;
+	}
+	result = register_dma_params(true);
+	if (result == DOCA_SUCCESS)
+		result = register_kernels_params();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register DMA sample parameters: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+	result = doca_argp_start(argc, argv);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to parse sample input: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+#ifndef DOCA_ARCH_HOST
+	DOCA_LOG_ERR("Sample can run only on the Host");
+	goto argp_cleanup;
+#endif
+	result = dma_kernels_host(conf.kernel, conf.interval_ms, conf.duration_s, conf.trace_path,
+				  conf.dma_conf.export_desc_path, conf.dma_conf.buf_info_path,
+				  conf.dma_conf.pci_address);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("dma_kernels_host() encountered an error: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	exit_status = EXIT_SUCCESS;
+
+argp_cleanup:
+	doca_argp_destroy();
+sample_exit:
+	if (exit_status == EXIT_SUCCESS)
+		DOCA_LOG_INFO("Sample finished successfully");
+	else
+		DOCA_LOG_INFO("Sample finished with errors");
+	return exit_status;
+}
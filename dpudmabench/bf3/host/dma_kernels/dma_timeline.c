@@ -0,0 +1,232 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "dma_timeline.h"
+
+#define TIMELINE_DIP 0.9	/* An interval below this fraction of the median counts as a dip */
+
+/*
+ * Current CLOCK_MONOTONIC time
+ *
+ * @return: time in nanoseconds
+ */
+static uint64_t
+now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000UL + ts.tv_nsec;
+}
+
+/*
+ * Append one sample with the current counters
+ *
+ * @tl [in]: timeline
+ * @t_ns [in]: CLOCK_MONOTONIC time of the sample
+ */
+static void
+take_sample(struct timeline *tl, uint64_t t_ns)
+{
+	struct timeline_sample *s;
+
+	if (tl->nb_samples == tl->max_samples)
+		return;
+	s = &tl->samples[tl->nb_samples];
+	s->t_ns = t_ns - tl->start_ns;
+	s->ops = __atomic_load_n(&tl->ops, __ATOMIC_RELAXED);
+	s->in_flight = __atomic_load_n(&tl->in_flight, __ATOMIC_RELAXED);
+	__atomic_store_n(&tl->nb_samples, tl->nb_samples + 1, __ATOMIC_RELEASE);
+}
+
+/*
+ * Sampler thread: sleep to the next absolute deadline, sample, repeat
+ *
+ * @arg [in]: timeline
+ * @return: NULL
+ */
+static void *
+sampler_main(void *arg)
+{
+	struct timeline *tl = (struct timeline *)arg;
+	uint64_t deadline = tl->start_ns;
+	struct timespec ts;
+
+	while (!__atomic_load_n(&tl->stop, __ATOMIC_ACQUIRE) && tl->nb_samples < tl->max_samples) {
+		deadline += tl->interval_ns;
+		ts.tv_sec = deadline / 1000000000UL;
+		ts.tv_nsec = deadline % 1000000000UL;
+		while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) != 0)
+			;
+		if (__atomic_load_n(&tl->stop, __ATOMIC_ACQUIRE))
+			break;
+		take_sample(tl, now_ns());
+	}
+	return NULL;
+}
+
+struct timeline *
+timeline_create(uint32_t interval_ms, uint32_t max_samples)
+{
+	struct timeline *tl;
+
+	if (interval_ms == 0 || max_samples < 2)
+		return NULL;
+	if (posix_memalign((void **)&tl, TIMELINE_CACHE_LINE, sizeof(*tl)) != 0)
+		return NULL;
+	memset(tl, 0, sizeof(*tl));
+	tl->samples = calloc(max_samples, sizeof(*tl->samples));
+	if (tl->samples == NULL) {
+		free(tl);
+		return NULL;
+	}
+	tl->max_samples = max_samples;
+	tl->interval_ns = (uint64_t)interval_ms * 1000000UL;
+	tl->start_ns = now_ns();
+	take_sample(tl, tl->start_ns);
+
+	if (pthread_create(&tl->thread, NULL, sampler_main, tl) != 0) {
+		free(tl->samples);
+		free(tl);
+		return NULL;
+	}
+	tl->running = 1;
+	return tl;
+}
+
+void
+timeline_stop(struct timeline *tl)
+{
+	uint64_t t_ns = now_ns();
+
+	if (!tl->running)
+		return;
+	/* The sampler may sleep for up to one interval, the end of the run is the time of the call */
+	__atomic_store_n(&tl->stop, 1, __ATOMIC_RELEASE);
+	pthread_join(tl->thread, NULL);
+	tl->running = 0;
+	if (tl->nb_samples == tl->max_samples)
+		tl->nb_samples--;
+	take_sample(tl, t_ns);
+}
+
+/*
+ * qsort() comparator for doubles
+ *
+ * @a [in]: first value
+ * @b [in]: second value
+ * @return: <0, 0 or >0
+ */
+static int
+cmp_double(const void *a, const void *b)
+{
+	double x = *(const double *)a, y = *(const double *)b;
+
+	return (x > y) - (x < y);
+}
+
+/*
+ * Mean of a range of values
+ *
+ * @v [in]: values
+ * @n [in]: number of values, at least 1
+ * @return: mean
+ */
+static double
+mean_of(const double *v, int n)
+{
+	double sum = 0;
+	int i;
+
+	for (i = 0; i < n; i++)
+		sum += v[i];
+	return sum / n;
+}
+
+void
+timeline_report(const struct timeline *tl, const char *name, size_t size)
+{
+	const struct timeline_sample *prev, *cur;
+	double *gbps, *sorted, dt, mops, mean, var = 0, depth = 0, median;
+	int i, n = 0, dips = 0, edge;
+
+	if (tl->nb_samples < 2)
+		return;
+	gbps = calloc(tl->nb_samples, sizeof(*gbps));
+	sorted = calloc(tl->nb_samples, sizeof(*sorted));
+	if (gbps == NULL || sorted == NULL) {
+		free(gbps);
+		free(sorted);
+		return;
+	}
+
+	for (i = 1; i < (int)tl->nb_samples; i++) {
+		prev = &tl->samples[i - 1];
+		cur = &tl->samples[i];
+		dt = cur->t_ns - prev->t_ns;
+		if (dt <= 0)
+			continue;
+		mops = (cur->ops - prev->ops) / dt * 1000;
+		printf("TIMELINE %s %zu %.1f %.4f %.3f %lu\n", name, size, cur->t_ns / 1e6, mops, mops * size / 1000,
+		       cur->in_flight);
+		/* A last interval shorter than half a period is too noisy for the summary */
+		if (dt < tl->interval_ns / 2)
+			continue;
+		gbps[n++] = mops * size / 1000;
+		depth += cur->in_flight;
+	}
+	if (n == 0)
+		goto out;
+
+	mean = mean_of(gbps, n);
+	for (i = 0; i < n; i++)
+		var += (gbps[i] - mean) * (gbps[i] - mean);
+	memcpy(sorted, gbps, n * sizeof(*sorted));
+	qsort(sorted, n, sizeof(*sorted), cmp_double);
+	median = sorted[n / 2];
+	for (i = 0; i < n; i++)
+		if (gbps[i] < TIMELINE_DIP * median)
+			dips++;
+	/* Drift compares the last tenth of the run with the first tenth */
+	edge = n >= 10 ? n / 10 : 1;
+
+	cur = &tl->samples[tl->nb_samples - 1];
+	printf("STABILITY %s %zu intervals=%d run_gbps=%.3f mean=%.3f min=%.3f p5=%.3f p50=%.3f max=%.3f cov=%.2f%% "
+	       "dips=%d drift=%+.2f%% depth=%.1f\n",
+	       name, size, n, (double)cur->ops * size / cur->t_ns, mean, sorted[0], sorted[n * 5 / 100], median,
+	       sorted[n - 1], mean > 0 ? sqrt(var / n) / mean * 100 : 0, dips,
+	       mean_of(gbps, edge) > 0 ? (mean_of(gbps + n - edge, edge) / mean_of(gbps, edge) - 1) * 100 : 0,
+	       depth / n);
+out:
+	fflush(stdout);
+	free(gbps);
+	free(sorted);
+}
+
+void
+timeline_destroy(struct timeline *tl)
+{
+	if (tl == NULL)
+		return;
+	if (tl->running) {
+		__atomic_store_n(&tl->stop, 1, __ATOMIC_RELEASE);
+		pthread_join(tl->thread, NULL);
+	}
+	free(tl->samples);
+	free(tl);
+}
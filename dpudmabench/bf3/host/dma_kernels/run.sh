@@ -0,0 +1,24 @@
+# /*
+# * Copyright (c) 2025, University of California, Merced. All rights reserved.
+# *
+# * This file is part of the benchmarking software package developed by
+# * the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+# *
+# * For detailed copyright and licensing information, please refer to the license
+# * file LICENSE in the top level directory.
+# *
+# */
+
+
+
+# Start dpu/dma_write_h_to_d_lat_poll/run.sh 33554432 on the DPU first,
+# the read and write kernels need a READ_WRITE export.
+scp <user>@dpu:/tmp/buffer_info.txt .
+scp <user>@dpu:/tmp/export_desc.txt .
+echo ""
+
+make clean
+make
+echo ""
+
+./doca_dma_kernels_host -p 01:00.0 -d export_desc.txt -b buffer_info.txt -k all | tee dma_kernels_host.txt
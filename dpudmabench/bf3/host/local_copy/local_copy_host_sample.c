@@ -0,0 +1,503 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <doca_buf.h>
+#include <doca_buf_inventory.h>
+#include <doca_dma.h>
+#include <doca_error.h>
+#include <doca_log.h>
+#include <doca_mmap.h>
+#include <doca_pe.h>
+
+#include "dma_common.h"
+#include "utils.h"
+
+DOCA_LOG_REGISTER(LOCAL_COPY_HOST);
+
+#define BUF_LEN (256UL << 20)		/* Source and destination buffer, well above the LLC */
+#define LAT_BYTES (1UL << 30)		/* Bytes copied per latency point */
+#define LAT_MAX_ITERATIONS 5000		/* Latency iterations of the small sizes */
+#define LAT_MIN_ITERATIONS 10		/* Latency iterations of the large sizes */
+#define THR_BYTES (4UL << 30)		/* Bytes copied per throughput point */
+#define THR_MIN_REPS 10			/* Minimum number of batches per throughput point */
+#define THR_MAX_REPS 1000		/* Maximum number of batches per throughput point */
+#define MEMCPY_THREADS 8		/* Threads of the parallel memcpy baseline */
+
+/* Copy sizes of the sweep */
+static const size_t sizes[] = {64, 1024, 4096, 65536, 1UL << 20, 8UL << 20, 64UL << 20};
+#define NB_SIZES (sizeof(sizes) / sizeof(sizes[0]))
+
+/* One measured point */
+struct copy_result {
+	double lat_us;		/* Average latency of a single copy */
+	double gbps;		/* Throughput with many copies in flight */
+	double cpu_pct;		/* CPU time of the process over wall time during the throughput run */
+};
+
+/* One thread of the parallel memcpy baseline */
+struct memcpy_worker {
+	char *dst;		/* Destination buffer */
+	const char *src;	/* Source buffer */
+	size_t size;		/* Copy size */
+	uint64_t first;		/* First copy index of this thread */
+	uint64_t copies;	/* Total number of copies */
+	int stride;		/* Number of threads */
+	volatile int *go;	/* Set to 1 once all threads exist, -1 to abort */
+};
+
+/*
+ * Elapsed time between two timestamps
+ *
+ * @start [in]: start timestamp
+ * @end [in]: end timestamp
+ * @return: elapsed time in nanoseconds
+ */
+static double
+elapsed_ns(const struct timespec *start, const struct timespec *end)
+{
+	return (end->tv_sec - start->tv_sec) * 1e9 + (end->tv_nsec - start->tv_nsec);
+}
+
+/*
+ * Offset of copy i of a throughput run, copies walk the whole buffer so that neither side stays in cache
+ *
+ * @i [in]: copy index
+ * @size [in]: copy size
+ * @return: offset in both buffers
+ */
+static size_t
+copy_offset(uint64_t i, size_t size)
+{
+	return (i % (BUF_LEN / size)) * size;
+}
+
+/*
+ * Number of single-copy iterations of a latency point
+ *
+ * @size [in]: copy size
+ * @return: number of iterations
+ */
+static int
+lat_iterations(size_t size)
+{
+	size_t iters = LAT_BYTES / size;
+
+	if (iters < LAT_MIN_ITERATIONS)
+		return LAT_MIN_ITERATIONS;
+	if (iters > LAT_MAX_ITERATIONS)
+		return LAT_MAX_ITERATIONS;
+	return iters;
+}
+
+/*
+ * Tasks per batch of a throughput point, large copies use short batches and a batch never reuses a slot
+ *
+ * @size [in]: copy size
+ * @return: number of tasks per batch
+ */
+static int
+thr_batch(size_t size)
+{
+	size_t batch = THR_BYTES / size / THR_MIN_REPS;
+
+	if (batch > BUF_LEN / size)
+		batch = BUF_LEN / size;
+	if (batch < 1)
+		return 1;
+	if (batch > NUM_DMA_TASKS)
+		return NUM_DMA_TASKS;
+	return batch;
+}
+
+/*
+ * Number of batches of a throughput point
+ *
+ * @size [in]: copy size
+ * @return: number of batches
+ */
+static int
+thr_reps(size_t size)
+{
+	size_t reps = THR_BYTES / (size * thr_batch(size));
+
+	if (reps < THR_MIN_REPS)
+		return THR_MIN_REPS;
+	if (reps > THR_MAX_REPS)
+		return THR_MAX_REPS;
+	return reps;
+}
+
+/*
+ * Point the first num tasks at copies first, first + 1, ... of both buffers
+ *
+ * @resources [in]: DMA resources
+ * @src [in]: source buffer
+ * @dst [in]: destination buffer
+ * @size [in]: copy size
+ * @first [in]: copy index of the first task
+ * @num [in]: number of tasks
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+prepare_tasks(struct dma_resources *resources, char *src, char *dst, size_t size, uint64_t first, int num)
+{
+	doca_error_t result;
+	int i;
+
+	for (i = 0; i < num; i++) {
+		result = doca_buf_set_data(resources->src_doca_buf_array[i], src + copy_offset(first + i, size), size);
+		if (result == DOCA_SUCCESS)
+			result = doca_buf_set_data(resources->dst_doca_buf_array[i], dst + copy_offset(first + i, size),
+						   0);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to set data of DOCA buffers: %s", doca_error_get_descr(result));
+			return result;
+		}
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Submit the first num tasks
+ *
+ * @resources [in]: DMA resources
+ * @num [in]: number of tasks to submit
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+submit_tasks(struct dma_resources *resources, int num)
+{
+	doca_error_t result;
+	int i;
+
+	resources->num_remaining_tasks = num;
+	for (i = 0; i < num; i++) {
+		result = doca_task_submit(doca_dma_task_memcpy_as_task(resources->tasks[i]));
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to submit DMA task: %s", doca_error_get_descr(result));
+			return result;
+		}
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Measure a local DMA copy of one size
+ *
+ * @resources [in]: DMA resources
+ * @src [in]: source buffer
+ * @dst [in]: destination buffer
+ * @size [in]: copy size
+ * @use_event [in]: wait for completions on the PE notification handle instead of polling
+ * @res [out]: measured point
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+measure_dma(struct dma_resources *resources, char *src, char *dst, size_t size, bool use_event,
+	    struct copy_result *res)
+{
+	struct timespec start, end, cpu_start, cpu_end;
+	int i, iters = lat_iterations(size), batch = thr_batch(size), reps = thr_reps(size);
+	doca_error_t result;
+
+	result = prepare_tasks(resources, src, dst, size, 0, 1);
+	if (result != DOCA_SUCCESS)
+		return result;
+
+	/* Latency: one task in flight, always on the first slot like the memcpy latency */
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < iters; i++) {
+		result = submit_tasks(resources, 1);
+		if (result == DOCA_SUCCESS)
+			result = dma_wait_tasks(resources, use_event);
+		if (result != DOCA_SUCCESS)
+			return result;
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	res->lat_us = elapsed_ns(&start, &end) / iters / 1000;
+
+	/* Throughput: every batch moves on to the next slots, so the copies walk both buffers like the memcpy run */
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpu_start);
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < reps; i++) {
+		result = prepare_tasks(resources, src, dst, size, (uint64_t)i * batch, batch);
+		if (result == DOCA_SUCCESS)
+			result = submit_tasks(resources, batch);
+		if (result == DOCA_SUCCESS)
+			result = dma_wait_tasks(resources, use_event);
+		if (result != DOCA_SUCCESS)
+			return result;
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpu_end);
+	res->gbps = (double)reps * batch * size / elapsed_ns(&start, &end);
+	res->cpu_pct = elapsed_ns(&cpu_start, &cpu_end) / elapsed_ns(&start, &end) * 100;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Parallel memcpy thread, copies first, first + stride, ...
+ *
+ * @arg [in]: worker
+ * @return: NULL
+ */
+static void *
+run_memcpy_worker(void *arg)
+{
+	struct memcpy_worker *w = (struct memcpy_worker *)arg;
+	uint64_t i;
+
+	while (*w->go == 0)
+		;
+	if (*w->go < 0)
+		return NULL;
+
+	for (i = w->first; i < w->copies; i += w->stride) {
+		memcpy(w->dst + copy_offset(i, w->size), w->src + copy_offset(i, w->size), w->size);
+		__asm__ __volatile__("" : : "r"(w->dst) : "memory");
+	}
+	return NULL;
+}
+
+/*
+ * Measure the CPU memcpy baseline of one size, the same copies as the DMA throughput run
+ *
+ * @src [in]: source buffer
+ * @dst [in]: destination buffer
+ * @size [in]: copy size
+ * @nb_threads [in]: number of copying threads, 1 runs in the calling thread
+ * @res [out]: measured point, lat_us is only set for one thread
+ * @return: 0 on success and -1 otherwise
+ */
+static int
+measure_memcpy(const char *src, char *dst, size_t size, int nb_threads, struct copy_result *res)
+{
+	struct memcpy_worker workers[MEMCPY_THREADS];
+	pthread_t threads[MEMCPY_THREADS];
+	struct timespec start, end, cpu_start, cpu_end;
+	uint64_t i, copies = (uint64_t)thr_reps(size) * thr_batch(size);
+	volatile int go = 0;
+	int t, iters, nb_started = 0;
+
+	if (nb_threads == 1) {
+		iters = lat_iterations(size);
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		for (i = 0; i < (uint64_t)iters; i++) {
+			memcpy(dst, src, size);
+			__asm__ __volatile__("" : : "r"(dst) : "memory");
+		}
+		clock_gettime(CLOCK_MONOTONIC, &end);
+		res->lat_us = elapsed_ns(&start, &end) / iters / 1000;
+	}
+
+	for (t = 0; t < nb_threads; t++) {
+		workers[t].dst = dst;
+		workers[t].src = src;
+		workers[t].size = size;
+		workers[t].first = t;
+		workers[t].copies = copies;
+		workers[t].stride = nb_threads;
+		workers[t].go = &go;
+	}
+	for (t = 1; t < nb_threads; t++) {
+		if (pthread_create(&threads[t], NULL, run_memcpy_worker, &workers[t]) != 0) {
+			fprintf(stderr, "Failed to create memcpy thread %d\n", t);
+			break;
+		}
+		nb_started++;
+	}
+	if (nb_started != nb_threads - 1) {
+		go = -1;
+		for (t = 1; t <= nb_started; t++)
+			pthread_join(threads[t], NULL);
+		return -1;
+	}
+
+	/* The calling thread is worker 0 */
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpu_start);
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	go = 1;
+	run_memcpy_worker(&workers[0]);
+	for (t = 1; t < nb_threads; t++)
+		pthread_join(threads[t], NULL);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpu_end);
+	res->gbps = (double)copies * size / elapsed_ns(&start, &end);
+	res->cpu_pct = elapsed_ns(&cpu_start, &cpu_end) / elapsed_ns(&start, &end) * 100;
+	return 0;
+}
+
+/*
+ * Run DOCA DMA local copy benchmark, source and destination both in local memory
+ *
+ * @pcie_addr [in]: Device PCI address
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t
+local_copy_host(const char *pcie_addr)
+{
+	struct dma_resources resources;
+	struct program_core_objects *state = &resources.state;
+	union doca_data task_user_data = {0};
+	struct copy_result poll_res, event_res, cpu_res, par_res;
+	uint64_t max_buffer_size;
+	char *src = NULL, *dst = NULL;
+	doca_error_t result, tmp_result, task_result = DOCA_SUCCESS;
+	int i, nb_bufs = 0, nb_tasks = 0, nb_threads;
+	size_t s;
+
+	/* Allocate resources, the event handle is only used by the event points */
+	result = allocate_dma_resources_with_event(pcie_addr, &resources);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to allocate DMA resources: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	/* Connect context to progress engine */
+	result = doca_pe_connect_ctx(state->pe, state->ctx);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to connect progress engine to context: %s", doca_error_get_descr(result));
+		goto destroy_resources;
+	}
+
+	result = doca_ctx_start(state->ctx);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start context: %s", doca_error_get_descr(result));
+		goto destroy_resources;
+	}
+
+	/* Get maximum buffer size allowed */
+	result = doca_dma_cap_task_memcpy_get_max_buf_size(doca_dev_as_devinfo(state->dev), &max_buffer_size);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to get max buffer size: %s", doca_error_get_descr(result));
+		goto stop_dma;
+	}
+
+	if (posix_memalign((void **)&src, 4096, BUF_LEN) != 0 || posix_memalign((void **)&dst, 4096, BUF_LEN) != 0) {
+		DOCA_LOG_ERR("Failed to allocate memory for local buffers");
+		result = DOCA_ERROR_NO_MEMORY;
+		goto stop_dma;
+	}
+	memset(src, '1', BUF_LEN);
+	memset(dst, '0', BUF_LEN);
+
+	/* Both buffers are registered on the same device */
+	result = doca_mmap_set_memrange(state->src_mmap, src, BUF_LEN);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_start(state->src_mmap);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_set_memrange(state->dst_mmap, dst, BUF_LEN);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_start(state->dst_mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start local mmaps: %s", doca_error_get_descr(result));
+		goto stop_dma;
+	}
+
+	for (nb_bufs = 0; nb_bufs < NUM_DMA_TASKS; nb_bufs++) {
+		result = doca_buf_inventory_buf_get_by_addr(state->buf_inv, state->src_mmap, src, BUF_LEN,
+							    &resources.src_doca_buf_array[nb_bufs]);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Unable to acquire DOCA source buffer: %s", doca_error_get_descr(result));
+			goto destroy_bufs;
+		}
+		result = doca_buf_inventory_buf_get_by_addr(state->buf_inv, state->dst_mmap, dst, BUF_LEN,
+							    &resources.dst_doca_buf_array[nb_bufs]);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Unable to acquire DOCA destination buffer: %s", doca_error_get_descr(result));
+			doca_buf_dec_refcount(resources.src_doca_buf_array[nb_bufs], NULL);
+			goto destroy_bufs;
+		}
+	}
+
+	task_user_data.ptr = &task_result;
+	for (nb_tasks = 0; nb_tasks < NUM_DMA_TASKS; nb_tasks++) {
+		result = doca_dma_task_memcpy_alloc_init(resources.dma_ctx, resources.src_doca_buf_array[nb_tasks],
+							 resources.dst_doca_buf_array[nb_tasks], task_user_data,
+							 &resources.tasks[nb_tasks]);
+		if (result != DOCA_SUCCESS) {
+			DOCA_LOG_ERR("Failed to allocate DMA memcpy task: %s", doca_error_get_descr(result));
+			goto free_tasks;
+		}
+	}
+
+	nb_threads = sysconf(_SC_NPROCESSORS_ONLN);
+	if (nb_threads > MEMCPY_THREADS)
+		nb_threads = MEMCPY_THREADS;
+	if (nb_threads < 1)
+		nb_threads = 1;
+
+	printf("Local copy, %lu MB source and destination registered on %s\n", BUF_LEN >> 20, pcie_addr);
+	printf("Size\t\t DMA poll lat(us)\t DMA poll(GB/s)\t DMA event(GB/s)\t DMA event CPU(%%)\t"
+	       " memcpy lat(us)\t memcpy(GB/s)\t memcpy x%d(GB/s)\n", nb_threads);
+	for (s = 0; s < NB_SIZES; s++) {
+		if (sizes[s] > max_buffer_size || sizes[s] > BUF_LEN)
+			break;
+		result = measure_dma(&resources, src, dst, sizes[s], false, &poll_res);
+		if (result == DOCA_SUCCESS)
+			result = measure_dma(&resources, src, dst, sizes[s], true, &event_res);
+		if (result != DOCA_SUCCESS || task_result != DOCA_SUCCESS) {
+			DOCA_ERROR_PROPAGATE(result, task_result);
+			DOCA_LOG_ERR("Local DMA copy failed at %zu bytes: %s", sizes[s], doca_error_get_descr(result));
+			break;
+		}
+		if (measure_memcpy(src, dst, sizes[s], 1, &cpu_res) != 0 ||
+		    measure_memcpy(src, dst, sizes[s], nb_threads, &par_res) != 0) {
+			result = DOCA_ERROR_OPERATING_SYSTEM;
+			break;
+		}
+		printf("%-10zu\t %16.2f\t %14.3f\t %15.3f\t %16.1f\t %14.2f\t %12.3f\t %15.3f\n", sizes[s],
+		       poll_res.lat_us, poll_res.gbps, event_res.gbps, event_res.cpu_pct, cpu_res.lat_us, cpu_res.gbps,
+		       par_res.gbps);
+		fflush(stdout);
+	}
+
+free_tasks:
+	for (i = 0; i < nb_tasks; i++)
+		doca_task_free(doca_dma_task_memcpy_as_task(resources.tasks[i]));
+destroy_bufs:
+	for (i = 0; i < nb_bufs; i++) {
+		tmp_result = doca_buf_dec_refcount(resources.src_doca_buf_array[i], NULL);
+		DOCA_ERROR_PROPAGATE(tmp_result, doca_buf_dec_refcount(resources.dst_doca_buf_array[i], NULL));
+		if (tmp_result != DOCA_SUCCESS) {
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+			DOCA_LOG_ERR("Failed to decrease DOCA buffer reference count: %s", doca_error_get_descr(tmp_result));
+		}
+	}
+stop_dma:
+	tmp_result = request_stop_ctx(state->pe, state->ctx);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+		DOCA_LOG_ERR("Unable to stop context: %s", doca_error_get_descr(tmp_result));
+	}
+	state->ctx = NULL;
+destroy_resources:
+	tmp_result = destroy_dma_resources(&resources);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+		DOCA_LOG_ERR("Failed to destroy DMA resources: %s", doca_error_get_descr(tmp_result));
+	}
+	free(src);
+	free(dst);
+
+	return result;
+}
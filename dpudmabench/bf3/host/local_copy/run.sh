@@ -0,0 +1,20 @@
+# /*
+# * Copyright (c) 2025, University of California, Merced. All rights reserved.
+# *
+# * This file is part of the benchmarking software package developed by
+# * the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+# *
+# * For detailed copyright and licensing information, please refer to the license
+# * file LICENSE in the top level directory.
+# *
+# */
+
+
+# Runs on the host only, no DPU side is needed. Both buffers are host memory
+# registered on the same function, the engine on the card still reads and
+# writes them across PCIe.
+make clean
+make
+echo ""
+
+./doca_local_copy_host -p 01:00.0
@@ -0,0 +1,516 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+
+#include <doca_dev.h>
+#include <doca_error.h>
+#include <doca_log.h>
+#include <doca_mmap.h>
+
+#include "dma_common.h"
+#include "mmap_reg_cost.h"
+#include "reg_cache.h"
+
+DOCA_LOG_REGISTER(MMAP_REG_COST_HOST);
+
+#define HUGE_PAGE_SIZE (2UL << 20)	/* Huge page size of the MAP_HUGETLB runs */
+#define CACHE_ARENA_SIZE (256UL << 20)	/* Memory the dynamic buffers of the cache benchmark come from */
+#define CACHE_NB_BUFS 4096		/* Dynamic buffers of the cache benchmark */
+#define CACHE_MAX_BUF 65536		/* Largest dynamic buffer */
+#define CACHE_MAX_ENTRIES 256		/* Registration cache limit */
+#define CACHE_REQUESTS 100000		/* Buffer requests served through the cache */
+#define NOCACHE_REQUESTS 1000		/* Buffer requests registered one by one */
+
+/* Number of equally sized regions registered back to back */
+static const int region_counts[] = {1, 16, 256};
+#define NB_REGION_COUNTS (sizeof(region_counts) / sizeof(region_counts[0]))
+
+/*
+ * Elapsed time between two timestamps
+ *
+ * @start [in]: start timestamp
+ * @end [in]: end timestamp
+ * @return: elapsed time in nanoseconds
+ */
+static double
+elapsed_ns(const struct timespec *start, const struct timespec *end)
+{
+	return (end->tv_sec - start->tv_sec) * 1e9 + (end->tv_nsec - start->tv_nsec);
+}
+
+/*
+ * Create, populate, start and export an mmap, timing every step
+ *
+ * @dev [in]: DOCA device
+ * @addr [in]: region start
+ * @len [in]: region length
+ * @mmap [out]: started and exported mmap
+ * @desc [out]: export descriptor, owned by the mmap
+ * @desc_len [out]: export descriptor length
+ * @t [in/out]: step times are added to it
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+register_region(struct doca_dev *dev, void *addr, size_t len, struct doca_mmap **mmap, const void **desc,
+		size_t *desc_len, struct reg_times *t)
+{
+	struct timespec ts[5];
+	doca_error_t result;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts[0]);
+	result = doca_mmap_create(mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create mmap: %s", doca_error_get_descr(result));
+		return result;
+	}
+	result = doca_mmap_add_dev(*mmap, dev);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to add device to mmap: %s", doca_error_get_descr(result));
+		goto destroy_mmap;
+	}
+	result = doca_mmap_set_permissions(*mmap, DOCA_ACCESS_FLAG_PCI_READ_WRITE);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set mmap permissions: %s", doca_error_get_descr(result));
+		goto destroy_mmap;
+	}
+	clock_gettime(CLOCK_MONOTONIC, &ts[1]);
+
+	result = doca_mmap_set_memrange(*mmap, addr, len);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to set memory range for mmap: %s", doca_error_get_descr(result));
+		goto destroy_mmap;
+	}
+	clock_gettime(CLOCK_MONOTONIC, &ts[2]);
+
+	result = doca_mmap_start(*mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start mmap: %s", doca_error_get_descr(result));
+		goto destroy_mmap;
+	}
+	clock_gettime(CLOCK_MONOTONIC, &ts[3]);
+
+	result = doca_mmap_export_pci(*mmap, dev, desc, desc_len);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to export mmap: %s", doca_error_get_descr(result));
+		goto destroy_mmap;
+	}
+	clock_gettime(CLOCK_MONOTONIC, &ts[4]);
+
+	t->create += elapsed_ns(&ts[0], &ts[1]);
+	t->memrange += elapsed_ns(&ts[1], &ts[2]);
+	t->start += elapsed_ns(&ts[2], &ts[3]);
+	t->export_pci += elapsed_ns(&ts[3], &ts[4]);
+	return DOCA_SUCCESS;
+
+destroy_mmap:
+	doca_mmap_destroy(*mmap);
+	*mmap = NULL;
+	return result;
+}
+
+/*
+ * Destroy an mmap, timing it
+ *
+ * @mmap [in]: mmap
+ * @t [in/out]: destroy time is added to it
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+deregister_region(struct doca_mmap *mmap, struct reg_times *t)
+{
+	struct timespec start, end;
+	doca_error_t result;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	result = doca_mmap_destroy(mmap);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Failed to destroy mmap: %s", doca_error_get_descr(result));
+	t->destroy += elapsed_ns(&start, &end);
+	return result;
+}
+
+/*
+ * Allocate and populate anonymous memory, so page faults are not part of the registration
+ *
+ * @len [in]: length
+ * @huge [in]: back the memory with 2 MB huge pages
+ * @return: memory, NULL on failure
+ */
+static char *
+alloc_region(size_t len, bool huge)
+{
+	void *addr;
+
+	addr = mmap(NULL, len, PROT_READ | PROT_WRITE,
+		    MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE | (huge ? MAP_HUGETLB : 0), -1, 0);
+	return addr == MAP_FAILED ? NULL : addr;
+}
+
+/*
+ * Number of repetitions for a configuration, large registrations take seconds
+ *
+ * @bytes [in]: registered bytes per repetition
+ * @return: repetitions
+ */
+static int
+reps_for(size_t bytes)
+{
+	if (bytes <= (16UL << 20))
+		return 100;
+	if (bytes <= (1UL << 30))
+		return 10;
+	return 3;
+}
+
+/*
+ * Measure registering nb_regions regions of one size and page size
+ *
+ * @dev [in]: DOCA device
+ * @size [in]: region size
+ * @huge [in]: use 2 MB huge pages
+ * @nb_regions [in]: regions registered back to back
+ * @return: DOCA_SUCCESS on success (or if the memory is not available) and DOCA_ERROR otherwise
+ */
+static doca_error_t
+measure_config(struct doca_dev *dev, size_t size, bool huge, int nb_regions)
+{
+	struct reg_times t = {0};
+	struct doca_mmap **mmaps;
+	const void *desc;
+	size_t desc_len;
+	doca_error_t result = DOCA_SUCCESS, tmp_result;
+	int rep, reps, r, nb_registered = 0;
+	double n;
+	char *mem;
+
+	mem = alloc_region(size * nb_regions, huge);
+	if (mem == NULL) {
+		printf("%12zu\t %7d\t skipped, failed to allocate %zu bytes\n", size, nb_regions, size * nb_regions);
+		return DOCA_SUCCESS;
+	}
+	mmaps = calloc(nb_regions, sizeof(*mmaps));
+	if (mmaps == NULL) {
+		munmap(mem, size * nb_regions);
+		return DOCA_ERROR_NO_MEMORY;
+	}
+
+	reps = reps_for(size * nb_regions);
+	for (rep = 0; rep < reps && result == DOCA_SUCCESS; rep++) {
+		for (nb_registered = 0; nb_registered < nb_regions; nb_registered++) {
+			result = register_region(dev, mem + nb_registered * size, size, &mmaps[nb_registered], &desc,
+						 &desc_len, &t);
+			if (result != DOCA_SUCCESS)
+				break;
+		}
+		for (r = 0; r < nb_registered; r++) {
+			tmp_result = deregister_region(mmaps[r], &t);
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+		}
+	}
+
+	if (result == DOCA_SUCCESS) {
+		n = (double)reps * nb_regions * 1000;
+		printf("%12zu\t %7d\t %10.2f\t %12.2f\t %9.2f\t %10.2f\t %11.2f\t %9.2f\n", size, nb_regions,
+		       t.create / n, t.memrange / n, t.start / n, t.export_pci / n, t.destroy / n,
+		       (t.create + t.memrange + t.start + t.export_pci + t.destroy) / n);
+		fflush(stdout);
+	}
+
+	free(mmaps);
+	munmap(mem, size * nb_regions);
+	return result;
+}
+
+/*
+ * Sweep region size, page size and number of regions
+ *
+ * @dev [in]: DOCA device
+ * @max_region [in]: largest region and largest memory per configuration
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+sweep_registration(struct doca_dev *dev, size_t max_region)
+{
+	doca_error_t result;
+	size_t size, c;
+	int huge;
+
+	for (huge = 0; huge <= 1; huge++) {
+		printf("\nRegistration cost per region (us), page size: %s\n", huge ? "2 MB" : "4 KB");
+		printf("%12s\t %7s\t %10s\t %12s\t %9s\t %10s\t %11s\t %9s\n", "Region size", "Regions", "create",
+		       "set_memrange", "start", "export_pci", "destroy", "total");
+		for (size = huge ? HUGE_PAGE_SIZE : REG_MIN_SIZE; size <= max_region; size *= REG_SIZE_STEP) {
+			for (c = 0; c < NB_REGION_COUNTS; c++) {
+				if (size * region_counts[c] > max_region)
+					break;
+				result = measure_config(dev, size, huge, region_counts[c]);
+				if (result != DOCA_SUCCESS)
+					return result;
+			}
+		}
+	}
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Registration callback of the cache: a started and exported mmap per region
+ *
+ * @ctx [in]: DOCA device
+ * @addr [in]: region start
+ * @len [in]: region length
+ * @handle [out]: mmap
+ * @return: 0 on success and -1 otherwise
+ */
+static int
+cache_reg(void *ctx, void *addr, size_t len, void **handle)
+{
+	struct reg_times t = {0};
+	struct doca_mmap *mmap;
+	const void *desc;
+	size_t desc_len;
+
+	if (register_region(ctx, addr, len, &mmap, &desc, &desc_len, &t) != DOCA_SUCCESS)
+		return -1;
+	*handle = mmap;
+	return 0;
+}
+
+/*
+ * Deregistration callback of the cache
+ *
+ * @ctx [in]: DOCA device
+ * @handle [in]: mmap
+ */
+static void
+cache_dereg(void *ctx, void *handle)
+{
+	(void)ctx;
+	doca_mmap_destroy(handle);
+}
+
+/*
+ * Compare per-buffer registration against the registration cache for dynamically allocated buffers
+ *
+ * 90% of the requests go to 10% of the buffers, like a service that keeps reusing its hot buffers.
+ *
+ * @dev [in]: DOCA device
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+measure_cache(struct doca_dev *dev)
+{
+	static const struct reg_cache_ops ops = {.reg = cache_reg, .dereg = cache_dereg};
+	struct reg_cache_stats stats;
+	struct reg_cache *cache;
+	struct reg_entry *entry;
+	struct reg_times t = {0};
+	struct timespec start, end;
+	struct doca_mmap *mmap;
+	const void *desc;
+	size_t *offsets, *lens, desc_len;
+	doca_error_t result = DOCA_SUCCESS;
+	double nocache_ns, cache_ns;
+	char *arena;
+	int i, b;
+
+	arena = alloc_region(CACHE_ARENA_SIZE, false);
+	offsets = calloc(CACHE_NB_BUFS, sizeof(*offsets));
+	lens = calloc(CACHE_NB_BUFS, sizeof(*lens));
+	if (arena == NULL || offsets == NULL || lens == NULL) {
+		DOCA_LOG_ERR("Failed to allocate the cache benchmark buffers");
+		result = DOCA_ERROR_NO_MEMORY;
+		goto free_bufs;
+	}
+
+	srand(1);
+	for (b = 0; b < CACHE_NB_BUFS; b++) {
+		lens[b] = 64 + rand() % (CACHE_MAX_BUF - 64);
+		offsets[b] = (rand() % ((CACHE_ARENA_SIZE - CACHE_MAX_BUF) / 64)) * 64;
+	}
+
+	/* Without cache every request registers, exports and destroys its buffer */
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < NOCACHE_REQUESTS; i++) {
+		b = rand() % CACHE_NB_BUFS;
+		result = register_region(dev, arena + offsets[b], lens[b], &mmap, &desc, &desc_len, &t);
+		if (result != DOCA_SUCCESS)
+			goto free_bufs;
+		doca_mmap_destroy(mmap);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	nocache_ns = elapsed_ns(&start, &end) / NOCACHE_REQUESTS;
+
+	cache = reg_cache_create(&ops, dev, sysconf(_SC_PAGESIZE), CACHE_MAX_ENTRIES, 0);
+	if (cache == NULL) {
+		result = DOCA_ERROR_NO_MEMORY;
+		goto free_bufs;
+	}
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < CACHE_REQUESTS; i++) {
+		if (rand() % 10 != 0)
+			b = rand() % (CACHE_NB_BUFS / 10);
+		else
+			b = rand() % CACHE_NB_BUFS;
+		entry = reg_cache_get(cache, arena + offsets[b], lens[b]);
+		if (entry == NULL) {
+			DOCA_LOG_ERR("Registration cache failed to register buffer %d", b);
+			result = DOCA_ERROR_DRIVER;
+			break;
+		}
+		reg_cache_put(cache, entry);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	cache_ns = elapsed_ns(&start, &end) / CACHE_REQUESTS;
+
+	reg_cache_get_stats(cache, &stats);
+	reg_cache_destroy(cache);
+
+	if (result == DOCA_SUCCESS) {
+		printf("\nDynamic buffers: %d of 64 to %d bytes, %d-entry registration cache\n", CACHE_NB_BUFS,
+		       CACHE_MAX_BUF, CACHE_MAX_ENTRIES);
+		printf("Without cache, register + export + destroy per request (us) = %.2f\n", nocache_ns / 1000);
+		printf("With cache, get + put per request (us) = %.2f\n", cache_ns / 1000);
+		printf("Hits = %" PRIu64 ", misses = %" PRIu64 ", evictions = %" PRIu64 ", hit rate = %.2f%%\n", stats.hits, stats.misses,
+		       stats.evictions, 100.0 * stats.hits / (stats.hits + stats.misses));
+	}
+
+free_bufs:
+	free(lens);
+	free(offsets);
+	if (arena != NULL)
+		munmap(arena, CACHE_ARENA_SIZE);
+	return result;
+}
+
+/*
+ * Export one region per sweep size for the import measurement on the DPU and wait until it is done
+ *
+ * @dev [in]: DOCA device
+ * @max_region [in]: largest region
+ * @export_desc_file_path [in]: export descriptor file, see mmap_reg_cost.h
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+export_for_import(struct doca_dev *dev, size_t max_region, const char *export_desc_file_path)
+{
+	struct doca_mmap *mmaps[64];
+	struct reg_times t = {0};
+	const void *desc;
+	size_t size, desc_len;
+	uint64_t header[2] = {REG_DESC_MAGIC, 0}, record[2];
+	doca_error_t result = DOCA_SUCCESS, tmp_result;
+	size_t sizes[64];
+	char *mem[64];
+	int i, nb = 0, enter = 0;
+	FILE *fp;
+
+	fp = fopen(export_desc_file_path, "wb");
+	if (fp == NULL) {
+		DOCA_LOG_ERR("Failed to create %s", export_desc_file_path);
+		return DOCA_ERROR_IO_FAILED;
+	}
+	/* The region count is rewritten once known */
+	fwrite(header, sizeof(header), 1, fp);
+
+	for (size = REG_MIN_SIZE; size <= max_region && nb < 64; size *= REG_SIZE_STEP) {
+		mem[nb] = alloc_region(size, false);
+		if (mem[nb] == NULL)
+			break;
+		result = register_region(dev, mem[nb], size, &mmaps[nb], &desc, &desc_len, &t);
+		if (result != DOCA_SUCCESS) {
+			munmap(mem[nb], size);
+			goto destroy_regions;
+		}
+		record[0] = size;
+		record[1] = desc_len;
+		sizes[nb++] = size;
+		if (fwrite(record, sizeof(record), 1, fp) != 1 || fwrite(desc, 1, desc_len, fp) != desc_len) {
+			DOCA_LOG_ERR("Failed to write %s", export_desc_file_path);
+			result = DOCA_ERROR_IO_FAILED;
+			goto destroy_regions;
+		}
+	}
+
+	header[1] = nb;
+	if (fseek(fp, 0, SEEK_SET) != 0 || fwrite(header, sizeof(header), 1, fp) != 1) {
+		DOCA_LOG_ERR("Failed to write %s", export_desc_file_path);
+		result = DOCA_ERROR_IO_FAILED;
+		goto destroy_regions;
+	}
+	fclose(fp);
+	fp = NULL;
+
+	DOCA_LOG_INFO("Exported %d regions, please copy %s to the DPU and run the DPU side", nb, export_desc_file_path);
+	DOCA_LOG_INFO("Wait till the DPU has finished and press enter");
+	while (enter != '\r' && enter != '\n')
+		enter = getchar();
+
+destroy_regions:
+	if (fp != NULL)
+		fclose(fp);
+	for (i = 0; i < nb; i++) {
+		tmp_result = doca_mmap_destroy(mmaps[i]);
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+		munmap(mem[i], sizes[i]);
+	}
+	return result;
+}
+
+/*
+ * Run DOCA mmap registration cost benchmark on the Host
+ *
+ * @pcie_addr [in]: Device PCI address
+ * @max_region [in]: Largest region size of the sweep
+ * @export_desc_file_path [in]: Export descriptor file path
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t
+mmap_reg_cost_host(const char *pcie_addr, size_t max_region, const char *export_desc_file_path)
+{
+	struct doca_dev *dev;
+	doca_error_t result, tmp_result;
+
+	result = open_doca_device_with_pci(pcie_addr, &dma_task_is_supported, &dev);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to open DOCA device: %s", doca_error_get_descr(result));
+		return result;
+	}
+
+	result = sweep_registration(dev, max_region);
+	if (result != DOCA_SUCCESS)
+		goto close_device;
+
+	result = measure_cache(dev);
+	if (result != DOCA_SUCCESS)
+		goto close_device;
+
+	result = export_for_import(dev, max_region, export_desc_file_path);
+
+close_device:
+	tmp_result = doca_dev_close(dev);
+	if (tmp_result != DOCA_SUCCESS) {
+		DOCA_ERROR_PROPAGATE(result, tmp_result);
+		DOCA_LOG_ERR("Failed to close DOCA device: %s", doca_error_get_descr(tmp_result));
+	}
+
+	return result;
+}
@@ -0,0 +1,424 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "reg_cache.h"
+
+struct reg_cache {
+	struct reg_cache_ops ops;	/* Registration callbacks */
+	void *ctx;			/* User context of the callbacks */
+	uintptr_t align;		/* Registration alignment */
+	size_t max_entries;		/* Entry limit, 0 for none */
+	size_t max_bytes;		/* Byte limit, 0 for none */
+	struct reg_entry *root;		/* Interval tree */
+	struct reg_entry *lru_head;	/* Most recently used */
+	struct reg_entry *lru_tail;	/* Least recently used */
+	uint32_t seed;			/* Treap priority generator */
+	struct reg_cache_stats stats;	/* Counters */
+};
+
+/*
+ * Next treap priority (xorshift32)
+ *
+ * @cache [in]: registration cache
+ * @return: pseudo-random priority
+ */
+static uint32_t
+next_prio(struct reg_cache *cache)
+{
+	uint32_t x = cache->seed;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	cache->seed = x;
+	return x;
+}
+
+/*
+ * Recompute the subtree maximum of a node from its children
+ *
+ * @n [in]: tree node
+ */
+static void
+update_max(struct reg_entry *n)
+{
+	n->max_end = n->end;
+	if (n->left != NULL && n->left->max_end > n->max_end)
+		n->max_end = n->left->max_end;
+	if (n->right != NULL && n->right->max_end > n->max_end)
+		n->max_end = n->right->max_end;
+}
+
+/*
+ * Tree order: by start, ties broken by address of the entry
+ *
+ * @a [in]: first entry
+ * @b [in]: second entry
+ * @return: non-zero if a sorts before b
+ */
+static int
+entry_less(const struct reg_entry *a, const struct reg_entry *b)
+{
+	return a->start < b->start || (a->start == b->start && (uintptr_t)a < (uintptr_t)b);
+}
+
+/*
+ * Rotate a subtree right, its left child becomes the root
+ *
+ * @n [in]: subtree root
+ * @return: new subtree root
+ */
+static struct reg_entry *
+rotate_right(struct reg_entry *n)
+{
+	struct reg_entry *l = n->left;
+
+	n->left = l->right;
+	l->right = n;
+	update_max(n);
+	update_max(l);
+	return l;
+}
+
+/*
+ * Rotate a subtree left, its right child becomes the root
+ *
+ * @n [in]: subtree root
+ * @return: new subtree root
+ */
+static struct reg_entry *
+rotate_left(struct reg_entry *n)
+{
+	struct reg_entry *r = n->right;
+
+	n->right = r->left;
+	r->left = n;
+	update_max(n);
+	update_max(r);
+	return r;
+}
+
+/*
+ * Insert an entry into a subtree
+ *
+ * @n [in]: subtree root
+ * @e [in]: entry to insert
+ * @return: new subtree root
+ */
+static struct reg_entry *
+tree_insert(struct reg_entry *n, struct reg_entry *e)
+{
+	if (n == NULL)
+		return e;
+
+	if (entry_less(e, n)) {
+		n->left = tree_insert(n->left, e);
+		if (n->left->prio > n->prio)
+			return rotate_right(n);
+	} else {
+		n->right = tree_insert(n->right, e);
+		if (n->right->prio > n->prio)
+			return rotate_left(n);
+	}
+	update_max(n);
+	return n;
+}
+
+/*
+ * Remove an entry from a subtree
+ *
+ * @n [in]: subtree root
+ * @e [in]: entry to remove, must be in the subtree
+ * @return: new subtree root
+ */
+static struct reg_entry *
+tree_remove(struct reg_entry *n, struct reg_entry *e)
+{
+	if (n == e) {
+		if (n->left == NULL)
+			return n->right;
+		if (n->right == NULL)
+			return n->left;
+		/* Rotate the entry down below its higher priority child */
+		if (n->left->prio > n->right->prio) {
+			n = rotate_right(n);
+			n->right = tree_remove(n->right, e);
+		} else {
+			n = rotate_left(n);
+			n->left = tree_remove(n->left, e);
+		}
+	} else if (entry_less(e, n)) {
+		n->left = tree_remove(n->left, e);
+	} else {
+		n->right = tree_remove(n->right, e);
+	}
+	update_max(n);
+	return n;
+}
+
+/*
+ * Find a region containing [start, end)
+ *
+ * @n [in]: subtree root
+ * @start [in]: range start
+ * @end [in]: range end
+ * @return: covering entry, NULL if none
+ */
+static struct reg_entry *
+tree_find_covering(struct reg_entry *n, uintptr_t start, uintptr_t end)
+{
+	struct reg_entry *e;
+
+	if (n == NULL || n->max_end < end)
+		return NULL;
+
+	e = tree_find_covering(n->left, start, end);
+	if (e != NULL)
+		return e;
+	if (n->start <= start && n->end >= end)
+		return n;
+	/* Everything on the right starts after n, so it cannot cover start if n does not */
+	if (n->start > start)
+		return NULL;
+	return tree_find_covering(n->right, start, end);
+}
+
+/*
+ * Find a region overlapping [start, end)
+ *
+ * @n [in]: subtree root
+ * @start [in]: range start
+ * @end [in]: range end
+ * @in_use [in]: look for regions with users (true) or without (false)
+ * @return: overlapping entry, NULL if none
+ */
+static struct reg_entry *
+tree_find_overlap(struct reg_entry *n, uintptr_t start, uintptr_t end, int in_use)
+{
+	struct reg_entry *e;
+
+	if (n == NULL || n->max_end <= start)
+		return NULL;
+
+	e = tree_find_overlap(n->left, start, end, in_use);
+	if (e != NULL)
+		return e;
+	if (n->start >= end)
+		return NULL;
+	if (n->end > start && (n->refcnt > 0) == in_use)
+		return n;
+	return tree_find_overlap(n->right, start, end, in_use);
+}
+
+/*
+ * Count the regions with users overlapping [start, end)
+ *
+ * @n [in]: subtree root
+ * @start [in]: range start
+ * @end [in]: range end
+ * @return: number of regions
+ */
+static int
+tree_count_used(const struct reg_entry *n, uintptr_t start, uintptr_t end)
+{
+	int count;
+
+	if (n == NULL || n->max_end <= start)
+		return 0;
+
+	count = tree_count_used(n->left, start, end);
+	if (n->start >= end)
+		return count;
+	if (n->end > start && n->refcnt > 0)
+		count++;
+	return count + tree_count_used(n->right, start, end);
+}
+
+/*
+ * Remove an entry from the LRU list
+ *
+ * @cache [in]: registration cache
+ * @e [in]: entry
+ */
+static void
+lru_unlink(struct reg_cache *cache, struct reg_entry *e)
+{
+	if (e->lru_prev != NULL)
+		e->lru_prev->lru_next = e->lru_next;
+	else
+		cache->lru_head = e->lru_next;
+	if (e->lru_next != NULL)
+		e->lru_next->lru_prev = e->lru_prev;
+	else
+		cache->lru_tail = e->lru_prev;
+	e->lru_prev = e->lru_next = NULL;
+}
+
+/*
+ * Insert an entry as the most recently used one
+ *
+ * @cache [in]: registration cache
+ * @e [in]: entry
+ */
+static void
+lru_push_front(struct reg_cache *cache, struct reg_entry *e)
+{
+	e->lru_prev = NULL;
+	e->lru_next = cache->lru_head;
+	if (cache->lru_head != NULL)
+		cache->lru_head->lru_prev = e;
+	else
+		cache->lru_tail = e;
+	cache->lru_head = e;
+}
+
+/*
+ * Deregister and free an unused entry
+ *
+ * @cache [in]: registration cache
+ * @e [in]: entry
+ */
+static void
+remove_entry(struct reg_cache *cache, struct reg_entry *e)
+{
+	cache->root = tree_remove(cache->root, e);
+	lru_unlink(cache, e);
+	cache->stats.nb_entries--;
+	cache->stats.nb_bytes -= e->end - e->start;
+	cache->ops.dereg(cache->ctx, e->handle);
+	free(e);
+}
+
+/*
+ * Evict unused regions in LRU order until a new region of len bytes fits the limits
+ *
+ * @cache [in]: registration cache
+ * @len [in]: length of the region about to be registered
+ */
+static void
+make_room(struct reg_cache *cache, size_t len)
+{
+	struct reg_entry *e = cache->lru_tail, *prev;
+
+	while (e != NULL && ((cache->max_entries && cache->stats.nb_entries + 1 > cache->max_entries) ||
+			     (cache->max_bytes && cache->stats.nb_bytes + len > cache->max_bytes))) {
+		prev = e->lru_prev;
+		if (e->refcnt == 0) {
+			remove_entry(cache, e);
+			cache->stats.evictions++;
+		}
+		e = prev;
+	}
+}
+
+struct reg_cache *
+reg_cache_create(const struct reg_cache_ops *ops, void *ctx, size_t align, size_t max_entries, size_t max_bytes)
+{
+	struct reg_cache *cache;
+
+	if (align == 0 || (align & (align - 1)) != 0) {
+		fprintf(stderr, "Registration alignment must be a power of two\n");
+		return NULL;
+	}
+
+	cache = calloc(1, sizeof(*cache));
+	if (cache == NULL)
+		return NULL;
+
+	cache->ops = *ops;
+	cache->ctx = ctx;
+	cache->align = align;
+	cache->max_entries = max_entries;
+	cache->max_bytes = max_bytes;
+	cache->seed = 2463534242u;
+	return cache;
+}
+
+struct reg_entry *
+reg_cache_get(struct reg_cache *cache, void *addr, size_t len)
+{
+	uintptr_t start = (uintptr_t)addr, end = start + len;
+	struct reg_entry *e;
+
+	e = tree_find_covering(cache->root, start, end);
+	if (e != NULL) {
+		cache->stats.hits++;
+		lru_unlink(cache, e);
+		lru_push_front(cache, e);
+		e->refcnt++;
+		return e;
+	}
+
+	cache->stats.misses++;
+
+	e = calloc(1, sizeof(*e));
+	if (e == NULL)
+		return NULL;
+	e->start = start & ~(cache->align - 1);
+	e->end = (end + cache->align - 1) & ~(cache->align - 1);
+
+	make_room(cache, e->end - e->start);
+
+	if (cache->ops.reg(cache->ctx, (void *)e->start, e->end - e->start, &e->handle) != 0) {
+		free(e);
+		return NULL;
+	}
+
+	e->prio = next_prio(cache);
+	e->max_end = e->end;
+	e->refcnt = 1;
+	cache->root = tree_insert(cache->root, e);
+	lru_push_front(cache, e);
+	cache->stats.nb_entries++;
+	cache->stats.nb_bytes += e->end - e->start;
+	return e;
+}
+
+void
+reg_cache_put(struct reg_cache *cache, struct reg_entry *entry)
+{
+	if (entry->refcnt > 0)
+		entry->refcnt--;
+	/* Entries above the limits are only evicted on the next miss, so a put stays cheap */
+	(void)cache;
+}
+
+int
+reg_cache_invalidate(struct reg_cache *cache, void *addr, size_t len)
+{
+	uintptr_t start = (uintptr_t)addr, end = start + len;
+	struct reg_entry *e;
+
+	while ((e = tree_find_overlap(cache->root, start, end, 0)) != NULL)
+		remove_entry(cache, e);
+
+	return tree_count_used(cache->root, start, end);
+}
+
+void
+reg_cache_get_stats(const struct reg_cache *cache, struct reg_cache_stats *stats)
+{
+	*stats = cache->stats;
+}
+
+void
+reg_cache_destroy(struct reg_cache *cache)
+{
+	while (cache->lru_head != NULL) {
+		cache->lru_head->refcnt = 0;
+		remove_entry(cache, cache->lru_head);
+	}
+	free(cache);
+}
@@ -0,0 +1,134 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+#ifndef REG_CACHE_H_
+#define REG_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Registration cache
+ *
+ * Registered (and exported) memory regions are kept in an interval tree keyed by address range, so a buffer that
+ * lies inside an already registered region reuses it instead of paying doca_mmap_set_memrange + doca_mmap_start +
+ * doca_mmap_export_pci again. Regions that are not in use are evicted in LRU order once the cache exceeds its entry
+ * or byte limit. The cache does not know about DOCA, the caller provides the register/deregister callbacks.
+ */
+
+/* Registration callbacks */
+struct reg_cache_ops {
+	/*
+	 * Register [addr, addr + len)
+	 *
+	 * @ctx [in]: user context given to reg_cache_create()
+	 * @addr [in]: region start, aligned to the cache alignment
+	 * @len [in]: region length, multiple of the cache alignment
+	 * @handle [out]: registration handle, e.g. a started and exported doca_mmap
+	 * @return: 0 on success and -1 otherwise
+	 */
+	int (*reg)(void *ctx, void *addr, size_t len, void **handle);
+
+	/*
+	 * Deregister a region registered by reg()
+	 *
+	 * @ctx [in]: user context given to reg_cache_create()
+	 * @handle [in]: registration handle
+	 */
+	void (*dereg)(void *ctx, void *handle);
+};
+
+/* One registered region */
+struct reg_entry {
+	uintptr_t start;		/* First byte of the region */
+	uintptr_t end;			/* One past the last byte of the region */
+	void *handle;			/* Handle returned by reg_cache_ops.reg */
+	int refcnt;			/* Users between reg_cache_get() and reg_cache_put() */
+	/* Interval tree (treap ordered by start, heap ordered by prio) */
+	struct reg_entry *left;
+	struct reg_entry *right;
+	uintptr_t max_end;		/* Largest end in this subtree */
+	uint32_t prio;			/* Treap priority */
+	/* LRU list, most recently used first */
+	struct reg_entry *lru_prev;
+	struct reg_entry *lru_next;
+};
+
+/* Cache counters */
+struct reg_cache_stats {
+	uint64_t hits;			/* Lookups served by an existing region */
+	uint64_t misses;		/* Lookups that registered a new region */
+	uint64_t evictions;		/* Regions deregistered to stay within the limits */
+	size_t nb_entries;		/* Regions currently registered */
+	size_t nb_bytes;		/* Bytes currently registered */
+};
+
+struct reg_cache;
+
+/*
+ * Create a registration cache
+ *
+ * @ops [in]: registration callbacks
+ * @ctx [in]: user context passed to the callbacks
+ * @align [in]: registrations are widened to this power-of-two alignment (e.g. the page size) to increase reuse
+ * @max_entries [in]: maximum number of registered regions, 0 for no limit
+ * @max_bytes [in]: maximum number of registered bytes, 0 for no limit
+ * @return: cache, NULL on failure
+ */
+struct reg_cache *reg_cache_create(const struct reg_cache_ops *ops, void *ctx, size_t align, size_t max_entries,
+				   size_t max_bytes);
+
+/*
+ * Find or register a region covering [addr, addr + len)
+ *
+ * The entry stays registered until the matching reg_cache_put().
+ *
+ * @cache [in]: registration cache
+ * @addr [in]: buffer start
+ * @len [in]: buffer length
+ * @return: entry covering the buffer, NULL if the registration failed
+ */
+struct reg_entry *reg_cache_get(struct reg_cache *cache, void *addr, size_t len);
+
+/*
+ * Release an entry returned by reg_cache_get()
+ *
+ * @cache [in]: registration cache
+ * @entry [in]: entry
+ */
+void reg_cache_put(struct reg_cache *cache, struct reg_entry *entry);
+
+/*
+ * Deregister every unused region overlapping [addr, addr + len), e.g. before the memory is freed
+ *
+ * @cache [in]: registration cache
+ * @addr [in]: range start
+ * @len [in]: range length
+ * @return: number of regions still in use that overlap the range
+ */
+int reg_cache_invalidate(struct reg_cache *cache, void *addr, size_t len);
+
+/*
+ * Read the cache counters
+ *
+ * @cache [in]: registration cache
+ * @stats [out]: counters
+ */
+void reg_cache_get_stats(const struct reg_cache *cache, struct reg_cache_stats *stats);
+
+/*
+ * Deregister every region and free the cache
+ *
+ * @cache [in]: registration cache
+ */
+void reg_cache_destroy(struct reg_cache *cache);
+
+#endif
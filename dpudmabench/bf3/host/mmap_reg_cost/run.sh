@@ -0,0 +1,22 @@
+# /*
+# * Copyright (c) 2025, University of California, Merced. All rights reserved.
+# *
+# * This file is part of the benchmarking software package developed by
+# * the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+# *
+# * For detailed copyright and licensing information, please refer to the license
+# * file LICENSE in the top level directory.
+# *
+# */
+
+# Usage: run.sh <largest region size in bytes>, e.g. 68719476736 for 64 GB
+# 2 MB pages are used for the huge page rows, reserve them first, e.g.
+#   echo 32768 > /sys/kernel/mm/hugepages/hugepages-2048kB/nr_hugepages
+len=$1
+sed -i "/max_region =/c\	max_region = ${len}UL;" mmap_reg_cost_host_main.c
+
+make clean
+make
+echo ""
+
+./doca_mmap_reg_cost_host -p 01:00.0
@@ -0,0 +1,153 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <doca_argp.h>
+#include <doca_dev.h>
+#include <doca_log.h>
+
+#include <utils.h>
+
+#include "multi_dev.h"
+
+DOCA_LOG_REGISTER(MULTI_DEV_HOST::MAIN);
+
+/* Sample's Logic */
+doca_error_t multi_dev_host(char *devs, size_t length, const char *export_desc_file_path,
+			    const char *buffer_info_file_path);
+
+/*
+ * ARGP Callback - Handle device list parameter
+ *
+ * @param [in]: Input parameter
+ * @config [in/out]: Program configuration context
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+devs_callback(void *param, void *config)
+{
+	struct multi_dev_config *conf = (struct multi_dev_config *)config;
+	const char *devs = (char *)param;
+
+	if (strnlen(devs, MAX_ARG_SIZE) >= MAX_ARG_SIZE) {
+		DOCA_LOG_ERR("Entered device list exceeding the maximum size of %d", MAX_USER_ARG_SIZE);
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+	strlcpy(conf->devs, devs, MAX_ARG_SIZE);
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Register the device list parameter
+ *
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+register_devs_param(void)
+{
+	struct doca_argp_param *devs_param;
+	doca_error_t result;
+
+	result = doca_argp_param_create(&devs_param);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to create ARGP param: %s", doca_error_get_descr(result));
+		return result;
+	}
+	doca_argp_param_set_short_name(devs_param, "l");
+	doca_argp_param_set_long_name(devs_param, "devs");
+	doca_argp_param_set_description(devs_param, "Comma separated PCI addresses of the functions to export through");
+	doca_argp_param_set_callback(devs_param, devs_callback);
+	doca_argp_param_set_type(devs_param, DOCA_ARGP_TYPE_STRING);
+	result = doca_argp_register_param(devs_param);
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Failed to register program param: %s", doca_error_get_descr(result));
+	return result;
+}
+
+/*
+ * Sample main function
+ *
+ * @argc [in]: command line arguments size
+ * @argv [in]: array of command line arguments
+ * @return: EXIT_SUCCESS on success and EXIT_FAILURE otherwise
+ */
+int
+main(int argc, char **argv)
+{
+	struct multi_dev_config conf = {0};
+	size_t length;
+	doca_error_t result;
+	struct doca_log_backend *sdk_log;
+	int exit_status = EXIT_FAILURE;
+
+	/* Set the default configuration values (Example values), both PFs */
+	strcpy(conf.devs, "b1:00.0,b1:00.1");
+	strcpy(conf.dma_conf.export_desc_path, "/tmp/export_desc.txt");
+	strcpy(conf.dma_conf.buf_info_path, "/tmp/buffer_info.txt");
+
+	/* Register a logger backend */
+	result = doca_log_backend_create_standard();
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+
+	/* Register a logger backend for internal SDK errors and warnings */
+	result = doca_log_backend_create_with_file_sdk(stderr, &sdk_log);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+	result = doca_log_backend_set_sdk_level(sdk_log, DOCA_LOG_LEVEL_WARNING);
+	if (result != DOCA_SUCCESS)
+		goto sample_exit;
+
+	result = doca_argp_init("doca_multi_dev_host", &conf);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to init ARGP resources: %s", doca_error_get_descr(result));
+		goto sample_exit;
+	}
+	result = register_dma_params(true);
+	if (result == DOCA_SUCCESS)
+		result = register_devs_param();
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to register DMA sample parameters: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+	result = doca_argp_start(argc, argv);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to parse sample input: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+#ifndef DOCA_ARCH_HOST
+	DOCA_LOG_ERR("Sample can run only on the Host");
+	goto argp_cleanup;
+#endif
+	/* Host buffer of every device, set by run.sh */
+	length = 33554432;
+
+	result = multi_dev_host(conf.devs, length, conf.dma_conf.export_desc_path, conf.dma_conf.buf_info_path);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("multi_dev_host() encountered an error: %s", doca_error_get_descr(result));
+		goto argp_cleanup;
+	}
+
+	exit_status = EXIT_SUCCESS;
+
+argp_cleanup:
+	doca_argp_destroy();
+sample_exit:
+	if (exit_status == EXIT_SUCCESS)
+		DOCA_LOG_INFO("Sample finished successfully");
+	else
+		DOCA_LOG_INFO("Sample finished with errors");
+	return exit_status;
+}
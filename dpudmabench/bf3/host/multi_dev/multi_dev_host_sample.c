@@ -0,0 +1,190 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <doca_dev.h>
+#include <doca_error.h>
+#include <doca_log.h>
+#include <doca_mmap.h>
+
+#include "multi_dev.h"
+
+DOCA_LOG_REGISTER(MULTI_DEV_HOST);
+
+/* One exported function */
+struct export_dev {
+	const char *pcie_addr;		/* PCI address of the function */
+	struct doca_dev *dev;		/* DOCA device */
+	struct doca_mmap *mmap;		/* Exported mmap */
+	char *buffer;			/* Buffer behind the mmap */
+};
+
+/*
+ * Saves export descriptor and buffer information into two separate files
+ *
+ * @export_desc [in]: Export descriptor to write into a file
+ * @export_desc_len [in]: Export descriptor length
+ * @buffer [in]: Exported buffer
+ * @buffer_len [in]: Exported buffer length
+ * @export_desc_file_path [in]: Export descriptor file path
+ * @buffer_info_file_path [in]: Buffer information file path
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+save_config_info_to_files(const void *export_desc, size_t export_desc_len, const char *buffer, size_t buffer_len,
+			  const char *export_desc_file_path, const char *buffer_info_file_path)
+{
+	FILE *fp;
+
+	fp = fopen(export_desc_file_path, "wb");
+	if (fp == NULL) {
+		DOCA_LOG_ERR("Failed to create %s", export_desc_file_path);
+		return DOCA_ERROR_IO_FAILED;
+	}
+	if (fwrite(export_desc, 1, export_desc_len, fp) != export_desc_len) {
+		DOCA_LOG_ERR("Failed to write all data into %s", export_desc_file_path);
+		fclose(fp);
+		return DOCA_ERROR_IO_FAILED;
+	}
+	fclose(fp);
+
+	fp = fopen(buffer_info_file_path, "w");
+	if (fp == NULL) {
+		DOCA_LOG_ERR("Failed to create %s", buffer_info_file_path);
+		return DOCA_ERROR_IO_FAILED;
+	}
+	fprintf(fp, "%" PRIu64 "\n", (uint64_t)(uintptr_t)buffer);
+	fprintf(fp, "%" PRIu64 "", (uint64_t)buffer_len);
+	fclose(fp);
+
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Export a buffer of its own through one function
+ *
+ * @e [in]: exported function, pcie_addr set
+ * @length [in]: buffer length
+ * @export_desc [out]: export descriptor
+ * @export_desc_len [out]: export descriptor length
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+export_one(struct export_dev *e, size_t length, const void **export_desc, size_t *export_desc_len)
+{
+	doca_error_t result;
+
+	result = open_doca_device_with_pci(e->pcie_addr, &dma_task_is_supported, &e->dev);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to open DOCA device %s: %s", e->pcie_addr, doca_error_get_descr(result));
+		return result;
+	}
+
+	if (posix_memalign((void **)&e->buffer, 4096, length) != 0) {
+		DOCA_LOG_ERR("Failed to allocate %zu bytes for %s", length, e->pcie_addr);
+		e->buffer = NULL;
+		return DOCA_ERROR_NO_MEMORY;
+	}
+	memset(e->buffer, '1', length);
+
+	/* Read-write, the DPU side runs both directions */
+	result = doca_mmap_create(&e->mmap);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_add_dev(e->mmap, e->dev);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_set_permissions(e->mmap, DOCA_ACCESS_FLAG_PCI_READ_WRITE);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_set_memrange(e->mmap, e->buffer, length);
+	if (result == DOCA_SUCCESS)
+		result = doca_mmap_start(e->mmap);
+	if (result != DOCA_SUCCESS) {
+		DOCA_LOG_ERR("Failed to start mmap on %s: %s", e->pcie_addr, doca_error_get_descr(result));
+		return result;
+	}
+
+	result = doca_mmap_export_pci(e->mmap, e->dev, export_desc, export_desc_len);
+	if (result != DOCA_SUCCESS)
+		DOCA_LOG_ERR("Failed to export mmap on %s: %s", e->pcie_addr, doca_error_get_descr(result));
+	return result;
+}
+
+/*
+ * Run DOCA multi-device DMA sample on the Host, exporting one buffer through every function of the list
+ *
+ * @devs [in]: comma separated PCI addresses, modified in place
+ * @length [in]: buffer length of every function
+ * @export_desc_file_path [in]: Base of the export descriptor file paths
+ * @buffer_info_file_path [in]: Base of the buffer info file paths
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+doca_error_t
+multi_dev_host(char *devs, size_t length, const char *export_desc_file_path, const char *buffer_info_file_path)
+{
+	struct export_dev exports[MAX_DEVS] = {0};
+	char desc_path[MAX_ARG_SIZE + 8], info_path[MAX_ARG_SIZE + 8];
+	const void *export_desc;
+	size_t export_desc_len;
+	doca_error_t result = DOCA_SUCCESS, tmp_result;
+	char *tok, *saveptr;
+	int i, nb_devs = 0, enter = 0;
+
+	for (tok = strtok_r(devs, DEV_LIST_SEP, &saveptr); tok != NULL; tok = strtok_r(NULL, DEV_LIST_SEP, &saveptr)) {
+		if (nb_devs == MAX_DEVS) {
+			DOCA_LOG_ERR("At most %d devices are supported", MAX_DEVS);
+			return DOCA_ERROR_INVALID_VALUE;
+		}
+		exports[nb_devs++].pcie_addr = tok;
+	}
+	if (nb_devs == 0) {
+		DOCA_LOG_ERR("Empty device list");
+		return DOCA_ERROR_INVALID_VALUE;
+	}
+
+	for (i = 0; i < nb_devs; i++) {
+		result = export_one(&exports[i], length, &export_desc, &export_desc_len);
+		if (result != DOCA_SUCCESS)
+			goto destroy_exports;
+
+		snprintf(desc_path, sizeof(desc_path), "%s.%d", export_desc_file_path, i);
+		snprintf(info_path, sizeof(info_path), "%s.%d", buffer_info_file_path, i);
+		result = save_config_info_to_files(export_desc, export_desc_len, exports[i].buffer, length, desc_path,
+						   info_path);
+		if (result != DOCA_SUCCESS)
+			goto destroy_exports;
+		DOCA_LOG_INFO("Exported %zu bytes through %s to %s and %s", length, exports[i].pcie_addr, desc_path,
+			      info_path);
+	}
+
+	DOCA_LOG_INFO("Please copy the %d descriptor/buffer file pairs to the DPU and run the DPU side", nb_devs);
+	DOCA_LOG_INFO("Wait till the DPU has finished and press enter");
+	while (enter != '\r' && enter != '\n')
+		enter = getchar();
+
+destroy_exports:
+	for (i = 0; i < nb_devs; i++) {
+		if (exports[i].mmap != NULL) {
+			tmp_result = doca_mmap_destroy(exports[i].mmap);
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+		}
+		free(exports[i].buffer);
+		if (exports[i].dev != NULL) {
+			tmp_result = doca_dev_close(exports[i].dev);
+			DOCA_ERROR_PROPAGATE(result, tmp_result);
+		}
+	}
+	return result;
+}
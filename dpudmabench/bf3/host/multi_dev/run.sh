@@ -0,0 +1,24 @@
+# /*
+# * Copyright (c) 2025, University of California, Merced. All rights reserved.
+# *
+# * This file is part of the benchmarking software package developed by
+# * the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+# *
+# * For detailed copyright and licensing information, please refer to the license
+# * file LICENSE in the top level directory.
+# *
+# */
+
+
+# Usage: run.sh <buffer size per device in bytes> [device list]
+# The default list exports through both PFs. For SFs list the PF once per SF,
+# e.g. b1:00.0,b1:00.0, and give the SF names on the DPU side.
+len=$1
+devs=${2:-b1:00.0,b1:00.1}
+sed -i "/length =/c\	length = ${len};" multi_dev_host_main.c
+
+make clean
+make
+echo ""
+
+./doca_multi_dev_host -l ${devs} -d /tmp/export_desc.txt -b /tmp/buffer_info.txt
@@ -0,0 +1,22 @@
+# /*
+# * Copyright (c) 2025, University of California, Merced. All rights reserved.
+# *
+# * This file is part of the benchmarking software package developed by
+# * the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+# *
+# * For detailed copyright and licensing information, please refer to the license
+# * file LICENSE in the top level directory.
+# *
+# */
+
+# Usage: run_crossover.sh <result file> ...
+# Result files are the outputs of bf3/dpu/dma_sweep/run.sh and of
+# rdma/rdma_bench -R -a run on the DPU, e.g.
+#   dpu> ../rdma/rdma_bench -d mlx5_0 -o read -t lat -a -s 2097152 -R <host> | tee rdma_read_lat.txt
+#   dpu> ../rdma/rdma_bench -d mlx5_0 -o read -t thr -a -s 2097152 -R <host> | tee rdma_read_thr.txt
+# (and the same for -o write).
+
+make clean && make
+echo ""
+
+./transport_select -o transport_table.txt "$@"
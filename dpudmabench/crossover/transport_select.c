@@ -0,0 +1,390 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+#include <getopt.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "transport_table.h"
+
+#define LINE_SIZE 256		/* Maximum size of an input line */
+#define MAX_SAMPLES 4096	/* Maximum number of (direction, transport, size) points */
+
+/* Measurements of one transport at one size, merged from all RECORD lines */
+struct sample {
+	char direction[TT_NAME_SIZE];	/* pull, push or local */
+	char transport[TT_NAME_SIZE];	/* transport name */
+	size_t size;			/* payload size */
+	double lat_us;			/* average latency, negative if not measured */
+	double gbps;			/* bandwidth, negative if not measured */
+};
+
+static struct sample samples[MAX_SAMPLES];
+static int nb_samples;
+
+/*
+ * Value of a sample for the selection metric
+ *
+ * @s [in]: sample
+ * @metric [in]: selection metric
+ * @return: latency or bandwidth, negative if not measured
+ */
+static double
+sample_value(const struct sample *s, enum transport_metric metric)
+{
+	return metric == TT_LATENCY ? s->lat_us : s->gbps;
+}
+
+/*
+ * Find the sample of a transport at one size
+ *
+ * @direction [in]: direction
+ * @transport [in]: transport name
+ * @size [in]: payload size
+ * @return: sample, NULL if not found
+ */
+static struct sample *
+find_sample(const char *direction, const char *transport, size_t size)
+{
+	int i;
+
+	for (i = 0; i < nb_samples; i++) {
+		if (samples[i].size == size && strcmp(samples[i].direction, direction) == 0 &&
+		    strcmp(samples[i].transport, transport) == 0)
+			return &samples[i];
+	}
+	return NULL;
+}
+
+/*
+ * Parse a "RECORD <direction> <transport> <size> <lat_us> <mops> <gbps>" line, "-" marks a missing value
+ *
+ * @line [in]: input line
+ * @return: 0 on success (or if the line is not a record) and -1 otherwise
+ */
+static int
+parse_record(const char *line)
+{
+	char direction[TT_NAME_SIZE], transport[TT_NAME_SIZE], lat[32], mops[32], gbps[32];
+	unsigned long long size;
+	struct sample *s;
+
+	if (strncmp(line, "RECORD ", 7) != 0)
+		return 0;
+	if (sscanf(line + 7, "%31s %31s %llu %31s %31s %31s", direction, transport, &size, lat, mops, gbps) != 6) {
+		fprintf(stderr, "Malformed record: %s", line);
+		return -1;
+	}
+
+	s = find_sample(direction, transport, size);
+	if (s == NULL) {
+		if (nb_samples == MAX_SAMPLES) {
+			fprintf(stderr, "Too many records, at most %d are supported\n", MAX_SAMPLES);
+			return -1;
+		}
+		s = &samples[nb_samples++];
+		strcpy(s->direction, direction);
+		strcpy(s->transport, transport);
+		s->size = size;
+		s->lat_us = -1;
+		s->gbps = -1;
+	}
+
+	/* Latency and throughput runs of the same transport are merged, the last record wins */
+	if (strcmp(lat, "-") != 0)
+		s->lat_us = strtod(lat, NULL);
+	if (strcmp(gbps, "-") != 0)
+		s->gbps = strtod(gbps, NULL);
+	return 0;
+}
+
+/*
+ * Read all records of a stream
+ *
+ * @fp [in]: input stream
+ * @return: 0 on success and -1 otherwise
+ */
+static int
+read_records(FILE *fp)
+{
+	char line[LINE_SIZE];
+
+	while (fgets(line, sizeof(line), fp) != NULL) {
+		if (parse_record(line) != 0)
+			return -1;
+	}
+	return 0;
+}
+
+/*
+ * qsort comparator on payload size
+ */
+static int
+cmp_size(const void *a, const void *b)
+{
+	size_t x = *(const size_t *)a, y = *(const size_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+/*
+ * Collect the sorted distinct sizes measured for one direction
+ *
+ * @direction [in]: direction
+ * @sizes [out]: sizes, at least MAX_SAMPLES entries
+ * @return: number of sizes
+ */
+static int
+direction_sizes(const char *direction, size_t *sizes)
+{
+	int i, j, n = 0;
+
+	for (i = 0; i < nb_samples; i++) {
+		if (strcmp(samples[i].direction, direction) != 0)
+			continue;
+		for (j = 0; j < n && sizes[j] != samples[i].size; j++)
+			;
+		if (j == n)
+			sizes[n++] = samples[i].size;
+	}
+	qsort(sizes, n, sizeof(*sizes), cmp_size);
+	return n;
+}
+
+/*
+ * Best transport at one size
+ *
+ * @direction [in]: direction
+ * @metric [in]: selection metric
+ * @size [in]: payload size
+ * @return: winning sample, NULL if no transport measured the metric at this size
+ */
+static const struct sample *
+best_sample(const char *direction, enum transport_metric metric, size_t size)
+{
+	const struct sample *best = NULL;
+	double v;
+	int i;
+
+	for (i = 0; i < nb_samples; i++) {
+		if (samples[i].size != size || strcmp(samples[i].direction, direction) != 0)
+			continue;
+		v = sample_value(&samples[i], metric);
+		if (v <= 0)
+			continue;
+		if (best == NULL || (metric == TT_LATENCY ? v < sample_value(best, metric) :
+							    v > sample_value(best, metric)))
+			best = &samples[i];
+	}
+	return best;
+}
+
+/*
+ * Estimate where the curves of two transports cross between two measured sizes
+ *
+ * Both metrics are close to linear in log-log space between neighbouring powers of two, so the difference of the
+ * two log curves is interpolated linearly in log(size) and its zero is taken as the crossover.
+ *
+ * @a [in]: winner at the lower size
+ * @b [in]: winner at the upper size
+ * @metric [in]: selection metric
+ * @lo [in]: lower size
+ * @hi [in]: upper size
+ * @return: first size at which b is expected to win
+ */
+static size_t
+fit_crossover(const struct sample *a, const struct sample *b, enum transport_metric metric, size_t lo, size_t hi)
+{
+	const struct sample *a_hi, *b_lo;
+	double d_lo, d_hi, t, x;
+
+	a_hi = find_sample(a->direction, a->transport, hi);
+	b_lo = find_sample(b->direction, b->transport, lo);
+	if (a_hi == NULL || b_lo == NULL || sample_value(a_hi, metric) <= 0 || sample_value(b_lo, metric) <= 0)
+		return hi;
+
+	d_lo = log(sample_value(a, metric)) - log(sample_value(b_lo, metric));
+	d_hi = log(sample_value(a_hi, metric)) - log(sample_value(b, metric));
+	if (d_lo == d_hi)
+		return hi;
+
+	t = d_lo / (d_lo - d_hi);
+	x = exp(log((double)lo) + t * (log((double)hi) - log((double)lo)));
+	if (x <= lo)
+		return lo + 1;
+	if (x >= hi)
+		return hi;
+	return (size_t)ceil(x);
+}
+
+/*
+ * Build the ranges of one direction and metric and print the per-size winners and the crossovers
+ *
+ * @direction [in]: direction
+ * @metric [in]: selection metric
+ * @table [in]: transport selection table to extend
+ * @return: 0 on success and -1 otherwise
+ */
+static int
+select_transports(const char *direction, enum transport_metric metric, struct transport_table *table)
+{
+	static size_t sizes[MAX_SAMPLES];
+	const struct sample *best, *prev = NULL;
+	struct transport_range range;
+	size_t prev_size = 0, cross;
+	int i, n;
+
+	n = direction_sizes(direction, sizes);
+
+	printf("\n%s %s\n", direction, metric == TT_LATENCY ? "latency" : "throughput");
+	printf("%12s\t %-14s\t %s\n", "Size(B)", "Best", metric == TT_LATENCY ? "Avg Lat(us)" : "Bandwidth(GB/s)");
+
+	memset(&range, 0, sizeof(range));
+	strcpy(range.direction, direction);
+	range.metric = metric;
+
+	for (i = 0; i < n; i++) {
+		best = best_sample(direction, metric, sizes[i]);
+		if (best == NULL)
+			continue;
+		printf("%12zu\t %-14s\t %.3f\n", sizes[i], best->transport, sample_value(best, metric));
+
+		if (prev == NULL) {
+			/* The first measured size also covers every smaller message */
+			range.min_size = 0;
+			strcpy(range.transport, best->transport);
+		} else if (strcmp(prev->transport, best->transport) != 0) {
+			cross = fit_crossover(prev, best, metric, prev_size, sizes[i]);
+			printf("%12s\t crossover %s -> %s at ~%zu bytes\n", "", prev->transport, best->transport, cross);
+			range.max_size = cross - 1;
+			if (transport_table_add(table, &range) != 0)
+				return -1;
+			range.min_size = cross;
+			strcpy(range.transport, best->transport);
+		}
+		prev = best;
+		prev_size = sizes[i];
+	}
+
+	if (prev == NULL)
+		return 0;
+
+	/* The last measured size also covers every larger message */
+	range.max_size = TT_UNBOUNDED;
+	return transport_table_add(table, &range);
+}
+
+/*
+ * Print command line usage
+ *
+ * @prog [in]: program name
+ */
+static void
+usage(const char *prog)
+{
+	printf("Usage: %s [-o table] [file ...]\n", prog);
+	printf("Reads RECORD lines of doca_dma_sweep and rdma_bench -R (stdin without files) and prints the\n");
+	printf("best transport per size, the fitted crossovers and the transport selection table.\n");
+	printf("  -o, --output <path>      also write the selection table to <path>\n");
+}
+
+/*
+ * Crossover finder main function
+ *
+ * @argc [in]: command line arguments size
+ * @argv [in]: array of command line arguments
+ * @return: EXIT_SUCCESS on success and EXIT_FAILURE otherwise
+ */
+int
+main(int argc, char **argv)
+{
+	static const struct option long_opts[] = {
+		{"output", required_argument, NULL, 'o'},
+		{"help", no_argument, NULL, 'h'},
+		{NULL, 0, NULL, 0},
+	};
+	struct transport_table table = {0};
+	const char *output = NULL;
+	int c, i, j, exit_status = EXIT_FAILURE;
+	FILE *fp;
+
+	while ((c = getopt_long(argc, argv, "o:h", long_opts, NULL)) != -1) {
+		switch (c) {
+		case 'o':
+			output = optarg;
+			break;
+		case 'h':
+			usage(argv[0]);
+			return EXIT_SUCCESS;
+		default:
+			usage(argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (optind == argc) {
+		if (read_records(stdin) != 0)
+			return EXIT_FAILURE;
+	}
+	for (i = optind; i < argc; i++) {
+		fp = fopen(argv[i], "r");
+		if (fp == NULL) {
+			perror(argv[i]);
+			return EXIT_FAILURE;
+		}
+		c = read_records(fp);
+		fclose(fp);
+		if (c != 0)
+			return EXIT_FAILURE;
+	}
+
+	if (nb_samples == 0) {
+		fprintf(stderr, "No RECORD lines found\n");
+		return EXIT_FAILURE;
+	}
+
+	/* Every direction in order of first appearance */
+	for (i = 0; i < nb_samples; i++) {
+		for (j = 0; j < i && strcmp(samples[j].direction, samples[i].direction) != 0; j++)
+			;
+		if (j < i)
+			continue;
+		if (select_transports(samples[i].direction, TT_LATENCY, &table) != 0 ||
+		    select_transports(samples[i].direction, TT_THROUGHPUT, &table) != 0)
+			goto destroy_table;
+	}
+
+	printf("\nTransport selection table\n");
+	if (transport_table_save(&table, stdout) != 0)
+		goto destroy_table;
+
+	if (output != NULL) {
+		fp = fopen(output, "w");
+		if (fp == NULL) {
+			perror(output);
+			goto destroy_table;
+		}
+		c = transport_table_save(&table, fp);
+		if (fclose(fp) != 0 || c != 0) {
+			fprintf(stderr, "Failed to write %s\n", output);
+			goto destroy_table;
+		}
+	}
+
+	exit_status = EXIT_SUCCESS;
+
+destroy_table:
+	transport_table_destroy(&table);
+	return exit_status;
+}
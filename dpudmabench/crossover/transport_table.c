@@ -0,0 +1,154 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "transport_table.h"
+
+#define LINE_SIZE 256		/* Maximum size of a table line */
+
+const char *
+transport_metric_name(enum transport_metric metric)
+{
+	return metric == TT_LATENCY ? "lat" : "thr";
+}
+
+int
+transport_table_add(struct transport_table *table, const struct transport_range *range)
+{
+	struct transport_range *ranges;
+	int capacity;
+
+	if (table->nb_ranges == table->capacity) {
+		capacity = table->capacity ? table->capacity * 2 : 16;
+		ranges = realloc(table->ranges, capacity * sizeof(*ranges));
+		if (ranges == NULL) {
+			fprintf(stderr, "Failed to grow the transport table\n");
+			return -1;
+		}
+		table->ranges = ranges;
+		table->capacity = capacity;
+	}
+
+	table->ranges[table->nb_ranges++] = *range;
+	return 0;
+}
+
+int
+transport_table_load(const char *path, struct transport_table *table)
+{
+	struct transport_range range;
+	char line[LINE_SIZE], metric[8], max_size[32];
+	unsigned long long min_size;
+	int lineno = 0;
+	FILE *fp;
+
+	memset(table, 0, sizeof(*table));
+
+	fp = fopen(path, "r");
+	if (fp == NULL) {
+		perror(path);
+		return -1;
+	}
+
+	while (fgets(line, sizeof(line), fp) != NULL) {
+		lineno++;
+		if (line[0] == '#' || line[0] == '\n')
+			continue;
+
+		memset(&range, 0, sizeof(range));
+		if (sscanf(line, "%31s %7s %llu %31s %31s", range.direction, metric, &min_size, max_size,
+			   range.transport) != 5) {
+			fprintf(stderr, "%s:%d: malformed entry\n", path, lineno);
+			goto error;
+		}
+
+		if (strcmp(metric, "lat") == 0)
+			range.metric = TT_LATENCY;
+		else if (strcmp(metric, "thr") == 0)
+			range.metric = TT_THROUGHPUT;
+		else {
+			fprintf(stderr, "%s:%d: unknown metric %s\n", path, lineno, metric);
+			goto error;
+		}
+
+		range.min_size = min_size;
+		range.max_size = strcmp(max_size, "inf") == 0 ? TT_UNBOUNDED : strtoull(max_size, NULL, 0);
+		if (range.max_size < range.min_size) {
+			fprintf(stderr, "%s:%d: empty size range\n", path, lineno);
+			goto error;
+		}
+
+		if (transport_table_add(table, &range) != 0)
+			goto error;
+	}
+
+	fclose(fp);
+	return 0;
+
+error:
+	fclose(fp);
+	transport_table_destroy(table);
+	return -1;
+}
+
+int
+transport_table_save(const struct transport_table *table, FILE *fp)
+{
+	const struct transport_range *range;
+	int i;
+
+	fprintf(fp, "# direction metric min_size max_size transport\n");
+	for (i = 0; i < table->nb_ranges; i++) {
+		range = &table->ranges[i];
+		fprintf(fp, "%s %s %zu ", range->direction, transport_metric_name(range->metric), range->min_size);
+		if (range->max_size == TT_UNBOUNDED)
+			fprintf(fp, "inf");
+		else
+			fprintf(fp, "%zu", range->max_size);
+		fprintf(fp, " %s\n", range->transport);
+	}
+
+	return ferror(fp) ? -1 : 0;
+}
+
+const char *
+transport_table_lookup(const struct transport_table *table, const char *direction, enum transport_metric metric,
+		       size_t size)
+{
+	const struct transport_range *range, *first = NULL, *last = NULL;
+	int i;
+
+	/* Tables hold a handful of ranges per direction, a linear scan is cheaper than anything smarter */
+	for (i = 0; i < table->nb_ranges; i++) {
+		range = &table->ranges[i];
+		if (range->metric != metric || strcmp(range->direction, direction) != 0)
+			continue;
+		if (size >= range->min_size && size <= range->max_size)
+			return range->transport;
+		if (first == NULL || range->min_size < first->min_size)
+			first = range;
+		if (last == NULL || range->max_size > last->max_size)
+			last = range;
+	}
+
+	if (first == NULL)
+		return NULL;
+	return size < first->min_size ? first->transport : last->transport;
+}
+
+void
+transport_table_destroy(struct transport_table *table)
+{
+	free(table->ranges);
+	memset(table, 0, sizeof(*table));
+}
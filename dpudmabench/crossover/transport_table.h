@@ -0,0 +1,103 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+#ifndef TRANSPORT_TABLE_H_
+#define TRANSPORT_TABLE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define TT_NAME_SIZE 32			/* Maximum size of a direction or transport name */
+#define TT_UNBOUNDED SIZE_MAX		/* max_size of the last range, written as "inf" */
+
+/* What the transport was selected for */
+enum transport_metric {
+	TT_LATENCY,		/* lowest average completion latency */
+	TT_THROUGHPUT,		/* highest bandwidth */
+};
+
+/* Sizes [min_size, max_size] of one direction are best served by transport */
+struct transport_range {
+	char direction[TT_NAME_SIZE];	/* pull (DPU reads host), push (DPU writes host) or local */
+	enum transport_metric metric;	/* Selection metric */
+	size_t min_size;		/* First payload size of the range */
+	size_t max_size;		/* Last payload size of the range */
+	char transport[TT_NAME_SIZE];	/* e.g. dma_poll, dma_event, rdma_read, rdma_write, memcpy */
+};
+
+/* Transport selection table, ranges of one direction and metric are sorted and do not overlap */
+struct transport_table {
+	struct transport_range *ranges;	/* Table entries */
+	int nb_ranges;			/* Number of entries */
+	int capacity;			/* Allocated entries */
+};
+
+/*
+ * Return the printable name of a selection metric
+ *
+ * @metric [in]: selection metric
+ * @return: "lat" or "thr"
+ */
+const char *transport_metric_name(enum transport_metric metric);
+
+/*
+ * Append a range to the table
+ *
+ * @table [in]: transport selection table
+ * @range [in]: range to append
+ * @return: 0 on success and -1 otherwise
+ */
+int transport_table_add(struct transport_table *table, const struct transport_range *range);
+
+/*
+ * Load a table written by transport_table_save()
+ *
+ * Every line is "<direction> <lat|thr> <min_size> <max_size|inf> <transport>", lines starting with '#' are
+ * comments.
+ *
+ * @path [in]: table file
+ * @table [out]: transport selection table
+ * @return: 0 on success and -1 otherwise
+ */
+int transport_table_load(const char *path, struct transport_table *table);
+
+/*
+ * Write the table in the format read by transport_table_load()
+ *
+ * @table [in]: transport selection table
+ * @fp [in]: output stream
+ * @return: 0 on success and -1 otherwise
+ */
+int transport_table_save(const struct transport_table *table, FILE *fp);
+
+/*
+ * Pick the transport for one message
+ *
+ * Sizes outside of the measured sweep use the closest range.
+ *
+ * @table [in]: transport selection table
+ * @direction [in]: pull, push or local
+ * @metric [in]: optimize for latency or throughput
+ * @size [in]: payload size
+ * @return: transport name, NULL if the table has no entry for direction and metric
+ */
+const char *transport_table_lookup(const struct transport_table *table, const char *direction,
+				   enum transport_metric metric, size_t size);
+
+/*
+ * Free the table entries
+ *
+ * @table [in]: transport selection table
+ */
+void transport_table_destroy(struct transport_table *table);
+
+#endif
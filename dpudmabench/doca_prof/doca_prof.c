@@ -0,0 +1,643 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+#define _GNU_SOURCE
+#include <dlfcn.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <doca_buf.h>
+#include <doca_ctx.h>
+#include <doca_dma.h>
+#include <doca_error.h>
+#include <doca_mmap.h>
+#include <doca_pe.h>
+
+/*
+ * LD_PRELOAD profiler for the DOCA DMA usage of unmodified applications
+ *
+ * Wraps doca_task_submit(), doca_pe_progress(), the memcpy completion callbacks and the doca_mmap_* calls, forwarding
+ * each to the next definition found by dlsym(RTLD_NEXT). It records per-call latency histograms, the payload size
+ * distribution, the number of tasks in flight over time and empty vs useful progress calls, and writes everything
+ * as JSON when the process exits.
+ *
+ * Environment:
+ *	DOCA_PROF_OUTPUT	JSON output path (default: doca_prof.<pid>.json)
+ *	DOCA_PROF_INTERVAL_MS	queue depth sampling interval (default: 10)
+ */
+
+#define PROF_SUB_BITS 2				/* Histogram buckets per power of two are 1 << PROF_SUB_BITS */
+#define PROF_BUCKETS (64 << PROF_SUB_BITS)	/* Histogram buckets covering all of uint64_t */
+#define PROF_TASK_SLOTS (1 << 16)		/* Task table size, a power of two */
+#define PROF_MAX_DMA 64				/* DMA contexts with their own callbacks */
+#define PROF_SERIES (1 << 16)			/* Queue depth intervals kept */
+#define PROF_TOMBSTONE ((struct doca_task *)1)	/* Task table key of a freed task */
+
+/* Log-linear histogram, updated with relaxed atomics from any thread */
+struct prof_hist {
+	uint64_t count;			/* Values */
+	uint64_t sum;			/* Sum of the values */
+	uint64_t min;			/* Smallest value */
+	uint64_t max;			/* Largest value */
+	uint64_t buckets[PROF_BUCKETS];	/* Values per bucket, see prof_bucket() */
+};
+
+/* Timed events, one histogram each */
+enum prof_event {
+	PROF_TASK_SUBMIT,
+	PROF_PE_PROGRESS_EMPTY,
+	PROF_PE_PROGRESS_USEFUL,
+	PROF_TASK_LATENCY,
+	PROF_COMPLETION_CB,
+	PROF_ERROR_CB,
+	PROF_MMAP_CREATE,
+	PROF_MMAP_DESTROY,
+	PROF_MMAP_START,
+	PROF_MMAP_STOP,
+	PROF_MMAP_ADD_DEV,
+	PROF_MMAP_SET_MEMRANGE,
+	PROF_MMAP_SET_PERMISSIONS,
+	PROF_MMAP_EXPORT_PCI,
+	PROF_MMAP_CREATE_FROM_EXPORT,
+	PROF_NUM_EVENTS,
+};
+
+static const char *const prof_event_names[PROF_NUM_EVENTS] = {
+	"doca_task_submit",
+	"doca_pe_progress_empty",
+	"doca_pe_progress_useful",
+	"task_latency",
+	"completion_cb",
+	"error_cb",
+	"doca_mmap_create",
+	"doca_mmap_destroy",
+	"doca_mmap_start",
+	"doca_mmap_stop",
+	"doca_mmap_add_dev",
+	"doca_mmap_set_memrange",
+	"doca_mmap_set_permissions",
+	"doca_mmap_export_pci",
+	"doca_mmap_create_from_export",
+};
+
+/* Callbacks the application gave to doca_dma_task_memcpy_set_conf() */
+struct prof_callbacks {
+	struct doca_dma *dma;					/* DMA context */
+	doca_dma_task_memcpy_completion_cb_t completion_cb;	/* Application success callback */
+	doca_dma_task_memcpy_completion_cb_t error_cb;		/* Application error callback */
+};
+
+/* Memcpy task known to the profiler */
+struct prof_task {
+	struct doca_task *task;				/* Key, NULL if the slot was never used */
+	struct doca_dma_task_memcpy *memcpy_task;	/* Task as returned by the allocation */
+	int callbacks;					/* Index into prof.callbacks */
+	uint64_t submit_ns;				/* Last submission time */
+};
+
+/* Profiler state */
+static struct {
+	uint64_t start_ns;					/* Process start */
+	uint64_t interval_ns;					/* Queue depth sampling interval */
+	struct prof_hist events[PROF_NUM_EVENTS];		/* Latency per event in nanoseconds */
+	struct prof_hist payload;				/* Payload size in bytes of submitted tasks */
+	struct prof_hist depth;					/* Tasks in flight seen by each submission */
+	uint64_t errors[PROF_NUM_EVENTS];			/* Calls that returned an error */
+	uint64_t untracked;					/* Tasks allocated before the profiler knew */
+	int64_t in_flight;					/* Submitted and not completed tasks */
+	uint32_t depth_series[PROF_SERIES];			/* Highest depth per interval */
+	uint64_t last_interval;					/* Last interval with a depth sample */
+	struct prof_callbacks callbacks[PROF_MAX_DMA];		/* Application callbacks per DMA context */
+	int nb_callbacks;					/* Used entries of callbacks */
+	struct prof_task tasks[PROF_TASK_SLOTS];		/* Task table, open addressing */
+} prof;
+
+/* Next definitions of the wrapped calls */
+static __typeof__(doca_task_submit) *real_task_submit;
+static __typeof__(doca_pe_progress) *real_pe_progress;
+static __typeof__(doca_task_free) *real_task_free;
+static __typeof__(doca_dma_task_memcpy_set_conf) *real_memcpy_set_conf;
+static __typeof__(doca_dma_task_memcpy_alloc_init) *real_memcpy_alloc_init;
+static __typeof__(doca_mmap_create) *real_mmap_create;
+static __typeof__(doca_mmap_destroy) *real_mmap_destroy;
+static __typeof__(doca_mmap_start) *real_mmap_start;
+static __typeof__(doca_mmap_stop) *real_mmap_stop;
+static __typeof__(doca_mmap_add_dev) *real_mmap_add_dev;
+static __typeof__(doca_mmap_set_memrange) *real_mmap_set_memrange;
+static __typeof__(doca_mmap_set_permissions) *real_mmap_set_permissions;
+static __typeof__(doca_mmap_export_pci) *real_mmap_export_pci;
+static __typeof__(doca_mmap_create_from_export) *real_mmap_create_from_export;
+
+/*
+ * Monotonic time
+ *
+ * @return: current time in nanoseconds
+ */
+static inline uint64_t
+prof_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/*
+ * Histogram bucket of a value: exact below 1 << PROF_SUB_BITS, then 1 << PROF_SUB_BITS buckets per power of two
+ *
+ * @v [in]: value
+ * @return: bucket index
+ */
+static inline int
+prof_bucket(uint64_t v)
+{
+	int lg;
+
+	if (v < (1U << PROF_SUB_BITS))
+		return (int)v;
+	lg = 63 - __builtin_clzll(v);
+	return (lg << PROF_SUB_BITS) + (int)((v >> (lg - PROF_SUB_BITS)) & ((1U << PROF_SUB_BITS) - 1));
+}
+
+/*
+ * Smallest value of a bucket
+ *
+ * @b [in]: bucket index
+ * @return: lower bound
+ */
+static uint64_t
+prof_bucket_low(int b)
+{
+	int lg = b >> PROF_SUB_BITS;
+
+	if (b < (1 << PROF_SUB_BITS))
+		return b;
+	return (uint64_t)((1 << PROF_SUB_BITS) + (b & ((1 << PROF_SUB_BITS) - 1))) << (lg - PROF_SUB_BITS);
+}
+
+/*
+ * Largest value of a bucket
+ *
+ * @b [in]: bucket index
+ * @return: upper bound, inclusive
+ */
+static uint64_t
+prof_bucket_high(int b)
+{
+	if (b < (1 << PROF_SUB_BITS))
+		return b;
+	return prof_bucket_low(b) + (1ULL << ((b >> PROF_SUB_BITS) - PROF_SUB_BITS)) - 1;
+}
+
+/*
+ * Add a value to a histogram
+ *
+ * @h [in]: histogram
+ * @v [in]: value
+ */
+static inline void
+prof_hist_add(struct prof_hist *h, uint64_t v)
+{
+	uint64_t cur;
+
+	/* min starts at 0 in the zeroed state, the first value sets it */
+	if (__atomic_fetch_add(&h->count, 1, __ATOMIC_RELAXED) == 0)
+		__atomic_store_n(&h->min, v, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&h->sum, v, __ATOMIC_RELAXED);
+	__atomic_fetch_add(&h->buckets[prof_bucket(v)], 1, __ATOMIC_RELAXED);
+	cur = __atomic_load_n(&h->min, __ATOMIC_RELAXED);
+	while (v < cur && !__atomic_compare_exchange_n(&h->min, &cur, v, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+		;
+	cur = __atomic_load_n(&h->max, __ATOMIC_RELAXED);
+	while (v > cur && !__atomic_compare_exchange_n(&h->max, &cur, v, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+		;
+}
+
+/*
+ * Record the tasks in flight after a submission or completion
+ *
+ * @delta [in]: +1 for a submission and -1 for a completion
+ * @return: tasks in flight after the change
+ */
+static inline int64_t
+prof_depth_update(int64_t delta)
+{
+	int64_t depth = __atomic_add_fetch(&prof.in_flight, delta, __ATOMIC_RELAXED);
+	uint64_t slot = (prof_now() - prof.start_ns) / prof.interval_ns;
+	uint32_t cur, d = depth < 0 ? 0 : (uint32_t)depth;
+	uint32_t *max;
+
+	if (slot >= PROF_SERIES)
+		return depth;
+	max = &prof.depth_series[slot];
+	cur = __atomic_load_n(max, __ATOMIC_RELAXED);
+	while (d > cur && !__atomic_compare_exchange_n(max, &cur, d, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+		;
+	if (slot > __atomic_load_n(&prof.last_interval, __ATOMIC_RELAXED))
+		__atomic_store_n(&prof.last_interval, slot, __ATOMIC_RELAXED);
+	return depth;
+}
+
+/*
+ * Task table slot of a task
+ *
+ * @task [in]: task
+ * @insert [in]: claim a free slot if the task is not in the table
+ * @return: table entry, NULL if not found or the table is full
+ */
+static struct prof_task *
+prof_task_slot(struct doca_task *task, bool insert)
+{
+	uint32_t i = (uint32_t)(((uintptr_t)task >> 4) * 0x9E3779B97F4A7C15ULL >> 32) & (PROF_TASK_SLOTS - 1);
+	struct doca_task *key, *expected;
+	int probe;
+
+	for (probe = 0; probe < PROF_TASK_SLOTS; probe++, i = (i + 1) & (PROF_TASK_SLOTS - 1)) {
+		key = __atomic_load_n(&prof.tasks[i].task, __ATOMIC_ACQUIRE);
+		if (key == task)
+			return &prof.tasks[i];
+		if (key == NULL || (insert && key == PROF_TOMBSTONE)) {
+			if (!insert)
+				return NULL;
+			expected = key;
+			if (__atomic_compare_exchange_n(&prof.tasks[i].task, &expected, task, false, __ATOMIC_ACQ_REL,
+							__ATOMIC_ACQUIRE))
+				return &prof.tasks[i];
+			if (expected == task)
+				return &prof.tasks[i];
+		}
+	}
+	return NULL;
+}
+
+/*
+ * Application callbacks of a completed task
+ *
+ * @task [in]: completed memcpy task
+ * @entry [out]: task table entry, NULL if the task is unknown
+ * @return: callbacks registered for the DMA context of the task
+ */
+static const struct prof_callbacks *
+prof_task_callbacks(struct doca_dma_task_memcpy *task, struct prof_task **entry)
+{
+	*entry = prof_task_slot(doca_dma_task_memcpy_as_task(task), false);
+	/* Without an entry the task is assumed to belong to the first DMA context */
+	return &prof.callbacks[*entry != NULL ? (*entry)->callbacks : 0];
+}
+
+/*
+ * Completion callback registered in place of the application one
+ *
+ * @task [in]: completed task
+ * @task_user_data [in]: task user data
+ * @ctx_user_data [in]: context user data
+ */
+static void
+prof_completion_cb(struct doca_dma_task_memcpy *task, union doca_data task_user_data, union doca_data ctx_user_data)
+{
+	struct prof_task *entry;
+	const struct prof_callbacks *cbs = prof_task_callbacks(task, &entry);
+	uint64_t t0 = prof_now();
+
+	if (entry != NULL && entry->submit_ns != 0)
+		prof_hist_add(&prof.events[PROF_TASK_LATENCY], t0 - entry->submit_ns);
+	prof_depth_update(-1);
+	cbs->completion_cb(task, task_user_data, ctx_user_data);
+	prof_hist_add(&prof.events[PROF_COMPLETION_CB], prof_now() - t0);
+}
+
+/*
+ * Error callback registered in place of the application one
+ *
+ * @task [in]: failed task
+ * @task_user_data [in]: task user data
+ * @ctx_user_data [in]: context user data
+ */
+static void
+prof_error_cb(struct doca_dma_task_memcpy *task, union doca_data task_user_data, union doca_data ctx_user_data)
+{
+	struct prof_task *entry;
+	const struct prof_callbacks *cbs = prof_task_callbacks(task, &entry);
+	uint64_t t0 = prof_now();
+
+	prof_depth_update(-1);
+	cbs->error_cb(task, task_user_data, ctx_user_data);
+	prof_hist_add(&prof.events[PROF_ERROR_CB], prof_now() - t0);
+}
+
+doca_error_t
+doca_dma_task_memcpy_set_conf(struct doca_dma *dma, doca_dma_task_memcpy_completion_cb_t task_completion_cb,
+			      doca_dma_task_memcpy_completion_cb_t task_error_cb, uint32_t num_memcpy_tasks)
+{
+	int i;
+
+	for (i = 0; i < prof.nb_callbacks && prof.callbacks[i].dma != dma; i++)
+		;
+	if (i == PROF_MAX_DMA) {
+		fprintf(stderr, "doca_prof: more than %d DMA contexts, callbacks of the new one are not profiled\n",
+			PROF_MAX_DMA);
+		return real_memcpy_set_conf(dma, task_completion_cb, task_error_cb, num_memcpy_tasks);
+	}
+	prof.callbacks[i].dma = dma;
+	prof.callbacks[i].completion_cb = task_completion_cb;
+	prof.callbacks[i].error_cb = task_error_cb;
+	if (i == prof.nb_callbacks)
+		__atomic_store_n(&prof.nb_callbacks, i + 1, __ATOMIC_RELEASE);
+	return real_memcpy_set_conf(dma, prof_completion_cb, prof_error_cb, num_memcpy_tasks);
+}
+
+doca_error_t
+doca_dma_task_memcpy_alloc_init(struct doca_dma *dma, const struct doca_buf *src, struct doca_buf *dst,
+				union doca_data user_data, struct doca_dma_task_memcpy **task)
+{
+	doca_error_t result = real_memcpy_alloc_init(dma, src, dst, user_data, task);
+	struct prof_task *entry;
+	int i;
+
+	if (result != DOCA_SUCCESS)
+		return result;
+	entry = prof_task_slot(doca_dma_task_memcpy_as_task(*task), true);
+	if (entry == NULL)
+		return result;
+	for (i = 0; i < prof.nb_callbacks && prof.callbacks[i].dma != dma; i++)
+		;
+	entry->memcpy_task = *task;
+	entry->callbacks = i < prof.nb_callbacks ? i : 0;
+	entry->submit_ns = 0;
+	return result;
+}
+
+void
+doca_task_free(struct doca_task *task)
+{
+	struct prof_task *entry = prof_task_slot(task, false);
+
+	if (entry != NULL)
+		__atomic_store_n(&entry->task, PROF_TOMBSTONE, __ATOMIC_RELEASE);
+	real_task_free(task);
+}
+
+doca_error_t
+doca_task_submit(struct doca_task *task)
+{
+	struct prof_task *entry = prof_task_slot(task, false);
+	doca_error_t result;
+	size_t len;
+	uint64_t t0;
+
+	if (entry != NULL) {
+		if (doca_buf_get_data_len(doca_dma_task_memcpy_get_src(entry->memcpy_task), &len) == DOCA_SUCCESS)
+			prof_hist_add(&prof.payload, len);
+	} else {
+		__atomic_fetch_add(&prof.untracked, 1, __ATOMIC_RELAXED);
+	}
+
+	t0 = prof_now();
+	if (entry != NULL)
+		entry->submit_ns = t0;
+	result = real_task_submit(task);
+	prof_hist_add(&prof.events[PROF_TASK_SUBMIT], prof_now() - t0);
+	if (result != DOCA_SUCCESS) {
+		__atomic_fetch_add(&prof.errors[PROF_TASK_SUBMIT], 1, __ATOMIC_RELAXED);
+		return result;
+	}
+	prof_hist_add(&prof.depth, prof_depth_update(1));
+	return result;
+}
+
+uint8_t
+doca_pe_progress(struct doca_pe *pe)
+{
+	uint64_t t0 = prof_now();
+	uint8_t progressed = real_pe_progress(pe);
+
+	prof_hist_add(&prof.events[progressed ? PROF_PE_PROGRESS_USEFUL : PROF_PE_PROGRESS_EMPTY], prof_now() - t0);
+	return progressed;
+}
+
+/* Time a wrapped call that returns doca_error_t and count its failures */
+#define PROF_TIMED(event, call) \
+	do { \
+		uint64_t t0 = prof_now(); \
+		doca_error_t r = (call); \
+		prof_hist_add(&prof.events[event], prof_now() - t0); \
+		if (r != DOCA_SUCCESS) \
+			__atomic_fetch_add(&prof.errors[event], 1, __ATOMIC_RELAXED); \
+		return r; \
+	} while (0)
+
+doca_error_t
+doca_mmap_create(struct doca_mmap **mmap)
+{
+	PROF_TIMED(PROF_MMAP_CREATE, real_mmap_create(mmap));
+}
+
+doca_error_t
+doca_mmap_destroy(struct doca_mmap *mmap)
+{
+	PROF_TIMED(PROF_MMAP_DESTROY, real_mmap_destroy(mmap));
+}
+
+doca_error_t
+doca_mmap_start(struct doca_mmap *mmap)
+{
+	PROF_TIMED(PROF_MMAP_START, real_mmap_start(mmap));
+}
+
+doca_error_t
+doca_mmap_stop(struct doca_mmap *mmap)
+{
+	PROF_TIMED(PROF_MMAP_STOP, real_mmap_stop(mmap));
+}
+
+doca_error_t
+doca_mmap_add_dev(struct doca_mmap *mmap, struct doca_dev *dev)
+{
+	PROF_TIMED(PROF_MMAP_ADD_DEV, real_mmap_add_dev(mmap, dev));
+}
+
+doca_error_t
+doca_mmap_set_memrange(struct doca_mmap *mmap, void *addr, size_t len)
+{
+	PROF_TIMED(PROF_MMAP_SET_MEMRANGE, real_mmap_set_memrange(mmap, addr, len));
+}
+
+doca_error_t
+doca_mmap_set_permissions(struct doca_mmap *mmap, uint32_t access_mask)
+{
+	PROF_TIMED(PROF_MMAP_SET_PERMISSIONS, real_mmap_set_permissions(mmap, access_mask));
+}
+
+doca_error_t
+doca_mmap_export_pci(struct doca_mmap *mmap, const struct doca_dev *dev, const void **export_desc,
+		     size_t *export_desc_len)
+{
+	PROF_TIMED(PROF_MMAP_EXPORT_PCI, real_mmap_export_pci(mmap, dev, export_desc, export_desc_len));
+}
+
+doca_error_t
+doca_mmap_create_from_export(const union doca_data *user_data, const void *export_desc, size_t export_desc_len,
+			     struct doca_dev *dev, struct doca_mmap **mmap)
+{
+	PROF_TIMED(PROF_MMAP_CREATE_FROM_EXPORT,
+		   real_mmap_create_from_export(user_data, export_desc, export_desc_len, dev, mmap));
+}
+
+/*
+ * Value below which a fraction of a histogram lies, with the resolution of its buckets
+ *
+ * @h [in]: histogram
+ * @q [in]: fraction between 0 and 1
+ * @return: upper bound of the bucket holding the quantile, at most the largest value
+ */
+static uint64_t
+prof_hist_quantile(const struct prof_hist *h, double q)
+{
+	uint64_t target = (uint64_t)(q * h->count + 0.999999), seen = 0, high;
+	int b;
+
+	if (target == 0)
+		target = 1;
+	for (b = 0; b < PROF_BUCKETS; b++) {
+		seen += h->buckets[b];
+		if (seen >= target) {
+			high = prof_bucket_high(b);
+			return high < h->max ? high : h->max;
+		}
+	}
+	return h->max;
+}
+
+/*
+ * Write a histogram as a JSON object
+ *
+ * @out [in]: output file
+ * @h [in]: histogram
+ */
+static void
+prof_write_hist(FILE *out, const struct prof_hist *h)
+{
+	const char *sep = "";
+	int b;
+
+	fprintf(out, "{\"count\": %lu, \"sum\": %lu, \"mean\": %.1f, \"min\": %lu, \"max\": %lu", h->count, h->sum,
+		h->count ? (double)h->sum / h->count : 0.0, h->min, h->max);
+	fprintf(out, ", \"p50\": %lu, \"p90\": %lu, \"p99\": %lu, \"p999\": %lu, \"buckets\": [",
+		prof_hist_quantile(h, 0.5), prof_hist_quantile(h, 0.9), prof_hist_quantile(h, 0.99),
+		prof_hist_quantile(h, 0.999));
+	for (b = 0; b < PROF_BUCKETS; b++) {
+		if (h->buckets[b] == 0)
+			continue;
+		fprintf(out, "%s[%lu, %lu, %lu]", sep, prof_bucket_low(b), prof_bucket_high(b), h->buckets[b]);
+		sep = ", ";
+	}
+	fprintf(out, "]}");
+}
+
+/*
+ * Write the whole profile as JSON
+ *
+ * @out [in]: output file
+ * @duration_ns [in]: time since the profiler was loaded
+ */
+static void
+prof_write_json(FILE *out, uint64_t duration_ns)
+{
+	uint64_t empty = prof.events[PROF_PE_PROGRESS_EMPTY].count, useful = prof.events[PROF_PE_PROGRESS_USEFUL].count;
+	uint64_t last = prof.last_interval, i;
+	int e;
+
+	fprintf(out, "{\n  \"pid\": %d,\n  \"duration_s\": %.6f,\n  \"calls\": {\n", getpid(), duration_ns / 1e9);
+	for (e = 0; e < PROF_NUM_EVENTS; e++) {
+		fprintf(out, "    \"%s\": {\"errors\": %lu, \"ns\": ", prof_event_names[e], prof.errors[e]);
+		prof_write_hist(out, &prof.events[e]);
+		fprintf(out, "}%s\n", e + 1 < PROF_NUM_EVENTS ? "," : "");
+	}
+	fprintf(out, "  },\n  \"payload_bytes\": ");
+	prof_write_hist(out, &prof.payload);
+	fprintf(out, ",\n  \"untracked_submits\": %lu,\n", prof.untracked);
+	fprintf(out, "  \"progress\": {\"empty\": %lu, \"useful\": %lu, \"useful_ratio\": %.4f},\n", empty, useful,
+		empty + useful ? (double)useful / (empty + useful) : 0.0);
+	fprintf(out, "  \"queue_depth\": {\"at_submit\": ");
+	prof_write_hist(out, &prof.depth);
+	fprintf(out, ",\n    \"interval_ms\": %.3f, \"truncated\": %s, \"max_per_interval\": [", prof.interval_ns / 1e6,
+		duration_ns / prof.interval_ns >= PROF_SERIES ? "true" : "false");
+	for (i = 0; i <= last && prof.depth.count > 0; i++)
+		fprintf(out, "%s%u", i ? ", " : "", prof.depth_series[i]);
+	fprintf(out, "]}\n}\n");
+}
+
+/*
+ * Resolve the wrapped calls and read the configuration, runs when the library is loaded
+ */
+__attribute__((constructor)) static void
+prof_init(void)
+{
+	const char *interval = getenv("DOCA_PROF_INTERVAL_MS");
+
+	prof.start_ns = prof_now();
+	prof.interval_ns = (interval != NULL && atof(interval) > 0 ? atof(interval) : 10) * 1e6;
+
+	real_task_submit = dlsym(RTLD_NEXT, "doca_task_submit");
+	real_pe_progress = dlsym(RTLD_NEXT, "doca_pe_progress");
+	real_task_free = dlsym(RTLD_NEXT, "doca_task_free");
+	real_memcpy_set_conf = dlsym(RTLD_NEXT, "doca_dma_task_memcpy_set_conf");
+	real_memcpy_alloc_init = dlsym(RTLD_NEXT, "doca_dma_task_memcpy_alloc_init");
+	real_mmap_create = dlsym(RTLD_NEXT, "doca_mmap_create");
+	real_mmap_destroy = dlsym(RTLD_NEXT, "doca_mmap_destroy");
+	real_mmap_start = dlsym(RTLD_NEXT, "doca_mmap_start");
+	real_mmap_stop = dlsym(RTLD_NEXT, "doca_mmap_stop");
+	real_mmap_add_dev = dlsym(RTLD_NEXT, "doca_mmap_add_dev");
+	real_mmap_set_memrange = dlsym(RTLD_NEXT, "doca_mmap_set_memrange");
+	real_mmap_set_permissions = dlsym(RTLD_NEXT, "doca_mmap_set_permissions");
+	real_mmap_export_pci = dlsym(RTLD_NEXT, "doca_mmap_export_pci");
+	real_mmap_create_from_export = dlsym(RTLD_NEXT, "doca_mmap_create_from_export");
+}
+
+/*
+ * Write the profile and a one line summary, runs when the process exits
+ */
+__attribute__((destructor)) static void
+prof_fini(void)
+{
+	const char *path = getenv("DOCA_PROF_OUTPUT");
+	const struct prof_hist *latency = &prof.events[PROF_TASK_LATENCY];
+	uint64_t useful = prof.events[PROF_PE_PROGRESS_USEFUL].count;
+	uint64_t polls = useful + prof.events[PROF_PE_PROGRESS_EMPTY].count;
+	char default_path[64];
+	FILE *out;
+
+	/* Processes that never touched DOCA, e.g. the shell of a wrapper script, leave no file behind */
+	if (real_task_submit == NULL && real_mmap_create == NULL)
+		return;
+
+	if (path == NULL || path[0] == '\0') {
+		snprintf(default_path, sizeof(default_path), "doca_prof.%d.json", getpid());
+		path = default_path;
+	}
+	out = fopen(path, "w");
+	if (out == NULL) {
+		perror("doca_prof: failed to open the output file");
+		return;
+	}
+	prof_write_json(out, prof_now() - prof.start_ns);
+	fclose(out);
+
+	fprintf(stderr, "doca_prof: %lu tasks, %lu bytes, latency p50 %lu ns p99 %lu ns, %.1f%% useful polls -> %s\n",
+		latency->count, prof.payload.sum, prof_hist_quantile(latency, 0.5), prof_hist_quantile(latency, 0.99),
+		polls ? 100.0 * useful / polls : 0.0, path);
+}
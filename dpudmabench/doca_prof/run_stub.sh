@@ -0,0 +1,22 @@
+# /*
+# * Copyright (c) 2025, University of California, Merced. All rights reserved.
+# *
+# * This file is part of the benchmarking software package developed by
+# * the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+# *
+# * For detailed copyright and licensing information, please refer to the license
+# * file LICENSE in the top level directory.
+# *
+# */
+
+
+# Check the profiler on a plain Linux box against the stub DOCA library.
+# Usage: run_stub.sh [copies] [tasks in flight]
+ops=${1:-200000}
+depth=${2:-32}
+
+make clean && make stub
+echo ""
+
+DOCA_PROF_OUTPUT=doca_prof.stub.json LD_PRELOAD=$(pwd)/libdoca_prof.so stub/dma_app ${ops} ${depth}
+python3 -m json.tool doca_prof.stub.json > /dev/null && echo "doca_prof.stub.json is valid JSON"
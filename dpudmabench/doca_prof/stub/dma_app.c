@@ -0,0 +1,224 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <doca_buf.h>
+#include <doca_buf_inventory.h>
+#include <doca_ctx.h>
+#include <doca_dev.h>
+#include <doca_dma.h>
+#include <doca_error.h>
+#include <doca_mmap.h>
+#include <doca_pe.h>
+
+/*
+ * Small DOCA DMA application with no knowledge of doca_prof, used to check the profiler against the stub library
+ *
+ * Copies random sizes between 64 B and 64 KB from a source region into an exported destination region, keeping up to
+ * DEPTH tasks in flight and resubmitting from the completion callback, and verifies the copied data.
+ */
+
+#define DEPTH 32			/* Largest number of tasks in flight */
+#define SLOT_SIZE (64 * 1024)		/* Largest copy */
+#define DEFAULT_OPS 200000		/* Copies when no count is given */
+
+struct app_state {
+	struct doca_buf_inventory *inv;	/* Buffer inventory */
+	struct doca_mmap *src_mmap;	/* Source region */
+	struct doca_mmap *dst_mmap;	/* Destination region, created from an export */
+	char *src;			/* Source memory */
+	char *dst;			/* Destination memory */
+	long submitted;			/* Submitted copies */
+	long completed;			/* Completed copies */
+	long ops;			/* Copies to run */
+	int errors;			/* Failed copies */
+};
+
+/*
+ * Point a task at a new random slice of the source and submit it
+ *
+ * @st [in]: application state
+ * @task [in]: idle memcpy task
+ * @slot [in]: slot of the task, selects its source and destination range
+ * @return: DOCA_SUCCESS on success and DOCA_ERROR otherwise
+ */
+static doca_error_t
+submit_copy(struct app_state *st, struct doca_dma_task_memcpy *task, long slot)
+{
+	struct doca_buf *src = (struct doca_buf *)doca_dma_task_memcpy_get_src(task);
+	struct doca_buf *dst = doca_dma_task_memcpy_get_dst(task);
+	size_t len = 64 + (size_t)rand() % (SLOT_SIZE - 64 + 1);
+	doca_error_t result;
+
+	result = doca_buf_set_data(src, st->src + slot * SLOT_SIZE, len);
+	if (result != DOCA_SUCCESS)
+		return result;
+	doca_buf_reset_data_len(dst);
+	result = doca_task_submit(doca_dma_task_memcpy_as_task(task));
+	if (result == DOCA_SUCCESS)
+		st->submitted++;
+	return result;
+}
+
+/*
+ * Memcpy completion callback: verify the copy and resubmit the task
+ *
+ * @task [in]: completed task
+ * @task_user_data [in]: slot of the task
+ * @ctx_user_data [in]: application state
+ */
+static void
+copy_completed_cb(struct doca_dma_task_memcpy *task, union doca_data task_user_data, union doca_data ctx_user_data)
+{
+	struct app_state *st = ctx_user_data.ptr;
+	long slot = (long)task_user_data.u64;
+	size_t len;
+
+	doca_buf_get_data_len(doca_dma_task_memcpy_get_dst(task), &len);
+	if (memcmp(st->src + slot * SLOT_SIZE, st->dst + slot * SLOT_SIZE, len) != 0)
+		st->errors++;
+	st->completed++;
+	if (st->submitted < st->ops && submit_copy(st, task, slot) != DOCA_SUCCESS)
+		st->errors++;
+}
+
+/*
+ * Memcpy error callback
+ *
+ * @task [in]: failed task
+ * @task_user_data [in]: slot of the task
+ * @ctx_user_data [in]: application state
+ */
+static void
+copy_error_cb(struct doca_dma_task_memcpy *task, union doca_data task_user_data, union doca_data ctx_user_data)
+{
+	struct app_state *st = ctx_user_data.ptr;
+
+	(void)task_user_data;
+	fprintf(stderr, "Copy failed: %s\n",
+		doca_error_get_descr(doca_task_get_status(doca_dma_task_memcpy_as_task(task))));
+	st->completed++;
+	st->errors++;
+}
+
+/*
+ * Application main function
+ *
+ * @argc [in]: command line arguments size
+ * @argv [in]: array of command line arguments, optionally the number of copies and the tasks in flight
+ * @return: EXIT_SUCCESS on success and EXIT_FAILURE otherwise
+ */
+int
+main(int argc, char **argv)
+{
+	struct app_state st = {.ops = argc > 1 ? atol(argv[1]) : DEFAULT_OPS};
+	struct doca_dma_task_memcpy *tasks[DEPTH];
+	struct doca_devinfo **dev_list;
+	struct doca_dev *dev;
+	struct doca_dma *dma;
+	struct doca_pe *pe;
+	struct doca_buf *src_buf, *dst_buf;
+	struct doca_mmap *remote_mmap;
+	union doca_data data;
+	const void *export_desc;
+	size_t export_len, region = (size_t)DEPTH * SLOT_SIZE;
+	int depth = argc > 2 ? atoi(argv[2]) : DEPTH;
+	uint32_t nb_devs;
+	long i;
+
+	if (st.ops < 1 || depth < 1 || depth > DEPTH) {
+		fprintf(stderr, "Usage: %s [copies] [tasks in flight, 1..%d]\n", argv[0], DEPTH);
+		return EXIT_FAILURE;
+	}
+
+	st.src = malloc(region);
+	st.dst = calloc(1, region);
+	if (st.src == NULL || st.dst == NULL)
+		return EXIT_FAILURE;
+	for (i = 0; i < (long)region; i++)
+		st.src[i] = (char)rand();
+
+	if (doca_devinfo_create_list(&dev_list, &nb_devs) != DOCA_SUCCESS || nb_devs == 0 ||
+	    doca_dev_open(dev_list[0], &dev) != DOCA_SUCCESS) {
+		fprintf(stderr, "No DOCA device\n");
+		return EXIT_FAILURE;
+	}
+	doca_devinfo_destroy_list(dev_list);
+
+	/* Source region, and a destination region exported and imported the way the host/DPU samples do it */
+	if (doca_mmap_create(&st.src_mmap) != DOCA_SUCCESS || doca_mmap_add_dev(st.src_mmap, dev) != DOCA_SUCCESS ||
+	    doca_mmap_set_memrange(st.src_mmap, st.src, region) != DOCA_SUCCESS ||
+	    doca_mmap_set_permissions(st.src_mmap, DOCA_ACCESS_FLAG_LOCAL_READ_WRITE) != DOCA_SUCCESS ||
+	    doca_mmap_start(st.src_mmap) != DOCA_SUCCESS)
+		return EXIT_FAILURE;
+	if (doca_mmap_create(&st.dst_mmap) != DOCA_SUCCESS || doca_mmap_add_dev(st.dst_mmap, dev) != DOCA_SUCCESS ||
+	    doca_mmap_set_memrange(st.dst_mmap, st.dst, region) != DOCA_SUCCESS ||
+	    doca_mmap_set_permissions(st.dst_mmap, DOCA_ACCESS_FLAG_PCI_READ_WRITE) != DOCA_SUCCESS ||
+	    doca_mmap_start(st.dst_mmap) != DOCA_SUCCESS ||
+	    doca_mmap_export_pci(st.dst_mmap, dev, &export_desc, &export_len) != DOCA_SUCCESS)
+		return EXIT_FAILURE;
+	if (doca_mmap_create_from_export(NULL, export_desc, export_len, dev, &remote_mmap) != DOCA_SUCCESS)
+		return EXIT_FAILURE;
+
+	if (doca_buf_inventory_create(2 * DEPTH, &st.inv) != DOCA_SUCCESS ||
+	    doca_buf_inventory_start(st.inv) != DOCA_SUCCESS || doca_pe_create(&pe) != DOCA_SUCCESS ||
+	    doca_dma_create(dev, &dma) != DOCA_SUCCESS ||
+	    doca_dma_task_memcpy_set_conf(dma, copy_completed_cb, copy_error_cb, DEPTH) != DOCA_SUCCESS ||
+	    doca_pe_connect_ctx(pe, doca_dma_as_ctx(dma)) != DOCA_SUCCESS)
+		return EXIT_FAILURE;
+	data.ptr = &st;
+	doca_ctx_set_user_data(doca_dma_as_ctx(dma), data);
+	if (doca_ctx_start(doca_dma_as_ctx(dma)) != DOCA_SUCCESS)
+		return EXIT_FAILURE;
+
+	for (i = 0; i < DEPTH; i++) {
+		if (doca_buf_inventory_buf_get_by_addr(st.inv, st.src_mmap, st.src + i * SLOT_SIZE, SLOT_SIZE,
+						       &src_buf) != DOCA_SUCCESS ||
+		    doca_buf_inventory_buf_get_by_addr(st.inv, remote_mmap, st.dst + i * SLOT_SIZE, SLOT_SIZE,
+						       &dst_buf) != DOCA_SUCCESS)
+			return EXIT_FAILURE;
+		data.u64 = i;
+		if (doca_dma_task_memcpy_alloc_init(dma, src_buf, dst_buf, data, &tasks[i]) != DOCA_SUCCESS)
+			return EXIT_FAILURE;
+	}
+	for (i = 0; i < depth && st.submitted < st.ops; i++) {
+		if (submit_copy(&st, tasks[i], i) != DOCA_SUCCESS)
+			return EXIT_FAILURE;
+	}
+	while (st.completed < st.submitted)
+		doca_pe_progress(pe);
+
+	printf("Copied %ld buffers, %d errors\n", st.completed, st.errors);
+
+	for (i = 0; i < DEPTH; i++) {
+		doca_buf_dec_refcount((struct doca_buf *)doca_dma_task_memcpy_get_src(tasks[i]), NULL);
+		doca_buf_dec_refcount(doca_dma_task_memcpy_get_dst(tasks[i]), NULL);
+		doca_task_free(doca_dma_task_memcpy_as_task(tasks[i]));
+	}
+	doca_ctx_stop(doca_dma_as_ctx(dma));
+	doca_dma_destroy(dma);
+	doca_pe_destroy(pe);
+	doca_buf_inventory_stop(st.inv);
+	doca_buf_inventory_destroy(st.inv);
+	doca_mmap_destroy(remote_mmap);
+	doca_mmap_stop(st.dst_mmap);
+	doca_mmap_destroy(st.dst_mmap);
+	doca_mmap_stop(st.src_mmap);
+	doca_mmap_destroy(st.src_mmap);
+	doca_dev_close(dev);
+	free(st.src);
+	free(st.dst);
+	return st.errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
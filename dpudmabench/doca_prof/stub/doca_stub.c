@@ -0,0 +1,638 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <doca_buf.h>
+#include <doca_buf_inventory.h>
+#include <doca_ctx.h>
+#include <doca_dev.h>
+#include <doca_dma.h>
+#include <doca_error.h>
+#include <doca_mmap.h>
+#include <doca_pe.h>
+
+/*
+ * Software stand-in for libdoca_common and libdoca_dma
+ *
+ * Implements the stub headers well enough to run DOCA DMA code on a machine without a DPU: one fake device, mmaps over
+ * local memory, and a progress engine with a FIFO of submitted tasks. A task becomes ready STUB_LATENCY_NS plus its
+ * transfer time at STUB_BYTES_PER_NS after submission, and the doca_pe_progress() call that finds the oldest task ready
+ * copies it with memcpy() and runs its completion callback. Exports only work inside one process and nothing is
+ * thread safe.
+ */
+
+#define STUB_PCI_ADDR "03:00.0"		/* PCI address of the fake device */
+#define STUB_MAX_BUF_SIZE (2UL << 20)	/* Largest memcpy task */
+#define STUB_LATENCY_NS 2000		/* Fixed part of the emulated task latency */
+#define STUB_BYTES_PER_NS 12		/* Emulated bandwidth, about 12 GB/s */
+
+struct doca_devinfo {
+	char pci_addr[DOCA_DEVINFO_PCI_ADDR_SIZE];	/* PCI address */
+};
+
+struct doca_dev {
+	struct doca_devinfo *devinfo;	/* Device the handle was opened on */
+};
+
+struct doca_mmap {
+	char *addr;	/* Start of the memory range */
+	size_t len;	/* Length of the memory range */
+	int started;	/* doca_mmap_start() was called */
+};
+
+struct doca_buf_inventory {
+	size_t num_elements;	/* Capacity */
+	size_t used;		/* Buffers handed out */
+	int started;		/* doca_buf_inventory_start() was called */
+};
+
+struct doca_buf {
+	struct doca_buf_inventory *inventory;	/* Inventory the buffer came from */
+	char *head;				/* Start of the buffer */
+	size_t len;				/* Length of the buffer */
+	char *data;				/* Start of the data */
+	size_t data_len;			/* Length of the data */
+	uint16_t refcount;			/* References */
+};
+
+struct doca_ctx {
+	enum doca_ctx_states state;	/* Context state */
+	union doca_data user_data;	/* Passed to the completion callbacks */
+	struct doca_pe *pe;		/* Connected progress engine */
+	struct doca_dma *dma;		/* Owning DMA context */
+};
+
+struct doca_task {
+	struct doca_ctx *ctx;		/* Context the task belongs to */
+	union doca_data user_data;	/* Passed to the completion callbacks */
+	doca_error_t status;		/* Result of the last execution */
+	uint64_t ready_ns;		/* Emulated completion time */
+	struct doca_task *next;		/* Progress engine queue */
+};
+
+struct doca_dma_task_memcpy {
+	struct doca_task base;		/* Generic task, first so the two convert by a cast */
+	const struct doca_buf *src;	/* Source buffer */
+	struct doca_buf *dst;		/* Destination buffer */
+};
+
+struct doca_dma {
+	struct doca_ctx ctx;					/* Generic context */
+	doca_dma_task_memcpy_completion_cb_t completion_cb;	/* Success callback */
+	doca_dma_task_memcpy_completion_cb_t error_cb;		/* Error callback */
+	uint32_t max_tasks;					/* Task pool size */
+	uint32_t nb_tasks;					/* Allocated tasks */
+};
+
+struct doca_pe {
+	struct doca_task *head;	/* Oldest submitted task */
+	struct doca_task *tail;	/* Newest submitted task */
+	size_t inflight;	/* Submitted and not completed tasks */
+};
+
+/* Exported memory range, the descriptor returned by doca_mmap_export_pci() */
+struct stub_export {
+	char *addr;	/* Start of the range */
+	size_t len;	/* Length of the range */
+};
+
+static struct doca_devinfo stub_devinfo = {STUB_PCI_ADDR};
+
+/*
+ * Monotonic time
+ *
+ * @return: current time in nanoseconds
+ */
+static uint64_t
+stub_now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+const char *
+doca_error_get_name(doca_error_t error)
+{
+	static const char *const names[] = {
+		"DOCA_SUCCESS", "DOCA_ERROR_UNKNOWN", "DOCA_ERROR_NOT_PERMITTED", "DOCA_ERROR_IN_USE",
+		"DOCA_ERROR_NOT_SUPPORTED", "DOCA_ERROR_AGAIN", "DOCA_ERROR_INVALID_VALUE", "DOCA_ERROR_NO_MEMORY",
+		"DOCA_ERROR_INITIALIZATION", "DOCA_ERROR_TIME_OUT", "DOCA_ERROR_SHUTDOWN",
+		"DOCA_ERROR_CONNECTION_RESET", "DOCA_ERROR_CONNECTION_ABORTED", "DOCA_ERROR_CONNECTION_INPROGRESS",
+		"DOCA_ERROR_NOT_CONNECTED", "DOCA_ERROR_NO_LOCK", "DOCA_ERROR_NOT_FOUND", "DOCA_ERROR_IO_FAILED",
+		"DOCA_ERROR_BAD_STATE", "DOCA_ERROR_UNSUPPORTED_VERSION", "DOCA_ERROR_OPERATING_SYSTEM",
+		"DOCA_ERROR_DRIVER", "DOCA_ERROR_UNEXPECTED", "DOCA_ERROR_ALREADY_EXIST", "DOCA_ERROR_FULL",
+		"DOCA_ERROR_EMPTY", "DOCA_ERROR_IN_PROGRESS", "DOCA_ERROR_TOO_BIG",
+	};
+
+	if ((unsigned int)error >= sizeof(names) / sizeof(names[0]))
+		return "DOCA_ERROR_UNKNOWN";
+	return names[error];
+}
+
+const char *
+doca_error_get_descr(doca_error_t error)
+{
+	return doca_error_get_name(error);
+}
+
+doca_error_t
+doca_devinfo_create_list(struct doca_devinfo ***dev_list, uint32_t *nb_devs)
+{
+	*dev_list = calloc(1, sizeof(**dev_list));
+	if (*dev_list == NULL)
+		return DOCA_ERROR_NO_MEMORY;
+	(*dev_list)[0] = &stub_devinfo;
+	*nb_devs = 1;
+	return DOCA_SUCCESS;
+}
+
+doca_error_t
+doca_devinfo_destroy_list(struct doca_devinfo **dev_list)
+{
+	free(dev_list);
+	return DOCA_SUCCESS;
+}
+
+doca_error_t
+doca_devinfo_is_equal_pci_addr(const struct doca_devinfo *devinfo, const char *pci_addr_str, uint8_t *is_equal)
+{
+	*is_equal = strcmp(devinfo->pci_addr, pci_addr_str) == 0;
+	return DOCA_SUCCESS;
+}
+
+doca_error_t
+doca_dev_open(struct doca_devinfo *devinfo, struct doca_dev **dev)
+{
+	*dev = calloc(1, sizeof(**dev));
+	if (*dev == NULL)
+		return DOCA_ERROR_NO_MEMORY;
+	(*dev)->devinfo = devinfo;
+	return DOCA_SUCCESS;
+}
+
+doca_error_t
+doca_dev_close(struct doca_dev *dev)
+{
+	free(dev);
+	return DOCA_SUCCESS;
+}
+
+struct doca_devinfo *
+doca_dev_as_devinfo(const struct doca_dev *dev)
+{
+	return dev->devinfo;
+}
+
+doca_error_t
+doca_mmap_create(struct doca_mmap **mmap)
+{
+	*mmap = calloc(1, sizeof(**mmap));
+	return *mmap == NULL ? DOCA_ERROR_NO_MEMORY : DOCA_SUCCESS;
+}
+
+doca_error_t
+doca_mmap_destroy(struct doca_mmap *mmap)
+{
+	free(mmap);
+	return DOCA_SUCCESS;
+}
+
+doca_error_t
+doca_mmap_start(struct doca_mmap *mmap)
+{
+	if (mmap->addr == NULL)
+		return DOCA_ERROR_BAD_STATE;
+	mmap->started = 1;
+	return DOCA_SUCCESS;
+}
+
+doca_error_t
+doca_mmap_stop(struct doca_mmap *mmap)
+{
+	mmap->started = 0;
+	return DOCA_SUCCESS;
+}
+
+doca_error_t
+doca_mmap_add_dev(struct doca_mmap *mmap, struct doca_dev *dev)
+{
+	(void)dev;
+	return mmap->started ? DOCA_ERROR_BAD_STATE : DOCA_SUCCESS;
+}
+
+doca_error_t
+doca_mmap_set_memrange(struct doca_mmap *mmap, void *addr, size_t len)
+{
+	if (mmap->started)
+		return DOCA_ERROR_BAD_STATE;
+	if (addr == NULL || len == 0)
+		return DOCA_ERROR_INVALID_VALUE;
+	mmap->addr = addr;
+	mmap->len = len;
+	return DOCA_SUCCESS;
+}
+
+doca_error_t
+doca_mmap_set_permissions(struct doca_mmap *mmap, uint32_t access_mask)
+{
+	(void)access_mask;
+	return mmap->started ? DOCA_ERROR_BAD_STATE : DOCA_SUCCESS;
+}
+
+doca_error_t
+doca_mmap_export_pci(struct doca_mmap *mmap, const struct doca_dev *dev, const void **export_desc,
+		     size_t *export_desc_len)
+{
+	static struct stub_export desc;
+
+	(void)dev;
+	if (!mmap->started)
+		return DOCA_ERROR_BAD_STATE;
+	desc.addr = mmap->addr;
+	desc.len = mmap->len;
+	*export_desc = &desc;
+	*export_desc_len = sizeof(desc);
+	return DOCA_SUCCESS;
+}
+
+doca_error_t
+doca_mmap_create_from_export(const union doca_data *user_data, const void *export_desc, size_t export_desc_len,
+			     struct doca_dev *dev, struct doca_mmap **mmap)
+{
+	const struct stub_export *desc = export_desc;
+	doca_error_t result;
+
+	(void)user_data;
+	(void)dev;
+	if (export_desc_len != sizeof(*desc))
+		return DOCA_ERROR_INVALID_VALUE;
+	result = doca_mmap_create(mmap);
+	if (result != DOCA_SUCCESS)
+		return result;
+	(*mmap)->addr = desc->addr;
+	(*mmap)->len = desc->len;
+	(*mmap)->started = 1;
+	return DOCA_SUCCESS;
+}
+
+doca_error_t
+doca_buf_inventory_create(size_t num_elements, struct doca_buf_inventory **buf_inventory)
+{
+	*buf_inventory = calloc(1, sizeof(**buf_inventory));
+	if (*buf_inventory == NULL)
+		return DOCA_ERROR_NO_MEMORY;
+	(*buf_inventory)->num_elements = num_elements;
+	return DOCA_SUCCESS;
+}
+
+doca_error_t
+doca_buf_inventory_destroy(struct doca_buf_inventory *inventory)
+{
+	if (inventory->used > 0)
+		return DOCA_ERROR_IN_USE;
+	free(inventory);
+	return DOCA_SUCCESS;
+}
+
+doca_error_t
+doca_buf_inventory_start(struct doca_buf_inventory *inventory)
+{
+	inventory->started = 1;
+	return DOCA_SUCCESS;
+}
+
+doca_error_t
+doca_buf_inventory_stop(struct doca_buf_inventory *inventory)
+{
+	inventory->started = 0;
+	return DOCA_SUCCESS;
+}
+
+doca_error_t
+doca_buf_inventory_buf_get_by_addr(struct doca_buf_inventory *inventory, struct doca_mmap *mmap, void *addr,
+				   size_t len, struct doca_buf **buf)
+{
+	char *p = addr;
+
+	if (!inventory->started || !mmap->started)
+		return DOCA_ERROR_BAD_STATE;
+	if (p < mmap->addr || p + len > mmap->addr + mmap->len)
+		return DOCA_ERROR_INVALID_VALUE;
+	if (inventory->used == inventory->num_elements)
+		return DOCA_ERROR_NO_MEMORY;
+	*buf = calloc(1, sizeof(**buf));
+	if (*buf == NULL)
+		return DOCA_ERROR_NO_MEMORY;
+	(*buf)->inventory = inventory;
+	(*buf)->head = p;
+	(*buf)->len = len;
+	(*buf)->data = p;
+	(*buf)->refcount = 1;
+	inventory->used++;
+	return DOCA_SUCCESS;
+}
+
+doca_error_t
+doca_buf_inventory_buf_get_by_data(struct doca_buf_inventory *inventory, struct doca_mmap *mmap, void *data,
+				   size_t data_len, struct doca_buf **buf)
+{
+	doca_error_t result = doca_buf_inventory_buf_get_by_addr(inventory, mmap, data, data_len, buf);
+
+	if (result == DOCA_SUCCESS)
+		(*buf)->data_len = data_len;
+	return result;
+}
+
+doca_error_t
+doca_buf_dec_refcount(struct doca_buf *buf, uint16_t *refcount)
+{
+	uint16_t left = --buf->refcount;
+
+	if (left == 0) {
+		buf->inventory->used--;
+		free(buf);
+	}
+	if (refcount != NULL)
+		*refcount = left;
+	return DOCA_SUCCESS;
+}
+
+doca_error_t
+doca_buf_get_data(const struct doca_buf *buf, void **data)
+{
+	*data = buf->data;
+	return DOCA_SUCCESS;
+}
+
+doca_error_t
+doca_buf_get_data_len(const struct doca_buf *buf, size_t *data_len)
+{
+	*data_len = buf->data_len;
+	return DOCA_SUCCESS;
+}
+
+doca_error_t
+doca_buf_set_data(struct doca_buf *buf, void *data, size_t data_len)
+{
+	char *p = data;
+
+	if (p < buf->head || p + data_len > buf->head + buf->len)
+		return DOCA_ERROR_INVALID_VALUE;
+	buf->data = p;
+	buf->data_len = data_len;
+	return DOCA_SUCCESS;
+}
+
+doca_error_t
+doca_buf_reset_data_len(struct doca_buf *buf)
+{
+	buf->data_len = 0;
+	return DOCA_SUCCESS;
+}
+
+doca_error_t
+doca_pe_create(struct doca_pe **pe)
+{
+	*pe = calloc(1, sizeof(**pe));
+	return *pe == NULL ? DOCA_ERROR_NO_MEMORY : DOCA_SUCCESS;
+}
+
+doca_error_t
+doca_pe_destroy(struct doca_pe *pe)
+{
+	if (pe->inflight > 0)
+		return DOCA_ERROR_IN_USE;
+	free(pe);
+	return DOCA_SUCCESS;
+}
+
+doca_error_t
+doca_pe_connect_ctx(struct doca_pe *pe, struct doca_ctx *ctx)
+{
+	if (ctx->state != DOCA_CTX_STATE_IDLE)
+		return DOCA_ERROR_BAD_STATE;
+	ctx->pe = pe;
+	return DOCA_SUCCESS;
+}
+
+/*
+ * Execute the oldest submitted task once it is ready: copy the source data behind the destination data and run the
+ * callback
+ *
+ * @pe [in]: progress engine
+ * @return: 1 if a task completed and 0 otherwise
+ */
+uint8_t
+doca_pe_progress(struct doca_pe *pe)
+{
+	struct doca_dma_task_memcpy *task;
+	struct doca_task *base = pe->head;
+	struct doca_dma *dma;
+
+	if (base == NULL || stub_now() < base->ready_ns)
+		return 0;
+	pe->head = base->next;
+	if (pe->head == NULL)
+		pe->tail = NULL;
+	pe->inflight--;
+
+	task = (struct doca_dma_task_memcpy *)base;
+	dma = base->ctx->dma;
+	if (task->src->data_len > STUB_MAX_BUF_SIZE ||
+	    task->dst->data + task->dst->data_len + task->src->data_len > task->dst->head + task->dst->len) {
+		base->status = DOCA_ERROR_INVALID_VALUE;
+		dma->error_cb(task, base->user_data, base->ctx->user_data);
+		return 1;
+	}
+	memcpy(task->dst->data + task->dst->data_len, task->src->data, task->src->data_len);
+	task->dst->data_len += task->src->data_len;
+	base->status = DOCA_SUCCESS;
+	dma->completion_cb(task, base->user_data, base->ctx->user_data);
+	return 1;
+}
+
+doca_error_t
+doca_pe_get_num_inflight_tasks(const struct doca_pe *pe, size_t *num_inflight_tasks)
+{
+	*num_inflight_tasks = pe->inflight;
+	return DOCA_SUCCESS;
+}
+
+doca_error_t
+doca_ctx_start(struct doca_ctx *ctx)
+{
+	if (ctx->pe == NULL || ctx->dma->completion_cb == NULL)
+		return DOCA_ERROR_BAD_STATE;
+	ctx->state = DOCA_CTX_STATE_RUNNING;
+	return DOCA_SUCCESS;
+}
+
+doca_error_t
+doca_ctx_stop(struct doca_ctx *ctx)
+{
+	if (ctx->pe != NULL && ctx->pe->inflight > 0) {
+		ctx->state = DOCA_CTX_STATE_STOPPING;
+		return DOCA_ERROR_IN_PROGRESS;
+	}
+	ctx->state = DOCA_CTX_STATE_IDLE;
+	return DOCA_SUCCESS;
+}
+
+doca_error_t
+doca_ctx_get_state(const struct doca_ctx *ctx, enum doca_ctx_states *state)
+{
+	/* A stopping context goes idle once its last task completed */
+	if (ctx->state == DOCA_CTX_STATE_STOPPING && ctx->pe->inflight == 0)
+		*state = DOCA_CTX_STATE_IDLE;
+	else
+		*state = ctx->state;
+	return DOCA_SUCCESS;
+}
+
+doca_error_t
+doca_ctx_set_user_data(struct doca_ctx *ctx, union doca_data user_data)
+{
+	ctx->user_data = user_data;
+	return DOCA_SUCCESS;
+}
+
+doca_error_t
+doca_task_submit(struct doca_task *task)
+{
+	struct doca_pe *pe = task->ctx->pe;
+
+	if (task->ctx->state != DOCA_CTX_STATE_RUNNING)
+		return DOCA_ERROR_BAD_STATE;
+	task->ready_ns = stub_now() + STUB_LATENCY_NS +
+			 ((struct doca_dma_task_memcpy *)task)->src->data_len / STUB_BYTES_PER_NS;
+	task->next = NULL;
+	if (pe->tail == NULL)
+		pe->head = task;
+	else
+		pe->tail->next = task;
+	pe->tail = task;
+	pe->inflight++;
+	return DOCA_SUCCESS;
+}
+
+void
+doca_task_free(struct doca_task *task)
+{
+	task->ctx->dma->nb_tasks--;
+	free(task);
+}
+
+doca_error_t
+doca_task_get_status(const struct doca_task *task)
+{
+	return task->status;
+}
+
+doca_error_t
+doca_dma_create(struct doca_dev *dev, struct doca_dma **dma)
+{
+	(void)dev;
+	*dma = calloc(1, sizeof(**dma));
+	if (*dma == NULL)
+		return DOCA_ERROR_NO_MEMORY;
+	(*dma)->ctx.dma = *dma;
+	return DOCA_SUCCESS;
+}
+
+doca_error_t
+doca_dma_destroy(struct doca_dma *dma)
+{
+	if (dma->ctx.state != DOCA_CTX_STATE_IDLE || dma->nb_tasks > 0)
+		return DOCA_ERROR_IN_USE;
+	free(dma);
+	return DOCA_SUCCESS;
+}
+
+struct doca_ctx *
+doca_dma_as_ctx(struct doca_dma *dma)
+{
+	return &dma->ctx;
+}
+
+doca_error_t
+doca_dma_cap_task_memcpy_get_max_buf_size(const struct doca_devinfo *devinfo, uint64_t *buf_size)
+{
+	(void)devinfo;
+	*buf_size = STUB_MAX_BUF_SIZE;
+	return DOCA_SUCCESS;
+}
+
+doca_error_t
+doca_dma_task_memcpy_set_conf(struct doca_dma *dma, doca_dma_task_memcpy_completion_cb_t task_completion_cb,
+			      doca_dma_task_memcpy_completion_cb_t task_error_cb, uint32_t num_memcpy_tasks)
+{
+	if (dma->ctx.state != DOCA_CTX_STATE_IDLE)
+		return DOCA_ERROR_BAD_STATE;
+	if (task_completion_cb == NULL || task_error_cb == NULL || num_memcpy_tasks == 0)
+		return DOCA_ERROR_INVALID_VALUE;
+	dma->completion_cb = task_completion_cb;
+	dma->error_cb = task_error_cb;
+	dma->max_tasks = num_memcpy_tasks;
+	return DOCA_SUCCESS;
+}
+
+doca_error_t
+doca_dma_task_memcpy_alloc_init(struct doca_dma *dma, const struct doca_buf *src, struct doca_buf *dst,
+				union doca_data user_data, struct doca_dma_task_memcpy **task)
+{
+	if (dma->nb_tasks == dma->max_tasks)
+		return DOCA_ERROR_NO_MEMORY;
+	*task = calloc(1, sizeof(**task));
+	if (*task == NULL)
+		return DOCA_ERROR_NO_MEMORY;
+	(*task)->base.ctx = &dma->ctx;
+	(*task)->base.user_data = user_data;
+	(*task)->src = src;
+	(*task)->dst = dst;
+	dma->nb_tasks++;
+	return DOCA_SUCCESS;
+}
+
+struct doca_task *
+doca_dma_task_memcpy_as_task(struct doca_dma_task_memcpy *task)
+{
+	return &task->base;
+}
+
+void
+doca_dma_task_memcpy_set_src(struct doca_dma_task_memcpy *task, const struct doca_buf *src)
+{
+	task->src = src;
+}
+
+const struct doca_buf *
+doca_dma_task_memcpy_get_src(const struct doca_dma_task_memcpy *task)
+{
+	return task->src;
+}
+
+void
+doca_dma_task_memcpy_set_dst(struct doca_dma_task_memcpy *task, struct doca_buf *dst)
+{
+	task->dst = dst;
+}
+
+struct doca_buf *
+doca_dma_task_memcpy_get_dst(const struct doca_dma_task_memcpy *task)
+{
+	return task->dst;
+}
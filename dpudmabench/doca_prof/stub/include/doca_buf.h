@@ -0,0 +1,31 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+#ifndef DOCA_BUF_H_
+#define DOCA_BUF_H_
+
+#include <doca_error.h>
+#include <doca_types.h>
+
+struct doca_buf;
+
+doca_error_t doca_buf_dec_refcount(struct doca_buf *buf, uint16_t *refcount);
+
+doca_error_t doca_buf_get_data(const struct doca_buf *buf, void **data);
+
+doca_error_t doca_buf_get_data_len(const struct doca_buf *buf, size_t *data_len);
+
+doca_error_t doca_buf_set_data(struct doca_buf *buf, void *data, size_t data_len);
+
+doca_error_t doca_buf_reset_data_len(struct doca_buf *buf);
+
+#endif
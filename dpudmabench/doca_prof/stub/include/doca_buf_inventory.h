@@ -0,0 +1,37 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+#ifndef DOCA_BUF_INVENTORY_H_
+#define DOCA_BUF_INVENTORY_H_
+
+#include <doca_buf.h>
+#include <doca_error.h>
+#include <doca_mmap.h>
+#include <doca_types.h>
+
+struct doca_buf_inventory;
+
+doca_error_t doca_buf_inventory_create(size_t num_elements, struct doca_buf_inventory **buf_inventory);
+
+doca_error_t doca_buf_inventory_destroy(struct doca_buf_inventory *inventory);
+
+doca_error_t doca_buf_inventory_start(struct doca_buf_inventory *inventory);
+
+doca_error_t doca_buf_inventory_stop(struct doca_buf_inventory *inventory);
+
+doca_error_t doca_buf_inventory_buf_get_by_addr(struct doca_buf_inventory *inventory, struct doca_mmap *mmap,
+						void *addr, size_t len, struct doca_buf **buf);
+
+doca_error_t doca_buf_inventory_buf_get_by_data(struct doca_buf_inventory *inventory, struct doca_mmap *mmap,
+						void *data, size_t data_len, struct doca_buf **buf);
+
+#endif
@@ -0,0 +1,43 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+#ifndef DOCA_CTX_H_
+#define DOCA_CTX_H_
+
+#include <doca_error.h>
+#include <doca_types.h>
+
+struct doca_ctx;
+struct doca_task;
+
+enum doca_ctx_states {
+	DOCA_CTX_STATE_IDLE = 0,
+	DOCA_CTX_STATE_STARTING = 1,
+	DOCA_CTX_STATE_RUNNING = 2,
+	DOCA_CTX_STATE_STOPPING = 3,
+};
+
+doca_error_t doca_ctx_start(struct doca_ctx *ctx);
+
+doca_error_t doca_ctx_stop(struct doca_ctx *ctx);
+
+doca_error_t doca_ctx_get_state(const struct doca_ctx *ctx, enum doca_ctx_states *state);
+
+doca_error_t doca_ctx_set_user_data(struct doca_ctx *ctx, union doca_data user_data);
+
+doca_error_t doca_task_submit(struct doca_task *task);
+
+void doca_task_free(struct doca_task *task);
+
+doca_error_t doca_task_get_status(const struct doca_task *task);
+
+#endif
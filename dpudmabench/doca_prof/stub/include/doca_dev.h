@@ -0,0 +1,37 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+#ifndef DOCA_DEV_H_
+#define DOCA_DEV_H_
+
+#include <doca_error.h>
+#include <doca_types.h>
+
+#define DOCA_DEVINFO_PCI_ADDR_SIZE 13
+
+struct doca_devinfo;
+struct doca_dev;
+
+doca_error_t doca_devinfo_create_list(struct doca_devinfo ***dev_list, uint32_t *nb_devs);
+
+doca_error_t doca_devinfo_destroy_list(struct doca_devinfo **dev_list);
+
+doca_error_t doca_devinfo_is_equal_pci_addr(const struct doca_devinfo *devinfo, const char *pci_addr_str,
+					    uint8_t *is_equal);
+
+doca_error_t doca_dev_open(struct doca_devinfo *devinfo, struct doca_dev **dev);
+
+doca_error_t doca_dev_close(struct doca_dev *dev);
+
+struct doca_devinfo *doca_dev_as_devinfo(const struct doca_dev *dev);
+
+#endif
@@ -0,0 +1,62 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+#ifndef DOCA_ERROR_H_
+#define DOCA_ERROR_H_
+
+/*
+ * Stub DOCA headers: the subset of the DOCA 2.5 API that doca_prof wraps and stub/dma_app uses, with the same
+ * signatures, so both build on a machine without DOCA. Only for testing doca_prof, not for benchmarking.
+ */
+
+typedef enum doca_error {
+	DOCA_SUCCESS = 0,
+	DOCA_ERROR_UNKNOWN,
+	DOCA_ERROR_NOT_PERMITTED,
+	DOCA_ERROR_IN_USE,
+	DOCA_ERROR_NOT_SUPPORTED,
+	DOCA_ERROR_AGAIN,
+	DOCA_ERROR_INVALID_VALUE,
+	DOCA_ERROR_NO_MEMORY,
+	DOCA_ERROR_INITIALIZATION,
+	DOCA_ERROR_TIME_OUT,
+	DOCA_ERROR_SHUTDOWN,
+	DOCA_ERROR_CONNECTION_RESET,
+	DOCA_ERROR_CONNECTION_ABORTED,
+	DOCA_ERROR_CONNECTION_INPROGRESS,
+	DOCA_ERROR_NOT_CONNECTED,
+	DOCA_ERROR_NO_LOCK,
+	DOCA_ERROR_NOT_FOUND,
+	DOCA_ERROR_IO_FAILED,
+	DOCA_ERROR_BAD_STATE,
+	DOCA_ERROR_UNSUPPORTED_VERSION,
+	DOCA_ERROR_OPERATING_SYSTEM,
+	DOCA_ERROR_DRIVER,
+	DOCA_ERROR_UNEXPECTED,
+	DOCA_ERROR_ALREADY_EXIST,
+	DOCA_ERROR_FULL,
+	DOCA_ERROR_EMPTY,
+	DOCA_ERROR_IN_PROGRESS,
+	DOCA_ERROR_TOO_BIG,
+} doca_error_t;
+
+#define DOCA_ERROR_PROPAGATE(r, t) \
+	do { \
+		if (r == DOCA_SUCCESS) \
+			r = t; \
+	} while (0)
+
+const char *doca_error_get_name(doca_error_t error);
+
+const char *doca_error_get_descr(doca_error_t error);
+
+#endif
@@ -0,0 +1,42 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+#ifndef DOCA_MMAP_H_
+#define DOCA_MMAP_H_
+
+#include <doca_dev.h>
+#include <doca_error.h>
+#include <doca_types.h>
+
+struct doca_mmap;
+
+doca_error_t doca_mmap_create(struct doca_mmap **mmap);
+
+doca_error_t doca_mmap_destroy(struct doca_mmap *mmap);
+
+doca_error_t doca_mmap_start(struct doca_mmap *mmap);
+
+doca_error_t doca_mmap_stop(struct doca_mmap *mmap);
+
+doca_error_t doca_mmap_add_dev(struct doca_mmap *mmap, struct doca_dev *dev);
+
+doca_error_t doca_mmap_set_memrange(struct doca_mmap *mmap, void *addr, size_t len);
+
+doca_error_t doca_mmap_set_permissions(struct doca_mmap *mmap, uint32_t access_mask);
+
+doca_error_t doca_mmap_export_pci(struct doca_mmap *mmap, const struct doca_dev *dev, const void **export_desc,
+				  size_t *export_desc_len);
+
+doca_error_t doca_mmap_create_from_export(const union doca_data *user_data, const void *export_desc,
+					  size_t export_desc_len, struct doca_dev *dev, struct doca_mmap **mmap);
+
+#endif
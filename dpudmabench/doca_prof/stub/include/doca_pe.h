@@ -0,0 +1,32 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+#ifndef DOCA_PE_H_
+#define DOCA_PE_H_
+
+#include <doca_ctx.h>
+#include <doca_error.h>
+#include <doca_types.h>
+
+struct doca_pe;
+
+doca_error_t doca_pe_create(struct doca_pe **pe);
+
+doca_error_t doca_pe_destroy(struct doca_pe *pe);
+
+doca_error_t doca_pe_connect_ctx(struct doca_pe *pe, struct doca_ctx *ctx);
+
+uint8_t doca_pe_progress(struct doca_pe *pe);
+
+doca_error_t doca_pe_get_num_inflight_tasks(const struct doca_pe *pe, size_t *num_inflight_tasks);
+
+#endif
@@ -0,0 +1,34 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+#ifndef DOCA_TYPES_H_
+#define DOCA_TYPES_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+union doca_data {
+	void *ptr;
+	uint64_t u64;
+};
+
+enum doca_access_flag {
+	DOCA_ACCESS_FLAG_LOCAL_READ_ONLY = 0,
+	DOCA_ACCESS_FLAG_LOCAL_READ_WRITE = (1 << 0),
+	DOCA_ACCESS_FLAG_RDMA_READ = (1 << 1),
+	DOCA_ACCESS_FLAG_RDMA_WRITE = (1 << 2),
+	DOCA_ACCESS_FLAG_RDMA_ATOMIC = (1 << 3),
+	DOCA_ACCESS_FLAG_PCI_READ_ONLY = (1 << 4),
+	DOCA_ACCESS_FLAG_PCI_READ_WRITE = (1 << 5),
+};
+
+#endif
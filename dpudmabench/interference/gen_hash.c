@@ -0,0 +1,139 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "interfere.h"
+
+#define HASH_DEFAULT_MEM (1UL << 20)	/* Key buffer per thread, cache resident like a KVS hot set */
+#define HASH_DEFAULT_KEY 64		/* Key size */
+#define HASH_SEED 0x9747b28cULL		/* Same seed for every key, so the hashes are independent */
+
+/* Key buffer of one hash thread */
+struct hash_priv {
+	uint8_t *keys;
+	size_t nb_keys;
+	uint64_t sink;		/* Keeps the hashes alive */
+};
+
+/*
+ * MurmurHash64A
+ *
+ * @key [in]: key
+ * @len [in]: key length
+ * @seed [in]: seed
+ * @return: 64-bit hash
+ */
+static uint64_t
+murmur64a(const void *key, size_t len, uint64_t seed)
+{
+	const uint64_t m = 0xc6a4a7935bd1e995ULL;
+	const int r = 47;
+	const uint8_t *data = key, *end = data + (len & ~(size_t)7);
+	uint64_t h = seed ^ (len * m), k;
+	size_t tail = len & 7;
+
+	for (; data != end; data += 8) {
+		memcpy(&k, data, sizeof(k));
+		k *= m;
+		k ^= k >> r;
+		k *= m;
+		h ^= k;
+		h *= m;
+	}
+	if (tail) {
+		k = 0;
+		memcpy(&k, data, tail);
+		h ^= k;
+		h *= m;
+	}
+	h ^= h >> r;
+	h *= m;
+	h ^= h >> r;
+	return h;
+}
+
+/*
+ * Fill the key buffer on the pinned core
+ *
+ * @t [in]: generator thread
+ * @return: 0 on success and -1 otherwise
+ */
+static int
+hash_setup(struct gen_thread *t)
+{
+	size_t mem = t->cfg->mem_size ? t->cfg->mem_size : HASH_DEFAULT_MEM;
+	size_t key_size = t->cfg->key_size ? t->cfg->key_size : HASH_DEFAULT_KEY;
+	struct hash_priv *p;
+	size_t i;
+
+	p = calloc(1, sizeof(*p));
+	if (p == NULL)
+		return -1;
+	t->priv = p;
+	p->nb_keys = mem / key_size;
+	if (p->nb_keys == 0)
+		return -1;
+	p->keys = malloc(p->nb_keys * key_size);
+	if (p->keys == NULL)
+		return -1;
+	for (i = 0; i < p->nb_keys * key_size; i++)
+		p->keys[i] = (uint8_t)(i * 131 + t->id);
+	return 0;
+}
+
+/*
+ * Hash every key of the buffer, over and over, until told to stop
+ *
+ * @t [in]: generator thread
+ */
+static void
+hash_run(struct gen_thread *t)
+{
+	struct hash_priv *p = t->priv;
+	size_t key_size = t->cfg->key_size ? t->cfg->key_size : HASH_DEFAULT_KEY;
+	uint64_t h = p->sink;
+	size_t i;
+
+	while (!gen_stop) {
+		for (i = 0; i < p->nb_keys; i++)
+			h ^= murmur64a(p->keys + i * key_size, key_size, HASH_SEED);
+		t->bytes += p->nb_keys * key_size;
+		t->ops += p->nb_keys;
+	}
+	p->sink = h;
+}
+
+/*
+ * Free the key buffer
+ *
+ * @t [in]: generator thread
+ */
+static void
+hash_cleanup(struct gen_thread *t)
+{
+	struct hash_priv *p = t->priv;
+
+	if (p == NULL)
+		return;
+	free(p->keys);
+	free(p);
+}
+
+const struct generator gen_hash = {
+	.name = "hash",
+	.description = "MurmurHash64A over 64 B keys of a 1 MB buffer per thread (Mops counts keys)",
+	.setup = hash_setup,
+	.run = hash_run,
+	.cleanup = hash_cleanup,
+};
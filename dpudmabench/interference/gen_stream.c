@@ -0,0 +1,106 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "interfere.h"
+
+#define STREAM_DEFAULT_MEM (96UL << 20)	/* Three arrays per thread, far larger than the LLC */
+#define STREAM_SCALAR 3.0
+
+/* Arrays of one stream thread */
+struct stream_priv {
+	double *a;
+	double *b;
+	double *c;
+	size_t n;
+};
+
+/*
+ * Allocate and first-touch the arrays on the pinned core
+ *
+ * @t [in]: generator thread
+ * @return: 0 on success and -1 otherwise
+ */
+static int
+stream_setup(struct gen_thread *t)
+{
+	size_t mem = t->cfg->mem_size ? t->cfg->mem_size : STREAM_DEFAULT_MEM;
+	struct stream_priv *p;
+	size_t i;
+
+	p = calloc(1, sizeof(*p));
+	if (p == NULL)
+		return -1;
+	t->priv = p;
+	p->n = mem / 3 / sizeof(double);
+	if (p->n == 0)
+		return -1;
+	if (posix_memalign((void **)&p->a, 4096, p->n * sizeof(double)) != 0 ||
+	    posix_memalign((void **)&p->b, 4096, p->n * sizeof(double)) != 0 ||
+	    posix_memalign((void **)&p->c, 4096, p->n * sizeof(double)) != 0)
+		return -1;
+	for (i = 0; i < p->n; i++) {
+		p->a[i] = 1.0;
+		p->b[i] = 2.0;
+		p->c[i] = 0.0;
+	}
+	return 0;
+}
+
+/*
+ * STREAM triad over the arrays until told to stop, counted as STREAM does (two reads and one write)
+ *
+ * @t [in]: generator thread
+ */
+static void
+stream_run(struct gen_thread *t)
+{
+	struct stream_priv *p = t->priv;
+	double *restrict a = p->a;
+	const double *restrict b = p->b, *restrict c = p->c;
+	size_t i, n = p->n;
+
+	while (!gen_stop) {
+		for (i = 0; i < n; i++)
+			a[i] = b[i] + STREAM_SCALAR * c[i];
+		t->bytes += 3 * n * sizeof(double);
+		t->ops += n;
+	}
+}
+
+/*
+ * Free the arrays
+ *
+ * @t [in]: generator thread
+ */
+static void
+stream_cleanup(struct gen_thread *t)
+{
+	struct stream_priv *p = t->priv;
+
+	if (p == NULL)
+		return;
+	free(p->a);
+	free(p->b);
+	free(p->c);
+	free(p);
+}
+
+const struct generator gen_stream = {
+	.name = "stream",
+	.description = "STREAM triad per thread over 96 MB, GB/s counts two reads and a write",
+	.setup = stream_setup,
+	.run = stream_run,
+	.cleanup = stream_cleanup,
+};
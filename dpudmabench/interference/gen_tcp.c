@@ -0,0 +1,292 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "interfere.h"
+
+#define TCP_CHUNK (64UL << 10)		/* Bytes per send() */
+
+/* Loopback sink, started by tcp_init() when no remote target is given */
+static int listen_fd = -1;
+static pthread_t sink_tids[GEN_MAX_THREADS];
+static int sink_cores[GEN_MAX_THREADS];
+static int nb_sinks;
+static struct sockaddr_storage target_addr;
+static socklen_t target_len;
+
+/*
+ * Pin the calling thread to a core
+ *
+ * @core [in]: core
+ */
+static void
+pin_self(int core)
+{
+	cpu_set_t set;
+
+	CPU_ZERO(&set);
+	CPU_SET(core, &set);
+	pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+/*
+ * Receive and discard everything sent on a connection
+ *
+ * @fd [in]: connected socket
+ */
+static void
+drain(int fd)
+{
+	static __thread char buf[TCP_CHUNK];
+	ssize_t n;
+
+	do {
+		n = recv(fd, buf, sizeof(buf), 0);
+	} while (n > 0 || (n < 0 && errno == EINTR));
+	close(fd);
+}
+
+/*
+ * Loopback sink thread, accepts one connection and drains it on the core of its sender
+ *
+ * @arg [in]: pointer to the core
+ * @return: NULL
+ */
+static void *
+loopback_sink(void *arg)
+{
+	int fd;
+
+	pin_self(*(int *)arg);
+	fd = accept(listen_fd, NULL, NULL);
+	if (fd >= 0)
+		drain(fd);
+	return NULL;
+}
+
+/*
+ * Resolve host:port into target_addr
+ *
+ * @target [in]: host:port
+ * @return: 0 on success and -1 otherwise
+ */
+static int
+resolve_target(const char *target)
+{
+	struct addrinfo hints = {.ai_family = AF_UNSPEC, .ai_socktype = SOCK_STREAM}, *res;
+	char host[GEN_TARGET_SIZE];
+	const char *colon = strrchr(target, ':');
+	int ret;
+
+	if (colon == NULL || colon == target) {
+		fprintf(stderr, "TCP target must be host:port\n");
+		return -1;
+	}
+	snprintf(host, sizeof(host), "%.*s", (int)(colon - target), target);
+	ret = getaddrinfo(host, colon + 1, &hints, &res);
+	if (ret != 0) {
+		fprintf(stderr, "Failed to resolve %s: %s\n", target, gai_strerror(ret));
+		return -1;
+	}
+	memcpy(&target_addr, res->ai_addr, res->ai_addrlen);
+	target_len = res->ai_addrlen;
+	freeaddrinfo(res);
+	return 0;
+}
+
+/*
+ * Resolve the remote sink, or start a loopback sink with one receiver per sender
+ *
+ * @cfg [in]: configuration
+ * @return: 0 on success and -1 otherwise
+ */
+static int
+tcp_init(struct gen_config *cfg)
+{
+	struct sockaddr_in addr = {.sin_family = AF_INET, .sin_addr.s_addr = htonl(INADDR_LOOPBACK)};
+	socklen_t len = sizeof(addr);
+
+	if (cfg->target[0] != '\0')
+		return resolve_target(cfg->target);
+
+	/* Receivers run on the sender cores, so loopback traffic loads only the cores given to the generator */
+	listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+	if (listen_fd < 0 || bind(listen_fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 ||
+	    listen(listen_fd, GEN_MAX_THREADS) != 0 || getsockname(listen_fd, (struct sockaddr *)&addr, &len) != 0) {
+		perror("Failed to start the loopback sink");
+		return -1;
+	}
+	memcpy(&target_addr, &addr, sizeof(addr));
+	target_len = sizeof(addr);
+
+	for (nb_sinks = 0; nb_sinks < cfg->nb_threads; nb_sinks++) {
+		sink_cores[nb_sinks] = cfg->cores[nb_sinks];
+		if (pthread_create(&sink_tids[nb_sinks], NULL, loopback_sink, &sink_cores[nb_sinks]) != 0) {
+			fprintf(stderr, "Failed to start loopback sink thread\n");
+			return -1;
+		}
+	}
+	return 0;
+}
+
+/*
+ * Connect to the sink
+ *
+ * @t [in]: generator thread
+ * @return: 0 on success and -1 otherwise
+ */
+static int
+tcp_setup(struct gen_thread *t)
+{
+	int *fd;
+
+	fd = malloc(sizeof(*fd));
+	if (fd == NULL)
+		return -1;
+	t->priv = fd;
+	*fd = socket(target_addr.ss_family, SOCK_STREAM, 0);
+	if (*fd < 0 || connect(*fd, (struct sockaddr *)&target_addr, target_len) != 0) {
+		perror("Failed to connect to the TCP sink");
+		return -1;
+	}
+	return 0;
+}
+
+/*
+ * Send TCP_CHUNK blocks until told to stop
+ *
+ * @t [in]: generator thread
+ */
+static void
+tcp_run(struct gen_thread *t)
+{
+	static __thread char buf[TCP_CHUNK];
+	int fd = *(int *)t->priv;
+	ssize_t n;
+
+	while (!gen_stop) {
+		n = send(fd, buf, sizeof(buf), MSG_NOSIGNAL);
+		if (n < 0) {
+			if (errno == EINTR)
+				continue;
+			perror("TCP send failed");
+			t->ret = -1;
+			return;
+		}
+		t->bytes += n;
+		t->ops++;
+	}
+}
+
+/*
+ * Close the connection, which ends the receiver
+ *
+ * @t [in]: generator thread
+ */
+static void
+tcp_cleanup(struct gen_thread *t)
+{
+	int *fd = t->priv;
+
+	if (fd == NULL)
+		return;
+	if (*fd >= 0)
+		close(*fd);
+	free(fd);
+}
+
+/*
+ * Stop the loopback sink
+ *
+ * @cfg [in]: configuration
+ */
+static void
+tcp_fini(struct gen_config *cfg)
+{
+	int i;
+
+	(void)cfg;
+	if (listen_fd < 0)
+		return;
+	/* Wakes up receivers whose sender never connected */
+	shutdown(listen_fd, SHUT_RDWR);
+	for (i = 0; i < nb_sinks; i++)
+		pthread_join(sink_tids[i], NULL);
+	close(listen_fd);
+	listen_fd = -1;
+}
+
+/*
+ * Connection thread of tcp_sink_main()
+ *
+ * @arg [in]: connected socket
+ * @return: NULL
+ */
+static void *
+remote_sink(void *arg)
+{
+	drain((int)(intptr_t)arg);
+	return NULL;
+}
+
+int
+tcp_sink_main(int port)
+{
+	struct sockaddr_in6 addr = {.sin6_family = AF_INET6, .sin6_addr = IN6ADDR_ANY_INIT};
+	pthread_t tid;
+	int fd, on = 1;
+
+	addr.sin6_port = htons(port);
+	listen_fd = socket(AF_INET6, SOCK_STREAM, 0);
+	if (listen_fd < 0 || setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on)) != 0 ||
+	    bind(listen_fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(listen_fd, GEN_MAX_THREADS) != 0) {
+		perror("Failed to listen");
+		return -1;
+	}
+	printf("tcp_sink listening on port %d\n", port);
+	fflush(stdout);
+
+	while (!gen_stop) {
+		fd = accept(listen_fd, NULL, NULL);
+		if (fd < 0) {
+			if (errno == EINTR)
+				continue;
+			perror("Failed to accept");
+			break;
+		}
+		if (pthread_create(&tid, NULL, remote_sink, (void *)(intptr_t)fd) != 0) {
+			close(fd);
+			continue;
+		}
+		pthread_detach(tid);
+	}
+	close(listen_fd);
+	return 0;
+}
+
+const struct generator gen_tcp = {
+	.name = "tcp",
+	.description = "One TCP stream per thread to a loopback receiver on the same core, or to -a host:port",
+	.init = tcp_init,
+	.setup = tcp_setup,
+	.run = tcp_run,
+	.cleanup = tcp_cleanup,
+	.fini = tcp_fini,
+};
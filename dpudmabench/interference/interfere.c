@@ -0,0 +1,309 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <getopt.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "interfere.h"
+
+#define DEFAULT_SINK_PORT 7007	/* Port of tcp_sink */
+
+volatile sig_atomic_t gen_stop;
+
+static const struct generator *const generators[] = {&gen_stream, &gen_tcp, &gen_hash};
+#define NB_GENERATORS (sizeof(generators) / sizeof(generators[0]))
+
+static pthread_barrier_t setup_barrier;	/* Every thread finished its setup */
+static pthread_barrier_t start_barrier;	/* The launcher checked the setups */
+static int setup_failed;
+
+/*
+ * Current CLOCK_MONOTONIC time
+ *
+ * @return: time in nanoseconds
+ */
+static uint64_t
+now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/*
+ * SIGINT and SIGTERM handler
+ *
+ * @signum [in]: signal number
+ */
+static void
+stop_handler(int signum)
+{
+	(void)signum;
+	gen_stop = 1;
+}
+
+/*
+ * Parse a core list such as "0-3,6"
+ *
+ * @list [in]: core list
+ * @cfg [out]: cores and nb_threads
+ * @return: 0 on success and -1 otherwise
+ */
+static int
+parse_cores(const char *list, struct gen_config *cfg)
+{
+	const char *p = list;
+	char *end;
+	long first, last, c;
+
+	cfg->nb_threads = 0;
+	while (*p != '\0') {
+		first = strtol(p, &end, 10);
+		if (end == p || first < 0)
+			return -1;
+		last = first;
+		if (*end == '-') {
+			p = end + 1;
+			last = strtol(p, &end, 10);
+			if (end == p || last < first)
+				return -1;
+		}
+		for (c = first; c <= last; c++) {
+			if (cfg->nb_threads == GEN_MAX_THREADS || c >= CPU_SETSIZE)
+				return -1;
+			cfg->cores[cfg->nb_threads++] = c;
+		}
+		if (*end == ',')
+			end++;
+		else if (*end != '\0')
+			return -1;
+		p = end;
+	}
+	return cfg->nb_threads > 0 ? 0 : -1;
+}
+
+/*
+ * Generator thread: pin, set up, wait for the others, run the load
+ *
+ * @arg [in]: generator thread
+ * @return: NULL
+ */
+static void *
+thread_main(void *arg)
+{
+	struct gen_thread *t = arg;
+	const struct generator *gen = t->cfg->gen;
+	cpu_set_t set;
+
+	CPU_ZERO(&set);
+	CPU_SET(t->core, &set);
+	if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+		fprintf(stderr, "Failed to pin thread %d to core %d\n", t->id, t->core);
+		t->ret = -1;
+	}
+	if (t->ret == 0)
+		t->ret = gen->setup(t);
+	if (t->ret != 0)
+		__atomic_store_n(&setup_failed, 1, __ATOMIC_RELAXED);
+
+	pthread_barrier_wait(&setup_barrier);
+	pthread_barrier_wait(&start_barrier);
+	if (t->ret == 0 && !gen_stop)
+		gen->run(t);
+	return NULL;
+}
+
+/*
+ * Print command line usage
+ *
+ * @prog [in]: program name
+ */
+static void
+usage(const char *prog)
+{
+	size_t i;
+
+	printf("Usage: %s -k <load> [-c cores] [-s seconds] [-m MB] [-z key size] [-a host:port]\n", prog);
+	printf("       %s -k tcp_sink [-P port]\n", prog);
+	printf("Runs a background load on the given cores until the time is up or SIGTERM/SIGINT arrives.\n");
+	printf("Prints READY once every thread is set up, then at the end\n");
+	printf("INTERFERER <load> <threads> <seconds> <GB/s> <Mops>\n");
+	for (i = 0; i < NB_GENERATORS; i++)
+		printf("  %-8s %s\n", generators[i]->name, generators[i]->description);
+	printf("  %-8s %s\n", "tcp_sink", "Receive and discard tcp load from other machines");
+	printf("  -c, --cores <list>       cores, one thread each, e.g. 0-3,6 (default: 0)\n");
+	printf("  -s, --duration <s>       run length, 0 until signalled (default: 0)\n");
+	printf("  -m, --mem <MB>           working set per thread (default: stream 96, hash 1)\n");
+	printf("  -z, --key-size <bytes>   hash key size (default: 64)\n");
+	printf("  -a, --target <host:port> tcp_sink to stream to (default: loopback receiver per thread)\n");
+	printf("  -P, --port <port>        tcp_sink port (default: %d)\n", DEFAULT_SINK_PORT);
+}
+
+/*
+ * Background load generator main function
+ *
+ * @argc [in]: command line arguments size
+ * @argv [in]: array of command line arguments
+ * @return: EXIT_SUCCESS on success and EXIT_FAILURE otherwise
+ */
+int
+main(int argc, char **argv)
+{
+	static const struct option long_opts[] = {
+		{"kind", required_argument, NULL, 'k'},
+		{"cores", required_argument, NULL, 'c'},
+		{"duration", required_argument, NULL, 's'},
+		{"mem", required_argument, NULL, 'm'},
+		{"key-size", required_argument, NULL, 'z'},
+		{"target", required_argument, NULL, 'a'},
+		{"port", required_argument, NULL, 'P'},
+		{"help", no_argument, NULL, 'h'},
+		{NULL, 0, NULL, 0},
+	};
+	struct sigaction sa = {.sa_handler = stop_handler};
+	struct gen_config cfg = {0};
+	struct gen_thread *threads;
+	const char *kind = NULL, *cores = "0";
+	int c, i, started = 0, port = DEFAULT_SINK_PORT, exit_status = EXIT_FAILURE;
+	uint64_t start, end, bytes = 0, ops = 0;
+	struct timespec tick = {0, 1000000};
+	double secs;
+	size_t g;
+
+	while ((c = getopt_long(argc, argv, "k:c:s:m:z:a:P:h", long_opts, NULL)) != -1) {
+		switch (c) {
+		case 'k':
+			kind = optarg;
+			break;
+		case 'c':
+			cores = optarg;
+			break;
+		case 's':
+			cfg.duration_s = strtoul(optarg, NULL, 0);
+			break;
+		case 'm':
+			cfg.mem_size = strtoull(optarg, NULL, 0) << 20;
+			break;
+		case 'z':
+			cfg.key_size = strtoull(optarg, NULL, 0);
+			break;
+		case 'a':
+			snprintf(cfg.target, sizeof(cfg.target), "%s", optarg);
+			break;
+		case 'P':
+			port = atoi(optarg);
+			break;
+		case 'h':
+			usage(argv[0]);
+			return EXIT_SUCCESS;
+		default:
+			usage(argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+	if (kind == NULL) {
+		usage(argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	/* No SA_RESTART, so a blocking send() or accept() returns and the loop sees gen_stop */
+	sigemptyset(&sa.sa_mask);
+	sigaction(SIGINT, &sa, NULL);
+	sigaction(SIGTERM, &sa, NULL);
+
+	if (strcmp(kind, "tcp_sink") == 0)
+		return tcp_sink_main(port) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+
+	for (g = 0; g < NB_GENERATORS && strcmp(generators[g]->name, kind) != 0; g++)
+		;
+	if (g == NB_GENERATORS) {
+		fprintf(stderr, "Unknown load %s\n", kind);
+		return EXIT_FAILURE;
+	}
+	cfg.gen = generators[g];
+	if (parse_cores(cores, &cfg) != 0) {
+		fprintf(stderr, "Invalid core list %s\n", cores);
+		return EXIT_FAILURE;
+	}
+
+	threads = aligned_alloc(GEN_CACHE_LINE, sizeof(*threads) * cfg.nb_threads);
+	if (threads == NULL)
+		return EXIT_FAILURE;
+	memset(threads, 0, sizeof(*threads) * cfg.nb_threads);
+	if (cfg.gen->init != NULL && cfg.gen->init(&cfg) != 0)
+		goto fini;
+
+	pthread_barrier_init(&setup_barrier, NULL, cfg.nb_threads + 1);
+	pthread_barrier_init(&start_barrier, NULL, cfg.nb_threads + 1);
+	for (started = 0; started < cfg.nb_threads; started++) {
+		threads[started].id = started;
+		threads[started].core = cfg.cores[started];
+		threads[started].cfg = &cfg;
+		if (pthread_create(&threads[started].tid, NULL, thread_main, &threads[started]) != 0) {
+			fprintf(stderr, "Failed to start thread %d\n", started);
+			/* Threads already started wait at barriers sized for all of them, so give up here */
+			exit(EXIT_FAILURE);
+		}
+	}
+
+	pthread_barrier_wait(&setup_barrier);
+	if (setup_failed)
+		gen_stop = 1;
+	start = now_ns();
+	pthread_barrier_wait(&start_barrier);
+	if (!setup_failed) {
+		printf("READY %s %d\n", cfg.gen->name, cfg.nb_threads);
+		fflush(stdout);
+	}
+
+	while (!gen_stop) {
+		if (cfg.duration_s != 0 && now_ns() - start >= cfg.duration_s * 1000000000ULL)
+			gen_stop = 1;
+		else
+			nanosleep(&tick, NULL);
+	}
+
+	/* Loads finish their current pass before they see gen_stop, so the window ends after the joins */
+	for (i = 0; i < started; i++)
+		pthread_join(threads[i].tid, NULL);
+	end = now_ns();
+	pthread_barrier_destroy(&setup_barrier);
+	pthread_barrier_destroy(&start_barrier);
+
+	exit_status = EXIT_SUCCESS;
+	for (i = 0; i < started; i++) {
+		if (threads[i].ret != 0)
+			exit_status = EXIT_FAILURE;
+		bytes += threads[i].bytes;
+		ops += threads[i].ops;
+		cfg.gen->cleanup(&threads[i]);
+	}
+	if (exit_status == EXIT_SUCCESS) {
+		secs = (end - start) / 1e9;
+		printf("%s on %d cores: %.3f GB/s, %.3f Mops over %.2f s\n", cfg.gen->name, cfg.nb_threads,
+		       bytes / secs / 1e9, ops / secs / 1e6, secs);
+		printf("INTERFERER %s %d %.3f %.3f %.3f\n", cfg.gen->name, cfg.nb_threads, secs, bytes / secs / 1e9,
+		       ops / secs / 1e6);
+	}
+
+fini:
+	if (cfg.gen->fini != NULL)
+		cfg.gen->fini(&cfg);
+	free(threads);
+	return exit_status;
+}
@@ -0,0 +1,73 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+#ifndef INTERFERE_H_
+#define INTERFERE_H_
+
+#include <signal.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <pthread.h>
+
+#define GEN_MAX_THREADS 64		/* Largest number of generator threads */
+#define GEN_TARGET_SIZE 256		/* Maximum size of a host:port target */
+#define GEN_CACHE_LINE 64		/* Counters of different threads never share a line */
+
+/* Generator configuration, from the command line */
+struct gen_config {
+	const struct generator *gen;		/* Selected generator */
+	int cores[GEN_MAX_THREADS];		/* Core of every thread */
+	int nb_threads;				/* Number of threads, one per core */
+	uint32_t duration_s;			/* Run length, 0 to run until SIGTERM or SIGINT */
+	size_t mem_size;			/* Working set per thread in bytes, 0 for the generator default */
+	size_t key_size;			/* Hash key size */
+	char target[GEN_TARGET_SIZE];		/* host:port of a remote tcp_sink, empty for loopback */
+};
+
+/* State of one generator thread */
+struct gen_thread {
+	pthread_t tid;				/* Thread handle */
+	int id;					/* Thread index */
+	int core;				/* Core the thread is pinned to */
+	const struct gen_config *cfg;		/* Configuration */
+	void *priv;				/* Generator state of the thread */
+	int ret;				/* 0 on success and -1 otherwise */
+	uint64_t bytes __attribute__((aligned(GEN_CACHE_LINE)));	/* Bytes moved, updated by the thread only */
+	uint64_t ops;				/* Operations done, updated by the thread only */
+};
+
+/* One background load */
+struct generator {
+	const char *name;			/* Name given to -k */
+	const char *description;		/* Help text */
+	int (*init)(struct gen_config *cfg);	/* Process-wide setup before the threads start, may be NULL */
+	int (*setup)(struct gen_thread *t);	/* Per-thread setup on the pinned core, before the start barrier */
+	void (*run)(struct gen_thread *t);	/* Load loop, returns once gen_stop is set */
+	void (*cleanup)(struct gen_thread *t);	/* Per-thread cleanup, called even if setup failed */
+	void (*fini)(struct gen_config *cfg);	/* Process-wide cleanup, may be NULL */
+};
+
+/* Set by the signal handler or the timer, load loops poll it */
+extern volatile sig_atomic_t gen_stop;
+
+extern const struct generator gen_stream;
+extern const struct generator gen_tcp;
+extern const struct generator gen_hash;
+
+/*
+ * Accept tcp generator connections on a port and discard their data, until SIGTERM or SIGINT
+ *
+ * @port [in]: TCP port
+ * @return: 0 on success and -1 otherwise
+ */
+int tcp_sink_main(int port);
+
+#endif
@@ -0,0 +1,307 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "rdma_common.h"
+
+/*
+ * Elapsed time between two timestamps
+ *
+ * @start [in]: start timestamp
+ * @end [in]: end timestamp
+ * @return: elapsed time in nanoseconds
+ */
+static double
+elapsed_ns(const struct timespec *start, const struct timespec *end)
+{
+	return (end->tv_sec - start->tv_sec) * 1e9 + (end->tv_nsec - start->tv_nsec);
+}
+
+/*
+ * Print one sweep record, the input format of dpudmabench/crossover/transport_select
+ *
+ * @cfg [in]: benchmark configuration
+ * @len [in]: payload length
+ * @lat_us [in]: average latency in microseconds, negative if not measured
+ * @mops [in]: throughput in Mops, negative if not measured
+ */
+static void
+print_record(const struct rdma_config *cfg, size_t len, double lat_us, double mops)
+{
+	static const char *const transports[] = {"rdma_read", "rdma_write", "rdma_send", "rdma_ud_send"};
+
+	if (!cfg->record)
+		return;
+
+	/* Run from the DPU, a Read pulls host data and every other operation pushes it */
+	printf("RECORD %s %s %zu ", cfg->op == RDMA_OP_READ ? "pull" : "push", transports[cfg->op], len);
+	if (lat_us < 0)
+		printf("- ");
+	else
+		printf("%.3f ", lat_us);
+	if (mops < 0)
+		printf("- -\n");
+	else
+		printf("%.4f %.3f\n", mops, mops * len / 1000);
+}
+
+/*
+ * Print latency statistics in the same layout as the DMA latency benchmarks
+ *
+ * @cfg [in]: benchmark configuration
+ * @len [in]: payload length
+ * @times [in]: per-operation latency in nanoseconds
+ * @n [in]: number of samples
+ */
+static void
+report_latency(const struct rdma_config *cfg, size_t len, const double *times, int n)
+{
+	double min_t = times[0], max_t = times[0], mean_t = 0, std_dev = 0;
+	int i;
+
+	for (i = 0; i < n; i++) {
+		mean_t += times[i];
+		if (times[i] < min_t)
+			min_t = times[i];
+		if (times[i] > max_t)
+			max_t = times[i];
+	}
+	mean_t /= n;
+	for (i = 0; i < n; i++)
+		std_dev += pow(times[i] - mean_t, 2);
+	std_dev = sqrt(std_dev / n);
+
+	printf("Blocking %s, dst_buffer_size: %zu\n", rdma_op_name(cfg->op), len);
+	printf("Min time(us)\t Avg Lat(us)\t Max time(us)\t Std dev(us)\n");
+	printf("%.2f\t %13.2f\t %13.2f\t %13.2f\n", min_t / 1000, mean_t / 1000, max_t / 1000, std_dev / 1000);
+	print_record(cfg, len, mean_t / 1000, -1);
+}
+
+/*
+ * Measure per-operation completion latency (post one signaled WR, poll its completion)
+ *
+ * @cfg [in]: benchmark configuration
+ * @res [in]: verbs objects
+ * @len [in]: payload length
+ * @return: 0 on success and -1 otherwise
+ */
+static int
+run_latency(const struct rdma_config *cfg, struct rdma_resources *res, size_t len)
+{
+	struct timespec start, end;
+	struct ibv_wc wc;
+	double *times;
+	int i;
+
+	times = calloc(cfg->iterations, sizeof(*times));
+	if (times == NULL)
+		return -1;
+
+	for (i = 0; i < cfg->iterations; i++) {
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		if (rdma_post_op(cfg, res, len, true) != 0 || rdma_poll(res->send_cq, &wc, 1) < 0) {
+			fprintf(stderr, "Operation %d failed\n", i);
+			free(times);
+			return -1;
+		}
+		clock_gettime(CLOCK_MONOTONIC, &end);
+		times[i] = elapsed_ns(&start, &end);
+	}
+
+	report_latency(cfg, len, times, cfg->iterations);
+	free(times);
+	return 0;
+}
+
+/*
+ * Measure throughput keeping tx_depth operations outstanding
+ *
+ * @cfg [in]: benchmark configuration
+ * @res [in]: verbs objects
+ * @len [in]: payload length
+ * @return: 0 on success and -1 otherwise
+ */
+static int
+run_throughput(const struct rdma_config *cfg, struct rdma_resources *res, size_t len)
+{
+	struct ibv_wc wc[DEFAULT_TX_DEPTH];
+	struct timespec start, end;
+	int posted = 0, completed = 0, n;
+	double ns, mops;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	while (completed < cfg->iterations) {
+		while (posted < cfg->iterations && posted - completed < cfg->tx_depth) {
+			if (rdma_post_op(cfg, res, len, true) != 0) {
+				fprintf(stderr, "Failed to post operation %d\n", posted);
+				return -1;
+			}
+			posted++;
+		}
+		n = rdma_poll(res->send_cq, wc, DEFAULT_TX_DEPTH);
+		if (n < 0)
+			return -1;
+		completed += n;
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	ns = elapsed_ns(&start, &end);
+	mops = (double)completed / ns * 1000;
+	printf("Iteration %d, dst_buffer_size: %zu\n", cfg->iterations, len);
+	printf("Average %s (polling) throughput (Mops) = %.3f\n", rdma_op_name(cfg->op), mops);
+	printf("Average %s (polling) bandwidth (GB/s) = %.3f\n", rdma_op_name(cfg->op), mops * len / 1000);
+	print_record(cfg, len, -1, mops);
+	return 0;
+}
+
+/*
+ * Passive side of Send/Recv: keep receives posted until the client signals the end of the run
+ *
+ * @cfg [in]: benchmark configuration
+ * @res [in]: verbs objects
+ * @len [in]: payload length
+ * @return: 0 on success and -1 otherwise
+ */
+static int
+serve_receives(const struct rdma_config *cfg, struct rdma_resources *res, size_t len)
+{
+	struct ibv_wc wc[DEFAULT_RX_DEPTH];
+	unsigned long received = 0;
+	ssize_t ret;
+	char token;
+	int i, n;
+
+	/* The receive queue was filled by rdma_bench(), let the client start */
+	if (rdma_sync(res) != 0)
+		return -1;
+
+	for (;;) {
+		n = ibv_poll_cq(res->recv_cq, DEFAULT_RX_DEPTH, wc);
+		if (n < 0)
+			return -1;
+		for (i = 0; i < n; i++) {
+			if (wc[i].status != IBV_WC_SUCCESS && wc[i].status != IBV_WC_WR_FLUSH_ERR) {
+				fprintf(stderr, "Receive failed: %s\n", ibv_wc_status_str(wc[i].status));
+				return -1;
+			}
+			if (rdma_post_recv(res) != 0)
+				return -1;
+		}
+		received += n;
+
+		ret = recv(res->sockfd, &token, 1, MSG_DONTWAIT);
+		if (ret == 1)
+			break;
+		if (ret == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+			perror("Lost connection to the client");
+			return -1;
+		}
+	}
+
+	printf("Received %lu messages of %zu bytes\n", received, len);
+	token = 'e';
+	if (write(res->sockfd, &token, 1) != 1)
+		return -1;
+	return 0;
+}
+
+/*
+ * Run the benchmark for one payload size on either side
+ *
+ * @cfg [in]: benchmark configuration
+ * @res [in]: verbs objects
+ * @len [in]: payload length
+ * @return: 0 on success and -1 otherwise
+ */
+static int
+run_one_size(const struct rdma_config *cfg, struct rdma_resources *res, size_t len)
+{
+	bool is_client = cfg->server_addr[0] != '\0';
+	bool is_send = cfg->op == RDMA_OP_SEND || cfg->op == RDMA_OP_UD_SEND;
+	int ret;
+
+	if (!is_client) {
+		if (is_send)
+			return serve_receives(cfg, res, len);
+		/* One-sided: nothing to do until the client is finished */
+		if (rdma_sync(res) != 0)
+			return -1;
+		return rdma_sync(res);
+	}
+
+	if (rdma_sync(res) != 0)
+		return -1;
+
+	if (cfg->test == RDMA_TEST_LAT)
+		ret = run_latency(cfg, res, len);
+	else
+		ret = run_throughput(cfg, res, len);
+	fflush(stdout);
+	if (ret != 0)
+		return ret;
+
+	return rdma_sync(res);
+}
+
+/*
+ * Run RDMA benchmark between the DPU and its host
+ *
+ * @cfg [in]: benchmark configuration
+ * @return: 0 on success and -1 otherwise
+ */
+int
+rdma_bench(const struct rdma_config *cfg)
+{
+	struct rdma_resources res;
+	size_t len;
+	int ret = 0;
+
+	if (rdma_create_resources(cfg, &res) != 0)
+		return -1;
+
+	printf("%s %s on %s port %d, GID index %d\n", rdma_op_name(cfg->op),
+	       cfg->test == RDMA_TEST_LAT ? "latency" : "throughput",
+	       ibv_get_device_name(res.ctx->device), cfg->ib_port, cfg->gid_index);
+
+	if (rdma_connect(cfg, &res) != 0) {
+		rdma_destroy_resources(&res);
+		return -1;
+	}
+
+	/* Receives always cover the whole buffer, so they are posted once for every size */
+	if (cfg->server_addr[0] == '\0' && (cfg->op == RDMA_OP_SEND || cfg->op == RDMA_OP_UD_SEND)) {
+		for (int i = 0; i < DEFAULT_RX_DEPTH; i++) {
+			if (rdma_post_recv(&res) != 0) {
+				fprintf(stderr, "Failed to post receive\n");
+				rdma_destroy_resources(&res);
+				return -1;
+			}
+		}
+	}
+
+	if (cfg->sweep) {
+		for (len = 2; len <= cfg->length && ret == 0; len *= 2)
+			ret = run_one_size(cfg, &res, len);
+	} else {
+		ret = run_one_size(cfg, &res, cfg->length);
+	}
+
+	rdma_destroy_resources(&res);
+	return ret;
+}
@@ -0,0 +1,148 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "rdma_common.h"
+
+/* Benchmark logic */
+int rdma_bench(const struct rdma_config *cfg);
+
+/*
+ * Print command line usage
+ *
+ * @prog [in]: program name
+ */
+static void
+usage(const char *prog)
+{
+	printf("Usage: %s [options] [server address]\n", prog);
+	printf("  -d, --ib-dev <name>      IB device name (default: first device, e.g. mlx5_0 or rxe0)\n");
+	printf("  -i, --ib-port <port>     IB port number (default: 1)\n");
+	printf("  -g, --gid-index <index>  GID index for RoCE/rdma_rxe (default: 0)\n");
+	printf("  -o, --op <op>            read | write | send | ud_send (default: read)\n");
+	printf("  -t, --test <test>        lat | thr (default: lat)\n");
+	printf("  -s, --size <bytes>       payload size (default: 4096)\n");
+	printf("  -n, --iters <num>        number of measured operations (default: 5000)\n");
+	printf("  -q, --tx-depth <num>     outstanding operations in throughput mode (default: %d)\n",
+	       DEFAULT_TX_DEPTH);
+	printf("  -a, --all                sweep sizes 2 .. <size> in powers of two\n");
+	printf("  -R, --record             also print RECORD lines for the crossover finder\n");
+	printf("  -P, --port <port>        TCP port for the connection exchange (default: %d)\n",
+	       DEFAULT_TCP_PORT);
+	printf("Run without a server address on the passive side and with it on the initiator.\n");
+}
+
+/*
+ * Benchmark main function
+ *
+ * @argc [in]: command line arguments size
+ * @argv [in]: array of command line arguments
+ * @return: EXIT_SUCCESS on success and EXIT_FAILURE otherwise
+ */
+int
+main(int argc, char **argv)
+{
+	static const struct option long_opts[] = {
+		{"ib-dev", required_argument, NULL, 'd'},
+		{"ib-port", required_argument, NULL, 'i'},
+		{"gid-index", required_argument, NULL, 'g'},
+		{"op", required_argument, NULL, 'o'},
+		{"test", required_argument, NULL, 't'},
+		{"size", required_argument, NULL, 's'},
+		{"iters", required_argument, NULL, 'n'},
+		{"tx-depth", required_argument, NULL, 'q'},
+		{"all", no_argument, NULL, 'a'},
+		{"record", no_argument, NULL, 'R'},
+		{"port", required_argument, NULL, 'P'},
+		{"help", no_argument, NULL, 'h'},
+		{NULL, 0, NULL, 0},
+	};
+	struct rdma_config cfg = {0};
+	int c;
+
+	/* Set the default configuration values */
+	cfg.ib_port = 1;
+	cfg.gid_index = 0;
+	cfg.tcp_port = DEFAULT_TCP_PORT;
+	cfg.op = RDMA_OP_READ;
+	cfg.test = RDMA_TEST_LAT;
+	cfg.length = 4096;
+	cfg.iterations = 5000;
+	cfg.tx_depth = DEFAULT_TX_DEPTH;
+
+	while ((c = getopt_long(argc, argv, "d:i:g:o:t:s:n:q:aRP:h", long_opts, NULL)) != -1) {
+		switch (c) {
+		case 'd':
+			strncpy(cfg.ib_devname, optarg, MAX_ARG_SIZE - 1);
+			break;
+		case 'i':
+			cfg.ib_port = atoi(optarg);
+			break;
+		case 'g':
+			cfg.gid_index = atoi(optarg);
+			break;
+		case 'o':
+			if (rdma_parse_op(optarg, &cfg.op) != 0) {
+				fprintf(stderr, "Unknown operation %s\n", optarg);
+				return EXIT_FAILURE;
+			}
+			break;
+		case 't':
+			if (strcmp(optarg, "lat") == 0)
+				cfg.test = RDMA_TEST_LAT;
+			else if (strcmp(optarg, "thr") == 0)
+				cfg.test = RDMA_TEST_THR;
+			else {
+				fprintf(stderr, "Unknown test %s\n", optarg);
+				return EXIT_FAILURE;
+			}
+			break;
+		case 's':
+			cfg.length = strtoull(optarg, NULL, 0);
+			break;
+		case 'n':
+			cfg.iterations = atoi(optarg);
+			break;
+		case 'q':
+			cfg.tx_depth = atoi(optarg);
+			break;
+		case 'a':
+			cfg.sweep = true;
+			break;
+		case 'R':
+			cfg.record = true;
+			break;
+		case 'P':
+			cfg.tcp_port = atoi(optarg);
+			break;
+		case 'h':
+			usage(argv[0]);
+			return EXIT_SUCCESS;
+		default:
+			usage(argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (optind < argc)
+		strncpy(cfg.server_addr, argv[optind], MAX_ARG_SIZE - 1);
+
+	if (cfg.length < 1 || cfg.iterations < 1 || cfg.tx_depth < 1) {
+		fprintf(stderr, "Size, iterations and tx depth must be positive\n");
+		return EXIT_FAILURE;
+	}
+
+	return rdma_bench(&cfg) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
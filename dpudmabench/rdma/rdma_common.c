@@ -0,0 +1,469 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "rdma_common.h"
+
+int
+rdma_parse_op(const char *str, enum rdma_op *op)
+{
+	if (strcmp(str, "read") == 0)
+		*op = RDMA_OP_READ;
+	else if (strcmp(str, "write") == 0)
+		*op = RDMA_OP_WRITE;
+	else if (strcmp(str, "send") == 0)
+		*op = RDMA_OP_SEND;
+	else if (strcmp(str, "ud_send") == 0)
+		*op = RDMA_OP_UD_SEND;
+	else
+		return -1;
+	return 0;
+}
+
+const char *
+rdma_op_name(enum rdma_op op)
+{
+	switch (op) {
+	case RDMA_OP_READ:
+		return "RDMA Read";
+	case RDMA_OP_WRITE:
+		return "RDMA Write";
+	case RDMA_OP_SEND:
+		return "RDMA Send/Recv";
+	case RDMA_OP_UD_SEND:
+		return "RDMA UD Send/Recv";
+	}
+	return "unknown";
+}
+
+/*
+ * Open an IB device by name, or the first device when name is empty
+ *
+ * @name [in]: IB device name
+ * @return: device context, NULL if not found
+ */
+static struct ibv_context *
+open_ib_device(const char *name)
+{
+	struct ibv_device **dev_list;
+	struct ibv_context *ctx = NULL;
+	int i, nb_devs;
+
+	dev_list = ibv_get_device_list(&nb_devs);
+	if (dev_list == NULL) {
+		perror("Failed to get IB device list");
+		return NULL;
+	}
+
+	for (i = 0; i < nb_devs; i++) {
+		if (name[0] != '\0' && strcmp(ibv_get_device_name(dev_list[i]), name) != 0)
+			continue;
+		ctx = ibv_open_device(dev_list[i]);
+		break;
+	}
+
+	if (ctx == NULL)
+		fprintf(stderr, "IB device %s not found\n", name[0] != '\0' ? name : "(any)");
+
+	ibv_free_device_list(dev_list);
+	return ctx;
+}
+
+int
+rdma_create_resources(const struct rdma_config *cfg, struct rdma_resources *res)
+{
+	struct ibv_qp_init_attr qp_init_attr = {0};
+	struct ibv_qp_attr attr = {0};
+	int access = IBV_ACCESS_LOCAL_WRITE | IBV_ACCESS_REMOTE_READ | IBV_ACCESS_REMOTE_WRITE;
+	bool is_ud = cfg->op == RDMA_OP_UD_SEND;
+	int flags;
+
+	memset(res, 0, sizeof(*res));
+	res->sockfd = -1;
+
+	res->ctx = open_ib_device(cfg->ib_devname);
+	if (res->ctx == NULL)
+		return -1;
+
+	if (ibv_query_port(res->ctx, cfg->ib_port, &res->port_attr) != 0) {
+		fprintf(stderr, "Failed to query port %d\n", cfg->ib_port);
+		goto destroy;
+	}
+
+	if (is_ud && cfg->length > (size_t)(128 << res->port_attr.active_mtu)) {
+		fprintf(stderr, "UD payload %zu exceeds the active MTU %d\n", cfg->length,
+			128 << res->port_attr.active_mtu);
+		goto destroy;
+	}
+
+	res->pd = ibv_alloc_pd(res->ctx);
+	if (res->pd == NULL) {
+		fprintf(stderr, "Failed to allocate PD\n");
+		goto destroy;
+	}
+
+	/* UD receives land after a 40-byte GRH */
+	res->buf_size = cfg->length + (is_ud ? UD_GRH_SIZE : 0);
+	if (posix_memalign((void **)&res->buf, sysconf(_SC_PAGESIZE), res->buf_size) != 0) {
+		fprintf(stderr, "Failed to allocate payload buffer\n");
+		res->buf = NULL;
+		goto destroy;
+	}
+	memset(res->buf, '1', res->buf_size);
+
+	res->mr = ibv_reg_mr(res->pd, res->buf, res->buf_size, access);
+	if (res->mr == NULL) {
+		fprintf(stderr, "Failed to register MR\n");
+		goto destroy;
+	}
+
+	res->send_cq = ibv_create_cq(res->ctx, cfg->tx_depth, NULL, NULL, 0);
+	res->recv_cq = ibv_create_cq(res->ctx, DEFAULT_RX_DEPTH, NULL, NULL, 0);
+	if (res->send_cq == NULL || res->recv_cq == NULL) {
+		fprintf(stderr, "Failed to create CQs\n");
+		goto destroy;
+	}
+
+	qp_init_attr.send_cq = res->send_cq;
+	qp_init_attr.recv_cq = res->recv_cq;
+	qp_init_attr.qp_type = is_ud ? IBV_QPT_UD : IBV_QPT_RC;
+	qp_init_attr.cap.max_send_wr = cfg->tx_depth;
+	qp_init_attr.cap.max_recv_wr = DEFAULT_RX_DEPTH;
+	qp_init_attr.cap.max_send_sge = 1;
+	qp_init_attr.cap.max_recv_sge = 1;
+	res->qp = ibv_create_qp(res->pd, &qp_init_attr);
+	if (res->qp == NULL) {
+		fprintf(stderr, "Failed to create QP\n");
+		goto destroy;
+	}
+
+	attr.qp_state = IBV_QPS_INIT;
+	attr.pkey_index = 0;
+	attr.port_num = cfg->ib_port;
+	if (is_ud) {
+		attr.qkey = UD_QKEY;
+		flags = IBV_QP_STATE | IBV_QP_PKEY_INDEX | IBV_QP_PORT | IBV_QP_QKEY;
+	} else {
+		attr.qp_access_flags = access;
+		flags = IBV_QP_STATE | IBV_QP_PKEY_INDEX | IBV_QP_PORT | IBV_QP_ACCESS_FLAGS;
+	}
+	if (ibv_modify_qp(res->qp, &attr, flags) != 0) {
+		fprintf(stderr, "Failed to modify QP to INIT\n");
+		goto destroy;
+	}
+
+	res->local.qpn = res->qp->qp_num;
+	res->local.psn = lrand48() & 0xffffff;
+	res->local.rkey = res->mr->rkey;
+	res->local.addr = (uintptr_t)res->buf;
+	res->local.lid = res->port_attr.lid;
+	if (ibv_query_gid(res->ctx, cfg->ib_port, cfg->gid_index, &res->local.gid) != 0) {
+		fprintf(stderr, "Failed to query GID index %d\n", cfg->gid_index);
+		goto destroy;
+	}
+
+	return 0;
+
+destroy:
+	rdma_destroy_resources(res);
+	return -1;
+}
+
+void
+rdma_destroy_resources(struct rdma_resources *res)
+{
+	if (res->ah != NULL)
+		ibv_destroy_ah(res->ah);
+	if (res->qp != NULL)
+		ibv_destroy_qp(res->qp);
+	if (res->send_cq != NULL)
+		ibv_destroy_cq(res->send_cq);
+	if (res->recv_cq != NULL)
+		ibv_destroy_cq(res->recv_cq);
+	if (res->mr != NULL)
+		ibv_dereg_mr(res->mr);
+	free(res->buf);
+	if (res->pd != NULL)
+		ibv_dealloc_pd(res->pd);
+	if (res->ctx != NULL)
+		ibv_close_device(res->ctx);
+	if (res->sockfd >= 0)
+		close(res->sockfd);
+	memset(res, 0, sizeof(*res));
+	res->sockfd = -1;
+}
+
+/*
+ * Open the out-of-band TCP connection (listen on the server, connect on the client)
+ *
+ * @cfg [in]: benchmark configuration
+ * @return: connected socket, -1 on failure
+ */
+static int
+oob_connect(const struct rdma_config *cfg)
+{
+	struct addrinfo hints = {.ai_family = AF_INET, .ai_socktype = SOCK_STREAM};
+	struct addrinfo *ai;
+	char port[16];
+	int fd, listen_fd, one = 1;
+
+	snprintf(port, sizeof(port), "%d", cfg->tcp_port);
+
+	if (cfg->server_addr[0] != '\0') {
+		if (getaddrinfo(cfg->server_addr, port, &hints, &ai) != 0) {
+			fprintf(stderr, "Failed to resolve %s\n", cfg->server_addr);
+			return -1;
+		}
+		fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+		if (fd >= 0 && connect(fd, ai->ai_addr, ai->ai_addrlen) != 0) {
+			close(fd);
+			fd = -1;
+		}
+		freeaddrinfo(ai);
+		if (fd < 0)
+			perror("Failed to connect to the server");
+		return fd;
+	}
+
+	hints.ai_flags = AI_PASSIVE;
+	if (getaddrinfo(NULL, port, &hints, &ai) != 0)
+		return -1;
+	listen_fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+	if (listen_fd < 0) {
+		freeaddrinfo(ai);
+		return -1;
+	}
+	setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+	if (bind(listen_fd, ai->ai_addr, ai->ai_addrlen) != 0 || listen(listen_fd, 1) != 0) {
+		perror("Failed to listen for the client");
+		freeaddrinfo(ai);
+		close(listen_fd);
+		return -1;
+	}
+	freeaddrinfo(ai);
+
+	printf("Waiting for the client on port %d\n", cfg->tcp_port);
+	fflush(stdout);
+	fd = accept(listen_fd, NULL, NULL);
+	close(listen_fd);
+	if (fd < 0)
+		perror("Failed to accept the client");
+	return fd;
+}
+
+/*
+ * Read or write exactly len bytes on a socket
+ *
+ * @fd [in]: socket
+ * @buf [in/out]: data
+ * @len [in]: number of bytes
+ * @do_write [in]: write when true, read otherwise
+ * @return: 0 on success and -1 otherwise
+ */
+static int
+oob_xfer(int fd, void *buf, size_t len, bool do_write)
+{
+	char *p = buf;
+	ssize_t n;
+
+	while (len > 0) {
+		n = do_write ? write(fd, p, len) : read(fd, p, len);
+		if (n <= 0)
+			return -1;
+		p += n;
+		len -= n;
+	}
+	return 0;
+}
+
+/*
+ * Move the QP through RTR to RTS using the remote parameters
+ *
+ * @cfg [in]: benchmark configuration
+ * @res [in/out]: verbs objects
+ * @return: 0 on success and -1 otherwise
+ */
+static int
+qp_to_rts(const struct rdma_config *cfg, struct rdma_resources *res)
+{
+	struct ibv_ah_attr ah_attr = {0};
+	struct ibv_qp_attr attr = {0};
+	bool is_ud = cfg->op == RDMA_OP_UD_SEND;
+	int flags;
+
+	ah_attr.dlid = res->remote.lid;
+	ah_attr.port_num = cfg->ib_port;
+	/* RoCE (including rdma_rxe) has no LIDs and always routes on the GID */
+	if (res->port_attr.link_layer == IBV_LINK_LAYER_ETHERNET || res->remote.lid == 0) {
+		ah_attr.is_global = 1;
+		ah_attr.grh.dgid = res->remote.gid;
+		ah_attr.grh.sgid_index = cfg->gid_index;
+		ah_attr.grh.hop_limit = 1;
+	}
+
+	attr.qp_state = IBV_QPS_RTR;
+	if (is_ud) {
+		flags = IBV_QP_STATE;
+	} else {
+		attr.path_mtu = res->port_attr.active_mtu;
+		attr.dest_qp_num = res->remote.qpn;
+		attr.rq_psn = res->remote.psn;
+		attr.max_dest_rd_atomic = 16;
+		attr.min_rnr_timer = 12;
+		attr.ah_attr = ah_attr;
+		flags = IBV_QP_STATE | IBV_QP_AV | IBV_QP_PATH_MTU | IBV_QP_DEST_QPN | IBV_QP_RQ_PSN |
+			IBV_QP_MAX_DEST_RD_ATOMIC | IBV_QP_MIN_RNR_TIMER;
+	}
+	if (ibv_modify_qp(res->qp, &attr, flags) != 0) {
+		fprintf(stderr, "Failed to modify QP to RTR\n");
+		return -1;
+	}
+
+	memset(&attr, 0, sizeof(attr));
+	attr.qp_state = IBV_QPS_RTS;
+	attr.sq_psn = res->local.psn;
+	if (is_ud) {
+		flags = IBV_QP_STATE | IBV_QP_SQ_PSN;
+	} else {
+		attr.timeout = 14;
+		attr.retry_cnt = 7;
+		attr.rnr_retry = 7;
+		attr.max_rd_atomic = 16;
+		flags = IBV_QP_STATE | IBV_QP_SQ_PSN | IBV_QP_TIMEOUT | IBV_QP_RETRY_CNT | IBV_QP_RNR_RETRY |
+			IBV_QP_MAX_QP_RD_ATOMIC;
+	}
+	if (ibv_modify_qp(res->qp, &attr, flags) != 0) {
+		fprintf(stderr, "Failed to modify QP to RTS\n");
+		return -1;
+	}
+
+	if (is_ud) {
+		res->ah = ibv_create_ah(res->pd, &ah_attr);
+		if (res->ah == NULL) {
+			fprintf(stderr, "Failed to create address handle\n");
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+int
+rdma_connect(const struct rdma_config *cfg, struct rdma_resources *res)
+{
+	res->sockfd = oob_connect(cfg);
+	if (res->sockfd < 0)
+		return -1;
+
+	if (oob_xfer(res->sockfd, &res->local, sizeof(res->local), true) != 0 ||
+	    oob_xfer(res->sockfd, &res->remote, sizeof(res->remote), false) != 0) {
+		fprintf(stderr, "Failed to exchange connection parameters\n");
+		return -1;
+	}
+
+	if (qp_to_rts(cfg, res) != 0)
+		return -1;
+
+	return rdma_sync(res);
+}
+
+int
+rdma_sync(struct rdma_resources *res)
+{
+	char token = 's';
+
+	if (oob_xfer(res->sockfd, &token, 1, true) != 0 || oob_xfer(res->sockfd, &token, 1, false) != 0) {
+		fprintf(stderr, "Failed to synchronize with the peer\n");
+		return -1;
+	}
+	return 0;
+}
+
+int
+rdma_post_recv(struct rdma_resources *res)
+{
+	struct ibv_sge sge = {
+		.addr = (uintptr_t)res->buf,
+		.length = res->buf_size,
+		.lkey = res->mr->lkey,
+	};
+	struct ibv_recv_wr wr = {.sg_list = &sge, .num_sge = 1};
+	struct ibv_recv_wr *bad_wr;
+
+	return ibv_post_recv(res->qp, &wr, &bad_wr) == 0 ? 0 : -1;
+}
+
+int
+rdma_post_op(const struct rdma_config *cfg, struct rdma_resources *res, size_t len, bool signaled)
+{
+	struct ibv_sge sge = {
+		.addr = (uintptr_t)res->buf,
+		.length = len,
+		.lkey = res->mr->lkey,
+	};
+	struct ibv_send_wr wr = {.sg_list = &sge, .num_sge = 1};
+	struct ibv_send_wr *bad_wr;
+
+	wr.send_flags = signaled ? IBV_SEND_SIGNALED : 0;
+	switch (cfg->op) {
+	case RDMA_OP_READ:
+		wr.opcode = IBV_WR_RDMA_READ;
+		wr.wr.rdma.remote_addr = res->remote.addr;
+		wr.wr.rdma.rkey = res->remote.rkey;
+		break;
+	case RDMA_OP_WRITE:
+		wr.opcode = IBV_WR_RDMA_WRITE;
+		wr.wr.rdma.remote_addr = res->remote.addr;
+		wr.wr.rdma.rkey = res->remote.rkey;
+		break;
+	case RDMA_OP_SEND:
+		wr.opcode = IBV_WR_SEND;
+		break;
+	case RDMA_OP_UD_SEND:
+		wr.opcode = IBV_WR_SEND;
+		wr.wr.ud.ah = res->ah;
+		wr.wr.ud.remote_qpn = res->remote.qpn;
+		wr.wr.ud.remote_qkey = UD_QKEY;
+		break;
+	}
+
+	return ibv_post_send(res->qp, &wr, &bad_wr) == 0 ? 0 : -1;
+}
+
+int
+rdma_poll(struct ibv_cq *cq, struct ibv_wc *wc, int max)
+{
+	int i, n;
+
+	do {
+		n = ibv_poll_cq(cq, max, wc);
+	} while (n == 0);
+
+	if (n < 0) {
+		fprintf(stderr, "Failed to poll CQ\n");
+		return -1;
+	}
+
+	for (i = 0; i < n; i++) {
+		if (wc[i].status != IBV_WC_SUCCESS) {
+			fprintf(stderr, "Work completion failed: %s\n", ibv_wc_status_str(wc[i].status));
+			return -1;
+		}
+	}
+	return n;
+}
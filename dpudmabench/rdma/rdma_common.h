@@ -0,0 +1,164 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+#ifndef RDMA_COMMON_H_
+#define RDMA_COMMON_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include <infiniband/verbs.h>
+
+#define MAX_ARG_SIZE 257		/* Maximum size of input argument */
+#define DEFAULT_TCP_PORT 18515		/* Out-of-band exchange port (same default as perftest) */
+#define DEFAULT_TX_DEPTH 128		/* Send queue depth */
+#define DEFAULT_RX_DEPTH 512		/* Receive queue depth */
+#define UD_GRH_SIZE 40			/* GRH prepended to every UD receive */
+#define UD_QKEY 0x11111111		/* Q_Key shared by both UD endpoints */
+
+/* Benchmarked RDMA operation */
+enum rdma_op {
+	RDMA_OP_READ,		/* RC RDMA Read */
+	RDMA_OP_WRITE,		/* RC RDMA Write */
+	RDMA_OP_SEND,		/* RC Send/Recv */
+	RDMA_OP_UD_SEND,	/* UD Send/Recv */
+};
+
+/* Benchmarked metric */
+enum rdma_test {
+	RDMA_TEST_LAT,		/* Per-operation completion latency */
+	RDMA_TEST_THR,		/* Pipelined throughput */
+};
+
+/* Configuration struct */
+struct rdma_config {
+	char ib_devname[MAX_ARG_SIZE];	/* IB device name (e.g. mlx5_0 or rxe0) */
+	char server_addr[MAX_ARG_SIZE];	/* Server address, empty on the server side */
+	int ib_port;			/* IB port number */
+	int gid_index;			/* GID index used on RoCE ports */
+	int tcp_port;			/* Out-of-band exchange TCP port */
+	enum rdma_op op;		/* Benchmarked operation */
+	enum rdma_test test;		/* Latency or throughput */
+	size_t length;			/* Payload size in bytes */
+	int iterations;			/* Number of measured operations */
+	int tx_depth;			/* Outstanding operations in throughput mode */
+	bool sweep;			/* Run all sizes 2..length instead of a single one */
+	bool record;			/* Also print RECORD lines for dpudmabench/crossover */
+};
+
+/* Connection parameters swapped over the out-of-band TCP socket */
+struct rdma_dest {
+	uint32_t qpn;		/* Queue pair number */
+	uint32_t psn;		/* Initial packet sequence number */
+	uint32_t rkey;		/* Remote key of the registered buffer */
+	uint64_t addr;		/* Address of the registered buffer */
+	uint16_t lid;		/* Port LID (IB only) */
+	union ibv_gid gid;	/* Port GID (RoCE) */
+};
+
+/* Verbs objects used by the benchmark */
+struct rdma_resources {
+	struct ibv_context *ctx;	/* Device context */
+	struct ibv_pd *pd;		/* Protection domain */
+	struct ibv_mr *mr;		/* Memory region covering buf */
+	struct ibv_cq *send_cq;		/* Send completion queue */
+	struct ibv_cq *recv_cq;		/* Receive completion queue */
+	struct ibv_qp *qp;		/* Queue pair (RC or UD) */
+	struct ibv_ah *ah;		/* Address handle (UD only) */
+	struct ibv_port_attr port_attr;	/* Attributes of the used port */
+	char *buf;			/* Registered payload buffer */
+	size_t buf_size;		/* Size of buf */
+	int sockfd;			/* Out-of-band socket */
+	struct rdma_dest local;		/* Local connection parameters */
+	struct rdma_dest remote;	/* Remote connection parameters */
+};
+
+/*
+ * Parse the name of an RDMA operation
+ *
+ * @str [in]: read, write, send or ud_send
+ * @op [out]: parsed operation
+ * @return: 0 on success and -1 otherwise
+ */
+int rdma_parse_op(const char *str, enum rdma_op *op);
+
+/*
+ * Return the printable name of an RDMA operation
+ *
+ * @op [in]: operation
+ * @return: operation name
+ */
+const char *rdma_op_name(enum rdma_op op);
+
+/*
+ * Open the device, allocate PD/CQs/QP and register the payload buffer
+ *
+ * @cfg [in]: benchmark configuration
+ * @res [out]: verbs objects
+ * @return: 0 on success and -1 otherwise
+ */
+int rdma_create_resources(const struct rdma_config *cfg, struct rdma_resources *res);
+
+/*
+ * Release everything allocated by rdma_create_resources() and rdma_connect()
+ *
+ * @res [in]: verbs objects
+ */
+void rdma_destroy_resources(struct rdma_resources *res);
+
+/*
+ * Swap connection parameters with the peer and move the QP to RTS
+ *
+ * @cfg [in]: benchmark configuration
+ * @res [in/out]: verbs objects, remote is filled on success
+ * @return: 0 on success and -1 otherwise
+ */
+int rdma_connect(const struct rdma_config *cfg, struct rdma_resources *res);
+
+/*
+ * Block until the peer reaches the same point (one byte each way over TCP)
+ *
+ * @res [in]: verbs objects
+ * @return: 0 on success and -1 otherwise
+ */
+int rdma_sync(struct rdma_resources *res);
+
+/*
+ * Post a receive covering the whole payload buffer
+ *
+ * @res [in]: verbs objects
+ * @return: 0 on success and -1 otherwise
+ */
+int rdma_post_recv(struct rdma_resources *res);
+
+/*
+ * Post one send-side work request of the configured operation
+ *
+ * @cfg [in]: benchmark configuration
+ * @res [in]: verbs objects
+ * @len [in]: payload length
+ * @signaled [in]: request a completion for this work request
+ * @return: 0 on success and -1 otherwise
+ */
+int rdma_post_op(const struct rdma_config *cfg, struct rdma_resources *res, size_t len, bool signaled);
+
+/*
+ * Busy-poll a CQ until at least one completion is reaped
+ *
+ * @cq [in]: completion queue
+ * @wc [out]: array receiving the completions
+ * @max [in]: size of wc
+ * @return: number of completions reaped, -1 on a failed completion
+ */
+int rdma_poll(struct ibv_cq *cq, struct ibv_wc *wc, int max);
+
+#endif
@@ -0,0 +1,23 @@
+# /*
+# * Copyright (c) 2025, University of California, Merced. All rights reserved.
+# *
+# * This file is part of the benchmarking software package developed by
+# * the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+# *
+# * For detailed copyright and licensing information, please refer to the license
+# * file LICENSE in the top level directory.
+# *
+# */
+
+# Usage: run.sh <op> <lat|thr> <size> [server address]
+# Start without a server address on the passive side (e.g. the host),
+# then with the host address on the initiator (e.g. the DPU).
+op=$1
+test=$2
+len=$3
+server=$4
+
+make clean && make
+echo ""
+
+./rdma_bench -d mlx5_0 -o ${op} -t ${test} -s ${len} ${server}
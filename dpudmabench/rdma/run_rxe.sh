@@ -0,0 +1,30 @@
+# /*
+# * Copyright (c) 2025, University of California, Merced. All rights reserved.
+# *
+# * This file is part of the benchmarking software package developed by
+# * the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+# *
+# * For detailed copyright and licensing information, please refer to the license
+# * file LICENSE in the top level directory.
+# *
+# */
+
+# Development run on a plain Linux box with soft-RoCE (rdma_rxe).
+# Usage: run_rxe.sh <netdev> [op] [lat|thr] [size]
+netdev=$1
+op=${2:-read}
+test=${3:-lat}
+len=${4:-4096}
+
+sudo modprobe rdma_rxe
+rdma link show rxe0 > /dev/null 2>&1 || sudo rdma link add rxe0 type rxe netdev ${netdev}
+addr=$(ip -4 -o addr show dev ${netdev} | awk '{print $4}' | cut -d/ -f1)
+
+make clean && make
+echo ""
+
+# GID index 1 is the IPv4-mapped RoCEv2 GID on rdma_rxe
+./rdma_bench -d rxe0 -g 1 -o ${op} -t ${test} -s ${len} -n 1000 &
+sleep 1
+./rdma_bench -d rxe0 -g 1 -o ${op} -t ${test} -s ${len} -n 1000 ${addr}
+wait
@@ -0,0 +1,168 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+#include <arm_neon.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "membw.h"
+
+/*
+ * NEON kernels, plus the two store paths Arm cores treat specially: STNP (non-temporal pair) and DC ZVA
+ */
+
+/*
+ * Advanced SIMD is mandatory on AArch64
+ *
+ * @return: true
+ */
+static bool
+neon_supported(void)
+{
+	return true;
+}
+
+/* c = a, see membw_fn */
+static double
+neon_copy(double *a, double *b, double *c, size_t n)
+{
+	size_t i;
+
+	(void)b;
+	for (i = 0; i < n; i += 4) {
+		vst1q_f64(c + i, vld1q_f64(a + i));
+		vst1q_f64(c + i + 2, vld1q_f64(a + i + 2));
+	}
+	return 0;
+}
+
+/* b = s * c, see membw_fn */
+static double
+neon_scale(double *a, double *b, double *c, size_t n)
+{
+	size_t i;
+
+	(void)a;
+	for (i = 0; i < n; i += 4) {
+		vst1q_f64(b + i, vmulq_n_f64(vld1q_f64(c + i), MEMBW_SCALAR));
+		vst1q_f64(b + i + 2, vmulq_n_f64(vld1q_f64(c + i + 2), MEMBW_SCALAR));
+	}
+	return 0;
+}
+
+/* c = a + b, see membw_fn */
+static double
+neon_add(double *a, double *b, double *c, size_t n)
+{
+	size_t i;
+
+	for (i = 0; i < n; i += 4) {
+		vst1q_f64(c + i, vaddq_f64(vld1q_f64(a + i), vld1q_f64(b + i)));
+		vst1q_f64(c + i + 2, vaddq_f64(vld1q_f64(a + i + 2), vld1q_f64(b + i + 2)));
+	}
+	return 0;
+}
+
+/* a = b + s * c, see membw_fn */
+static double
+neon_triad(double *a, double *b, double *c, size_t n)
+{
+	size_t i;
+
+	for (i = 0; i < n; i += 4) {
+		vst1q_f64(a + i, vaddq_f64(vld1q_f64(b + i), vmulq_n_f64(vld1q_f64(c + i), MEMBW_SCALAR)));
+		vst1q_f64(a + i + 2, vaddq_f64(vld1q_f64(b + i + 2), vmulq_n_f64(vld1q_f64(c + i + 2), MEMBW_SCALAR)));
+	}
+	return 0;
+}
+
+/* Sum of a, see membw_fn */
+static double
+neon_read(double *a, double *b, double *c, size_t n)
+{
+	float64x2_t s0 = vdupq_n_f64(0), s1 = vdupq_n_f64(0);
+	size_t i;
+
+	(void)b;
+	(void)c;
+	for (i = 0; i < n; i += 4) {
+		s0 = vaddq_f64(s0, vld1q_f64(a + i));
+		s1 = vaddq_f64(s1, vld1q_f64(a + i + 2));
+	}
+	return vaddvq_f64(vaddq_f64(s0, s1));
+}
+
+/* a = s, see membw_fn */
+static double
+neon_write(double *a, double *b, double *c, size_t n)
+{
+	const float64x2_t s = vdupq_n_f64(MEMBW_SCALAR);
+	size_t i;
+
+	(void)b;
+	(void)c;
+	for (i = 0; i < n; i += 4) {
+		vst1q_f64(a + i, s);
+		vst1q_f64(a + i + 2, s);
+	}
+	return 0;
+}
+
+/* a = s with STNP, which hints that the lines will not be read again, see membw_fn */
+static double
+neon_nt_write(double *a, double *b, double *c, size_t n)
+{
+	const float64x2_t s = vdupq_n_f64(MEMBW_SCALAR);
+	size_t i;
+
+	(void)b;
+	(void)c;
+	for (i = 0; i < n; i += 4)
+		__asm__ volatile("stnp %q1, %q1, [%0]" : : "r"(a + i), "w"(s) : "memory");
+	return 0;
+}
+
+/* a = 0 with DC ZVA, which zeroes a whole block without reading it first, see membw_fn */
+static double
+neon_zero(double *a, double *b, double *c, size_t n)
+{
+	char *p = (char *)a, *end = (char *)(a + n);
+	uint64_t dczid;
+	size_t block;
+
+	(void)b;
+	(void)c;
+	__asm__ volatile("mrs %0, dczid_el0" : "=r"(dczid));
+	/* DZP set: DC ZVA is prohibited, fall back to ordinary stores */
+	if (dczid & 16) {
+		memset(a, 0, n * sizeof(*a));
+		return 0;
+	}
+	block = 4UL << (dczid & 15);
+	for (; p < end; p += block)
+		__asm__ volatile("dc zva, %0" : : "r"(p) : "memory");
+	return 0;
+}
+
+const struct membw_variant membw_neon = {
+	.name = "neon",
+	.supported = neon_supported,
+	.fn = {
+		[MEMBW_COPY] = neon_copy,
+		[MEMBW_SCALE] = neon_scale,
+		[MEMBW_ADD] = neon_add,
+		[MEMBW_TRIAD] = neon_triad,
+		[MEMBW_READ] = neon_read,
+		[MEMBW_WRITE] = neon_write,
+		[MEMBW_NT_WRITE] = neon_nt_write,
+		[MEMBW_ZERO] = neon_zero,
+	},
+};
@@ -0,0 +1,132 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+#include <string.h>
+
+#include "membw.h"
+
+/*
+ * Plain C loops as in STREAM, built with -fno-tree-vectorize so they stay a one-element-at-a-time baseline
+ */
+
+/*
+ * Scalar variant is always supported
+ *
+ * @return: true
+ */
+static bool
+scalar_supported(void)
+{
+	return true;
+}
+
+/* c = a, see membw_fn */
+static double
+scalar_copy(double *restrict a, double *restrict b, double *restrict c, size_t n)
+{
+	size_t i;
+
+	(void)b;
+	for (i = 0; i < n; i++)
+		c[i] = a[i];
+	return 0;
+}
+
+/* b = s * c, see membw_fn */
+static double
+scalar_scale(double *restrict a, double *restrict b, double *restrict c, size_t n)
+{
+	size_t i;
+
+	(void)a;
+	for (i = 0; i < n; i++)
+		b[i] = MEMBW_SCALAR * c[i];
+	return 0;
+}
+
+/* c = a + b, see membw_fn */
+static double
+scalar_add(double *restrict a, double *restrict b, double *restrict c, size_t n)
+{
+	size_t i;
+
+	for (i = 0; i < n; i++)
+		c[i] = a[i] + b[i];
+	return 0;
+}
+
+/* a = b + s * c, see membw_fn */
+static double
+scalar_triad(double *restrict a, double *restrict b, double *restrict c, size_t n)
+{
+	size_t i;
+
+	for (i = 0; i < n; i++)
+		a[i] = b[i] + MEMBW_SCALAR * c[i];
+	return 0;
+}
+
+/* Sum of a, see membw_fn */
+static double
+scalar_read(double *restrict a, double *restrict b, double *restrict c, size_t n)
+{
+	double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+	size_t i;
+
+	/* Four accumulators, so the loop is bound by loads and not by the add latency */
+	(void)b;
+	(void)c;
+	for (i = 0; i < n; i += 4) {
+		s0 += a[i];
+		s1 += a[i + 1];
+		s2 += a[i + 2];
+		s3 += a[i + 3];
+	}
+	return s0 + s1 + s2 + s3;
+}
+
+/* a = s, see membw_fn */
+static double
+scalar_write(double *restrict a, double *restrict b, double *restrict c, size_t n)
+{
+	size_t i;
+
+	(void)b;
+	(void)c;
+	for (i = 0; i < n; i++)
+		a[i] = MEMBW_SCALAR;
+	return 0;
+}
+
+/* a = 0, see membw_fn */
+static double
+scalar_zero(double *restrict a, double *restrict b, double *restrict c, size_t n)
+{
+	(void)b;
+	(void)c;
+	/* The C library picks its own zeroing strategy, e.g. DC ZVA on Arm */
+	memset(a, 0, n * sizeof(*a));
+	return 0;
+}
+
+const struct membw_variant membw_scalar = {
+	.name = "scalar",
+	.supported = scalar_supported,
+	.fn = {
+		[MEMBW_COPY] = scalar_copy,
+		[MEMBW_SCALE] = scalar_scale,
+		[MEMBW_ADD] = scalar_add,
+		[MEMBW_TRIAD] = scalar_triad,
+		[MEMBW_READ] = scalar_read,
+		[MEMBW_WRITE] = scalar_write,
+		[MEMBW_ZERO] = scalar_zero,
+	},
+};
@@ -0,0 +1,152 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+#include <arm_sve.h>
+#include <sys/auxv.h>
+
+#include "membw.h"
+
+#ifndef HWCAP_SVE
+#define HWCAP_SVE (1 << 22)
+#endif
+
+/*
+ * SVE kernels, vector-length agnostic, built with +sve and only run where the kernel reports SVE
+ */
+
+/*
+ * Whether the CPU has SVE
+ *
+ * @return: true if supported
+ */
+static bool
+sve_supported(void)
+{
+	return (getauxval(AT_HWCAP) & HWCAP_SVE) != 0;
+}
+
+/* c = a, see membw_fn */
+static double
+sve_copy(double *a, double *b, double *c, size_t n)
+{
+	svbool_t pg;
+	uint64_t i;
+
+	(void)b;
+	for (i = 0; i < n; i += svcntd()) {
+		pg = svwhilelt_b64_u64(i, n);
+		svst1_f64(pg, c + i, svld1_f64(pg, a + i));
+	}
+	return 0;
+}
+
+/* b = s * c, see membw_fn */
+static double
+sve_scale(double *a, double *b, double *c, size_t n)
+{
+	svbool_t pg;
+	uint64_t i;
+
+	(void)a;
+	for (i = 0; i < n; i += svcntd()) {
+		pg = svwhilelt_b64_u64(i, n);
+		svst1_f64(pg, b + i, svmul_n_f64_x(pg, svld1_f64(pg, c + i), MEMBW_SCALAR));
+	}
+	return 0;
+}
+
+/* c = a + b, see membw_fn */
+static double
+sve_add(double *a, double *b, double *c, size_t n)
+{
+	svbool_t pg;
+	uint64_t i;
+
+	for (i = 0; i < n; i += svcntd()) {
+		pg = svwhilelt_b64_u64(i, n);
+		svst1_f64(pg, c + i, svadd_f64_x(pg, svld1_f64(pg, a + i), svld1_f64(pg, b + i)));
+	}
+	return 0;
+}
+
+/* a = b + s * c, see membw_fn */
+static double
+sve_triad(double *a, double *b, double *c, size_t n)
+{
+	svbool_t pg;
+	uint64_t i;
+
+	for (i = 0; i < n; i += svcntd()) {
+		pg = svwhilelt_b64_u64(i, n);
+		svst1_f64(pg, a + i, svadd_f64_x(pg, svld1_f64(pg, b + i),
+						 svmul_n_f64_x(pg, svld1_f64(pg, c + i), MEMBW_SCALAR)));
+	}
+	return 0;
+}
+
+/* Sum of a, see membw_fn */
+static double
+sve_read(double *a, double *b, double *c, size_t n)
+{
+	svfloat64_t sum = svdup_n_f64(0);
+	svbool_t pg;
+	uint64_t i;
+
+	(void)b;
+	(void)c;
+	for (i = 0; i < n; i += svcntd()) {
+		pg = svwhilelt_b64_u64(i, n);
+		sum = svadd_f64_m(pg, sum, svld1_f64(pg, a + i));
+	}
+	return svaddv_f64(svptrue_b64(), sum);
+}
+
+/* a = s, see membw_fn */
+static double
+sve_write(double *a, double *b, double *c, size_t n)
+{
+	const svfloat64_t s = svdup_n_f64(MEMBW_SCALAR);
+	uint64_t i;
+
+	(void)b;
+	(void)c;
+	for (i = 0; i < n; i += svcntd())
+		svst1_f64(svwhilelt_b64_u64(i, n), a + i, s);
+	return 0;
+}
+
+/* a = s with STNT1D non-temporal stores, see membw_fn */
+static double
+sve_nt_write(double *a, double *b, double *c, size_t n)
+{
+	const svfloat64_t s = svdup_n_f64(MEMBW_SCALAR);
+	uint64_t i;
+
+	(void)b;
+	(void)c;
+	for (i = 0; i < n; i += svcntd())
+		svstnt1_f64(svwhilelt_b64_u64(i, n), a + i, s);
+	return 0;
+}
+
+const struct membw_variant membw_sve = {
+	.name = "sve",
+	.supported = sve_supported,
+	.fn = {
+		[MEMBW_COPY] = sve_copy,
+		[MEMBW_SCALE] = sve_scale,
+		[MEMBW_ADD] = sve_add,
+		[MEMBW_TRIAD] = sve_triad,
+		[MEMBW_READ] = sve_read,
+		[MEMBW_WRITE] = sve_write,
+		[MEMBW_NT_WRITE] = sve_nt_write,
+	},
+};
@@ -0,0 +1,256 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+#include <immintrin.h>
+
+#include "membw.h"
+
+/*
+ * AVX2 and AVX-512 kernels, built for the baseline ISA with per-function targets and picked at run time
+ */
+
+/*
+ * Whether the CPU has AVX2
+ *
+ * @return: true if supported
+ */
+static bool
+avx2_supported(void)
+{
+	return __builtin_cpu_supports("avx2");
+}
+
+/* c = a, see membw_fn */
+__attribute__((target("avx2"))) static double
+avx2_copy(double *a, double *b, double *c, size_t n)
+{
+	size_t i;
+
+	(void)b;
+	for (i = 0; i < n; i += 4)
+		_mm256_store_pd(c + i, _mm256_load_pd(a + i));
+	return 0;
+}
+
+/* b = s * c, see membw_fn */
+__attribute__((target("avx2"))) static double
+avx2_scale(double *a, double *b, double *c, size_t n)
+{
+	const __m256d s = _mm256_set1_pd(MEMBW_SCALAR);
+	size_t i;
+
+	(void)a;
+	for (i = 0; i < n; i += 4)
+		_mm256_store_pd(b + i, _mm256_mul_pd(s, _mm256_load_pd(c + i)));
+	return 0;
+}
+
+/* c = a + b, see membw_fn */
+__attribute__((target("avx2"))) static double
+avx2_add(double *a, double *b, double *c, size_t n)
+{
+	size_t i;
+
+	for (i = 0; i < n; i += 4)
+		_mm256_store_pd(c + i, _mm256_add_pd(_mm256_load_pd(a + i), _mm256_load_pd(b + i)));
+	return 0;
+}
+
+/* a = b + s * c, see membw_fn */
+__attribute__((target("avx2"))) static double
+avx2_triad(double *a, double *b, double *c, size_t n)
+{
+	const __m256d s = _mm256_set1_pd(MEMBW_SCALAR);
+	size_t i;
+
+	for (i = 0; i < n; i += 4)
+		_mm256_store_pd(a + i, _mm256_add_pd(_mm256_load_pd(b + i), _mm256_mul_pd(s, _mm256_load_pd(c + i))));
+	return 0;
+}
+
+/* Sum of a, see membw_fn */
+__attribute__((target("avx2"))) static double
+avx2_read(double *a, double *b, double *c, size_t n)
+{
+	__m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+	double out[4];
+	size_t i;
+
+	(void)b;
+	(void)c;
+	for (i = 0; i < n; i += 8) {
+		s0 = _mm256_add_pd(s0, _mm256_load_pd(a + i));
+		s1 = _mm256_add_pd(s1, _mm256_load_pd(a + i + 4));
+	}
+	_mm256_storeu_pd(out, _mm256_add_pd(s0, s1));
+	return out[0] + out[1] + out[2] + out[3];
+}
+
+/* a = s, see membw_fn */
+__attribute__((target("avx2"))) static double
+avx2_write(double *a, double *b, double *c, size_t n)
+{
+	const __m256d s = _mm256_set1_pd(MEMBW_SCALAR);
+	size_t i;
+
+	(void)b;
+	(void)c;
+	for (i = 0; i < n; i += 4)
+		_mm256_store_pd(a + i, s);
+	return 0;
+}
+
+/* a = s with streaming stores that bypass the caches, see membw_fn */
+__attribute__((target("avx2"))) static double
+avx2_nt_write(double *a, double *b, double *c, size_t n)
+{
+	const __m256d s = _mm256_set1_pd(MEMBW_SCALAR);
+	size_t i;
+
+	(void)b;
+	(void)c;
+	for (i = 0; i < n; i += 4)
+		_mm256_stream_pd(a + i, s);
+	_mm_sfence();
+	return 0;
+}
+
+/*
+ * Whether the CPU has AVX-512F
+ *
+ * @return: true if supported
+ */
+static bool
+avx512_supported(void)
+{
+	return __builtin_cpu_supports("avx512f");
+}
+
+/* c = a, see membw_fn */
+__attribute__((target("avx512f"))) static double
+avx512_copy(double *a, double *b, double *c, size_t n)
+{
+	size_t i;
+
+	(void)b;
+	for (i = 0; i < n; i += 8)
+		_mm512_store_pd(c + i, _mm512_load_pd(a + i));
+	return 0;
+}
+
+/* b = s * c, see membw_fn */
+__attribute__((target("avx512f"))) static double
+avx512_scale(double *a, double *b, double *c, size_t n)
+{
+	const __m512d s = _mm512_set1_pd(MEMBW_SCALAR);
+	size_t i;
+
+	(void)a;
+	for (i = 0; i < n; i += 8)
+		_mm512_store_pd(b + i, _mm512_mul_pd(s, _mm512_load_pd(c + i)));
+	return 0;
+}
+
+/* c = a + b, see membw_fn */
+__attribute__((target("avx512f"))) static double
+avx512_add(double *a, double *b, double *c, size_t n)
+{
+	size_t i;
+
+	for (i = 0; i < n; i += 8)
+		_mm512_store_pd(c + i, _mm512_add_pd(_mm512_load_pd(a + i), _mm512_load_pd(b + i)));
+	return 0;
+}
+
+/* a = b + s * c, see membw_fn */
+__attribute__((target("avx512f"))) static double
+avx512_triad(double *a, double *b, double *c, size_t n)
+{
+	const __m512d s = _mm512_set1_pd(MEMBW_SCALAR);
+	size_t i;
+
+	for (i = 0; i < n; i += 8)
+		_mm512_store_pd(a + i, _mm512_add_pd(_mm512_load_pd(b + i), _mm512_mul_pd(s, _mm512_load_pd(c + i))));
+	return 0;
+}
+
+/* Sum of a, see membw_fn */
+__attribute__((target("avx512f"))) static double
+avx512_read(double *a, double *b, double *c, size_t n)
+{
+	__m512d s0 = _mm512_setzero_pd(), s1 = _mm512_setzero_pd();
+	size_t i;
+
+	(void)b;
+	(void)c;
+	for (i = 0; i < n; i += 16) {
+		s0 = _mm512_add_pd(s0, _mm512_load_pd(a + i));
+		s1 = _mm512_add_pd(s1, _mm512_load_pd(a + i + 8));
+	}
+	return _mm512_reduce_add_pd(_mm512_add_pd(s0, s1));
+}
+
+/* a = s, see membw_fn */
+__attribute__((target("avx512f"))) static double
+avx512_write(double *a, double *b, double *c, size_t n)
+{
+	const __m512d s = _mm512_set1_pd(MEMBW_SCALAR);
+	size_t i;
+
+	(void)b;
+	(void)c;
+	for (i = 0; i < n; i += 8)
+		_mm512_store_pd(a + i, s);
+	return 0;
+}
+
+/* a = s with streaming stores that bypass the caches, see membw_fn */
+__attribute__((target("avx512f"))) static double
+avx512_nt_write(double *a, double *b, double *c, size_t n)
+{
+	const __m512d s = _mm512_set1_pd(MEMBW_SCALAR);
+	size_t i;
+
+	(void)b;
+	(void)c;
+	for (i = 0; i < n; i += 8)
+		_mm512_stream_pd(a + i, s);
+	_mm_sfence();
+	return 0;
+}
+
+const struct membw_variant membw_avx2 = {
+	.name = "avx2",
+	.supported = avx2_supported,
+	.fn = {
+		[MEMBW_COPY] = avx2_copy,
+		[MEMBW_SCALE] = avx2_scale,
+		[MEMBW_ADD] = avx2_add,
+		[MEMBW_TRIAD] = avx2_triad,
+		[MEMBW_READ] = avx2_read,
+		[MEMBW_WRITE] = avx2_write,
+		[MEMBW_NT_WRITE] = avx2_nt_write,
+	},
+};
+
+const struct membw_variant membw_avx512 = {
+	.name = "avx512",
+	.supported = avx512_supported,
+	.fn = {
+		[MEMBW_COPY] = avx512_copy,
+		[MEMBW_SCALE] = avx512_scale,
+		[MEMBW_ADD] = avx512_add,
+		[MEMBW_TRIAD] = avx512_triad,
+		[MEMBW_READ] = avx512_read,
+		[MEMBW_WRITE] = avx512_write,
+		[MEMBW_NT_WRITE] = avx512_nt_write,
+	},
+};
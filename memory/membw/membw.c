@@ -0,0 +1,548 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+#define _GNU_SOURCE
+#include <getopt.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "membw.h"
+
+#define MAX_THREADS 256			/* Largest number of threads */
+#define MAX_POINTS 64			/* Largest number of thread counts in a sweep */
+#define DEFAULT_ARRAY_MB 256		/* Size of every array, split over the threads */
+#define DEFAULT_REPS 10			/* Repetitions of every kernel, the first one is a warm-up */
+#define LIST_SEP ","			/* Separator of the -t, -k and -v lists */
+
+static const char *const kernel_names[MEMBW_NB_KERNELS] = {
+	"copy", "scale", "add", "triad", "read", "write", "nt_write", "zero",
+};
+
+/* Arrays each kernel moves, STREAM counting */
+static const int kernel_arrays[MEMBW_NB_KERNELS] = {2, 2, 3, 3, 1, 1, 1, 1};
+
+/* Every variant built for this architecture */
+static const struct membw_variant *const variants[] = {
+	&membw_scalar,
+#if defined(__x86_64__)
+	&membw_avx2,
+	&membw_avx512,
+#elif defined(__aarch64__)
+	&membw_neon,
+#ifdef MEMBW_HAVE_SVE
+	&membw_sve,
+#endif
+#endif
+};
+#define NB_VARIANTS (sizeof(variants) / sizeof(variants[0]))
+
+/* Command of one round, set by the launcher between the two barriers */
+enum round_cmd {
+	ROUND_RUN,	/* Run the kernel once */
+	ROUND_VERIFY,	/* Check the output of the kernel */
+	ROUND_INIT,	/* Reset the arrays */
+	ROUND_QUIT,	/* Leave */
+};
+
+/* Benchmark configuration, from the command line */
+struct membw_config {
+	int cores[MAX_THREADS];			/* Core of thread i */
+	int nb_cores;				/* Number of cores */
+	int threads[MAX_POINTS];		/* Thread counts of the sweep */
+	int nb_points;				/* Number of thread counts */
+	size_t array_bytes;			/* Size of every array */
+	int reps;				/* Repetitions of every kernel */
+	bool kernels[MEMBW_NB_KERNELS];		/* Selected kernels */
+	bool variants[NB_VARIANTS];		/* Selected variants */
+};
+
+/* State of one thread of a point */
+struct membw_thread {
+	pthread_t tid;				/* Thread handle */
+	int core;				/* Core the thread is pinned to */
+	double *a, *b, *c;			/* Arrays, first touched by this thread */
+	size_t n;				/* Elements per array */
+	double sum;				/* Result of the read kernel */
+	int errors;				/* Failed verifications */
+};
+
+/* Launcher state shared with the threads of a point */
+static pthread_barrier_t start_barrier, end_barrier;
+static enum round_cmd cmd;
+static membw_fn cmd_fn;
+static enum membw_kernel cmd_kernel;
+
+/*
+ * Current CLOCK_MONOTONIC time
+ *
+ * @return: time in seconds
+ */
+static double
+now_s(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/*
+ * Set the arrays to their initial values
+ *
+ * @t [in]: thread
+ */
+static void
+init_arrays(struct membw_thread *t)
+{
+	size_t i;
+
+	for (i = 0; i < t->n; i++) {
+		t->a[i] = MEMBW_INIT_A;
+		t->b[i] = MEMBW_INIT_B;
+		t->c[i] = MEMBW_INIT_C;
+	}
+}
+
+/*
+ * Check the output of a kernel that ran on the initial values
+ *
+ * @t [in]: thread
+ * @k [in]: kernel
+ * @return: number of wrong elements
+ */
+static size_t
+verify(const struct membw_thread *t, enum membw_kernel k)
+{
+	const double *out;
+	double expect;
+	size_t i, bad = 0;
+
+	switch (k) {
+	case MEMBW_COPY:
+		out = t->c;
+		expect = MEMBW_INIT_A;
+		break;
+	case MEMBW_SCALE:
+		out = t->b;
+		expect = MEMBW_SCALAR * MEMBW_INIT_C;
+		break;
+	case MEMBW_ADD:
+		out = t->c;
+		expect = MEMBW_INIT_A + MEMBW_INIT_B;
+		break;
+	case MEMBW_TRIAD:
+		out = t->a;
+		expect = MEMBW_INIT_B + MEMBW_SCALAR * MEMBW_INIT_C;
+		break;
+	case MEMBW_READ:
+		return t->sum != t->n * MEMBW_INIT_A;
+	case MEMBW_WRITE:
+	case MEMBW_NT_WRITE:
+		out = t->a;
+		expect = MEMBW_SCALAR;
+		break;
+	default:
+		out = t->a;
+		expect = 0;
+		break;
+	}
+	for (i = 0; i < t->n; i++)
+		bad += out[i] != expect;
+	return bad;
+}
+
+/*
+ * Thread of a point: pin, allocate and first-touch the arrays, then run rounds until ROUND_QUIT
+ *
+ * @arg [in]: thread
+ * @return: NULL
+ */
+static void *
+thread_main(void *arg)
+{
+	struct membw_thread *t = arg;
+	cpu_set_t set;
+
+	CPU_ZERO(&set);
+	CPU_SET(t->core, &set);
+	if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+		fprintf(stderr, "Failed to pin to core %d\n", t->core);
+		t->errors++;
+	}
+	/* Allocated after pinning, so first touch places the pages next to the core that uses them */
+	if (posix_memalign((void **)&t->a, MEMBW_ALIGN, t->n * sizeof(double)) != 0 ||
+	    posix_memalign((void **)&t->b, MEMBW_ALIGN, t->n * sizeof(double)) != 0 ||
+	    posix_memalign((void **)&t->c, MEMBW_ALIGN, t->n * sizeof(double)) != 0) {
+		fprintf(stderr, "Failed to allocate the arrays of core %d\n", t->core);
+		t->n = 0;
+		t->errors++;
+	}
+	init_arrays(t);
+
+	for (;;) {
+		pthread_barrier_wait(&start_barrier);
+		if (cmd == ROUND_QUIT)
+			break;
+		if (cmd == ROUND_RUN)
+			t->sum = cmd_fn(t->a, t->b, t->c, t->n);
+		else if (cmd == ROUND_VERIFY && t->n > 0)
+			t->errors += verify(t, cmd_kernel) != 0;
+		else
+			init_arrays(t);
+		pthread_barrier_wait(&end_barrier);
+	}
+
+	free(t->a);
+	free(t->b);
+	free(t->c);
+	return NULL;
+}
+
+/*
+ * Run one round on every thread of the point
+ *
+ * @c [in]: command
+ * @return: round length in seconds
+ */
+static double
+run_round(enum round_cmd c)
+{
+	double start;
+
+	cmd = c;
+	pthread_barrier_wait(&start_barrier);
+	start = now_s();
+	/* Threads leave right after the start barrier on ROUND_QUIT */
+	if (c != ROUND_QUIT)
+		pthread_barrier_wait(&end_barrier);
+	return now_s() - start;
+}
+
+/*
+ * Run every selected variant and kernel with nb_threads threads
+ *
+ * @cfg [in]: configuration
+ * @nb_threads [in]: number of threads
+ * @return: 0 on success and -1 otherwise
+ */
+static int
+run_point(const struct membw_config *cfg, int nb_threads)
+{
+	struct membw_thread *threads;
+	double t, best, sum, bytes, best_gbps, avg_gbps;
+	size_t n, v;
+	int i, k, r, started, errors = 0;
+
+	/* Every thread gets the same number of elements, a multiple of the kernel unroll and of a DC ZVA block */
+	n = cfg->array_bytes / sizeof(double) / nb_threads / MEMBW_ALIGN_ELEMS * MEMBW_ALIGN_ELEMS;
+	if (n == 0) {
+		fprintf(stderr, "Arrays too small for %d threads\n", nb_threads);
+		return -1;
+	}
+	threads = calloc(nb_threads, sizeof(*threads));
+	if (threads == NULL)
+		return -1;
+
+	pthread_barrier_init(&start_barrier, NULL, nb_threads + 1);
+	pthread_barrier_init(&end_barrier, NULL, nb_threads + 1);
+	for (started = 0; started < nb_threads; started++) {
+		threads[started].core = cfg->cores[started];
+		threads[started].n = n;
+		if (pthread_create(&threads[started].tid, NULL, thread_main, &threads[started]) != 0) {
+			fprintf(stderr, "Failed to start thread %d\n", started);
+			/* The barriers count every thread, the ones already started cannot be released */
+			exit(EXIT_FAILURE);
+		}
+	}
+	/* Waits for the setup of every thread */
+	run_round(ROUND_INIT);
+	for (i = 0; i < nb_threads; i++)
+		errors += threads[i].errors;
+	if (errors != 0)
+		goto quit;
+
+	printf("%d threads, %zu bytes per array per thread, %d repetitions (first one not counted)\n", nb_threads,
+	       n * sizeof(double), cfg->reps);
+	printf("Variant\t Kernel\t\t Best(GB/s)\t Avg(GB/s)\t Min time(s)\n");
+	for (v = 0; v < NB_VARIANTS; v++) {
+		if (!cfg->variants[v])
+			continue;
+		for (k = 0; k < MEMBW_NB_KERNELS; k++) {
+			if (!cfg->kernels[k] || variants[v]->fn[k] == NULL)
+				continue;
+			cmd_fn = variants[v]->fn[k];
+			cmd_kernel = k;
+			best = 0;
+			sum = 0;
+			for (r = 0; r < cfg->reps; r++) {
+				t = run_round(ROUND_RUN);
+				if (r == 0)
+					continue;
+				sum += t;
+				if (best == 0 || t < best)
+					best = t;
+			}
+			run_round(ROUND_VERIFY);
+			run_round(ROUND_INIT);
+
+			bytes = (double)kernel_arrays[k] * n * sizeof(double) * nb_threads;
+			best_gbps = bytes / best / 1e9;
+			avg_gbps = bytes / (sum / (cfg->reps - 1)) / 1e9;
+			printf("%s\t %-8s\t %10.3f\t %9.3f\t %11.6f\n", variants[v]->name, kernel_names[k], best_gbps,
+			       avg_gbps, best);
+			printf("MEMBW %s %s %d %.3f %.3f %.6f\n", variants[v]->name, kernel_names[k], nb_threads,
+			       best_gbps, avg_gbps, best);
+			fflush(stdout);
+		}
+	}
+	printf("\n");
+	for (i = 0; i < nb_threads; i++)
+		errors += threads[i].errors;
+	if (errors != 0)
+		fprintf(stderr, "%d threads failed a verification\n", errors);
+
+quit:
+	run_round(ROUND_QUIT);
+	for (i = 0; i < started; i++)
+		pthread_join(threads[i].tid, NULL);
+	pthread_barrier_destroy(&start_barrier);
+	pthread_barrier_destroy(&end_barrier);
+	free(threads);
+	return errors == 0 ? 0 : -1;
+}
+
+/*
+ * Parse a core list such as "0-3,6"
+ *
+ * @list [in]: core list
+ * @cfg [out]: cores and nb_cores
+ * @return: 0 on success and -1 otherwise
+ */
+static int
+parse_cores(const char *list, struct membw_config *cfg)
+{
+	const char *p = list;
+	char *end;
+	long first, last, c;
+
+	cfg->nb_cores = 0;
+	while (*p != '\0') {
+		first = strtol(p, &end, 10);
+		if (end == p || first < 0)
+			return -1;
+		last = first;
+		if (*end == '-') {
+			p = end + 1;
+			last = strtol(p, &end, 10);
+			if (end == p || last < first)
+				return -1;
+		}
+		for (c = first; c <= last; c++) {
+			if (cfg->nb_cores == MAX_THREADS || c >= CPU_SETSIZE)
+				return -1;
+			cfg->cores[cfg->nb_cores++] = c;
+		}
+		if (*end == ',')
+			end++;
+		else if (*end != '\0')
+			return -1;
+		p = end;
+	}
+	return cfg->nb_cores > 0 ? 0 : -1;
+}
+
+/*
+ * Use every core the process may run on
+ *
+ * @cfg [out]: cores and nb_cores
+ * @return: 0 on success and -1 otherwise
+ */
+static int
+default_cores(struct membw_config *cfg)
+{
+	cpu_set_t set;
+	int c;
+
+	if (sched_getaffinity(0, sizeof(set), &set) != 0)
+		return -1;
+	cfg->nb_cores = 0;
+	for (c = 0; c < CPU_SETSIZE && cfg->nb_cores < MAX_THREADS; c++) {
+		if (CPU_ISSET(c, &set))
+			cfg->cores[cfg->nb_cores++] = c;
+	}
+	return 0;
+}
+
+/*
+ * Select the entries of a name list
+ *
+ * @list [in]: comma separated names, modified in place
+ * @names [in]: known names
+ * @nb_names [in]: number of known names
+ * @selected [out]: selected entries
+ * @return: 0 on success and -1 otherwise
+ */
+static int
+parse_names(char *list, const char *const *names, int nb_names, bool *selected)
+{
+	char *tok, *saveptr;
+	int i;
+
+	memset(selected, 0, nb_names * sizeof(*selected));
+	for (tok = strtok_r(list, LIST_SEP, &saveptr); tok != NULL; tok = strtok_r(NULL, LIST_SEP, &saveptr)) {
+		for (i = 0; i < nb_names && strcmp(names[i], tok) != 0; i++)
+			;
+		if (i == nb_names) {
+			fprintf(stderr, "Unknown name %s\n", tok);
+			return -1;
+		}
+		selected[i] = true;
+	}
+	return 0;
+}
+
+/*
+ * Print command line usage
+ *
+ * @prog [in]: program name
+ */
+static void
+usage(const char *prog)
+{
+	size_t v;
+
+	printf("Usage: %s [-c cores] [-t threads] [-m MB] [-r reps] [-k kernels] [-v variants]\n", prog);
+	printf("STREAM-style memory bandwidth, one pinned thread per core, each with its own part of the arrays.\n");
+	printf("Prints MEMBW <variant> <kernel> <threads> <best GB/s> <avg GB/s> <min time s> for every result.\n");
+	printf("  -c, --cores <list>       cores in the order threads are added, e.g. 0-7 (default: all allowed)\n");
+	printf("  -t, --threads <list>     thread counts, e.g. 1,2,4,8 (default: powers of two, then all cores)\n");
+	printf("  -m, --mem <MB>           size of every array over all threads (default: %d)\n", DEFAULT_ARRAY_MB);
+	printf("  -r, --reps <n>           runs of every kernel, the first one is a warm-up (default: %d)\n",
+	       DEFAULT_REPS);
+	printf("  -k, --kernels <list>     copy,scale,add,triad,read,write,nt_write,zero (default: all)\n");
+	printf("  -v, --variants <list>    built here:");
+	for (v = 0; v < NB_VARIANTS; v++)
+		printf("%s%s", v ? "," : " ", variants[v]->name);
+	printf(" (default: all the CPU supports)\n");
+}
+
+/*
+ * Memory bandwidth benchmark main function
+ *
+ * @argc [in]: command line arguments size
+ * @argv [in]: array of command line arguments
+ * @return: EXIT_SUCCESS on success and EXIT_FAILURE otherwise
+ */
+int
+main(int argc, char **argv)
+{
+	static const struct option long_opts[] = {
+		{"cores", required_argument, NULL, 'c'},
+		{"threads", required_argument, NULL, 't'},
+		{"mem", required_argument, NULL, 'm'},
+		{"reps", required_argument, NULL, 'r'},
+		{"kernels", required_argument, NULL, 'k'},
+		{"variants", required_argument, NULL, 'v'},
+		{"help", no_argument, NULL, 'h'},
+		{NULL, 0, NULL, 0},
+	};
+	const char *variant_names[NB_VARIANTS];
+	struct membw_config cfg = {0};
+	char *threads = NULL, *tok, *saveptr;
+	int c, i, exit_status = EXIT_SUCCESS;
+	bool explicit_variants = false;
+	size_t v;
+
+	cfg.array_bytes = (size_t)DEFAULT_ARRAY_MB << 20;
+	cfg.reps = DEFAULT_REPS;
+	for (i = 0; i < MEMBW_NB_KERNELS; i++)
+		cfg.kernels[i] = true;
+	for (v = 0; v < NB_VARIANTS; v++) {
+		variant_names[v] = variants[v]->name;
+		cfg.variants[v] = true;
+	}
+	if (default_cores(&cfg) != 0)
+		return EXIT_FAILURE;
+
+	while ((c = getopt_long(argc, argv, "c:t:m:r:k:v:h", long_opts, NULL)) != -1) {
+		switch (c) {
+		case 'c':
+			if (parse_cores(optarg, &cfg) != 0) {
+				fprintf(stderr, "Invalid core list %s\n", optarg);
+				return EXIT_FAILURE;
+			}
+			break;
+		case 't':
+			threads = optarg;
+			break;
+		case 'm':
+			cfg.array_bytes = strtoull(optarg, NULL, 0) << 20;
+			break;
+		case 'r':
+			cfg.reps = atoi(optarg);
+			break;
+		case 'k':
+			if (parse_names(optarg, kernel_names, MEMBW_NB_KERNELS, cfg.kernels) != 0)
+				return EXIT_FAILURE;
+			break;
+		case 'v':
+			if (parse_names(optarg, variant_names, NB_VARIANTS, cfg.variants) != 0)
+				return EXIT_FAILURE;
+			explicit_variants = true;
+			break;
+		case 'h':
+			usage(argv[0]);
+			return EXIT_SUCCESS;
+		default:
+			usage(argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+	if (cfg.reps < 2) {
+		fprintf(stderr, "At least 2 repetitions are needed\n");
+		return EXIT_FAILURE;
+	}
+
+	for (v = 0; v < NB_VARIANTS; v++) {
+		if (cfg.variants[v] && !variants[v]->supported()) {
+			if (explicit_variants)
+				fprintf(stderr, "This CPU does not support %s, skipped\n", variants[v]->name);
+			cfg.variants[v] = false;
+		}
+	}
+
+	if (threads != NULL) {
+		for (tok = strtok_r(threads, LIST_SEP, &saveptr); tok != NULL;
+		     tok = strtok_r(NULL, LIST_SEP, &saveptr)) {
+			i = atoi(tok);
+			if (i < 1 || i > cfg.nb_cores || cfg.nb_points == MAX_POINTS) {
+				fprintf(stderr, "Thread count %s must be in [1, %d]\n", tok, cfg.nb_cores);
+				return EXIT_FAILURE;
+			}
+			cfg.threads[cfg.nb_points++] = i;
+		}
+	} else {
+		for (i = 1; i < cfg.nb_cores; i *= 2)
+			cfg.threads[cfg.nb_points++] = i;
+		cfg.threads[cfg.nb_points++] = cfg.nb_cores;
+	}
+
+	for (i = 0; i < cfg.nb_points; i++) {
+		if (run_point(&cfg, cfg.threads[i]) != 0)
+			exit_status = EXIT_FAILURE;
+	}
+	return exit_status;
+}
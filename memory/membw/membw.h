@@ -0,0 +1,68 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+#ifndef MEMBW_H_
+#define MEMBW_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#define MEMBW_SCALAR 3.0		/* Scalar of scale and triad */
+#define MEMBW_INIT_A 1.0		/* Initial values, every kernel is idempotent over them */
+#define MEMBW_INIT_B 2.0
+#define MEMBW_INIT_C 0.5
+
+/* Kernels, in the order they run */
+enum membw_kernel {
+	MEMBW_COPY,		/* c = a */
+	MEMBW_SCALE,		/* b = s * c */
+	MEMBW_ADD,		/* c = a + b */
+	MEMBW_TRIAD,		/* a = b + s * c */
+	MEMBW_READ,		/* sum of a */
+	MEMBW_WRITE,		/* a = s */
+	MEMBW_NT_WRITE,		/* a = s with non-temporal stores */
+	MEMBW_ZERO,		/* a = 0, cache-line zeroing where the ISA has it */
+	MEMBW_NB_KERNELS,
+};
+
+/*
+ * One kernel over n elements of the thread's arrays, n is a multiple of MEMBW_ALIGN_ELEMS
+ *
+ * @a [in/out]: first array
+ * @b [in/out]: second array
+ * @c [in/out]: third array
+ * @n [in]: number of elements
+ * @return: sum for MEMBW_READ, 0 otherwise
+ */
+typedef double (*membw_fn)(double *a, double *b, double *c, size_t n);
+
+#define MEMBW_ALIGN 4096			/* Array alignment */
+#define MEMBW_ALIGN_ELEMS 512			/* Element count granularity, 4 KB, a multiple of every DC ZVA block */
+
+/* Kernels of one instruction set */
+struct membw_variant {
+	const char *name;			/* Name given to -v */
+	bool (*supported)(void);		/* Whether this CPU runs the variant */
+	membw_fn fn[MEMBW_NB_KERNELS];		/* Kernels, NULL where the variant has no such kernel */
+};
+
+extern const struct membw_variant membw_scalar;
+#if defined(__x86_64__)
+extern const struct membw_variant membw_avx2;
+extern const struct membw_variant membw_avx512;
+#elif defined(__aarch64__)
+extern const struct membw_variant membw_neon;
+#ifdef MEMBW_HAVE_SVE
+extern const struct membw_variant membw_sve;
+#endif
+#endif
+
+#endif
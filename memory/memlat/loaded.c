@@ -0,0 +1,349 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "memlat.h"
+
+#define LOAD_BUF_MB 128			/* Buffer of every load thread, far larger than its LLC share */
+#define CHUNK (64UL << 10)		/* Traffic between two rate checks */
+#define RAMP_MS 20			/* Load time before the chase starts */
+#define MAX_LAG_NS 1e6			/* Lag after which a throttled thread stops catching up */
+#define KNEE_FACTOR 2.0			/* Latency over idle that counts as the cliff */
+
+/* A load thread, cache-line aligned so the counters do not share lines */
+struct load_thread {
+	pthread_t tid;			/* Thread */
+	int core;			/* Core it is pinned to */
+	enum load_kind kind;		/* Traffic */
+	uint64_t *buf;			/* Buffer it streams over */
+	size_t words;			/* Words of the buffer */
+	double rate;			/* Target in bytes per ns, 0 for no limit */
+	uint64_t bytes;			/* Traffic so far, read by the main thread */
+	uint64_t sum;			/* Keeps the reads alive */
+} __attribute__((aligned(64)));
+
+/* A point of the curve */
+struct loaded_point {
+	double target;			/* Total load rate asked for in GB/s, 0 for no limit */
+	double achieved;		/* Total load rate reached during the chase */
+	double ns;			/* Chase latency */
+};
+
+static const char *const load_names[] = {"read", "write", "copy"};
+
+static pthread_barrier_t start_barrier, end_barrier;
+static int running;			/* Load threads generate traffic while set */
+static bool quit;			/* Load threads exit at the next start barrier */
+
+/*
+ * Stream one chunk of the buffer
+ *
+ * @t [in/out]: load thread
+ * @pos [in]: first word of the chunk
+ * @return: bytes of traffic
+ */
+static size_t
+load_chunk(struct load_thread *t, size_t pos)
+{
+	size_t words = CHUNK / sizeof(uint64_t), i;
+	uint64_t *p = t->buf + pos, *dst, sum = 0;
+
+	switch (t->kind) {
+	case LOAD_READ:
+		for (i = 0; i < words; i++)
+			sum += p[i];
+		t->sum += sum;
+		return CHUNK;
+	case LOAD_WRITE:
+		for (i = 0; i < words; i++)
+			p[i] = pos + i;
+		return CHUNK;
+	default:
+		/* Copy from the first half of the buffer into the second */
+		dst = p + t->words / 2;
+		for (i = 0; i < words / 2; i++)
+			dst[i] = p[i];
+		return CHUNK;
+	}
+}
+
+/*
+ * Generate traffic until running is cleared, spinning on the clock between chunks to hold the target rate
+ *
+ * @t [in/out]: load thread
+ */
+static void
+generate(struct load_thread *t)
+{
+	size_t span = t->kind == LOAD_COPY ? t->words / 2 : t->words, step = CHUNK / sizeof(uint64_t);
+	size_t pos = 0;
+	uint64_t bytes = 0;
+	double start = now_ns(), due, now;
+
+	if (t->kind == LOAD_COPY)
+		step /= 2;
+	while (__atomic_load_n(&running, __ATOMIC_ACQUIRE)) {
+		bytes += load_chunk(t, pos);
+		pos += step;
+		if (pos + step > span)
+			pos = 0;
+		__atomic_store_n(&t->bytes, t->bytes + CHUNK, __ATOMIC_RELAXED);
+		if (t->rate <= 0)
+			continue;
+		due = start + bytes / t->rate;
+		now = now_ns();
+		/* A thread that fell behind (descheduled) resumes at the rate instead of bursting */
+		if (now > due + MAX_LAG_NS)
+			start = now - bytes / t->rate;
+		while (now < due && __atomic_load_n(&running, __ATOMIC_RELAXED))
+			now = now_ns();
+	}
+}
+
+/*
+ * Load thread: pin, first-touch the buffer, then generate traffic once per round
+ *
+ * @arg [in]: struct load_thread
+ * @return: NULL
+ */
+static void *
+load_main(void *arg)
+{
+	struct load_thread *t = arg;
+	cpu_set_t set;
+	size_t i;
+
+	CPU_ZERO(&set);
+	CPU_SET(t->core, &set);
+	pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+	for (i = 0; i < t->words; i++)
+		t->buf[i] = i;
+
+	pthread_barrier_wait(&start_barrier);
+	for (;;) {
+		pthread_barrier_wait(&start_barrier);
+		if (quit)
+			break;
+		generate(t);
+		pthread_barrier_wait(&end_barrier);
+	}
+	return NULL;
+}
+
+/*
+ * Chase latency while the load threads run at one total rate
+ *
+ * @threads [in/out]: load threads
+ * @nb [in]: number of load threads
+ * @p [in/out]: point, target in, achieved and ns out
+ * @start [in]: chain start
+ * @accesses [in]: loads of the chase
+ */
+static void
+measure_point(struct load_thread *threads, int nb, struct loaded_point *p, void *start, size_t accesses)
+{
+	struct timespec ramp = {0, RAMP_MS * 1000000L};
+	uint64_t before = 0, after = 0;
+	double t0, t1;
+	int i;
+
+	for (i = 0; i < nb; i++)
+		threads[i].rate = p->target / nb;
+	__atomic_store_n(&running, 1, __ATOMIC_RELEASE);
+	pthread_barrier_wait(&start_barrier);
+	nanosleep(&ramp, NULL);
+
+	for (i = 0; i < nb; i++)
+		before += __atomic_load_n(&threads[i].bytes, __ATOMIC_RELAXED);
+	t0 = now_ns();
+	p->ns = time_chase(&start, 1, accesses, 0);
+	t1 = now_ns();
+	for (i = 0; i < nb; i++)
+		after += __atomic_load_n(&threads[i].bytes, __ATOMIC_RELAXED);
+
+	__atomic_store_n(&running, 0, __ATOMIC_RELEASE);
+	pthread_barrier_wait(&end_barrier);
+	/* Bytes per ns is GB/s */
+	p->achieved = (after - before) / (t1 - t0);
+}
+
+/*
+ * Start the load threads, each pinned and with its own first-touched buffer
+ *
+ * @cfg [in]: configuration
+ * @threads [out]: load threads
+ * @return: 0 on success and -1 otherwise
+ */
+static int
+start_loads(const struct memlat_config *cfg, struct load_thread *threads)
+{
+	int i;
+
+	pthread_barrier_init(&start_barrier, NULL, cfg->nb_load_cores + 1);
+	pthread_barrier_init(&end_barrier, NULL, cfg->nb_load_cores + 1);
+	quit = false;
+	for (i = 0; i < cfg->nb_load_cores; i++) {
+		threads[i].core = cfg->load_cores[i];
+		threads[i].kind = cfg->load;
+		threads[i].words = ((size_t)LOAD_BUF_MB << 20) / sizeof(uint64_t);
+		if (posix_memalign((void **)&threads[i].buf, 4096, (size_t)LOAD_BUF_MB << 20) != 0)
+			break;
+		if (pthread_create(&threads[i].tid, NULL, load_main, &threads[i]) != 0) {
+			free(threads[i].buf);
+			break;
+		}
+	}
+	if (i < cfg->nb_load_cores) {
+		/* The started threads stay blocked in the init barrier until the process exits */
+		fprintf(stderr, "Failed to start load thread %d\n", i);
+		return -1;
+	}
+	pthread_barrier_wait(&start_barrier);
+	return 0;
+}
+
+/*
+ * Stop and join the load threads
+ *
+ * @threads [in/out]: load threads
+ * @nb [in]: number of load threads
+ */
+static void
+stop_loads(struct load_thread *threads, int nb)
+{
+	int i;
+
+	quit = true;
+	pthread_barrier_wait(&start_barrier);
+	for (i = 0; i < nb; i++) {
+		pthread_join(threads[i].tid, NULL);
+		free(threads[i].buf);
+	}
+	pthread_barrier_destroy(&start_barrier);
+	pthread_barrier_destroy(&end_barrier);
+}
+
+/*
+ * Print one point of the curve
+ *
+ * @cfg [in]: configuration
+ * @mode [in]: page mode of the chain
+ * @p [in]: point, a negative target for the idle point
+ * @idle [in]: unloaded latency
+ */
+static void
+print_point(const struct memlat_config *cfg, const struct page_mode *mode, const struct loaded_point *p,
+	    double idle)
+{
+	if (p->target < 0)
+		printf("idle");
+	else if (p->target > 0)
+		printf("%.2f", p->target);
+	else
+		printf("max");
+	printf("\t\t %.2f\t\t %.2f\t %.2fx\n", p->achieved, p->ns, p->ns / idle);
+	printf("LOADED %s %s %d %.3f %.3f %.3f\n", mode->name, load_names[cfg->load],
+	       p->target < 0 ? 0 : cfg->nb_load_cores, p->target < 0 ? 0 : p->target, p->achieved, p->ns);
+	fflush(stdout);
+}
+
+int
+run_loaded(const struct memlat_config *cfg)
+{
+	struct load_thread *threads;
+	struct loaded_point points[MAX_RATES], idle = {-1, 0, 0};
+	const struct page_mode *mode = NULL;
+	size_t size = 0, n;
+	int nb_points = 0, m, i;
+	void *start;
+	char *buf = NULL;
+
+	/* Chase on the largest selected page that allocates, so the curve shows memory and not TLB misses */
+	for (m = NB_PAGE_MODES - 1; m >= 0 && buf == NULL; m--) {
+		if (!cfg->modes[m])
+			continue;
+		mode = &page_modes[m];
+		size = cfg->max_size;
+		buf = alloc_buffer(mode, &size);
+	}
+	if (buf == NULL) {
+		fprintf(stderr, "Failed to allocate the chain\n");
+		return -1;
+	}
+	n = build_chain(buf, size, cfg->kind, cfg->seed, 1, &start);
+	if (n == 0) {
+		fprintf(stderr, "Failed to build the chain\n");
+		free_buffer(mode, buf, size);
+		return -1;
+	}
+	threads = aligned_alloc(64, sizeof(*threads) * cfg->nb_load_cores);
+	if (threads == NULL) {
+		free_buffer(mode, buf, size);
+		return -1;
+	}
+	memset(threads, 0, sizeof(*threads) * cfg->nb_load_cores);
+
+	idle.ns = time_chase(&start, 1, cfg->accesses, n);
+	if (start_loads(cfg, threads) != 0)
+		return -1;
+
+	/* No limit first, the sweep is in fractions of that peak */
+	if (cfg->nb_rates == 0) {
+		points[cfg->steps - 1].target = 0;
+		measure_point(threads, cfg->nb_load_cores, &points[cfg->steps - 1], start, cfg->accesses);
+		for (i = 0; i < cfg->steps - 1; i++) {
+			points[i].target = points[cfg->steps - 1].achieved * (i + 1) / cfg->steps;
+			measure_point(threads, cfg->nb_load_cores, &points[i], start, cfg->accesses);
+		}
+		nb_points = cfg->steps;
+	} else {
+		for (i = 0; i < cfg->nb_rates; i++) {
+			points[i].target = cfg->rates[i];
+			measure_point(threads, cfg->nb_load_cores, &points[i], start, cfg->accesses);
+		}
+		nb_points = cfg->nb_rates;
+	}
+	stop_loads(threads, cfg->nb_load_cores);
+	free(threads);
+	free_buffer(mode, buf, size);
+
+	printf("Loaded latency: %zu KB chain on %s pages, core %d, %d %s load thread%s\n", size >> 10, mode->name,
+	       cfg->core, cfg->nb_load_cores, load_names[cfg->load], cfg->nb_load_cores > 1 ? "s" : "");
+	printf("Target(GB/s)\t Load(GB/s)\t Latency(ns)\t vs idle\n");
+	print_point(cfg, mode, &idle, idle.ns);
+	for (i = 0; i < nb_points; i++)
+		print_point(cfg, mode, &points[i], idle.ns);
+
+	/* The cliff: the least traffic at which the chase is KNEE_FACTOR times slower than idle */
+	m = -1;
+	for (i = 0; i < nb_points; i++) {
+		if (points[i].ns >= KNEE_FACTOR * idle.ns && (m < 0 || points[i].achieved < points[m].achieved))
+			m = i;
+	}
+	if (m < 0) {
+		printf("Latency stays under %.1fx idle (%.2f ns) up to the peak\n\n", KNEE_FACTOR, idle.ns);
+		return 0;
+	}
+	printf("Latency reaches %.1fx idle (%.2f ns) at %.2f GB/s\n", KNEE_FACTOR, idle.ns, points[m].achieved);
+	printf("KNEE %s %s %d %.3f %.3f\n\n", mode->name, load_names[cfg->load], cfg->nb_load_cores,
+	       points[m].achieved, points[m].ns);
+	return 0;
+}
@@ -0,0 +1,690 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+#define _GNU_SOURCE
+#include <getopt.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+
+#include "memlat.h"
+
+const struct page_mode page_modes[NB_PAGE_MODES] = {
+	{"4k", 4096, 0, MADV_NOHUGEPAGE},
+	{"thp", 2UL << 20, 0, MADV_HUGEPAGE},
+	{"2m", 2UL << 20, MAP_HUGETLB | (21 << MAP_HUGE_SHIFT), -1},
+	{"1g", 1UL << 30, MAP_HUGETLB | (30 << MAP_HUGE_SHIFT), -1},
+};
+
+static volatile uintptr_t sink;		/* Keeps the chase alive */
+
+double
+now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/*
+ * xorshift64* step
+ *
+ * @state [in/out]: generator state, never 0
+ * @return: next random number
+ */
+static uint64_t
+next_rand(uint64_t *state)
+{
+	*state ^= *state >> 12;
+	*state ^= *state << 25;
+	*state ^= *state >> 27;
+	return *state * 0x2545f4914f6cdd1dULL;
+}
+
+/*
+ * Chase one chain for steps loads
+ *
+ * @p [in]: start of the chain
+ * @steps [in]: number of loads, a multiple of 8
+ * @return: end of the chain
+ */
+static void *
+chase1(void *p, size_t steps)
+{
+	size_t i;
+
+	for (i = 0; i < steps; i += 8) {
+		p = *(void **)p;
+		p = *(void **)p;
+		p = *(void **)p;
+		p = *(void **)p;
+		p = *(void **)p;
+		p = *(void **)p;
+		p = *(void **)p;
+		p = *(void **)p;
+	}
+	return p;
+}
+
+/*
+ * Chase N independent chains in lockstep, the loads of one step can all be in flight at once
+ */
+#define DEFINE_CHASE(N)								\
+static void *									\
+chase##N(void **start, size_t steps)						\
+{										\
+	void *p[N];								\
+	uintptr_t x = 0;							\
+	size_t i;								\
+	int j;									\
+										\
+	for (j = 0; j < N; j++)							\
+		p[j] = start[j];						\
+	for (i = 0; i < steps; i++) {						\
+		_Pragma("GCC unroll 32")					\
+		for (j = 0; j < N; j++)						\
+			p[j] = *(void **)p[j];					\
+	}									\
+	for (j = 0; j < N; j++)							\
+		x ^= (uintptr_t)p[j];						\
+	return (void *)x;							\
+}
+
+DEFINE_CHASE(2)
+DEFINE_CHASE(4)
+DEFINE_CHASE(8)
+DEFINE_CHASE(16)
+DEFINE_CHASE(32)
+
+char *
+alloc_buffer(const struct page_mode *mode, size_t *size)
+{
+	size_t len;
+	void *buf;
+
+	for (; *size >= MIN_SIZE; *size /= 2) {
+		len = (*size + mode->page_size - 1) / mode->page_size * mode->page_size;
+		buf = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | mode->mmap_flags, -1, 0);
+		if (buf == MAP_FAILED)
+			continue;
+		if (mode->advice >= 0)
+			madvise(buf, len, mode->advice);
+		/* Fault in only after the advice, or THP=always would already have backed 4k with huge pages */
+		memset(buf, 0, len);
+		return buf;
+	}
+	return NULL;
+}
+
+void
+free_buffer(const struct page_mode *mode, char *buf, size_t size)
+{
+	munmap(buf, (size + mode->page_size - 1) / mode->page_size * mode->page_size);
+}
+
+/*
+ * Offset of an element inside its slot: a random line of the page for the page chain, a fixed offset would pile
+ * every load onto one cache set
+ *
+ * @kind [in]: chain layout
+ * @idx [in]: slot of the element
+ * @return: offset in bytes
+ */
+static size_t
+element_offset(enum chain_kind kind, uint32_t idx)
+{
+	if (kind == CHAIN_LINE)
+		return 0;
+	return (idx * 0x9e3779b1u >> 7) % (BASE_PAGE / LINE) * LINE;
+}
+
+size_t
+build_chain(char *buf, size_t size, enum chain_kind kind, uint64_t seed, int nb_chains, void **starts)
+{
+	size_t stride = kind == CHAIN_LINE ? LINE : BASE_PAGE;
+	size_t n = size / stride, i, j;
+	uint64_t state = seed ? seed : 1;
+	uint32_t *order, tmp;
+	char *elem, *next;
+
+	if (n < 2)
+		return 0;
+	order = malloc(n * sizeof(*order));
+	if (order == NULL)
+		return 0;
+	for (i = 0; i < n; i++)
+		order[i] = i;
+	for (i = n - 1; i > 0; i--) {
+		j = next_rand(&state) % (i + 1);
+		tmp = order[i];
+		order[i] = order[j];
+		order[j] = tmp;
+	}
+
+	for (i = 0; i < n; i++) {
+		elem = buf + (size_t)order[i] * stride + element_offset(kind, order[i]);
+		next = buf + (size_t)order[(i + 1) % n] * stride + element_offset(kind, order[(i + 1) % n]);
+		*(void **)elem = next;
+	}
+	for (i = 0; i < (size_t)nb_chains; i++) {
+		j = order[i * n / nb_chains];
+		starts[i] = buf + j * stride + element_offset(kind, j);
+	}
+	free(order);
+	return n;
+}
+
+double
+time_chase(void **starts, int nb_chains, size_t accesses, size_t warm)
+{
+	size_t steps = (accesses / nb_chains + 7) / 8 * 8;
+	double start, end;
+
+	if (warm > 0)
+		sink ^= (uintptr_t)chase1(starts[0], (warm + 7) / 8 * 8);
+	start = now_ns();
+	switch (nb_chains) {
+	case 1:
+		sink ^= (uintptr_t)chase1(starts[0], steps);
+		break;
+	case 2:
+		sink ^= (uintptr_t)chase2(starts, steps);
+		break;
+	case 4:
+		sink ^= (uintptr_t)chase4(starts, steps);
+		break;
+	case 8:
+		sink ^= (uintptr_t)chase8(starts, steps);
+		break;
+	case 16:
+		sink ^= (uintptr_t)chase16(starts, steps);
+		break;
+	default:
+		sink ^= (uintptr_t)chase32(starts, steps);
+		break;
+	}
+	end = now_ns();
+	return (end - start) / (steps * nb_chains);
+}
+
+/*
+ * Read the data and unified cache levels of the chase core from sysfs
+ *
+ * @core [in]: core
+ * @levels [out]: levels, smallest first
+ * @return: number of levels, 0 if sysfs has none
+ */
+static int
+read_cache_levels(int core, struct cache_level *levels)
+{
+	char path[128], type[32];
+	unsigned long size;
+	int idx, level, nb = 0;
+	char unit;
+	FILE *fp;
+
+	for (idx = 0; idx < 16 && nb < MAX_LEVELS; idx++) {
+		snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cache/index%d/type", core, idx);
+		fp = fopen(path, "r");
+		if (fp == NULL)
+			break;
+		if (fscanf(fp, "%31s", type) != 1)
+			type[0] = '\0';
+		fclose(fp);
+		if (strcmp(type, "Instruction") == 0)
+			continue;
+
+		snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cache/index%d/level", core, idx);
+		fp = fopen(path, "r");
+		if (fp == NULL)
+			continue;
+		if (fscanf(fp, "%d", &level) != 1)
+			level = 0;
+		fclose(fp);
+
+		snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cache/index%d/size", core, idx);
+		fp = fopen(path, "r");
+		if (fp == NULL)
+			continue;
+		unit = 'K';
+		if (fscanf(fp, "%lu%c", &size, &unit) < 1 || level == 0) {
+			fclose(fp);
+			continue;
+		}
+		fclose(fp);
+		levels[nb].size = size << (unit == 'M' ? 20 : unit == 'G' ? 30 : 10);
+		snprintf(levels[nb].name, sizeof(levels[nb].name), "L%d%s", level,
+			 strcmp(type, "Data") == 0 ? "d" : "");
+		nb++;
+	}
+	return nb;
+}
+
+/*
+ * Latency of the largest swept working set not above a size
+ *
+ * @sizes [in]: swept sizes, ascending
+ * @lat [in]: one-chain latency of every size
+ * @nb_sizes [in]: number of sizes
+ * @size [in]: size
+ * @at [out]: working set used
+ * @return: latency, negative if no swept size fits
+ */
+static double
+latency_at(const size_t *sizes, const double *lat, int nb_sizes, size_t size, size_t *at)
+{
+	int i;
+
+	for (i = nb_sizes - 1; i >= 0; i--) {
+		if (sizes[i] <= size && lat[i] > 0) {
+			*at = sizes[i];
+			return lat[i];
+		}
+	}
+	return -1;
+}
+
+/*
+ * Sweep every working set of one page mode
+ *
+ * @cfg [in]: configuration
+ * @mode [in]: page mode
+ * @levels [in]: cache levels
+ * @nb_levels [in]: number of cache levels
+ * @dram_lat [out]: one-chain latency at the largest working set
+ * @dram_size [out]: largest working set, 0 if it did not reach DRAM
+ * @return: 0 on success and -1 otherwise
+ */
+static int
+run_mode(const struct memlat_config *cfg, const struct page_mode *mode, const struct cache_level *levels,
+	 int nb_levels, double *dram_lat, size_t *dram_size)
+{
+	static const char *const kind_names[] = {"line", "page"};
+	size_t sizes[MAX_SIZES], size, alloc = cfg->max_size, n, at;
+	double lat1[MAX_SIZES], ns_chain[MAX_CHAINS], ns;
+	void *starts[MAX_CHAINS];
+	int nb_sizes = 0, i, c;
+	char *buf;
+
+	*dram_size = 0;
+	buf = alloc_buffer(mode, &alloc);
+	if (buf == NULL) {
+		printf("Pages %s: allocation failed, skipped (hugetlb pages reserved?)\n\n", mode->name);
+		return 0;
+	}
+	if (alloc < cfg->max_size)
+		printf("Pages %s: only %zu bytes could be allocated\n", mode->name, alloc);
+
+	printf("Pages %s, %s chain, core %d, ns per load\n", mode->name, kind_names[cfg->kind], cfg->core);
+	printf("Size(KB)");
+	for (c = 0; c < cfg->nb_chains; c++)
+		printf("\t %d chain%s", cfg->chains[c], cfg->chains[c] > 1 ? "s (MLP)" : "");
+	printf("\n");
+
+	for (size = MIN_SIZE; size <= alloc && nb_sizes < MAX_SIZES; size *= 2) {
+		for (c = 0; c < cfg->nb_chains; c++) {
+			n = build_chain(buf, size, cfg->kind, cfg->seed + size, cfg->chains[c], starts);
+			ns_chain[c] = -1;
+			if (n >= (size_t)cfg->chains[c])
+				ns_chain[c] = time_chase(starts, cfg->chains[c], cfg->accesses, n);
+		}
+		/* MLP is how many loads overlap: one-chain latency over the per-load time of k chains */
+		sizes[nb_sizes] = size;
+		lat1[nb_sizes] = cfg->chains[0] == 1 ? ns_chain[0] : -1;
+		printf("%zu", size >> 10);
+		for (c = 0; c < cfg->nb_chains; c++) {
+			if (ns_chain[c] < 0)
+				printf("\t -");
+			else if (cfg->chains[c] > 1 && lat1[nb_sizes] > 0)
+				printf("\t %.2f (%.1fx)", ns_chain[c], lat1[nb_sizes] / ns_chain[c]);
+			else
+				printf("\t %.2f", ns_chain[c]);
+		}
+		printf("\n");
+		for (c = 0; c < cfg->nb_chains; c++) {
+			if (ns_chain[c] < 0)
+				continue;
+			printf("MEMLAT %s %s %zu %d %.3f %.2f\n", mode->name, kind_names[cfg->kind], size,
+			       cfg->chains[c], ns_chain[c], lat1[nb_sizes] > 0 ? lat1[nb_sizes] / ns_chain[c] : 1.0);
+		}
+		fflush(stdout);
+		nb_sizes++;
+	}
+	free_buffer(mode, buf, alloc);
+
+	/* Plateaus: half of every cache level so the level holds the whole set, DRAM needs twice the last level */
+	if (nb_sizes == 0 || lat1[nb_sizes - 1] <= 0) {
+		printf("\n");
+		return 0;
+	}
+	printf("Plateaus (1 chain)\n");
+	for (i = 0; i < nb_levels; i++) {
+		ns = latency_at(sizes, lat1, nb_sizes, levels[i].size / 2, &at);
+		if (ns < 0)
+			continue;
+		printf("%s (%zu KB)\t %.2f ns at %zu KB\n", levels[i].name, levels[i].size >> 10, ns, at >> 10);
+		printf("LEVEL %s %s %zu %.3f\n", mode->name, levels[i].name, at, ns);
+	}
+	if (nb_levels > 0 && sizes[nb_sizes - 1] < 2 * levels[nb_levels - 1].size) {
+		printf("DRAM\t\t not reached, raise -M above %zu MB\n", levels[nb_levels - 1].size >> 19);
+	} else {
+		*dram_lat = lat1[nb_sizes - 1];
+		*dram_size = sizes[nb_sizes - 1];
+		printf("DRAM\t\t %.2f ns at %zu KB\n", *dram_lat, *dram_size >> 10);
+		printf("LEVEL %s DRAM %zu %.3f\n", mode->name, *dram_size, *dram_lat);
+	}
+	printf("\n");
+	return 0;
+}
+
+/*
+ * Parse a comma separated list of chain counts, 1 is always measured first as the MLP baseline
+ *
+ * @list [in]: list, modified
+ * @cfg [out]: configuration receiving the chain counts
+ * @return: 0 on success and -1 otherwise
+ */
+static int
+parse_chains(char *list, struct memlat_config *cfg)
+{
+	char *tok, *saveptr;
+	int n;
+
+	cfg->chains[0] = 1;
+	cfg->nb_chains = 1;
+	for (tok = strtok_r(list, LIST_SEP, &saveptr); tok != NULL; tok = strtok_r(NULL, LIST_SEP, &saveptr)) {
+		n = atoi(tok);
+		if (n == 1)
+			continue;
+		if ((n != 2 && n != 4 && n != 8 && n != 16 && n != 32) || cfg->nb_chains == MAX_CHAINS) {
+			fprintf(stderr, "Chain count %s must be one of 1,2,4,8,16,32\n", tok);
+			return -1;
+		}
+		cfg->chains[cfg->nb_chains++] = n;
+	}
+	return 0;
+}
+
+/*
+ * Parse a comma separated list of page modes
+ *
+ * @list [in]: list, modified
+ * @cfg [out]: configuration receiving the selected modes
+ * @return: 0 on success and -1 otherwise
+ */
+static int
+parse_modes(char *list, struct memlat_config *cfg)
+{
+	char *tok, *saveptr;
+	size_t m;
+
+	memset(cfg->modes, 0, sizeof(cfg->modes));
+	for (tok = strtok_r(list, LIST_SEP, &saveptr); tok != NULL; tok = strtok_r(NULL, LIST_SEP, &saveptr)) {
+		for (m = 0; m < NB_PAGE_MODES; m++) {
+			if (strcmp(tok, page_modes[m].name) == 0)
+				break;
+		}
+		if (m == NB_PAGE_MODES) {
+			fprintf(stderr, "Unknown page mode %s\n", tok);
+			return -1;
+		}
+		cfg->modes[m] = true;
+	}
+	return 0;
+}
+
+/*
+ * Parse a core list such as "0-3,6"
+ *
+ * @list [in]: core list
+ * @cfg [out]: load_cores and nb_load_cores
+ * @return: 0 on success and -1 otherwise
+ */
+static int
+parse_cores(const char *list, struct memlat_config *cfg)
+{
+	const char *p = list;
+	char *end;
+	long first, last, c;
+
+	cfg->nb_load_cores = 0;
+	while (*p != '\0') {
+		first = strtol(p, &end, 10);
+		if (end == p || first < 0)
+			return -1;
+		last = first;
+		if (*end == '-') {
+			p = end + 1;
+			last = strtol(p, &end, 10);
+			if (end == p || last < first)
+				return -1;
+		}
+		for (c = first; c <= last; c++) {
+			if (cfg->nb_load_cores == MAX_CORES || c >= CPU_SETSIZE)
+				return -1;
+			cfg->load_cores[cfg->nb_load_cores++] = c;
+		}
+		if (*end == ',')
+			end++;
+		else if (*end != '\0')
+			return -1;
+		p = end;
+	}
+	return cfg->nb_load_cores > 0 ? 0 : -1;
+}
+
+/*
+ * Parse a comma separated list of load rates in GB/s, 0 for no limit
+ *
+ * @list [in]: list, modified
+ * @cfg [out]: configuration receiving the rates
+ * @return: 0 on success and -1 otherwise
+ */
+static int
+parse_rates(char *list, struct memlat_config *cfg)
+{
+	char *tok, *saveptr;
+	double rate;
+
+	cfg->nb_rates = 0;
+	for (tok = strtok_r(list, LIST_SEP, &saveptr); tok != NULL; tok = strtok_r(NULL, LIST_SEP, &saveptr)) {
+		rate = atof(tok);
+		if (rate < 0 || cfg->nb_rates == MAX_RATES) {
+			fprintf(stderr, "Invalid load rate %s\n", tok);
+			return -1;
+		}
+		cfg->rates[cfg->nb_rates++] = rate;
+	}
+	return 0;
+}
+
+/*
+ * Print the usage
+ *
+ * @prog [in]: program name
+ */
+static void
+usage(const char *prog)
+{
+	printf("Usage: %s [-c core] [-M MB] [-p pages] [-P chains] [-k line|page] [-n accesses] [-S seed]\n", prog);
+	printf("       %s -L cores [-w read|write|copy] [-B rates | -s steps] [-c core] [-M MB] [-p pages]\n", prog);
+	printf("Memory latency: randomized pointer chains over working sets from 4 KB up,\n");
+	printf("on 4 KB, 2 MB and 1 GB pages, with independent chains for memory-level parallelism.\n");
+	printf("Prints MEMLAT <pages> <chain> <bytes> <chains> <ns per load> <MLP> for every point and\n");
+	printf("LEVEL <pages> <level> <bytes> <ns> for every latency plateau.\n");
+	printf("With -L, chases one -M MB chain while threads on the load cores stream at throttled rates, and\n");
+	printf("prints KNEE <pages> <load> <threads> <load GB/s> <ns> where latency doubles and\n");
+	printf("LOADED <pages> <load> <threads> <target GB/s> <load GB/s> <ns> for every rate.\n");
+	printf("  -c, --core <n>           core the chase runs on (default: 0)\n");
+	printf("  -M, --max <MB>           largest working set (default: %d)\n", DEFAULT_MAX_MB);
+	printf("  -p, --pages <list>       4k,thp,2m,1g, 2m and 1g need reserved hugetlb pages (default: 4k,2m,1g)\n");
+	printf("  -P, --chains <list>      chains walked at once, from 1,2,4,8,16,32 (default: 1)\n");
+	printf("  -k, --chain <kind>       line: every cache line, page: one line per 4 KB page (default: line)\n");
+	printf("  -n, --accesses <n>       loads per point over all chains (default: %lu)\n", DEFAULT_ACCESSES);
+	printf("  -S, --seed <n>           seed of the random chains (default: 1)\n");
+	printf("  -L, --load-cores <list>  loaded latency with one load thread per core, e.g. 1-7\n");
+	printf("  -w, --load <kind>        read, write or copy traffic of the load threads (default: read)\n");
+	printf("  -B, --rates <list>       total load rates in GB/s, 0 for no limit (default: a sweep to the peak)\n");
+	printf("  -s, --steps <n>          points of the sweep, in equal fractions of the peak (default: %d)\n",
+	       DEFAULT_STEPS);
+}
+
+/*
+ * Memory latency benchmark main function
+ *
+ * @argc [in]: command line arguments size
+ * @argv [in]: array of command line arguments
+ * @return: EXIT_SUCCESS on success and EXIT_FAILURE otherwise
+ */
+int
+main(int argc, char **argv)
+{
+	static const struct option long_opts[] = {
+		{"core", required_argument, NULL, 'c'},
+		{"max", required_argument, NULL, 'M'},
+		{"pages", required_argument, NULL, 'p'},
+		{"chains", required_argument, NULL, 'P'},
+		{"chain", required_argument, NULL, 'k'},
+		{"accesses", required_argument, NULL, 'n'},
+		{"seed", required_argument, NULL, 'S'},
+		{"load-cores", required_argument, NULL, 'L'},
+		{"load", required_argument, NULL, 'w'},
+		{"rates", required_argument, NULL, 'B'},
+		{"steps", required_argument, NULL, 's'},
+		{"help", no_argument, NULL, 'h'},
+		{NULL, 0, NULL, 0},
+	};
+	struct cache_level levels[MAX_LEVELS];
+	double dram_lat[NB_PAGE_MODES] = {0};
+	size_t dram_size[NB_PAGE_MODES] = {0};
+	struct memlat_config cfg = {0};
+	int c, nb_levels, exit_status = EXIT_SUCCESS;
+	size_t m, huge;
+	cpu_set_t set;
+
+	cfg.max_size = (size_t)DEFAULT_MAX_MB << 20;
+	cfg.accesses = DEFAULT_ACCESSES;
+	cfg.modes[0] = cfg.modes[2] = cfg.modes[3] = true;
+	cfg.chains[0] = 1;
+	cfg.nb_chains = 1;
+	cfg.kind = CHAIN_LINE;
+	cfg.seed = 1;
+	cfg.load = LOAD_READ;
+	cfg.steps = DEFAULT_STEPS;
+
+	while ((c = getopt_long(argc, argv, "c:M:p:P:k:n:S:L:w:B:s:h", long_opts, NULL)) != -1) {
+		switch (c) {
+		case 'c':
+			cfg.core = atoi(optarg);
+			break;
+		case 'M':
+			cfg.max_size = strtoull(optarg, NULL, 0) << 20;
+			break;
+		case 'p':
+			if (parse_modes(optarg, &cfg) != 0)
+				return EXIT_FAILURE;
+			break;
+		case 'P':
+			if (parse_chains(optarg, &cfg) != 0)
+				return EXIT_FAILURE;
+			break;
+		case 'k':
+			if (strcmp(optarg, "line") == 0) {
+				cfg.kind = CHAIN_LINE;
+			} else if (strcmp(optarg, "page") == 0) {
+				cfg.kind = CHAIN_PAGE;
+			} else {
+				fprintf(stderr, "Unknown chain kind %s\n", optarg);
+				return EXIT_FAILURE;
+			}
+			break;
+		case 'n':
+			cfg.accesses = strtoull(optarg, NULL, 0);
+			break;
+		case 'S':
+			cfg.seed = strtoull(optarg, NULL, 0);
+			break;
+		case 'L':
+			if (parse_cores(optarg, &cfg) != 0) {
+				fprintf(stderr, "Invalid core list %s\n", optarg);
+				return EXIT_FAILURE;
+			}
+			break;
+		case 'w':
+			if (strcmp(optarg, "read") == 0) {
+				cfg.load = LOAD_READ;
+			} else if (strcmp(optarg, "write") == 0) {
+				cfg.load = LOAD_WRITE;
+			} else if (strcmp(optarg, "copy") == 0) {
+				cfg.load = LOAD_COPY;
+			} else {
+				fprintf(stderr, "Unknown load %s\n", optarg);
+				return EXIT_FAILURE;
+			}
+			break;
+		case 'B':
+			if (parse_rates(optarg, &cfg) != 0)
+				return EXIT_FAILURE;
+			break;
+		case 's':
+			cfg.steps = atoi(optarg);
+			break;
+		case 'h':
+			usage(argv[0]);
+			return EXIT_SUCCESS;
+		default:
+			usage(argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+	if (cfg.max_size < MIN_SIZE || cfg.accesses < 1024) {
+		fprintf(stderr, "The working set must be at least 4 KB and a point at least 1024 loads\n");
+		return EXIT_FAILURE;
+	}
+
+	CPU_ZERO(&set);
+	CPU_SET(cfg.core, &set);
+	if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+		fprintf(stderr, "Failed to pin to core %d\n", cfg.core);
+		return EXIT_FAILURE;
+	}
+	if (cfg.nb_load_cores > 0) {
+		if (cfg.steps < 1 || cfg.steps > MAX_RATES) {
+			fprintf(stderr, "Steps must be in [1, %d]\n", MAX_RATES);
+			return EXIT_FAILURE;
+		}
+		return run_loaded(&cfg) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+	nb_levels = read_cache_levels(cfg.core, levels);
+
+	for (m = 0; m < NB_PAGE_MODES; m++) {
+		if (cfg.modes[m] && run_mode(&cfg, &page_modes[m], levels, nb_levels, &dram_lat[m], &dram_size[m]) != 0)
+			exit_status = EXIT_FAILURE;
+	}
+
+	/* TLB-miss cost: the same DRAM-sized set on 4 KB pages against the largest huge page that covered it */
+	for (huge = NB_PAGE_MODES - 1; huge > 0; huge--) {
+		if (dram_size[huge] != 0 && dram_size[huge] == dram_size[0])
+			break;
+	}
+	if (huge > 0) {
+		printf("TLB-miss penalty (4k vs %s at %zu KB)\t %.2f ns\n", page_modes[huge].name, dram_size[0] >> 10,
+		       dram_lat[0] - dram_lat[huge]);
+		printf("LEVEL 4k TLB %zu %.3f\n", dram_size[0], dram_lat[0] - dram_lat[huge]);
+	}
+	return exit_status;
+}
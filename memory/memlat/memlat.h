@@ -0,0 +1,143 @@
+/*
+* Copyright (c) 2025, University of California, Merced. All rights reserved.
+*
+* This file is part of the benchmarking software package developed by
+* the team members of Prof. Xiaoyi Lu's group at University of California, Merced.
+*
+* For detailed copyright and licensing information, please refer to the license
+* file LICENSE in the top level directory.
+*
+*/
+
+
+#ifndef MEMLAT_H_
+#define MEMLAT_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/mman.h>
+
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+
+#define LINE 64				/* Chain element, one cache line */
+#define BASE_PAGE 4096			/* Page of the page chain, the smallest page everywhere */
+#define MIN_SIZE (4UL << 10)		/* Smallest working set */
+#define DEFAULT_MAX_MB 1024		/* Largest working set */
+#define DEFAULT_ACCESSES (1UL << 22)	/* Loads per point, split over the chains */
+#define DEFAULT_STEPS 10		/* Points of a loaded-latency sweep */
+#define MAX_CHAINS 32			/* Most chains walked at once */
+#define MAX_SIZES 64			/* Most working sets of a sweep */
+#define MAX_LEVELS 8			/* Most cache levels read from sysfs */
+#define MAX_CORES 256			/* Most load threads */
+#define MAX_RATES 64			/* Most load rates of a loaded-latency sweep */
+#define LIST_SEP ","			/* Separator of the -p, -P, -L and -B lists */
+
+/* Page backing of the chain */
+struct page_mode {
+	const char *name;	/* Name given to -p */
+	size_t page_size;	/* Allocation granularity */
+	int mmap_flags;		/* Extra mmap flags */
+	int advice;		/* madvise advice, -1 for none */
+};
+
+#define NB_PAGE_MODES 4			/* 4k, thp, 2m and 1g */
+extern const struct page_mode page_modes[NB_PAGE_MODES];
+
+/* Layout of the chain */
+enum chain_kind {
+	CHAIN_LINE,	/* Every line of the working set in random order: cache and TLB misses */
+	CHAIN_PAGE,	/* One line per 4 KB page in random page order: mostly TLB misses */
+};
+
+/* Traffic of the loaded-latency threads */
+enum load_kind {
+	LOAD_READ,	/* Loads only */
+	LOAD_WRITE,	/* Stores only */
+	LOAD_COPY,	/* Half loads, half stores */
+};
+
+/* A cache level from sysfs */
+struct cache_level {
+	char name[16];		/* e.g. L1d */
+	size_t size;		/* Size in bytes */
+};
+
+/* Benchmark configuration, from the command line */
+struct memlat_config {
+	int core;				/* Core the chase runs on */
+	size_t max_size;			/* Largest working set */
+	size_t accesses;			/* Loads per point */
+	bool modes[NB_PAGE_MODES];		/* Selected page modes */
+	int chains[MAX_CHAINS];			/* Chain counts */
+	int nb_chains;				/* Number of chain counts */
+	enum chain_kind kind;			/* Chain layout */
+	uint64_t seed;				/* Seed of the permutations */
+	int load_cores[MAX_CORES];		/* Cores of the load threads, none for the idle sweep */
+	int nb_load_cores;			/* Number of load threads */
+	enum load_kind load;			/* Traffic of the load threads */
+	double rates[MAX_RATES];		/* Total load rates in GB/s, none for a sweep up to the peak */
+	int nb_rates;				/* Number of load rates */
+	int steps;				/* Points of the sweep up to the peak */
+};
+
+/*
+ * Current CLOCK_MONOTONIC time
+ *
+ * @return: time in nanoseconds
+ */
+double now_ns(void);
+
+/*
+ * Allocate the buffer of a page mode, halving the size until the allocation succeeds
+ *
+ * @mode [in]: page mode
+ * @size [in/out]: wanted size, then the allocated size
+ * @return: buffer, NULL if even MIN_SIZE could not be allocated
+ */
+char *alloc_buffer(const struct page_mode *mode, size_t *size);
+
+/*
+ * Free a buffer from alloc_buffer()
+ *
+ * @mode [in]: page mode it was allocated with
+ * @buf [in]: buffer
+ * @size [in]: allocated size
+ */
+void free_buffer(const struct page_mode *mode, char *buf, size_t size);
+
+/*
+ * Link a random single cycle over the working set, every element on its own line
+ *
+ * @buf [in]: buffer
+ * @size [in]: working set
+ * @kind [in]: one element per line or one per 4 KB page
+ * @seed [in]: permutation seed
+ * @nb_chains [in]: number of start points to return
+ * @starts [out]: start points evenly spaced along the cycle
+ * @return: number of elements of the cycle, 0 on failure
+ */
+size_t build_chain(char *buf, size_t size, enum chain_kind kind, uint64_t seed, int nb_chains, void **starts);
+
+/*
+ * Time nb_chains chains over one working set
+ *
+ * @starts [in]: start of every chain
+ * @nb_chains [in]: number of chains
+ * @accesses [in]: loads over all chains
+ * @warm [in]: loads of the untimed warm-up walk of the first chain
+ * @return: nanoseconds per load
+ */
+double time_chase(void **starts, int nb_chains, size_t accesses, size_t warm);
+
+/*
+ * Measure chase latency while the load threads generate memory traffic at every rate
+ *
+ * @cfg [in]: configuration
+ * @return: 0 on success and -1 otherwise
+ */
+int run_loaded(const struct memlat_config *cfg);
+
+#endif /* MEMLAT_H_ */